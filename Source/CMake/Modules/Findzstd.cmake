@@ -0,0 +1,16 @@
+# Find Zstandard dependency
+#
+# This module defines
+#  zstd_INCLUDE_DIRS
+#  zstd_LIBRARIES
+#  zstd_FOUND
+
+start_find_package(zstd)
+
+set(zstd_INSTALL_DIR ${BSF_SOURCE_DIR}/../Dependencies/zstd CACHE PATH "")
+gen_default_lib_search_dirs(zstd)
+
+find_imported_includes(zstd zstd.h)
+find_imported_library(zstd zstd)
+
+end_find_package(zstd zstd)
@@ -3,6 +3,7 @@
 #include "Animation/BsAnimationClip.h"
 #include "Resources/BsResources.h"
 #include "Animation/BsSkeleton.h"
+#include "Animation/BsCompressedAnimationCurves.h"
 #include "Private/RTTI/BsAnimationClipRTTI.h"
 
 namespace bs
@@ -139,12 +140,35 @@ namespace bs
 	void AnimationClip::setCurves(const AnimationCurves& curves)
 	{
 		*mCurves = curves;
+		mCompressedCurves = nullptr;
 
 		buildNameMapping();
 		calculateLength();
 		mVersion++;
 	}
 
+	void AnimationClip::compress(const ANIMATION_COMPRESSION_DESC& desc)
+	{
+		mCompressedCurves = CompressedAnimationCurves::create(*mCurves, mLength, mSampleRate, desc);
+
+		// Curves can be accessed from other threads, so create a new set rather than modifying the existing one
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+
+		for(auto& entry : mCurves->position)
+			curves->position.push_back({ entry.name, entry.flags, TAnimationCurve<Vector3>() });
+
+		for(auto& entry : mCurves->rotation)
+			curves->rotation.push_back({ entry.name, entry.flags, TAnimationCurve<Quaternion>() });
+
+		for(auto& entry : mCurves->scale)
+			curves->scale.push_back({ entry.name, entry.flags, TAnimationCurve<Vector3>() });
+
+		curves->generic = mCurves->generic;
+
+		mCurves = curves;
+		mVersion++;
+	}
+
 	bool AnimationClip::hasRootMotion() const
 	{
 		return mRootMotion != nullptr && 
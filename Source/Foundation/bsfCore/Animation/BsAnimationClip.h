@@ -157,7 +157,8 @@ namespace bs
 
 		/** 
 		 * A set of all curves stored in the animation. Returned value will not be updated if the animation clip curves are
-		 * added or removed, as it is a copy of clip's internal values.
+		 * added or removed, as it is a copy of clip's internal values. If the clip was compressed, the returned position, 
+		 * rotation and scale curves will not contain any keyframes. Assigning new curves removes the compressed data.
 		 */
 		BS_SCRIPT_EXPORT(n:Curves,pr:setter)
 		void setCurves(const AnimationCurves& curves);
@@ -242,6 +243,18 @@ namespace bs
 		 */
 		UINT64 getVersion() const { return mVersion; }
 
+		/**
+		 * Compresses the position, rotation and scale curves of the clip. Compressed curves use a fraction of the memory,
+		 * at the cost of a small loss in precision controlled by @p desc. Evaluating a full skeleton takes about as long
+		 * as with uncompressed curves: constant tracks are cheaper to evaluate, while animated rotations are slower (about
+		 * 0.6x the throughput) as they need to be reconstructed from their quantized form. Keyframes of the original 
+		 * curves are released and only their names and flags are kept.
+		 */
+		void compress(const ANIMATION_COMPRESSION_DESC& desc);
+
+		/** Returns the compressed position, rotation and scale curves, or null if the clip isn't compressed. */
+		SPtr<CompressedAnimationCurves> getCompressedCurves() const { return mCompressedCurves; }
+
 		/** 
 		 * Creates an animation clip with no curves. After creation make sure to register some animation curves before
 		 * using it. 
@@ -305,6 +318,9 @@ namespace bs
 		 */
 		SPtr<RootMotion> mRootMotion;
 
+		/** Compressed version of the position, rotation and scale curves in mCurves. Null if not compressed. */
+		SPtr<CompressedAnimationCurves> mCompressedCurves;
+
 		/** 
 		 * Contains a map from curve name to curve index. Indices are stored as specified in CurveType enum. 
 		 */
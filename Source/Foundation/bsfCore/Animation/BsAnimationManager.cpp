@@ -3,25 +3,42 @@
 #include "Animation/BsAnimationManager.h"
 #include "Animation/BsAnimation.h"
 #include "Animation/BsAnimationClip.h"
-#include "Threading/BsTaskScheduler.h"
+#include "Animation/BsCompressedAnimationCurves.h"
+#include "Threading/BsJobScheduler.h"
 #include "Utility/BsTime.h"
 #include "Scene/BsSceneManager.h"
 #include "Renderer/BsCamera.h"
 #include "Animation/BsMorphShapes.h"
 #include "Mesh/BsMeshData.h"
 #include "Mesh/BsMeshUtility.h"
+#include "Profiling/BsProfilerCPU.h"
 
 namespace bs
 {
+	/** 
+	 * Number of bone transforms after which a batch is considered full. Chosen so a batch's output (and most of its
+	 * skeleton data) fits in the per-core cache. 
+	 */
+	static constexpr UINT32 BATCH_BONE_COUNT = 256;
+
+	/** Maximum number of animation proxies evaluated by a single batch. */
+	static constexpr UINT32 BATCH_MAX_PROXIES = 32;
+
 	AnimationManager::AnimationManager()
 		: mNextId(1), mUpdateRate(1.0f / 60.0f), mAnimationTime(0.0f), mLastAnimationUpdateTime(0.0f)
 		, mNextAnimationUpdateTime(0.0f), mPaused(false), mPoseReadBufferIdx(1), mPoseWriteBufferIdx(0)
+		, mNumPendingBatches(0), mEvaluationPending(false)
 	{
 		mBlendShapeVertexDesc = VertexDataDesc::create();
 		mBlendShapeVertexDesc->addVertElem(VET_FLOAT3, VES_POSITION, 1, 1);
 		mBlendShapeVertexDesc->addVertElem(VET_UBYTE4_NORM, VES_NORMAL, 1, 1);
 	}
 
+	AnimationManager::~AnimationManager()
+	{
+		waitUntilEvaluated();
+	}
+
 	void AnimationManager::setPaused(bool paused)
 	{
 		mPaused = paused;
@@ -38,20 +55,15 @@ namespace bs
 	const EvaluatedAnimationData* AnimationManager::update(bool async)
 	{
 		// Wait for any workers to complete
-		{
-			Lock lock(mMutex);
+		waitUntilEvaluated();
 
-			while (mNumActiveWorkers > 0)
-				mWorkerDoneSignal.wait(lock);
-
-			// Advance the buffers (last write buffer becomes read buffer)
-			if(mSwapBuffers)
-			{
-				mPoseReadBufferIdx = (mPoseReadBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
-				mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
+		// Advance the buffers (last write buffer becomes read buffer)
+		if(mSwapBuffers)
+		{
+			mPoseReadBufferIdx = (mPoseReadBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
+			mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
 
-				mSwapBuffers = false;
-			}
+			mSwapBuffers = false;
 		}
 
 		if(mPaused)
@@ -99,58 +111,37 @@ namespace bs
 			mCullFrustums.push_back(entry.second->getWorldFrustum());
 		}
 
-		// Prepare the write buffer
-		UINT32 totalNumBones = 0;
-		for (auto& anim : mProxies)
-		{
-			if (anim->skeleton != nullptr)
-				totalNumBones += anim->skeleton->getNumBones();
-		}
+		// Determine which animations need evaluating, and split them in batches
+		gProfilerCPU().beginSample("AnimationCull");
+		cullProxies();
+		UINT32 totalNumBones = buildBatches();
+		gProfilerCPU().endSample("AnimationCull");
 
 		// Prepare the write buffer
 		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		renderData.transforms.resize(totalNumBones);
 		renderData.infos.clear();
+		renderData.version = mNextDataVersion++;
 
-		// Queue animation evaluation tasks
-		{
-			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mProxies.size();
-		}
+		// Queue animation evaluation jobs
+		const UINT32 numBatches = (UINT32)mBatches.size();
+		mNumPendingBatches.store(numBatches);
+		mEvaluationPending = true;
 
-		UINT32 curBoneIdx = 0;
-		for (auto& anim : mProxies)
+		JobScheduler& jobScheduler = JobScheduler::instance();
+		for(UINT32 i = 0; i < numBatches; i++)
 		{
-			auto evaluateAnimWorker = [this, anim, curBoneIdx]()
-			{
-				UINT32 boneIdx = curBoneIdx;
-				evaluateAnimation(anim.get(), boneIdx);
-
-				Lock lock(mMutex);
-				{
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
-				}
-
-				mWorkerDoneSignal.notify_one();
-			};
+			EvaluationJobData jobData;
+			jobData.manager = this;
+			jobData.batchIdx = i;
 
-			SPtr<Task> task = Task::create("AnimWorker", evaluateAnimWorker);
-			TaskScheduler::instance().addTask(task);
-
-			if (anim->skeleton != nullptr)
-				curBoneIdx += anim->skeleton->getNumBones();
+			jobScheduler.run(jobScheduler.createJob(&AnimationManager::evaluateBatchJob, jobData));
 		}
 
 		// Wait for tasks to complete
 		if(!async)
 		{
-			{
-				Lock lock(mMutex);
-
-				while (mNumActiveWorkers > 0)
-					mWorkerDoneSignal.wait(lock);
-			}
+			waitUntilEvaluated();
 
 			// Trigger events and update attachments (for the data we just evaluated)
 			for (auto& anim : mAnimations)
@@ -165,30 +156,137 @@ namespace bs
 		return &mAnimData[mPoseReadBufferIdx];
 	}
 
-	void AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32& curBoneIdx)
+	void AnimationManager::waitUntilEvaluated()
 	{
-		if (anim->mCullEnabled)
+		if(!mEvaluationPending)
+			return;
+
+		gProfilerCPU().beginSample("AnimationWait");
+		JobScheduler::instance().waitUntil([this]()
+		{
+			return mNumPendingBatches.load(std::memory_order_acquire) == 0;
+		});
+		gProfilerCPU().endSample("AnimationWait");
+
+		// Publish the per-animation information. Done here rather than in the batches so they never need to lock.
+		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
+
+		const UINT32 numVisible = (UINT32)mVisibleProxies.size();
+		for(UINT32 i = 0; i < numVisible; i++)
 		{
-			bool isVisible = false;
-			for (auto& frustum : mCullFrustums)
+			if(mHasEvaluatedInfo[i])
+				renderData.infos[mVisibleProxies[i]->id] = mEvaluatedInfos[i];
+		}
+
+		mEvaluationPending = false;
+	}
+
+	void AnimationManager::cullProxies()
+	{
+		const UINT32 numProxies = (UINT32)mProxies.size();
+		mProxyVisibility.resize(numProxies);
+
+		// Gather bounds of all cullable proxies into SIMD friendly format
+		mCullProxyIndices.clear();
+		for(UINT32 i = 0; i < numProxies; i++)
+		{
+			const AnimationProxy* anim = mProxies[i].get();
+			if(anim->mCullEnabled)
 			{
-				if (frustum.intersects(anim->mBounds))
-				{
-					isVisible = true;
-					break;
-				}
+				mProxyVisibility[i] = 0;
+				mCullProxyIndices.push_back(i);
 			}
+			else
+				mProxyVisibility[i] = 1;
+		}
+
+		const UINT32 numCullable = (UINT32)mCullProxyIndices.size();
+		mCullBounds.resize(numCullable);
+		for(UINT32 i = 0; i < numCullable; i++)
+			mCullBounds.set(i, mProxies[mCullProxyIndices[i]]->mBounds);
 
-			if (!isVisible)
-				return;
+		// Test all bounds against every frustum, a proxy is visible if it is visible in any of them
+		mFrustumVisibility.resize(numCullable);
+		for(auto& frustum : mCullFrustums)
+		{
+			simd::intersects(frustum.getPlanes(), mCullBounds, 0, numCullable, mFrustumVisibility.data());
+
+			for(UINT32 i = 0; i < numCullable; i++)
+				mProxyVisibility[mCullProxyIndices[i]] |= mFrustumVisibility[i];
 		}
 
+		mVisibleProxies.clear();
+		for(UINT32 i = 0; i < numProxies; i++)
+		{
+			if(mProxyVisibility[i])
+				mVisibleProxies.push_back(mProxies[i].get());
+		}
+	}
+
+	UINT32 AnimationManager::buildBatches()
+	{
+		const UINT32 numVisible = (UINT32)mVisibleProxies.size();
+		mBoneOffsets.resize(numVisible);
+		mEvaluatedInfos.resize(numVisible);
+		mHasEvaluatedInfo.resize(numVisible);
+		mBatches.clear();
+
+		UINT32 totalNumBones = 0;
+		UINT32 batchCost = 0;
+
+		EvaluationBatch batch = { 0, 0 };
+		for(UINT32 i = 0; i < numVisible; i++)
+		{
+			const AnimationProxy* anim = mVisibleProxies[i];
+			const UINT32 numBones = anim->skeleton != nullptr ? anim->skeleton->getNumBones() : 0;
+
+			mBoneOffsets[i] = totalNumBones;
+			totalNumBones += numBones;
+
+			// Objects without a skeleton still have a cost of evaluating curves & morph shapes, count them as a bone
+			batchCost += std::max(numBones, 1U);
+			batch.count++;
+
+			if(batchCost >= BATCH_BONE_COUNT || batch.count >= BATCH_MAX_PROXIES)
+			{
+				mBatches.push_back(batch);
+
+				batch.start = i + 1;
+				batch.count = 0;
+				batchCost = 0;
+			}
+		}
+
+		if(batch.count > 0)
+			mBatches.push_back(batch);
+
+		return totalNumBones;
+	}
+
+	void AnimationManager::evaluateBatchJob(Job* job, const void* data)
+	{
+		const EvaluationJobData& jobData = *(const EvaluationJobData*)data;
+		jobData.manager->evaluateBatch(jobData.batchIdx);
+	}
+
+	void AnimationManager::evaluateBatch(UINT32 batchIdx)
+	{
+		const EvaluationBatch& batch = mBatches[batchIdx];
+		for(UINT32 i = batch.start; i < batch.start + batch.count; i++)
+			mHasEvaluatedInfo[i] = evaluateAnimation(mVisibleProxies[i], mBoneOffsets[i], mEvaluatedInfos[i]);
+
+		mNumPendingBatches.fetch_sub(1, std::memory_order_release);
+	}
+
+	bool AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32 curBoneIdx, 
+		EvaluatedAnimationData::AnimInfo& animInfo)
+	{
 		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		
 		UINT32 prevPoseBufferIdx = (mPoseWriteBufferIdx + CoreThread::NUM_SYNC_BUFFERS) % (CoreThread::NUM_SYNC_BUFFERS + 1);
 		EvaluatedAnimationData& prevRenderData = mAnimData[prevPoseBufferIdx];
 
-		EvaluatedAnimationData::AnimInfo animInfo;
+		animInfo = EvaluatedAnimationData::AnimInfo();
 		bool hasAnimInfo = false;
 
 		// Evaluate skeletal animation
@@ -221,7 +319,6 @@ namespace bs
 			// Animate bones
 			anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
 
-			curBoneIdx += numBones;
 			hasAnimInfo = true;
 		}
 		else
@@ -259,12 +356,23 @@ namespace bs
 			if (state.disabled)
 				continue;
 
+			const CompressedAnimationCurves* compressed = state.compressedCurves.get();
+
 			{
 				UINT32 curveIdx = soInfo.curveIndices.position;
 				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-					anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+					if (compressed != nullptr)
+					{
+						anim->sceneObjectPose.positions[curveIdx] = 
+							compressed->evaluateVector(CurveType::Position, curveIdx, state.time, state.loop);
+					}
+					else
+					{
+						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+						anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+					}
+
 					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
 			}
@@ -273,9 +381,18 @@ namespace bs
 				UINT32 curveIdx = soInfo.curveIndices.rotation;
 				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-					anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-					anim->sceneObjectPose.rotations[curveIdx].normalize();
+					if (compressed != nullptr)
+					{
+						anim->sceneObjectPose.rotations[curveIdx] = 
+							compressed->evaluateRotation(curveIdx, state.time, state.loop);
+					}
+					else
+					{
+						const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+						anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
+						anim->sceneObjectPose.rotations[curveIdx].normalize();
+					}
+
 					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
 			}
@@ -284,8 +401,17 @@ namespace bs
 				UINT32 curveIdx = soInfo.curveIndices.scale;
 				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-					anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+					if (compressed != nullptr)
+					{
+						anim->sceneObjectPose.scales[curveIdx] = 
+							compressed->evaluateVector(CurveType::Scale, curveIdx, state.time, state.loop);
+					}
+					else
+					{
+						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+						anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+					}
+
 					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
 			}
@@ -497,11 +623,7 @@ namespace bs
 		else
 			animInfo.morphShapeInfo.version = 1;
 
-		if (hasAnimInfo)
-		{
-			Lock lock(mMutex);
-			renderData.infos[anim->id] = animInfo;
-		}
+		return hasAnimInfo;
 	}
 
 	UINT64 AnimationManager::registerAnimation(Animation* anim)
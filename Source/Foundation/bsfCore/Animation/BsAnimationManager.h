@@ -6,6 +6,7 @@
 #include "Utility/BsModule.h"
 #include "CoreThread/BsCoreThread.h"
 #include "Math/BsConvexVolume.h"
+#include "Math/BsSIMD.h"
 #include "RenderAPI/BsVertexDataDesc.h"
 
 namespace bs
@@ -48,6 +49,9 @@ namespace bs
 
 		/** Global joint transforms for all skeletons in the scene. */
 		Vector<Matrix4> transforms;
+
+		/** Incremented every time the data is re-evaluated. 0 is considered an invalid version. */
+		UINT64 version = 0;
 	};
 
 	/** 
@@ -58,6 +62,7 @@ namespace bs
 	{
 	public:
 		AnimationManager();
+		~AnimationManager();
 
 		/** Pauses or resumes the animation evaluation. */
 		void setPaused(bool paused);
@@ -89,12 +94,18 @@ namespace bs
 	private:
 		friend class Animation;
 
-		/** Possible states the worker thread can be in, used for synchronization. */
-		enum class WorkerState
+		/** Range of visible animation proxies evaluated by a single job. */
+		struct EvaluationBatch
+		{
+			UINT32 start;
+			UINT32 count;
+		};
+
+		/** Payload of a job evaluating a single batch. */
+		struct EvaluationJobData
 		{
-			Inactive,
-			Started,
-			DataReady
+			AnimationManager* manager;
+			UINT32 batchIdx;
 		};
 
 		/** 
@@ -105,17 +116,33 @@ namespace bs
 		/** Unregisters an animation with the specified ID. Must be called before an Animation is destroyed. */
 		void unregisterAnimation(UINT64 id);
 
-		/** Worker method ran on the animation thread that evaluates all animation at the provided time. */
-		void evaluateAnimation();
+		/** Blocks until all batches queued by the last call to update() finish evaluating. */
+		void waitUntilEvaluated();
+
+		/** 
+		 * Tests bounds of all animation proxies against the active camera frustums and populates the list of visible
+		 * proxies. Culling is performed on multiple proxies at once using SIMD instructions.
+		 */
+		void cullProxies();
+
+		/** Splits the visible proxies into batches and assigns each proxy its range in the bone transform buffer. */
+		UINT32 buildBatches();
+
+		/** Job method that evaluates all animation proxies in a single batch. */
+		static void evaluateBatchJob(Job* job, const void* data);
+
+		/** Evaluates all animation proxies in a single batch. */
+		void evaluateBatch(UINT32 batchIdx);
 
 		/** 
 		 * Evaluates animation for a single object and writes the result in the currently active write buffer. 
 		 *
 		 * @param[in]	anim		Proxy representing the animation to evaluate.
-		 * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information. This will be
-		 *							automatically advanced by the number of written bone transforms.
+		 * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information.
+		 * @param[out]	animInfo	Information about where the evaluated data was written.
+		 * @return					True if any data was evaluated and @p animInfo was written to.
 		 */
-		void evaluateAnimation(AnimationProxy* anim, UINT32& boneIdx);
+		bool evaluateAnimation(AnimationProxy* anim, UINT32 boneIdx, EvaluatedAnimationData::AnimInfo& animInfo);
 
 		UINT64 mNextId;
 		UnorderedMap<UINT64, Animation*> mAnimations;
@@ -135,11 +162,22 @@ namespace bs
 
 		UINT32 mPoseReadBufferIdx;
 		UINT32 mPoseWriteBufferIdx;
-		
-		Signal mWorkerDoneSignal;
-		Mutex mMutex;
-
-		UINT32 mNumActiveWorkers = 0;
+		UINT64 mNextDataVersion = 1;
+
+		// Per-frame evaluation data, re-used between frames to avoid allocations
+		simd::AABoxSoA mCullBounds;
+		Vector<UINT32> mCullProxyIndices;
+		Vector<UINT8> mFrustumVisibility;
+		Vector<UINT8> mProxyVisibility;
+
+		Vector<AnimationProxy*> mVisibleProxies;
+		Vector<UINT32> mBoneOffsets;
+		Vector<EvaluatedAnimationData::AnimInfo> mEvaluatedInfos;
+		Vector<UINT8> mHasEvaluatedInfo;
+		Vector<EvaluationBatch> mBatches;
+
+		std::atomic<UINT32> mNumPendingBatches;
+		bool mEvaluationPending;
 		bool mSwapBuffers = false;
 	};
 
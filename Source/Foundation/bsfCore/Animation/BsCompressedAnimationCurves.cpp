@@ -0,0 +1,804 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Animation/BsCompressedAnimationCurves.h"
+#include "Animation/BsAnimationUtility.h"
+#include "Math/BsSIMD.h"
+#include "Private/RTTI/BsCompressedAnimationCurvesRTTI.h"
+
+namespace bs
+{
+	/** Number of tracks decompressed at once. Matches the width of a float32x4 vector. */
+	static constexpr UINT32 DECODE_BATCH_SIZE = 4;
+
+	/** Largest value of a quantized position or scale component. */
+	static constexpr float VECTOR_QUANT_MAX = 65535.0f;
+
+	/** Largest value of a quantized quaternion component. Top bit of the component is used for the largest index. */
+	static constexpr float QUAT_QUANT_MAX = 32767.0f;
+
+	/** Range of the three smallest quaternion components is [-QUAT_RANGE, QUAT_RANGE]. */
+	static constexpr float QUAT_RANGE = 0.70710678f;
+
+	/** Maximum number of frames in a segment. Ensures the key counts always fit in a CompressedTrackHeader. */
+	static constexpr UINT32 MAX_SEGMENT_LENGTH = 4096;
+
+	/** Key level used for tracks that have a single key within the segment. */
+	static constexpr UINT32 CONSTANT_KEY_LEVEL = 0xFFFF;
+
+	/** Maximum key level + 1. Enough to cover MAX_SEGMENT_LENGTH. */
+	static constexpr UINT32 NUM_KEY_LEVELS = 13;
+
+	/** Number of bytes of padding at the end of the data buffer, ensuring keys can always be read as 64-bit values. */
+	static constexpr UINT32 DATA_PADDING = 8;
+
+	/** Size of the per-segment range (minimum and scale) stored for each position and scale track. */
+	static constexpr UINT32 VECTOR_RANGE_SIZE = sizeof(float) * 6;
+
+	/** Returns the index of the curve type within the track arrays. */
+	static UINT32 getTypeIndex(CurveType type)
+	{
+		switch(type)
+		{
+		case CurveType::Position:
+			return 0;
+		case CurveType::Rotation:
+			return 1;
+		case CurveType::Scale:
+			return 2;
+		default:
+			BS_EXCEPT(InvalidParametersException, "Only position, rotation and scale tracks can be compressed.");
+			return 0;
+		}
+	}
+
+	/** Encodes a normalized quaternion using the smallest-three method. */
+	static void encodeQuaternion(const Quaternion& value, UINT16* output)
+	{
+		UINT32 largestIdx = 0;
+		for(UINT32 i = 1; i < 4; i++)
+		{
+			if(std::abs(value[i]) > std::abs(value[largestIdx]))
+				largestIdx = i;
+		}
+
+		// Largest component is reconstructed as a positive value, flip the quaternion so that holds
+		const float sign = value[largestIdx] < 0.0f ? -1.0f : 1.0f;
+
+		UINT32 outputIdx = 0;
+		for(UINT32 i = 0; i < 4; i++)
+		{
+			if(i == largestIdx)
+				continue;
+
+			const float normalized = (value[i] * sign / QUAT_RANGE) * 0.5f + 0.5f;
+			output[outputIdx++] = (UINT16)Math::clamp(Math::roundToInt(normalized * QUAT_QUANT_MAX), 0, 32767);
+		}
+
+		output[0] |= (UINT16)((largestIdx >> 1) << 15);
+		output[1] |= (UINT16)((largestIdx & 1) << 15);
+	}
+
+	/** Decodes a quaternion encoded by encodeQuaternion(). */
+	static Quaternion decodeQuaternion(const UINT16* input)
+	{
+		const UINT32 largestIdx = ((input[0] >> 15) << 1) | (input[1] >> 15);
+
+		float values[3];
+		float sqrLength = 0.0f;
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			values[i] = ((input[i] & 0x7FFF) / QUAT_QUANT_MAX * 2.0f - 1.0f) * QUAT_RANGE;
+			sqrLength += values[i] * values[i];
+		}
+
+		Quaternion output;
+		UINT32 inputIdx = 0;
+		for(UINT32 i = 0; i < 4; i++)
+		{
+			if(i == largestIdx)
+				output[i] = std::sqrt(std::max(1.0f - sqrLength, 0.0f));
+			else
+				output[i] = values[inputIdx++];
+		}
+
+		return output;
+	}
+
+	/** Returns the largest per-component difference between two vectors. */
+	static float getError(const Vector3& a, const Vector3& b)
+	{
+		return std::max(std::max(std::abs(a.x - b.x), std::abs(a.y - b.y)), std::abs(a.z - b.z));
+	}
+
+	/** Returns the largest per-component difference between two rotations, ignoring the quaternion sign. */
+	static float getError(const Quaternion& a, const Quaternion& b)
+	{
+		float diffError = 0.0f;
+		float sumError = 0.0f;
+		for(UINT32 i = 0; i < 4; i++)
+		{
+			diffError = std::max(diffError, std::abs(a[i] - b[i]));
+			sumError = std::max(sumError, std::abs(a[i] + b[i]));
+		}
+
+		return std::min(diffError, sumError);
+	}
+
+	/** Interpolates between two decoded values the same way the decoder does. */
+	static Vector3 interpolate(const Vector3& a, const Vector3& b, float t)
+	{
+		return a + (b - a) * t;
+	}
+
+	/** @copydoc interpolate(const Vector3&, const Vector3&, float) */
+	static Quaternion interpolate(const Quaternion& a, const Quaternion& b, float t)
+	{
+		const Quaternion end = a.dot(b) < 0.0f ? -b : b;
+
+		Quaternion output = a + (end - a) * t;
+		output.normalize();
+
+		return output;
+	}
+
+	/** Returns the number of keys required to cover a segment using the provided key stride. */
+	static UINT32 getNumKeys(UINT32 numFrames, UINT32 keyStride)
+	{
+		return (numFrames + keyStride - 1) / keyStride + 1;
+	}
+
+	/** Returns the frame (relative to the segment start) at which the key with the specified index is located. */
+	static UINT32 getKeyFrame(UINT32 keyIdx, UINT32 keyStride, UINT32 numFrames)
+	{
+		return std::min(keyIdx * keyStride, numFrames);
+	}
+
+	/**
+	 * Finds the lowest key level (i.e. the largest key stride) for which interpolating between the decoded values at key
+	 * frames approximates all the samples within the provided tolerance.
+	 *
+	 * @param[in]	samples		Original values, one per frame (including the frame at the end of the segment).
+	 * @param[in]	decoded		Values of @p samples after quantization.
+	 * @param[in]	numFrames	Number of frames in the segment.
+	 * @param[in]	tolerance	Maximum allowed error.
+	 */
+	template<class T>
+	static UINT32 findKeyLevel(const T* samples, const T* decoded, UINT32 numFrames, float tolerance)
+	{
+		UINT32 keyLevel = 0;
+		for(; (numFrames >> keyLevel) > 1; keyLevel++)
+		{
+			const UINT32 keyStride = numFrames >> keyLevel;
+			const UINT32 numKeys = getNumKeys(numFrames, keyStride);
+
+			bool withinTolerance = true;
+			for(UINT32 i = 0; i <= numFrames && withinTolerance; i++)
+			{
+				const UINT32 keyIdx = std::min(i / keyStride, numKeys - 2);
+				const UINT32 frame0 = getKeyFrame(keyIdx, keyStride, numFrames);
+				const UINT32 frame1 = getKeyFrame(keyIdx + 1, keyStride, numFrames);
+
+				const float t = (i - frame0) / (float)(frame1 - frame0);
+				const T value = interpolate(decoded[frame0], decoded[frame1], t);
+
+				withinTolerance = getError(value, samples[i]) <= tolerance;
+			}
+
+			if(withinTolerance)
+				break;
+		}
+
+		return keyLevel;
+	}
+
+	/** Appends raw bytes to the data buffer. */
+	static void write(Vector<UINT8>& data, const void* input, UINT32 size)
+	{
+		const UINT8* bytes = (const UINT8*)input;
+		data.insert(data.end(), bytes, bytes + size);
+	}
+
+	/** Compresses a position or scale track within a single segment and appends it to the data buffer. */
+	static CompressedTrackHeader encodeVectorSegment(const Vector3* samples, UINT32 numFrames, float tolerance,
+		Vector<UINT8>& data)
+	{
+		Vector3 min = samples[0];
+		Vector3 max = samples[0];
+		for(UINT32 i = 1; i <= numFrames; i++)
+		{
+			min = Vector3::min(min, samples[i]);
+			max = Vector3::max(max, samples[i]);
+		}
+
+		CompressedTrackHeader header;
+		header.offset = (UINT32)data.size();
+
+		const Vector3 range = max - min;
+		if(range.x <= tolerance && range.y <= tolerance && range.z <= tolerance)
+		{
+			const Vector3 center = (min + max) * 0.5f;
+			const Vector3 scale = Vector3::ZERO;
+			const UINT16 key[4] = { 0, 0, 0, 0 };
+
+			write(data, &center, sizeof(center));
+			write(data, &scale, sizeof(scale));
+			write(data, key, sizeof(key));
+
+			header.keyLevel = CONSTANT_KEY_LEVEL;
+			header.numKeys = 1;
+			return header;
+		}
+
+		Vector3 scale;
+		for(UINT32 i = 0; i < 3; i++)
+			scale[i] = range[i] > 0.0f ? range[i] / VECTOR_QUANT_MAX : 0.0f;
+
+		FrameVector<UINT16> keys((numFrames + 1) * 3);
+		FrameVector<Vector3> decoded(numFrames + 1);
+		for(UINT32 i = 0; i <= numFrames; i++)
+		{
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				UINT16 key = 0;
+				if(scale[j] > 0.0f)
+				{
+					const INT32 quantized = Math::roundToInt((samples[i][j] - min[j]) / scale[j]);
+					key = (UINT16)Math::clamp(quantized, 0, 65535);
+				}
+
+				keys[i * 3 + j] = key;
+				decoded[i][j] = min[j] + key * scale[j];
+			}
+		}
+
+		const UINT32 keyLevel = findKeyLevel(samples, decoded.data(), numFrames, tolerance);
+		const UINT32 keyStride = numFrames >> keyLevel;
+		const UINT32 numKeys = getNumKeys(numFrames, keyStride);
+
+		write(data, &min, sizeof(min));
+		write(data, &scale, sizeof(scale));
+
+		for(UINT32 i = 0; i < numKeys; i++)
+			write(data, &keys[getKeyFrame(i, keyStride, numFrames) * 3], sizeof(UINT16) * 3);
+
+		// Keep the next track aligned
+		if(numKeys % 2 != 0)
+			data.insert(data.end(), sizeof(UINT16), 0);
+
+		header.keyLevel = (UINT16)keyLevel;
+		header.numKeys = (UINT16)numKeys;
+		return header;
+	}
+
+	/** Compresses a rotation track within a single segment and appends it to the data buffer. */
+	static CompressedTrackHeader encodeRotationSegment(const Quaternion* samples, UINT32 numFrames, float tolerance,
+		Vector<UINT8>& data)
+	{
+		FrameVector<UINT16> keys((numFrames + 1) * 3);
+		FrameVector<Quaternion> decoded(numFrames + 1);
+		for(UINT32 i = 0; i <= numFrames; i++)
+		{
+			encodeQuaternion(samples[i], &keys[i * 3]);
+			decoded[i] = decodeQuaternion(&keys[i * 3]);
+		}
+
+		bool isConstant = true;
+		for(UINT32 i = 1; i <= numFrames && isConstant; i++)
+			isConstant = getError(decoded[0], samples[i]) <= tolerance;
+
+		UINT32 keyLevel = CONSTANT_KEY_LEVEL;
+		UINT32 keyStride = 0;
+		UINT32 numKeys = 1;
+		if(!isConstant)
+		{
+			keyLevel = findKeyLevel(samples, decoded.data(), numFrames, tolerance);
+			keyStride = numFrames >> keyLevel;
+			numKeys = getNumKeys(numFrames, keyStride);
+		}
+
+		CompressedTrackHeader header;
+		header.offset = (UINT32)data.size();
+		header.keyLevel = (UINT16)keyLevel;
+		header.numKeys = (UINT16)numKeys;
+
+		for(UINT32 i = 0; i < numKeys; i++)
+			write(data, &keys[getKeyFrame(i, keyStride, numFrames) * 3], sizeof(UINT16) * 3);
+
+		if(numKeys % 2 != 0)
+			data.insert(data.end(), sizeof(UINT16), 0);
+
+		return header;
+	}
+
+	/** Location of the keys surrounding the evaluation time, for each possible key level. */
+	struct KeyLookup
+	{
+		UINT32 keys[NUM_KEY_LEVELS + 1][2]; // Last entry is used for constant tracks
+		float alpha[NUM_KEY_LEVELS + 1];
+
+		/** Returns the index of the lookup entry to use for the specified track. */
+		static UINT32 getEntry(const CompressedTrackHeader& header)
+		{
+			return std::min((UINT32)header.keyLevel, NUM_KEY_LEVELS);
+		}
+	};
+
+	/** Tracks decoded together, DECODE_BATCH_SIZE at a time. */
+	struct TrackBatch
+	{
+		const UINT8* data[DECODE_BATCH_SIZE];
+		UINT32 entries[DECODE_BATCH_SIZE];
+		bool isConstant;
+	};
+
+	/** 
+	 * Finds the data and the key lookup entries of up to DECODE_BATCH_SIZE tracks. If there are less tracks than 
+	 * DECODE_BATCH_SIZE the last track is repeated.
+	 *
+	 * @param[in]	headers		Headers of all the tracks of the evaluated type, within the evaluated segment.
+	 * @param[in]	data		Buffer containing the data of all the tracks.
+	 * @param[in]	tracks		Indices of the tracks to find.
+	 * @param[in]	count		Number of entries in @p tracks. Must be in range [1, DECODE_BATCH_SIZE].
+	 * @param[out]	output		Information about the found tracks.
+	 */
+	static inline void findTracks(const CompressedTrackHeader* headers, const UINT8* data, const UINT32* tracks, 
+		UINT32 count, TrackBatch& output)
+	{
+		output.isConstant = true;
+		for(UINT32 i = 0; i < DECODE_BATCH_SIZE; i++)
+		{
+			const CompressedTrackHeader& header = headers[tracks[std::min(i, count - 1)]];
+
+			output.data[i] = data + header.offset;
+			output.entries[i] = KeyLookup::getEntry(header);
+			output.isConstant &= output.entries[i] == NUM_KEY_LEVELS;
+		}
+	}
+
+	/** Reads the three components of a key, along with the two bytes following it. */
+	static inline UINT64 readKey(const UINT8* data)
+	{
+		UINT64 key;
+		memcpy(&key, data, sizeof(key));
+
+		return key;
+	}
+
+	/** 
+	 * Reads a key of each track in the batch, and transposes them so each output vector contains a single component of
+	 * all the keys.
+	 *
+	 * @param[in]	batch		Tracks to read the keys from.
+	 * @param[in]	keyOffset	Offset of the first key from the start of the track data, in bytes.
+	 * @param[in]	lookup		Location of the keys surrounding the evaluation time.
+	 * @param[in]	keyIdx		0 to read the keys before the evaluation time, 1 to read the keys after it.
+	 * @param[out]	output		Components of the keys.
+	 */
+	static inline void gatherKeys(const TrackBatch& batch, UINT32 keyOffset, const KeyLookup& lookup, UINT32 keyIdx,
+		simd::int32x4 (&output)[3])
+	{
+		using namespace simd;
+
+		const UINT8* keys[DECODE_BATCH_SIZE];
+		for(UINT32 i = 0; i < DECODE_BATCH_SIZE; i++)
+			keys[i] = batch.data[i] + keyOffset + lookup.keys[batch.entries[i]][keyIdx] * sizeof(UINT16) * 3;
+
+		// Keys are read into registers and transposed there, as copying them to memory and loading them as vectors
+		// stalls on store forwarding. Data is padded so it's safe to read the two bytes past the key.
+		const uint16x8 keys01 = bit_cast<uint16x8>(make_uint<uint64x2>(readKey(keys[0]), readKey(keys[1])));
+		const uint16x8 keys23 = bit_cast<uint16x8>(make_uint<uint64x2>(readKey(keys[2]), readKey(keys[3])));
+
+		// [x0 x2 y0 y2 z0 z2 w0 w2] and [x1 x3 y1 y3 z1 z3 w1 w3]
+		const uint16x8 keys02 = zip8_lo(keys01, keys23);
+		const uint16x8 keys13 = zip8_hi(keys01, keys23);
+
+		// [x0 x1 x2 x3 y0 y1 y2 y3] and [z0 z1 z2 z3 w0 w1 w2 w3]
+		const uint16x8 xy = zip8_lo(keys02, keys13);
+		const uint16x8 zw = zip8_hi(keys02, keys13);
+
+		const uint16x8 zero = make_zero();
+		output[0] = bit_cast<int32x4>(zip8_lo(xy, zero));
+		output[1] = bit_cast<int32x4>(zip8_hi(xy, zero));
+		output[2] = bit_cast<int32x4>(zip8_lo(zw, zero));
+	}
+
+	/** Returns the interpolation factor of each track in the batch. */
+	static inline simd::float32x4 gatherAlpha(const TrackBatch& batch, const KeyLookup& lookup)
+	{
+		return simd::make_float<simd::float32x4>(lookup.alpha[batch.entries[0]], lookup.alpha[batch.entries[1]], 
+			lookup.alpha[batch.entries[2]], lookup.alpha[batch.entries[3]]);
+	}
+
+	/** Writes the decoded values of up to DECODE_BATCH_SIZE tracks to their locations in the output. */
+	template<UINT32 N>
+	static void storeBatch(const simd::float32x4 (&values)[N], const UINT32* outputIndices, UINT32 count, 
+		float* const* output)
+	{
+		using namespace simd;
+
+		// Tracks are usually requested in the same order as their outputs (e.g. bones), in which case the whole batch 
+		// can be written at once
+		const UINT32 firstIdx = outputIndices[0];
+		if(count == DECODE_BATCH_SIZE && outputIndices[1] == firstIdx + 1 && outputIndices[2] == firstIdx + 2 && 
+			outputIndices[3] == firstIdx + 3)
+		{
+			for(UINT32 i = 0; i < N; i++)
+				store_u(output[i] + firstIdx, values[i]);
+
+			return;
+		}
+
+		float decoded[N][DECODE_BATCH_SIZE];
+		for(UINT32 i = 0; i < N; i++)
+			store_u(decoded[i], values[i]);
+
+		for(UINT32 i = 0; i < count; i++)
+		{
+			const UINT32 outputIdx = outputIndices[i];
+			for(UINT32 j = 0; j < N; j++)
+				output[j][outputIdx] = decoded[j][i];
+		}
+	}
+
+	/** Decodes and interpolates position or scale tracks, DECODE_BATCH_SIZE tracks at a time. */
+	static void decodeVectors(const CompressedTrackHeader* headers, const UINT8* data, const KeyLookup& lookup, 
+		const UINT32* tracks, const UINT32* outputIndices, UINT32 count, float* const* output)
+	{
+		using namespace simd;
+
+		for(UINT32 i = 0; i < count; i += DECODE_BATCH_SIZE)
+		{
+			const UINT32 batchSize = std::min(DECODE_BATCH_SIZE, count - i);
+
+			TrackBatch batch;
+			findTracks(headers, data, tracks + i, batchSize, batch);
+
+			// Transpose the ranges so each vector contains a single component of the minimum or the scale
+			float32x4 min[4];
+			for(UINT32 j = 0; j < DECODE_BATCH_SIZE; j++)
+				min[j] = load_u<float32x4>(batch.data[j]);
+
+			transpose4(min[0], min[1], min[2], min[3]);
+
+			float32x4 values[3] = { min[0], min[1], min[2] };
+
+			// Constant tracks store their value as the minimum, with zero scale
+			if(!batch.isConstant)
+			{
+				float32x4 scale[4];
+				for(UINT32 j = 0; j < DECODE_BATCH_SIZE; j++)
+					scale[j] = load_u<float32x4>((const float*)batch.data[j] + 3);
+
+				transpose4(scale[0], scale[1], scale[2], scale[3]);
+
+				int32x4 keys[2][3];
+				gatherKeys(batch, VECTOR_RANGE_SIZE, lookup, 0, keys[0]);
+				gatherKeys(batch, VECTOR_RANGE_SIZE, lookup, 1, keys[1]);
+
+				const float32x4 t = gatherAlpha(batch, lookup);
+				for(UINT32 j = 0; j < 3; j++)
+				{
+					const float32x4 key0 = to_float32(keys[0][j]);
+					const float32x4 key1 = to_float32(keys[1][j]);
+					const float32x4 key = add(key0, mul(sub(key1, key0), t));
+
+					values[j] = add(min[j], mul(key, scale[j]));
+				}
+			}
+
+			storeBatch(values, outputIndices + i, batchSize, output);
+		}
+	}
+
+	/** Decodes a key of each of the tracks in a batch, as encoded by encodeQuaternion(). */
+	static inline void decodeQuaternions(const simd::int32x4 (&keys)[3], simd::float32x4 (&output)[4])
+	{
+		using namespace simd;
+
+		const float32x4 scale = splat<float32x4>(2.0f * QUAT_RANGE / QUAT_QUANT_MAX);
+		const float32x4 bias = splat<float32x4>(-QUAT_RANGE);
+		const int32x4 valueMask = splat<int32x4>(0x7FFF);
+
+		const float32x4 a = add(mul(to_float32(bit_and(keys[0], valueMask)), scale), bias);
+		const float32x4 b = add(mul(to_float32(bit_and(keys[1], valueMask)), scale), bias);
+		const float32x4 c = add(mul(to_float32(keys[2]), scale), bias);
+
+		const float32x4 sqrLength = add(add(mul(a, a), mul(b, b)), mul(c, c));
+		const float32x4 d = sqrt(max(sub(splat<float32x4>(1.0f), sqrLength), (float32x4)make_zero()));
+
+		// Insert the reconstructed component at the location of the largest component
+		const int32x4 largestIdx = bit_or(shift_l<1>(shift_r<15>(keys[0])), shift_r<15>(keys[1]));
+		const mask_float32x4 afterX = bit_cast<mask_float32x4>(cmp_gt(largestIdx, splat<int32x4>(0)));
+		const mask_float32x4 afterY = bit_cast<mask_float32x4>(cmp_gt(largestIdx, splat<int32x4>(1)));
+		const mask_float32x4 afterZ = bit_cast<mask_float32x4>(cmp_gt(largestIdx, splat<int32x4>(2)));
+
+		output[0] = blend(a, d, afterX);
+		output[1] = blend(b, blend(d, a, afterX), afterY);
+		output[2] = blend(c, blend(d, b, afterY), afterZ);
+		output[3] = blend(d, c, afterZ);
+	}
+
+	/** Decodes and interpolates rotation tracks, DECODE_BATCH_SIZE tracks at a time. */
+	static void decodeRotations(const CompressedTrackHeader* headers, const UINT8* data, const KeyLookup& lookup, 
+		const UINT32* tracks, const UINT32* outputIndices, UINT32 count, float* const* output)
+	{
+		using namespace simd;
+
+		for(UINT32 i = 0; i < count; i += DECODE_BATCH_SIZE)
+		{
+			const UINT32 batchSize = std::min(DECODE_BATCH_SIZE, count - i);
+
+			TrackBatch batch;
+			findTracks(headers, data, tracks + i, batchSize, batch);
+
+			int32x4 keys[3];
+			gatherKeys(batch, 0, lookup, 0, keys);
+
+			float32x4 values[4];
+			decodeQuaternions(keys, values);
+
+			// Constant tracks only have a single key
+			if(!batch.isConstant)
+			{
+				float32x4 end[4];
+				gatherKeys(batch, 0, lookup, 1, keys);
+				decodeQuaternions(keys, end);
+
+				// Interpolate along the shortest path
+				const float32x4 dot = add(add(mul(values[0], end[0]), mul(values[1], end[1])), 
+					add(mul(values[2], end[2]), mul(values[3], end[3])));
+
+				const float32x4 flipSign = bit_and(dot, splat<float32x4>(-0.0f));
+				const float32x4 t = gatherAlpha(batch, lookup);
+
+				for(UINT32 j = 0; j < 4; j++)
+				{
+					end[j] = bit_xor(end[j], flipSign);
+					values[j] = add(values[j], mul(sub(end[j], values[j]), t));
+				}
+			}
+
+			storeBatch(values, outputIndices + i, batchSize, output);
+		}
+	}
+
+	void CompressedAnimationCurves::evaluate(CurveType type, float time, bool loop, const UINT32* tracks,
+		const UINT32* outputIndices, UINT32 count, float* const* output) const
+	{
+		const UINT32 typeIdx = getTypeIndex(type);
+
+		UINT32 segmentIdx;
+		UINT32 numFrames;
+		float frame;
+		findSegment(time, loop, segmentIdx, frame, numFrames);
+
+		// Headers are stored per segment, with all position tracks followed by all rotation and scale tracks
+		UINT32 headerOffset = segmentIdx * (mNumTracks[0] + mNumTracks[1] + mNumTracks[2]);
+		for(UINT32 i = 0; i < typeIdx; i++)
+			headerOffset += mNumTracks[i];
+
+		const CompressedTrackHeader* headers = mHeaders.data() + headerOffset;
+
+		// Keys of all tracks are placed at one of only a few possible strides, so find the keys surrounding the
+		// evaluation time once per stride, rather than once per track
+		KeyLookup lookup;
+		for(UINT32 i = 0; i < NUM_KEY_LEVELS && (numFrames >> i) > 0; i++)
+		{
+			const UINT32 keyStride = numFrames >> i;
+			const UINT32 keyIdx = std::min((UINT32)frame / keyStride, getNumKeys(numFrames, keyStride) - 2);
+
+			const float frame0 = (float)getKeyFrame(keyIdx, keyStride, numFrames);
+			const float frame1 = (float)getKeyFrame(keyIdx + 1, keyStride, numFrames);
+
+			lookup.keys[i][0] = keyIdx;
+			lookup.keys[i][1] = keyIdx + 1;
+			lookup.alpha[i] = (frame - frame0) / (frame1 - frame0);
+		}
+
+		lookup.keys[NUM_KEY_LEVELS][0] = 0;
+		lookup.keys[NUM_KEY_LEVELS][1] = 0;
+		lookup.alpha[NUM_KEY_LEVELS] = 0.0f;
+
+		if(type == CurveType::Rotation)
+			decodeRotations(headers, mData.data(), lookup, tracks, outputIndices, count, output);
+		else
+			decodeVectors(headers, mData.data(), lookup, tracks, outputIndices, count, output);
+	}
+
+	Vector3 CompressedAnimationCurves::evaluateVector(CurveType type, UINT32 track, float time, bool loop) const
+	{
+		Vector3 output;
+		float* components[] = { &output.x, &output.y, &output.z };
+
+		const UINT32 outputIdx = 0;
+		evaluate(type, time, loop, &track, &outputIdx, 1, components);
+
+		return output;
+	}
+
+	Quaternion CompressedAnimationCurves::evaluateRotation(UINT32 track, float time, bool loop) const
+	{
+		Quaternion output;
+		float* components[] = { &output.x, &output.y, &output.z, &output.w };
+
+		const UINT32 outputIdx = 0;
+		evaluate(CurveType::Rotation, time, loop, &track, &outputIdx, 1, components);
+
+		output.normalize();
+		return output;
+	}
+
+	UINT32 CompressedAnimationCurves::getNumTracks(CurveType type) const
+	{
+		return mNumTracks[getTypeIndex(type)];
+	}
+
+	UINT32 CompressedAnimationCurves::getMemoryUsage() const
+	{
+		return (UINT32)(sizeof(*this) + mHeaders.size() * sizeof(CompressedTrackHeader) + mData.size());
+	}
+
+	void CompressedAnimationCurves::findSegment(float time, bool loop, UINT32& segmentIdx, float& frame,
+		UINT32& numFrames) const
+	{
+		if(mNumFrames <= 1)
+		{
+			segmentIdx = 0;
+			frame = 0.0f;
+			numFrames = 0;
+			return;
+		}
+
+		AnimationUtility::wrapTime(time, 0.0f, mLength, loop);
+
+		const UINT32 lastFrame = mNumFrames - 1;
+		const float globalFrame = Math::clamp(time * mFrameRate, 0.0f, (float)lastFrame);
+
+		segmentIdx = std::min((UINT32)globalFrame / mSegmentLength, mNumSegments - 1);
+
+		const UINT32 segmentStart = segmentIdx * mSegmentLength;
+		frame = globalFrame - (float)segmentStart;
+		numFrames = std::min(mSegmentLength, lastFrame - segmentStart);
+	}
+
+	SPtr<CompressedAnimationCurves> CompressedAnimationCurves::create(const AnimationCurves& curves, float length,
+		UINT32 sampleRate, const ANIMATION_COMPRESSION_DESC& desc)
+	{
+		if(desc.sampleRate > 0)
+			sampleRate = desc.sampleRate;
+
+		SPtr<CompressedAnimationCurves> output = createEmpty();
+
+		// Frames are spaced uniformly so that the last frame lands exactly on the end of the clip
+		const UINT32 numIntervals = length > 0.0f ? std::max(Math::ceilToInt(length * sampleRate - 0.001f), 1) : 0;
+
+		output->mLength = length;
+		output->mNumFrames = numIntervals + 1;
+		output->mFrameRate = length > 0.0f ? numIntervals / length : 0.0f;
+		output->mSegmentLength = Math::clamp(desc.segmentLength, 1U, MAX_SEGMENT_LENGTH);
+		output->mNumSegments = std::max(Math::divideAndRoundUp(numIntervals, output->mSegmentLength), 1U);
+		output->mNumTracks[0] = (UINT32)curves.position.size();
+		output->mNumTracks[1] = (UINT32)curves.rotation.size();
+		output->mNumTracks[2] = (UINT32)curves.scale.size();
+
+		const UINT32 numTracks = output->mNumTracks[0] + output->mNumTracks[1] + output->mNumTracks[2];
+		output->mHeaders.resize(numTracks * output->mNumSegments);
+
+		const float timeStep = numIntervals > 0 ? length / numIntervals : 0.0f;
+		auto sampleTrack = [&](const auto& curve, auto* samples)
+		{
+			for(UINT32 i = 0; i < output->mNumFrames; i++)
+			{
+				const float time = i == numIntervals ? length : i * timeStep;
+				samples[i] = curve.evaluate(time, false);
+			}
+		};
+
+		bs_frame_mark();
+		{
+			FrameVector<Vector3> vectorSamples(output->mNumFrames);
+			FrameVector<Quaternion> rotationSamples(output->mNumFrames);
+
+			// Encode track by track and sort the data by segment afterwards, so the samples of a track are only
+			// generated once
+			FrameVector<FrameVector<UINT8>> segmentData(output->mNumSegments);
+			Vector<UINT8> trackData;
+
+			UINT32 trackIdx = 0;
+			auto encodeTrack = [&](auto& samples, float tolerance, auto encode)
+			{
+				for(UINT32 i = 0; i < output->mNumSegments; i++)
+				{
+					const UINT32 segmentStart = i * output->mSegmentLength;
+					const UINT32 numFrames = std::min(output->mSegmentLength, numIntervals - segmentStart);
+
+					trackData.clear();
+					CompressedTrackHeader header = encode(&samples[segmentStart], numFrames, tolerance, trackData);
+
+					FrameVector<UINT8>& data = segmentData[i];
+					header.offset = (UINT32)data.size();
+					data.insert(data.end(), trackData.begin(), trackData.end());
+
+					output->mHeaders[i * numTracks + trackIdx] = header;
+				}
+
+				trackIdx++;
+			};
+
+			for(auto& entry : curves.position)
+			{
+				sampleTrack(entry.curve, vectorSamples.data());
+				encodeTrack(vectorSamples, desc.positionTolerance, &encodeVectorSegment);
+			}
+
+			for(auto& entry : curves.rotation)
+			{
+				sampleTrack(entry.curve, rotationSamples.data());
+
+				// Keep neighbouring samples in the same hemisphere, so interpolation between them takes the short path
+				for(UINT32 i = 0; i < output->mNumFrames; i++)
+				{
+					rotationSamples[i].normalize();
+
+					if(i > 0 && rotationSamples[i].dot(rotationSamples[i - 1]) < 0.0f)
+						rotationSamples[i] = -rotationSamples[i];
+				}
+
+				encodeTrack(rotationSamples, desc.rotationTolerance, &encodeRotationSegment);
+			}
+
+			for(auto& entry : curves.scale)
+			{
+				sampleTrack(entry.curve, vectorSamples.data());
+				encodeTrack(vectorSamples, desc.scaleTolerance, &encodeVectorSegment);
+			}
+
+			// Lay out the segments one after another, in time order
+			for(UINT32 i = 0; i < output->mNumSegments; i++)
+			{
+				const UINT32 segmentOffset = (UINT32)output->mData.size();
+				for(UINT32 j = 0; j < numTracks; j++)
+					output->mHeaders[i * numTracks + j].offset += segmentOffset;
+
+				output->mData.insert(output->mData.end(), segmentData[i].begin(), segmentData[i].end());
+			}
+
+			// Decoder reads keys in 8 byte chunks
+			output->mData.insert(output->mData.end(), DATA_PADDING, 0);
+		}
+		bs_frame_clear();
+
+		return output;
+	}
+
+	UINT32 CompressedAnimationCurves::getMemoryUsage(const AnimationCurves& curves)
+	{
+		UINT32 size = 0;
+		for(auto& entry : curves.position)
+			size += sizeof(entry) + entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Vector3>);
+
+		for(auto& entry : curves.rotation)
+			size += sizeof(entry) + entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Quaternion>);
+
+		for(auto& entry : curves.scale)
+			size += sizeof(entry) + entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Vector3>);
+
+		return size;
+	}
+
+	SPtr<CompressedAnimationCurves> CompressedAnimationCurves::createEmpty()
+	{
+		CompressedAnimationCurves* raw = new (bs_alloc<CompressedAnimationCurves>()) CompressedAnimationCurves();
+		return bs_shared_ptr(raw);
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTIStatic()
+	{
+		return CompressedAnimationCurvesRTTI::instance();
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTI() const
+	{
+		return CompressedAnimationCurves::getRTTIStatic();
+	}
+}
@@ -0,0 +1,149 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsIReflectable.h"
+#include "Animation/BsAnimationClip.h"
+
+namespace bs
+{
+	/** @addtogroup Animation
+	 *  @{
+	 */
+
+	/** Settings controlling how are animation curves compressed. */
+	struct ANIMATION_COMPRESSION_DESC
+	{
+		/** Maximum allowed error in position values, per component. */
+		float positionTolerance = 0.0001f;
+
+		/** Maximum allowed error in rotation values, per quaternion component. */
+		float rotationTolerance = 0.0001f;
+
+		/** Maximum allowed error in scale values, per component. */
+		float scaleTolerance = 0.0001f;
+
+		/** Rate at which the curves are sampled, in frames per second. If zero, the clip's own sample rate is used. */
+		UINT32 sampleRate = 0;
+
+		/**
+		 * Number of frames grouped in a single segment. Key reduction is performed separately for each segment, so
+		 * shorter segments adapt better to local changes in the curve, at the cost of some per-segment overhead.
+		 */
+		UINT32 segmentLength = 16;
+	};
+
+	/** @} */
+
+	/** @addtogroup Animation-Internal
+	 *  @{
+	 */
+
+	/** Describes where are the keys of a single track stored within a single segment of CompressedAnimationCurves. */
+	struct CompressedTrackHeader
+	{
+		UINT32 offset; /**< Offset of the track data, in bytes, from the start of the data buffer. */
+		UINT16 keyLevel; /**< Keys are placed every (numFrames >> keyLevel) frames. 0xFFFF if the track is constant. */
+		UINT16 numKeys; /**< Number of keys stored for the track in the segment. */
+	};
+
+	/** @cond SPECIALIZATIONS */
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedTrackHeader);
+	/** @endcond */
+
+	/**
+	 * Compact representation of the position, rotation and scale curves of an AnimationClip.
+	 *
+	 * Curves are resampled at a fixed rate and split into time-sorted segments of a fixed number of frames, so sampling
+	 * at a specific time only ever touches the data of a single segment. Within a segment every track keeps only every
+	 * N-th frame (or a single value if the track is constant), where N is the largest step for which linear
+	 * interpolation between the kept frames remains within the provided error tolerance.
+	 *
+	 * Rotations are stored as smallest-three quantized quaternions in 48 bits, while positions and scales are stored as
+	 * 16-bit fixed point values, relative to the range of values of the track within the segment.
+	 *
+	 * Tracks are indexed the same as the curves in AnimationCurves they were created from.
+	 */
+	class BS_CORE_EXPORT CompressedAnimationCurves : public IReflectable
+	{
+	public:
+		/**
+		 * Evaluates a set of tracks of the same type at the specified time. Multiple tracks are decompressed at once,
+		 * so prefer to evaluate as many tracks as possible in a single call.
+		 *
+		 * @param[in]	type			Type of tracks to evaluate. Only position, rotation and scale are supported.
+		 * @param[in]	time			Time to evaluate the tracks at.
+		 * @param[in]	loop			If true the time will wrap around the clip length, otherwise it will be clamped.
+		 * @param[in]	tracks			Indices of the tracks to evaluate.
+		 * @param[in]	outputIndices	Index at which to write the result of each track, in the output arrays.
+		 * @param[in]	count			Number of entries in @p tracks and @p outputIndices.
+		 * @param[out]	output			One array per value component (three for vectors, four for quaternions, in
+		 *								x, y, z, w order) the results will be written to.
+		 */
+		void evaluate(CurveType type, float time, bool loop, const UINT32* tracks, const UINT32* outputIndices,
+			UINT32 count, float* const* output) const;
+
+		/** Evaluates a single position or scale track at the specified time. */
+		Vector3 evaluateVector(CurveType type, UINT32 track, float time, bool loop) const;
+
+		/** Evaluates a single rotation track at the specified time. */
+		Quaternion evaluateRotation(UINT32 track, float time, bool loop) const;
+
+		/** Returns the number of tracks of the specified type. */
+		UINT32 getNumTracks(CurveType type) const;
+
+		/** Returns the number of bytes used by the compressed curves. */
+		UINT32 getMemoryUsage() const;
+
+		/**
+		 * Compresses the provided curves.
+		 *
+		 * @param[in]	curves		Curves to compress. Generic curves are ignored.
+		 * @param[in]	length		Length of the animation, in seconds.
+		 * @param[in]	sampleRate	Rate at which to sample the curves, used if not overriden by @p desc.
+		 * @param[in]	desc		Settings controlling the compression.
+		 */
+		static SPtr<CompressedAnimationCurves> create(const AnimationCurves& curves, float length, UINT32 sampleRate,
+			const ANIMATION_COMPRESSION_DESC& desc = ANIMATION_COMPRESSION_DESC());
+
+		/** Returns the number of bytes used by the keyframes of the position, rotation and scale curves. */
+		static UINT32 getMemoryUsage(const AnimationCurves& curves);
+
+	private:
+		CompressedAnimationCurves() = default;
+
+		/**
+		 * Maps the provided time to a segment and a frame position relative to the start of the segment. Also returns
+		 * the number of frames in the segment.
+		 */
+		void findSegment(float time, bool loop, UINT32& segmentIdx, float& frame, UINT32& numFrames) const;
+
+		float mLength = 0.0f;
+		float mFrameRate = 0.0f;
+		UINT32 mNumFrames = 0;
+		UINT32 mSegmentLength = 0;
+		UINT32 mNumSegments = 0;
+		UINT32 mNumTracks[3] = { 0, 0, 0 };
+
+		Vector<CompressedTrackHeader> mHeaders;
+		Vector<UINT8> mData;
+
+		/************************************************************************/
+		/* 								SERIALIZATION                      		*/
+		/************************************************************************/
+	public:
+		friend class CompressedAnimationCurvesRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+
+		/**
+		 * Creates CompressedAnimationCurves with no data. You must populate its data manually.
+		 *
+		 * @note	For serialization use only.
+		 */
+		static SPtr<CompressedAnimationCurves> createEmpty();
+	};
+
+	/** @} */
+}
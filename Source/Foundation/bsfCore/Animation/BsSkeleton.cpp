@@ -2,11 +2,60 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Animation/BsSkeleton.h"
 #include "Animation/BsAnimationClip.h"
+#include "Animation/BsCompressedAnimationCurves.h"
 #include "Animation/BsSkeletonMask.h"
+#include "Math/BsSIMD.h"
 #include "Private/RTTI/BsSkeletonRTTI.h"
 
 namespace bs
 {
+	/** Number of bones processed by a single SIMD operation during pose evaluation. */
+	static constexpr UINT32 POSE_BATCH_SIZE = 8;
+
+	/** Rounds the number of bones up to a multiple of POSE_BATCH_SIZE. */
+	static UINT32 getPaddedBoneCount(UINT32 numBones)
+	{
+		return ((numBones + POSE_BATCH_SIZE - 1) / POSE_BATCH_SIZE) * POSE_BATCH_SIZE;
+	}
+
+	/** 
+	 * Provides access to a local skeleton pose stored in structure-of-arrays layout. Each component is a separate array
+	 * of padded bone count entries, in order: position xyz, rotation xyzw, scale xyz.
+	 */
+	struct PoseSoA
+	{
+		static constexpr UINT32 NUM_COMPONENTS = 10;
+
+		PoseSoA(float* data, UINT32 stride)
+		{
+			for(UINT32 i = 0; i < 3; i++)
+				position[i] = data + stride * i;
+
+			for(UINT32 i = 0; i < 4; i++)
+				rotation[i] = data + stride * (3 + i);
+
+			for(UINT32 i = 0; i < 3; i++)
+				scale[i] = data + stride * (7 + i);
+		}
+
+		float* position[3];
+		float* rotation[4];
+		float* scale[3];
+	};
+
+	/** Calculates 1 / length of a set of quaternions. */
+	static simd::float32x8 invLength(const simd::float32x8 (&q)[4])
+	{
+		using namespace simd;
+
+		float32x8 sqrdLength = mul(q[0], q[0]);
+		sqrdLength = add(sqrdLength, mul(q[1], q[1]));
+		sqrdLength = add(sqrdLength, mul(q[2], q[2]));
+		sqrdLength = add(sqrdLength, mul(q[3], q[3]));
+
+		return div(splat<float32x8>(1.0f), sqrt(sqrdLength));
+	}
+
 	LocalSkeletonPose::LocalSkeletonPose()
 		: positions(nullptr), rotations(nullptr), scales(nullptr), hasOverride(nullptr), numBones(0)
 	{ }
@@ -98,6 +147,8 @@ namespace bs
 			mBoneInfo[i].name = bones[i].name;
 			mBoneInfo[i].parent = bones[i].parent;
 		}
+
+		buildEvaluationData();
 	}
 
 	Skeleton::~Skeleton()
@@ -110,6 +161,12 @@ namespace bs
 
 		if (mBoneInfo != nullptr)
 			bs_deleteN(mBoneInfo, mNumBones);
+
+		if (mBoneOrder != nullptr)
+			bs_free(mBoneOrder);
+
+		if (mBindPoseSoA != nullptr)
+			bs_free(mBindPoseSoA);
 	}
 
 	SPtr<Skeleton> Skeleton::create(BONE_DESC* bones, UINT32 numBones)
@@ -128,6 +185,7 @@ namespace bs
 
 			AnimationState state;
 			state.curves = clip.getCurves();
+			state.compressedCurves = clip.getCompressedCurves();
 			state.boneToCurveMapping = boneToCurveMapping.data();
 			state.loop = loop;
 			state.weight = 1.0f;
@@ -159,23 +217,93 @@ namespace bs
 	void Skeleton::getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask, 
 		const AnimationStateLayer* layers, UINT32 numLayers)
 	{
-		// Note: If more performance is required this method could be optimized with vector instructions
+		using namespace simd;
 
 		assert(localPose.numBones == mNumBones);
 
+		if(mNumBones == 0)
+			return;
+
+		// All per-bone data is kept in structure-of-arrays layout so it can be processed POSE_BATCH_SIZE bones at a time.
+		// Data is indexed by bone index, padded to a multiple of the batch size.
+		const UINT32 stride = getPaddedBoneCount(mNumBones);
+		const UINT32 numFloats = stride * PoseSoA::NUM_COMPONENTS * 2;
+		const UINT32 numMasks = stride * 2;
+
+		float* poseData = bs_stack_alloc<float>(numFloats);
+		UINT32* maskData = bs_stack_alloc<UINT32>(numMasks);
+		UINT32* activeBones = bs_stack_alloc<UINT32>(mNumBones);
+		UINT32* sampledTracks = bs_stack_alloc<UINT32>(mNumBones * 2); // Track and bone indices, for compressed curves
+
+		PoseSoA output(poseData, stride);
+		PoseSoA sample(poseData + stride * PoseSoA::NUM_COMPONENTS, stride);
+
+		UINT32* hasAnimCurve = maskData; // All bits set if any curve affected the bone
+		UINT32* hasSample = maskData + stride; // All bits set if the bone was sampled by the current curve set
+
+		memset(poseData, 0, sizeof(float) * numFloats);
+		memset(hasAnimCurve, 0, sizeof(UINT32) * stride);
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			for(UINT32 j = 0; j < stride; j += POSE_BATCH_SIZE)
+				store_u(&output.scale[i][j], splat<float32x8>(1.0f));
+		}
+
+		// Only iterate over enabled bones when evaluating curves
+		UINT32 numActiveBones = 0;
 		for(UINT32 i = 0; i < mNumBones; i++)
 		{
-			localPose.positions[i] = Vector3::ZERO;
-			localPose.rotations[i] = Quaternion::ZERO;
-			localPose.scales[i] = Vector3::ONE;
+			if (mask.isEnabled(i))
+				activeBones[numActiveBones++] = i;
 		}
 
-		bool* hasAnimCurve = bs_stack_alloc<bool>(mNumBones);
-		bs_zero_out(hasAnimCurve, mNumBones);
+		// Samples the curves referenced by the mapping member @p mappingField for all active bones, and writes the results
+		// into the sample pose. Returns the number of sampled curves.
+		auto sampleCurves = [&](CurveType type, auto& curves, auto* caches, UINT32 AnimationCurveMapping::* mappingField,
+			const AnimationState& state, float** sampleOutput, UINT32 numComponents)
+		{
+			memset(hasSample, 0, sizeof(UINT32) * stride);
+
+			const bool isCompressed = state.compressedCurves != nullptr;
+			UINT32* trackIndices = sampledTracks;
+			UINT32* trackBones = sampledTracks + mNumBones;
+
+			UINT32 numCurves = 0;
+			for(UINT32 i = 0; i < numActiveBones; i++)
+			{
+				const UINT32 boneIdx = activeBones[i];
+				const UINT32 curveIdx = state.boneToCurveMapping[boneIdx].*mappingField;
+				if (curveIdx == (UINT32)-1)
+					continue;
+
+				// Compressed tracks are gathered and decompressed all at once below
+				if(isCompressed)
+				{
+					trackIndices[numCurves] = curveIdx;
+					trackBones[numCurves] = boneIdx;
+				}
+				else
+				{
+					const auto value = curves[curveIdx].curve.evaluate(state.time, caches[curveIdx], state.loop);
+					for(UINT32 j = 0; j < numComponents; j++)
+						sampleOutput[j][boneIdx] = value[j];
+				}
+
+				hasSample[boneIdx] = 0xFFFFFFFF;
+				hasAnimCurve[boneIdx] = 0xFFFFFFFF;
+				numCurves++;
+			}
+
+			if(isCompressed && numCurves > 0)
+			{
+				state.compressedCurves->evaluate(type, state.time, state.loop, trackIndices, trackBones, numCurves,
+					sampleOutput);
+			}
+
+			return numCurves;
+		};
 
-		// Note: For a possible performance improvement consider keeping an array of only active (non-disabled) bones and
-		// just iterate over them without mask checks. Possibly also a list of active curve mappings to avoid those checks
-		// as well.
 		for(UINT32 i = 0; i < numLayers; i++)
 		{
 			const AnimationStateLayer& layer = layers[i];
@@ -204,134 +332,294 @@ namespace bs
 				if (Math::approxEquals(normWeight, 0.0f))
 					continue;
 
-				for (UINT32 k = 0; k < mNumBones; k++)
-				{
-					if (!mask.isEnabled(k))
-						continue;
+				const float32x8 weight = splat<float32x8>(normWeight);
+				const float32x8 zero = make_zero();
+				const float32x8 one = splat<float32x8>(1.0f);
 
-					const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-					UINT32 curveIdx = mapping.position;
-					if (curveIdx != (UINT32)-1)
+				// Positions are blended additively
+				if(sampleCurves(CurveType::Position, state.curves->position, state.positionCaches,
+					&AnimationCurveMapping::position, state, sample.position, 3) > 0)
+				{
+					for(UINT32 k = 0; k < stride; k += POSE_BATCH_SIZE)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-						localPose.positions[k] += curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop) * normWeight;
+						const float32x8 enabled = bit_cast<float32x8>(load_u<uint32x8>(&hasSample[k]));
+						for(UINT32 l = 0; l < 3; l++)
+						{
+							const float32x8 value = load_u<float32x8>(&output.position[l][k]);
+							const float32x8 blended = add(value, mul(load_u<float32x8>(&sample.position[l][k]), weight));
 
-						localPose.hasOverride[k] = false;
-						hasAnimCurve[k] = true;
+							store_u(&output.position[l][k], blend(blended, value, enabled));
+						}
 					}
+				}
 
-					curveIdx = mapping.scale;
-					if (curveIdx != (UINT32)-1)
+				// Scales are blended multiplicatively
+				if(sampleCurves(CurveType::Scale, state.curves->scale, state.scaleCaches,
+					&AnimationCurveMapping::scale, state, sample.scale, 3) > 0)
+				{
+					for(UINT32 k = 0; k < stride; k += POSE_BATCH_SIZE)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-						localPose.scales[k] *= curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop) * normWeight;
+						const float32x8 enabled = bit_cast<float32x8>(load_u<uint32x8>(&hasSample[k]));
+						for(UINT32 l = 0; l < 3; l++)
+						{
+							const float32x8 value = load_u<float32x8>(&output.scale[l][k]);
+							const float32x8 blended = mul(value, mul(load_u<float32x8>(&sample.scale[l][k]), weight));
 
-						localPose.hasOverride[k] = false;
-						hasAnimCurve[k] = true;
+							store_u(&output.scale[l][k], blend(blended, value, enabled));
+						}
 					}
+				}
 
-					if (layer.additive)
-					{
-						curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
-						{
-							bool isAssigned = localPose.rotations[k].w != 0.0f;
-							if (!isAssigned)
-								localPose.rotations[k] = Quaternion::IDENTITY;
+				if(sampleCurves(CurveType::Rotation, state.curves->rotation, state.rotationCaches,
+					&AnimationCurveMapping::rotation, state, sample.rotation, 4) == 0)
+					continue;
 
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+				for(UINT32 k = 0; k < stride; k += POSE_BATCH_SIZE)
+				{
+					const float32x8 enabled = bit_cast<float32x8>(load_u<uint32x8>(&hasSample[k]));
 
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-							value = Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
+					float32x8 value[4];
+					float32x8 rotation[4];
+					for(UINT32 l = 0; l < 4; l++)
+					{
+						value[l] = load_u<float32x8>(&output.rotation[l][k]);
+						rotation[l] = load_u<float32x8>(&sample.rotation[l][k]);
+					}
 
-							localPose.rotations[k] *= value;
-							localPose.hasOverride[k] = false;
-							hasAnimCurve[k] = true;
-						}
+					float32x8 blended[4];
+					if (layer.additive)
+					{
+						// Rotations not assigned yet start from identity
+						const mask_float32x8 isAssigned = cmp_neq(value[3], zero);
+						for(UINT32 l = 0; l < 3; l++)
+							value[l] = blend(value[l], zero, isAssigned);
+
+						value[3] = blend(value[3], one, isAssigned);
+
+						// Lerp from identity to the sampled rotation, along the shortest path, and normalize
+						const float32x8 flip = blend(one, neg(one), cmp_ge(rotation[3], zero));
+						for(UINT32 l = 0; l < 3; l++)
+							rotation[l] = mul(rotation[l], weight);
+
+						rotation[3] = add(mul(flip, sub(one, weight)), mul(rotation[3], weight));
+
+						const float32x8 rotationInvLength = invLength(rotation);
+						for(UINT32 l = 0; l < 4; l++)
+							rotation[l] = mul(rotation[l], rotationInvLength);
+
+						// Apply on top of the existing rotation (value * rotation)
+						const float32x8& x0 = value[0]; const float32x8& y0 = value[1];
+						const float32x8& z0 = value[2]; const float32x8& w0 = value[3];
+						const float32x8& x1 = rotation[0]; const float32x8& y1 = rotation[1];
+						const float32x8& z1 = rotation[2]; const float32x8& w1 = rotation[3];
+
+						blended[0] = sub(add(add(mul(w0, x1), mul(x0, w1)), mul(y0, z1)), mul(z0, y1));
+						blended[1] = sub(add(add(mul(w0, y1), mul(y0, w1)), mul(z0, x1)), mul(x0, z1));
+						blended[2] = sub(add(add(mul(w0, z1), mul(z0, w1)), mul(x0, y1)), mul(y0, x1));
+						blended[3] = sub(sub(sub(mul(w0, w1), mul(x0, x1)), mul(y0, y1)), mul(z0, z1));
 					}
 					else
 					{
-						curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
+						// Accumulate weighted rotations, flipping the ones in the opposite hemisphere
+						float32x8 dot = zero;
+						for(UINT32 l = 0; l < 4; l++)
 						{
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop) * normWeight;
-
-							if (value.dot(localPose.rotations[k]) < 0.0f)
-								value = -value;
-
-							localPose.rotations[k] += value;
-							localPose.hasOverride[k] = false;
-							hasAnimCurve[k] = true;
+							rotation[l] = mul(rotation[l], weight);
+							dot = add(dot, mul(rotation[l], value[l]));
 						}
+
+						const float32x8 flip = blend(neg(one), one, cmp_lt(dot, zero));
+						for(UINT32 l = 0; l < 4; l++)
+							blended[l] = add(value[l], mul(rotation[l], flip));
 					}
+
+					for(UINT32 l = 0; l < 4; l++)
+						store_u(&output.rotation[l][k], blend(blended[l], value[l], enabled));
 				}
 			}
 		}
 
-		// Apply default local tranform to non-animated bones (so that any potential child bones are transformed properly)
-		for(UINT32 i = 0; i < mNumBones; i++)
+		// Apply default local tranform to non-animated bones (so that any potential child bones are transformed properly),
+		// and normalize the rotations
+		PoseSoA bindPose(mBindPoseSoA, stride);
+		const float32x8 zero = make_zero();
+		for(UINT32 i = 0; i < stride; i += POSE_BATCH_SIZE)
 		{
-			if(hasAnimCurve[i])
-				continue;
+			const float32x8 animated = bit_cast<float32x8>(load_u<uint32x8>(&hasAnimCurve[i]));
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				store_u(&output.position[j][i], blend(load_u<float32x8>(&output.position[j][i]),
+					load_u<float32x8>(&bindPose.position[j][i]), animated));
+
+				store_u(&output.scale[j][i], blend(load_u<float32x8>(&output.scale[j][i]),
+					load_u<float32x8>(&bindPose.scale[j][i]), animated));
+			}
+
+			float32x8 rotation[4];
+			for(UINT32 j = 0; j < 4; j++)
+			{
+				rotation[j] = blend(load_u<float32x8>(&output.rotation[j][i]), 
+					load_u<float32x8>(&bindPose.rotation[j][i]), animated);
+			}
+
+			const mask_float32x8 isAssigned = cmp_neq(rotation[3], zero);
+			const float32x8 rotationInvLength = invLength(rotation);
 
-			localPose.positions[i] = mBoneTransforms[i].getPosition();
-			localPose.rotations[i] = mBoneTransforms[i].getRotation();
-			localPose.scales[i] = mBoneTransforms[i].getScale();
+			for(UINT32 j = 0; j < 3; j++)
+				store_u(&output.rotation[j][i], blend(mul(rotation[j], rotationInvLength), zero, isAssigned));
+
+			store_u(&output.rotation[3][i], blend(mul(rotation[3], rotationInvLength), splat<float32x8>(1.0f), 
+				isAssigned));
 		}
 
-		// Calculate local pose matrices
-		UINT32 isGlobalBytes = sizeof(bool) * mNumBones;
-		bool* isGlobal = (bool*)bs_stack_alloc(isGlobalBytes);
-		memset(isGlobal, 0, isGlobalBytes);
+		// Bones affected by animation curves cannot be overriden
+		for(UINT32 i = 0; i < mNumBones; i++)
+		{
+			if (hasAnimCurve[i])
+				localPose.hasOverride[i] = false;
+		}
 
+		// Output the local pose
 		for(UINT32 i = 0; i < mNumBones; i++)
 		{
-			bool isAssigned = localPose.rotations[i].w != 0.0f;
-			if (!isAssigned)
-				localPose.rotations[i] = Quaternion::IDENTITY;
-			else
-				localPose.rotations[i].normalize();
+			localPose.positions[i] = Vector3(output.position[0][i], output.position[1][i], output.position[2][i]);
+			localPose.rotations[i] = Quaternion(output.rotation[3][i], output.rotation[0][i], output.rotation[1][i], 
+				output.rotation[2][i]);
+			localPose.scales[i] = Vector3(output.scale[0][i], output.scale[1][i], output.scale[2][i]);
+		}
 
-			if (localPose.hasOverride[i])
+		// Calculate local pose matrices (overriden bones are provided by the caller, in global space)
+		for(UINT32 i = 0; i < stride; i += POSE_BATCH_SIZE)
+		{
+			const float32x8 x = load_u<float32x8>(&output.rotation[0][i]);
+			const float32x8 y = load_u<float32x8>(&output.rotation[1][i]);
+			const float32x8 z = load_u<float32x8>(&output.rotation[2][i]);
+			const float32x8 w = load_u<float32x8>(&output.rotation[3][i]);
+
+			const float32x8 tx = add(x, x);
+			const float32x8 ty = add(y, y);
+			const float32x8 tz = add(z, z);
+			const float32x8 twx = mul(tx, w);
+			const float32x8 twy = mul(ty, w);
+			const float32x8 twz = mul(tz, w);
+			const float32x8 txx = mul(tx, x);
+			const float32x8 txy = mul(ty, x);
+			const float32x8 txz = mul(tz, x);
+			const float32x8 tyy = mul(ty, y);
+			const float32x8 tyz = mul(tz, y);
+			const float32x8 tzz = mul(tz, z);
+
+			const float32x8 one = splat<float32x8>(1.0f);
+			const float32x8 rot[3][3] =
 			{
-				isGlobal[i] = true;
-				continue;
+				{ sub(one, add(tyy, tzz)), sub(txy, twz), add(txz, twy) },
+				{ add(txy, twz), sub(one, add(txx, tzz)), sub(tyz, twx) },
+				{ sub(txz, twy), add(tyz, twx), sub(one, add(txx, tyy)) }
+			};
+
+			// Rows of the 3x4 part of the matrix, for each bone in the batch
+			SIMDPP_ALIGN(32) float rows[3][4][POSE_BATCH_SIZE];
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				for(UINT32 k = 0; k < 3; k++)
+					store(rows[j][k], mul(rot[j][k], load_u<float32x8>(&output.scale[k][i])));
+
+				store(rows[j][3], load_u<float32x8>(&output.position[j][i]));
+			}
+
+			const UINT32 numInBatch = std::min(POSE_BATCH_SIZE, mNumBones - i);
+			for(UINT32 j = 0; j < numInBatch; j++)
+			{
+				const UINT32 boneIdx = i + j;
+				if (localPose.hasOverride[boneIdx])
+					continue;
+
+				pose[boneIdx] = Matrix4(
+					rows[0][0][j], rows[0][1][j], rows[0][2][j], rows[0][3][j],
+					rows[1][0][j], rows[1][1][j], rows[1][2][j], rows[1][3][j],
+					rows[2][0][j], rows[2][1][j], rows[2][2][j], rows[2][3][j],
+					0.0f, 0.0f, 0.0f, 1.0f);
 			}
+		}
+
+		// Calculate global poses. Parents always come before children, so this can be done in a single pass.
+		for (UINT32 i = 0; i < mNumBones; i++)
+		{
+			const UINT32 boneIdx = mBoneOrder[i];
+			const UINT32 parentBoneIdx = mBoneInfo[boneIdx].parent;
+
+			if (localPose.hasOverride[boneIdx] || parentBoneIdx == (UINT32)-1)
+				continue;
 
-			pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
+			simd::multiply(pose[parentBoneIdx], pose[boneIdx], pose[boneIdx]);
 		}
 
-		// Calculate global poses
-		// Note: For a possible performance improvement consider sorting bones in such order so that parents (and overrides)
-		// always come before children, we no isGlobal check is needed.
-		std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+		for (UINT32 i = 0; i < mNumBones; i++)
+			simd::multiply(pose[i], mInvBindPoses[i], pose[i]);
+
+		bs_stack_free(sampledTracks);
+		bs_stack_free(activeBones);
+		bs_stack_free(maskData);
+		bs_stack_free(poseData);
+	}
+
+	void Skeleton::buildEvaluationData()
+	{
+		if(mBoneOrder != nullptr)
+			bs_free(mBoneOrder);
+
+		if(mBindPoseSoA != nullptr)
+			bs_free(mBindPoseSoA);
+
+		mBoneOrder = nullptr;
+		mBindPoseSoA = nullptr;
+
+		if(mNumBones == 0)
+			return;
+
+		// Sort bones by their depth in the hierarchy, so parents are always evaluated before children
+		Vector<UINT32> depths(mNumBones);
+		for(UINT32 i = 0; i < mNumBones; i++)
 		{
-			UINT32 parentBoneIdx = mBoneInfo[boneIdx].parent;
-			if (parentBoneIdx == (UINT32)-1)
+			UINT32 depth = 0;
+			UINT32 parent = mBoneInfo[i].parent;
+			while(parent != (UINT32)-1 && depth < mNumBones)
 			{
-				isGlobal[boneIdx] = true;
-				return;
+				parent = mBoneInfo[parent].parent;
+				depth++;
 			}
 
-			if (!isGlobal[parentBoneIdx])
-				calcGlobal(parentBoneIdx);
+			depths[i] = depth;
+		}
+
+		mBoneOrder = (UINT32*)bs_alloc(sizeof(UINT32) * mNumBones);
+		for(UINT32 i = 0; i < mNumBones; i++)
+			mBoneOrder[i] = i;
 
-			pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
-			isGlobal[boneIdx] = true;
-		};
+		std::stable_sort(mBoneOrder, mBoneOrder + mNumBones, 
+			[&depths](UINT32 lhs, UINT32 rhs) { return depths[lhs] < depths[rhs]; });
 
-		for (UINT32 i = 0; i < mNumBones; i++)
+		// Store the bind pose in SIMD friendly format
+		const UINT32 stride = getPaddedBoneCount(mNumBones);
+		mBindPoseSoA = (float*)bs_alloc(sizeof(float) * stride * PoseSoA::NUM_COMPONENTS);
+		memset(mBindPoseSoA, 0, sizeof(float) * stride * PoseSoA::NUM_COMPONENTS);
+
+		PoseSoA bindPose(mBindPoseSoA, stride);
+		for(UINT32 i = 0; i < mNumBones; i++)
 		{
-			if (!isGlobal[i])
-				calcGlobal(i);
-		}
+			const Vector3& position = mBoneTransforms[i].getPosition();
+			const Quaternion& rotation = mBoneTransforms[i].getRotation();
+			const Vector3& scale = mBoneTransforms[i].getScale();
 
-		for (UINT32 i = 0; i < mNumBones; i++)
-			pose[i] = pose[i] * mInvBindPoses[i];
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				bindPose.position[j][i] = position[j];
+				bindPose.scale[j][i] = scale[j];
+			}
 
-		bs_stack_free(isGlobal);
-		bs_stack_free(hasAnimCurve);
+			for(UINT32 j = 0; j < 4; j++)
+				bindPose.rotation[j][i] = rotation[j];
+		}
 	}
 
 	UINT32 Skeleton::getRootBoneIndex() const
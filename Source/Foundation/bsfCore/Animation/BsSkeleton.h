@@ -43,6 +43,7 @@ namespace bs
 	struct AnimationState
 	{
 		SPtr<AnimationCurves> curves; /**< All curves in the animation clip. */
+		SPtr<CompressedAnimationCurves> compressedCurves; /**< Compressed clip curves, if available. */
 		AnimationCurveMapping* boneToCurveMapping; /**< Mapping of bone indices to curve indices for quick lookup .*/
 		AnimationCurveMapping* soToCurveMapping; /**< Mapping of scene object indices to curve indices for quick lookup. */
 
@@ -177,11 +178,26 @@ namespace bs
 		Skeleton();
 		Skeleton(BONE_DESC* bones, UINT32 numBones);
 
+		/** 
+		 * Builds data used for speeding up pose evaluation: the parent-first bone order and the local bind pose in
+		 * structure-of-arrays layout. Must be called whenever the bone data changes.
+		 */
+		void buildEvaluationData();
+
 		UINT32 mNumBones = 0;
 		Transform* mBoneTransforms = nullptr;
 		Matrix4* mInvBindPoses = nullptr;
 		SkeletonBoneInfo* mBoneInfo = nullptr;
 
+		/** Indices of all bones, sorted so that parents always come before their children. */
+		UINT32* mBoneOrder = nullptr;
+
+		/** 
+		 * Local bind pose of all bones, with each component (position xyz, rotation xyzw, scale xyz) stored in a separate
+		 * array, padded to a multiple of the SIMD batch size.
+		 */
+		float* mBindPoseSoA = nullptr;
+
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
 		/************************************************************************/
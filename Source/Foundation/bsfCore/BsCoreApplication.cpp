@@ -16,6 +16,7 @@
 #include "Utility/BsDynLib.h"
 #include "Utility/BsDynLibManager.h"
 #include "Scene/BsSceneManager.h"
+#include "Scene/BsTransformStorage.h"
 #include "Importer/BsImporter.h"
 #include "Resources/BsResources.h"
 #include "Mesh/BsMesh.h"
@@ -72,6 +73,9 @@ namespace bs
 		ProfilerGPU::shutDown();
 
 		SceneManager::shutDown();
+
+		if (TransformStorage::isStarted())
+			TransformStorage::shutDown();
 		
 		Input::shutDown();
 
@@ -113,6 +117,7 @@ namespace bs
 		CoreThread::shutDown();
 		RenderStats::shutDown();
 		TaskScheduler::shutDown();
+		JobScheduler::shutDown();
 		ThreadPool::shutDown();
 		ProfilingManager::shutDown();
 		ProfilerCPU::shutDown();
@@ -136,7 +141,10 @@ namespace bs
 		MessageHandler::startUp();
 		ProfilerCPU::startUp();
 		ProfilingManager::startUp();
-		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>((numWorkerThreads));
+		// Job scheduler keeps one persistent worker per core, on top of any threads ran directly through the pool
+		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(numWorkerThreads, 
+			BS_THREAD_HARDWARE_CONCURRENCY + 16);
+		JobScheduler::startUp();
 		TaskScheduler::startUp();
 		TaskScheduler::instance().removeWorker();
 		RenderStats::startUp();
@@ -162,6 +170,9 @@ namespace bs
 
 		loadPlugin(mStartUpDesc.renderer, &mRendererPlugin);
 
+		if (mStartUpDesc.transformStorage)
+			TransformStorage::startUp();
+
 		SceneManager::startUp();
 		RendererManager::instance().setActive(mStartUpDesc.renderer);
 		startUpRenderer();
@@ -278,7 +289,9 @@ namespace bs
 			// animation we sent on the previous frame, and we want the scene information to match to what is displayed.
 			const EvaluatedAnimationData* animData = AnimationManager::instance().update();
 
-			// Send out resource events in case any were loaded/destroyed/modified
+			// Release anything left over by asynchronous resource loads, then send out resource events in case any
+			// were loaded/destroyed/modified
+			gResources()._update();
 			ResourceListenerManager::instance().update();
 
 			// Trigger any renderer task callbacks (should be done before scene object update, or core sync, so objects have
@@ -22,6 +22,7 @@ namespace bs
 		String audio; /**< Name of the audio plugin to use. */
 		String input; /**< Name of the input plugin to use. */
 		bool scripting = false; /**< True to load the scripting system. */
+		bool transformStorage = false; /**< True to keep scene object transforms in the TransformStorage. */
 
 		RENDER_WINDOW_DESC primaryWindowDesc; /**< Describes the window to create during start-up. */
 
@@ -329,6 +329,7 @@ namespace bs
 	class AudioSource;
 	class AudioClipImportOptions;
 	class AnimationClip;
+	class CompressedAnimationCurves;
 	class CCamera;
 	class CRenderable;
 	class CLight;
@@ -363,6 +364,7 @@ namespace bs
 	class Resource;
 	class Resources;
 	class ResourceManifest;
+	class ResourcePack;
 	class Texture;
 	class Mesh;
 	class MeshBase;
@@ -401,6 +403,7 @@ namespace bs
 	struct SPHERICAL_JOINT_DESC;
 	struct D6_JOINT_DESC;
 	struct AUDIO_CLIP_DESC;
+	struct ANIMATION_COMPRESSION_DESC;
 
 	template<class T>
 	class TCoreThreadQueue;
@@ -600,6 +603,7 @@ namespace bs
 		TID_DepthStencilStateDesc = 1152,
 		TID_SerializedGpuProgramData = 1153,
 		TID_SubShader = 1154,
+		TID_CompressedAnimationCurves = 1155,
 
 		// Moved from Engine layer
 		TID_CCamera = 30000,
@@ -82,6 +82,7 @@ set(BS_CORE_INC_SCENE
 	"bsfCore/Scene/BsPrefabUtility.h"
 	"bsfCore/Scene/BsTransform.h"
 	"bsfCore/Scene/BsSceneActor.h"
+	"bsfCore/Scene/BsTransformStorage.h"
 )
 
 set(BS_CORE_INC_INPUT
@@ -122,6 +123,7 @@ set(BS_CORE_SRC_RTTI
 set(BS_CORE_INC_PROFILING
 	"bsfCore/Profiling/BsProfilerCPU.h"
 	"bsfCore/Profiling/BsProfilerGPU.h"
+	"bsfCore/Profiling/BsLatencyHistogram.h"
 	"bsfCore/Profiling/BsProfilingManager.h"
 	"bsfCore/Profiling/BsRenderStats.h"
 )
@@ -205,6 +207,7 @@ set(BS_CORE_INC_MATERIAL
 set(BS_CORE_INC_RESOURCES
 	"bsfCore/Resources/BsResources.h"
 	"bsfCore/Resources/BsResourceManifest.h"
+	"bsfCore/Resources/BsResourcePack.h"
 	"bsfCore/Resources/BsResourceHandle.h"
 	"bsfCore/Resources/BsResource.h"
 	"bsfCore/Resources/BsGpuResourceData.h"
@@ -246,6 +249,7 @@ set(BS_CORE_SRC_PROFILING
 	"bsfCore/Profiling/BsProfilerCPU.cpp"
 	"bsfCore/Profiling/BsProfilerGPU.cpp"
 	"bsfCore/Profiling/BsProfilingManager.cpp"
+	"bsfCore/Profiling/BsLatencyHistogram.cpp"
 )
 
 set(BS_CORE_SRC_COMPONENTS
@@ -354,6 +358,7 @@ set(BS_CORE_INC_RTTI
 	"bsfCore/Private/RTTI/BsCAudioListenerRTTI.h"
 	"bsfCore/Private/RTTI/BsAnimationClipRTTI.h"
 	"bsfCore/Private/RTTI/BsAnimationCurveRTTI.h"
+	"bsfCore/Private/RTTI/BsCompressedAnimationCurvesRTTI.h"
 	"bsfCore/Private/RTTI/BsSkeletonRTTI.h"
 	"bsfCore/Private/RTTI/BsCCameraRTTI.h"
 	"bsfCore/Private/RTTI/BsCameraRTTI.h"
@@ -398,6 +403,7 @@ set(BS_CORE_SRC_RESOURCES
 	"bsfCore/Resources/BsResource.cpp"
 	"bsfCore/Resources/BsResourceHandle.cpp"
 	"bsfCore/Resources/BsResourceManifest.cpp"
+	"bsfCore/Resources/BsResourcePack.cpp"
 	"bsfCore/Resources/BsResources.cpp"
 	"bsfCore/Resources/BsResourceMetaData.cpp"
 	"bsfCore/Resources/BsSavedResourceData.cpp"
@@ -534,6 +540,7 @@ set(BS_CORE_SRC_SCENE
 	"bsfCore/Scene/BsPrefabUtility.cpp"
 	"bsfCore/Scene/BsTransform.cpp"
 	"bsfCore/Scene/BsSceneActor.cpp"
+	"bsfCore/Scene/BsTransformStorage.cpp"
 )
 
 set(BS_CORE_INC_AUDIO
@@ -566,6 +573,7 @@ set(BS_CORE_INC_ANIMATION
 	"bsfCore/Animation/BsAnimationUtility.h"
 	"bsfCore/Animation/BsSkeletonMask.h"
 	"bsfCore/Animation/BsMorphShapes.h"
+	"bsfCore/Animation/BsCompressedAnimationCurves.h"
 )
 
 set(BS_CORE_SRC_ANIMATION
@@ -577,6 +585,7 @@ set(BS_CORE_SRC_ANIMATION
 	"bsfCore/Animation/BsAnimationUtility.cpp"
 	"bsfCore/Animation/BsSkeletonMask.cpp"
 	"bsfCore/Animation/BsMorphShapes.cpp"
+	"bsfCore/Animation/BsCompressedAnimationCurves.cpp"
 )
 
 set(BS_CORE_INC_PARTICLES
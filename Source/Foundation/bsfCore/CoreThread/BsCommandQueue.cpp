@@ -7,12 +7,108 @@
 
 namespace bs
 {
+	constexpr UINT32 CommandBuffer::CHUNK_SIZE;
+
+	CommandBuffer::~CommandBuffer()
+	{
+		clear();
+
+		for(auto& chunk : mChunks)
+			bs_free_aligned16(chunk.data);
+	}
+
+	UINT8* CommandBuffer::allocateCommand(UINT32 size)
+	{
+		size = align(size);
+
+		while(mActiveChunk < (UINT32)mChunks.size())
+		{
+			Chunk& chunk = mChunks[mActiveChunk];
+			if((chunk.size - chunk.used) >= size)
+				break;
+
+			mActiveChunk++;
+		}
+
+		if(mActiveChunk == (UINT32)mChunks.size())
+		{
+			Chunk chunk;
+			chunk.size = std::max(size, CHUNK_SIZE);
+			chunk.data = (UINT8*)bs_alloc_aligned16(chunk.size);
+			chunk.used = 0;
+
+			mChunks.push_back(chunk);
+		}
+
+		Chunk& chunk = mChunks[mActiveChunk];
+		UINT8* data = chunk.data + chunk.used;
+		chunk.used += size;
+
+		((CommandHeader*)data)->size = size;
+		mNumCommands++;
+
+		return data;
+	}
+
+	void CommandBuffer::execute(const std::function<void(UINT32)>& notifyCallback)
+	{
+		consume(true, notifyCallback);
+	}
+
+	void CommandBuffer::clear()
+	{
+		consume(false, nullptr);
+	}
+
+	void CommandBuffer::consume(bool execute, const std::function<void(UINT32)>& notifyCallback)
+	{
+		for(UINT32 i = 0; i < (UINT32)mChunks.size(); i++)
+		{
+			Chunk& chunk = mChunks[i];
+
+			UINT32 offset = 0;
+			while(offset < chunk.used)
+			{
+				UINT8* data = chunk.data + offset;
+				const CommandHeader& header = *(CommandHeader*)data;
+
+				AsyncOp* asyncOp = nullptr;
+				if(header.returnsValue)
+					asyncOp = (AsyncOp*)(data + getAsyncOpOffset());
+
+				header.invoke(data + getClosureOffset(header.returnsValue), asyncOp, execute);
+
+				if(asyncOp != nullptr)
+				{
+					if(execute && !asyncOp->hasCompleted())
+					{
+						LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
+							"Make sure to complete the operation before returning from the command callback method.");
+						asyncOp->_completeOperation(nullptr);
+					}
+
+					asyncOp->~AsyncOp();
+				}
+
+				if(execute && header.notifyWhenComplete && notifyCallback != nullptr)
+					notifyCallback(header.callbackId);
+
+				offset += header.size;
+			}
+
+			chunk.used = 0;
+		}
+
+		mActiveChunk = 0;
+		mNumCommands = 0;
+	}
+
 #if BS_DEBUG_MODE
 	CommandQueueBase::CommandQueueBase(ThreadId threadId)
 		:mMyThreadId(threadId), mMaxDebugIdx(0)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<bs::Queue<QueuedCommand>>();
+		mCommands = bs_new<CommandBuffer>();
 
 		{
 			Lock lock(CommandQueueBreakpointMutex);
@@ -25,7 +121,7 @@ namespace bs
 		:mMyThreadId(threadId)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<bs::Queue<QueuedCommand>>();
+		mCommands = bs_new<CommandBuffer>();
 	}
 #endif
 
@@ -34,125 +130,65 @@ namespace bs
 		if(mCommands != nullptr)
 			bs_delete(mCommands);
 
-		while(!mEmptyCommandQueues.empty())
+		while(!mEmptyCommandBuffers.empty())
 		{
-			bs_delete(mEmptyCommandQueues.top());
-			mEmptyCommandQueues.pop();
+			bs_delete(mEmptyCommandBuffers.top());
+			mEmptyCommandBuffers.pop();
 		}
 	}
 
-	AsyncOp CommandQueueBase::queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
-	{
-#if BS_DEBUG_MODE
-		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
-
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
-#endif
-
-		mCommands->push(newCommand);
-
-#if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
-#endif
-
-		return newCommand.asyncOp;
-	}
-
-	void CommandQueueBase::queue(std::function<void()> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
-	{
-#if BS_DEBUG_MODE
-		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
-
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, _notifyWhenComplete, _callbackId);
-#endif
-
-		mCommands->push(newCommand);
-
-#if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
-#endif
-	}
-
-	bs::Queue<QueuedCommand>* CommandQueueBase::flush()
+	CommandBuffer* CommandQueueBase::flush()
 	{
-		bs::Queue<QueuedCommand>* oldCommands = mCommands;
+		CommandBuffer* oldCommands = mCommands;
 
-		if(!mEmptyCommandQueues.empty())
-		{
-			mCommands = mEmptyCommandQueues.top();
-			mEmptyCommandQueues.pop();
-		}
-		else
 		{
-			mCommands = bs_new<bs::Queue<QueuedCommand>>();
+			Lock lock(mEmptyCommandBuffersMutex);
+
+			if(!mEmptyCommandBuffers.empty())
+			{
+				mCommands = mEmptyCommandBuffers.top();
+				mEmptyCommandBuffers.pop();
+			}
+			else
+				mCommands = nullptr;
 		}
 
+		if(mCommands == nullptr)
+			mCommands = bs_new<CommandBuffer>();
+
 		return oldCommands;
 	}
 
-	void CommandQueueBase::playbackWithNotify(bs::Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback)
+	void CommandQueueBase::playbackWithNotify(CommandBuffer* commands, std::function<void(UINT32)> notifyCallback)
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
 		if(commands == nullptr)
 			return;
 
-		while(!commands->empty())
-		{
-			QueuedCommand& command = commands->front();
+		commands->execute(notifyCallback);
 
-			if(command.returnsValue)
-			{
-				AsyncOp& op = command.asyncOp;
-				command.callbackWithReturnValue(op);
-
-				if(!command.asyncOp.hasCompleted())
-				{
-					LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
-						"Make sure to complete the operation before returning from the command callback method.");
-					command.asyncOp._completeOperation(nullptr);
-				}
-			}
-			else
-			{
-				command.callback();
-			}
-
-			if(command.notifyWhenComplete && notifyCallback != nullptr)
-			{
-				notifyCallback(command.callbackId);
-			}
-
-			commands->pop();
-		}
-
-		mEmptyCommandQueues.push(commands);
+		Lock lock(mEmptyCommandBuffersMutex);
+		mEmptyCommandBuffers.push(commands);
 	}
 
-	void CommandQueueBase::playback(bs::Queue<QueuedCommand>* commands)
+	void CommandQueueBase::playback(CommandBuffer* commands)
 	{
 		playbackWithNotify(commands, std::function<void(UINT32)>());
 	}
 
 	void CommandQueueBase::cancelAll()
 	{
-		bs::Queue<QueuedCommand>* commands = flush();
-
-		while(!commands->empty())
-			commands->pop();
+		CommandBuffer* commands = flush();
+		commands->clear();
 
-		mEmptyCommandQueues.push(commands);
+		Lock lock(mEmptyCommandBuffersMutex);
+		mEmptyCommandBuffers.push(commands);
 	}
 
 	bool CommandQueueBase::isEmpty()
 	{
-		if(mCommands != nullptr && mCommands->size() > 0)
+		if(mCommands != nullptr && !mCommands->isEmpty())
 			return false;
 
 		return true;
@@ -64,76 +64,165 @@ namespace bs
 	};
 
 	/**
-	 * Represents a single queued command in the command list. Contains all the data for executing the command and checking 
-	 * up on the command status.
+	 * Linear buffer of commands queued for execution on another thread. Each command is stored as a type-erased closure
+	 * placed in-line in the buffer, along with a small header containing a pointer to the function that executes it.
+	 * Commands are laid out one after another in large memory chunks which are retained when the buffer is cleared, so
+	 * once the buffer has grown to its working size queuing commands doesn't allocate any memory.
 	 */
-	struct QueuedCommand
+	class BS_CORE_EXPORT CommandBuffer
 	{
-#if BS_DEBUG_MODE
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, UINT32 _debugId, const SPtr<AsyncOpSyncData>& asyncOpSyncData,
-			bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			: debugId(_debugId), callbackWithReturnValue(_callback), asyncOp(asyncOpSyncData), returnsValue(true)
-			, callbackId(_callbackId), notifyWhenComplete(_notifyWhenComplete)
-		{ }
+		/** Header preceding each command in the buffer. */
+		struct CommandHeader
+		{
+			/** 
+			 * Executes the command (unless @p execute is false) and destroys its closure. @p asyncOp is null for commands 
+			 * that don't return a value.
+			 */
+			void(*invoke)(void* closure, AsyncOp* asyncOp, bool execute);
+
+			UINT32 size; /**< Size of the command including the header, in bytes. */
+			UINT32 callbackId;
+			bool returnsValue;
+			bool notifyWhenComplete;
+		};
 
-		QueuedCommand(std::function<void()> _callback, UINT32 _debugId, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:debugId(_debugId), callback(_callback), asyncOp(AsyncOpEmpty()), returnsValue(false), callbackId(_callbackId)
-			, notifyWhenComplete(_notifyWhenComplete)
-		{ }
+		/** Single contiguous block of memory commands are placed in. */
+		struct Chunk
+		{
+			UINT8* data;
+			UINT32 size;
+			UINT32 used;
+		};
 
-		UINT32 debugId;
-#else
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, const SPtr<AsyncOpSyncData>& asyncOpSyncData, 
-			bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			: callbackWithReturnValue(_callback), asyncOp(asyncOpSyncData), returnsValue(true), callbackId(_callbackId)
-			, notifyWhenComplete(_notifyWhenComplete)
-		{ }
+	public:
+		/** Size of a single memory chunk, in bytes. Commands larger than this get a chunk of their own. */
+		static constexpr UINT32 CHUNK_SIZE = 64 * 1024;
 
-		QueuedCommand(std::function<void()> _callback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			: callback(_callback), asyncOp(AsyncOpEmpty()), returnsValue(false), callbackId(_callbackId)
-			, notifyWhenComplete(_notifyWhenComplete)
-		{ }
-#endif
+		CommandBuffer() = default;
+		~CommandBuffer();
 
-		~QueuedCommand()
-		{ }
+		CommandBuffer(const CommandBuffer&) = delete;
+		CommandBuffer& operator=(const CommandBuffer&) = delete;
 
-		QueuedCommand(const QueuedCommand& source)
+		/**
+		 * Adds a command that doesn't return a value to the end of the buffer.
+		 *
+		 * @param[in]	command				Callable with signature void().
+		 * @param[in]	notifyWhenComplete	Call the notify callback provided to execute() when the command is complete.
+		 * @param[in]	callbackId			Identifier passed to the notify callback.
+		 */
+		template<class F>
+		void add(F&& command, bool notifyWhenComplete = false, UINT32 callbackId = 0)
 		{
-			callback = source.callback;
-			callbackWithReturnValue = source.callbackWithReturnValue;
-			asyncOp = source.asyncOp;
-			returnsValue = source.returnsValue;
-			callbackId = source.callbackId;
-			notifyWhenComplete = source.notifyWhenComplete;
+			typedef typename std::decay<F>::type Closure;
 
-#if BS_DEBUG_MODE
-			debugId = source.debugId;
-#endif
+			UINT8* data = allocateCommand(getClosureOffset(false) + (UINT32)sizeof(Closure));
+			CommandHeader* header = (CommandHeader*)data;
+			header->invoke = &invokeCommand<Closure>;
+			header->callbackId = callbackId;
+			header->returnsValue = false;
+			header->notifyWhenComplete = notifyWhenComplete;
+
+			new (data + getClosureOffset(false)) Closure(std::forward<F>(command));
 		}
 
-		QueuedCommand& operator=(const QueuedCommand& rhs)
+		/**
+		 * Adds a command that returns a value to the end of the buffer.
+		 *
+		 * @param[in]	command				Callable with signature void(AsyncOp&). The command should complete the
+		 *									operation once done.
+		 * @param[in]	syncData			Synchronization data used for the returned async operation.
+		 * @param[in]	notifyWhenComplete	Call the notify callback provided to execute() when the command is complete.
+		 * @param[in]	callbackId			Identifier passed to the notify callback.
+		 * @return							Async operation that will be completed by the command.
+		 */
+		template<class F>
+		AsyncOp addReturn(F&& command, const SPtr<AsyncOpSyncData>& syncData, bool notifyWhenComplete = false, 
+			UINT32 callbackId = 0)
 		{
-			callback = rhs.callback;
-			callbackWithReturnValue = rhs.callbackWithReturnValue;
-			asyncOp = rhs.asyncOp;
-			returnsValue = rhs.returnsValue;
-			callbackId = rhs.callbackId;
-			notifyWhenComplete = rhs.notifyWhenComplete;
-			
-#if BS_DEBUG_MODE
-			debugId = rhs.debugId;
-#endif
+			typedef typename std::decay<F>::type Closure;
+
+			UINT8* data = allocateCommand(getClosureOffset(true) + (UINT32)sizeof(Closure));
+			CommandHeader* header = (CommandHeader*)data;
+			header->invoke = &invokeReturnCommand<Closure>;
+			header->callbackId = callbackId;
+			header->returnsValue = true;
+			header->notifyWhenComplete = notifyWhenComplete;
 
-			return *this;
+			AsyncOp* asyncOp = new (data + getAsyncOpOffset()) AsyncOp(syncData);
+			new (data + getClosureOffset(true)) Closure(std::forward<F>(command));
+
+			return *asyncOp;
 		}
 
-		std::function<void()> callback;
-		std::function<void(AsyncOp&)> callbackWithReturnValue;
-		AsyncOp asyncOp;
-		bool returnsValue;
-		UINT32 callbackId;
-		bool notifyWhenComplete;
+		/**
+		 * Executes all the commands in the order they were added, and clears the buffer.
+		 *
+		 * @param[in]	notifyCallback	Callback that will be called after every command that has the notify flag set. The
+		 *								callback will receive the callback ID of the command.
+		 */
+		void execute(const std::function<void(UINT32)>& notifyCallback = nullptr);
+
+		/** Removes all the commands from the buffer without executing them. Memory used by the buffer is retained. */
+		void clear();
+
+		/** Returns the number of commands in the buffer. */
+		UINT32 getNumCommands() const { return mNumCommands; }
+
+		/** Returns true if no commands are queued in the buffer. */
+		bool isEmpty() const { return mNumCommands == 0; }
+
+	private:
+		/** Alignment of all the commands, as well as of their closures. */
+		static constexpr UINT32 ALIGNMENT = 16;
+
+		/** Rounds the value up to the command alignment. */
+		static constexpr UINT32 align(UINT32 value) { return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+		/** Returns the offset of the async operation from the start of the command. */
+		static constexpr UINT32 getAsyncOpOffset() { return align((UINT32)sizeof(CommandHeader)); }
+
+		/** Returns the offset of the closure from the start of the command. */
+		static constexpr UINT32 getClosureOffset(bool returnsValue)
+		{
+			return returnsValue ? align(getAsyncOpOffset() + (UINT32)sizeof(AsyncOp)) : getAsyncOpOffset();
+		}
+
+		/** Reserves memory for a new command of the specified size, and writes its size into its header. */
+		UINT8* allocateCommand(UINT32 size);
+
+		/** Executes (if requested) and destroys a closure of a command that doesn't return a value. */
+		template<class F>
+		static void invokeCommand(void* closure, AsyncOp* asyncOp, bool execute)
+		{
+			static_assert(alignof(F) <= ALIGNMENT, "Command closure is over-aligned.");
+
+			F& command = *(F*)closure;
+			if(execute)
+				command();
+
+			command.~F();
+		}
+
+		/** Executes (if requested) and destroys a closure of a command that returns a value. */
+		template<class F>
+		static void invokeReturnCommand(void* closure, AsyncOp* asyncOp, bool execute)
+		{
+			static_assert(alignof(F) <= ALIGNMENT, "Command closure is over-aligned.");
+
+			F& command = *(F*)closure;
+			if(execute)
+				command(*asyncOp);
+
+			command.~F();
+		}
+
+		/** Destroys or executes all commands in the buffer, and resets the buffer. */
+		void consume(bool execute, const std::function<void(UINT32)>& notifyCallback);
+
+		Vector<Chunk> mChunks;
+		UINT32 mActiveChunk = 0;
+		UINT32 mNumCommands = 0;
 	};
 
 	/** Manages a list of commands that can be queued for later execution on the core thread. */
@@ -157,16 +246,17 @@ namespace bs
 		ThreadId getThreadId() const { return mMyThreadId; }
 
 		/**
-		 * Executes all provided commands one by one in order. To get the commands you should call flush().
+		 * Executes all provided commands one by one in order. To get the commands you should call flush(). The command
+		 * buffer is returned to the queue for reuse once executed.
 		 *
 		 * @param[in]	commands			Commands to execute.
 		 * @param[in]	notifyCallback  	Callback that will be called if a command that has @p notifyOnComplete flag set.
 		 * 									The callback will receive @p callbackId of the command.
 		 */
-		void playbackWithNotify(Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback);
+		void playbackWithNotify(CommandBuffer* commands, std::function<void(UINT32)> notifyCallback);
 
 		/** Executes all provided commands one by one in order. To get the commands you should call flush(). */
-		void playback(Queue<QueuedCommand>* commands);
+		void playback(CommandBuffer* commands);
 
 		/**
 		 * Allows you to set a breakpoint that will trigger when the specified command is executed.		
@@ -201,7 +291,22 @@ namespace bs
 		 * Callback method also needs to call AsyncOp::markAsResolved once it is done processing. (If it doesn't it will 
 		 * still be called automatically, but the return value will default to nullptr)
 		 */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		template<class F>
+		AsyncOp queueReturn(F&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		{
+#if BS_DEBUG_MODE
+			breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx++);
+#endif
+
+			AsyncOp asyncOp = mCommands->addReturn(std::forward<F>(commandCallback), mAsyncOpSyncData, _notifyWhenComplete,
+				_callbackId);
+
+#if BS_FORCE_SINGLETHREADED_RENDERING
+			playback(flush());
+#endif
+
+			return asyncOp;
+		}
 
 		/**
 		 * Queue up a new command to execute. Make sure the provided function has all of its parameters properly bound. 
@@ -214,13 +319,26 @@ namespace bs
 		 * @param[in]	_callbackId		   	(optional) Identifier for the callback so you can then later find
 		 * 									it if needed.
 		 */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		template<class F>
+		void queue(F&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		{
+#if BS_DEBUG_MODE
+			breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx++);
+#endif
+
+			mCommands->add(std::forward<F>(commandCallback), _notifyWhenComplete, _callbackId);
+
+#if BS_FORCE_SINGLETHREADED_RENDERING
+			playback(flush());
+#endif
+		}
 
 		/**
-		 * Returns a copy of all queued commands and makes room for new ones. Must be called from the thread that created 
-		 * the command queue. Returned commands must be passed to playback() method.
+		 * Returns all queued commands and makes room for new ones, by swapping the active command buffer with an empty
+		 * one. Must be called from the thread that created the command queue. Returned commands must be passed to 
+		 * playback() method.
 		 */
-		Queue<QueuedCommand>* flush();
+		CommandBuffer* flush();
 
 		/** Cancels all currently queued commands. */
 		void cancelAll();
@@ -236,8 +354,9 @@ namespace bs
 		void throwInvalidThreadException(const String& message) const;
 
 	private:
-		Queue<QueuedCommand>* mCommands;
-		Stack<Queue<QueuedCommand>*> mEmptyCommandQueues; /**< List of empty queues for reuse. */
+		CommandBuffer* mCommands;
+		Stack<CommandBuffer*> mEmptyCommandBuffers; /**< List of empty buffers for reuse. */
+		Mutex mEmptyCommandBuffersMutex;
 
 		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
 		ThreadId mMyThreadId;
@@ -300,7 +419,8 @@ namespace bs
 		{ }
 
 		/** @copydoc CommandQueueBase::queueReturn */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		template<class F>
+		AsyncOp queueReturn(F&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -310,14 +430,16 @@ namespace bs
 #endif
 
 			this->lock();
-			AsyncOp asyncOp = CommandQueueBase::queueReturn(commandCallback, _notifyWhenComplete, _callbackId);
+			AsyncOp asyncOp = CommandQueueBase::queueReturn(std::forward<F>(commandCallback), _notifyWhenComplete, 
+				_callbackId);
 			this->unlock();
 
 			return asyncOp;
 		}
 
 		/** @copydoc CommandQueueBase::queue */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		template<class F>
+		void queue(F&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -327,12 +449,12 @@ namespace bs
 #endif
 
 			this->lock();
-			CommandQueueBase::queue(commandCallback, _notifyWhenComplete, _callbackId);
+			CommandQueueBase::queue(std::forward<F>(commandCallback), _notifyWhenComplete, _callbackId);
 			this->unlock();
 		}
 
 		/** @copydoc CommandQueueBase::flush */
-		bs::Queue<QueuedCommand>* flush()
+		CommandBuffer* flush()
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -342,7 +464,7 @@ namespace bs
 #endif
 
 			this->lock();
-			bs::Queue<QueuedCommand>* commands = CommandQueueBase::flush();
+			CommandBuffer* commands = CommandQueueBase::flush();
 			this->unlock();
 
 			return commands;
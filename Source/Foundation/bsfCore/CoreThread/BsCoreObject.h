@@ -225,6 +225,10 @@ namespace bs
 		 * @note	
 		 * This generally happens at the end of every sim thread frame. Synced data becomes available to the core thread 
 		 * the start of the next core thread frame.
+		 * @note
+		 * This may be called from a worker thread, in parallel with other objects that this object doesn't depend on.
+		 * Implementations should only read the object's own state (and state of its dependencies), and allocate any
+		 * memory using the provided allocator or the global frame allocator.
 		 */
 		virtual CoreSyncData syncToCore(FrameAlloc* allocator) { return CoreSyncData(); }
 
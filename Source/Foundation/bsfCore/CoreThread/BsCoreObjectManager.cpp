@@ -6,9 +6,14 @@
 #include "Error/BsException.h"
 #include "Math/BsMath.h"
 #include "CoreThread/BsCoreThread.h"
+#include "Threading/BsJobScheduler.h"
+#include "Profiling/BsProfilerCPU.h"
 
 namespace bs
 {
+	/** Minimum number of objects synced by a single job, when syncing a dependency level in parallel. */
+	static constexpr UINT32 MIN_OBJECTS_PER_JOB = 256;
+
 	CoreObjectManager::CoreObjectManager()
 		:mNextAvailableID(1)
 	{
@@ -30,6 +35,15 @@ namespace bs
 				"engine objects before shutdown.");
 		}
 #endif
+
+		for (auto& syncData : mCoreSyncData)
+		{
+			for (auto& alloc : syncData.workerAllocs)
+				bs_delete(alloc);
+		}
+
+		for (auto& alloc : mFreeWorkerAllocs)
+			bs_delete(alloc);
 	}
 
 	UINT64 CoreObjectManager::generateId()
@@ -66,7 +80,8 @@ namespace bs
 				{
 					CoreSyncData objSyncData = object->syncToCore(gCoreThread().getFrameAlloc());
 				
-					mDestroyedSyncData.push_back(CoreStoredSyncObjData(coreObject, internalId, objSyncData));
+					mDestroyedSyncData.push_back(CoreStoredSyncObjData(coreObject, internalId, objSyncData, 
+						gCoreThread().getFrameAlloc()));
 
 					DirtyObjectData& dirtyObjData = mDirtyObjects[internalId];
 					dirtyObjData.syncDataId = (INT32)mDestroyedSyncData.size() - 1;
@@ -222,86 +237,38 @@ namespace bs
 
 	void CoreObjectManager::syncToCore(CoreObject* object)
 	{
-		struct IndividualCoreSyncData
-		{
-			SPtr<ct::CoreObject> destination;
-			CoreSyncData syncData;
-			FrameAlloc* allocator;
-		};
-
 		Lock lock(mObjectsMutex);
 
-		FrameAlloc* allocator = gCoreThread().getFrameAlloc();
-		Vector<IndividualCoreSyncData> syncData;
-
-		std::function<void(CoreObject*)> syncObject = [&](CoreObject* curObj)
-		{
-			if (!curObj->isCoreDirty())
-				return; // We already processed it as some other object's dependency
-
-			// Sync dependencies before dependants
-			// Note: I don't check for recursion. Possible infinite loop if two objects
-			// are dependent on one another.
+		collectSyncObjects(object);
 
-			UINT64 id = curObj->getInternalID();
-			auto iterFind = mDependencies.find(id);
-
-			if (iterFind != mDependencies.end())
-			{
-				const Vector<CoreObject*>& dependencies = iterFind->second;
-				for (auto& dependency : dependencies)
-					syncObject(dependency);
-			}
-
-			SPtr<ct::CoreObject> objectCore = curObj->getCore();
-			if (objectCore == nullptr)
-			{
-				curObj->markCoreClean();
-				mDirtyObjects.erase(id);
-				return;
-			}
+		const UINT32 numObjects = (UINT32)mSyncObjects.size();
+		if (numObjects == 0)
+			return;
 
-			syncData.push_back(IndividualCoreSyncData());
-			IndividualCoreSyncData& data = syncData.back();
-			data.allocator = allocator;
-			data.destination = objectCore;
-			data.syncData = curObj->syncToCore(allocator);
+		Vector<CoreStoredSyncObjData> syncData(numObjects);
+		syncObjects(mSyncObjects.data(), numObjects, gCoreThread().getFrameAlloc(), syncData.data());
 
-			curObj->markCoreClean();
-			mDirtyObjects.erase(id);
-		};
+		for (auto& entry : mSyncObjects)
+			mDirtyObjects.erase(entry->getInternalID());
 
-		syncObject(object);
+		mSyncObjects.clear();
+		mSyncLevels.clear();
 
-		std::function<void(const Vector<IndividualCoreSyncData>&)> callback =
-			[](const Vector<IndividualCoreSyncData>& data)
+		gCoreThread().queueCommand([syncData = std::move(syncData)]()
 		{
-			// Traverse in reverse to sync dependencies before dependants
-			for (auto riter = data.rbegin(); riter != data.rend(); ++riter)
-			{
-				const IndividualCoreSyncData& entry = *riter;
-				entry.destination->syncToCore(entry.syncData);
-
-				UINT8* dataPtr = entry.syncData.getBuffer();
-
-				if (dataPtr != nullptr)
-					entry.allocator->free(dataPtr);
-			}
-		};
-
-		if (syncData.size() > 0)
-			gCoreThread().queueCommand(std::bind(callback, syncData));
+			applySyncData(syncData);
+		});
 	}
 
 	void CoreObjectManager::syncDownload(FrameAlloc* allocator)
 	{
 		Lock lock(mObjectsMutex);
 
+		gProfilerCPU().beginSample("CoreObjectSyncDownload");
+
 		mCoreSyncData.push_back(CoreStoredSyncData());
 		CoreStoredSyncData& syncData = mCoreSyncData.back();
 
-		syncData.alloc = allocator;
-		
 		// Add all objects dependant on the dirty objects
 		bs_frame_mark();
 		{
@@ -333,81 +300,223 @@ namespace bs
 		}
 
 		bs_frame_clear();
-		
-		// Order in which objects are recursed in matters, ones with lower ID will have been created before
-		// ones with higher ones and should be updated first.
+
+		// Order in which objects are collected in matters, ones with lower ID will have been created before
+		// ones with higher ones and should be updated first (within the same dependency level).
 		for (auto& objectData : mDirtyObjects)
 		{
-			std::function<void(CoreObject*)> syncObject = [&](CoreObject* curObj)
+			CoreObject* object = objectData.second.object;
+			if (object != nullptr)
+				collectSyncObjects(object);
+			else
 			{
-				if (!curObj->isCoreDirty())
-					return; // We already processed it as some other object's dependency
+				// Object was destroyed but we still need to sync its modifications before it was destroyed
+				if (objectData.second.syncDataId != -1)
+					syncData.entries.push_back(mDestroyedSyncData[objectData.second.syncDataId]);
+			}
+		}
 
-				// Sync dependencies before dependants
-				// Note: I don't check for recursion. Possible infinite loop if two objects
-				// are dependent on one another.
-				
-				UINT64 id = curObj->getInternalID();
-				auto iterFind = mDependencies.find(id);
+		// Group the objects by level, keeping their relative order within a level. After this the offset of each level
+		// points to the end of its range.
+		UINT32 numLevels = 0;
+		for (auto& entry : mSyncLevels)
+			numLevels = std::max(numLevels, entry.second + 1);
 
-				if (iterFind != mDependencies.end())
-				{
-					const Vector<CoreObject*>& dependencies = iterFind->second;
-					for (auto& dependency : dependencies)
-						syncObject(dependency);
-				}
+		mLevelOffsets.assign(numLevels, 0);
+		for (auto& entry : mSyncObjects)
+		{
+			const UINT32 level = mSyncLevels[entry];
+			if (level + 1 < numLevels)
+				mLevelOffsets[level + 1]++;
+		}
 
-				SPtr<ct::CoreObject> objectCore = curObj->getCore();
-				if (objectCore == nullptr)
-				{
-					curObj->markCoreClean();
-					return;
-				}
+		for (UINT32 i = 1; i < numLevels; i++)
+			mLevelOffsets[i] += mLevelOffsets[i - 1];
 
-				CoreSyncData objSyncData = curObj->syncToCore(allocator);
-				curObj->markCoreClean();
+		mSortedSyncObjects.resize(mSyncObjects.size());
+		for (auto& entry : mSyncObjects)
+			mSortedSyncObjects[mLevelOffsets[mSyncLevels[entry]]++] = entry;
 
-				syncData.entries.push_back(CoreStoredSyncObjData(objectCore,
-					curObj->getInternalID(), objSyncData));
-			};
+		const UINT32 firstEntry = (UINT32)syncData.entries.size();
+		syncData.entries.resize(firstEntry + mSortedSyncObjects.size());
 
-			CoreObject* object = objectData.second.object;
-			if (object != nullptr)
-				syncObject(object);
+		CoreObject** objects = mSortedSyncObjects.data();
+		CoreStoredSyncObjData* entries = syncData.entries.data() + firstEntry;
+
+		UINT32 maxChunks = 1;
+		if (JobScheduler::isStarted())
+			maxChunks = JobScheduler::instance().getNumActiveWorkers() + 1;
+
+		// Levels need to be synced one after another, but objects within a level don't depend on each other
+		UINT32 levelStart = 0;
+		for (UINT32 i = 0; i < numLevels; i++)
+		{
+			const UINT32 levelEnd = mLevelOffsets[i];
+			const UINT32 count = levelEnd - levelStart;
+
+			UINT32 numChunks = Math::clamp(count / MIN_OBJECTS_PER_JOB, 1U, maxChunks);
+			if (numChunks == 1)
+				syncObjects(objects + levelStart, count, allocator, entries + levelStart);
 			else
 			{
-				// Object was destroyed but we still need to sync its modifications before it was destroyed
-				if (objectData.second.syncDataId != -1)
-					syncData.entries.push_back(mDestroyedSyncData[objectData.second.syncDataId]);
+				const UINT32 chunkSize = Math::divideAndRoundUp(count, numChunks);
+				numChunks = Math::divideAndRoundUp(count, chunkSize);
+
+				// First chunk uses the provided allocator, the rest get an allocator each, re-used by following levels
+				while ((UINT32)syncData.workerAllocs.size() < numChunks - 1)
+					syncData.workerAllocs.push_back(allocWorkerFrameAlloc());
+
+				JobScheduler::instance().parallelForAndWait(numChunks, 1, [&](UINT32 start, UINT32 numToProcess)
+				{
+					for (UINT32 chunk = start; chunk < start + numToProcess; chunk++)
+					{
+						const UINT32 chunkStart = levelStart + chunk * chunkSize;
+						const UINT32 chunkEnd = std::min(chunkStart + chunkSize, levelEnd);
+						FrameAlloc* chunkAllocator = chunk == 0 ? allocator : syncData.workerAllocs[chunk - 1];
+
+						syncObjects(objects + chunkStart, chunkEnd - chunkStart, chunkAllocator, entries + chunkStart);
+					}
+				});
 			}
+
+			levelStart = levelEnd;
 		}
 
+		mSyncObjects.clear();
+		mSortedSyncObjects.clear();
+		mSyncLevels.clear();
 		mDirtyObjects.clear();
 		mDestroyedSyncData.clear();
+
+		gProfilerCPU().endSample("CoreObjectSyncDownload");
 	}
 
 	void CoreObjectManager::syncUpload()
 	{
-		Lock lock(mObjectsMutex);
+		gProfilerCPU().beginSample("CoreObjectSyncUpload");
 
-		if (mCoreSyncData.size() == 0)
-			return;
+		CoreStoredSyncData syncData;
+		{
+			Lock lock(mObjectsMutex);
+
+			if (mCoreSyncData.size() > 0)
+			{
+				syncData = std::move(mCoreSyncData.front());
+				mCoreSyncData.pop_front();
+			}
+		}
+
+		// Note: Applied without holding the lock, so the sim thread can keep registering objects in the meantime
+		applySyncData(syncData.entries);
+
+		if (syncData.workerAllocs.size() > 0)
+		{
+			Lock lock(mObjectsMutex);
+
+			for (auto& alloc : syncData.workerAllocs)
+				mFreeWorkerAllocs.push_back(alloc);
+		}
+
+		gProfilerCPU().endSample("CoreObjectSyncUpload");
+	}
+
+	void CoreObjectManager::collectSyncObjects(CoreObject* object)
+	{
+		if (!object->isCoreDirty() || mSyncLevels.find(object) != mSyncLevels.end())
+			return; // We already processed it as some other object's dependency
+
+		// Note: I don't check for recursion. Possible infinite loop if two objects
+		// are dependent on one another.
+		mCollectStack.push_back(object);
+		while (!mCollectStack.empty())
+		{
+			CoreObject* curObj = mCollectStack.back();
+
+			// Objects can get pushed multiple times if they are a dependency of multiple objects on the stack
+			if (mSyncLevels.find(curObj) != mSyncLevels.end())
+			{
+				mCollectStack.pop_back();
+				continue;
+			}
+
+			// Collect dependencies before dependants
+			UINT32 level = 0;
+			bool dependenciesCollected = true;
+
+			auto iterFind = mDependencies.find(curObj->getInternalID());
+			if (iterFind != mDependencies.end())
+			{
+				const Vector<CoreObject*>& dependencies = iterFind->second;
+				for (auto& dependency : dependencies)
+				{
+					if (!dependency->isCoreDirty())
+						continue;
+
+					auto iterFindLevel = mSyncLevels.find(dependency);
+					if (iterFindLevel != mSyncLevels.end())
+						level = std::max(level, iterFindLevel->second + 1);
+					else
+					{
+						mCollectStack.push_back(dependency);
+						dependenciesCollected = false;
+					}
+				}
+			}
+
+			if (!dependenciesCollected)
+				continue;
+
+			mCollectStack.pop_back();
+
+			mSyncLevels[curObj] = level;
+			mSyncObjects.push_back(curObj);
+		}
+	}
+
+	void CoreObjectManager::syncObjects(CoreObject** objects, UINT32 count, FrameAlloc* allocator,
+		CoreStoredSyncObjData* entries)
+	{
+		for (UINT32 i = 0; i < count; i++)
+		{
+			CoreObject* curObj = objects[i];
 
-		CoreStoredSyncData& syncData = mCoreSyncData.front();
+			// Objects without a core thread counterpart get an empty entry, which is skipped during upload
+			SPtr<ct::CoreObject> objectCore = curObj->getCore();
+			if (objectCore != nullptr)
+			{
+				CoreSyncData objSyncData = curObj->syncToCore(allocator);
+				entries[i] = CoreStoredSyncObjData(objectCore, curObj->getInternalID(), objSyncData, allocator);
+			}
 
-		for (auto& objSyncData : syncData.entries)
+			curObj->markCoreClean();
+		}
+	}
+
+	void CoreObjectManager::applySyncData(const Vector<CoreStoredSyncObjData>& entries)
+	{
+		for (auto& objSyncData : entries)
 		{
-			SPtr<ct::CoreObject> destinationObj = objSyncData.destinationObj;
+			const SPtr<ct::CoreObject>& destinationObj = objSyncData.destinationObj;
 			if (destinationObj != nullptr)
 				destinationObj->syncToCore(objSyncData.syncData);
 
 			UINT8* data = objSyncData.syncData.getBuffer();
 
 			if (data != nullptr)
-				syncData.alloc->free(data);
+				objSyncData.alloc->free(data);
 		}
+	}
+
+	FrameAlloc* CoreObjectManager::allocWorkerFrameAlloc()
+	{
+		if (mFreeWorkerAllocs.empty())
+			return bs_new<FrameAlloc>();
+
+		// Data stored in the allocator has been uploaded by now, so it can be released
+		FrameAlloc* alloc = mFreeWorkerAllocs.back();
+		mFreeWorkerAllocs.pop_back();
 
-		syncData.entries.clear();
-		mCoreSyncData.pop_front();
+		alloc->clear();
+		return alloc;
 	}
-}
\ No newline at end of file
+}
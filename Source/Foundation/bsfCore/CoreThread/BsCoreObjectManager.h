@@ -30,16 +30,18 @@ namespace bs
 		struct CoreStoredSyncObjData
 		{
 			CoreStoredSyncObjData()
-				:internalId(0)
+				:internalId(0), alloc(nullptr)
 			{ }
 
-			CoreStoredSyncObjData(const SPtr<ct::CoreObject> destObj, UINT64 internalId, const CoreSyncData& syncData)
-				:destinationObj(destObj), syncData(syncData), internalId(internalId)
+			CoreStoredSyncObjData(const SPtr<ct::CoreObject> destObj, UINT64 internalId, const CoreSyncData& syncData,
+				FrameAlloc* alloc)
+				:destinationObj(destObj), syncData(syncData), internalId(internalId), alloc(alloc)
 			{ }
 
 			SPtr<ct::CoreObject> destinationObj;
 			CoreSyncData syncData;
 			UINT64 internalId;
+			FrameAlloc* alloc;
 		};
 
 		/**
@@ -48,7 +50,8 @@ namespace bs
 		 */
 		struct CoreStoredSyncData
 		{
-			FrameAlloc* alloc = nullptr;
+			/** Allocators used by worker threads, to be returned to the pool once the data has been uploaded. */
+			Vector<FrameAlloc*> workerAllocs;
 			Vector<CoreStoredSyncObjData> entries;
 		};
 
@@ -101,6 +104,10 @@ namespace bs
 		 * Stores all syncable data from dirty core objects into memory allocated by the provided allocator. Additional 
 		 * meta-data is stored internally to be used by call to syncUpload().
 		 *
+		 * Dirty objects are grouped into levels, so that an object's dependencies are always in a lower level than the
+		 * object itself. Objects within a level don't depend on one another, and large levels are therefore split between
+		 * JobScheduler workers, each storing its data using a separate frame allocator.
+		 *
 		 * @param[in]	allocator Allocator to use for allocating memory for stored data.
 		 *
 		 * @note	Sim thread only.
@@ -109,13 +116,34 @@ namespace bs
 		void syncDownload(FrameAlloc* allocator);
 
 		/**
-		 * Copies all the data stored by previous call to syncDownload() into core thread versions of CoreObjects.
+		 * Copies all the data stored by previous call to syncDownload() into core thread versions of CoreObjects, in the
+		 * order the data was stored in.
 		 *
 		 * @note	Core thread only.
 		 * @note	Must be preceded by a call to syncDownload().
 		 */
 		void syncUpload();
 
+		/**
+		 * Appends the provided object and all of its dirty dependencies (direct or indirect) that aren't already in
+		 * @p mSyncObjects to that list. Dependencies are always added before their dependants. Each added object is also
+		 * assigned a dependency level, one higher than the highest level of any of its dirty dependencies.
+		 */
+		void collectSyncObjects(CoreObject* object);
+
+		/**
+		 * Stores syncable data of the provided objects into the @p entries array (one entry per object, at the same index),
+		 * allocating it using the provided allocator. Objects are marked as clean once synced.
+		 */
+		static void syncObjects(CoreObject** objects, UINT32 count, FrameAlloc* allocator, 
+			CoreStoredSyncObjData* entries);
+
+		/** Copies the data stored by syncObjects() into core thread versions of CoreObjects, and frees the data. */
+		static void applySyncData(const Vector<CoreStoredSyncObjData>& entries);
+
+		/** Returns an unused frame allocator for storing data synced by a worker thread. */
+		FrameAlloc* allocWorkerFrameAlloc();
+
 		/**
 		 * Updates the cached list of dependencies and dependants for the specified object.
 		 * 			
@@ -132,6 +160,13 @@ namespace bs
 
 		Vector<CoreStoredSyncObjData> mDestroyedSyncData;
 		List<CoreStoredSyncData> mCoreSyncData;
+		Vector<FrameAlloc*> mFreeWorkerAllocs;
+
+		Vector<CoreObject*> mSyncObjects; // Transient
+		Vector<CoreObject*> mSortedSyncObjects; // Transient
+		UnorderedMap<CoreObject*, UINT32> mSyncLevels; // Transient
+		Vector<UINT32> mLevelOffsets; // Transient
+		Vector<CoreObject*> mCollectStack; // Transient
 
 		Mutex mObjectsMutex;
 	};
@@ -96,7 +96,39 @@ namespace bs
 		 * @see		CommandQueue::queueReturn()
 		 * @note	Thread safe
 		 */
-		AsyncOp queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class F>
+		AsyncOp queueReturnCommand(F&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+			assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
+
+			if (!flags.isSet(CTQF_InternalQueue))
+				return getQueue()->queueReturnCommand(std::forward<F>(commandCallback));
+			else
+			{
+				bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+
+				AsyncOp op;
+				UINT32 commandId = -1;
+				{
+					Lock lock(mCommandQueueMutex);
+
+					if (blockUntilComplete)
+					{
+						commandId = mMaxCommandNotifyId++;
+						op = mCommandQueue->queueReturn(std::forward<F>(commandCallback), true, commandId);
+					}
+					else
+						op = mCommandQueue->queueReturn(std::forward<F>(commandCallback));
+				}
+
+				mCommandReadyCondition.notify_all();
+
+				if (blockUntilComplete)
+					blockUntilCommandCompleted(commandId);
+
+				return op;
+			}
+		}
 
 		/**
 		 * Queues a new command that will be added to the global command queue. 
@@ -107,7 +139,36 @@ namespace bs
 		 * @see		CommandQueue::queue()
 		 * @note	Thread safe
 		 */
-		void queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class F>
+		void queueCommand(F&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+			assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
+
+			if (!flags.isSet(CTQF_InternalQueue))
+				getQueue()->queueCommand(std::forward<F>(commandCallback));
+			else
+			{
+				bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+
+				UINT32 commandId = -1;
+				{
+					Lock lock(mCommandQueueMutex);
+
+					if (blockUntilComplete)
+					{
+						commandId = mMaxCommandNotifyId++;
+						mCommandQueue->queue(std::forward<F>(commandCallback), true, commandId);
+					}
+					else
+						mCommandQueue->queue(std::forward<F>(commandCallback));
+				}
+
+				mCommandReadyCondition.notify_all();
+
+				if (blockUntilComplete)
+					blockUntilCommandCompleted(commandId);
+			}
+		}
 
 		/**
 		 * Called once every frame.
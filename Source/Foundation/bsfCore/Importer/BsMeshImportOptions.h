@@ -165,6 +165,21 @@ namespace bs
 		 */
 		bool getImportRootMotion() const { return mImportRootMotion; }
 
+		/**
+		 * Enables or disables compression of imported animation clips. Compressed clips use significantly less memory,
+		 * at the cost of a small loss in precision and slower evaluation of animated rotations.
+		 *
+		 * @see	AnimationClip::compress
+		 */
+		void setAnimationCompression(bool enabled) { mCompressAnimation = enabled; }
+
+		/**
+		 * Checks is animation compression enabled.
+		 *
+		 * @see	setAnimationCompression
+		 */
+		bool getAnimationCompression() const { return mCompressAnimation; }
+
 		/** Creates a new import options object that allows you to customize how are meshes imported. */
 		static SPtr<MeshImportOptions> create();
 
@@ -177,6 +192,7 @@ namespace bs
 		bool mImportAnimation;
 		bool mReduceKeyFrames;
 		bool mImportRootMotion;
+		bool mCompressAnimation;
 		float mImportScale;
 		CollisionMeshType mCollisionMeshType;
 		Vector<AnimationSplitInfo> mAnimationSplits;
@@ -794,6 +794,46 @@ namespace bs
 			bs_frame_free(offsets);
 		}
 		bs_frame_clear();
+
+		// Group data parameter mappings per material parameter, so mappings of dirty parameters can be found directly
+		std::sort(mDataParamInfos.begin(), mDataParamInfos.end(), 
+			[](const DataParamInfo& lhs, const DataParamInfo& rhs) { return lhs.paramIdx < rhs.paramIdx; });
+
+		const UINT32 numParams = params->getNumParams();
+		mDataParamOffsets.assign(numParams + 1, 0);
+
+		for (auto& paramInfo : mDataParamInfos)
+			mDataParamOffsets[paramInfo.paramIdx + 1]++;
+
+		for (UINT32 i = 0; i < numParams; i++)
+			mDataParamOffsets[i + 1] += mDataParamOffsets[i];
+
+		// Find material parameters used by object parameter mappings
+		const UINT32 numMaskEntries = Math::divideAndRoundUp(numParams, MaterialParamsBase::PARAMS_PER_MASK_ENTRY);
+		mObjectParamsMask.assign(numMaskEntries, 0);
+
+		for (UINT32 i = 0; i < numPasses; i++)
+		{
+			for (UINT32 j = 0; j < NUM_STAGES; j++)
+			{
+				const StageParamInfo& stageInfo = mPassParamInfos[i].stages[j];
+
+				auto addToMask = [this](const ObjectParamInfo* paramInfos, UINT32 numParamInfos)
+				{
+					for (UINT32 k = 0; k < numParamInfos; k++)
+					{
+						const UINT32 paramIdx = paramInfos[k].paramIdx;
+						mObjectParamsMask[paramIdx / MaterialParamsBase::PARAMS_PER_MASK_ENTRY] |= 
+							1ULL << (paramIdx % MaterialParamsBase::PARAMS_PER_MASK_ENTRY);
+					}
+				};
+
+				addToMask(stageInfo.textures, stageInfo.numTextures);
+				addToMask(stageInfo.loadStoreTextures, stageInfo.numLoadStoreTextures);
+				addToMask(stageInfo.buffers, stageInfo.numBuffers);
+				addToMask(stageInfo.samplerStates, stageInfo.numSamplerStates);
+			}
+		}
 	}
 
 	template<bool Core>
@@ -880,110 +920,66 @@ namespace bs
 	template<bool Core>
 	void TGpuParamsSet<Core>::update(const SPtr<MaterialParamsType>& params, bool updateAll)
 	{
-		// Note: Instead of iterating over every single parameter, it might be more efficient for @p params to keep
-		// a ring buffer and a version number. Then we could just iterate over the ring buffer and only access dirty
-		// parameters. If the version number is too high (larger than ring buffer can store), then we force update for all.
+		const UINT32 numParams = params->getNumParams();
+		const UINT32 numMaskEntries = (UINT32)mObjectParamsMask.size();
 
-		// Update data params
-		for(auto& paramInfo : mDataParamInfos)
+		// Find out which parameters changed since the last update
+		if (updateAll)
+			mDirtyParams.assign(numMaskEntries, ~0ULL);
+		else if (!params->getDirtyParams(mParamVersion, mDirtyParams))
 		{
-			ParamBlockPtrType paramBlock = mBlocks[paramInfo.blockIdx].buffer;
-			if (paramBlock == nullptr || !mBlocks[paramInfo.blockIdx].allowUpdate)
-				continue;
+			// Changes since the last update are no longer tracked by the parameters, compare versions instead
+			mDirtyParams.assign(numMaskEntries, 0);
+			for (UINT32 i = 0; i < numParams; i++)
+			{
+				if (params->getParamData(i)->version > mParamVersion)
+					mDirtyParams[i / MaterialParamsBase::PARAMS_PER_MASK_ENTRY] |= 
+						1ULL << (i % MaterialParamsBase::PARAMS_PER_MASK_ENTRY);
+			}
+		}
 
-			const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-			if (materialParamInfo->version <= mParamVersion && !updateAll)
-				continue;
+		mParamVersion = params->getParamVersion();
 
-			UINT32 arraySize = materialParamInfo->arraySize == 0 ? 1 : materialParamInfo->arraySize;
-			const GpuParamDataTypeInfo& typeInfo = GpuParams::PARAM_SIZES.lookup[(int)materialParamInfo->dataType];
-			UINT32 paramSize = typeInfo.numColumns * typeInfo.numRows * typeInfo.baseTypeSize;
+		bool anyObjectParamsDirty = false;
+		bool anyDataParamsDirty = false;
+		for (UINT32 i = 0; i < numMaskEntries; i++)
+		{
+			anyObjectParamsDirty |= (mDirtyParams[i] & mObjectParamsMask[i]) != 0;
+			anyDataParamsDirty |= (mDirtyParams[i] & ~mObjectParamsMask[i]) != 0;
+		}
 
-			UINT8* data = params->getData(materialParamInfo->index);
+		auto isDirty = [this](UINT32 paramIdx)
+		{
+			return (mDirtyParams[paramIdx / MaterialParamsBase::PARAMS_PER_MASK_ENTRY] & 
+				(1ULL << (paramIdx % MaterialParamsBase::PARAMS_PER_MASK_ENTRY))) != 0;
+		};
 
+		// Update data params
+		if (anyDataParamsDirty)
+		{
 			bool transposeMatrices = ct::RenderAPI::instance().getAPIInfo().isFlagSet(RenderAPIFeatureFlag::ColumnMajorMatrices);
-			if (transposeMatrices)
+			for (UINT32 i = 0; i < numParams; i++)
 			{
-				auto writeTransposed = [&](auto& temp)
+				// Skip whole entries of the mask with no dirty parameters
+				if ((i % MaterialParamsBase::PARAMS_PER_MASK_ENTRY) == 0 && 
+					mDirtyParams[i / MaterialParamsBase::PARAMS_PER_MASK_ENTRY] == 0)
 				{
-					for (UINT32 i = 0; i < arraySize; i++)
-					{
-						UINT32 arrayOffset = i * paramSize;
-						memcpy(&temp, data + arrayOffset, paramSize);
-						auto transposed = temp.transpose();
+					i += MaterialParamsBase::PARAMS_PER_MASK_ENTRY - 1;
+					continue;
+				}
 
-						paramBlock->write((paramInfo.offset + arrayOffset) * sizeof(UINT32), &transposed, paramSize);
-					}
-				};
+				if (!isDirty(i))
+					continue;
 
-				switch (materialParamInfo->dataType)
-				{
-				case GPDT_MATRIX_2X2:
-				{
-					MatrixNxM<2, 2> matrix;
-					writeTransposed(matrix);
-				}
-					break;
-				case GPDT_MATRIX_2X3:
-				{
-					MatrixNxM<2, 3> matrix;
-					writeTransposed(matrix);
-				}
-					break;
-				case GPDT_MATRIX_2X4:
-				{
-					MatrixNxM<2, 4> matrix;
-					writeTransposed(matrix);
-				}
-					break;
-				case GPDT_MATRIX_3X2:
-				{
-					MatrixNxM<3, 2> matrix;
-					writeTransposed(matrix);
-				}
-					break;
-				case GPDT_MATRIX_3X3:
-				{
-					Matrix3 matrix;
-					writeTransposed(matrix);
-				}
-					break;
-				case GPDT_MATRIX_3X4:
-				{
-					MatrixNxM<3, 4> matrix;
-					writeTransposed(matrix);
-				}
-					break;
-				case GPDT_MATRIX_4X2:
-				{
-					MatrixNxM<4, 2> matrix;
-					writeTransposed(matrix);
-				}
-					break;
-				case GPDT_MATRIX_4X3:
-				{
-					MatrixNxM<4, 3> matrix;
-					writeTransposed(matrix);
-				}
-					break;
-				case GPDT_MATRIX_4X4:
-				{
-					Matrix4 matrix;
-					writeTransposed(matrix);
-				}
-					break;
-				default:
-				{
-					paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
-					break;
-				}
-				}
+				for (UINT32 j = mDataParamOffsets[i]; j < mDataParamOffsets[i + 1]; j++)
+					updateDataParam(mDataParamInfos[j], params, transposeMatrices);
 			}
-			else
-				paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
 		}
 
 		// Update object params
+		if (!anyObjectParamsDirty && !updateAll)
+			return;
+
 		UINT32 numPasses = (UINT32)mPassParams.size();
 
 		for(UINT32 i = 0; i < numPasses; i++)
@@ -998,10 +994,11 @@ namespace bs
 				{
 					const ObjectParamInfo& paramInfo = stageInfo.textures[k];
 
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
+					if (!isDirty(paramInfo.paramIdx))
 						continue;
 
+					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
+
 					TextureSurface surface;
 					TextureType texture;
 					params->getTexture(*materialParamInfo, texture, surface);
@@ -1013,10 +1010,11 @@ namespace bs
 				{
 					const ObjectParamInfo& paramInfo = stageInfo.loadStoreTextures[k];
 
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
+					if (!isDirty(paramInfo.paramIdx))
 						continue;
 
+					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
+
 					TextureSurface surface;
 					TextureType texture;
 					params->getLoadStoreTexture(*materialParamInfo, texture, surface);
@@ -1028,10 +1026,11 @@ namespace bs
 				{
 					const ObjectParamInfo& paramInfo = stageInfo.buffers[k];
 
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
+					if (!isDirty(paramInfo.paramIdx))
 						continue;
 
+					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
+
 					BufferType buffer;
 					params->getBuffer(*materialParamInfo, buffer);
 
@@ -1042,10 +1041,11 @@ namespace bs
 				{
 					const ObjectParamInfo& paramInfo = stageInfo.samplerStates[k];
 
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
+					if (!isDirty(paramInfo.paramIdx))
 						continue;
 
+					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
+
 					SamplerStateType samplerState;
 					params->getSamplerState(*materialParamInfo, samplerState);
 
@@ -1055,8 +1055,104 @@ namespace bs
 
 			paramPtr->_markCoreDirty();
 		}
+	}
 
-		mParamVersion = params->getParamVersion();
+
+	template<bool Core>
+	void TGpuParamsSet<Core>::updateDataParam(const DataParamInfo& paramInfo, const SPtr<MaterialParamsType>& params,
+		bool transposeMatrices)
+	{
+		const ParamBlockPtrType& paramBlock = mBlocks[paramInfo.blockIdx].buffer;
+		if (paramBlock == nullptr || !mBlocks[paramInfo.blockIdx].allowUpdate)
+			return;
+
+		const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
+
+		UINT32 arraySize = materialParamInfo->arraySize == 0 ? 1 : materialParamInfo->arraySize;
+		const GpuParamDataTypeInfo& typeInfo = GpuParams::PARAM_SIZES.lookup[(int)materialParamInfo->dataType];
+		UINT32 paramSize = typeInfo.numColumns * typeInfo.numRows * typeInfo.baseTypeSize;
+
+		UINT8* data = params->getData(materialParamInfo->index);
+
+		if (transposeMatrices)
+		{
+			auto writeTransposed = [&](auto& temp)
+			{
+				for (UINT32 i = 0; i < arraySize; i++)
+				{
+					UINT32 arrayOffset = i * paramSize;
+					memcpy(&temp, data + arrayOffset, paramSize);
+					auto transposed = temp.transpose();
+
+					paramBlock->write((paramInfo.offset + arrayOffset) * sizeof(UINT32), &transposed, paramSize);
+				}
+			};
+
+			switch (materialParamInfo->dataType)
+			{
+			case GPDT_MATRIX_2X2:
+			{
+				MatrixNxM<2, 2> matrix;
+				writeTransposed(matrix);
+			}
+				break;
+			case GPDT_MATRIX_2X3:
+			{
+				MatrixNxM<2, 3> matrix;
+				writeTransposed(matrix);
+			}
+				break;
+			case GPDT_MATRIX_2X4:
+			{
+				MatrixNxM<2, 4> matrix;
+				writeTransposed(matrix);
+			}
+				break;
+			case GPDT_MATRIX_3X2:
+			{
+				MatrixNxM<3, 2> matrix;
+				writeTransposed(matrix);
+			}
+				break;
+			case GPDT_MATRIX_3X3:
+			{
+				Matrix3 matrix;
+				writeTransposed(matrix);
+			}
+				break;
+			case GPDT_MATRIX_3X4:
+			{
+				MatrixNxM<3, 4> matrix;
+				writeTransposed(matrix);
+			}
+				break;
+			case GPDT_MATRIX_4X2:
+			{
+				MatrixNxM<4, 2> matrix;
+				writeTransposed(matrix);
+			}
+				break;
+			case GPDT_MATRIX_4X3:
+			{
+				MatrixNxM<4, 3> matrix;
+				writeTransposed(matrix);
+			}
+				break;
+			case GPDT_MATRIX_4X4:
+			{
+				Matrix4 matrix;
+				writeTransposed(matrix);
+			}
+				break;
+			default:
+			{
+				paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
+				break;
+			}
+			}
+		}
+		else
+			paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
 	}
 
 	template class TGpuParamsSet <false>;
@@ -166,6 +166,10 @@ namespace bs
 		 * @param[in]	updateAll		Normally the system will track dirty parameters since the last call to this method,
 		 *								and only update the dirty ones. Set this to true if you want to force all parameters
 		 *								to update, regardless of their dirty state.
+		 *
+		 * @note	
+		 * Dirty parameters are retrieved as a bitmask from @p params, and only the mappings of those parameters are 
+		 * visited. If no parameters changed since the last call, this method doesn't touch any of the GPU parameters.
 		 */
 		void update(const SPtr<MaterialParamsType>& params, bool updateAll = false);
 
@@ -173,11 +177,19 @@ namespace bs
 	private:
 		template<bool Core2> friend class TMaterial;
 
+		/** Writes the value of a data parameter from @p params into the parameter block buffer it maps to. */
+		void updateDataParam(const DataParamInfo& paramInfo, const SPtr<MaterialParamsType>& params, 
+			bool transposeMatrices);
+
 		Vector<SPtr<GpuParamsType>> mPassParams;
 		Vector<BlockInfo> mBlocks;
 		Vector<DataParamInfo> mDataParamInfos;
+		Vector<UINT32> mDataParamOffsets;
+		Vector<UINT64> mObjectParamsMask;
 		PassParamInfo* mPassParamInfos;
 
+		Vector<UINT64> mDirtyParams; // Transient
+
 		UINT64 mParamVersion;
 		UINT8* mData;
 	};
@@ -361,7 +361,7 @@ namespace bs
 		 * @note			
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialDataParam<float, Core> getParamFloat(const String& name) const
+		TMaterialDataParam<float, Core> getParamFloat(const StringID& name) const
 		{
 			TMaterialDataParam<float, Core> gpuParam;
 			getParam(name, gpuParam);
@@ -379,7 +379,7 @@ namespace bs
 		 * @note
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialDataParam<Color, Core> getParamColor(const String& name) const
+		TMaterialDataParam<Color, Core> getParamColor(const StringID& name) const
 		{
 			TMaterialDataParam<Color, Core> gpuParam;
 			getParam(name, gpuParam);
@@ -397,7 +397,7 @@ namespace bs
 		 * @note	
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialDataParam<Vector2, Core> getParamVec2(const String& name) const
+		TMaterialDataParam<Vector2, Core> getParamVec2(const StringID& name) const
 		{
 			TMaterialDataParam<Vector2, Core> gpuParam;
 			getParam(name, gpuParam);
@@ -415,7 +415,7 @@ namespace bs
 		 * @note			
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialDataParam<Vector3, Core> getParamVec3(const String& name) const
+		TMaterialDataParam<Vector3, Core> getParamVec3(const StringID& name) const
 		{
 			TMaterialDataParam<Vector3, Core> gpuParam;
 			getParam(name, gpuParam);
@@ -433,7 +433,7 @@ namespace bs
 		 * @note	
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialDataParam<Vector4, Core> getParamVec4(const String& name) const
+		TMaterialDataParam<Vector4, Core> getParamVec4(const StringID& name) const
 		{
 			TMaterialDataParam<Vector4, Core> gpuParam;
 			getParam(name, gpuParam);
@@ -451,7 +451,7 @@ namespace bs
 		 * @note	
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialDataParam<Matrix3, Core> getParamMat3(const String& name) const
+		TMaterialDataParam<Matrix3, Core> getParamMat3(const StringID& name) const
 		{
 			TMaterialDataParam<Matrix3, Core> gpuParam;
 			getParam(name, gpuParam);
@@ -469,7 +469,7 @@ namespace bs
 		 * @note	
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialDataParam<Matrix4, Core> getParamMat4(const String& name) const
+		TMaterialDataParam<Matrix4, Core> getParamMat4(const StringID& name) const
 		{
 			TMaterialDataParam<Matrix4, Core> gpuParam;
 			getParam(name, gpuParam);
@@ -487,7 +487,7 @@ namespace bs
 		 * @note			
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialParamStruct<Core> getParamStruct(const String& name) const;
+		TMaterialParamStruct<Core> getParamStruct(const StringID& name) const;
 
 		/**
 		 * Returns a texture GPU parameter. This parameter may be used for more efficiently getting/setting GPU parameter 
@@ -499,7 +499,7 @@ namespace bs
 		 * @note
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialParamTexture<Core> getParamTexture(const String& name) const;
+		TMaterialParamTexture<Core> getParamTexture(const StringID& name) const;
 
 		/**
 		 * Returns a GPU parameter for binding a load/store texture. This parameter may be used for more efficiently 
@@ -511,7 +511,7 @@ namespace bs
 		 * @note			
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialParamLoadStoreTexture<Core> getParamLoadStoreTexture(const String& name) const;
+		TMaterialParamLoadStoreTexture<Core> getParamLoadStoreTexture(const StringID& name) const;
 
 		/**
 		 * Returns a buffer GPU parameter. This parameter may be used for more efficiently getting/setting GPU parameter 
@@ -523,7 +523,7 @@ namespace bs
 		 * @note
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialParamBuffer<Core> getParamBuffer(const String& name) const;
+		TMaterialParamBuffer<Core> getParamBuffer(const StringID& name) const;
 
 		/**
 		 * Returns a sampler state GPU parameter. This parameter may be used for more efficiently getting/setting GPU 
@@ -535,7 +535,19 @@ namespace bs
 		 * @note			
 		 * If material shader changes this handle will be invalidated.
 		 */
-		TMaterialParamSampState<Core> getParamSamplerState(const String& name) const;
+		TMaterialParamSampState<Core> getParamSamplerState(const StringID& name) const;
+
+		/**
+		 * Returns a handle to a group of data parameters that can be written together. Prefer this over individual
+		 * handles when several parameters are updated at the same time, as the material is only marked dirty once.
+		 *
+		 * @note	
+		 * Expected behavior is that you would retrieve this parameter when initially constructing the material, and then 
+		 * use it throughout material lifetime to assign parameter values.
+		 * @note			
+		 * If material shader changes this handle will be invalidated.
+		 */
+		TMaterialParamBatch<Core> getParamBatch(const Vector<StringID>& names) const;
 
 		/**
 		 * Allows you to retrieve a handle to a parameter that you can then use for quickly setting and retrieving parameter
@@ -546,7 +558,7 @@ namespace bs
 		 * of that.
 		 */
 		template <typename T>
-		void getParam(const String& name, TMaterialDataParam<T, Core>& output) const;
+		void getParam(const StringID& name, TMaterialDataParam<T, Core>& output) const;
 
 		/**
 		 * @name Internal
@@ -557,7 +569,7 @@ namespace bs
 		 * Returns an object containg all of material's parameters. Allows the caller to manipulate the parameters more
 		 * directly. 
 		 */
-		SPtr<MaterialParamsType> _getInternalParams() const { return mParams; }
+		const SPtr<MaterialParamsType>& _getInternalParams() const { return mParams; }
 
 		/** @} */
 	protected:
@@ -8,7 +8,7 @@
 namespace bs
 {
 	template<class T, bool Core>
-	TMaterialDataParam<T, Core>::TMaterialDataParam(const String& name, const MaterialPtrType& material)
+	TMaterialDataParam<T, Core>::TMaterialDataParam(const StringID& name, const MaterialPtrType& material)
 		:mParamIndex(0), mArraySize(0), mMaterial(nullptr)
 	{
 		if(material != nullptr)
@@ -45,7 +45,7 @@ namespace bs
 			return;
 		}
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		params->setDataParam(*data, arrayIdx, value);
@@ -59,7 +59,7 @@ namespace bs
 		if (mMaterial == nullptr || arrayIdx >= mArraySize)
 			return output;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		params->getDataParam(*data, arrayIdx, output);
@@ -67,7 +67,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	TMaterialParamStruct<Core>::TMaterialParamStruct(const String& name, const MaterialPtrType& material)
+	TMaterialParamStruct<Core>::TMaterialParamStruct(const StringID& name, const MaterialPtrType& material)
 		:mParamIndex(0), mArraySize(0), mMaterial(nullptr)
 	{
 		if (material != nullptr)
@@ -103,7 +103,7 @@ namespace bs
 			return;
 		}
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		params->setStructData(*data, value, sizeBytes, arrayIdx);
@@ -116,7 +116,7 @@ namespace bs
 		if (mMaterial == nullptr || arrayIdx >= mArraySize)
 			return;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		params->getStructData(*data, value, sizeBytes, arrayIdx);
@@ -128,14 +128,14 @@ namespace bs
 		if (mMaterial == nullptr)
 			return 0;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		return params->getStructSize(*data);
 	}
 
 	template<bool Core>
-	TMaterialParamTexture<Core>::TMaterialParamTexture(const String& name, const MaterialPtrType& material)
+	TMaterialParamTexture<Core>::TMaterialParamTexture(const StringID& name, const MaterialPtrType& material)
 		:mParamIndex(0), mMaterial(nullptr)
 	{
 		if (material != nullptr)
@@ -161,7 +161,7 @@ namespace bs
 		if (mMaterial == nullptr)
 			return;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		// If there is a default value, assign that instead of null
@@ -184,7 +184,7 @@ namespace bs
 
 		TextureSurface surface;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		params->getTexture(*data, texture, surface);
@@ -192,7 +192,7 @@ namespace bs
 	}
 	
 	template<bool Core>
-	TMaterialParamLoadStoreTexture<Core>::TMaterialParamLoadStoreTexture(const String& name, 
+	TMaterialParamLoadStoreTexture<Core>::TMaterialParamLoadStoreTexture(const StringID& name, 
 		const MaterialPtrType& material)
 		:mParamIndex(0), mMaterial(nullptr)
 	{
@@ -219,7 +219,7 @@ namespace bs
 		if (mMaterial == nullptr)
 			return;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		params->setLoadStoreTexture(*data, texture, surface);
@@ -237,7 +237,7 @@ namespace bs
 
 		TextureSurface surface;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		params->getLoadStoreTexture(*data, texture, surface);
@@ -246,7 +246,7 @@ namespace bs
 	}
 	
 	template<bool Core>
-	TMaterialParamBuffer<Core>::TMaterialParamBuffer(const String& name, const MaterialPtrType& material)
+	TMaterialParamBuffer<Core>::TMaterialParamBuffer(const StringID& name, const MaterialPtrType& material)
 		:mParamIndex(0), mMaterial(nullptr)
 	{
 		if (material != nullptr)
@@ -272,7 +272,7 @@ namespace bs
 		if (mMaterial == nullptr)
 			return;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		params->setBuffer(*data, buffer);
@@ -287,7 +287,7 @@ namespace bs
 		if (mMaterial == nullptr)
 			return buffer;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 		params->getBuffer(*data, buffer);
 
@@ -295,7 +295,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	TMaterialParamSampState<Core>::TMaterialParamSampState(const String& name, const MaterialPtrType& material)
+	TMaterialParamSampState<Core>::TMaterialParamSampState(const StringID& name, const MaterialPtrType& material)
 		:mParamIndex(0), mMaterial(nullptr)
 	{
 		if (material != nullptr)
@@ -321,7 +321,7 @@ namespace bs
 		if (mMaterial == nullptr)
 			return;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		// If there is a default value, assign that instead of null
@@ -341,13 +341,61 @@ namespace bs
 		if (mMaterial == nullptr)
 			return samplerState;
 
-		SPtr<MaterialParamsType> params = mMaterial->_getInternalParams();
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
 		const MaterialParams::ParamData* data = params->getParamData(mParamIndex);
 
 		params->getSamplerState(*data, samplerState);
 		return samplerState;
 	}
 
+	template<bool Core>
+	TMaterialParamBatch<Core>::TMaterialParamBatch(const Vector<StringID>& names, const MaterialPtrType& material)
+		:mNames(names), mMaterial(nullptr)
+	{
+		if (material != nullptr)
+		{
+			const SPtr<MaterialParamsType>& params = material->_getInternalParams();
+
+			mParamIndices.resize(names.size());
+			for (UINT32 i = 0; i < (UINT32)names.size(); i++)
+			{
+				mParamIndices[i] = params->getParamIndex(names[i]);
+
+				if (mParamIndices[i] == (UINT32)-1)
+					params->reportGetParamError(MaterialParams::GetParamResult::NotFound, names[i], 0);
+			}
+
+			mMaterial = material;
+		}
+	}
+
+	template<bool Core>
+	template<class T>
+	void TMaterialParamBatch<Core>::setValue(UINT32 idx, const T& value) const
+	{
+		const UINT32 paramIdx = mParamIndices[idx];
+		if (paramIdx == (UINT32)-1)
+			return;
+
+		const SPtr<MaterialParamsType>& params = mMaterial->_getInternalParams();
+		const MaterialParams::ParamData* data = params->getParamData(paramIdx);
+
+		if (data->type != MaterialParams::ParamType::Data || 
+			data->dataType != (GpuParamDataType)TGpuDataParamInfo<T>::TypeId)
+		{
+			params->reportGetParamError(MaterialParams::GetParamResult::InvalidType, mNames[idx], 0);
+			return;
+		}
+
+		params->setDataParam(*data, 0, value);
+	}
+
+	template<bool Core>
+	void TMaterialParamBatch<Core>::markDirty() const
+	{
+		mMaterial->_markCoreDirty();
+	}
+
 	template class TMaterialDataParam<float, false>;
 	template class TMaterialDataParam<int, false>;
 	template class TMaterialDataParam<Color, false>;
@@ -400,4 +448,45 @@ namespace bs
 
 	template class TMaterialParamSampState<false>;
 	template class TMaterialParamSampState<true>;
-}
\ No newline at end of file
+
+	template class TMaterialParamBatch<false>;
+	template class TMaterialParamBatch<true>;
+
+	template void TMaterialParamBatch<false>::setValue(UINT32, const float&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const int&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Color&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Vector2&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Vector3&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Vector4&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Vector2I&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Vector3I&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Vector4I&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Matrix2&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Matrix2x3&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Matrix2x4&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Matrix3&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Matrix3x2&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Matrix3x4&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Matrix4&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Matrix4x2&) const;
+	template void TMaterialParamBatch<false>::setValue(UINT32, const Matrix4x3&) const;
+
+	template void TMaterialParamBatch<true>::setValue(UINT32, const float&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const int&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Color&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Vector2&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Vector3&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Vector4&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Vector2I&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Vector3I&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Vector4I&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Matrix2&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Matrix2x3&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Matrix2x4&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Matrix3&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Matrix3x2&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Matrix3x4&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Matrix4&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Matrix4x2&) const;
+	template void TMaterialParamBatch<true>::setValue(UINT32, const Matrix4x3&) const;
+}
@@ -42,7 +42,7 @@ namespace bs
 		typedef typename TMaterialParamsType<Core>::Type MaterialParamsType;
 
 	public:
-		TMaterialDataParam(const String& name, const MaterialPtrType& material);
+		TMaterialDataParam(const StringID& name, const MaterialPtrType& material);
 		TMaterialDataParam() { }
 
 		/** @copydoc TGpuDataParam::set */
@@ -71,7 +71,7 @@ namespace bs
 		typedef typename TMaterialParamsType<Core>::Type MaterialParamsType;
 
 	public:
-		TMaterialParamStruct(const String& name, const MaterialPtrType& material);
+		TMaterialParamStruct(const StringID& name, const MaterialPtrType& material);
 		TMaterialParamStruct() { }
 
 		/** @copydoc TGpuParamStruct::set */
@@ -104,7 +104,7 @@ namespace bs
 		typedef typename TGpuParamTextureType<Core>::Type TextureType;
 
 	public:
-		TMaterialParamTexture(const String& name, const MaterialPtrType& material);
+		TMaterialParamTexture(const StringID& name, const MaterialPtrType& material);
 		TMaterialParamTexture() { }
 
 		/** @copydoc GpuParamTexture::set */
@@ -133,7 +133,7 @@ namespace bs
 		typedef typename TGpuParamTextureType<Core>::Type TextureType;
 
 	public:
-		TMaterialParamLoadStoreTexture(const String& name, const MaterialPtrType& material);
+		TMaterialParamLoadStoreTexture(const StringID& name, const MaterialPtrType& material);
 		TMaterialParamLoadStoreTexture() { }
 
 		/** @copydoc GpuParamLoadStoreTexture::set */
@@ -162,7 +162,7 @@ namespace bs
 		typedef typename TGpuBufferType<Core>::Type BufferType;
 
 	public:
-		TMaterialParamBuffer(const String& name, const MaterialPtrType& material);
+		TMaterialParamBuffer(const StringID& name, const MaterialPtrType& material);
 		TMaterialParamBuffer() { }
 
 		/** @copydoc GpuParamBuffer::set */
@@ -191,7 +191,7 @@ namespace bs
 		typedef typename TGpuParamSamplerStateType<Core>::Type SamplerStateType;
 
 	public:
-		TMaterialParamSampState(const String& name, const MaterialPtrType& material);
+		TMaterialParamSampState(const StringID& name, const MaterialPtrType& material);
 		TMaterialParamSampState() { }
 
 		/** @copydoc GpuParamSampState::set */
@@ -211,6 +211,63 @@ namespace bs
 		MaterialPtrType mMaterial;
 	};
 
+	/**
+	 * A handle to a set of Material data parameters that are usually written together. Parameter names are resolved once
+	 * on construction, after which all the parameters can be written with a single call, marking the material dirty only
+	 * once.
+	 *
+	 * @see		Material
+	 */
+	template<bool Core>
+	class BS_CORE_EXPORT TMaterialParamBatch
+	{
+		typedef typename TMaterialType<Core>::Type MaterialPtrType;
+		typedef typename TMaterialParamsType<Core>::Type MaterialParamsType;
+
+	public:
+		TMaterialParamBatch(const Vector<StringID>& names, const MaterialPtrType& material);
+		TMaterialParamBatch() { }
+
+		/**
+		 * Assigns values to all the parameters in the batch, in the order their names were provided on construction. Type
+		 * of each value must match the type of its parameter. Values are written to the first array element.
+		 */
+		template<class... Types>
+		void set(const Types&... values) const
+		{
+			if (mMaterial == nullptr)
+				return;
+
+			assert(sizeof...(Types) == mParamIndices.size());
+
+			UINT32 idx = 0;
+			(void)std::initializer_list<int>{ (setValue(idx++, values), 0)... };
+
+			markDirty();
+		}
+
+		/** Returns the number of parameters in the batch. */
+		UINT32 getNumParams() const { return (UINT32)mParamIndices.size(); }
+
+		/** Checks if param is initialized. */
+		bool operator==(const std::nullptr_t& nullval) const
+		{
+			return mMaterial == nullptr;
+		}
+
+	protected:
+		/** Writes the value of a single parameter in the batch, without marking the material dirty. */
+		template<class T>
+		void setValue(UINT32 idx, const T& value) const;
+
+		/** Notifies the material its parameters were modified. */
+		void markDirty() const;
+
+		Vector<StringID> mNames;
+		Vector<UINT32> mParamIndices;
+		MaterialPtrType mMaterial;
+	};
+
 	/** @} */
 
 	/** @addtogroup Material
@@ -234,6 +291,7 @@ namespace bs
 	typedef TMaterialParamLoadStoreTexture<false> MaterialParamLoadStoreTexture;
 	typedef TMaterialParamBuffer<false> MaterialParamBuffer;
 	typedef TMaterialParamSampState<false> MaterialParamSampState;
+	typedef TMaterialParamBatch<false> MaterialParamBatch;
 
 	namespace ct
 	{
@@ -254,6 +312,7 @@ namespace bs
 		typedef TMaterialParamLoadStoreTexture<true> MaterialParamLoadStoreTexture;
 		typedef TMaterialParamBuffer<true> MaterialParamBuffer;
 		typedef TMaterialParamSampState<true> MaterialParamSampState;
+		typedef TMaterialParamBatch<true> MaterialParamBatch;
 	}
 
 	/** @} */
@@ -6,6 +6,7 @@
 #include "Image/BsTexture.h"
 #include "RenderAPI/BsGpuBuffer.h"
 #include "RenderAPI/BsSamplerState.h"
+#include "Math/BsMath.h"
 
 namespace bs
 {
@@ -112,6 +113,8 @@ namespace bs
 
 			samplerIdx++;
 		}
+
+		initDirtyMasks();
 	}
 
 	MaterialParamsBase::~MaterialParamsBase()
@@ -121,7 +124,7 @@ namespace bs
 		mAlloc.clear();
 	}
 
-	UINT32 MaterialParamsBase::getParamIndex(const String& name) const
+	UINT32 MaterialParamsBase::getParamIndex(const StringID& name) const
 	{
 		auto iterFind = mParamLookup.find(name);
 		if (iterFind == mParamLookup.end())
@@ -130,7 +133,7 @@ namespace bs
 		return iterFind->second;
 	}
 
-	MaterialParamsBase::GetParamResult MaterialParamsBase::getParamIndex(const String& name, ParamType type,
+	MaterialParamsBase::GetParamResult MaterialParamsBase::getParamIndex(const StringID& name, ParamType type,
 		GpuParamDataType dataType, UINT32 arrayIdx, UINT32& output) const
 	{
 		auto iterFind = mParamLookup.find(name);
@@ -150,7 +153,7 @@ namespace bs
 		return GetParamResult::Success;
 	}
 
-	MaterialParamsBase::GetParamResult MaterialParamsBase::getParamData(const String& name, ParamType type, 
+	MaterialParamsBase::GetParamResult MaterialParamsBase::getParamData(const StringID& name, ParamType type, 
 		GpuParamDataType dataType, UINT32 arrayIdx, const ParamData** output) const
 	{
 		auto iterFind = mParamLookup.find(name);
@@ -170,24 +173,82 @@ namespace bs
 		return GetParamResult::Success;
 	}
 
-	void MaterialParamsBase::reportGetParamError(GetParamResult errorCode, const String& name, UINT32 arrayIdx) const
+	void MaterialParamsBase::reportGetParamError(GetParamResult errorCode, const StringID& name, UINT32 arrayIdx) const
 	{
+		const String paramName = name.empty() ? String() : String(name.cstr());
+
 		switch (errorCode)
 		{
 		case GetParamResult::NotFound:
-			LOGWRN("Material doesn't have a parameter named " + name + ".");
+			LOGWRN("Material doesn't have a parameter named " + paramName + ".");
 			break;
 		case GetParamResult::InvalidType:
-			LOGWRN("Parameter \"" + name + "\" is not of the requested type.");
+			LOGWRN("Parameter \"" + paramName + "\" is not of the requested type.");
 			break;
 		case GetParamResult::IndexOutOfBounds:
-			LOGWRN("Parameter \"" + name + "\" array index " + toString(arrayIdx) + " out of range.");
+			LOGWRN("Parameter \"" + paramName + "\" array index " + toString(arrayIdx) + " out of range.");
 			break;
 		default:
 			break;
 		}
 	}
 
+	bool MaterialParamsBase::getDirtyParams(UINT64 version, Vector<UINT64>& output) const
+	{
+		UINT64 generationStart;
+		if (version >= mDirtyMaskVersions[0])
+		{
+			output = mDirtyMasks[0];
+			generationStart = mDirtyMaskVersions[0];
+
+			// Caller has caught up with the newer generation, start a new one if anything changed since it was started
+			if (mParamVersion > mDirtyMaskVersions[0])
+			{
+				std::swap(mDirtyMasks[0], mDirtyMasks[1]);
+				mDirtyMaskVersions[1] = mDirtyMaskVersions[0];
+
+				std::fill(mDirtyMasks[0].begin(), mDirtyMasks[0].end(), 0);
+				mDirtyMaskVersions[0] = mParamVersion;
+			}
+		}
+		else if (version >= mDirtyMaskVersions[1])
+		{
+			output = mDirtyMasks[1];
+			generationStart = mDirtyMaskVersions[1];
+		}
+		else
+			return false;
+
+		if (version == generationStart)
+			return true;
+
+		// Masks also contain parameters modified after the generation started, but before the provided version
+		for (UINT32 i = 0; i < (UINT32)output.size(); i++)
+		{
+			UINT64& entry = output[i];
+
+			UINT64 remaining = entry;
+			for (UINT32 j = 0; remaining != 0; j++, remaining >>= 1)
+			{
+				if ((remaining & 1) != 0 && mParams[i * PARAMS_PER_MASK_ENTRY + j].version <= version)
+					entry &= ~(1ULL << j);
+			}
+		}
+
+		return true;
+	}
+
+	void MaterialParamsBase::initDirtyMasks()
+	{
+		const UINT32 numEntries = Math::divideAndRoundUp((UINT32)mParams.size(), PARAMS_PER_MASK_ENTRY);
+
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			mDirtyMasks[i].assign(numEntries, 0);
+			mDirtyMaskVersions[i] = mParamVersion;
+		}
+	}
+
 	RTTITypeBase* MaterialParamStructData::getRTTIStatic()
 	{
 		return MaterialParamStructDataRTTI::instance();
@@ -289,7 +350,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TMaterialParams<Core>::getStructData(const String& name, void* value, UINT32 size, UINT32 arrayIdx) const
+	void TMaterialParams<Core>::getStructData(const StringID& name, void* value, UINT32 size, UINT32 arrayIdx) const
 	{
 		const ParamData* param = nullptr;
 		GetParamResult result = getParamData(name, ParamType::Data, GPDT_STRUCT, arrayIdx, &param);
@@ -303,7 +364,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TMaterialParams<Core>::setStructData(const String& name, const void* value, UINT32 size, UINT32 arrayIdx)
+	void TMaterialParams<Core>::setStructData(const StringID& name, const void* value, UINT32 size, UINT32 arrayIdx)
 	{
 		const ParamData* param = nullptr;
 		GetParamResult result = getParamData(name, ParamType::Data, GPDT_STRUCT, arrayIdx, &param);
@@ -317,7 +378,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TMaterialParams<Core>::getTexture(const String& name, TextureType& value, TextureSurface& surface) const
+	void TMaterialParams<Core>::getTexture(const StringID& name, TextureType& value, TextureSurface& surface) const
 	{
 		const ParamData* param = nullptr;
 		GetParamResult result = getParamData(name, ParamType::Texture, GPDT_UNKNOWN, 0, &param);
@@ -331,7 +392,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TMaterialParams<Core>::setTexture(const String& name, const TextureType& value, const TextureSurface& surface)
+	void TMaterialParams<Core>::setTexture(const StringID& name, const TextureType& value, const TextureSurface& surface)
 	{
 		const ParamData* param = nullptr;
 		GetParamResult result = getParamData(name, ParamType::Texture, GPDT_UNKNOWN, 0, &param);
@@ -345,7 +406,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TMaterialParams<Core>::getLoadStoreTexture(const String& name, TextureType& value, TextureSurface& surface) const
+	void TMaterialParams<Core>::getLoadStoreTexture(const StringID& name, TextureType& value, TextureSurface& surface) const
 	{
 		const ParamData* param = nullptr;
 		GetParamResult result = getParamData(name, ParamType::Texture, GPDT_UNKNOWN, 0, &param);
@@ -359,7 +420,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TMaterialParams<Core>::setLoadStoreTexture(const String& name, const TextureType& value, const TextureSurface& surface)
+	void TMaterialParams<Core>::setLoadStoreTexture(const StringID& name, const TextureType& value, const TextureSurface& surface)
 	{
 		const ParamData* param = nullptr;
 		GetParamResult result = getParamData(name, ParamType::Texture, GPDT_UNKNOWN, 0, &param);
@@ -373,7 +434,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TMaterialParams<Core>::getBuffer(const String& name, BufferType& value) const
+	void TMaterialParams<Core>::getBuffer(const StringID& name, BufferType& value) const
 	{
 		const ParamData* param = nullptr;
 		GetParamResult result = getParamData(name, ParamType::Buffer, GPDT_UNKNOWN, 0, &param);
@@ -387,7 +448,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TMaterialParams<Core>::setBuffer(const String& name, const BufferType& value)
+	void TMaterialParams<Core>::setBuffer(const StringID& name, const BufferType& value)
 	{
 		const ParamData* param = nullptr;
 		GetParamResult result = getParamData(name, ParamType::Buffer, GPDT_UNKNOWN, 0, &param);
@@ -401,7 +462,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TMaterialParams<Core>::getSamplerState(const String& name, SamplerType& value) const
+	void TMaterialParams<Core>::getSamplerState(const StringID& name, SamplerType& value) const
 	{
 		const ParamData* param = nullptr;
 		GetParamResult result = getParamData(name, ParamType::Sampler, GPDT_UNKNOWN, 0, &param);
@@ -415,7 +476,7 @@ namespace bs
 	}
 
 	template<bool Core>
-	void TMaterialParams<Core>::setSamplerState(const String& name, const SamplerType& value)
+	void TMaterialParams<Core>::setSamplerState(const StringID& name, const SamplerType& value)
 	{
 		const ParamData* param = nullptr;
 		GetParamResult result = getParamData(name, ParamType::Sampler, GPDT_UNKNOWN, 0, &param);
@@ -454,7 +515,7 @@ namespace bs
 		}
 
 		memcpy(structParam.data, value, structParam.dataSize);
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -480,7 +541,7 @@ namespace bs
 		textureParam.isLoadStore = false;
 		textureParam.surface = surface;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -494,7 +555,7 @@ namespace bs
 	{
 		mBufferParams[param.index].value = value;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -513,7 +574,7 @@ namespace bs
 		textureParam.isLoadStore = true;
 		textureParam.surface = surface;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -533,7 +594,7 @@ namespace bs
 	{
 		mSamplerStateParams[param.index].value = value;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -846,6 +907,7 @@ namespace bs
 
 			ParamData& param = mParams[paramIdx];
 			param.version = mParamVersion;
+			setDirtyBit(paramIdx);
 
 			UINT32 arraySize = param.arraySize > 1 ? param.arraySize : 1;
 			const GpuParamDataTypeInfo& typeInfo = bs::GpuParams::PARAM_SIZES.lookup[(int)param.dataType];
@@ -863,6 +925,7 @@ namespace bs
 
 			ParamData& param = mParams[paramIdx];
 			param.version = mParamVersion;
+			setDirtyBit(paramIdx);
 
 			MaterialParamTextureDataCore* sourceTexData = (MaterialParamTextureDataCore*)sourceData;
 			sourceData += sizeof(MaterialParamTextureDataCore);
@@ -878,6 +941,7 @@ namespace bs
 
 			ParamData& param = mParams[paramIdx];
 			param.version = mParamVersion;
+			setDirtyBit(paramIdx);
 
 			MaterialParamBufferDataCore* sourceBufferData = (MaterialParamBufferDataCore*)sourceData;
 			sourceData += sizeof(MaterialParamBufferDataCore);
@@ -893,6 +957,7 @@ namespace bs
 
 			ParamData& param = mParams[paramIdx];
 			param.version = mParamVersion;
+			setDirtyBit(paramIdx);
 
 			MaterialParamSamplerStateDataCore* sourceSamplerStateData = (MaterialParamSamplerStateDataCore*)sourceData;
 			sourceData += sizeof(MaterialParamSamplerStateDataCore);
@@ -71,20 +71,19 @@ namespace bs
 		 * @tparam		T			Native type of the parameter.
 		 */
 		template <typename T>
-		void getDataParam(const String& name, UINT32 arrayIdx, T& output) const
+		void getDataParam(const StringID& name, UINT32 arrayIdx, T& output) const
 		{
-			GpuParamDataType dataType = TGpuDataParamInfo<T>::TypeId;
+			GpuParamDataType dataType = (GpuParamDataType)TGpuDataParamInfo<T>::TypeId;
 
 			const ParamData* param = nullptr;
 			auto result = getParamData(name, ParamType::Data, dataType, arrayIdx, &param);
 			if (result != GetParamResult::Success)
+			{
+				reportGetParamError(result, name, arrayIdx);
 				return;
+			}
 
-			const GpuParamDataTypeInfo& typeInfo = GpuParams::PARAM_SIZES.lookup[dataType];
-			UINT32 paramTypeSize = typeInfo.numColumns * typeInfo.numRows * typeInfo.baseTypeSize;
-			output = *(T*)(mDataParamsBuffer[param->index + arrayIdx * paramTypeSize]);
-
-			memcpy(output, &mDataParamsBuffer[param->index + arrayIdx * paramTypeSize], sizeof(paramTypeSize));
+			getDataParam(*param, arrayIdx, output);
 		}
 
 		/**
@@ -98,19 +97,19 @@ namespace bs
 		 * @tparam		T			Native type of the parameter.
 		 */
 		template <typename T>
-		void setDataParam(const String& name, UINT32 arrayIdx, const T& input) const
+		void setDataParam(const StringID& name, UINT32 arrayIdx, const T& input) const
 		{
-			GpuParamDataType dataType = TGpuDataParamInfo<T>::TypeId;
+			GpuParamDataType dataType = (GpuParamDataType)TGpuDataParamInfo<T>::TypeId;
 
 			const ParamData* param = nullptr;
 			auto result = getParamData(name, ParamType::Data, dataType, arrayIdx, &param);
 			if (result != GetParamResult::Success)
+			{
+				reportGetParamError(result, name, arrayIdx);
 				return;
+			}
 
-			const GpuParamDataTypeInfo& typeInfo = GpuParams::PARAM_SIZES.lookup[dataType];
-			UINT32 paramTypeSize = typeInfo.numColumns * typeInfo.numRows * typeInfo.baseTypeSize;
-
-			memcpy(&mDataParamsBuffer[param->index + arrayIdx * paramTypeSize], input, sizeof(paramTypeSize));
+			setDataParam(*param, arrayIdx, input);
 		}
 
 		/** 
@@ -120,7 +119,7 @@ namespace bs
 		 * @param[in]	name		Name of the shader parameter.
 		 * @return					Index of the parameter, or -1 if not found.
 		 */
-		UINT32 getParamIndex(const String& name) const;
+		UINT32 getParamIndex(const StringID& name) const;
 
 		/** 
 		 * Returns an index of the parameter with the specified name. Index can be used in a call to getParamData(UINT32) to
@@ -135,7 +134,7 @@ namespace bs
 		 * @param[out]	output		Index of the requested parameter, only valid if success is returned.
 		 * @return					Success or error state of the request.
 		 */
-		GetParamResult getParamIndex(const String& name, ParamType type, GpuParamDataType dataType, UINT32 arrayIdx,
+		GetParamResult getParamIndex(const StringID& name, ParamType type, GpuParamDataType dataType, UINT32 arrayIdx,
 			UINT32& output) const;
 
 		/**
@@ -153,7 +152,7 @@ namespace bs
 		 *							some other error was reported.
 		 * @return					Success or error state of the request.
 		 */
-		GetParamResult getParamData(const String& name, ParamType type, GpuParamDataType dataType, UINT32 arrayIdx,
+		GetParamResult getParamData(const StringID& name, ParamType type, GpuParamDataType dataType, UINT32 arrayIdx,
 			const ParamData** output) const;
 
 		/**
@@ -171,10 +170,10 @@ namespace bs
 		 * @param[in]	name		Name of the shader parameter for which the error occurred.
 		 * @param[in]	arrayIdx	Array index for which the error occurred.
 		 */
-		void reportGetParamError(GetParamResult errorCode, const String& name, UINT32 arrayIdx) const;
+		void reportGetParamError(GetParamResult errorCode, const StringID& name, UINT32 arrayIdx) const;
 
 		/**
-		 * Equivalent to getDataParam(const String&, UINT32, T&) except it uses the internal parameter reference
+		 * Equivalent to getDataParam(const StringID&, UINT32, T&) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
 		 * object.
 		 */
@@ -191,7 +190,7 @@ namespace bs
 		}
 
 		/**
-		 * Equivalent to setDataParam(const String&, UINT32, T&) except it uses the internal parameter reference
+		 * Equivalent to setDataParam(const StringID&, UINT32, T&) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
 		 * object.
 		 */
@@ -206,7 +205,7 @@ namespace bs
 			assert(sizeof(input) == paramTypeSize);
 			memcpy(&mDataParamsBuffer[param.index + arrayIdx * paramTypeSize], &input, paramTypeSize);
 
-			param.version = ++mParamVersion;
+			markParamDirty(param);
 		}
 
 		/** Returns pointer to the internal data buffer for a data parameter at the specified index. */
@@ -218,10 +217,49 @@ namespace bs
 		/** Returns a counter that gets incremented whenever a parameter gets updated. */
 		UINT64 getParamVersion() const { return mParamVersion; }
 
+		/**
+		 * Finds all parameters that were modified since the provided version, as returned by getParamVersion().
+		 *
+		 * @param[in]	version		Version to compare the parameter versions against.
+		 * @param[out]	output		Bitmask with one bit per parameter (in the order of parameter indices), set for every
+		 *							parameter modified after @p version. Resized to hold a bit for each parameter.
+		 * @return					True if the output mask was populated. False if the changes since @p version are no
+		 *							longer tracked, in which case the caller must check the version of each parameter.
+		 *
+		 * @note	
+		 * Changes are tracked in two generations of dirty masks, the newer generation being started whenever a caller
+		 * requests the changes since (or after) the start of the current one. This allows multiple callers that check for
+		 * changes at roughly the same frequency (for example once per frame) to only ever look at the dirty parameters.
+		 */
+		bool getDirtyParams(UINT64 version, Vector<UINT64>& output) const;
+
+		/** Number of parameters whose dirty bits are stored in a single entry of a dirty mask. */
+		static constexpr UINT32 PARAMS_PER_MASK_ENTRY = 64;
+
 	protected:
+		/** Updates the version of the provided parameter and records the change in the dirty masks. */
+		void markParamDirty(const ParamData& param) const
+		{
+			param.version = ++mParamVersion;
+			setDirtyBit((UINT32)(&param - mParams.data()));
+		}
+
+		/** Marks the parameter with the specified index as changed in both generations of the dirty masks. */
+		void setDirtyBit(UINT32 paramIdx) const
+		{
+			const UINT64 bit = 1ULL << (paramIdx % PARAMS_PER_MASK_ENTRY);
+			const UINT32 entryIdx = paramIdx / PARAMS_PER_MASK_ENTRY;
+
+			mDirtyMasks[0][entryIdx] |= bit;
+			mDirtyMasks[1][entryIdx] |= bit;
+		}
+
+		/** Allocates the dirty masks for the current set of parameters. Must be called whenever the set changes. */
+		void initDirtyMasks();
+
 		const static UINT32 STATIC_BUFFER_SIZE = 256;
 
-		UnorderedMap<String, UINT32> mParamLookup;
+		UnorderedMap<StringID, UINT32> mParamLookup;
 		Vector<ParamData> mParams;
 
 		UINT8* mDataParamsBuffer = nullptr;
@@ -234,6 +272,10 @@ namespace bs
 
 		mutable UINT64 mParamVersion = 1;
 		mutable StaticAlloc<STATIC_BUFFER_SIZE> mAlloc;
+
+		// Dirty mask generations, and versions at which they were started. The first generation is the newer one.
+		mutable Vector<UINT64> mDirtyMasks[2];
+		mutable UINT64 mDirtyMaskVersions[2] = { 1, 1 };
 	};
 
 	/** Raw data for a single structure parameter. */
@@ -368,7 +410,7 @@ namespace bs
 		 * @param[in]	size		Size of the buffer into which to write the value. Must match parameter struct's size.
 		 * @param[in]	arrayIdx	If the parameter is an array, index of the entry to access.
 		 */
-		void getStructData(const String& name, void* value, UINT32 size, UINT32 arrayIdx) const;
+		void getStructData(const StringID& name, void* value, UINT32 size, UINT32 arrayIdx) const;
 
 		/**
 		 * Sets the value of a shader structure parameter with the specified name at the specified array index. If the
@@ -379,7 +421,7 @@ namespace bs
 		 * @param[in]	size		Size of the buffer from which to retrieve the value. Must match parameter struct's size.
 		 * @param[in]	arrayIdx	If the parameter is an array, index of the entry to access.
 		 */
-		void setStructData(const String& name, const void* value, UINT32 size, UINT32 arrayIdx);
+		void setStructData(const StringID& name, const void* value, UINT32 size, UINT32 arrayIdx);
 
 		/**
 		 * Returns the value of a shader texture parameter with the specified name. If the parameter name or type is not
@@ -389,7 +431,7 @@ namespace bs
 		 * @param[out]	value		Output value of the parameter.
 		 * @param[out]	surface		Surface describing which part of the texture is being accessed.
 		 */
-		void getTexture(const String& name, TextureType& value, TextureSurface& surface) const;
+		void getTexture(const StringID& name, TextureType& value, TextureSurface& surface) const;
 
 		/**
 		 * Sets the value of a shader texture parameter with the specified name. If the parameter name or type is not
@@ -399,7 +441,7 @@ namespace bs
 		 * @param[in]	value		New value of the parameter.
 		 * @param[in]	surface		Surface describing which part of the texture is being accessed.
 		 */
-		void setTexture(const String& name, const TextureType& value, 
+		void setTexture(const StringID& name, const TextureType& value, 
 						const TextureSurface& surface = TextureSurface::COMPLETE);
 
 		/**
@@ -410,7 +452,7 @@ namespace bs
 		 * @param[out]	value		Output value of the parameter.
 		 * @param[out]	surface		Surface describing which part of the texture is being accessed.
 		 */
-		void getLoadStoreTexture(const String& name, TextureType& value, TextureSurface& surface) const;
+		void getLoadStoreTexture(const StringID& name, TextureType& value, TextureSurface& surface) const;
 
 		/**
 		 * Sets the value of a shader load/store texture parameter with the specified name. If the parameter name or
@@ -420,7 +462,7 @@ namespace bs
 		 * @param[in]	value		New value of the parameter.
 		 * @param[in]	surface		Surface describing which part of the texture is being accessed.
 		 */
-		void setLoadStoreTexture(const String& name, const TextureType& value, const TextureSurface& surface);
+		void setLoadStoreTexture(const StringID& name, const TextureType& value, const TextureSurface& surface);
 
 		/**
 		 * Returns the value of a shader buffer parameter with the specified name. If the parameter name or type is not
@@ -429,7 +471,7 @@ namespace bs
 		 * @param[in]	name		Name of the shader parameter.
 		 * @param[out]	value		Output value of the parameter.
 		 */
-		void getBuffer(const String& name, BufferType& value) const;
+		void getBuffer(const StringID& name, BufferType& value) const;
 
 		/**
 		 * Sets the value of a shader buffer parameter with the specified name. If the parameter name or type is not
@@ -438,7 +480,7 @@ namespace bs
 		 * @param[in]	name		Name of the shader parameter.
 		 * @param[in]	value		New value of the parameter.
 		 */
-		void setBuffer(const String& name, const BufferType& value);
+		void setBuffer(const StringID& name, const BufferType& value);
 
 		/**
 		 * Sets the value of a shader sampler state parameter with the specified name. If the parameter name or type is not
@@ -447,7 +489,7 @@ namespace bs
 		 * @param[in]	name		Name of the shader parameter.
 		 * @param[out]	value		Output value of the parameter.
 		 */
-		void getSamplerState(const String& name, SamplerType& value) const;
+		void getSamplerState(const StringID& name, SamplerType& value) const;
 
 		/**
 		 * Sets the value of a shader sampler state parameter with the specified name. If the parameter name or type is not
@@ -456,17 +498,17 @@ namespace bs
 		 * @param[in]	name		Name of the shader parameter.
 		 * @param[in]	value		New value of the parameter.
 		 */
-		void setSamplerState(const String& name, const SamplerType& value);
+		void setSamplerState(const StringID& name, const SamplerType& value);
 
 		/**
-		 * Equivalent to getStructData(const String&, UINT32, void*, UINT32) except it uses the internal parameter reference
+		 * Equivalent to getStructData(const StringID&, UINT32, void*, UINT32) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
 		 * object.
 		 */
 		void getStructData(const ParamData& param, void* value, UINT32 size, UINT32 arrayIdx) const;
 
 		/**
-		 * Equivalent to setStructData(const String&, UINT32, void*, UINT32) except it uses the internal parameter reference
+		 * Equivalent to setStructData(const StringID&, UINT32, void*, UINT32) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
 		 * object.
 		 */
@@ -479,41 +521,41 @@ namespace bs
 		UINT32 getStructSize(const ParamData& param) const;
 
 		/**
-		 * Equivalent to getTexture(const String&, HTexture&) except it uses the internal parameter reference directly,
+		 * Equivalent to getTexture(const StringID&, HTexture&) except it uses the internal parameter reference directly,
 		 * avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this object.
 		 */
 		void getTexture(const ParamData& param, TextureType& value, TextureSurface& surface) const;
 
 		/**
-		 * Equivalent to setTexture(const String&, HTexture&) except it uses the internal parameter reference directly,
+		 * Equivalent to setTexture(const StringID&, HTexture&) except it uses the internal parameter reference directly,
 		 * avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this object.
 		 */
 		void setTexture(const ParamData& param, const TextureType& value, 
 						const TextureSurface& surface = TextureSurface::COMPLETE);
 
 		/**
-		 * Equivalent to getBuffer(const String&, SPtr<GpuBuffer>&) except it uses the internal parameter reference
+		 * Equivalent to getBuffer(const StringID&, SPtr<GpuBuffer>&) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
 		 * object.
 		 */
 		void getBuffer(const ParamData& param, BufferType& value) const;
 
 		/**
-		 * Equivalent to setBuffer(const String&, SPtr<GpuBuffer>&) except it uses the internal parameter reference
+		 * Equivalent to setBuffer(const StringID&, SPtr<GpuBuffer>&) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
 		 * object.
 		 */
 		void setBuffer(const ParamData& param, const BufferType& value);
 
 		/**
-		 * Equivalent to getLoadStoreTexture(const String&, HTexture&, TextureSurface&) except it uses the internal
+		 * Equivalent to getLoadStoreTexture(const StringID&, HTexture&, TextureSurface&) except it uses the internal
 		 * parameter reference directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid
 		 * and belongs to this object.
 		 */
 		void getLoadStoreTexture(const ParamData& param, TextureType& value, TextureSurface& surface) const;
 
 		/**
-		 * Equivalent to setLoadStoreTexture(const String&, HTexture&, TextureSurface&) except it uses the internal
+		 * Equivalent to setLoadStoreTexture(const StringID&, HTexture&, TextureSurface&) except it uses the internal
 		 * parameter reference directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid
 		 * and belongs to this object.
 		 */
@@ -526,14 +568,14 @@ namespace bs
 		bool getIsTextureLoadStore(const ParamData& param) const;
 
 		/**
-		 * Equivalent to getSamplerState(const String&, SPtr<SamplerState>&) except it uses the internal parameter reference
+		 * Equivalent to getSamplerState(const StringID&, SPtr<SamplerState>&) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
 		 * object.
 		 */
 		void getSamplerState(const ParamData& param, SamplerType& value) const;
 
 		/**
-		 * Equivalent to setSamplerState(const String&, SPtr<SamplerState>&) except it uses the internal parameter reference
+		 * Equivalent to setSamplerState(const StringID&, SPtr<SamplerState>&) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
 		 * object.
 		 */
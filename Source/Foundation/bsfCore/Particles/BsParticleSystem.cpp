@@ -4,6 +4,8 @@
 #include "Mesh/BsMesh.h"
 #include "RenderAPI/BsVertexDataDesc.h"
 #include "Mesh/BsMeshUtility.h"
+#include "Math/BsSIMD.h"
+#include "Threading/BsJobScheduler.h"
 
 namespace bs
 {
@@ -58,6 +60,9 @@ namespace bs
 		Vector3* size = nullptr;
 		float* lifetime = nullptr;
 		RGBA* color = nullptr;
+		float* initialLifetime = nullptr;
+		Vector3* initialSize = nullptr;
+		UINT32* seed = nullptr;
 
 	private:
 		/** 
@@ -71,13 +76,20 @@ namespace bs
 				reserve<Vector3>(capacity).
 				reserve<Vector3>(capacity).
 				reserve<float>(capacity).
-				reserve<RGBA>(capacity);
+				reserve<RGBA>(capacity).
+				reserve<float>(capacity).
+				reserve<Vector3>(capacity).
+				reserve<UINT32>(capacity).
+				init();
 
 			position = alloc.alloc<Vector3>(capacity);
 			velocity = alloc.alloc<Vector3>(capacity);
 			size = alloc.alloc<Vector3>(capacity);
 			lifetime = alloc.alloc<float>(capacity);
 			color = alloc.alloc<RGBA>(capacity);
+			initialLifetime = alloc.alloc<float>(capacity);
+			initialSize = alloc.alloc<Vector3>(capacity);
+			seed = alloc.alloc<UINT32>(capacity);
 		}
 
 		/** Frees the internal buffers. */
@@ -88,6 +100,9 @@ namespace bs
 			if(size) alloc.free(size);
 			if(lifetime) alloc.free(lifetime);
 			if(color) alloc.free(color);
+			if(initialLifetime) alloc.free(initialLifetime);
+			if(initialSize) alloc.free(initialSize);
+			if(seed) alloc.free(seed);
 		}
 
 		/** Transfers ownership of @p other internal buffers to this object. */
@@ -98,6 +113,9 @@ namespace bs
 			size = other.size; other.size = nullptr;
 			lifetime = other.lifetime; other.lifetime = nullptr;
 			color = other.color; other.color = nullptr;
+			initialLifetime = other.initialLifetime; other.initialLifetime = nullptr;
+			initialSize = other.initialSize; other.initialSize = nullptr;
+			seed = other.seed; other.seed = nullptr;
 			capacity = other.capacity; other.capacity = 0;
 			alloc = std::move(other.alloc);
 		}
@@ -111,7 +129,10 @@ namespace bs
 			memcpy(velocity, other.velocity, other.capacity * sizeof(Vector3));
 			memcpy(size, other.size, other.capacity * sizeof(Vector3));
 			memcpy(lifetime, other.lifetime, other.capacity * sizeof(float));
-			memcpy(color, other.color, other.capacity * sizeof(Color));
+			memcpy(color, other.color, other.capacity * sizeof(RGBA));
+			memcpy(initialLifetime, other.initialLifetime, other.capacity * sizeof(float));
+			memcpy(initialSize, other.initialSize, other.capacity * sizeof(Vector3));
+			memcpy(seed, other.seed, other.capacity * sizeof(UINT32));
 		}
 
 		GroupAlloc alloc;
@@ -170,6 +191,9 @@ namespace bs
 				std::swap(mParticles.size[idx], mParticles.size[lastIdx]);
 				std::swap(mParticles.lifetime[idx], mParticles.lifetime[lastIdx]);
 				std::swap(mParticles.color[idx], mParticles.color[lastIdx]);
+				std::swap(mParticles.initialLifetime[idx], mParticles.initialLifetime[lastIdx]);
+				std::swap(mParticles.initialSize[idx], mParticles.initialSize[lastIdx]);
+				std::swap(mParticles.seed[idx], mParticles.seed[lastIdx]);
 			}
 
 			mCount--;
@@ -178,6 +202,9 @@ namespace bs
 		/** Returns all data about the particles. Active particles are always sequential at the start of the buffer. */
 		ParticleSetData& getParticles() { return mParticles; }
 
+		/** @copydoc getParticles() */
+		const ParticleSetData& getParticles() const { return mParticles; }
+
 		/** Returns the number of particles that are currently active. */
 		UINT32 getParticleCount() const { return mCount; }
 
@@ -1349,4 +1376,399 @@ namespace bs
 		return bs_unique_ptr(output);
 	}
 
+	/** Number of floats processed by a single SIMD operation in the particle update kernels. */
+	static constexpr UINT32 SIMD_WIDTH = 4;
+
+	/** Number of particles whose normalized age is calculated at once by the over-lifetime evolvers. */
+	static constexpr UINT32 AGE_BATCH_SIZE = 64;
+
+	/** Performs dst[i] += src[i] * scale for each of the @p count floats. */
+	static void multiplyAdd(float* dst, const float* src, float scale, UINT32 count)
+	{
+		using namespace simd;
+
+		const float32x4 scaleVec = splat<float32x4>(scale);
+
+		UINT32 i = 0;
+		for(; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+		{
+			const float32x4 value = load_u<float32x4>(dst + i);
+			const float32x4 delta = load_u<float32x4>(src + i);
+			store_u(dst + i, float32x4(add(value, mul(delta, scaleVec))));
+		}
+
+		for(; i < count; i++)
+			dst[i] += src[i] * scale;
+	}
+
+	/** Adds @p value to each of the @p count vectors in @p dst. */
+	static void addVector(Vector3* dst, const Vector3& value, UINT32 count)
+	{
+		using namespace simd;
+
+		// Three registers hold four repetitions of the vector, matching the layout of four consecutive vectors
+		SIMDPP_ALIGN(16) float pattern[SIMD_WIDTH * 3];
+		for(UINT32 i = 0; i < SIMD_WIDTH; i++)
+		{
+			pattern[i * 3 + 0] = value.x;
+			pattern[i * 3 + 1] = value.y;
+			pattern[i * 3 + 2] = value.z;
+		}
+
+		const float32x4 patternA = load<float32x4>(pattern);
+		const float32x4 patternB = load<float32x4>(pattern + SIMD_WIDTH);
+		const float32x4 patternC = load<float32x4>(pattern + SIMD_WIDTH * 2);
+
+		float* data = (float*)dst;
+		const UINT32 numFloats = count * 3;
+
+		UINT32 i = 0;
+		for(; i + SIMD_WIDTH * 3 <= numFloats; i += SIMD_WIDTH * 3)
+		{
+			store_u(data + i, float32x4(add(load_u<float32x4>(data + i), patternA)));
+			store_u(data + i + SIMD_WIDTH, float32x4(add(load_u<float32x4>(data + i + SIMD_WIDTH), patternB)));
+			store_u(data + i + SIMD_WIDTH * 2, float32x4(add(load_u<float32x4>(data + i + SIMD_WIDTH * 2), patternC)));
+		}
+
+		for(; i < numFloats; i++)
+			data[i] += pattern[i % 3];
+	}
+
+	/** 
+	 * Subtracts @p timeStep from the lifetime of all particles in the set, and frees the particles whose lifetime
+	 * has expired.
+	 */
+	static void decayLifetime(ParticleSet& particles, float timeStep)
+	{
+		using namespace simd;
+
+		ParticleSetData& data = particles.getParticles();
+		const UINT32 count = particles.getParticleCount();
+
+		// Particles are processed back to front, so that particles moved into the place of freed particles have already
+		// been processed
+		const UINT32 numAligned = count - count % SIMD_WIDTH;
+		for(UINT32 i = count; i > numAligned; i--)
+		{
+			data.lifetime[i - 1] -= timeStep;
+			if(data.lifetime[i - 1] <= 0.0f)
+				particles.freeParticle(i - 1);
+		}
+
+		const float32x4 timeStepVec = splat<float32x4>(timeStep);
+		const float32x4 zero = make_zero();
+		for(UINT32 i = numAligned; i > 0; i -= SIMD_WIDTH)
+		{
+			float* lifetime = data.lifetime + i - SIMD_WIDTH;
+
+			const float32x4 value = sub(load_u<float32x4>(lifetime), timeStepVec);
+			store_u(lifetime, value);
+
+			if(!test_bits_any(bit_cast<uint32x4>(cmp_le(value, zero))))
+				continue;
+
+			for(UINT32 j = SIMD_WIDTH; j > 0; j--)
+			{
+				const UINT32 idx = i - SIMD_WIDTH + j - 1;
+				if(data.lifetime[idx] <= 0.0f)
+					particles.freeParticle(idx);
+			}
+		}
+	}
+
+	/** 
+	 * Calculates the normalized age of @p count particles starting at @p start, in range [0, 1], where 0 represents
+	 * a newly spawned particle and 1 a particle at the end of its lifetime.
+	 */
+	static void calculateNormalizedAge(const ParticleSetData& data, UINT32 start, UINT32 count, float* output)
+	{
+		using namespace simd;
+
+		const float32x4 zero = make_zero();
+		const float32x4 one = splat<float32x4>(1.0f);
+
+		UINT32 i = 0;
+		for(; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+		{
+			const float32x4 lifetime = load_u<float32x4>(data.lifetime + start + i);
+			const float32x4 initialLifetime = load_u<float32x4>(data.initialLifetime + start + i);
+
+			float32x4 age = sub(one, div(lifetime, initialLifetime));
+			age = min(max(age, zero), one);
+
+			store_u(output + i, age);
+		}
+
+		for(; i < count; i++)
+		{
+			const float age = 1.0f - data.lifetime[start + i] / data.initialLifetime[start + i];
+			output[i] = Math::clamp01(age);
+		}
+	}
+
+	/** Returns a value in range [0, 1] determined by the lower 16 bits of the particle seed. */
+	static float getSeedFactorLow(UINT32 seed)
+	{
+		return (seed & 0xFFFF) * (1.0f / 65535.0f);
+	}
+
+	/** Returns a value in range [0, 1] determined by the upper 16 bits of the particle seed. */
+	static float getSeedFactorHigh(UINT32 seed)
+	{
+		return (seed >> 16) * (1.0f / 65535.0f);
+	}
+
+	void ParticleEmitter::spawn(const Random& random, const ParticleSystemState& state, ParticleSet& particles)
+	{
+		if(!mShape)
+			return;
+
+		mEmitAccumulator += mEmissionRate * state.timeStep;
+
+		UINT32 count = (UINT32)mEmitAccumulator;
+		mEmitAccumulator -= (float)count;
+
+		const UINT32 start = particles.getParticleCount();
+		if(start >= state.maxParticles)
+			return;
+
+		count = std::min(count, state.maxParticles - start);
+		if(count == 0)
+			return;
+
+		ParticleEmitterState emitterState;
+		bs_zero_out(emitterState);
+
+		mShape->spawn(random, particles, count, emitterState);
+
+		// Note: The shape outputs the particle normal in place of the velocity
+		ParticleSetData& data = particles.getParticles();
+		const float t = state.normalizedTime;
+
+		const UINT32 end = start + count;
+		for(UINT32 i = start; i < end; i++)
+		{
+			const float lifetime = std::max(mInitialLifetime.evaluate(t, random.getUNorm()), 0.0001f);
+			const float size = mInitialSize.evaluate(t, random.getUNorm());
+
+			data.velocity[i] *= mInitialSpeed.evaluate(t, random.getUNorm());
+			data.lifetime[i] = lifetime;
+			data.initialLifetime[i] = lifetime;
+			data.size[i] = Vector3(size, size, size);
+			data.initialSize[i] = data.size[i];
+			data.color[i] = mInitialColor.evaluate(t, random.getUNorm());
+			data.seed[i] = random.get();
+		}
+	}
+
+	ParticleVelocity::ParticleVelocity(const PARTICLE_VELOCITY_DESC& desc)
+		:mInfo(desc)
+	{ }
+
+	void ParticleVelocity::evolve(const Random& random, const ParticleSystemState& state, ParticleSet& particles) const
+	{
+		ParticleSetData& data = particles.getParticles();
+		addVector(data.position, mInfo.velocity * state.timeStep, particles.getParticleCount());
+	}
+
+	UPtr<ParticleVelocity> ParticleVelocity::create(const PARTICLE_VELOCITY_DESC& desc)
+	{
+		return bs_unique_ptr_new<ParticleVelocity>(desc);
+	}
+
+	ParticleForce::ParticleForce(const PARTICLE_FORCE_DESC& desc)
+		:mInfo(desc)
+	{ }
+
+	void ParticleForce::evolve(const Random& random, const ParticleSystemState& state, ParticleSet& particles) const
+	{
+		ParticleSetData& data = particles.getParticles();
+		addVector(data.velocity, mInfo.force * state.timeStep, particles.getParticleCount());
+	}
+
+	UPtr<ParticleForce> ParticleForce::create(const PARTICLE_FORCE_DESC& desc)
+	{
+		return bs_unique_ptr_new<ParticleForce>(desc);
+	}
+
+	ParticleColor::ParticleColor(const PARTICLE_COLOR_DESC& desc)
+		:mInfo(desc)
+	{
+		// Evaluating gradients per-particle is expensive, so they are baked into a lookup table instead
+		for(UINT32 i = 0; i <= NUM_SAMPLES; i++)
+		{
+			const float t = i / (float)NUM_SAMPLES;
+
+			mMinSamples[i] = mInfo.color.evaluate(t, 0.0f);
+			mMaxSamples[i] = mInfo.color.evaluate(t, 1.0f);
+		}
+	}
+
+	void ParticleColor::evolve(const Random& random, const ParticleSystemState& state, ParticleSet& particles) const
+	{
+		ParticleSetData& data = particles.getParticles();
+		const UINT32 count = particles.getParticleCount();
+
+		float age[AGE_BATCH_SIZE];
+		for(UINT32 start = 0; start < count; start += AGE_BATCH_SIZE)
+		{
+			const UINT32 batchSize = std::min(AGE_BATCH_SIZE, count - start);
+			calculateNormalizedAge(data, start, batchSize, age);
+
+			for(UINT32 i = 0; i < batchSize; i++)
+			{
+				const UINT32 sampleIdx = (UINT32)(age[i] * NUM_SAMPLES + 0.5f);
+				const UINT32 factor = Bitwise::unormToUint<8>(getSeedFactorHigh(data.seed[start + i]));
+
+				data.color[start + i] = Color::lerp((UINT8)factor, mMinSamples[sampleIdx], mMaxSamples[sampleIdx]);
+			}
+		}
+	}
+
+	UPtr<ParticleColor> ParticleColor::create(const PARTICLE_COLOR_DESC& desc)
+	{
+		return bs_unique_ptr_new<ParticleColor>(desc);
+	}
+
+	ParticleSize::ParticleSize(const PARTICLE_SIZE_DESC& desc)
+		:mInfo(desc)
+	{
+		// Evaluating curves per-particle is expensive, so they are baked into a lookup table instead
+		for(UINT32 i = 0; i <= NUM_SAMPLES; i++)
+		{
+			const float t = i / (float)NUM_SAMPLES;
+
+			mMinSamples[i] = mInfo.size.evaluate(t, 0.0f);
+			mMaxSamples[i] = mInfo.size.evaluate(t, 1.0f);
+		}
+	}
+
+	void ParticleSize::evolve(const Random& random, const ParticleSystemState& state, ParticleSet& particles) const
+	{
+		ParticleSetData& data = particles.getParticles();
+		const UINT32 count = particles.getParticleCount();
+
+		float age[AGE_BATCH_SIZE];
+		for(UINT32 start = 0; start < count; start += AGE_BATCH_SIZE)
+		{
+			const UINT32 batchSize = std::min(AGE_BATCH_SIZE, count - start);
+			calculateNormalizedAge(data, start, batchSize, age);
+
+			for(UINT32 i = 0; i < batchSize; i++)
+			{
+				const float pos = age[i] * NUM_SAMPLES;
+				const UINT32 sampleIdx = std::min((UINT32)pos, NUM_SAMPLES - 1);
+				const float frac = pos - (float)sampleIdx;
+
+				const float minValue = Math::lerp(frac, mMinSamples[sampleIdx], mMinSamples[sampleIdx + 1]);
+				const float maxValue = Math::lerp(frac, mMaxSamples[sampleIdx], mMaxSamples[sampleIdx + 1]);
+				const float scale = Math::lerp(getSeedFactorLow(data.seed[start + i]), minValue, maxValue);
+
+				data.size[start + i] = data.initialSize[start + i] * scale;
+			}
+		}
+	}
+
+	UPtr<ParticleSize> ParticleSize::create(const PARTICLE_SIZE_DESC& desc)
+	{
+		return bs_unique_ptr_new<ParticleSize>(desc);
+	}
+
+	ParticleSystem::ParticleSystem(UINT32 seed)
+		:mRandom(seed)
+	{
+		mParticleSet = bs_new<ParticleSet>(64);
+	}
+
+	ParticleSystem::~ParticleSystem()
+	{
+		bs_delete(mParticleSet);
+	}
+
+	UINT32 ParticleSystem::addEmitter(ParticleEmitter* emitter)
+	{
+		mEmitters.push_back(emitter);
+		return (UINT32)mEmitters.size() - 1;
+	}
+
+	UINT32 ParticleSystem::addEvolver(ParticleEvolver* evolver)
+	{
+		mEvolvers.push_back(evolver);
+		return (UINT32)mEvolvers.size() - 1;
+	}
+
+	UINT32 ParticleSystem::getParticleCount() const
+	{
+		return mParticleSet->getParticleCount();
+	}
+
+	void ParticleSystem::simulate(float timeDelta)
+	{
+		mTime += timeDelta;
+		if(mDuration > 0.0f)
+			mTime = std::fmod(mTime, mDuration);
+
+		ParticleSystemState state;
+		state.timeStep = timeDelta;
+		state.normalizedTime = mDuration > 0.0f ? mTime / mDuration : 0.0f;
+		state.maxParticles = mMaxParticles;
+
+		decayLifetime(*mParticleSet, timeDelta);
+
+		for(auto& emitter : mEmitters)
+			emitter->spawn(mRandom, state, *mParticleSet);
+
+		for(auto& evolver : mEvolvers)
+			evolver->evolve(mRandom, state, *mParticleSet);
+
+		ParticleSetData& data = mParticleSet->getParticles();
+		multiplyAdd((float*)data.position, (float*)data.velocity, timeDelta, mParticleSet->getParticleCount() * 3);
+	}
+
+	void ParticleSystem::simulate(ParticleSystem** systems, UINT32 numSystems, float timeDelta)
+	{
+		const bool parallel = numSystems > 1 && JobScheduler::isStarted() &&
+			JobScheduler::instance().getNumActiveWorkers() > 1;
+
+		if(parallel)
+		{
+			// Systems can differ greatly in particle count, so each is a separate task to keep the workers balanced
+			JobScheduler::instance().parallelForAndWait(numSystems, 1, 
+				[systems, timeDelta](UINT32 start, UINT32 count)
+			{
+				for(UINT32 i = start; i < start + count; i++)
+					systems[i]->simulate(timeDelta);
+			});
+		}
+		else
+		{
+			for(UINT32 i = 0; i < numSystems; i++)
+				systems[i]->simulate(timeDelta);
+		}
+	}
+
+	UINT32 ParticleSystem::writeVertices(ParticleVertex* output, UINT32 maxVertices) const
+	{
+		const ParticleSetData& data = mParticleSet->getParticles();
+		const UINT32 count = std::min(mParticleSet->getParticleCount(), maxVertices);
+
+		for(UINT32 i = 0; i < count; i++)
+		{
+			output[i].position = data.position[i];
+			output[i].size = Vector2(data.size[i].x, data.size[i].y);
+			output[i].color = data.color[i];
+		}
+
+		return count;
+	}
+
+	SPtr<VertexDataDesc> ParticleSystem::createVertexDesc()
+	{
+		SPtr<VertexDataDesc> vertexDesc = VertexDataDesc::create();
+		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+		vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD);
+		vertexDesc->addVertElem(VET_COLOR, VES_COLOR);
+
+		return vertexDesc;
+	}
 }
@@ -6,6 +6,7 @@
 #include "Allocators/BsGroupAlloc.h"
 #include "Image/BsColor.h"
 #include "Image/BsColorGradient.h"
+#include "Math/BsVector2.h"
 #include "Math/BsVector3.h"
 #include "Animation/BsAnimationCurve.h"
 #include "Utility/BsBitwise.h"
@@ -530,14 +531,193 @@ namespace bs
 		bool m32BitNormals;
 	};
 
-	// TODO - Doc
+	/** Contains particle system state that varies from frame to frame. */
+	struct ParticleSystemState
+	{
+		/** Time step to advance the simulation by, in seconds. */
+		float timeStep;
+
+		/** System time at the end of the time step, normalized to range [0, 1] over the duration of the system. */
+		float normalizedTime;
+
+		/** Maximum number of particles the system can contain. */
+		UINT32 maxParticles;
+	};
+
+	/** 
+	 * Spawns new particles at a specified rate, using the emitter shape to determine their initial position and
+	 * direction, and the initial property distributions to determine the rest of their properties.
+	 *
+	 * @note	Emitters keep track of fractional particles between frames and therefore must not be shared between
+	 *			multiple particle systems.
+	 */
 	class BS_CORE_EXPORT ParticleEmitter
 	{
 	public:
+		/** Sets the shape that determines the position and direction of the spawned particles. */
 		void setShape(ParticleEmitterShape* shape) { mShape = shape; }
 
+		/** Determines the number of particles spawned per second. */
+		void setEmissionRate(float rate) { mEmissionRate = rate; }
+
+		/** @copydoc setEmissionRate */
+		float getEmissionRate() const { return mEmissionRate; }
+
+		/** Determines the lifetime of the spawned particles, in seconds. Evaluated over the system duration. */
+		void setInitialLifetime(const FloatDistribution& value) { mInitialLifetime = value; }
+
+		/** Determines the speed of the spawned particles along their initial direction. Evaluated over the system duration. */
+		void setInitialSpeed(const FloatDistribution& value) { mInitialSpeed = value; }
+
+		/** Determines the size of the spawned particles. Evaluated over the system duration. */
+		void setInitialSize(const FloatDistribution& value) { mInitialSize = value; }
+
+		/** Determines the color of the spawned particles. Evaluated over the system duration. */
+		void setInitialColor(const ColorDistribution& value) { mInitialColor = value; }
+
+		/**
+		 * Spawns the particles emitted during the time step of the provided system state. Does nothing if the emitter
+		 * has no shape assigned.
+		 *
+		 * @param[in]	random		Random number generator.
+		 * @param[in]	state		State of the particle system the particles are spawned for.
+		 * @param[in]	particles	Particle set in which to insert new particles.
+		 */
+		void spawn(const Random& random, const ParticleSystemState& state, ParticleSet& particles);
+
 	private:
 		ParticleEmitterShape* mShape = nullptr;
+		float mEmissionRate = 50.0f;
+		FloatDistribution mInitialLifetime = FloatDistribution(10.0f);
+		FloatDistribution mInitialSpeed = FloatDistribution(1.0f);
+		FloatDistribution mInitialSize = FloatDistribution(0.1f);
+		ColorDistribution mInitialColor = ColorDistribution(Color::White);
+
+		float mEmitAccumulator = 0.0f;
+	};
+
+	/** Base class for all particle evolvers. Evolvers update the properties of all active particles, every frame. */
+	class BS_CORE_EXPORT ParticleEvolver
+	{
+	public:
+		virtual ~ParticleEvolver() = default;
+
+		/**
+		 * Updates the properties of the active particles.
+		 *
+		 * @param[in]	random		Random number generator.
+		 * @param[in]	state		State of the particle system the particles belong to.
+		 * @param[in]	particles	Particle set containing the particles to update.
+		 */
+		virtual void evolve(const Random& random, const ParticleSystemState& state, ParticleSet& particles) const = 0;
+
+	protected:
+		ParticleEvolver() = default;
+	};
+
+	/** Information describing a ParticleVelocity evolver. */
+	struct PARTICLE_VELOCITY_DESC
+	{
+		/** Velocity added on top of the velocity of each particle, in units per second. */
+		Vector3 velocity = Vector3::ZERO;
+	};
+
+	/** 
+	 * Particle evolver that moves the particles by a constant velocity (e.g. wind), in addition to their own velocity. 
+	 * The particle velocity itself is not modified.
+	 */
+	class BS_CORE_EXPORT ParticleVelocity : public ParticleEvolver
+	{
+	public:
+		ParticleVelocity(const PARTICLE_VELOCITY_DESC& desc);
+
+		/** @copydoc ParticleEvolver::evolve */
+		void evolve(const Random& random, const ParticleSystemState& state, ParticleSet& particles) const override;
+
+		/** Creates a new particle velocity evolver. */
+		static UPtr<ParticleVelocity> create(const PARTICLE_VELOCITY_DESC& desc);
+
+	private:
+		PARTICLE_VELOCITY_DESC mInfo;
+	};
+
+	/** Information describing a ParticleForce evolver. */
+	struct PARTICLE_FORCE_DESC
+	{
+		/** Acceleration applied to the velocity of each particle, in units per second squared (e.g. gravity). */
+		Vector3 force = Vector3::ZERO;
+	};
+
+	/** Particle evolver that accelerates the particles by applying a constant force to them. */
+	class BS_CORE_EXPORT ParticleForce : public ParticleEvolver
+	{
+	public:
+		ParticleForce(const PARTICLE_FORCE_DESC& desc);
+
+		/** @copydoc ParticleEvolver::evolve */
+		void evolve(const Random& random, const ParticleSystemState& state, ParticleSet& particles) const override;
+
+		/** Creates a new particle force evolver. */
+		static UPtr<ParticleForce> create(const PARTICLE_FORCE_DESC& desc);
+
+	private:
+		PARTICLE_FORCE_DESC mInfo;
+	};
+
+	/** Information describing a ParticleColor evolver. */
+	struct PARTICLE_COLOR_DESC
+	{
+		/** Color of the particles, evaluated over the particle lifetime. */
+		ColorDistribution color = ColorDistribution(Color::White);
+	};
+
+	/** Particle evolver that changes the color of the particles over their lifetime. */
+	class BS_CORE_EXPORT ParticleColor : public ParticleEvolver
+	{
+	public:
+		ParticleColor(const PARTICLE_COLOR_DESC& desc);
+
+		/** @copydoc ParticleEvolver::evolve */
+		void evolve(const Random& random, const ParticleSystemState& state, ParticleSet& particles) const override;
+
+		/** Creates a new particle color evolver. */
+		static UPtr<ParticleColor> create(const PARTICLE_COLOR_DESC& desc);
+
+	private:
+		/** Number of samples the color distribution is baked into. */
+		static constexpr UINT32 NUM_SAMPLES = 64;
+
+		PARTICLE_COLOR_DESC mInfo;
+		RGBA mMinSamples[NUM_SAMPLES + 1];
+		RGBA mMaxSamples[NUM_SAMPLES + 1];
+	};
+
+	/** Information describing a ParticleSize evolver. */
+	struct PARTICLE_SIZE_DESC
+	{
+		/** Factor to scale the initial size of the particles with, evaluated over the particle lifetime. */
+		FloatDistribution size = FloatDistribution(1.0f);
+	};
+
+	/** Particle evolver that scales the particles over their lifetime, relative to their initial size. */
+	class BS_CORE_EXPORT ParticleSize : public ParticleEvolver
+	{
+	public:
+		ParticleSize(const PARTICLE_SIZE_DESC& desc);
+
+		/** @copydoc ParticleEvolver::evolve */
+		void evolve(const Random& random, const ParticleSystemState& state, ParticleSet& particles) const override;
+
+		/** Creates a new particle size evolver. */
+		static UPtr<ParticleSize> create(const PARTICLE_SIZE_DESC& desc);
+
+	private:
+		/** Number of samples the size distribution is baked into. */
+		static constexpr UINT32 NUM_SAMPLES = 64;
+
+		PARTICLE_SIZE_DESC mInfo;
+		float mMinSamples[NUM_SAMPLES + 1];
+		float mMaxSamples[NUM_SAMPLES + 1];
 	};
 
 	/** @} */
@@ -546,11 +726,81 @@ namespace bs
 	 *  @{
 	 */
 
-	// TODO - Doc
+	/** Vertex written for each particle by ParticleSystem::writeVertices(). */
+	struct ParticleVertex
+	{
+		Vector3 position;
+		Vector2 size;
+		RGBA color;
+	};
+
+	/** 
+	 * Simulates a set of particles on the CPU. Every frame the emitters spawn new particles, particles past their
+	 * lifetime are removed, and the evolvers update the properties of the remaining ones. Particle data is stored as
+	 * a structure of arrays and updated using SIMD.
+	 *
+	 * Emitters and evolvers are not owned by the system and must remain alive for as long as they're registered with it.
+	 */
 	class BS_CORE_EXPORT ParticleSystem : public INonCopyable
 	{
 	public:
+		ParticleSystem(UINT32 seed = 0);
+		~ParticleSystem();
+
+		/** Registers a new emitter with the system and returns its index. */
 		UINT32 addEmitter(ParticleEmitter* emitter);
+
+		/** Registers a new evolver with the system and returns its index. Evolvers execute in the order they are added. */
+		UINT32 addEvolver(ParticleEvolver* evolver);
+
+		/** Determines the maximum number of particles that can exist at once. Emitters stop spawning at this limit. */
+		void setMaxParticles(UINT32 maxParticles) { mMaxParticles = maxParticles; }
+
+		/** @copydoc setMaxParticles */
+		UINT32 getMaxParticles() const { return mMaxParticles; }
+
+		/** 
+		 * Determines the length of a single cycle of the system, in seconds. Emitter property distributions are 
+		 * evaluated over this range, after which the cycle repeats.
+		 */
+		void setDuration(float duration) { mDuration = duration; }
+
+		/** @copydoc setDuration */
+		float getDuration() const { return mDuration; }
+
+		/** Returns the number of particles that are currently active. */
+		UINT32 getParticleCount() const;
+
+		/** Advances the simulation by @p timeDelta seconds. */
+		void simulate(float timeDelta);
+
+		/** 
+		 * Advances the simulation of multiple systems by @p timeDelta seconds. Systems are simulated in parallel on the
+		 * JobScheduler, if it is running.
+		 */
+		static void simulate(ParticleSystem** systems, UINT32 numSystems, float timeDelta);
+
+		/** 
+		 * Writes a vertex for each active particle into the provided buffer (e.g. a mapped vertex or instance buffer).
+		 *
+		 * @param[out]	output			Buffer to write the vertices to.
+		 * @param[in]	maxVertices		Maximum number of vertices that fit into @p output.
+		 * @return						Number of written vertices.
+		 */
+		UINT32 writeVertices(ParticleVertex* output, UINT32 maxVertices) const;
+
+		/** Creates a vertex description matching the layout of ParticleVertex. */
+		static SPtr<VertexDataDesc> createVertexDesc();
+
+	private:
+		Vector<ParticleEmitter*> mEmitters;
+		Vector<ParticleEvolver*> mEvolvers;
+		ParticleSet* mParticleSet = nullptr;
+		Random mRandom;
+
+		float mTime = 0.0f;
+		float mDuration = 5.0f;
+		UINT32 mMaxParticles = 2000;
 	};
 
 	/** @} */
@@ -8,6 +8,7 @@
 namespace bs
 {
 	Physics::Physics(const PHYSICS_INIT_DESC& init)
+		:mFlags(init.flags)
 	{
 		memset(mCollisionMap, 1, CollisionMapSize * CollisionMapSize * sizeof(bool));
 	}
@@ -50,6 +51,59 @@ namespace bs
 		return rayCastAny(ray.getOrigin(), ray.getDirection(), layer, max);
 	}
 
+	UINT32 Physics::rayCastBatch(const Ray* rays, UINT32 count, PhysicsQueryHit* hits, UINT64 layer, float max) const
+	{
+		UINT32 numHits = 0;
+		for(UINT32 i = 0; i < count; i++)
+		{
+			if(rayCast(rays[i], hits[i], layer, max))
+				numHits++;
+			else
+				hits[i] = PhysicsQueryHit();
+		}
+
+		return numHits;
+	}
+
+	UINT32 Physics::rayCastAnyBatch(const Ray* rays, UINT32 count, bool* results, UINT64 layer, float max) const
+	{
+		UINT32 numHits = 0;
+		for(UINT32 i = 0; i < count; i++)
+		{
+			results[i] = rayCastAny(rays[i], layer, max);
+			numHits += results[i] ? 1 : 0;
+		}
+
+		return numHits;
+	}
+
+	UINT32 Physics::sphereCastBatch(const Sphere* spheres, const Vector3* unitDirs, UINT32 count, PhysicsQueryHit* hits,
+		UINT64 layer, float max) const
+	{
+		UINT32 numHits = 0;
+		for(UINT32 i = 0; i < count; i++)
+		{
+			if(sphereCast(spheres[i], unitDirs[i], hits[i], layer, max))
+				numHits++;
+			else
+				hits[i] = PhysicsQueryHit();
+		}
+
+		return numHits;
+	}
+
+	UINT32 Physics::sphereOverlapAnyBatch(const Sphere* spheres, UINT32 count, bool* results, UINT64 layer) const
+	{
+		UINT32 numHits = 0;
+		for(UINT32 i = 0; i < count; i++)
+		{
+			results[i] = sphereOverlapAny(spheres[i], layer);
+			numHits += results[i] ? 1 : 0;
+		}
+
+		return numHits;
+	}
+
 	Vector<HCollider> rawToComponent(const Vector<Collider*>& raw)
 	{
 		if (raw.empty())
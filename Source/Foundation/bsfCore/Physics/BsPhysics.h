@@ -46,7 +46,14 @@ namespace bs
 		 * Enables continous collision detection. This will prevent fast-moving objects from tunneling through each other.
 		 * You must also enable CCD for individual Rigidbodies. This option can have a significant performance impact.
 		 */
-		CCD_Enable = 1<<3
+		CCD_Enable = 1<<3,
+		/**
+		 * Runs the simulation in parallel with the rest of the frame. Results of a simulation step are retrieved at the
+		 * start of the next fixed update, instead of blocking until the step completes. Rigidbody transforms are
+		 * interpolated between the two most recent steps every frame, meaning they lag one step behind the simulation.
+		 * Objects modified during the frame are only affected by the simulation step following the one in progress.
+		 */
+		Pipelined = 1<<4
 	};
 
 	/** @copydoc CharacterCollisionFlag */
@@ -427,6 +434,74 @@ namespace bs
 		virtual bool convexOverlapAny(const HPhysicsMesh& mesh, const Vector3& position, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const = 0;
 
+		/******************************************************************************************************************/
+		/******************************************** BATCHED QUERIES *****************************************************/
+		/******************************************************************************************************************/
+
+		/**
+		 * Casts multiple rays into the scene and records the closest found hit for each. Results are written into a
+		 * caller provided buffer without allocating any memory, and the backend may process the queries in parallel. 
+		 * Prefer this over rayCast() when performing a large number of queries at once.
+		 * 
+		 * @param[in]	rays	Array of rays to cast into the scene.
+		 * @param[in]	count	Number of entries in the @p rays array.
+		 * @param[out]	hits	Array of @p count entries that will receive the closest hit for each ray. Entries for
+		 *						rays that didn't hit anything will have a null PhysicsQueryHit::colliderRaw.
+		 * @param[in]	layer	Layers to consider for the query. This allows you to ignore certain groups of objects.
+		 * @param[in]	max		Maximum distance at which to perform the query. Hits past this distance will not be
+		 *						detected.
+		 * @return				Number of rays that hit something.
+		 */
+		virtual UINT32 rayCastBatch(const Ray* rays, UINT32 count, PhysicsQueryHit* hits, UINT64 layer = BS_ALL_LAYERS, 
+			float max = FLT_MAX) const;
+
+		/**
+		 * Casts multiple rays into the scene and checks if each of them has hit anything. See rayCastBatch() for details
+		 * on batched queries.
+		 * 
+		 * @param[in]	rays	Array of rays to cast into the scene.
+		 * @param[in]	count	Number of entries in the @p rays array.
+		 * @param[out]	results	Array of @p count entries that will receive true for each ray that hit something, and
+		 *						false otherwise.
+		 * @param[in]	layer	Layers to consider for the query. This allows you to ignore certain groups of objects.
+		 * @param[in]	max		Maximum distance at which to perform the query. Hits past this distance will not be
+		 *						detected.
+		 * @return				Number of rays that hit something.
+		 */
+		virtual UINT32 rayCastAnyBatch(const Ray* rays, UINT32 count, bool* results, UINT64 layer = BS_ALL_LAYERS, 
+			float max = FLT_MAX) const;
+
+		/**
+		 * Performs a sweep into the scene using multiple spheres and records the closest found hit for each. See 
+		 * rayCastBatch() for details on batched queries.
+		 * 
+		 * @param[in]	spheres		Array of spheres to sweep through the scene.
+		 * @param[in]	unitDirs	Array of unit directions towards which to perform the sweeps, one for each sphere.
+		 * @param[in]	count		Number of entries in the @p spheres and @p unitDirs arrays.
+		 * @param[out]	hits		Array of @p count entries that will receive the closest hit for each sphere. Entries
+		 *							for spheres that didn't hit anything will have a null PhysicsQueryHit::colliderRaw.
+		 * @param[in]	layer		Layers to consider for the query. This allows you to ignore certain groups of objects.
+		 * @param[in]	max			Maximum distance at which to perform the query. Hits past this distance will not be
+		 *							detected.
+		 * @return					Number of spheres that hit something.
+		 */
+		virtual UINT32 sphereCastBatch(const Sphere* spheres, const Vector3* unitDirs, UINT32 count, PhysicsQueryHit* hits,
+			UINT64 layer = BS_ALL_LAYERS, float max = FLT_MAX) const;
+
+		/**
+		 * Checks if each of the provided spheres overlaps any other collider in the scene. See rayCastBatch() for details
+		 * on batched queries.
+		 * 
+		 * @param[in]	spheres		Array of spheres to check for overlap.
+		 * @param[in]	count		Number of entries in the @p spheres array.
+		 * @param[out]	results		Array of @p count entries that will receive true for each sphere that overlaps
+		 *							another object, and false otherwise.
+		 * @param[in]	layer		Layers to consider for the query. This allows you to ignore certain groups of objects.
+		 * @return					Number of spheres that overlap another object.
+		 */
+		virtual UINT32 sphereOverlapAnyBatch(const Sphere* spheres, UINT32 count, bool* results, 
+			UINT64 layer = BS_ALL_LAYERS) const;
+
 		/******************************************************************************************************************/
 		/************************************************* OPTIONS ********************************************************/
 		/******************************************************************************************************************/
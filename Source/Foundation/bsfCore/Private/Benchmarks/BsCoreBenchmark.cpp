@@ -0,0 +1,904 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsCorePrerequisites.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsCompressedAnimationCurves.h"
+#include "Animation/BsCurveCache.h"
+#include "Particles/BsParticleSystem.h"
+#include "CoreThread/BsCommandQueue.h"
+#include "Material/BsMaterialParams.h"
+#include "Material/BsShader.h"
+#include "Resources/BsResourceManifest.h"
+#include "Resources/BsResourcePack.h"
+#include "Resources/BsSavedResourceData.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Math/BsRandom.h"
+#include "Threading/BsJobScheduler.h"
+#include "Threading/BsThreadPool.h"
+#include "Utility/BsTimer.h"
+
+#include <iostream>
+#include <iomanip>
+
+using namespace bs;
+
+/** Number of heap allocations made through the global operator new. */
+static std::atomic<UINT64> gNumHeapAllocs{0};
+
+void* operator new(size_t size)
+{
+	gNumHeapAllocs.fetch_add(1, std::memory_order_relaxed);
+
+	void* data = malloc(size);
+	if(data == nullptr)
+		throw std::bad_alloc();
+
+	return data;
+}
+
+void operator delete(void* data) noexcept
+{
+	free(data);
+}
+
+namespace
+{
+	/** Number of bones animated by the benchmark clip. */
+	constexpr UINT32 NUM_BONES = 96;
+
+	/** Length of the benchmark clip, in seconds. */
+	constexpr float CLIP_LENGTH = 4.0f;
+
+	/** Rate at which the benchmark clip is baked, in frames per second (same as an imported clip). */
+	constexpr UINT32 SAMPLE_RATE = 30;
+
+	/** Number of times the full clip is sampled per measurement. */
+	constexpr UINT32 NUM_SAMPLES = 2000;
+
+	/** Number of times each measurement is repeated. The fastest run is reported. */
+	constexpr UINT32 NUM_RUNS = 5;
+
+	/** Number of frames simulated per particle measurement. */
+	constexpr UINT32 NUM_PARTICLE_FRAMES = 100;
+
+	/** Time step of a single simulated frame, in seconds. */
+	constexpr float PARTICLE_FRAME_STEP = 1.0f / 60.0f;
+
+	/** Lifetime of the benchmark particles, in seconds. */
+	constexpr float PARTICLE_LIFETIME = 2.0f;
+
+	/** Number of commands queued per frame by the command queue benchmark. */
+	constexpr UINT32 NUM_COMMANDS_PER_FRAME = 10000;
+
+	/** Number of frames queued and executed per command queue measurement. */
+	constexpr UINT32 NUM_COMMAND_FRAMES = 100;
+
+	/** Number of data parameters in the material used by the material parameter benchmark. */
+	constexpr UINT32 NUM_MATERIAL_PARAMS = 64;
+
+	/** Number of parameters written for every object. */
+	constexpr UINT32 NUM_PARAMS_PER_OBJECT = 4;
+
+	/** Number of GPU parameters each material parameter maps to, in the dirty parameter benchmark. */
+	constexpr UINT32 NUM_MAPPINGS_PER_PARAM = 4;
+
+	/** Number of objects whose material parameters are written per frame. */
+	constexpr UINT32 NUM_MATERIAL_OBJECTS = 5000;
+
+	/** Number of frames per material parameter measurement. */
+	constexpr UINT32 NUM_MATERIAL_FRAMES = 50;
+
+	/** Number of resources read by the resource startup benchmark. */
+	constexpr UINT32 NUM_STARTUP_RESOURCES = 2000;
+
+	/** Size of the data of a single resource read by the resource startup benchmark, in bytes. */
+	constexpr UINT32 STARTUP_RESOURCE_SIZE = 16 * 1024;
+
+	/** Generates keyframes from a function, with tangents set up as with a baked curve. */
+	template<class T, class F>
+	TAnimationCurve<T> bakeCurve(F func)
+	{
+		const UINT32 numKeys = (UINT32)(CLIP_LENGTH * SAMPLE_RATE) + 1;
+
+		Vector<TKeyframe<T>> keyframes(numKeys);
+		for(UINT32 i = 0; i < numKeys; i++)
+		{
+			keyframes[i].time = i / (float)SAMPLE_RATE;
+			keyframes[i].value = func(keyframes[i].time);
+		}
+
+		for(UINT32 i = 0; i < numKeys; i++)
+		{
+			const UINT32 prev = i > 0 ? i - 1 : i;
+			const UINT32 next = i < (numKeys - 1) ? i + 1 : i;
+
+			const T tangent = (keyframes[next].value - keyframes[prev].value) *
+				(1.0f / (keyframes[next].time - keyframes[prev].time));
+
+			keyframes[i].inTangent = tangent;
+			keyframes[i].outTangent = tangent;
+		}
+
+		return TAnimationCurve<T>(keyframes);
+	}
+
+	/**
+	 * Generates curves similar to a baked character animation. Every bone rotates, only a few bones move and scale
+	 * remains constant (but still has a curve, as most importers output one).
+	 */
+	SPtr<AnimationCurves> generateCurves()
+	{
+		Random random(NUM_BONES);
+
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			const String name = "Bone" + toString(i);
+
+			const float frequency = 0.5f + random.getUNorm() * 2.0f;
+			const float phase = random.getUNorm() * Math::TWO_PI;
+			const Vector3 offset(random.getSNorm(), random.getSNorm(), random.getSNorm());
+			const Vector3 axis = Vector3::normalize(Vector3(random.getSNorm(), random.getSNorm(), 1.0f));
+			const bool moves = i % 8 == 0;
+
+			curves->addPositionCurve(name, bakeCurve<Vector3>([=](float t)
+			{
+				if(!moves)
+					return offset;
+
+				return offset + Vector3(std::sin(t * frequency + phase), 0.2f * std::sin(t * frequency * 2.0f), 0.0f);
+			}));
+
+			curves->addRotationCurve(name, bakeCurve<Quaternion>([=](float t)
+			{
+				const Radian angle(Math::PI * 0.25f * std::sin(t * frequency + phase));
+				return Quaternion(axis, angle);
+			}));
+
+			curves->addScaleCurve(name, bakeCurve<Vector3>([](float t) { return Vector3::ONE; }));
+		}
+
+		return curves;
+	}
+
+	/** Evaluates all the curves using the keyframe curves and their caches. */
+	double runUncompressed(const AnimationCurves& curves, Vector<Vector3>& positions, Vector<Quaternion>& rotations,
+		Vector<Vector3>& scales)
+	{
+		Vector<TCurveCache<Vector3>> positionCaches(curves.position.size());
+		Vector<TCurveCache<Quaternion>> rotationCaches(curves.rotation.size());
+		Vector<TCurveCache<Vector3>> scaleCaches(curves.scale.size());
+
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_SAMPLES; i++)
+		{
+			const float time = i * (CLIP_LENGTH / NUM_SAMPLES);
+
+			for(UINT32 j = 0; j < (UINT32)curves.position.size(); j++)
+				positions[j] = curves.position[j].curve.evaluate(time, positionCaches[j], true);
+
+			for(UINT32 j = 0; j < (UINT32)curves.rotation.size(); j++)
+				rotations[j] = curves.rotation[j].curve.evaluate(time, rotationCaches[j], true);
+
+			for(UINT32 j = 0; j < (UINT32)curves.scale.size(); j++)
+				scales[j] = curves.scale[j].curve.evaluate(time, scaleCaches[j], true);
+		}
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Evaluates all the curves using the compressed curves, decompressing all tracks of a type at once. */
+	double runCompressed(const CompressedAnimationCurves& curves, Vector<Vector3>& positions,
+		Vector<Quaternion>& rotations, Vector<Vector3>& scales)
+	{
+		Vector<UINT32> tracks(NUM_BONES);
+		Vector<float> components(NUM_BONES * 10);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+			tracks[i] = i;
+
+		float* positionOutput[] = { &components[0], &components[NUM_BONES], &components[NUM_BONES * 2] };
+		float* rotationOutput[] = { &components[NUM_BONES * 3], &components[NUM_BONES * 4], &components[NUM_BONES * 5],
+			&components[NUM_BONES * 6] };
+		float* scaleOutput[] = { &components[NUM_BONES * 7], &components[NUM_BONES * 8], &components[NUM_BONES * 9] };
+
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_SAMPLES; i++)
+		{
+			const float time = i * (CLIP_LENGTH / NUM_SAMPLES);
+
+			curves.evaluate(CurveType::Position, time, true, tracks.data(), tracks.data(), NUM_BONES, positionOutput);
+			curves.evaluate(CurveType::Rotation, time, true, tracks.data(), tracks.data(), NUM_BONES, rotationOutput);
+			curves.evaluate(CurveType::Scale, time, true, tracks.data(), tracks.data(), NUM_BONES, scaleOutput);
+		}
+
+		const double elapsed = (double)timer.getMicroseconds();
+
+		// Output the last sample so it can be compared against the uncompressed curves
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			positions[i] = Vector3(positionOutput[0][i], positionOutput[1][i], positionOutput[2][i]);
+			rotations[i] = Quaternion(rotationOutput[3][i], rotationOutput[0][i], rotationOutput[1][i],
+				rotationOutput[2][i]);
+			scales[i] = Vector3(scaleOutput[0][i], scaleOutput[1][i], scaleOutput[2][i]);
+		}
+
+		return elapsed;
+	}
+
+	/** Finds the largest difference between the compressed and uncompressed curves, over the entire clip. */
+	void findMaxError(const AnimationCurves& curves, const CompressedAnimationCurves& compressed, float& positionError,
+		float& rotationError)
+	{
+		positionError = 0.0f;
+		rotationError = 0.0f;
+
+		for(UINT32 i = 0; i < 1000; i++)
+		{
+			const float time = i * (CLIP_LENGTH / 999);
+
+			for(UINT32 j = 0; j < NUM_BONES; j++)
+			{
+				const Vector3 position = curves.position[j].curve.evaluate(time, false);
+				const Vector3 compressedPosition = compressed.evaluateVector(CurveType::Position, j, time, false);
+				positionError = std::max(positionError, (position - compressedPosition).length());
+
+				Quaternion rotation = curves.rotation[j].curve.evaluate(time, false);
+				rotation.normalize();
+
+				const Quaternion compressedRotation = compressed.evaluateRotation(j, time, false);
+				const float cosAngle = std::min(std::abs(rotation.dot(compressedRotation)), 1.0f);
+				rotationError = std::max(rotationError, Radian(2.0f * std::acos(cosAngle)).valueDegrees());
+			}
+		}
+	}
+}
+
+namespace
+{
+	/** Creates an evolver that fades the particles from white to transparent orange over their lifetime. */
+	UPtr<ParticleColor> createColorEvolver()
+	{
+		ColorGradient gradient;
+		gradient.setKeys({ { Color::White, 0.0f }, { Color(1.0f, 0.5f, 0.0f, 0.0f), 1.0f } });
+
+		PARTICLE_COLOR_DESC desc;
+		desc.color = ColorDistribution(gradient);
+
+		return ParticleColor::create(desc);
+	}
+
+	/** Creates an evolver that grows the particles to three times their initial size over their lifetime. */
+	UPtr<ParticleSize> createSizeEvolver()
+	{
+		TAnimationCurve<float> curve({ { 1.0f, 0.0f, 0.0f, 0.0f }, { 3.0f, 0.0f, 0.0f, 1.0f } });
+
+		PARTICLE_SIZE_DESC desc;
+		desc.size = FloatDistribution(curve);
+
+		return ParticleSize::create(desc);
+	}
+
+	/** Emitter, evolvers and the particle system they drive, set up to maintain a specific number of particles. */
+	struct BenchmarkParticleSystem
+	{
+		BenchmarkParticleSystem(UINT32 numParticles, UINT32 seed)
+			: shape(ParticleEmitterSphereShape::create({ 1.0f, 1.0f }))
+			, force(ParticleForce::create({ Vector3(0.0f, -9.81f, 0.0f) }))
+			, velocity(ParticleVelocity::create({ Vector3(1.0f, 0.0f, 0.5f) }))
+			, color(createColorEvolver())
+			, size(createSizeEvolver())
+			, system(seed)
+		{
+			emitter.setShape(shape.get());
+			emitter.setEmissionRate(numParticles / PARTICLE_LIFETIME);
+			emitter.setInitialLifetime(FloatDistribution(PARTICLE_LIFETIME * 0.9f, PARTICLE_LIFETIME));
+			emitter.setInitialSpeed(FloatDistribution(1.0f, 3.0f));
+			emitter.setInitialSize(FloatDistribution(0.1f, 0.2f));
+
+			system.setMaxParticles(numParticles);
+			system.addEmitter(&emitter);
+			system.addEvolver(force.get());
+			system.addEvolver(velocity.get());
+			system.addEvolver(color.get());
+			system.addEvolver(size.get());
+		}
+
+		UPtr<ParticleEmitterSphereShape> shape;
+		ParticleEmitter emitter;
+		UPtr<ParticleForce> force;
+		UPtr<ParticleVelocity> velocity;
+		UPtr<ParticleColor> color;
+		UPtr<ParticleSize> size;
+		ParticleSystem system;
+	};
+
+	/** Object receiving the benchmark commands, standing in for a core thread object being synced. */
+	struct CommandTarget
+	{
+		void setTransform(const Vector3& position, const Quaternion& rotation, UINT32 flags)
+		{
+			this->position = position;
+			this->rotation = rotation;
+			this->flags |= flags;
+		}
+
+		void getFlags(AsyncOp& op)
+		{
+			op._completeOperation(flags);
+		}
+
+		Vector3 position = Vector3::ZERO;
+		Quaternion rotation = Quaternion::IDENTITY;
+		UINT32 flags = 0;
+	};
+
+	/** Command stored as two std::function objects and an AsyncOp, as command queues used to. */
+	struct LegacyCommand
+	{
+		std::function<void()> callback;
+		std::function<void(AsyncOp&)> callbackWithReturnValue;
+		AsyncOp asyncOp;
+		bool returnsValue;
+		UINT32 callbackId;
+		bool notifyWhenComplete;
+	};
+
+	/** Results of a single command queue measurement. */
+	struct CommandResults
+	{
+		double commandsPerSecond;
+		double allocationsPerFrame;
+	};
+
+	/** Returns the total number of allocations made so far, through either the engine allocators or operator new. */
+	UINT64 getNumAllocations()
+	{
+		return MemoryCounter::getNumAllocs() + gNumHeapAllocs.load(std::memory_order_relaxed);
+	}
+
+	/** 
+	 * Queues and executes commands using a queue of std::function based commands copied into the queue, as the command
+	 * queue used to. Every hundredth command returns a value.
+	 */
+	CommandResults runLegacyCommands(CommandTarget& target)
+	{
+		Queue<LegacyCommand> commands;
+		const SPtr<AsyncOpSyncData> syncData = bs_shared_ptr_new<AsyncOpSyncData>();
+
+		const UINT64 numAllocations = getNumAllocations();
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_COMMAND_FRAMES; i++)
+		{
+			for(UINT32 j = 0; j < NUM_COMMANDS_PER_FRAME; j++)
+			{
+				LegacyCommand command;
+				command.callbackId = 0;
+				command.notifyWhenComplete = false;
+
+				if(j % 100 == 0)
+				{
+					command.callbackWithReturnValue = std::bind(&CommandTarget::getFlags, &target, std::placeholders::_1);
+					command.asyncOp = AsyncOp(syncData);
+					command.returnsValue = true;
+				}
+				else
+				{
+					command.callback = std::bind(&CommandTarget::setTransform, &target, Vector3((float)j, 0.0f, 0.0f),
+						Quaternion::IDENTITY, j);
+					command.returnsValue = false;
+				}
+
+				commands.push(command);
+			}
+
+			while(!commands.empty())
+			{
+				LegacyCommand& command = commands.front();
+				if(command.returnsValue)
+					command.callbackWithReturnValue(command.asyncOp);
+				else
+					command.callback();
+
+				commands.pop();
+			}
+		}
+
+		const double elapsed = (double)timer.getMicroseconds();
+		const double numCommands = (double)NUM_COMMANDS_PER_FRAME * NUM_COMMAND_FRAMES;
+
+		return { numCommands / (elapsed / 1000000.0), 
+			(getNumAllocations() - numAllocations) / (double)NUM_COMMAND_FRAMES };
+	}
+
+	/** Queues and executes the same commands as runLegacyCommands(), using a command buffer. */
+	CommandResults runBufferedCommands(CommandTarget& target)
+	{
+		CommandBuffer commands;
+		const SPtr<AsyncOpSyncData> syncData = bs_shared_ptr_new<AsyncOpSyncData>();
+
+		const UINT64 numAllocations = getNumAllocations();
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_COMMAND_FRAMES; i++)
+		{
+			for(UINT32 j = 0; j < NUM_COMMANDS_PER_FRAME; j++)
+			{
+				if(j % 100 == 0)
+					commands.addReturn(std::bind(&CommandTarget::getFlags, &target, std::placeholders::_1), syncData);
+				else
+				{
+					commands.add(std::bind(&CommandTarget::setTransform, &target, Vector3((float)j, 0.0f, 0.0f),
+						Quaternion::IDENTITY, j));
+				}
+			}
+
+			commands.execute();
+		}
+
+		const double elapsed = (double)timer.getMicroseconds();
+		const double numCommands = (double)NUM_COMMANDS_PER_FRAME * NUM_COMMAND_FRAMES;
+
+		return { numCommands / (elapsed / 1000000.0), 
+			(getNumAllocations() - numAllocations) / (double)NUM_COMMAND_FRAMES };
+	}
+
+	/** Creates material parameters with NUM_MATERIAL_PARAMS four component vector parameters. */
+	UPtr<MaterialParamsBase> createMaterialParams()
+	{
+		Map<String, SHADER_DATA_PARAM_DESC> dataParams;
+		for(UINT32 i = 0; i < NUM_MATERIAL_PARAMS; i++)
+		{
+			SHADER_DATA_PARAM_DESC desc;
+			desc.name = "gParam" + toString(i);
+			desc.gpuVariableName = desc.name;
+			desc.type = GPDT_FLOAT4;
+			desc.arraySize = 1;
+			desc.elementSize = 0;
+			desc.defaultValueIdx = (UINT32)-1;
+
+			dataParams[desc.name] = desc;
+		}
+
+		return bs_unique_ptr_new<MaterialParamsBase>(dataParams, Map<String, SHADER_OBJECT_PARAM_DESC>(),
+			Map<String, SHADER_OBJECT_PARAM_DESC>(), Map<String, SHADER_OBJECT_PARAM_DESC>());
+	}
+
+	/** Returns the name of the parameter written by an object, at the specified index. */
+	UINT32 getObjectParam(UINT32 object, UINT32 idx)
+	{
+		return (object * 7 + idx * 13) % NUM_MATERIAL_PARAMS;
+	}
+
+	/** Results of a single material parameter measurement, in parameter writes per second. */
+	struct MaterialParamResults
+	{
+		double stringNames;
+		double stringIds;
+		double handles;
+	};
+
+	/** 
+	 * Writes material parameters for every object, looking the parameters up by name on every write, by pre-interned
+	 * name on every write, and through parameter handles resolved once.
+	 */
+	MaterialParamResults runMaterialParams(MaterialParamsBase& params)
+	{
+		Vector<String> names(NUM_MATERIAL_PARAMS);
+		Vector<StringID> ids(NUM_MATERIAL_PARAMS);
+		Vector<const MaterialParamsBase::ParamData*> handles(NUM_MATERIAL_PARAMS);
+		for(UINT32 i = 0; i < NUM_MATERIAL_PARAMS; i++)
+		{
+			names[i] = "gParam" + toString(i);
+			ids[i] = names[i];
+			handles[i] = params.getParamData(params.getParamIndex(ids[i]));
+		}
+
+		const double numWrites = (double)NUM_MATERIAL_FRAMES * NUM_MATERIAL_OBJECTS * NUM_PARAMS_PER_OBJECT;
+
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_MATERIAL_FRAMES; i++)
+		{
+			for(UINT32 j = 0; j < NUM_MATERIAL_OBJECTS; j++)
+			{
+				for(UINT32 k = 0; k < NUM_PARAMS_PER_OBJECT; k++)
+					params.setDataParam(names[getObjectParam(j, k)], 0, Vector4((float)j, 0.0f, 0.0f, 1.0f));
+			}
+		}
+		const double stringTime = (double)timer.getMicroseconds();
+
+		timer.reset();
+		for(UINT32 i = 0; i < NUM_MATERIAL_FRAMES; i++)
+		{
+			for(UINT32 j = 0; j < NUM_MATERIAL_OBJECTS; j++)
+			{
+				for(UINT32 k = 0; k < NUM_PARAMS_PER_OBJECT; k++)
+					params.setDataParam(ids[getObjectParam(j, k)], 0, Vector4((float)j, 0.0f, 0.0f, 1.0f));
+			}
+		}
+		const double idTime = (double)timer.getMicroseconds();
+
+		timer.reset();
+		for(UINT32 i = 0; i < NUM_MATERIAL_FRAMES; i++)
+		{
+			for(UINT32 j = 0; j < NUM_MATERIAL_OBJECTS; j++)
+			{
+				for(UINT32 k = 0; k < NUM_PARAMS_PER_OBJECT; k++)
+					params.setDataParam(*handles[getObjectParam(j, k)], 0, Vector4((float)j, 0.0f, 0.0f, 1.0f));
+			}
+		}
+		const double handleTime = (double)timer.getMicroseconds();
+
+		return { numWrites / (stringTime / 1000000.0), numWrites / (idTime / 1000000.0), 
+			numWrites / (handleTime / 1000000.0) };
+	}
+
+	/** 
+	 * Finds GPU parameter mappings of the material parameters modified since the last check, with a few parameters
+	 * modified between the checks, as GpuParamsSet::update() does. Mappings are found either by comparing the parameter
+	 * version of each mapping, or by using the dirty masks. Returns the time per check for both, including the parameter
+	 * writes, in microseconds.
+	 */
+	std::pair<double, double> runMaterialDirtyScan(MaterialParamsBase& params)
+	{
+		// Every parameter used by NUM_MAPPINGS_PER_PARAM GPU programs, sorted by parameter index
+		const UINT32 numMappings = NUM_MATERIAL_PARAMS * NUM_MAPPINGS_PER_PARAM;
+
+		Vector<UINT32> mappings(numMappings);
+		for(UINT32 i = 0; i < numMappings; i++)
+			mappings[i] = i / NUM_MAPPINGS_PER_PARAM;
+
+		Vector<UINT64> dirtyParams;
+		UINT32 numFound[2] = { 0, 0 };
+		double elapsed[2];
+
+		for(UINT32 method = 0; method < 2; method++)
+		{
+			UINT64 version = params.getParamVersion();
+
+			Timer timer;
+			for(UINT32 i = 0; i < NUM_MATERIAL_OBJECTS; i++)
+			{
+				for(UINT32 j = 0; j < NUM_PARAMS_PER_OBJECT; j++)
+				{
+					const UINT32 paramIdx = getObjectParam(i, j);
+					params.setDataParam(*params.getParamData(paramIdx), 0, Vector4::ZERO);
+				}
+
+				if(method == 0)
+				{
+					for(UINT32 j = 0; j < numMappings; j++)
+					{
+						if(params.getParamData(mappings[j])->version > version)
+							numFound[method]++;
+					}
+				}
+				else
+				{
+					params.getDirtyParams(version, dirtyParams);
+					for(UINT32 j = 0; j < NUM_MATERIAL_PARAMS; j++)
+					{
+						const UINT64 bit = 1ULL << (j % MaterialParamsBase::PARAMS_PER_MASK_ENTRY);
+						if((dirtyParams[j / MaterialParamsBase::PARAMS_PER_MASK_ENTRY] & bit) == 0)
+							continue;
+
+						for(UINT32 k = j * NUM_MAPPINGS_PER_PARAM; k < (j + 1) * NUM_MAPPINGS_PER_PARAM; k++)
+							numFound[method] += mappings[k] == j ? 1 : 0;
+					}
+				}
+
+				version = params.getParamVersion();
+			}
+
+			elapsed[method] = (double)timer.getMicroseconds() / NUM_MATERIAL_OBJECTS;
+		}
+
+		if(numFound[0] != numFound[1])
+			std::cout << "Warning: version scan and dirty masks found a different number of parameters." << std::endl;
+
+		return { elapsed[0], elapsed[1] };
+	}
+
+	/** 
+	 * Simulates the systems and writes out their vertices for a number of frames. Returns the number of particles
+	 * processed per millisecond.
+	 */
+	double runParticles(ParticleSystem** systems, UINT32 numSystems, Vector<ParticleVertex>& vertices)
+	{
+		UINT64 numProcessed = 0;
+
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_PARTICLE_FRAMES; i++)
+		{
+			ParticleSystem::simulate(systems, numSystems, PARTICLE_FRAME_STEP);
+
+			UINT32 offset = 0;
+			for(UINT32 j = 0; j < numSystems; j++)
+				offset += systems[j]->writeVertices(&vertices[offset], (UINT32)vertices.size() - offset);
+
+			numProcessed += offset;
+		}
+
+		const double elapsed = (double)timer.getMicroseconds();
+		return numProcessed / (elapsed / 1000.0);
+	}
+
+	/** Writes a file laid out as a saved resource, with random bytes in place of the serialized resource. */
+	void writeResourceFile(const Path& path, const Random& random)
+	{
+		SavedResourceData savedResourceData({}, true, 0);
+
+		MemorySerializer ms;
+		UINT32 metaDataSize = 0;
+		UINT8* metaData = ms.encode(&savedResourceData, metaDataSize);
+
+		Vector<UINT8> data(STARTUP_RESOURCE_SIZE);
+		for(auto& entry : data)
+			entry = (UINT8)random.get();
+
+		const UINT32 dataSize = STARTUP_RESOURCE_SIZE;
+
+		std::ofstream stream(path.toPlatformString().c_str(), std::ios::out | std::ios::binary);
+		stream.write((const char*)&metaDataSize, sizeof(metaDataSize));
+		stream.write((const char*)metaData, metaDataSize);
+		stream.write((const char*)&dataSize, sizeof(dataSize));
+		stream.write((const char*)data.data(), dataSize);
+
+		bs_free(metaData);
+	}
+
+	/** 
+	 * Reads the meta-data of a resource and touches every page of its data, same as a resource load does before 
+	 * deserializing the resource. Returns a checksum of the touched data.
+	 */
+	UINT64 readResource(const SPtr<DataStream>& stream)
+	{
+		UINT32 metaDataSize = 0;
+		stream->read(&metaDataSize, sizeof(metaDataSize));
+
+		BinarySerializer bs;
+		SPtr<IReflectable> metaData = bs.decode(stream, metaDataSize);
+
+		UINT32 dataSize = 0;
+		stream->read(&dataSize, sizeof(dataSize));
+
+		UINT64 checksum = metaData != nullptr ? 1 : 0;
+		const UINT8* data = static_cast<MemoryDataStream*>(stream.get())->getCurrentPtr();
+		for(UINT32 i = 0; i < dataSize; i += 4096)
+			checksum += data[i];
+
+		return checksum;
+	}
+
+	/** Reads all the resources from their individual files, looking up their paths in the manifest. Returns time in ms. */
+	double runLooseFiles(const SPtr<ResourceManifest>& manifest, const Vector<UUID>& uuids)
+	{
+		UINT64 checksum = 0;
+
+		Timer timer;
+		for(auto& uuid : uuids)
+		{
+			Path path;
+			manifest->uuidToFilePath(uuid, path);
+
+			SPtr<MappedFileDataStream> stream = bs_shared_ptr_new<MappedFileDataStream>(path);
+			checksum += readResource(stream);
+		}
+
+		const double elapsed = timer.getMicroseconds() / 1000.0;
+
+		volatile UINT64 sink = checksum;
+		(void)sink;
+
+		return elapsed;
+	}
+
+	/** Opens the pack and reads all the resources from it. Returns time in ms. */
+	double runPack(const Path& packPath, const Vector<UUID>& uuids)
+	{
+		UINT64 checksum = 0;
+
+		Timer timer;
+		SPtr<ResourcePack> pack = ResourcePack::open(packPath);
+		for(auto& uuid : uuids)
+			checksum += readResource(pack->openEntry(uuid));
+
+		const double elapsed = timer.getMicroseconds() / 1000.0;
+
+		volatile UINT64 sink = checksum;
+		(void)sink;
+
+		return elapsed;
+	}
+}
+
+int main()
+{
+	// Animation clip compression
+	SPtr<AnimationCurves> curves = generateCurves();
+	SPtr<CompressedAnimationCurves> compressed =
+		CompressedAnimationCurves::create(*curves, CLIP_LENGTH, SAMPLE_RATE, ANIMATION_COMPRESSION_DESC());
+
+	const UINT32 rawSize = CompressedAnimationCurves::getMemoryUsage(*curves);
+	const UINT32 compressedSize = compressed->getMemoryUsage();
+
+	float positionError, rotationError;
+	findMaxError(*curves, *compressed, positionError, rotationError);
+
+	Vector<Vector3> positions(NUM_BONES);
+	Vector<Quaternion> rotations(NUM_BONES);
+	Vector<Vector3> scales(NUM_BONES);
+
+	double uncompressedTime = std::numeric_limits<double>::max();
+	double compressedTime = std::numeric_limits<double>::max();
+	for(UINT32 i = 0; i < NUM_RUNS; i++)
+	{
+		uncompressedTime = std::min(uncompressedTime, runUncompressed(*curves, positions, rotations, scales));
+		compressedTime = std::min(compressedTime, runCompressed(*compressed, positions, rotations, scales));
+	}
+
+	const double numTracks = NUM_BONES * 3.0 * NUM_SAMPLES;
+
+	std::cout << "Animation clip: " << NUM_BONES << " bones, " << CLIP_LENGTH << "s at " << SAMPLE_RATE << " fps"
+		<< std::endl;
+	std::cout << std::left << std::setw(16) << "Format" << std::setw(16) << "Bytes" << "Tracks/sec" << std::endl;
+	std::cout << std::left << std::setw(16) << "Keyframes" << std::setw(16) << rawSize << std::fixed
+		<< std::setprecision(0) << numTracks / (uncompressedTime / 1000000.0) << std::endl;
+	std::cout << std::left << std::setw(16) << "Compressed" << std::setw(16) << compressedSize << std::fixed
+		<< std::setprecision(0) << numTracks / (compressedTime / 1000000.0) << std::endl;
+	std::cout << "Max error: " << std::setprecision(5) << positionError << " units, " << rotationError << " degrees"
+		<< std::endl;
+
+	// Particle simulation, including writing out the vertices as they would be written into a vertex buffer
+	const UINT32 maxWorkers = std::max((UINT32)BS_THREAD_HARDWARE_CONCURRENCY, 1U);
+	ThreadPool::startUp<TThreadPool<>>(maxWorkers, maxWorkers + 16);
+
+	std::cout << std::endl << std::left << std::setw(16) << "Systems" << std::setw(16) << "Particles" 
+		<< std::setw(20) << "Serial (p/ms)" << "Parallel (p/ms)" << std::endl;
+
+	const UINT32 numParticles = 256000;
+	for(UINT32 numSystems = 1; numSystems <= 256; numSystems *= 4)
+	{
+		Vector<UPtr<BenchmarkParticleSystem>> benchmarkSystems;
+		Vector<ParticleSystem*> systems;
+		for(UINT32 i = 0; i < numSystems; i++)
+		{
+			benchmarkSystems.push_back(bs_unique_ptr_new<BenchmarkParticleSystem>(numParticles / numSystems, i));
+			systems.push_back(&benchmarkSystems.back()->system);
+		}
+
+		Vector<ParticleVertex> vertices(numParticles);
+
+		// Run until the particle count stabilizes
+		for(UINT32 i = 0; i < (UINT32)(PARTICLE_LIFETIME / PARTICLE_FRAME_STEP) * 2; i++)
+			ParticleSystem::simulate(systems.data(), numSystems, PARTICLE_FRAME_STEP);
+
+		double serialRate = 0.0;
+		for(UINT32 i = 0; i < NUM_RUNS; i++)
+			serialRate = std::max(serialRate, runParticles(systems.data(), numSystems, vertices));
+
+		JobScheduler::startUp(maxWorkers);
+
+		double parallelRate = 0.0;
+		for(UINT32 i = 0; i < NUM_RUNS; i++)
+			parallelRate = std::max(parallelRate, runParticles(systems.data(), numSystems, vertices));
+
+		JobScheduler::shutDown();
+
+		UINT32 totalParticles = 0;
+		for(auto& system : systems)
+			totalParticles += system->getParticleCount();
+
+		std::cout << std::left << std::setw(16) << numSystems << std::setw(16) << totalParticles << std::fixed 
+			<< std::setprecision(0) << std::setw(20) << serialRate << parallelRate << std::endl;
+	}
+
+	ThreadPool::shutDown();
+
+	// Commands queued for the core thread, with every hundredth command returning a value
+	CommandTarget target;
+
+	CommandResults legacyResults = { 0.0, 0.0 };
+	CommandResults bufferedResults = { 0.0, 0.0 };
+	for(UINT32 i = 0; i < NUM_RUNS; i++)
+	{
+		CommandResults results = runLegacyCommands(target);
+		if(results.commandsPerSecond > legacyResults.commandsPerSecond)
+			legacyResults = results;
+
+		results = runBufferedCommands(target);
+		if(results.commandsPerSecond > bufferedResults.commandsPerSecond)
+			bufferedResults = results;
+	}
+
+	std::cout << std::endl << NUM_COMMANDS_PER_FRAME << " commands per frame" << std::endl;
+	std::cout << std::left << std::setw(16) << "Queue" << std::setw(16) << "Commands/sec" << "Allocations/frame" 
+		<< std::endl;
+	std::cout << std::left << std::setw(16) << "std::function" << std::fixed << std::setprecision(0) << std::setw(16)
+		<< legacyResults.commandsPerSecond << std::setprecision(1) << legacyResults.allocationsPerFrame << std::endl;
+	std::cout << std::left << std::setw(16) << "Command buffer" << std::fixed << std::setprecision(0) << std::setw(16)
+		<< bufferedResults.commandsPerSecond << std::setprecision(1) << bufferedResults.allocationsPerFrame << std::endl;
+
+	// Material parameter writes, with NUM_PARAMS_PER_OBJECT parameters written for every object
+	UPtr<MaterialParamsBase> materialParams = createMaterialParams();
+
+	MaterialParamResults paramResults = { 0.0, 0.0, 0.0 };
+	std::pair<double, double> scanResults = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+	for(UINT32 i = 0; i < NUM_RUNS; i++)
+	{
+		const MaterialParamResults results = runMaterialParams(*materialParams);
+		paramResults.stringNames = std::max(paramResults.stringNames, results.stringNames);
+		paramResults.stringIds = std::max(paramResults.stringIds, results.stringIds);
+		paramResults.handles = std::max(paramResults.handles, results.handles);
+
+		const std::pair<double, double> scan = runMaterialDirtyScan(*materialParams);
+		scanResults.first = std::min(scanResults.first, scan.first);
+		scanResults.second = std::min(scanResults.second, scan.second);
+	}
+
+	std::cout << std::endl << NUM_MATERIAL_PARAMS << " material parameters, " << NUM_PARAMS_PER_OBJECT 
+		<< " written per object" << std::endl;
+	std::cout << std::left << std::setw(16) << "Lookup" << "Sets/sec" << std::endl;
+	std::cout << std::left << std::setw(16) << "String" << std::fixed << std::setprecision(0) 
+		<< paramResults.stringNames << std::endl;
+	std::cout << std::left << std::setw(16) << "StringID" << std::fixed << std::setprecision(0) 
+		<< paramResults.stringIds << std::endl;
+	std::cout << std::left << std::setw(16) << "Handle" << std::fixed << std::setprecision(0) 
+		<< paramResults.handles << std::endl;
+	std::cout << std::left << std::setw(16) << "Dirty search" << "us/update" << std::endl;
+	std::cout << std::left << std::setw(16) << "Version scan" << std::fixed << std::setprecision(3) 
+		<< scanResults.first << std::endl;
+	std::cout << std::left << std::setw(16) << "Dirty masks" << std::fixed << std::setprecision(3) 
+		<< scanResults.second << std::endl;
+
+	// Resource startup, reading every resource either from its own file or from a single pack. Files are read right
+	// after being written so this measures the per-file overhead with a warm file cache, rather than disk throughput.
+	MemStack::beginThread(); // Used by the serializers
+
+	const Path resourceFolder = FileSystem::getTempDirectoryPath() + "bsfResourceBenchmark/";
+	FileSystem::createDir(resourceFolder);
+
+	SPtr<ResourceManifest> manifest = ResourceManifest::create("Benchmark");
+	Vector<UUID> uuids;
+
+	Random random;
+	for(UINT32 i = 0; i < NUM_STARTUP_RESOURCES; i++)
+	{
+		const UUID uuid = UUIDGenerator::generateRandom();
+		const Path path = resourceFolder + ("resource" + toString(i) + ".asset");
+
+		writeResourceFile(path, random);
+		manifest->registerResource(uuid, path);
+		uuids.push_back(uuid);
+	}
+
+	// Load in a different order than the resources were written in, as a scene would
+	for(UINT32 i = (UINT32)uuids.size() - 1; i > 0; i--)
+		std::swap(uuids[i], uuids[random.get() % (i + 1)]);
+
+	const Path packPath = resourceFolder + "resources.pack";
+	ResourcePack::create(manifest, packPath);
+
+	double looseTime = std::numeric_limits<double>::max();
+	double packTime = std::numeric_limits<double>::max();
+	for(UINT32 i = 0; i < NUM_RUNS; i++)
+	{
+		looseTime = std::min(looseTime, runLooseFiles(manifest, uuids));
+		packTime = std::min(packTime, runPack(packPath, uuids));
+	}
+
+	std::cout << std::endl << NUM_STARTUP_RESOURCES << " resources of " << STARTUP_RESOURCE_SIZE / 1024 << " KB"
+		<< std::endl;
+	std::cout << std::left << std::setw(16) << "Source" << std::setw(16) << "Total (ms)" << "Per resource (us)" 
+		<< std::endl;
+	std::cout << std::left << std::setw(16) << "Loose files" << std::fixed << std::setprecision(2) << std::setw(16)
+		<< looseTime << looseTime * 1000.0 / NUM_STARTUP_RESOURCES << std::endl;
+	std::cout << std::left << std::setw(16) << "Pack" << std::fixed << std::setprecision(2) << std::setw(16)
+		<< packTime << packTime * 1000.0 / NUM_STARTUP_RESOURCES << std::endl;
+
+	FileSystem::remove(resourceFolder);
+	MemStack::endThread();
+
+	return 0;
+}
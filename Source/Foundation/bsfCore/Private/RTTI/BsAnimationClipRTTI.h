@@ -6,6 +6,7 @@
 #include "Reflection/BsRTTIType.h"
 #include "Animation/BsAnimationClip.h"
 #include "Private/RTTI/BsAnimationCurveRTTI.h"
+#include "Private/RTTI/BsCompressedAnimationCurvesRTTI.h"
 
 namespace bs
 {
@@ -77,6 +78,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(mSampleRate, 7)
 			BS_RTTI_MEMBER_PLAIN_NAMED(rootMotionPos, mRootMotion->position, 8)
 			BS_RTTI_MEMBER_PLAIN_NAMED(rootMotionRot, mRootMotion->rotation, 9)
+			BS_RTTI_MEMBER_REFLPTR(mCompressedCurves, 10)
 		BS_END_RTTI_MEMBERS
 	public:
 		void onDeserializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
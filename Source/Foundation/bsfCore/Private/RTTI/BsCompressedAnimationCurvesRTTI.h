@@ -0,0 +1,53 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsRTTIType.h"
+#include "Animation/BsCompressedAnimationCurves.h"
+
+namespace bs
+{
+	/** @cond RTTI */
+	/** @addtogroup RTTI-Impl-Core
+	 *  @{
+	 */
+
+	class BS_CORE_EXPORT CompressedAnimationCurvesRTTI : 
+		public RTTIType <CompressedAnimationCurves, IReflectable, CompressedAnimationCurvesRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(mLength, 0)
+			BS_RTTI_MEMBER_PLAIN(mFrameRate, 1)
+			BS_RTTI_MEMBER_PLAIN(mNumFrames, 2)
+			BS_RTTI_MEMBER_PLAIN(mSegmentLength, 3)
+			BS_RTTI_MEMBER_PLAIN(mNumSegments, 4)
+			BS_RTTI_MEMBER_PLAIN_NAMED(numPositionTracks, mNumTracks[0], 5)
+			BS_RTTI_MEMBER_PLAIN_NAMED(numRotationTracks, mNumTracks[1], 6)
+			BS_RTTI_MEMBER_PLAIN_NAMED(numScaleTracks, mNumTracks[2], 7)
+			BS_RTTI_MEMBER_PLAIN(mHeaders, 8)
+			BS_RTTI_MEMBER_PLAIN(mData, 9)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "CompressedAnimationCurves";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_CompressedAnimationCurves;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return CompressedAnimationCurves::createEmpty();
+		}
+	};
+
+	/** @} */
+	/** @endcond */
+}
@@ -204,7 +204,7 @@ namespace bs
 			for (auto& entry : paramsObj->mParamLookup)
 			{
 				UINT32 paramIdx = entry.second;
-				matParams.push_back({ entry.first, paramsObj->mParams[paramIdx] });
+				matParams.push_back({ entry.first.cstr(), paramsObj->mParams[paramIdx] });
 			}
 
 			paramsObj->mRTTIData = matParams;
@@ -216,6 +216,12 @@ namespace bs
 			paramsObj->mRTTIData = nullptr;
 		}
 
+		void onDeserializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
+		{
+			MaterialParams* paramsObj = static_cast<MaterialParams*>(obj);
+			paramsObj->initDirtyMasks();
+		}
+
 		const String& getRTTIName() override
 		{
 			static String name = "MaterialParams";
@@ -51,6 +51,11 @@ namespace bs
 		void onDeserializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
 		{
 			Mesh* mesh = static_cast<Mesh*>(obj);
+
+			// CPU cached data lives as long as the mesh, don't let it keep the source file mapped
+			if ((mesh->mUsage & MU_CPUCACHED) != 0 && mesh->mCPUData != nullptr)
+				mesh->mCPUData->_releaseStream();
+
 			mesh->initialize();
 		}
 
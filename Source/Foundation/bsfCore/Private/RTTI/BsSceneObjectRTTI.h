@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Reflection/BsRTTIType.h"
 #include "Scene/BsSceneObject.h"
+#include "Scene/BsTransformStorage.h"
 #include "Scene/BsGameObjectHandle.h"
 #include "Scene/BsGameObjectManager.h"
 #include "Scene/BsComponent.h"
@@ -32,7 +33,13 @@ namespace bs
 		void setTransform(SceneObject* obj, Transform& value) { obj->mWorldTfrm = value; }
 
 		Transform& getLocalTransform(SceneObject* obj) { return obj->mLocalTfrm; }
-		void setLocalTransform(SceneObject* obj, Transform& value) { obj->mLocalTfrm = value; }
+		void setLocalTransform(SceneObject* obj, Transform& value)
+		{
+			obj->mLocalTfrm = value;
+
+			if (obj->isInTransformStorage())
+				TransformStorage::instance().setLocalTransform(obj->mTransformId, value);
+		}
 
 		bool& getActive(SceneObject* obj) { return obj->mActiveSelf; }
 		void setActive(SceneObject* obj, bool& value) { obj->mActiveSelf = value; }
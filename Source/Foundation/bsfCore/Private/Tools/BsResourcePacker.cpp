@@ -0,0 +1,64 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsCorePrerequisites.h"
+#include "Resources/BsResourceManifest.h"
+#include "Resources/BsResourcePack.h"
+#include "FileSystem/BsFileSystem.h"
+
+#include <iostream>
+
+using namespace bs;
+
+/**
+ * Creates a resource pack containing all the resources registered in a resource manifest.
+ *
+ * Usage: ResourcePacker <manifest> <output pack> [resource folder]
+ *
+ * The resource folder is prepended to the paths stored in the manifest, and should match the relative path the manifest
+ * was saved with. If not provided the folder containing the manifest is used.
+ */
+int main(int argc, char* argv[])
+{
+	if(argc < 3)
+	{
+		std::cout << "Usage: ResourcePacker <manifest> <output pack> [resource folder]" << std::endl;
+		return 1;
+	}
+
+	Path manifestPath = Path(argv[1]).getAbsolute(FileSystem::getWorkingDirectoryPath());
+	Path outputPath = Path(argv[2]).getAbsolute(FileSystem::getWorkingDirectoryPath());
+
+	Path resourceFolder;
+	if(argc > 3)
+		resourceFolder = Path(argv[3]).getAbsolute(FileSystem::getWorkingDirectoryPath());
+	else
+		resourceFolder = manifestPath.getDirectory();
+
+	if(!FileSystem::isFile(manifestPath))
+	{
+		std::cout << "Manifest \"" << manifestPath.toString() << "\" doesn't exist." << std::endl;
+		return 1;
+	}
+
+	SPtr<ResourceManifest> manifest = ResourceManifest::load(manifestPath, resourceFolder);
+	if(manifest == nullptr)
+	{
+		std::cout << "Failed to load manifest \"" << manifestPath.toString() << "\"." << std::endl;
+		return 1;
+	}
+
+	if(!ResourcePack::create(manifest, outputPath))
+	{
+		std::cout << "Failed to create pack \"" << outputPath.toString() << "\"." << std::endl;
+		return 1;
+	}
+
+	SPtr<ResourcePack> pack = ResourcePack::open(outputPath);
+	if(pack == nullptr)
+		return 1;
+
+	std::cout << "Packed " << pack->getNumEntries() << " of " << manifest->getResources().size() << " resources into \""
+		<< outputPath.toString() << "\" (" << FileSystem::getFileSize(outputPath) << " bytes)." << std::endl;
+
+	return 0;
+}
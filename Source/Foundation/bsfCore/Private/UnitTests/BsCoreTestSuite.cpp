@@ -0,0 +1,379 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/UnitTests/BsCoreTestSuite.h"
+#include "Animation/BsSkeleton.h"
+#include "Animation/BsSkeletonMask.h"
+#include "Animation/BsAnimationClip.h"
+#include "Math/BsRandom.h"
+
+namespace bs
+{
+	/**
+	 * Evaluates the pose one bone and one curve at a time, the way Skeleton::getPose() did before it was moved to SIMD.
+	 * Used as the reference the SIMD output is compared against.
+	 */
+	static void getScalarPose(const Vector<BONE_DESC>& bones, Matrix4* pose, LocalSkeletonPose& localPose,
+		const SkeletonMask& mask, const AnimationStateLayer* layers, UINT32 numLayers)
+	{
+		const UINT32 numBones = (UINT32)bones.size();
+		for(UINT32 i = 0; i < numBones; i++)
+		{
+			localPose.positions[i] = Vector3::ZERO;
+			localPose.rotations[i] = Quaternion::ZERO;
+			localPose.scales[i] = Vector3::ONE;
+		}
+
+		Vector<bool> hasAnimCurve(numBones, false);
+		for(UINT32 i = 0; i < numLayers; i++)
+		{
+			const AnimationStateLayer& layer = layers[i];
+
+			float invLayerWeight;
+			if (layer.additive)
+			{
+				float weightSum = 0.0f;
+				for (UINT32 j = 0; j < layer.numStates; j++)
+					weightSum += layer.states[j].weight;
+
+				invLayerWeight = 1.0f / weightSum;
+			}
+			else
+				invLayerWeight = 1.0f;
+
+			for (UINT32 j = 0; j < layer.numStates; j++)
+			{
+				const AnimationState& state = layer.states[j];
+				if (state.disabled)
+					continue;
+
+				float normWeight = state.weight * invLayerWeight;
+				if (Math::approxEquals(normWeight, 0.0f))
+					continue;
+
+				for (UINT32 k = 0; k < numBones; k++)
+				{
+					if (!mask.isEnabled(k))
+						continue;
+
+					const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
+					UINT32 curveIdx = mapping.position;
+					if (curveIdx != (UINT32)-1)
+					{
+						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+						localPose.positions[k] +=
+							curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop) * normWeight;
+
+						localPose.hasOverride[k] = false;
+						hasAnimCurve[k] = true;
+					}
+
+					curveIdx = mapping.scale;
+					if (curveIdx != (UINT32)-1)
+					{
+						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+						localPose.scales[k] *=
+							curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop) * normWeight;
+
+						localPose.hasOverride[k] = false;
+						hasAnimCurve[k] = true;
+					}
+
+					curveIdx = mapping.rotation;
+					if (curveIdx == (UINT32)-1)
+						continue;
+
+					const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+					Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
+
+					if (layer.additive)
+					{
+						if (localPose.rotations[k].w == 0.0f)
+							localPose.rotations[k] = Quaternion::IDENTITY;
+
+						localPose.rotations[k] *= Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
+					}
+					else
+					{
+						value = value * normWeight;
+						if (value.dot(localPose.rotations[k]) < 0.0f)
+							value = -value;
+
+						localPose.rotations[k] += value;
+					}
+
+					localPose.hasOverride[k] = false;
+					hasAnimCurve[k] = true;
+				}
+			}
+		}
+
+		for(UINT32 i = 0; i < numBones; i++)
+		{
+			if(hasAnimCurve[i])
+				continue;
+
+			localPose.positions[i] = bones[i].localTfrm.getPosition();
+			localPose.rotations[i] = bones[i].localTfrm.getRotation();
+			localPose.scales[i] = bones[i].localTfrm.getScale();
+		}
+
+		Vector<bool> isGlobal(numBones, false);
+		for(UINT32 i = 0; i < numBones; i++)
+		{
+			if (localPose.rotations[i].w == 0.0f)
+				localPose.rotations[i] = Quaternion::IDENTITY;
+			else
+				localPose.rotations[i].normalize();
+
+			if (localPose.hasOverride[i])
+			{
+				isGlobal[i] = true;
+				continue;
+			}
+
+			pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
+		}
+
+		std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+		{
+			UINT32 parentBoneIdx = bones[boneIdx].parent;
+			if (parentBoneIdx == (UINT32)-1)
+			{
+				isGlobal[boneIdx] = true;
+				return;
+			}
+
+			if (!isGlobal[parentBoneIdx])
+				calcGlobal(parentBoneIdx);
+
+			pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
+			isGlobal[boneIdx] = true;
+		};
+
+		for (UINT32 i = 0; i < numBones; i++)
+		{
+			if (!isGlobal[i])
+				calcGlobal(i);
+		}
+
+		for (UINT32 i = 0; i < numBones; i++)
+			pose[i] = pose[i] * bones[i].invBindPose;
+	}
+
+	/** Checks if two values are equal, with a tolerance relative to their magnitude. */
+	static bool approxEqualsRelative(float a, float b)
+	{
+		return Math::abs(a - b) <= 1e-4f * std::max(1.0f, std::max(Math::abs(a), Math::abs(b)));
+	}
+
+	/** Returns a random rotation, with its w component of either sign. */
+	static Quaternion getRandomRotation(const Random& random)
+	{
+		return Quaternion(random.getUnitVector(), Radian(random.getSNorm() * Math::PI));
+	}
+
+	/** Returns a curve with a few keys with random values and tangents. */
+	template<class T>
+	static TAnimationCurve<T> getRandomCurve(const Random& random, const std::function<T()>& getValue)
+	{
+		Vector<TKeyframe<T>> keyframes(4);
+		for(UINT32 i = 0; i < (UINT32)keyframes.size(); i++)
+		{
+			keyframes[i].value = getValue();
+			keyframes[i].inTangent = getValue();
+			keyframes[i].outTangent = getValue();
+			keyframes[i].time = i * 0.5f;
+		}
+
+		return TAnimationCurve<T>(keyframes);
+	}
+
+	/** Clip curves with a bone to curve mapping and evaluation caches, as kept by the animation system. */
+	struct TestClipState
+	{
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		Vector<AnimationCurveMapping> mapping;
+		Vector<TCurveCache<Vector3>> positionCaches;
+		Vector<TCurveCache<Quaternion>> rotationCaches;
+		Vector<TCurveCache<Vector3>> scaleCaches;
+
+		/** Adds curves for a random subset of the bones, and sets up the state to use them. */
+		void generate(const Random& random, const Vector<BONE_DESC>& bones, AnimationState& state)
+		{
+			auto getPosition = [&random]() { return random.getPointInSphere() * 2.0f; };
+			auto getRotation = [&random]() { return getRandomRotation(random); };
+			auto getScale = [&random]() { return Vector3::ONE * (0.5f + random.getUNorm()); };
+
+			mapping.resize(bones.size());
+			for(UINT32 i = 0; i < (UINT32)bones.size(); i++)
+			{
+				AnimationCurveMapping& boneMapping = mapping[i];
+				boneMapping = { (UINT32)-1, (UINT32)-1, (UINT32)-1 };
+
+				// Leave some bones without any curves, so they fall back to the bind pose
+				if((random.get() % 4) == 0)
+					continue;
+
+				if((random.get() % 2) == 0)
+				{
+					boneMapping.position = (UINT32)curves->position.size();
+					curves->addPositionCurve(bones[i].name, getRandomCurve<Vector3>(random, getPosition));
+				}
+
+				if((random.get() % 4) != 0)
+				{
+					boneMapping.rotation = (UINT32)curves->rotation.size();
+					curves->addRotationCurve(bones[i].name, getRandomCurve<Quaternion>(random, getRotation));
+				}
+
+				if((random.get() % 3) == 0)
+				{
+					boneMapping.scale = (UINT32)curves->scale.size();
+					curves->addScaleCurve(bones[i].name, getRandomCurve<Vector3>(random, getScale));
+				}
+			}
+
+			state.curves = curves;
+			state.compressedCurves = nullptr;
+			state.boneToCurveMapping = mapping.data();
+			state.soToCurveMapping = nullptr;
+			state.genericCaches = nullptr;
+			state.time = random.getUNorm() * 1.5f;
+			state.weight = 0.1f + random.getUNorm();
+			state.loop = true;
+			state.disabled = false;
+
+			resetCaches(state);
+		}
+
+		/** Clears the evaluation caches, so both evaluations start from the same state. */
+		void resetCaches(AnimationState& state)
+		{
+			positionCaches.assign(curves->position.size(), TCurveCache<Vector3>());
+			rotationCaches.assign(curves->rotation.size(), TCurveCache<Quaternion>());
+			scaleCaches.assign(curves->scale.size(), TCurveCache<Vector3>());
+
+			state.positionCaches = positionCaches.data();
+			state.rotationCaches = rotationCaches.data();
+			state.scaleCaches = scaleCaches.data();
+		}
+	};
+
+	void CoreTestSuite::startUp()
+	{
+		MemStack::beginThread();
+	}
+
+	void CoreTestSuite::shutDown()
+	{
+		MemStack::endThread();
+	}
+
+	CoreTestSuite::CoreTestSuite()
+	{
+		BS_ADD_TEST(CoreTestSuite::testSkeletonPose);
+	}
+
+	void CoreTestSuite::testSkeletonPose()
+	{
+		// Bone count is not a multiple of the SIMD batch size, so the padded tail gets tested as well
+		constexpr UINT32 NUM_BONES = 61;
+		Random random(3);
+
+		// Bones are created in random order, so parents often have a larger index than their children
+		Vector<UINT32> creationOrder(NUM_BONES);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+			creationOrder[i] = i;
+
+		for(UINT32 i = NUM_BONES - 1; i > 0; i--)
+			std::swap(creationOrder[i], creationOrder[random.get() % (i + 1)]);
+
+		Vector<BONE_DESC> bones(NUM_BONES);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			const UINT32 boneIdx = creationOrder[i];
+
+			BONE_DESC& bone = bones[boneIdx];
+			bone.name = "Bone" + toString(boneIdx);
+			bone.parent = i > 0 ? creationOrder[random.get() % i] : (UINT32)-1;
+			bone.localTfrm = Transform(random.getPointInSphere(), getRandomRotation(random),
+				Vector3::ONE * (0.75f + random.getUNorm() * 0.5f));
+			bone.invBindPose = Matrix4::TRS(random.getPointInSphere(), getRandomRotation(random), Vector3::ONE);
+		}
+
+		SPtr<Skeleton> skeleton = Skeleton::create(bones.data(), NUM_BONES);
+
+		// Two blended states in a regular layer, followed by an additive layer with two states
+		TestClipState clipStates[4];
+		AnimationState states[4];
+		for(UINT32 i = 0; i < 4; i++)
+			clipStates[i].generate(random, bones, states[i]);
+
+		AnimationStateLayer layers[2];
+		layers[0].states = &states[0];
+		layers[0].numStates = 2;
+		layers[0].index = 0;
+		layers[0].additive = false;
+
+		layers[1].states = &states[2];
+		layers[1].numStates = 2;
+		layers[1].index = 1;
+		layers[1].additive = true;
+
+		SkeletonMaskBuilder maskBuilder(skeleton);
+		maskBuilder.setBoneState(bones[creationOrder[NUM_BONES / 2]].name, false);
+		maskBuilder.setBoneState(bones[creationOrder[NUM_BONES - 1]].name, false);
+		SkeletonMask mask = maskBuilder.getMask();
+
+		// Overriden bones use the pose provided by the caller, unless they are animated
+		Vector<Matrix4> overridePose(NUM_BONES);
+		Vector<bool> hasOverride(NUM_BONES);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			hasOverride[i] = (random.get() % 8) == 0;
+			overridePose[i] = Matrix4::TRS(random.getPointInSphere(), getRandomRotation(random), Vector3::ONE);
+		}
+
+		Vector<Matrix4> scalarPose = overridePose;
+		LocalSkeletonPose scalarLocalPose(NUM_BONES);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+			scalarLocalPose.hasOverride[i] = hasOverride[i];
+
+		getScalarPose(bones, scalarPose.data(), scalarLocalPose, mask, layers, 2);
+
+		for(UINT32 i = 0; i < 4; i++)
+			clipStates[i].resetCaches(states[i]);
+
+		Vector<Matrix4> simdPose = overridePose;
+		LocalSkeletonPose simdLocalPose(NUM_BONES);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+			simdLocalPose.hasOverride[i] = hasOverride[i];
+
+		skeleton->getPose(simdPose.data(), simdLocalPose, mask, layers, 2);
+
+		bool localPoseMatches = true;
+		bool poseMatches = true;
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			localPoseMatches &= scalarLocalPose.hasOverride[i] == simdLocalPose.hasOverride[i];
+
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				localPoseMatches &= approxEqualsRelative(scalarLocalPose.positions[i][j], simdLocalPose.positions[i][j]);
+				localPoseMatches &= approxEqualsRelative(scalarLocalPose.scales[i][j], simdLocalPose.scales[i][j]);
+			}
+
+			for(UINT32 j = 0; j < 4; j++)
+				localPoseMatches &= approxEqualsRelative(scalarLocalPose.rotations[i][j], simdLocalPose.rotations[i][j]);
+
+			for(UINT32 j = 0; j < 4; j++)
+			{
+				for(UINT32 k = 0; k < 4; k++)
+					poseMatches &= approxEqualsRelative(scalarPose[i][j][k], simdPose[i][j][k]);
+			}
+		}
+
+		BS_TEST_ASSERT(localPoseMatches);
+		BS_TEST_ASSERT(poseMatches);
+	}
+}
@@ -0,0 +1,43 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Profiling/BsLatencyHistogram.h"
+#include "Utility/BsBitwise.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	void LatencyHistogram::addSample(UINT64 microseconds)
+	{
+		UINT32 idx = 0;
+		if(microseconds > 0)
+			idx = std::min(Bitwise::mostSignificantBitSet(microseconds) + 1, NUM_BUCKETS - 1);
+
+		mBuckets[idx]++;
+		mNumSamples++;
+		mTotal += microseconds;
+		mMax = std::max(mMax, microseconds);
+	}
+
+	void LatencyHistogram::clear()
+	{
+		*this = LatencyHistogram();
+	}
+
+	UINT64 LatencyHistogram::getPercentile(float percentile) const
+	{
+		if(mNumSamples == 0)
+			return 0;
+
+		const UINT64 threshold = std::max((UINT64)std::ceil(Math::clamp01(percentile) * mNumSamples), (UINT64)1);
+
+		UINT64 count = 0;
+		for(UINT32 i = 0; i < NUM_BUCKETS; i++)
+		{
+			count += mBuckets[i];
+			if(count >= threshold)
+				return std::min(getBucketUpperBound(i), mMax);
+		}
+
+		return mMax;
+	}
+}
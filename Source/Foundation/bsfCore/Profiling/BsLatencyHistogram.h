@@ -0,0 +1,60 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Profiling
+	 *  @{
+	 */
+
+	/**
+	 * Records the distribution of latencies, in microseconds. Samples are counted in buckets of exponentially increasing
+	 * size: bucket 0 counts samples under one microsecond, and bucket N counts samples in range [2^(N-1), 2^N).
+	 */
+	class BS_CORE_EXPORT LatencyHistogram
+	{
+	public:
+		/** Number of buckets in the histogram. The last bucket also counts all samples larger than its range. */
+		static constexpr UINT32 NUM_BUCKETS = 32;
+
+		/** Records a single sample. */
+		void addSample(UINT64 microseconds);
+
+		/** Removes all recorded samples. */
+		void clear();
+
+		/** Returns the number of recorded samples. */
+		UINT64 getNumSamples() const { return mNumSamples; }
+
+		/** Returns the average of all recorded samples, in microseconds. */
+		double getAverage() const { return mNumSamples > 0 ? mTotal / (double)mNumSamples : 0.0; }
+
+		/** Returns the largest recorded sample, in microseconds. */
+		UINT64 getMax() const { return mMax; }
+
+		/** Returns the number of samples in the bucket with the specified index. */
+		UINT64 getBucketCount(UINT32 idx) const { return mBuckets[idx]; }
+
+		/** Returns the exclusive upper bound of the bucket with the specified index, in microseconds. */
+		static UINT64 getBucketUpperBound(UINT32 idx) { return 1ULL << idx; }
+
+		/**
+		 * Returns the latency under which the specified portion of samples fall, in microseconds. The value is rounded up
+		 * to the upper bound of the bucket the percentile falls in, but never exceeds the largest recorded sample.
+		 *
+		 * @param[in]	percentile	Portion of the samples, in range [0, 1].
+		 */
+		UINT64 getPercentile(float percentile) const;
+
+	private:
+		UINT64 mBuckets[NUM_BUCKETS] = {};
+		UINT64 mNumSamples = 0;
+		UINT64 mTotal = 0;
+		UINT64 mMax = 0;
+	};
+
+	/** @} */
+}
@@ -385,6 +385,34 @@ namespace bs
 			thread->activeBlock = ActiveBlock();
 	}
 
+	void ProfilerCPU::addSample(const char* name, double time)
+	{
+		ThreadInfo* thread = ThreadInfo::activeThread;
+		if(thread == nullptr || !thread->isActive)
+		{
+			beginThread("Unknown");
+			thread = ThreadInfo::activeThread;
+		}
+
+		ProfiledBlock* parent = thread->activeBlock.block;
+		ProfiledBlock* block = nullptr;
+		
+		if(parent != nullptr)
+			block = parent->findChild(name);
+
+		if(block == nullptr)
+		{
+			block = thread->getBlock(name);
+
+			if(parent != nullptr)
+				parent->children.push_back(block);
+			else
+				thread->rootBlock->children.push_back(block);
+		}
+
+		block->basic.samples.push_back(ProfileSample(time, 0, 0));
+	}
+
 	void ProfilerCPU::beginSamplePrecise(const char* name)
 	{
 		// Note: There is a (small) possibility a context switch will happen during this measurement in which case result will be skewed. 
@@ -293,6 +293,16 @@ namespace bs
 		 */
 		void endSamplePrecise(const char* name);
 
+		/**
+		 * Records a sample whose duration was measured externally, rather than by a beginSample() / endSample() pair.
+		 * Useful for measurements that don't start and end on the same thread (e.g. latency of work handed off to other
+		 * threads). The sample is added as a child of the currently active sample.
+		 *
+		 * @param[in]	name	Unique name for the sample you can later use to find the sampling data.
+		 * @param[in]	time	Duration of the sample, in milliseconds.
+		 */
+		void addSample(const char* name, double time);
+
 		/** Clears all sampling data, and ends any unfinished sampling blocks. */
 		void reset();
 
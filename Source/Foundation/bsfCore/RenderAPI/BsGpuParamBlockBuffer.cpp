@@ -152,7 +152,7 @@ namespace bs
 
 	void GpuParamBlockBuffer::flushToGPU(UINT32 queueIdx)
 	{
-		if (mGPUBufferDirty)
+		if (mGPUBufferDirty || isGPUDataLost())
 		{
 			writeToGPU(mCachedData, queueIdx);
 			mGPUBufferDirty = false;
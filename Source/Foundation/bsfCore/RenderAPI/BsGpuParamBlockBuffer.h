@@ -138,6 +138,13 @@ namespace bs
 		/** @copydoc CoreObject::syncToCore */
 		void syncToCore(const CoreSyncData& data)  override;
 
+		/** 
+		 * Checks if the data last written by writeToGPU() is no longer available on the GPU, in which case the next
+		 * flushToGPU() call will write the cached data again even if it wasn't modified. This happens for GPBU_STREAM
+		 * buffers whose space in the ring buffer was reclaimed.
+		 */
+		virtual bool isGPUDataLost() const { return false; }
+
 		GpuParamBlockUsage mUsage;
 		UINT32 mSize;
 
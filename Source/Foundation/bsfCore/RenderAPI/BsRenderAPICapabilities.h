@@ -38,6 +38,7 @@ namespace bs
 		RSC_GEOMETRY_PROGRAM			= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 3), /**< Supports hardware geometry programs. */
 		RSC_TESSELLATION_PROGRAM		= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 4), /**< Supports hardware tessellation programs. */
 		RSC_COMPUTE_PROGRAM				= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 5), /**< Supports hardware compute programs. */
+		RSC_PARAM_BLOCK_RING_BUFFER		= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 6), /**< Sub-allocates GPBU_STREAM parameter blocks from a ring buffer and binds them by offset. */
 	};
 
 	/** Holds data about render system driver version. */
@@ -129,7 +129,10 @@ namespace bs { namespace ct
 			ParamBlockManager::registerBlock(this);																			\
 		}																													\
 																															\
-		SPtr<GpuParamBlockBuffer> createBuffer() const { return GpuParamBlockBuffer::create(mBlockSize); }					\
+		SPtr<GpuParamBlockBuffer> createBuffer(GpuParamBlockUsage usage = GPBU_DYNAMIC) const								\
+		{																													\
+			return GpuParamBlockBuffer::create(mBlockSize, usage);															\
+		}																													\
 																															\
 	private:																												\
 		friend class ParamBlockManager;																						\
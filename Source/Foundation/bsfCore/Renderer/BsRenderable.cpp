@@ -419,7 +419,7 @@ namespace bs
 	namespace ct
 	{
 	Renderable::Renderable() 
-		:mRendererId(0), mAnimationId((UINT64)-1), mMorphShapeVersion(0)
+		:mRendererId(0), mAnimationId((UINT64)-1), mMorphShapeVersion(0), mPoseVersion(0)
 	{
 	}
 
@@ -505,6 +505,8 @@ namespace bs
 		else
 			mBoneMatrixBuffer = nullptr;
 
+		mPoseVersion = 0;
+
 		if (mAnimType == RenderableAnimType::Morph || mAnimType == RenderableAnimType::SkinnedMorph)
 		{
 			SPtr<MorphShapes> morphShapes = mMesh->getMorphShapes();
@@ -546,7 +548,9 @@ namespace bs
 		if (animInfo == nullptr)
 			return;
 
-		if (mAnimType == RenderableAnimType::Skinned || mAnimType == RenderableAnimType::SkinnedMorph)
+		// Animation data only changes when animation is re-evaluated, which can be less often than every frame
+		const bool isPoseDirty = mPoseVersion != animData.version;
+		if (isPoseDirty && (mAnimType == RenderableAnimType::Skinned || mAnimType == RenderableAnimType::SkinnedMorph))
 		{
 			const EvaluatedAnimationData::PoseInfo& poseInfo = animInfo->poseInfo;
 
@@ -562,6 +566,7 @@ namespace bs
 			}
 
 			mBoneMatrixBuffer->unlock();
+			mPoseVersion = animData.version;
 		}
 
 		if (mAnimType == RenderableAnimType::Morph || mAnimType == RenderableAnimType::SkinnedMorph)
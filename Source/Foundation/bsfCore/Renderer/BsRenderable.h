@@ -247,7 +247,8 @@ namespace bs
 
 		/** 
 		 * Updates internal animation buffers from the contents of the provided animation data object. Does nothing if
-		 * renderable is not affected by animation.
+		 * renderable is not affected by animation, or if the buffers were already updated from the same version of
+		 * the animation data.
 		 */
 		void updateAnimationBuffers(const EvaluatedAnimationData& animData);
 
@@ -277,6 +278,7 @@ namespace bs
 		UINT32 mRendererId;
 		UINT64 mAnimationId;
 		UINT32 mMorphShapeVersion;
+		UINT64 mPoseVersion;
 
 		SPtr<GpuBuffer> mBoneMatrixBuffer;
 		SPtr<VertexBuffer> mMorphShapeBuffer;
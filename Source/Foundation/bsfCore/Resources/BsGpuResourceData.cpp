@@ -4,6 +4,7 @@
 #include "Private/RTTI/BsGpuResourceDataRTTI.h"
 #include "CoreThread/BsCoreThread.h"
 #include "Error/BsException.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -16,6 +17,7 @@ namespace bs
 	GpuResourceData::GpuResourceData(const GpuResourceData& copy)
 	{
 		mData = copy.mData;
+		mDataStream = copy.mDataStream;
 		mLocked = copy.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
 	}
@@ -28,6 +30,7 @@ namespace bs
 	GpuResourceData& GpuResourceData::operator=(const GpuResourceData& rhs)
 	{
 		mData = rhs.mData;
+		mDataStream = rhs.mDataStream;
 		mLocked = rhs.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
 
@@ -65,6 +68,7 @@ namespace bs
 		freeInternalBuffer();
 
 		mData = (UINT8*)bs_alloc(size);
+		mDataStream = nullptr;
 		mOwnsData = true;
 	}
 
@@ -98,9 +102,44 @@ namespace bs
 		freeInternalBuffer();
 
 		mData = data;
+		mDataStream = nullptr;
 		mOwnsData = false;
 	}
 
+	void GpuResourceData::_loadFromStream(const SPtr<DataStream>& stream, UINT32 size)
+	{
+		// Mapped data is referenced only if aligned enough to be accessed as any of the supported vertex/pixel formats
+		if (stream->isMapped())
+		{
+			UINT8* data = static_cast<MemoryDataStream*>(stream.get())->getCurrentPtr();
+			if (((size_t)data % 4) == 0 && stream->tell() + size <= stream->size())
+			{
+				setExternalBuffer(data);
+				mDataStream = stream;
+
+				stream->skip(size);
+				return;
+			}
+		}
+
+		allocateInternalBuffer(size);
+		stream->read(mData, size);
+	}
+
+	void GpuResourceData::_releaseStream()
+	{
+		if (mDataStream == nullptr)
+			return;
+
+		// Keep the mapping alive until the data is copied out of it
+		SPtr<DataStream> stream = mDataStream;
+		UINT8* data = mData;
+
+		const UINT32 size = getInternalBufferSize();
+		allocateInternalBuffer(size);
+		memcpy(mData, data, size);
+	}
+
 	void GpuResourceData::_lock() const
 	{
 		mLocked = true;
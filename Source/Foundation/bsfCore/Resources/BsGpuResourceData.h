@@ -66,6 +66,20 @@ namespace bs
 		 */
 		void setExternalBuffer(UINT8* data);
 
+		/**
+		 * Populates the internal buffer with @p size bytes read from the current position of @p stream. If the stream is
+		 * memory mapped and the data is suitably aligned, the data is referenced directly instead of being copied, and 
+		 * the stream is kept alive for as long as the data is referenced.
+		 */
+		void _loadFromStream(const SPtr<DataStream>& stream, UINT32 size);
+
+		/**
+		 * If the internal buffer references a memory mapped stream, copies the data into an internal buffer and releases
+		 * the stream. Should be called on data that is kept around after its resource is initialized, so the file it was
+		 * loaded from doesn't stay mapped.
+		 */
+		void _releaseStream();
+
 		/** Checks if the internal buffer is locked due to some other thread using it. */
 		bool isLocked() const { return mLocked; }
 
@@ -84,6 +98,7 @@ namespace bs
 
 	private:
 		UINT8* mData;
+		SPtr<DataStream> mDataStream;
 		bool mOwnsData;
 		mutable bool mLocked;
 
@@ -112,7 +112,7 @@ namespace bs
 
 	void ResourceHandleBase::removeInternalRef()
 	{
-		mData->mRefCount.fetch_sub(1, std::memory_order_relaxed);
+		mData->mRefCount.fetch_sub(1, std::memory_order_release);
 	}
 
 	void ResourceHandleBase::throwIfNotLoaded() const
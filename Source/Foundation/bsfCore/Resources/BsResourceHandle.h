@@ -159,7 +159,7 @@ namespace bs
 		{ 
 			if (mData)
 			{
-				std::uint32_t refCount = mData->mRefCount.fetch_sub(1, std::memory_order_relaxed);
+				std::uint32_t refCount = mData->mRefCount.fetch_sub(1, std::memory_order_release);
 
 				if (refCount == 1)
 					destroy();
@@ -335,7 +335,14 @@ namespace bs
 			this->addRef();
 		}
 
-		/**	Converts a weak handle into a normal handle. */
+		/**
+		 * Converts a weak handle into a normal handle.
+		 *
+		 * @note
+		 * An asynchronous load is cancelled once nothing references the resource anymore. If that happened the returned
+		 * handle will never finish loading. Use Resources::load(const WeakResourceHandle<T>&) instead to get a handle
+		 * to a resource that might not be loaded, as it restarts the load when needed.
+		 */
 		TResourceHandle<T, false> lock() const
 		{
 			TResourceHandle<Resource, false> handle;
@@ -55,6 +55,9 @@ namespace bs
 		/**	Checks if the provided path exists in the manifest. */
 		bool filePathExists(const Path& filePath) const;
 
+		/** Returns all the resources registered in the manifest, mapped from their UUID to their file path. */
+		const UnorderedMap<UUID, Path>& getResources() const { return mUUIDToFilePath; }
+
 		/**
 		 * Saves the resource manifest to the specified location.
 		 *
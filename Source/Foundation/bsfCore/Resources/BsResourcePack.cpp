@@ -0,0 +1,300 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Resources/BsResourcePack.h"
+#include "Resources/BsResourceManifest.h"
+#include "Resources/BsSavedResourceData.h"
+#include "Serialization/BsFileSerializer.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	/** Identifier at the start of every resource pack file ("BSPK"). */
+	static constexpr UINT32 PACK_MAGIC = 0x4B505342;
+
+	/** Version of the pack format written by ResourcePack::create(). */
+	static constexpr UINT32 PACK_VERSION = 1;
+
+	/**
+	 * Alignment of the index and of the data of every resource in the pack. Keeps the data of mapped resources aligned the
+	 * same as when mapping an individual resource file.
+	 */
+	static constexpr UINT64 PACK_ALIGNMENT = 64;
+
+	/** Header at the start of every resource pack file. */
+	struct PackHeader
+	{
+		UINT32 magic;
+		UINT32 version;
+		UINT32 numEntries;
+		UINT32 reserved;
+		UINT64 indexOffset;
+	};
+
+	/** Rounds the offset up to the next multiple of the pack alignment. */
+	static UINT64 alignPackOffset(UINT64 offset)
+	{
+		return (offset + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+	}
+
+	/**
+	 * Stream referencing the data of a single resource in a mapped pack. Keeps the pack mapped for as long as the stream,
+	 * or anything referencing its memory, is alive.
+	 */
+	class ResourcePackDataStream : public MemoryDataStream
+	{
+	public:
+		ResourcePackDataStream(const SPtr<MemoryDataStream>& packStream, UINT8* data, size_t size)
+			:MemoryDataStream(data, size, false), mPackStream(packStream)
+		{ }
+
+		bool isMapped() const override { return true; }
+
+	private:
+		SPtr<MemoryDataStream> mPackStream;
+	};
+
+	ResourcePack::ResourcePack(const ConstructPrivately& dummy)
+	{ }
+
+	const ResourcePack::Entry* ResourcePack::findEntry(const UUID& uuid) const
+	{
+		const Entry* end = mIndex + mNumEntries;
+		const Entry* iterFind = std::lower_bound(mIndex, end, uuid,
+			[](const Entry& entry, const UUID& value) { return entry.uuid < value; });
+
+		if (iterFind == end || iterFind->uuid != uuid)
+			return nullptr;
+
+		return iterFind;
+	}
+
+	SPtr<DataStream> ResourcePack::openEntry(const UUID& uuid) const
+	{
+		const Entry* entry = findEntry(uuid);
+		if (entry == nullptr)
+			return nullptr;
+
+		if (mMappedStream)
+			return bs_shared_ptr_new<ResourcePackDataStream>(mMappedStream, getEntryData(*entry), (size_t)entry->size);
+
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>((size_t)entry->size);
+
+		Lock lock(mFileMutex);
+		mFileStream->seek((size_t)entry->offset);
+		if (mFileStream->read(stream->getPtr(), (size_t)entry->size) != entry->size)
+		{
+			LOGERR("Failed reading resource " + uuid.toString() + " from pack \"" + mPath.toString() + "\".");
+			return nullptr;
+		}
+
+		return stream;
+	}
+
+	UINT64 ResourcePack::readEntry(const UUID& uuid, UINT64 offset, void* output, UINT64 size) const
+	{
+		const Entry* entry = findEntry(uuid);
+		if (entry == nullptr || offset >= entry->size)
+			return 0;
+
+		size = std::min(size, entry->size - offset);
+
+		if (mMappedStream)
+		{
+			memcpy(output, getEntryData(*entry) + offset, (size_t)size);
+			return size;
+		}
+
+		Lock lock(mFileMutex);
+		mFileStream->seek((size_t)(entry->offset + offset));
+		return mFileStream->read(output, (size_t)size);
+	}
+
+	UINT8* ResourcePack::getEntryData(const Entry& entry) const
+	{
+		if (!mMappedStream)
+			return nullptr;
+
+		return mMappedStream->getPtr() + entry.offset;
+	}
+
+	SPtr<ResourcePack> ResourcePack::open(const Path& path)
+	{
+		if (!FileSystem::isFile(path))
+		{
+			LOGWRN("Cannot open resource pack. Specified file: " + path.toString() + " doesn't exist.");
+			return nullptr;
+		}
+
+		SPtr<ResourcePack> pack = bs_shared_ptr_new<ResourcePack>(ConstructPrivately());
+		pack->mPath = path;
+
+		// Prefer mapping the pack so the index can be searched and the resources referenced without copying them
+		SPtr<MappedFileDataStream> mappedStream = bs_shared_ptr_new<MappedFileDataStream>(path, FileAccessPattern::Normal);
+
+		SPtr<DataStream> stream;
+		if (mappedStream->isOpen())
+			stream = mappedStream;
+		else
+		{
+			stream = FileSystem::openFile(path, true);
+			if (stream == nullptr)
+				return nullptr;
+		}
+
+		const UINT64 fileSize = stream->size();
+
+		PackHeader header;
+		if (stream->read(&header, sizeof(header)) != sizeof(header) || header.magic != PACK_MAGIC)
+		{
+			LOGERR("File \"" + path.toString() + "\" is not a valid resource pack.");
+			return nullptr;
+		}
+
+		if (header.version != PACK_VERSION)
+		{
+			LOGERR("Resource pack \"" + path.toString() + "\" uses an unsupported version " +
+				toString(header.version) + ".");
+			return nullptr;
+		}
+
+		const UINT64 indexSize = header.numEntries * (UINT64)sizeof(Entry);
+		if (header.indexOffset % PACK_ALIGNMENT != 0 || header.indexOffset + indexSize > fileSize)
+		{
+			LOGERR("Resource pack \"" + path.toString() + "\" has a corrupt index.");
+			return nullptr;
+		}
+
+		pack->mNumEntries = header.numEntries;
+		if (mappedStream->isOpen())
+		{
+			pack->mMappedStream = mappedStream;
+			pack->mIndex = (const Entry*)(mappedStream->getPtr() + header.indexOffset);
+		}
+		else
+		{
+			pack->mIndexData.resize(header.numEntries);
+
+			stream->seek((size_t)header.indexOffset);
+			stream->read(pack->mIndexData.data(), (size_t)indexSize);
+
+			pack->mFileStream = stream;
+			pack->mIndex = pack->mIndexData.data();
+		}
+
+		for (UINT32 i = 0; i < pack->mNumEntries; i++)
+		{
+			const Entry& entry = pack->mIndex[i];
+
+			const bool inBounds = entry.offset <= fileSize && entry.size <= fileSize - entry.offset;
+			const bool sorted = i == 0 || pack->mIndex[i - 1].uuid < entry.uuid;
+			if (!inBounds || !sorted)
+			{
+				LOGERR("Resource pack \"" + path.toString() + "\" has a corrupt index.");
+				return nullptr;
+			}
+		}
+
+		return pack;
+	}
+
+	bool ResourcePack::create(const SPtr<ResourceManifest>& manifest, const Path& outputPath)
+	{
+		Vector<std::pair<Entry, Path>> entries;
+		for (auto& resource : manifest->getResources())
+		{
+			const Path& filePath = resource.second;
+			if (!FileSystem::isFile(filePath))
+			{
+				LOGWRN("Skipping resource " + resource.first.toString() + " as its file \"" + filePath.toString() +
+					"\" doesn't exist.");
+				continue;
+			}
+
+			FileDecoder fs(filePath);
+			SPtr<SavedResourceData> savedResourceData = std::static_pointer_cast<SavedResourceData>(fs.decode());
+			if (savedResourceData == nullptr)
+			{
+				LOGWRN("Skipping file \"" + filePath.toString() + "\" as it isn't a valid resource file.");
+				continue;
+			}
+
+			ResourcePackEntryFlags flags;
+			if (savedResourceData->getCompressionMethod() != 0)
+				flags |= ResourcePackEntryFlag::Compressed;
+
+			Entry entry;
+			entry.uuid = resource.first;
+			entry.offset = 0;
+			entry.size = FileSystem::getFileSize(filePath);
+			entry.flags = (UINT32)flags;
+			entry.reserved = 0;
+
+			entries.push_back(std::make_pair(entry, filePath));
+		}
+
+		std::sort(entries.begin(), entries.end(),
+			[](const std::pair<Entry, Path>& a, const std::pair<Entry, Path>& b) { return a.first.uuid < b.first.uuid; });
+
+		PackHeader header;
+		header.magic = PACK_MAGIC;
+		header.version = PACK_VERSION;
+		header.numEntries = (UINT32)entries.size();
+		header.reserved = 0;
+		header.indexOffset = alignPackOffset(sizeof(PackHeader));
+
+		Vector<Entry> index(entries.size());
+		UINT64 offset = alignPackOffset(header.indexOffset + index.size() * sizeof(Entry));
+		for (UINT32 i = 0; i < (UINT32)entries.size(); i++)
+		{
+			index[i] = entries[i].first;
+			index[i].offset = offset;
+
+			offset = alignPackOffset(offset + index[i].size);
+		}
+
+		std::ofstream stream;
+		stream.open(outputPath.toPlatformString().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		if (stream.fail())
+		{
+			LOGERR("Failed to create resource pack: \"" + outputPath.toString() + "\". Error: " + strerror(errno) + ".");
+			return false;
+		}
+
+		const char padding[PACK_ALIGNMENT] = {};
+		auto writePadding = [&stream, &padding](UINT64 alignedOffset)
+		{
+			stream.write(padding, (std::streamsize)(alignedOffset - (UINT64)stream.tellp()));
+		};
+
+		stream.write((const char*)&header, sizeof(header));
+		writePadding(header.indexOffset);
+		stream.write((const char*)index.data(), index.size() * sizeof(Entry));
+
+		Vector<UINT8> buffer;
+		for (UINT32 i = 0; i < (UINT32)index.size(); i++)
+		{
+			const Path& filePath = entries[i].second;
+
+			buffer.resize((size_t)index[i].size);
+
+			SPtr<DataStream> fileStream = FileSystem::openFile(filePath, true);
+			if (fileStream == nullptr || fileStream->read(buffer.data(), buffer.size()) != buffer.size())
+			{
+				LOGERR("Failed to read resource file \"" + filePath.toString() + "\" while creating pack \"" +
+					outputPath.toString() + "\".");
+
+				stream.close();
+				FileSystem::remove(outputPath);
+				return false;
+			}
+
+			writePadding(index[i].offset);
+			stream.write((const char*)buffer.data(), buffer.size());
+		}
+
+		stream.close();
+		return !stream.fail();
+	}
+}
@@ -0,0 +1,121 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/** Flags describing the contents of a single resource stored in a ResourcePack. */
+	enum class ResourcePackEntryFlag
+	{
+		/** No flags. */
+		None = 0,
+		/** Resource data is compressed and must be decompressed before it can be deserialized. */
+		Compressed = 1 << 0
+	};
+
+	typedef Flags<ResourcePackEntryFlag> ResourcePackEntryFlags;
+	BS_FLAGS_OPERATORS(ResourcePackEntryFlag);
+
+	/**
+	 * A single file containing many saved resources, allowing them to be loaded without opening a separate file for each
+	 * one. Resources are stored exactly as they would be in individual resource files, and are located through an index
+	 * sorted by resource UUID.
+	 *
+	 * The pack is mapped into memory if possible, in which case resource data is referenced directly from the mapping.
+	 * Otherwise a single file handle is kept open and shared between all the reads.
+	 *
+	 * Packs are registered with Resources::registerResourcePack(), after which any resource contained in them is loaded
+	 * from the pack instead of its individual file.
+	 *
+	 * @note	Thread safe. The pack file must not be modified while the pack is open.
+	 */
+	class BS_CORE_EXPORT ResourcePack
+	{
+		struct ConstructPrivately {};
+	public:
+		/** Location and flags of a single resource in the pack, as stored in the pack index. */
+		struct Entry
+		{
+			UUID uuid;
+			UINT64 offset;
+			UINT64 size;
+			UINT32 flags;
+			UINT32 reserved;
+		};
+
+		explicit ResourcePack(const ConstructPrivately& dummy);
+
+		/** Returns the path of the pack file. */
+		const Path& getPath() const { return mPath; }
+
+		/** Returns the number of resources in the pack. */
+		UINT32 getNumEntries() const { return mNumEntries; }
+
+		/** Returns information about the resource at the specified index. Entries are sorted by UUID. */
+		const Entry& getEntry(UINT32 idx) const { return mIndex[idx]; }
+
+		/** Checks if the pack contains a resource with the specified UUID. */
+		bool contains(const UUID& uuid) const { return findEntry(uuid) != nullptr; }
+
+		/** Finds the entry for a resource with the specified UUID. Returns null if the pack doesn't contain the resource. */
+		const Entry* findEntry(const UUID& uuid) const;
+
+		/** Returns true if the pack file is mapped in memory. */
+		bool isMapped() const { return mMappedStream != nullptr; }
+
+		/**
+		 * Opens a stream containing the saved resource file data of the resource with the specified UUID. If the pack is
+		 * mapped the stream references the mapped memory, otherwise the data is read into memory. Returns null if the pack
+		 * doesn't contain the resource.
+		 */
+		SPtr<DataStream> openEntry(const UUID& uuid) const;
+
+		/**
+		 * Reads a range of the saved resource file data of the resource with the specified UUID, without reading the rest
+		 * of the resource.
+		 *
+		 * @param[in]	uuid	UUID of the resource to read.
+		 * @param[in]	offset	Offset relative to the start of the resource data, in bytes.
+		 * @param[out]	output	Buffer to output the data to. Must be at least @p size bytes.
+		 * @param[in]	size	Number of bytes to read.
+		 * @return				Number of bytes read. Less than @p size if the range extends past the end of the resource,
+		 *						or zero if the pack doesn't contain the resource.
+		 */
+		UINT64 readEntry(const UUID& uuid, UINT64 offset, void* output, UINT64 size) const;
+
+		/** Opens a resource pack. Returns null if the file doesn't exist or isn't a valid resource pack. */
+		static SPtr<ResourcePack> open(const Path& path);
+
+		/**
+		 * Creates a resource pack containing all the resources registered in the manifest. Resources whose files cannot
+		 * be found are skipped.
+		 *
+		 * @param[in]	manifest	Manifest containing the UUIDs and file paths of the resources to pack.
+		 * @param[in]	outputPath	Path to save the pack file at. Any existing file is overwritten.
+		 * @return					True if the pack was written.
+		 */
+		static bool create(const SPtr<ResourceManifest>& manifest, const Path& outputPath);
+
+	private:
+		/** Returns a pointer to the data of the entry, or null if the pack isn't mapped. */
+		UINT8* getEntryData(const Entry& entry) const;
+
+		Path mPath;
+		UINT32 mNumEntries = 0;
+		const Entry* mIndex = nullptr;
+
+		SPtr<MemoryDataStream> mMappedStream;
+
+		SPtr<DataStream> mFileStream;
+		Vector<Entry> mIndexData;
+		mutable Mutex mFileMutex;
+	};
+
+	/** @} */
+}
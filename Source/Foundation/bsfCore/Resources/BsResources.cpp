@@ -3,6 +3,7 @@
 #include "Resources/BsResources.h"
 #include "Resources/BsResource.h"
 #include "Resources/BsResourceManifest.h"
+#include "Resources/BsResourcePack.h"
 #include "Error/BsException.h"
 #include "Serialization/BsFileSerializer.h"
 #include "FileSystem/BsFileSystem.h"
@@ -20,6 +21,7 @@
 namespace bs
 {
 	Resources::Resources()
+		:mMainThreadId(BS_THREAD_CURRENT_ID)
 	{
 		mDefaultResourceManifest = ResourceManifest::create("Default");
 		mResourceManifests.push_back(mDefaultResourceManifest);
@@ -27,21 +29,43 @@ namespace bs
 
 	Resources::~Resources()
 	{
+		{
+			Lock lock(mLoadQueueMutex);
+			mIOThreadShutDown = true;
+		}
+
+		mLoadQueueCondition.notify_all();
+
+		if (mIOThreadStarted)
+			mIOThread.blockUntilComplete();
+
+		// Loads already read by the I/O thread are still being processed by worker threads, which reference this object
+		{
+			Lock lock(mLoadQueueMutex);
+			while (mNumActiveLoads > 0)
+				mLoadQueueCondition.wait(lock);
+		}
+
+		for (auto& entry : mLoadQueue)
+			bs_delete(entry);
+
+		_update();
 		unloadAll();
 	}
 
 	HResource Resources::load(const Path& filePath, ResourceLoadFlags loadFlags)
 	{
-		if (!FileSystem::isFile(filePath))
+		UUID uuid;
+		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
+
+		// Resources contained in a pack don't need their individual file
+		if ((!foundUUID || findResourcePack(uuid) == nullptr) && !FileSystem::isFile(filePath))
 		{
 			LOGWRN("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
 
 			return HResource();
 		}
 
-		UUID uuid;
-		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
-
 		if (!foundUUID)
 			uuid = UUIDGenerator::generateRandom();
 
@@ -59,20 +83,40 @@ namespace bs
 
 	HResource Resources::loadAsync(const Path& filePath, ResourceLoadFlags loadFlags)
 	{
-		if (!FileSystem::isFile(filePath))
+		UUID uuid;
+		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
+
+		// Resources contained in a pack don't need their individual file
+		if ((!foundUUID || findResourcePack(uuid) == nullptr) && !FileSystem::isFile(filePath))
 		{
 			LOGWRN("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
 
 			return HResource();
 		}
 
+		if (!foundUUID)
+			uuid = UUIDGenerator::generateRandom();
+
+		return loadInternal(uuid, filePath, false, loadFlags);
+	}
+
+	HResource Resources::loadAsync(const Path& filePath, const ASYNC_LOAD_DESC& desc, ResourceLoadFlags loadFlags)
+	{
 		UUID uuid;
 		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
 
+		// Resources contained in a pack don't need their individual file
+		if ((!foundUUID || findResourcePack(uuid) == nullptr) && !FileSystem::isFile(filePath))
+		{
+			LOGWRN("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
+
+			return HResource();
+		}
+
 		if (!foundUUID)
 			uuid = UUIDGenerator::generateRandom();
 
-		return loadInternal(uuid, filePath, false, loadFlags);
+		return loadInternal(uuid, filePath, false, loadFlags, desc);
 	}
 
 	HResource Resources::loadFromUUID(const UUID& uuid, bool async, ResourceLoadFlags loadFlags)
@@ -90,10 +134,30 @@ namespace bs
 		return loadInternal(uuid, filePath, !async, loadFlags);
 	}
 
-	HResource Resources::loadInternal(const UUID& uuid, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags)
+	/** Reads the meta-data of a resource stored in a resource pack, without reading the resource data. */
+	static SPtr<SavedResourceData> readSavedResourceData(const ResourcePack& pack, const UUID& uuid)
+	{
+		UINT32 objectSize = 0;
+		if (pack.readEntry(uuid, 0, &objectSize, sizeof(objectSize)) != sizeof(objectSize))
+			return nullptr;
+
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(objectSize);
+		if (pack.readEntry(uuid, sizeof(objectSize), stream->getPtr(), objectSize) != objectSize)
+			return nullptr;
+
+		BinarySerializer bs;
+		return std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize));
+	}
+
+	HResource Resources::loadInternal(const UUID& uuid, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags,
+		const ASYNC_LOAD_DESC& desc)
 	{
 		HResource outputResource;
 
+		// Resources in a pack are loaded from the pack, even if their individual file exists
+		SPtr<ResourcePack> pack = findResourcePack(uuid);
+		const Path& sourcePath = pack != nullptr ? pack->getPath() : filePath;
+
 		// Retrieve/create resource handle, and register with the system
 		bool loadInProgress = false;
 		bool loadFailed = false;
@@ -155,7 +219,7 @@ namespace bs
 
 			// If we have nowhere to load from, warn and complete load if a file path was provided, otherwise pass through
 			// as we might just want to complete a previously queued load 
-			if (filePath.isEmpty())
+			if (sourcePath.isEmpty())
 			{
 				if (!alreadyLoading)
 				{
@@ -163,7 +227,7 @@ namespace bs
 					loadFailed = true;
 				}
 			}
-			else if (!FileSystem::isFile(filePath))
+			else if (pack == nullptr && !FileSystem::isFile(filePath))
 			{
 				LOGWRN_VERBOSE("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
 				loadFailed = true;
@@ -171,9 +235,11 @@ namespace bs
 
 			if(!loadFailed)
 			{
-				// Load dependency data if a file path is provided
+				// Load dependency data if a file path or a pack is provided
 				SPtr<SavedResourceData> savedResourceData;
-				if (!filePath.isEmpty())
+				if (pack != nullptr)
+					savedResourceData = readSavedResourceData(*pack, uuid);
+				else if (!filePath.isEmpty())
 				{
 					FileDecoder fs(filePath);
 					savedResourceData = std::static_pointer_cast<SavedResourceData>(fs.decode());
@@ -273,7 +339,7 @@ namespace bs
 					}
 				}
 
-				initiateLoad = !alreadyLoading && !filePath.isEmpty();
+				initiateLoad = !alreadyLoading && !sourcePath.isEmpty();
 
 				if(savedResourceData != nullptr)
 					synchronous = synchronous & savedResourceData->allowAsyncLoading();
@@ -282,7 +348,10 @@ namespace bs
 
 		// Previously being loaded as async but now we want it synced, so we wait
 		if (loadInProgress && synchronous)
+		{
+			expediteAsyncLoad(uuid);
 			outputResource.blockUntilLoaded();
+		}
 
 		// Something went wrong, clean up and exit
 		if(loadFailed)
@@ -298,17 +367,12 @@ namespace bs
 			// Synchronous or the resource doesn't support async, read the file immediately
 			if (synchronous)
 			{
-				loadCallback(filePath, outputResource, loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
+				loadCallback(sourcePath, pack, outputResource, loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
 			}
-			else // Asynchronous, read the file on a worker thread
+			else // Asynchronous, read the file on the I/O thread and process it on worker threads
 			{
-				String fileName = filePath.getFilename();
-				String taskName = "Resource load: " + fileName;
-
 				bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
-				SPtr<Task> task = Task::create(taskName, 
-					std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData));
-				TaskScheduler::instance().addTask(task);
+				queueAsyncLoad(sourcePath, pack, outputResource, keepSourceData, desc);
 			}
 		}
 		else
@@ -329,30 +393,81 @@ namespace bs
 				depLoadFlags |= ResourceLoadFlag::KeepSourceData;
 
 			Vector<HResource> dependencies(numDependencies);
+			for (UINT32 i = 0; i < numDependencies; i++)
+			{
+				Path dependencyPath;
+				getFilePathFromUUID(dependenciesToLoad[i], dependencyPath);
+
+				dependencies[i] = loadInternal(dependenciesToLoad[i], dependencyPath, synchronous, depLoadFlags, desc);
+			}
 
-			// Keep dependencies alive until the parent is done loading
+			// Keep dependencies alive until the parent is done loading, as asynchronous loads of resources nothing
+			// references get cancelled. Nothing needs to be kept if the parent already finished loading.
 			{
-				// Note the resource is still guaranteed to be in the in-progress map because it can't be removed until
-				// its dependency count is reduced to zero.
 				Lock inProgressLock(mInProgressResourcesMutex);
-				mInProgressResources[uuid]->dependencies = dependencies;
-			}
 
-			for (UINT32 i = 0; i < numDependencies; i++)
-				dependencies[i] = loadFromUUID(dependenciesToLoad[i], !synchronous, depLoadFlags);
+				auto iterFind = mInProgressResources.find(uuid);
+				if (iterFind != mInProgressResources.end())
+				{
+					Vector<HResource>& loadDependencies = iterFind->second->dependencies;
+					loadDependencies.insert(loadDependencies.end(), dependencies.begin(), dependencies.end());
+				}
+			}
 		}
 
 		return outputResource;
 	}
 
-	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData)
+	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, const SPtr<ResourcePack>& pack, 
+		const UUID& uuid, bool loadWithSaveData)
 	{
-		Lock fileLock = FileScheduler::getLock(filePath);
-
-		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
-		if (stream == nullptr)
+		ResourceFileData fileData;
+		if (!readResourceFile(filePath, pack, uuid, loadWithSaveData, fileData))
 			return nullptr;
 
+		decompressResourceFile(fileData);
+		return deserializeResourceFile(filePath, fileData, loadWithSaveData);
+	}
+
+	bool Resources::readResourceFile(const Path& filePath, const SPtr<ResourcePack>& pack, const UUID& uuid, 
+		bool loadWithSaveData, ResourceFileData& fileData)
+	{
+		Lock fileLock;
+
+		SPtr<DataStream> stream;
+		if (pack != nullptr)
+		{
+			// Entries of mapped packs reference the mapping. Resources loaded with save data are expected to be saved
+			// again, so they get a copy instead to avoid keeping the pack mapped.
+			stream = pack->openEntry(uuid);
+			if (stream == nullptr)
+				return false;
+
+			if (loadWithSaveData && stream->isMapped())
+				stream = bs_shared_ptr_new<MemoryDataStream>(stream);
+		}
+		else
+		{
+			fileLock = FileScheduler::getLock(filePath);
+
+			// Map the file so large data blocks (e.g. vertex and pixel data) can be referenced instead of copied. Resources
+			// loaded with save data are expected to be saved again, so they're read normally to avoid keeping the file
+			// mapped.
+			if (!loadWithSaveData)
+			{
+				SPtr<MappedFileDataStream> mappedStream = bs_shared_ptr_new<MappedFileDataStream>(filePath);
+				if (mappedStream->isOpen())
+					stream = mappedStream;
+			}
+
+			if (stream == nullptr)
+			{
+				stream = FileSystem::openFile(filePath, true);
+				if (stream == nullptr)
+					return false;
+			}
+		}
+
 		if (stream->size() > std::numeric_limits<UINT32>::max())
 		{
 			BS_EXCEPT(InternalErrorException,
@@ -364,32 +479,47 @@ namespace bs
 			params["keepSourceData"] = 1;
 
 		// Read meta-data
-		SPtr<SavedResourceData> metaData;
+		if (!stream->eof())
 		{
-			if (!stream->eof())
-			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
+			UINT32 objectSize = 0;
+			stream->read(&objectSize, sizeof(objectSize));
 
-				BinarySerializer bs;
-				metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
-			}
+			BinarySerializer bs;
+			fileData.metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
 		}
 
+		if (fileData.metaData && !stream->eof())
+			stream->read(&fileData.objectSize, sizeof(fileData.objectSize));
+
+		fileData.stream = stream;
+		return true;
+	}
+
+	void Resources::decompressResourceFile(ResourceFileData& fileData)
+	{
+		if (!fileData.metaData || fileData.stream->eof())
+			return;
+
+		const UINT32 compressionMethod = fileData.metaData->getCompressionMethod();
+		if (compressionMethod == 1)
+			fileData.stream = Compression::decompress(fileData.stream);
+		else if (compressionMethod == 2)
+			fileData.stream = Compression::decompressBlocks(fileData.stream);
+	}
+
+	SPtr<Resource> Resources::deserializeResourceFile(const Path& filePath, ResourceFileData& fileData, 
+		bool loadWithSaveData)
+	{
+		UnorderedMap<String, UINT64> params;
+		if(loadWithSaveData)
+			params["keepSourceData"] = 1;
+
 		// Read resource data
 		SPtr<IReflectable> loadedData;
+		if(fileData.metaData && fileData.stream != nullptr && !fileData.stream->eof())
 		{
-			if(metaData && !stream->eof())
-			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
-
-				if (metaData->getCompressionMethod() != 0)
-					stream = Compression::decompress(stream);
-
-				BinarySerializer bs;
-				loadedData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
-			}
+			BinarySerializer bs;
+			loadedData = bs.decode(fileData.stream, fileData.objectSize, params);
 		}
 
 		if (loadedData == nullptr)
@@ -417,13 +547,23 @@ namespace bs
 				Lock inProgressLock(mInProgressResourcesMutex);
 				auto iterFind2 = mInProgressResources.find(uuid);
 				if (iterFind2 != mInProgressResources.end())
+				{
+					// If the load holds the internal reference, release it right away. If that was the last reference
+					// the asynchronous load gets cancelled once it reaches its next stage.
+					LoadedResourceData& resData = iterFind2->second->resData;
+					if (resData.numInternalRefs > 0)
+					{
+						resData.numInternalRefs--;
+						resource.removeInternalRef();
+						return;
+					}
+
 					loadInProgress = true;
+				}
 			}
 
-			// Technically we should be able to just cancel a load in progress instead of blocking until it finishes.
-			// However that would mean the last reference could get lost on whatever thread did the loading, which
-			// isn't something that's supported. If this ends up being a problem either make handle counting atomic
-			// or add a separate queue for objects destroyed from the load threads.
+			// The resource is loaded but still waiting on its dependencies, and the internal reference is held by the
+			// loaded resource data
 			if (loadInProgress)
 				resource.blockUntilLoaded();
 
@@ -586,7 +726,7 @@ namespace bs
 		for (UINT32 i = 0; i < (UINT32)dependencyList.size(); i++)
 			dependencyUUIDs[i] = dependencyList[i].resource.getUUID();
 
-		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 1 : 0;
+		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 2 : 0;
 		SPtr<SavedResourceData> resourceData = bs_shared_ptr_new<SavedResourceData>(dependencyUUIDs, 
 			resource->allowAsyncLoading(), compressionMethod);
 
@@ -647,10 +787,7 @@ namespace bs
 
 			SPtr<MemoryDataStream> objStream = bs_shared_ptr_new<MemoryDataStream>(bytes, numBytes);
 			if (compressionMethod != 0)
-			{
-				SPtr<DataStream> srcStream = std::static_pointer_cast<DataStream>(objStream);
-				objStream = Compression::compress(srcStream);
-			}
+				objStream = Compression::compressBlocks(objStream, mCompressionOptions);
 
 			stream.write((char*)&numBytes, sizeof(numBytes));
 			stream.write((char*)objStream->getPtr(), objStream->size());
@@ -737,6 +874,31 @@ namespace bs
 		return nullptr;
 	}
 
+	void Resources::registerResourcePack(const SPtr<ResourcePack>& pack)
+	{
+		auto findIter = std::find(mResourcePacks.begin(), mResourcePacks.end(), pack);
+		if(findIter == mResourcePacks.end())
+			mResourcePacks.push_back(pack);
+	}
+
+	void Resources::unregisterResourcePack(const SPtr<ResourcePack>& pack)
+	{
+		auto findIter = std::find(mResourcePacks.begin(), mResourcePacks.end(), pack);
+		if (findIter != mResourcePacks.end())
+			mResourcePacks.erase(findIter);
+	}
+
+	SPtr<ResourcePack> Resources::findResourcePack(const UUID& uuid) const
+	{
+		for(auto iter = mResourcePacks.rbegin(); iter != mResourcePacks.rend(); ++iter) 
+		{
+			if((*iter)->contains(uuid))
+				return *iter;
+		}
+
+		return nullptr;
+	}
+
 	bool Resources::isLoaded(const UUID& uuid, bool checkInProgress)
 	{
 		if (checkInProgress)
@@ -872,6 +1034,7 @@ namespace bs
 		{
 			HResource dependant = dependantLoad->resData.resource.lock();
 			loadComplete(dependant);
+			releaseOnMainThread(dependant);
 		}
 
 		if (finishLoad && myLoadData != nullptr)
@@ -886,9 +1049,10 @@ namespace bs
 		}
 	}
 
-	void Resources::loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData)
+	void Resources::loadCallback(const Path& filePath, const SPtr<ResourcePack>& pack, HResource& resource, 
+		bool loadWithSaveData)
 	{
-		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, loadWithSaveData);
+		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, pack, resource.getUUID(), loadWithSaveData);
 
 		{
 			Lock lock(mInProgressResourcesMutex);
@@ -902,6 +1066,376 @@ namespace bs
 		loadComplete(resource);
 	}
 
+	/** Converts a deadline relative to the current time, in seconds, to an absolute time in microseconds. */
+	static UINT64 getLoadDeadline(float deadline, UINT64 now)
+	{
+		if (!std::isfinite(deadline))
+			return std::numeric_limits<UINT64>::max();
+
+		return now + (UINT64)(std::max(deadline, 0.0f) * 1000000.0f);
+	}
+
+	bool Resources::isLoadedAfter(const AsyncLoadRequest* a, const AsyncLoadRequest* b)
+	{
+		if (a->priority != b->priority)
+			return a->priority < b->priority;
+
+		if (a->deadline != b->deadline)
+			return a->deadline > b->deadline;
+
+		if (a->distance != b->distance)
+			return a->distance > b->distance;
+
+		return a->sequence > b->sequence;
+	}
+
+	void Resources::queueAsyncLoad(const Path& filePath, const SPtr<ResourcePack>& pack, HResource& resource, 
+		bool keepSourceData, const ASYNC_LOAD_DESC& desc)
+	{
+		const UINT64 now = mLoadTimer.getMicroseconds();
+
+		AsyncLoadRequest* request = bs_new<AsyncLoadRequest>();
+		request->resource = resource.getWeak();
+		request->filePath = filePath;
+		request->pack = pack;
+		request->keepSourceData = keepSourceData;
+		request->priority = desc.priority;
+		request->deadline = getLoadDeadline(desc.deadline, now);
+		request->distance = desc.distance;
+		if (pack != nullptr)
+		{
+			// A missing entry fails the load once the I/O thread tries to read it, it just doesn't count towards the budget
+			const ResourcePack::Entry* entry = pack->findEntry(resource.getUUID());
+			request->size = entry != nullptr ? entry->size : 0;
+		}
+		else
+			request->size = FileSystem::getFileSize(filePath);
+
+		request->stageStart = now;
+
+		{
+			Lock lock(mLoadQueueMutex);
+
+			if (!mIOThreadStarted)
+			{
+				mIOThread = ThreadPool::instance().run("ResourceIO", std::bind(&Resources::runIOThread, this));
+				mIOThreadStarted = true;
+			}
+
+			request->sequence = mNextLoadSequence++;
+
+			mLoadQueue.push_back(request);
+			std::push_heap(mLoadQueue.begin(), mLoadQueue.end(), &Resources::isLoadedAfter);
+
+			mQueuedLoads[resource.getUUID()] = request;
+		}
+
+		mLoadQueueCondition.notify_one();
+	}
+
+	void Resources::setLoadPriority(const ResourceHandleBase& resource, const ASYNC_LOAD_DESC& desc)
+	{
+		const UINT64 now = mLoadTimer.getMicroseconds();
+
+		Lock lock(mLoadQueueMutex);
+
+		auto iterFind = mQueuedLoads.find(resource.getUUID());
+		if (iterFind == mQueuedLoads.end())
+			return;
+
+		AsyncLoadRequest* request = iterFind->second;
+		request->priority = desc.priority;
+		request->deadline = getLoadDeadline(desc.deadline, now);
+		request->distance = desc.distance;
+
+		std::make_heap(mLoadQueue.begin(), mLoadQueue.end(), &Resources::isLoadedAfter);
+	}
+
+	void Resources::expediteAsyncLoad(const UUID& uuid)
+	{
+		Lock lock(mLoadQueueMutex);
+
+		auto iterFind = mQueuedLoads.find(uuid);
+		if (iterFind == mQueuedLoads.end())
+			return;
+
+		AsyncLoadRequest* request = iterFind->second;
+		request->priority = std::numeric_limits<INT32>::max();
+		request->deadline = 0;
+
+		std::make_heap(mLoadQueue.begin(), mLoadQueue.end(), &Resources::isLoadedAfter);
+	}
+
+	void Resources::setMaxInFlightBytes(UINT64 bytes)
+	{
+		{
+			Lock lock(mLoadQueueMutex);
+			mMaxInFlightBytes = bytes;
+		}
+
+		mLoadQueueCondition.notify_one();
+	}
+
+	LatencyHistogram Resources::getLoadLatency(ResourceLoadStage stage) const
+	{
+		Lock lock(mLoadLatencyMutex);
+		return mLoadLatencies[(UINT32)stage];
+	}
+
+	void Resources::clearLoadLatencies()
+	{
+		Lock lock(mLoadLatencyMutex);
+
+		for (auto& entry : mLoadLatencies)
+			entry.clear();
+	}
+
+	void Resources::runIOThread()
+	{
+		while (true)
+		{
+			AsyncLoadRequest* request = nullptr;
+			{
+				Lock lock(mLoadQueueMutex);
+
+				// Wait until the next load fits in the in-flight budget. A file larger than the budget is allowed through
+				// once nothing else is in flight, otherwise it would never be loaded.
+				while (!mIOThreadShutDown)
+				{
+					if (!mLoadQueue.empty())
+					{
+						const UINT64 size = mLoadQueue.front()->size;
+						if (mInFlightBytes == 0 || mInFlightBytes + size <= mMaxInFlightBytes)
+							break;
+					}
+
+					mLoadQueueCondition.wait(lock);
+				}
+
+				if (mIOThreadShutDown)
+					break;
+
+				std::pop_heap(mLoadQueue.begin(), mLoadQueue.end(), &Resources::isLoadedAfter);
+				request = mLoadQueue.back();
+				mLoadQueue.pop_back();
+
+				mQueuedLoads.erase(request->resource.getUUID());
+				mInFlightBytes += request->size;
+				mNumActiveLoads++;
+			}
+
+			recordLoadStage(request, ResourceLoadStage::Queue);
+
+			if (cancelAsyncLoadIfUnused(request))
+				continue;
+
+			const UUID uuid = request->resource.getUUID();
+			if (!readResourceFile(request->filePath, request->pack, uuid, request->keepSourceData, request->fileData))
+			{
+				finishAsyncLoad(request, nullptr);
+				continue;
+			}
+
+			// Mapped files are only read once their pages are accessed. Touch every page so the reads happen here, 
+			// instead of stalling the worker threads in the later stages.
+			const SPtr<DataStream>& stream = request->fileData.stream;
+			if (stream->isMapped())
+			{
+				const UINT8* data = std::static_pointer_cast<MemoryDataStream>(stream)->getPtr();
+
+				UINT8 checksum = 0;
+				for (size_t i = stream->tell(); i < stream->size(); i += 4096)
+					checksum += data[i];
+
+				volatile UINT8 sink = checksum;
+				(void)sink;
+			}
+
+			recordLoadStage(request, ResourceLoadStage::Read);
+
+			const String& fileName = request->filePath.getFilename();
+			SPtr<Task> task;
+			if (request->fileData.metaData && request->fileData.metaData->getCompressionMethod() != 0)
+			{
+				task = Task::create("Resource decompress: " + fileName, 
+					std::bind(&Resources::decompressAsyncLoad, this, request));
+			}
+			else
+			{
+				task = Task::create("Resource deserialize: " + fileName, 
+					std::bind(&Resources::deserializeAsyncLoad, this, request));
+			}
+
+			TaskScheduler::instance().addTask(task);
+		}
+	}
+
+	void Resources::decompressAsyncLoad(AsyncLoadRequest* request)
+	{
+		if (cancelAsyncLoadIfUnused(request))
+			return;
+
+		decompressResourceFile(request->fileData);
+		recordLoadStage(request, ResourceLoadStage::Decompress);
+
+		SPtr<Task> task = Task::create("Resource deserialize: " + request->filePath.getFilename(), 
+			std::bind(&Resources::deserializeAsyncLoad, this, request));
+		TaskScheduler::instance().addTask(task);
+	}
+
+	void Resources::deserializeAsyncLoad(AsyncLoadRequest* request)
+	{
+		if (cancelAsyncLoadIfUnused(request))
+			return;
+
+		SPtr<Resource> resource = deserializeResourceFile(request->filePath, request->fileData, 
+			request->keepSourceData);
+		recordLoadStage(request, ResourceLoadStage::Deserialize);
+
+		finishAsyncLoad(request, resource);
+	}
+
+	bool Resources::cancelAsyncLoadIfUnused(AsyncLoadRequest* request)
+	{
+		{
+			Lock lock(mInProgressResourcesMutex);
+			if (!tryCancelAsyncLoad(request, nullptr))
+				return false;
+		}
+
+		endAsyncLoad(request);
+		return true;
+	}
+
+	void Resources::finishAsyncLoad(AsyncLoadRequest* request, const SPtr<Resource>& resource)
+	{
+		bool cancelled = false;
+		{
+			Lock lock(mInProgressResourcesMutex);
+
+			// The resource could have lost its last reference while it was being deserialized
+			cancelled = tryCancelAsyncLoad(request, resource);
+			if (!cancelled)
+			{
+				ResourceLoadData* myLoadData = mInProgressResources[request->resource.getUUID()];
+				myLoadData->loadedData = resource;
+				myLoadData->remainingDependencies--;
+			}
+		}
+
+		if (cancelled)
+		{
+			endAsyncLoad(request);
+			return;
+		}
+
+		HResource handle = request->resource.lock();
+		loadComplete(handle);
+		releaseOnMainThread(handle);
+
+		endAsyncLoad(request);
+	}
+
+	bool Resources::tryCancelAsyncLoad(AsyncLoadRequest* request, const SPtr<Resource>& resource)
+	{
+		// References to resources being loaded are only handed out while holding mInProgressResourcesMutex, so once the
+		// load is removed below any new request for the resource starts a new load, instead of waiting on this one. The
+		// only exception is WeakResourceHandle::lock() called by the user, which can't revive a cancelled load (see its
+		// documentation). Acquire pairs with the release in ResourceHandle::releaseRef(), so the decision is made on the
+		// latest count.
+		const UUID& uuid = request->resource.getUUID();
+		const UINT32 refCount = request->resource.getHandleData()->mRefCount.load(std::memory_order_acquire);
+		if (refCount > 0 || mDependantLoads.find(uuid) != mDependantLoads.end())
+			return false;
+
+		auto iterFind = mInProgressResources.find(uuid);
+		ResourceLoadData* loadData = iterFind->second;
+		mInProgressResources.erase(iterFind);
+
+		// Dependencies that are still loading must not notify the cancelled load once they finish
+		for (auto& dependency : loadData->dependencies)
+		{
+			auto iterFind2 = mDependantLoads.find(dependency.getUUID());
+			if (iterFind2 == mDependantLoads.end())
+				continue;
+
+			Vector<ResourceLoadData*>& dependantLoads = iterFind2->second;
+			dependantLoads.erase(std::remove(dependantLoads.begin(), dependantLoads.end(), loadData), 
+				dependantLoads.end());
+
+			if (dependantLoads.empty())
+				mDependantLoads.erase(iterFind2);
+		}
+
+		// Releasing the dependencies cancels their loads as well, unless something else references them. Releasing the
+		// last reference to a loaded dependency destroys it, so it must happen on the main thread.
+		{
+			Lock lock(mPendingReleaseMutex);
+
+			for (auto& dependency : loadData->dependencies)
+				mPendingReleaseHandles.push_back(dependency);
+
+			if (resource != nullptr)
+				mPendingDestroyResources.push_back(resource);
+		}
+
+		bs_delete(loadData);
+		return true;
+	}
+
+	void Resources::endAsyncLoad(AsyncLoadRequest* request)
+	{
+		const UINT64 size = request->size;
+		bs_delete(request);
+
+		// Notify while holding the lock, as the destructor can run as soon as the last load is done
+		Lock lock(mLoadQueueMutex);
+		mInFlightBytes -= size;
+		mNumActiveLoads--;
+
+		mLoadQueueCondition.notify_all();
+	}
+
+	void Resources::releaseOnMainThread(HResource& handle)
+	{
+		if (BS_THREAD_CURRENT_ID != mMainThreadId)
+		{
+			Lock lock(mPendingReleaseMutex);
+			mPendingReleaseHandles.push_back(handle);
+		}
+
+		handle = nullptr;
+	}
+
+	void Resources::_update()
+	{
+		Vector<HResource> handles;
+		Vector<SPtr<Resource>> resources;
+		{
+			Lock lock(mPendingReleaseMutex);
+			std::swap(handles, mPendingReleaseHandles);
+			std::swap(resources, mPendingDestroyResources);
+		}
+
+		// Resources of cancelled loads were never registered, so they are destroyed directly
+		for (auto& resource : resources)
+			resource->destroy();
+
+		// Handles are released when they go out of scope, destroying any resources that lost their last reference
+	}
+
+	void Resources::recordLoadStage(AsyncLoadRequest* request, ResourceLoadStage stage)
+	{
+		const UINT64 now = mLoadTimer.getMicroseconds();
+
+		{
+			Lock lock(mLoadLatencyMutex);
+			mLoadLatencies[(UINT32)stage].addSample(now - request->stageStart);
+		}
+
+		request->stageStart = now;
+	}
+
 	BS_CORE_EXPORT Resources& gResources()
 	{
 		return Resources::instance();
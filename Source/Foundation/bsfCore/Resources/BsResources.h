@@ -4,6 +4,10 @@
 
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
+#include "Utility/BsCompression.h"
+#include "Utility/BsTimer.h"
+#include "Threading/BsThreadPool.h"
+#include "Profiling/BsLatencyHistogram.h"
 
 namespace bs
 {
@@ -39,6 +43,41 @@ namespace bs
 	typedef Flags<ResourceLoadFlag> ResourceLoadFlags;
 	BS_FLAGS_OPERATORS(ResourceLoadFlag);
 
+	/**
+	 * Hints that determine the order in which asynchronous resource loads are started. Loads are ordered by priority
+	 * first, then by deadline and finally by distance.
+	 */
+	struct ASYNC_LOAD_DESC
+	{
+		/** Loads with higher priority are started before loads with lower priority, regardless of other hints. */
+		INT32 priority = 0;
+
+		/** Time in seconds, relative to when the load was requested, by which the resource is needed. */
+		float deadline = std::numeric_limits<float>::infinity();
+
+		/** Distance from the viewer to the closest object that requires the resource. */
+		float distance = std::numeric_limits<float>::infinity();
+	};
+
+	/** Stages an asynchronous resource load goes through. */
+	enum class ResourceLoadStage
+	{
+		/** Waiting to be picked up by the I/O thread, including the time spent waiting for the in-flight budget. */
+		Queue,
+		/** Reading the file from the disk, on the I/O thread. */
+		Read,
+		/** Decompressing the resource data on a worker thread, including the time spent waiting for a free worker. */
+		Decompress,
+		/**
+		 * Deserializing the resource from its data on a worker thread, including the time spent waiting for a free
+		 * worker.
+		 */
+		Deserialize,
+		Count // Keep at end
+	};
+
+	class SavedResourceData;
+
 	/**
 	 * Manager for dealing with all engine resources. It allows you to save new resources and load existing ones.
 	 *
@@ -124,13 +163,56 @@ namespace bs
 		 */
 		HResource loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default);
 
-		/** @copydoc loadAsync */
+		/** @copydoc loadAsync(const Path&, ResourceLoadFlags) */
 		template <class T>
 		ResourceHandle<T> loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default)
 		{
 			return static_resource_cast<T>(loadAsync(filePath, loadFlags));
 		}
 
+		/**
+		 * Loads the resource asynchronously, using the provided hints to determine when the load is started relative to
+		 * other asynchronous loads. Dependencies of the resource are loaded using the same hints.
+		 *
+		 * @param[in]	filePath	Full pathname of the file.
+		 * @param[in]	desc		Hints determining the order in which the loads are started.
+		 * @param[in]	loadFlags	Flags used to control the load process.
+		 *
+		 * @see		loadAsync(const Path&, ResourceLoadFlags)
+		 */
+		HResource loadAsync(const Path& filePath, const ASYNC_LOAD_DESC& desc,
+			ResourceLoadFlags loadFlags = ResourceLoadFlag::Default);
+
+		/** @copydoc loadAsync(const Path&, const ASYNC_LOAD_DESC&, ResourceLoadFlags) */
+		template <class T>
+		ResourceHandle<T> loadAsync(const Path& filePath, const ASYNC_LOAD_DESC& desc,
+			ResourceLoadFlags loadFlags = ResourceLoadFlag::Default)
+		{
+			return static_resource_cast<T>(loadAsync(filePath, desc, loadFlags));
+		}
+
+		/**
+		 * Changes the hints of an asynchronous load. Has no effect if the load was already started, or if the resource
+		 * isn't being loaded asynchronously.
+		 */
+		void setLoadPriority(const ResourceHandleBase& resource, const ASYNC_LOAD_DESC& desc);
+
+		/**
+		 * Sets the maximum number of bytes of resource files that can be read from the disk while their resources haven't
+		 * finished loading. Once reached the I/O thread waits for the in-flight loads to complete before reading more.
+		 * A single file larger than the limit is still read once no other loads are in flight.
+		 */
+		void setMaxInFlightBytes(UINT64 bytes);
+
+		/** @copydoc setMaxInFlightBytes */
+		UINT64 getMaxInFlightBytes() const { return mMaxInFlightBytes; }
+
+		/** Returns the distribution of time asynchronous loads spent in the specified stage. */
+		LatencyHistogram getLoadLatency(ResourceLoadStage stage) const;
+
+		/** Clears the latencies recorded for all asynchronous load stages. */
+		void clearLoadLatencies();
+
 		/**
 		 * Loads the resource with the given UUID. Returns an empty handle if resource can't be loaded.
 		 *
@@ -152,6 +234,10 @@ namespace bs
 		 * unloaded.
 		 *			
 		 * @param[in]	resource	Handle of the resource to release.
+		 *
+		 * @note
+		 * If the resource is being loaded asynchronously and no references to it remain after the release, the load is
+		 * cancelled.
 		 */
 		void release(ResourceHandleBase& resource);
 
@@ -201,6 +287,16 @@ namespace bs
 		 */
 		void save(const HResource& resource, bool compress = false);
 
+		/**
+		 * Determines how are resources compressed when saved with compression enabled. Data is split into blocks that are
+		 * compressed and decompressed in parallel, using the codec and the compression level specified by the options.
+		 * Resources saved with different options can be loaded regardless of the current options.
+		 */
+		void setCompressionOptions(const COMPRESSION_DESC& options) { mCompressionOptions = options; }
+
+		/** @copydoc setCompressionOptions */
+		const COMPRESSION_DESC& getCompressionOptions() const { return mCompressionOptions; }
+
 		/**
 		 * Updates an existing resource handle with a new resource. Caller must ensure that new resource type matches the 
 		 * original resource type.
@@ -251,6 +347,18 @@ namespace bs
 		 */
 		SPtr<ResourceManifest> getResourceManifest(const String& name) const;
 
+		/**
+		 * Registers a resource pack. Resources contained in the pack are loaded from it instead of their individual
+		 * files, regardless if they're loaded by UUID, by path or as dependencies. If multiple packs contain the same
+		 * resource, packs registered later take priority.
+		 *
+		 * @see		ResourcePack
+		 */
+		void registerResourcePack(const SPtr<ResourcePack>& pack);
+
+		/**	Unregisters a resource pack previously registered with registerResourcePack(). */
+		void unregisterResourcePack(const SPtr<ResourcePack>& pack);
+
 		/** Attempts to retrieve file path from the provided UUID. Returns true if successful, false otherwise. */
 		bool getFilePathFromUUID(const UUID& uuid, Path& filePath) const;
 
@@ -302,25 +410,133 @@ namespace bs
 		/** Returns an existing handle for the specified UUID if one exists, or creates a new one. */
 		HResource _getResourceHandle(const UUID& uuid);
 
+		/** 
+		 * Releases the resources and handles left over by asynchronous loads that were completed or cancelled on worker
+		 * threads. Must be called on the main thread, once per frame.
+		 */
+		void _update();
+
 		/** @} */
 	private:
 		friend class ResourceHandleBase;
 
+		/** Contents of a resource file, passed between the load stages. */
+		struct ResourceFileData
+		{
+			SPtr<DataStream> stream;
+			SPtr<SavedResourceData> metaData;
+			UINT32 objectSize = 0;
+		};
+
+		/** Asynchronous resource load, waiting in the load queue or being processed by one of the load stages. */
+		struct AsyncLoadRequest
+		{
+			WeakResourceHandle<Resource> resource;
+			Path filePath;
+			SPtr<ResourcePack> pack;
+			bool keepSourceData = false;
+
+			INT32 priority = 0;
+			UINT64 deadline = 0;
+			float distance = 0.0f;
+			UINT64 sequence = 0;
+
+			UINT64 size = 0;
+			UINT64 stageStart = 0;
+			ResourceFileData fileData;
+		};
+
+		/** Returns true if request @p a should be started after request @p b. */
+		static bool isLoadedAfter(const AsyncLoadRequest* a, const AsyncLoadRequest* b);
+
 		/**
 		 * Starts resource loading or returns an already loaded resource. Both UUID and filePath must match the	same 
 		 * resource, although you may provide an empty path in which case the resource will be retrieved from memory if its
 		 * currently loaded.
 		 */
-		HResource loadInternal(const UUID& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags);
+		HResource loadInternal(const UUID& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags,
+			const ASYNC_LOAD_DESC& desc = ASYNC_LOAD_DESC());
+
+		/**
+		 * Performs actually reading and deserializing of the resource file, or of the resource entry if a pack is
+		 * provided. Called from various worker threads.
+		 */
+		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, const SPtr<ResourcePack>& pack, const UUID& uuid,
+			bool loadWithSaveData);
+
+		/**
+		 * Opens the resource file, or the resource entry if a pack is provided, and reads its meta-data, leaving the
+		 * stream at the start of the resource data. Returns false if the file cannot be opened.
+		 */
+		bool readResourceFile(const Path& filePath, const SPtr<ResourcePack>& pack, const UUID& uuid, 
+			bool loadWithSaveData, ResourceFileData& fileData);
+
+		/** Decompresses the resource data read by readResourceFile(), if it is compressed. */
+		void decompressResourceFile(ResourceFileData& fileData);
+
+		/** Deserializes the resource from the data read by readResourceFile(). Returns null on failure. */
+		SPtr<Resource> deserializeResourceFile(const Path& filePath, ResourceFileData& fileData, bool loadWithSaveData);
 
-		/** Performs actually reading and deserializing of the resource file. Called from various worker threads. */
-		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData);
+		/** Adds an asynchronous load to the load queue, starting the I/O thread if it isn't running. */
+		void queueAsyncLoad(const Path& filePath, const SPtr<ResourcePack>& pack, HResource& resource, bool keepSourceData,
+			const ASYNC_LOAD_DESC& desc);
+
+		/** Returns the most recently registered resource pack containing the resource, or null if there is none. */
+		SPtr<ResourcePack> findResourcePack(const UUID& uuid) const;
+
+		/** Moves a queued load in front of all other queued loads, as something is blocked waiting on it. */
+		void expediteAsyncLoad(const UUID& uuid);
+
+		/**
+		 * Reads queued resource files in order of their priority, while the in-flight data is under budget, and passes
+		 * them on to the decompression stage. Runs on the I/O thread.
+		 */
+		void runIOThread();
+
+		/** Decompresses the data of an asynchronous load and passes it on to the deserialization stage. */
+		void decompressAsyncLoad(AsyncLoadRequest* request);
+
+		/** Deserializes the resource of an asynchronous load and completes the load. */
+		void deserializeAsyncLoad(AsyncLoadRequest* request);
+
+		/**
+		 * Checks if nothing references the resource of an asynchronous load anymore. If so, the load is cancelled, the
+		 * request is freed and true is returned.
+		 */
+		bool cancelAsyncLoadIfUnused(AsyncLoadRequest* request);
+
+		/** 
+		 * Completes an asynchronous load with the provided resource (or null if the load failed) and frees the request.
+		 * The load is cancelled instead if nothing references the resource anymore.
+		 */
+		void finishAsyncLoad(AsyncLoadRequest* request, const SPtr<Resource>& resource);
+
+		/**
+		 * Cancels an asynchronous load if nothing references its resource and no other load depends on it. The load is
+		 * removed from the in-progress loads right away, so a new request for the resource starts a new load. The
+		 * provided resource (if any) and the dependencies of the load are handed to the main thread for release. Must be
+		 * called while holding mInProgressResourcesMutex. Returns true if the load was cancelled.
+		 */
+		bool tryCancelAsyncLoad(AsyncLoadRequest* request, const SPtr<Resource>& resource);
+
+		/** Frees an asynchronous load request, and removes it from the loads in flight. */
+		void endAsyncLoad(AsyncLoadRequest* request);
+
+		/** 
+		 * Releases a resource handle. If called from a worker thread the release is deferred to the main thread, in case
+		 * it's the last reference to the resource and the resource needs to be destroyed.
+		 */
+		void releaseOnMainThread(HResource& handle);
+
+		/** Records the time a request spent in a load stage, and starts timing the next stage. */
+		void recordLoadStage(AsyncLoadRequest* request, ResourceLoadStage stage);
 
 		/**	Triggered when individual resource has finished loading. */
 		void loadComplete(HResource& resource);
 
 		/**	Callback triggered when the task manager is ready to process the loading task. */
-		void loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData);
+		void loadCallback(const Path& filePath, const SPtr<ResourcePack>& pack, HResource& resource, 
+			bool loadWithSaveData);
 
 		/**	Destroys a resource, freeing its memory. */
 		void destroy(ResourceHandleBase& resource);
@@ -328,6 +544,8 @@ namespace bs
 	private:
 		Vector<SPtr<ResourceManifest>> mResourceManifests;
 		SPtr<ResourceManifest> mDefaultResourceManifest;
+		Vector<SPtr<ResourcePack>> mResourcePacks;
+		COMPRESSION_DESC mCompressionOptions;
 
 		Mutex mInProgressResourcesMutex;
 		Mutex mLoadedResourceMutex;
@@ -337,6 +555,30 @@ namespace bs
 		UnorderedMap<UUID, LoadedResourceData> mLoadedResources;
 		UnorderedMap<UUID, ResourceLoadData*> mInProgressResources; // Resources that are being asynchronously loaded
 		UnorderedMap<UUID, Vector<ResourceLoadData*>> mDependantLoads; // Allows dependency to be notified when a dependant is loaded
+
+		// Asynchronous load pipeline
+		HThread mIOThread;
+		bool mIOThreadStarted = false;
+		bool mIOThreadShutDown = false;
+
+		Vector<AsyncLoadRequest*> mLoadQueue; // Heap ordered by isLoadedAfter()
+		UnorderedMap<UUID, AsyncLoadRequest*> mQueuedLoads;
+		UINT64 mNextLoadSequence = 0;
+		UINT64 mInFlightBytes = 0;
+		UINT64 mMaxInFlightBytes = 64 * 1024 * 1024;
+		UINT32 mNumActiveLoads = 0; // Loads picked up by the I/O thread that haven't finished yet
+		mutable Mutex mLoadQueueMutex;
+		Signal mLoadQueueCondition;
+
+		Timer mLoadTimer;
+		LatencyHistogram mLoadLatencies[(UINT32)ResourceLoadStage::Count];
+		mutable Mutex mLoadLatencyMutex;
+
+		// Released by the main thread, as releasing them could destroy resources
+		ThreadId mMainThreadId;
+		Vector<HResource> mPendingReleaseHandles;
+		Vector<SPtr<Resource>> mPendingDestroyResources;
+		Mutex mPendingReleaseMutex;
 	};
 
 	/** Provides easier access to Resources manager. */
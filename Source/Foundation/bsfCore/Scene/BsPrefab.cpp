@@ -77,6 +77,7 @@ namespace bs
 
 		mRoot = sceneObject->clone(false);
 		mRoot->mParent = nullptr;
+		mRoot->updateTransformStorageParent();
 		mRoot->mLinkId = -1;
 
 		// Remove objects with "dont save" flag
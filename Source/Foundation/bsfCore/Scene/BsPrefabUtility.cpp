@@ -32,6 +32,7 @@ namespace bs
 		// Remove default parent, and replace with original one
 		newInstance->mParent->removeChild(newInstance);
 		newInstance->mParent = parent;
+		newInstance->updateTransformStorageParent();
 
 		restoreLinkedInstanceData(newInstance, soProxy, linkedInstanceData);
 	}
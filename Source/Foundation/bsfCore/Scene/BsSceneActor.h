@@ -107,6 +107,7 @@ namespace bs
 		ObjectMobility mMobility;
 		bool mActive;
 		UINT32 mHash;
+		UINT32 mBoundActorIdx;
 	};
 
 	/** @} */
@@ -11,6 +11,7 @@
 #include "RenderAPI/BsRenderTarget.h"
 #include "Renderer/BsLightProbeVolume.h"
 #include "Scene/BsSceneActor.h"
+#include "Scene/BsTransformStorage.h"
 
 namespace bs
 {
@@ -87,19 +88,73 @@ namespace bs
 
 	void SceneManager::_bindActor(const SPtr<SceneActor>& actor, const HSceneObject& so)
 	{
-		mBoundActors[actor.get()] = BoundActorData(actor, so);
+		if (actor->mBoundActorIdx != (UINT32)-1)
+			_unbindActor(actor);
+
+		const UINT32 idx = (UINT32)mBoundActors.size();
+		mBoundActors.push_back(BoundActorData(actor, so));
+		actor->mBoundActorIdx = idx;
+
+		// Insert at the start of the scene object's list
+		BoundActorData& entry = mBoundActors.back();
+		entry.nextForSO = so->mFirstBoundActor;
+
+		if (entry.nextForSO != (UINT32)-1)
+			mBoundActors[entry.nextForSO].prevForSO = idx;
+
+		so->mFirstBoundActor = idx;
+
+		// Actor needs to receive the current state of the scene object
+		entry.dirtyIdx = (UINT32)mDirtyActors.size();
+		mDirtyActors.push_back(idx);
 	}
 
 	void SceneManager::_unbindActor(const SPtr<SceneActor>& actor)
 	{
-		mBoundActors.erase(actor.get());
+		const UINT32 idx = actor->mBoundActorIdx;
+		if (idx == (UINT32)-1)
+			return;
+
+		unlinkBoundActor(idx);
+
+		const UINT32 dirtyIdx = mBoundActors[idx].dirtyIdx;
+		if (dirtyIdx != (UINT32)-1)
+		{
+			const UINT32 lastDirtyIdx = mDirtyActors.back();
+			mDirtyActors[dirtyIdx] = lastDirtyIdx;
+			mBoundActors[lastDirtyIdx].dirtyIdx = dirtyIdx;
+			mDirtyActors.pop_back();
+		}
+
+		// Move the last actor in place of the removed one, and update everything referencing it
+		const UINT32 lastIdx = (UINT32)mBoundActors.size() - 1;
+		if (idx != lastIdx)
+		{
+			BoundActorData& last = mBoundActors[lastIdx];
+
+			if (last.prevForSO != (UINT32)-1)
+				mBoundActors[last.prevForSO].nextForSO = idx;
+			else if (!last.so.isDestroyed())
+				last.so->mFirstBoundActor = idx;
+
+			if (last.nextForSO != (UINT32)-1)
+				mBoundActors[last.nextForSO].prevForSO = idx;
+
+			if (last.dirtyIdx != (UINT32)-1)
+				mDirtyActors[last.dirtyIdx] = idx;
+
+			last.actor->mBoundActorIdx = idx;
+			mBoundActors[idx] = std::move(last);
+		}
+
+		mBoundActors.pop_back();
+		actor->mBoundActorIdx = (UINT32)-1;
 	}
 
 	HSceneObject SceneManager::_getActorSO(const SPtr<SceneActor>& actor) const
 	{
-		auto iterFind = mBoundActors.find(actor.get());
-		if (iterFind != mBoundActors.end())
-			return iterFind->second.so;
+		if (actor->mBoundActorIdx != (UINT32)-1)
+			return mBoundActors[actor->mBoundActorIdx].so;
 
 		return HSceneObject();		
 	}
@@ -151,8 +206,48 @@ namespace bs
 
 	void SceneManager::_updateCoreObjectTransforms()
 	{
-		for (auto& entry : mBoundActors)
-			entry.second.actor->_updateState(*entry.second.so);
+		if (TransformStorage::isStarted())
+			TransformStorage::instance().update();
+
+		for (auto& idx : mDirtyActors)
+		{
+			BoundActorData& entry = mBoundActors[idx];
+			entry.dirtyIdx = (UINT32)-1;
+
+			if (!entry.so.isDestroyed())
+				entry.actor->_updateState(*entry.so);
+		}
+
+		mDirtyActors.clear();
+	}
+
+	void SceneManager::markBoundActorsDirty(UINT32 firstActorIdx)
+	{
+		for (UINT32 idx = firstActorIdx; idx != (UINT32)-1; idx = mBoundActors[idx].nextForSO)
+		{
+			BoundActorData& entry = mBoundActors[idx];
+			if (entry.dirtyIdx != (UINT32)-1)
+				continue;
+
+			entry.dirtyIdx = (UINT32)mDirtyActors.size();
+			mDirtyActors.push_back(idx);
+		}
+	}
+
+	void SceneManager::unlinkBoundActor(UINT32 idx)
+	{
+		BoundActorData& entry = mBoundActors[idx];
+
+		if (entry.prevForSO != (UINT32)-1)
+			mBoundActors[entry.prevForSO].nextForSO = entry.nextForSO;
+		else if (!entry.so.isDestroyed())
+			entry.so->mFirstBoundActor = entry.nextForSO;
+
+		if (entry.nextForSO != (UINT32)-1)
+			mBoundActors[entry.nextForSO].prevForSO = entry.prevForSO;
+
+		entry.prevForSO = (UINT32)-1;
+		entry.nextForSO = (UINT32)-1;
 	}
 
 	SPtr<Camera> SceneManager::getMainCamera() const
@@ -14,7 +14,10 @@ namespace bs
 	 *  @{
 	 */
 
-	/** Information about a scene actor and the scene object it has been bound to. */
+	/** 
+	 * Information about a scene actor and the scene object it has been bound to. Actors bound to the same scene object
+	 * form a linked list, starting at the scene object.
+	 */
 	struct BoundActorData
 	{
 		BoundActorData() { }
@@ -25,6 +28,9 @@ namespace bs
 
 		SPtr<SceneActor> actor;
 		HSceneObject so;
+		UINT32 prevForSO = (UINT32)-1; /**< Index of the previous actor bound to the same scene object, if any. */
+		UINT32 nextForSO = (UINT32)-1; /**< Index of the next actor bound to the same scene object, if any. */
+		UINT32 dirtyIdx = (UINT32)-1; /**< Position of the actor in the dirty list, or -1 if it isn't dirty. */
 	};
 
 	/** Possible states components can be in. Controls which component callbacks are triggered. */
@@ -94,8 +100,8 @@ namespace bs
 		void setMainRenderTarget(const SPtr<RenderTarget>& rt);
 
 		/** 
-		 * Binds a scene actor with a scene object. Every frame the scene object's transform will be monitored for
-		 * changes and those changes will be automatically transfered to the actor. 
+		 * Binds a scene actor with a scene object. Whenever the scene object's transform, active state or mobility 
+		 * changes, the changes will be automatically transfered to the actor on the next _updateCoreObjectTransforms().
 		 */
 		void _bindActor(const SPtr<SceneActor>& actor, const HSceneObject& so);
 
@@ -120,7 +126,10 @@ namespace bs
 		/** Called at fixed time internals. Calls the fixed update method on all active components. */
 		void _fixedUpdate();
 
-		/** Updates dirty transforms on any core objects that may be tied with scene objects. */
+		/** 
+		 * Updates dirty transforms on any core objects that may be tied with scene objects. Only actors whose scene 
+		 * objects changed since the last call are updated.
+		 */
 		void _updateCoreObjectTransforms();
 
 		/** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
@@ -160,6 +169,16 @@ namespace bs
 		/**	Callback that is triggered when the main render target size is changed. */
 		void onMainRenderTargetResized();
 
+		/** 
+		 * Queues all actors bound to a scene object for an update.
+		 *
+		 * @param[in]	firstActorIdx	Index of the first actor bound to the scene object, as stored by the scene object.
+		 */
+		void markBoundActorsDirty(UINT32 firstActorIdx);
+
+		/** Removes the actor at the specified index from the list of actors bound to its scene object. */
+		void unlinkBoundActor(UINT32 idx);
+
 		/** Removes a component from the active component list. */
 		void removeFromActiveList(const HComponent& component);
 
@@ -184,7 +203,8 @@ namespace bs
 	protected:
 		HSceneObject mRootNode;
 
-		UnorderedMap<SceneActor*, BoundActorData> mBoundActors;
+		Vector<BoundActorData> mBoundActors;
+		Vector<UINT32> mDirtyActors;
 		UnorderedMap<Camera*, SPtr<Camera>> mCameras;
 		Vector<SPtr<Camera>> mMainCameras;
 
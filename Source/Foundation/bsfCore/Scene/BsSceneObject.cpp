@@ -9,6 +9,7 @@
 #include "Serialization/BsMemorySerializer.h"
 #include "Scene/BsGameObjectManager.h"
 #include "Scene/BsPrefabUtility.h"
+#include "Scene/BsTransformStorage.h"
 #include "Math/BsMatrix3.h"
 #include "BsCoreApplication.h"
 
@@ -16,10 +17,16 @@ namespace bs
 {
 	SceneObject::SceneObject(const String& name, UINT32 flags)
 		: GameObject(), mPrefabHash(0), mFlags(flags), mCachedLocalTfrm(Matrix4::IDENTITY)
-		, mCachedWorldTfrm(Matrix4::IDENTITY), mDirtyFlags(0xFFFFFFFF), mDirtyHash(0), mActiveSelf(true)
+		, mCachedWorldTfrm(Matrix4::IDENTITY), mDirtyFlags(0xFFFFFFFF), mDirtyHash(0)
+		, mTransformId(TransformStorage::INVALID_ID), mFirstBoundActor((UINT32)-1), mActiveSelf(true)
 		, mActiveHierarchy(true), mMobility(ObjectMobility::Movable)
 	{
 		setName(name);
+
+		// Objects that aren't instantiated can be created outside of the sim thread (e.g. when loading prefabs), so they
+		// are added to the transform storage once they are instantiated or parented to an object in the storage
+		if (TransformStorage::isStarted() && (flags & SOF_DontInstantiate) == 0)
+			mTransformId = TransformStorage::instance().registerObject(this);
 	}
 
 	SceneObject::~SceneObject()
@@ -29,6 +36,9 @@ namespace bs
 			LOGWRN("Object is being deleted without being destroyed first? " + mName);
 			destroyInternal(mThisHandle, true);
 		}
+
+		if (isInTransformStorage())
+			TransformStorage::instance().unregisterObject(mTransformId);
 	}
 
 	HSceneObject SceneObject::create(const String& name, UINT32 flags)
@@ -98,6 +108,8 @@ namespace bs
 				mComponents.erase(mComponents.end() - 1);
 			}
 
+			detachTransformStorage();
+
 			GameObjectManager::instance().unregisterObject(handle);
 		}
 		else
@@ -199,6 +211,9 @@ namespace bs
 		{
 			obj->mFlags &= ~SOF_DontInstantiate;
 
+			if (!obj->isInTransformStorage())
+				obj->updateTransformStorageParent();
+
 			if (obj->mParent == nullptr)
 				gSceneManager().registerNewSO(obj->mThisHandle);
 
@@ -300,6 +315,12 @@ namespace bs
 
 	const Transform& SceneObject::getTransform() const
 	{ 
+		if (isInTransformStorage())
+		{
+			mWorldTfrm = TransformStorage::instance().getWorldTransform(mTransformId);
+			return mWorldTfrm;
+		}
+
 		if (!isCachedWorldTfrmUpToDate())
 			updateWorldTfrm();
 
@@ -319,6 +340,12 @@ namespace bs
 
 	const Matrix4& SceneObject::getWorldMatrix() const
 	{
+		if (isInTransformStorage())
+		{
+			mCachedWorldTfrm = TransformStorage::instance().getWorldMatrix(mTransformId);
+			return mCachedWorldTfrm;
+		}
+
 		if (!isCachedWorldTfrmUpToDate())
 			updateWorldTfrm();
 
@@ -327,10 +354,7 @@ namespace bs
 
 	Matrix4 SceneObject::getInvWorldMatrix() const
 	{
-		if (!isCachedWorldTfrmUpToDate())
-			updateWorldTfrm();
-
-		Matrix4 worldToLocal = mWorldTfrm.getInvMatrix();
+		Matrix4 worldToLocal = getTransform().getInvMatrix();
 		return worldToLocal;
 	}
 
@@ -419,7 +443,9 @@ namespace bs
 		if (!isCachedLocalTfrmUpToDate())
 			updateLocalTfrm();
 
-		if (!isCachedWorldTfrmUpToDate())
+		if (isInTransformStorage())
+			getTransform();
+		else if (!isCachedWorldTfrmUpToDate())
 			updateWorldTfrm();
 	}
 
@@ -433,24 +459,21 @@ namespace bs
 		{
 			mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
 			mDirtyHash++;
-		}
 
-		// Only send component flags if we haven't removed them all
-		if (componentFlags != 0)
-		{
-			for (auto& entry : mComponents)
-			{
-				if (entry->supportsNotify(flags))
-				{
-					bool alwaysRun = entry->hasFlag(ComponentFlag::AlwaysRun);
-					if (alwaysRun || gSceneManager().isRunning())
-						entry->onTransformChanged(componentFlags);
-				}
-			}
+			if (isInTransformStorage())
+				TransformStorage::instance().setLocalTransform(mTransformId, mLocalTfrm);
 		}
 
+		notifyComponentsTransformChanged(flags, componentFlags);
+		markBoundActorsDirty();
+
 		// Mobility flag is only relevant for this scene object
 		flags = (TransformChangedFlags)(flags & ~TCF_Mobility);
+
+		// Children in the transform storage are marked dirty by the storage, and notified during its next update
+		if (isInTransformStorage())
+			flags = (TransformChangedFlags)(flags & ~TCF_Transform);
+
 		if (flags != 0)
 		{
 			for (auto& entry : mChildren)
@@ -458,6 +481,24 @@ namespace bs
 		}
 	}
 
+	void SceneObject::notifyComponentsTransformChanged(TransformChangedFlags flags, 
+		TransformChangedFlags componentFlags) const
+	{
+		// Only send component flags if we haven't removed them all
+		if (componentFlags == 0)
+			return;
+
+		for (auto& entry : mComponents)
+		{
+			if (entry->supportsNotify(flags))
+			{
+				bool alwaysRun = entry->hasFlag(ComponentFlag::AlwaysRun);
+				if (alwaysRun || gSceneManager().isRunning())
+					entry->onTransformChanged(componentFlags);
+			}
+		}
+	}
+
 	void SceneObject::updateWorldTfrm() const
 	{
 		mWorldTfrm = mLocalTfrm;
@@ -483,6 +524,65 @@ namespace bs
 		mDirtyFlags &= ~DirtyFlags::LocalTfrmDirty;
 	}
 
+	void SceneObject::markBoundActorsDirty() const
+	{
+		if (mFirstBoundActor != (UINT32)-1)
+			gSceneManager().markBoundActorsDirty(mFirstBoundActor);
+	}
+
+	void SceneObject::attachTransformStorage()
+	{
+		if (!isInTransformStorage())
+			mTransformId = TransformStorage::instance().registerObject(this);
+
+		UINT32 parentId = TransformStorage::INVALID_ID;
+		if (mParent != nullptr && mMobility == ObjectMobility::Movable)
+			parentId = mParent->mTransformId;
+
+		TransformStorage::instance().setParent(mTransformId, parentId);
+
+		for (auto& child : mChildren)
+			child->attachTransformStorage();
+	}
+
+	void SceneObject::detachTransformStorage()
+	{
+		for (auto& child : mChildren)
+			child->detachTransformStorage();
+
+		if (!isInTransformStorage())
+			return;
+
+		TransformStorage::instance().unregisterObject(mTransformId);
+		mTransformId = TransformStorage::INVALID_ID;
+		mDirtyFlags |= DirtyFlags::WorldTfrmDirty;
+	}
+
+	void SceneObject::updateTransformStorageParent()
+	{
+		if (!TransformStorage::isStarted())
+			return;
+
+		// Storage evaluates parents on its own, so it can only contain objects whose parents it contains as well
+		if (mParent != nullptr && !mParent->isInTransformStorage())
+		{
+			detachTransformStorage();
+			return;
+		}
+
+		if (!isInTransformStorage())
+		{
+			attachTransformStorage();
+			return;
+		}
+
+		UINT32 parentId = TransformStorage::INVALID_ID;
+		if (mParent != nullptr && mMobility == ObjectMobility::Movable)
+			parentId = mParent->mTransformId;
+
+		TransformStorage::instance().setParent(mTransformId, parentId);
+	}
+
 	/************************************************************************/
 	/* 								Hierarchy	                     		*/
 	/************************************************************************/
@@ -531,6 +631,7 @@ namespace bs
 				parent->addChild(mThisHandle);
 
 			mParent = parent;
+			updateTransformStorageParent();
 
 			if (keepWorldTransform)
 			{
@@ -679,6 +780,7 @@ namespace bs
 		if (mActiveHierarchy != activeHierarchy)
 		{
 			mActiveHierarchy = activeHierarchy;
+			markBoundActorsDirty();
 
 			if (triggerEvents)
 			{
@@ -714,6 +816,7 @@ namespace bs
 		if(mMobility != mobility)
 		{
 			mMobility = mobility;
+			updateTransformStorageParent();
 
 			// If mobility changed to movable, update both the mobility flag and transform, otherwise just mobility
 			if (mMobility == ObjectMobility::Movable)
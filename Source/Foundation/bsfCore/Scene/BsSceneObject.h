@@ -51,6 +51,7 @@ namespace bs
 		friend class Prefab;
 		friend class PrefabDiff;
 		friend class PrefabUtility;
+		friend class TransformStorage;
 	public:
 		~SceneObject();
 
@@ -300,6 +301,10 @@ namespace bs
 		/**
 		 * Returns a hash value that changes whenever a scene objects transform gets updated. It allows you to detect 
 		 * changes with the local or world transforms without directly comparing their values with some older state.
+		 *
+		 * @note	
+		 * If the object's transform is kept in the TransformStorage, changes caused by parent transforms are only
+		 * reflected after the next TransformStorage::update().
 		 */
 		UINT32 getTransformHash() const { return mDirtyHash; }
 
@@ -313,6 +318,9 @@ namespace bs
 		mutable UINT32 mDirtyFlags;
 		mutable UINT32 mDirtyHash;
 
+		UINT32 mTransformId;
+		UINT32 mFirstBoundActor;
+
 		/** 
 		 * Notifies components and child scene object that a transform has been changed.  
 		 * 
@@ -320,6 +328,14 @@ namespace bs
 		 */
 		void notifyTransformChanged(TransformChangedFlags flags) const;
 
+		/**
+		 * Notifies components attached to this object that a transform has been changed.
+		 *
+		 * @param	flags			Specifies in what way was the transform changed.
+		 * @param	componentFlags	Flags to pass to the components. Same as @p flags, unless the object is immovable.
+		 */
+		void notifyComponentsTransformChanged(TransformChangedFlags flags, TransformChangedFlags componentFlags) const;
+
 		/** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
 		void updateLocalTfrm() const;
 
@@ -336,6 +352,28 @@ namespace bs
 		/**	Checks if cached world transform needs updating. */
 		bool isCachedWorldTfrmUpToDate() const { return (mDirtyFlags & DirtyFlags::WorldTfrmDirty) == 0; }
 
+		/** Queues any scene actors bound to this object for an update, when the scene manager next updates them. */
+		void markBoundActorsDirty() const;
+
+		/** Checks are the transforms of this object kept in the TransformStorage. */
+		bool isInTransformStorage() const { return mTransformId != (UINT32)-1; }
+
+		/** 
+		 * Adds this object and all of its children to the TransformStorage, or just updates the parent if the object is 
+		 * already in the storage.
+		 */
+		void attachTransformStorage();
+
+		/** Removes this object and all of its children from the TransformStorage. */
+		void detachTransformStorage();
+
+		/**
+		 * Updates the parent of the object in the TransformStorage, after the parent or mobility of the object changes.
+		 * Objects can only be in the storage if their parent is, so this may also add or remove the object from the 
+		 * storage.
+		 */
+		void updateTransformStorageParent();
+
 		/************************************************************************/
 		/* 								Hierarchy	                     		*/
 		/************************************************************************/
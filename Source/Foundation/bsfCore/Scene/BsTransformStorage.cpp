@@ -0,0 +1,604 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Scene/BsTransformStorage.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsSceneManager.h"
+#include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
+#include "Threading/BsJobScheduler.h"
+#include "Profiling/BsProfilerCPU.h"
+
+namespace bs
+{
+	/** Minimum number of batches updated by a single job, when updating a hierarchy level in parallel. */
+	static constexpr UINT32 MIN_BATCHES_PER_JOB = 128;
+
+	void TransformStorage::TransformSoA::resize(UINT32 count)
+	{
+		const UINT32 paddedCount = Math::divideAndRoundUp(count, BATCH_SIZE) * BATCH_SIZE;
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			position[i].resize(paddedCount, 0.0f);
+			scale[i].resize(paddedCount, 1.0f);
+		}
+
+		for(UINT32 i = 0; i < 3; i++)
+			rotation[i].resize(paddedCount, 0.0f);
+
+		rotation[3].resize(paddedCount, 1.0f);
+	}
+
+	void TransformStorage::TransformSoA::set(UINT32 idx, const Transform& transform)
+	{
+		const Vector3& pos = transform.getPosition();
+		const Quaternion& rot = transform.getRotation();
+		const Vector3& scl = transform.getScale();
+
+		position[0][idx] = pos.x;
+		position[1][idx] = pos.y;
+		position[2][idx] = pos.z;
+
+		rotation[0][idx] = rot.x;
+		rotation[1][idx] = rot.y;
+		rotation[2][idx] = rot.z;
+		rotation[3][idx] = rot.w;
+
+		scale[0][idx] = scl.x;
+		scale[1][idx] = scl.y;
+		scale[2][idx] = scl.z;
+	}
+
+	Transform TransformStorage::TransformSoA::get(UINT32 idx) const
+	{
+		return Transform(
+			Vector3(position[0][idx], position[1][idx], position[2][idx]),
+			Quaternion(rotation[3][idx], rotation[0][idx], rotation[1][idx], rotation[2][idx]),
+			Vector3(scale[0][idx], scale[1][idx], scale[2][idx]));
+	}
+
+	UINT32 TransformStorage::registerObject(SceneObject* so)
+	{
+		UINT32 id;
+		if(!mFreeIds.empty())
+		{
+			id = mFreeIds.back();
+			mFreeIds.pop_back();
+		}
+		else
+		{
+			id = (UINT32)mIdToSlot.size();
+			mIdToSlot.push_back(INVALID_ID);
+		}
+
+		const UINT32 slot = addSlot();
+		mObjects[slot] = so;
+		mSlotToId[slot] = id;
+		mIdToSlot[id] = slot;
+
+		mLocal.set(slot, so->getLocalTransform());
+		setBit(mDirty, slot);
+
+		mNumObjects++;
+		mVersion++;
+		mHierarchyDirty = true;
+
+		return id;
+	}
+
+	void TransformStorage::unregisterObject(UINT32 id)
+	{
+		const UINT32 slot = mIdToSlot[id];
+
+		// Slot is kept until the hierarchy is rebuilt, so children evaluated before that still find valid data
+		mObjects[slot] = nullptr;
+		mSlotToId[slot] = INVALID_ID;
+		mIdToSlot[id] = INVALID_ID;
+		mFreeIds.push_back(id);
+
+		mNumObjects--;
+		mHierarchyDirty = true;
+	}
+
+	void TransformStorage::setParent(UINT32 id, UINT32 parentId)
+	{
+		const UINT32 slot = mIdToSlot[id];
+		const UINT32 parentSlot = parentId != INVALID_ID ? mIdToSlot[parentId] : INVALID_ID;
+
+		if(mParents[slot] == parentSlot)
+			return;
+
+		mParents[slot] = parentSlot;
+		setBit(mDirty, slot);
+
+		mVersion++;
+		mHierarchyDirty = true;
+	}
+
+	void TransformStorage::setLocalTransform(UINT32 id, const Transform& transform)
+	{
+		const UINT32 slot = mIdToSlot[id];
+
+		mLocal.set(slot, transform);
+		setBit(mDirty, slot);
+
+		mVersion++;
+	}
+
+	Transform TransformStorage::getWorldTransform(UINT32 id)
+	{
+		const UINT32 slot = mIdToSlot[id];
+		evaluate(slot);
+
+		return mWorld.get(slot);
+	}
+
+	const Matrix4& TransformStorage::getWorldMatrix(UINT32 id)
+	{
+		const UINT32 slot = mIdToSlot[id];
+		evaluate(slot);
+
+		return mWorldMatrices[slot];
+	}
+
+	void TransformStorage::update()
+	{
+		if(mVersion == mCleanVersion && !mHierarchyDirty)
+			return;
+
+		gProfilerCPU().beginSample("UpdateTransforms");
+
+		if(mHierarchyDirty)
+			rebuildHierarchy();
+
+		const UINT32 numLevels = (UINT32)mLevelOffsets.size() - 1;
+
+		// Propagate dirty flags to children. Slots are sorted by depth so parents are always visited before children,
+		// and the first level has no parents.
+		const UINT32 firstChild = numLevels > 1 ? mLevelOffsets[1] : mNumSlots;
+		for(UINT32 i = firstChild; i < mNumSlots; i++)
+		{
+			const UINT32 parent = mParents[i];
+			if(parent == INVALID_ID || !isBitSet(mDirty, parent) || isBitSet(mDirty, i))
+				continue;
+
+			setBit(mDirty, i);
+			setBit(mInherited, i);
+		}
+
+		UINT32 maxChunks = 1;
+		if (JobScheduler::isStarted())
+			maxChunks = JobScheduler::instance().getNumActiveWorkers() + 1;
+
+		// Levels need to be updated one after another, but objects within a level don't depend on each other
+		for(UINT32 i = 0; i < numLevels; i++)
+		{
+			const UINT32 levelStart = mLevelOffsets[i];
+			const UINT32 numBatches = (mLevelOffsets[i + 1] - levelStart) / BATCH_SIZE;
+
+			UINT32 numChunks = Math::clamp(numBatches / MIN_BATCHES_PER_JOB, 1U, maxChunks);
+			if(numChunks == 1)
+				updateBatches(levelStart, mLevelOffsets[i + 1]);
+			else
+			{
+				const UINT32 chunkSize = Math::divideAndRoundUp(numBatches, numChunks);
+				numChunks = Math::divideAndRoundUp(numBatches, chunkSize);
+
+				JobScheduler::instance().parallelForAndWait(numChunks, 1, [&](UINT32 start, UINT32 numToProcess)
+				{
+					for(UINT32 chunk = start; chunk < start + numToProcess; chunk++)
+					{
+						const UINT32 batchStart = chunk * chunkSize;
+						const UINT32 batchEnd = std::min(batchStart + chunkSize, numBatches);
+
+						updateBatches(levelStart + batchStart * BATCH_SIZE, levelStart + batchEnd * BATCH_SIZE);
+					}
+				});
+			}
+		}
+
+		// Objects that only moved because their parent did haven't notified their components yet
+		mNotifyList.clear();
+		for(UINT32 i = 0; i < (UINT32)mInherited.size(); i++)
+		{
+			UINT64 bits = mInherited[i];
+			for(UINT32 j = 0; bits != 0; j++, bits >>= 1)
+			{
+				if((bits & 1) == 0)
+					continue;
+
+				SceneObject* so = mObjects[i * 64 + j];
+				if(so != nullptr)
+					mNotifyList.push_back(so);
+			}
+		}
+
+		std::fill(mDirty.begin(), mDirty.end(), 0);
+		std::fill(mInherited.begin(), mInherited.end(), 0);
+		mCleanVersion = mVersion;
+
+		// Notify after the dirty state is cleared, as components are allowed to move objects in response
+		for(auto& entry : mNotifyList)
+		{
+			entry->mDirtyHash++;
+			entry->notifyComponentsTransformChanged(TCF_Transform, TCF_Transform);
+			entry->markBoundActorsDirty();
+		}
+
+		gProfilerCPU().endSample("UpdateTransforms");
+	}
+
+	void TransformStorage::onStartUp()
+	{
+		if(SceneManager::isStarted())
+		{
+			HSceneObject root = gSceneManager().getRootNode();
+			if(root != nullptr)
+				root->attachTransformStorage();
+		}
+	}
+
+	void TransformStorage::onShutDown()
+	{
+		// Objects fall back to evaluating their world transforms on their own
+		for(UINT32 i = 0; i < mNumSlots; i++)
+		{
+			SceneObject* so = mObjects[i];
+			if(so == nullptr)
+				continue;
+
+			so->mTransformId = INVALID_ID;
+			so->mDirtyFlags |= SceneObject::WorldTfrmDirty;
+		}
+	}
+
+	UINT32 TransformStorage::addSlot()
+	{
+		const UINT32 slot = mNumSlots++;
+		if(slot >= (UINT32)mParents.size())
+		{
+			const UINT32 capacity = std::max(BATCH_SIZE * 8, (UINT32)mParents.size() * 2);
+
+			mLocal.resize(capacity);
+			mWorld.resize(capacity);
+			mWorldMatrices.resize(capacity, Matrix4::IDENTITY);
+			mParents.resize(capacity, INVALID_ID);
+			mObjects.resize(capacity, nullptr);
+			mSlotToId.resize(capacity, INVALID_ID);
+			mEvaluatedVersion.resize(capacity, 0);
+			mDirty.resize(Math::divideAndRoundUp(capacity, 64U), 0);
+			mInherited.resize(Math::divideAndRoundUp(capacity, 64U), 0);
+		}
+
+		mParents[slot] = INVALID_ID;
+		return slot;
+	}
+
+	void TransformStorage::rebuildHierarchy()
+	{
+		// Parents of removed objects are considered roots. Their children are either being destroyed or re-parented.
+		for(UINT32 i = 0; i < mNumSlots; i++)
+		{
+			const UINT32 parent = mParents[i];
+			if(parent != INVALID_ID && mObjects[parent] == nullptr)
+				mParents[i] = INVALID_ID;
+		}
+
+		// Calculate depths, walking up the hierarchy until an object with a known depth is found
+		Vector<UINT32> depths(mNumSlots, INVALID_ID);
+		UINT32 numLevels = 0;
+		for(UINT32 i = 0; i < mNumSlots; i++)
+		{
+			if(mObjects[i] == nullptr || depths[i] != INVALID_ID)
+				continue;
+
+			mEvaluateChain.clear();
+
+			UINT32 depth = 0;
+			UINT32 current = i;
+			while(true)
+			{
+				mEvaluateChain.push_back(current);
+
+				const UINT32 parent = mParents[current];
+				if(parent == INVALID_ID)
+					break;
+
+				if(depths[parent] != INVALID_ID)
+				{
+					depth = depths[parent] + 1;
+					break;
+				}
+
+				current = parent;
+			}
+
+			for(auto iter = mEvaluateChain.rbegin(); iter != mEvaluateChain.rend(); ++iter)
+				depths[*iter] = depth++;
+
+			numLevels = std::max(numLevels, depth);
+		}
+
+		// Start every level on a batch boundary, so batches never span multiple levels
+		Vector<UINT32> levelCounts(numLevels, 0);
+		for(UINT32 i = 0; i < mNumSlots; i++)
+		{
+			if(mObjects[i] != nullptr)
+				levelCounts[depths[i]]++;
+		}
+
+		mLevelOffsets.resize(numLevels + 1);
+
+		UINT32 numSlots = 0;
+		for(UINT32 i = 0; i < numLevels; i++)
+		{
+			mLevelOffsets[i] = numSlots;
+			numSlots += Math::divideAndRoundUp(levelCounts[i], BATCH_SIZE) * BATCH_SIZE;
+			levelCounts[i] = mLevelOffsets[i];
+		}
+
+		mLevelOffsets[numLevels] = numSlots;
+
+		Vector<UINT32> newSlots(mNumSlots, INVALID_ID);
+		for(UINT32 i = 0; i < mNumSlots; i++)
+		{
+			if(mObjects[i] != nullptr)
+				newSlots[i] = levelCounts[depths[i]]++;
+		}
+
+		// Move the data into the sorted order. Unused slots are left with identity transforms and no parent.
+		const UINT32 capacity = std::max(numSlots, BATCH_SIZE * 8);
+
+		TransformSoA local;
+		TransformSoA world;
+		local.resize(capacity);
+		world.resize(capacity);
+
+		Vector<Matrix4> worldMatrices(capacity, Matrix4::IDENTITY);
+		Vector<UINT32> parents(capacity, INVALID_ID);
+		Vector<SceneObject*> objects(capacity, nullptr);
+		Vector<UINT32> slotToId(capacity, INVALID_ID);
+		Vector<UINT32> evaluatedVersion(capacity, 0);
+		Vector<UINT64> dirty(Math::divideAndRoundUp(capacity, 64U), 0);
+
+		for(UINT32 i = 0; i < mNumSlots; i++)
+		{
+			const UINT32 slot = newSlots[i];
+			if(slot == INVALID_ID)
+				continue;
+
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				local.position[j][slot] = mLocal.position[j][i];
+				local.scale[j][slot] = mLocal.scale[j][i];
+				world.position[j][slot] = mWorld.position[j][i];
+				world.scale[j][slot] = mWorld.scale[j][i];
+			}
+
+			for(UINT32 j = 0; j < 4; j++)
+			{
+				local.rotation[j][slot] = mLocal.rotation[j][i];
+				world.rotation[j][slot] = mWorld.rotation[j][i];
+			}
+
+			worldMatrices[slot] = mWorldMatrices[i];
+			parents[slot] = mParents[i] != INVALID_ID ? newSlots[mParents[i]] : INVALID_ID;
+			objects[slot] = mObjects[i];
+			slotToId[slot] = mSlotToId[i];
+			evaluatedVersion[slot] = mEvaluatedVersion[i];
+
+			if(isBitSet(mDirty, i))
+				setBit(dirty, slot);
+
+			mIdToSlot[mSlotToId[i]] = slot;
+		}
+
+		mLocal = std::move(local);
+		mWorld = std::move(world);
+		mWorldMatrices = std::move(worldMatrices);
+		mParents = std::move(parents);
+		mObjects = std::move(objects);
+		mSlotToId = std::move(slotToId);
+		mEvaluatedVersion = std::move(evaluatedVersion);
+		mDirty = std::move(dirty);
+		mInherited.assign(mDirty.size(), 0);
+
+		mNumSlots = numSlots;
+		mHierarchyDirty = false;
+	}
+
+	void TransformStorage::evaluate(UINT32 slot)
+	{
+		if(mCleanVersion == mVersion || mEvaluatedVersion[slot] == mVersion)
+			return;
+
+		// Find the top-most parent modified since the last update. Everything above it is up to date.
+		mEvaluateChain.clear();
+
+		UINT32 numToEvaluate = 0;
+		for(UINT32 current = slot; current != INVALID_ID; current = mParents[current])
+		{
+			mEvaluateChain.push_back(current);
+
+			if(isBitSet(mDirty, current))
+				numToEvaluate = (UINT32)mEvaluateChain.size();
+		}
+
+		for(UINT32 i = numToEvaluate; i-- > 0;)
+		{
+			const UINT32 current = mEvaluateChain[i];
+			const UINT32 parent = mParents[current];
+
+			Transform world = mLocal.get(current);
+			if(parent != INVALID_ID)
+				world.makeWorld(mWorld.get(parent));
+
+			mWorld.set(current, world);
+			mWorldMatrices[current] = world.getMatrix();
+			mEvaluatedVersion[current] = mVersion;
+		}
+
+		mEvaluatedVersion[slot] = mVersion;
+	}
+
+	void TransformStorage::updateBatches(UINT32 start, UINT32 end)
+	{
+		using namespace simd;
+
+		const float32x8 zero = make_zero();
+		const float32x8 one = splat<float32x8>(1.0f);
+
+		for(UINT32 i = start; i < end; i += BATCH_SIZE)
+		{
+			// Batches start at multiples of BATCH_SIZE, so all their dirty flags are in the same word
+			const UINT64 dirtyMask = (mDirty[i >> 6] >> (i & 63)) & ((1ULL << BATCH_SIZE) - 1);
+			if(dirtyMask == 0)
+				continue;
+
+			// Parents are scattered throughout the previous levels, gather them into a batch. Objects without a parent
+			// use the identity transform.
+			SIMDPP_ALIGN(32) float parentData[10][BATCH_SIZE];
+			for(UINT32 j = 0; j < BATCH_SIZE; j++)
+			{
+				const UINT32 parent = mParents[i + j];
+				if(parent == INVALID_ID)
+				{
+					for(UINT32 k = 0; k < 3; k++)
+					{
+						parentData[k][j] = 0.0f;
+						parentData[7 + k][j] = 1.0f;
+					}
+
+					for(UINT32 k = 0; k < 3; k++)
+						parentData[3 + k][j] = 0.0f;
+
+					parentData[6][j] = 1.0f;
+				}
+				else
+				{
+					for(UINT32 k = 0; k < 3; k++)
+					{
+						parentData[k][j] = mWorld.position[k][parent];
+						parentData[7 + k][j] = mWorld.scale[k][parent];
+					}
+
+					for(UINT32 k = 0; k < 4; k++)
+						parentData[3 + k][j] = mWorld.rotation[k][parent];
+				}
+			}
+
+			float32x8 parentPos[3];
+			float32x8 parentScale[3];
+			float32x8 localPos[3];
+			float32x8 localScale[3];
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				parentPos[j] = load<float32x8>(parentData[j]);
+				parentScale[j] = load<float32x8>(parentData[7 + j]);
+				localPos[j] = load_u<float32x8>(&mLocal.position[j][i]);
+				localScale[j] = load_u<float32x8>(&mLocal.scale[j][i]);
+			}
+
+			const float32x8 px = load<float32x8>(parentData[3]);
+			const float32x8 py = load<float32x8>(parentData[4]);
+			const float32x8 pz = load<float32x8>(parentData[5]);
+			const float32x8 pw = load<float32x8>(parentData[6]);
+
+			const float32x8 lx = load_u<float32x8>(&mLocal.rotation[0][i]);
+			const float32x8 ly = load_u<float32x8>(&mLocal.rotation[1][i]);
+			const float32x8 lz = load_u<float32x8>(&mLocal.rotation[2][i]);
+			const float32x8 lw = load_u<float32x8>(&mLocal.rotation[3][i]);
+
+			// World rotation = parent rotation * local rotation
+			const float32x8 x = add(sub(add(mul(pw, lx), mul(px, lw)), mul(pz, ly)), mul(py, lz));
+			const float32x8 y = add(sub(add(mul(pw, ly), mul(py, lw)), mul(px, lz)), mul(pz, lx));
+			const float32x8 z = add(sub(add(mul(pw, lz), mul(pz, lw)), mul(py, lx)), mul(px, ly));
+			const float32x8 w = sub(sub(sub(mul(pw, lw), mul(px, lx)), mul(py, ly)), mul(pz, lz));
+
+			// World position = parent rotation applied to (parent scale * local position), plus parent position
+			float32x8 parentRot[3][3];
+			{
+				const float32x8 tx = add(px, px);
+				const float32x8 ty = add(py, py);
+				const float32x8 tz = add(pz, pz);
+				const float32x8 twx = mul(tx, pw);
+				const float32x8 twy = mul(ty, pw);
+				const float32x8 twz = mul(tz, pw);
+				const float32x8 txx = mul(tx, px);
+				const float32x8 txy = mul(ty, px);
+				const float32x8 txz = mul(tz, px);
+				const float32x8 tyy = mul(ty, py);
+				const float32x8 tyz = mul(tz, py);
+				const float32x8 tzz = mul(tz, pz);
+
+				parentRot[0][0] = sub(one, add(tyy, tzz)); parentRot[0][1] = sub(txy, twz); parentRot[0][2] = add(txz, twy);
+				parentRot[1][0] = add(txy, twz); parentRot[1][1] = sub(one, add(txx, tzz)); parentRot[1][2] = sub(tyz, twx);
+				parentRot[2][0] = sub(txz, twy); parentRot[2][1] = add(tyz, twx); parentRot[2][2] = sub(one, add(txx, tyy));
+			}
+
+			float32x8 scaledPos[3];
+			for(UINT32 j = 0; j < 3; j++)
+				scaledPos[j] = mul(parentScale[j], localPos[j]);
+
+			float32x8 pos[3];
+			float32x8 scale[3];
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				float32x8 rotated = zero;
+				for(UINT32 k = 0; k < 3; k++)
+					rotated = add(rotated, mul(parentRot[j][k], scaledPos[k]));
+
+				pos[j] = add(rotated, parentPos[j]);
+				scale[j] = mul(parentScale[j], localScale[j]);
+
+				store_u(&mWorld.position[j][i], pos[j]);
+				store_u(&mWorld.scale[j][i], scale[j]);
+			}
+
+			store_u(&mWorld.rotation[0][i], x);
+			store_u(&mWorld.rotation[1][i], y);
+			store_u(&mWorld.rotation[2][i], z);
+			store_u(&mWorld.rotation[3][i], w);
+
+			// World matrix from the world position, rotation and scale
+			const float32x8 tx = add(x, x);
+			const float32x8 ty = add(y, y);
+			const float32x8 tz = add(z, z);
+			const float32x8 twx = mul(tx, w);
+			const float32x8 twy = mul(ty, w);
+			const float32x8 twz = mul(tz, w);
+			const float32x8 txx = mul(tx, x);
+			const float32x8 txy = mul(ty, x);
+			const float32x8 txz = mul(tz, x);
+			const float32x8 tyy = mul(ty, y);
+			const float32x8 tyz = mul(tz, y);
+			const float32x8 tzz = mul(tz, z);
+
+			const float32x8 rot[3][3] =
+			{
+				{ sub(one, add(tyy, tzz)), sub(txy, twz), add(txz, twy) },
+				{ add(txy, twz), sub(one, add(txx, tzz)), sub(tyz, twx) },
+				{ sub(txz, twy), add(tyz, twx), sub(one, add(txx, tyy)) }
+			};
+
+			// Rows of the 3x4 part of the matrix, for each object in the batch
+			SIMDPP_ALIGN(32) float rows[3][4][BATCH_SIZE];
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				for(UINT32 k = 0; k < 3; k++)
+					store(rows[j][k], mul(rot[j][k], scale[k]));
+
+				store(rows[j][3], pos[j]);
+			}
+
+			for(UINT32 j = 0; j < BATCH_SIZE; j++)
+			{
+				mWorldMatrices[i + j] = Matrix4(
+					rows[0][0][j], rows[0][1][j], rows[0][2][j], rows[0][3][j],
+					rows[1][0][j], rows[1][1][j], rows[1][2][j], rows[1][3][j],
+					rows[2][0][j], rows[2][1][j], rows[2][2][j], rows[2][3][j],
+					0.0f, 0.0f, 0.0f, 1.0f);
+			}
+		}
+	}
+}
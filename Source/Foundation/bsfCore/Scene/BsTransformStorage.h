@@ -0,0 +1,148 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsModule.h"
+#include "Scene/BsTransform.h"
+#include "Math/BsMatrix4.h"
+
+namespace bs
+{
+	/** @addtogroup Scene-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Stores local and world transforms of scene objects in structure-of-arrays layout, sorted by depth in the hierarchy.
+	 * World transforms are not updated as soon as a transform changes. Instead the changed object is marked in a dirty
+	 * bitset and all the dirty world transforms are recomputed by update(), one hierarchy level at a time. Objects within
+	 * a level are processed in SIMD batches, with large levels split between the workers of the JobScheduler.
+	 *
+	 * World transforms of individual objects can also be retrieved before the update, in which case only the object and
+	 * its parents are evaluated.
+	 *
+	 * The storage is optional. When started, all scene objects created afterwards (as well as the current scene
+	 * hierarchy) store their transforms in it. SceneObject's transform methods work the same regardless, except that
+	 * children of a moved object don't get their transform changed notifications until the next update().
+	 *
+	 * @note	Sim thread only.
+	 */
+	class BS_CORE_EXPORT TransformStorage : public Module<TransformStorage>
+	{
+	public:
+		/** Identifier of an object not present in the storage. */
+		static constexpr UINT32 INVALID_ID = (UINT32)-1;
+
+		/** Number of objects whose transforms are computed by a single SIMD operation. */
+		static constexpr UINT32 BATCH_SIZE = 8;
+
+		TransformStorage() = default;
+
+		/**
+		 * Adds a new scene object to the storage and returns its identifier. The object is initially placed at the root
+		 * of the hierarchy.
+		 */
+		UINT32 registerObject(SceneObject* so);
+
+		/** Removes an object previously added with registerObject(). */
+		void unregisterObject(UINT32 id);
+
+		/**
+		 * Changes the object the world transform of the object is relative to. Provide INVALID_ID for objects whose world
+		 * transform equals their local transform.
+		 */
+		void setParent(UINT32 id, UINT32 parentId);
+
+		/** Updates the local transform of an object and marks its world transform, and those of its children, as dirty. */
+		void setLocalTransform(UINT32 id, const Transform& transform);
+
+		/** Returns the world transform of the object. Evaluates the object and its parents if they are dirty. */
+		Transform getWorldTransform(UINT32 id);
+
+		/** Returns the world matrix of the object. Evaluates the object and its parents if they are dirty. */
+		const Matrix4& getWorldMatrix(UINT32 id);
+
+		/**
+		 * Recomputes all dirty world transforms and notifies components of objects whose parent transform changed since
+		 * the last update.
+		 */
+		void update();
+
+		/** Returns the number of objects in the storage. */
+		UINT32 getNumObjects() const { return mNumObjects; }
+
+	private:
+		/** Transform components stored as separate arrays, padded to a multiple of BATCH_SIZE. */
+		struct TransformSoA
+		{
+			/** Changes the number of transforms stored in the arrays. Existing contents are preserved. */
+			void resize(UINT32 count);
+
+			/** Assigns a transform to the specified index. */
+			void set(UINT32 idx, const Transform& transform);
+
+			/** Returns the transform at the specified index. */
+			Transform get(UINT32 idx) const;
+
+			Vector<float> position[3];
+			Vector<float> rotation[4];
+			Vector<float> scale[3];
+		};
+
+		/** @copydoc Module::onStartUp */
+		void onStartUp() override;
+
+		/** @copydoc Module::onShutDown */
+		void onShutDown() override;
+
+		/** Adds a new slot at the end of the arrays, and returns its index. */
+		UINT32 addSlot();
+
+		/**
+		 * Sorts the slots by their depth in the hierarchy so that parents always come before children, and removes unused
+		 * slots. Every level starts at a multiple of BATCH_SIZE.
+		 */
+		void rebuildHierarchy();
+
+		/** Evaluates the world transform of the slot, if it or any of its parents changed since it was last evaluated. */
+		void evaluate(UINT32 slot);
+
+		/** Recomputes world transforms of all dirty slots in batches in the [@p start, @p end) range. */
+		void updateBatches(UINT32 start, UINT32 end);
+
+		/** Checks is the bit for the specified slot set in the bitset. */
+		static bool isBitSet(const Vector<UINT64>& bits, UINT32 slot)
+		{
+			return (bits[slot >> 6] & (1ULL << (slot & 63))) != 0;
+		}
+
+		/** Sets the bit for the specified slot in the bitset. */
+		static void setBit(Vector<UINT64>& bits, UINT32 slot) { bits[slot >> 6] |= 1ULL << (slot & 63); }
+
+		TransformSoA mLocal;
+		TransformSoA mWorld;
+		Vector<Matrix4> mWorldMatrices;
+		Vector<UINT32> mParents;
+		Vector<SceneObject*> mObjects;
+		Vector<UINT32> mSlotToId;
+		Vector<UINT32> mEvaluatedVersion;
+
+		Vector<UINT64> mDirty;
+		Vector<UINT64> mInherited;
+
+		Vector<UINT32> mIdToSlot;
+		Vector<UINT32> mFreeIds;
+		Vector<UINT32> mLevelOffsets;
+		Vector<UINT32> mEvaluateChain;
+		Vector<SceneObject*> mNotifyList;
+
+		UINT32 mNumSlots = 0;
+		UINT32 mNumObjects = 0;
+		UINT32 mVersion = 0;
+		UINT32 mCleanVersion = 0;
+		bool mHierarchyDirty = false;
+	};
+
+	/** @} */
+}
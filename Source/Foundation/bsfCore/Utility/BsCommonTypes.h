@@ -297,7 +297,13 @@ namespace bs
 	enum GpuParamBlockUsage
 	{
 		GPBU_STATIC, /**< Buffer will be rarely, if ever, updated. */
-		GPBU_DYNAMIC /**< Buffer will be updated often (for example every frame). */
+		GPBU_DYNAMIC, /**< Buffer will be updated often (for example every frame). */
+		/**
+		 * Buffer will be updated often and its contents only need to persist until it is bound. If the render API
+		 * reports RSC_PARAM_BLOCK_RING_BUFFER the data is sub-allocated from a per-device ring buffer and bound by offset,
+		 * otherwise this behaves the same as GPBU_DYNAMIC.
+		 */
+		GPBU_STREAM
 	};
 
 	/** Type of a parameter in a GPU program. */
@@ -10,6 +10,9 @@
 #include "Mesh/BsMeshData.h"
 #include "RenderAPI/BsVertexDataDesc.h"
 #include "Mesh/BsMesh.h"
+#include "RenderAPI/BsVertexBuffer.h"
+#include "RenderAPI/BsIndexBuffer.h"
+#include "RenderAPI/BsVertexData.h"
 #include "Managers/BsRenderWindowManager.h"
 #include "Platform/BsPlatform.h"
 #include "Math/BsRect2I.h"
@@ -42,19 +45,6 @@ using namespace std::placeholders;
 
 namespace bs
 {
-	struct GUIGroupElement
-	{
-		GUIGroupElement()
-		{ }
-
-		GUIGroupElement(GUIElement* _element, UINT32 _renderElement)
-			:element(_element), renderElement(_renderElement)
-		{ }
-
-		GUIElement* element;
-		UINT32 renderElement;
-	};
-
 	struct GUIMaterialGroup
 	{
 		SpriteMaterial* material;
@@ -65,9 +55,69 @@ namespace bs
 		UINT32 depth;
 		UINT32 minDepth;
 		Rect2I bounds;
-		Vector<GUIGroupElement> elements;
+		FrameVector<UINT32> elements;
 	};
 
+	/** 
+	 * Writes the vertices and indices of a single render element of a GUI element into the mesh data, at the specified
+	 * offsets.
+	 */
+	static void fillMeshData(MeshData& meshData, const GUIElement* element, UINT32 renderElement, UINT32 vertexOffset,
+		UINT32 indexOffset, UINT32 numIndices)
+	{
+		UINT8* vertices = meshData.getElementData(VES_POSITION);
+		UINT32* indices = meshData.getIndices32();
+
+		element->_fillBuffer(vertices, indices, vertexOffset, indexOffset, meshData.getNumVertices(), 
+			meshData.getNumIndices(), renderElement);
+
+		// Elements output indices relative to their own first vertex
+		UINT32 indexEnd = indexOffset + numIndices;
+		for(UINT32 i = indexOffset; i < indexEnd; i++)
+			indices[i] += vertexOffset;
+	}
+
+	/** Vertices and indices of a set of render elements, to be written to an existing GUI mesh. */
+	struct GUIMeshPatch
+	{
+		/** Location of a single render element in the mesh, in number of vertices and indices. */
+		struct Range
+		{
+			UINT32 vertexOffset;
+			UINT32 numVertices;
+			UINT32 indexOffset;
+			UINT32 numIndices;
+		};
+
+		Vector<Range> ranges;
+		Vector<UINT8> vertices;
+		Vector<UINT8> indices;
+	};
+
+	/** Writes the ranges of the patch to the vertex and index buffers of the mesh. Must be called on the core thread. */
+	static void writeMeshPatch(const SPtr<ct::Mesh>& mesh, const SPtr<GUIMeshPatch>& patch)
+	{
+		SPtr<ct::VertexBuffer> vertexBuffer = mesh->getVertexData()->getBuffer(0);
+		SPtr<ct::IndexBuffer> indexBuffer = mesh->getIndexBuffer();
+
+		const UINT32 vertexStride = vertexBuffer->getProperties().getVertexSize();
+		const UINT32 indexSize = indexBuffer->getProperties().getIndexSize();
+
+		const UINT8* vertices = patch->vertices.data();
+		const UINT8* indices = patch->indices.data();
+		for(auto& range : patch->ranges)
+		{
+			const UINT32 vertexBytes = range.numVertices * vertexStride;
+			const UINT32 indexBytes = range.numIndices * indexSize;
+
+			vertexBuffer->writeData(range.vertexOffset * vertexStride, vertexBytes, vertices, BWT_NORMAL);
+			indexBuffer->writeData(range.indexOffset * indexSize, indexBytes, indices, BWT_NORMAL);
+
+			vertices += vertexBytes;
+			indices += indexBytes;
+		}
+	}
+
 	const UINT32 GUIManager::DRAG_DISTANCE = 3;
 	const float GUIManager::TOOLTIP_HOVER_TIME = 1.0f;
 
@@ -401,7 +451,7 @@ namespace bs
 
 				for (auto& entry : renderData.cachedMeshes)
 				{
-					const SPtr<Mesh>& mesh = entry.isLine ? renderData.lineMesh : renderData.triangleMesh;
+					const SPtr<Mesh>& mesh = renderData.meshes[entry.isLine ? 1 : 0];
 					if(!mesh)
 						continue;
 
@@ -447,283 +497,491 @@ namespace bs
 			GUIRenderData& renderData = cachedMeshData.second;
 
 			// Check if anything is dirty. If nothing is we can skip the update
-			bool isDirty = renderData.isDirty;
+			bool rebuild = renderData.isDirty;
 			renderData.isDirty = false;
 
+			mDirtyElements.clear();
 			for(auto& widget : renderData.widgets)
 			{
-				if (widget->isDirty(true))
-				{
-					isDirty = true;
-				}
+				if (widget->_updateDirtyElements(mDirtyElements))
+					rebuild = true;
 			}
 
-			if(!isDirty)
+			if(!rebuild && mDirtyElements.empty())
 				continue;
 
 			mCoreDirty = true;
 
-			bs_frame_mark();
+			// If only some elements changed try to write just their part of the meshes. Meshes only need to be regrouped
+			// if the change could affect batching, and the list of elements only needs to be rebuilt if elements were
+			// added or removed.
+			bool regroup = false;
+			if (!rebuild)
+				rebuild = !refreshRenderElements(renderData, mDirtyElements, regroup);
+
+			if (rebuild)
 			{
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
-				{
-					UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
-					UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
+				collectRenderElements(renderData);
+				regroup = true;
+			}
 
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-					return (aDepth > bDepth) || 
-						(aDepth == bDepth && a.element > b.element) || 
-						(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
-				};
+			mPatchedElements.clear();
+			if (regroup)
+				groupRenderElements(renderData);
+			else
+				patchRenderElements(renderData, mDirtyElements);
 
-				FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
+			uploadMeshes(renderData, regroup);
+		}
 
-				for (auto& widget : renderData.widgets)
-				{
-					const Vector<GUIElement*>& elements = widget->getElements();
+		mDirtyElements.clear();
+		mPatchedElements.clear();
+	}
 
-					for (auto& element : elements)
-					{
-						if (!element->_isVisible())
-							continue;
+	void GUIManager::readRenderElement(GUIRenderElementData& data)
+	{
+		GUIElement* element = data.element;
+		data.depth = element->_getRenderElementDepth(data.renderElement);
 
-						UINT32 numRenderElems = element->_getNumRenderElements();
-						for (UINT32 i = 0; i < numRenderElems; i++)
-						{
-							allElements.insert(GUIGroupElement(element, i));
-						}
-					}
+		SpriteMaterial* spriteMaterial = nullptr;
+		const SpriteMaterialInfo& matInfo = element->_getMaterial(data.renderElement, &spriteMaterial);
+		assert(spriteMaterial != nullptr);
+
+		data.material = spriteMaterial;
+		data.mergeHash = spriteMaterial->getMergeHash(matInfo);
+
+		element->_getMeshInfo(data.renderElement, data.numVertices, data.numIndices, data.meshType);
+
+		data.bounds = element->_getClippedBounds();
+		data.bounds.transform(element->_getParentWidget()->getWorldTfrm());
+	}
+
+	void GUIManager::collectRenderElements(GUIRenderData& renderData)
+	{
+		renderData.renderElements.clear();
+		renderData.elementLookup.clear();
+		renderData.isSortDirty = true;
+
+		for (auto& widget : renderData.widgets)
+		{
+			const Vector<GUIElement*>& elements = widget->getElements();
+
+			for (auto& element : elements)
+			{
+				if (!element->_isVisible())
+					continue;
+
+				UINT32 numRenderElems = element->_getNumRenderElements();
+				if (numRenderElems == 0)
+					continue;
+
+				GUIElementRange range;
+				range.start = (UINT32)renderData.renderElements.size();
+				range.count = numRenderElems;
+
+				renderData.elementLookup[element] = range;
+
+				for (UINT32 i = 0; i < numRenderElems; i++)
+				{
+					GUIRenderElementData data;
+					data.element = element;
+					data.renderElement = i;
+
+					readRenderElement(data);
+					renderData.renderElements.push_back(data);
 				}
+			}
+		}
+	}
+
+	bool GUIManager::refreshRenderElements(GUIRenderData& renderData, const Vector<GUIElement*>& dirtyElements, 
+		bool& regroup)
+	{
+		for (auto& element : dirtyElements)
+		{
+			auto iterFind = renderData.elementLookup.find(element);
+			if (iterFind == renderData.elementLookup.end())
+			{
+				// Element that wasn't rendered so far has become visible, or gained some contents
+				if (element->_isVisible() && element->_getNumRenderElements() > 0)
+					return false;
+
+				continue;
+			}
+
+			const GUIElementRange& range = iterFind->second;
+			if (!element->_isVisible() || element->_getNumRenderElements() != range.count)
+				return false;
+
+			for (UINT32 i = 0; i < range.count; i++)
+			{
+				GUIRenderElementData& data = renderData.renderElements[range.start + i];
+
+				const UINT32 oldDepth = data.depth;
+				const UINT64 oldMergeHash = data.mergeHash;
+				const SpriteMaterial* oldMaterial = data.material;
+				const GUIMeshType oldMeshType = data.meshType;
+				const UINT32 oldNumVertices = data.numVertices;
+				const UINT32 oldNumIndices = data.numIndices;
 
-				// Group the elements in such a way so that we end up with a smallest amount of
-				// meshes, without breaking back to front rendering order
-				FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
-				for (auto& elem : allElements)
+				readRenderElement(data);
+
+				if (data.depth != oldDepth)
+					renderData.isSortDirty = true;
+
+				if (regroup)
+					continue;
+
+				// Element can be written over its old data only if it occupies the same range of the mesh, and if the 
+				// conditions its mesh was grouped under still hold
+				if (data.depth != oldDepth || data.mergeHash != oldMergeHash || data.material != oldMaterial ||
+					data.meshType != oldMeshType || data.numVertices != oldNumVertices || data.numIndices != oldNumIndices)
 				{
-					GUIElement* guiElem = elem.element;
-					UINT32 renderElemIdx = elem.renderElement;
-					UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
+					regroup = true;
+					continue;
+				}
 
-					Rect2I tfrmedBounds = guiElem->_getClippedBounds();
-					tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
+				// Meshes were grouped so their bounds don't overlap other meshes in between them, which still holds as
+				// long as the element doesn't leave the bounds of its mesh
+				const Rect2I& meshBounds = renderData.cachedMeshes[data.meshIdx].bounds;
 
-					SpriteMaterial* spriteMaterial = nullptr;
-					const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
-					assert(spriteMaterial != nullptr);
+				Rect2I newMeshBounds = meshBounds;
+				newMeshBounds.encapsulate(data.bounds);
 
-					UINT64 hash = spriteMaterial->getMergeHash(matInfo);
-					FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
-					
-					// Try to find a group this material will fit in:
-					//  - Group that has a depth value same or one below elements depth will always be a match
-					//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
-					//    overlap the current elements bounds.
-					GUIMaterialGroup* foundGroup = nullptr;
+				if (newMeshBounds != meshBounds)
+					regroup = true;
+			}
+		}
+
+		return true;
+	}
+
+	void GUIManager::groupRenderElements(GUIRenderData& renderData)
+	{
+		const Vector<GUIRenderElementData>& renderElements = renderData.renderElements;
+
+		// Sort all render elements from farthest to nearest (highest depth to lowest)
+		if (renderData.isSortDirty)
+		{
+			const UINT32 numRenderElements = (UINT32)renderElements.size();
+
+			renderData.sortedElements.resize(numRenderElements);
+			for (UINT32 i = 0; i < numRenderElements; i++)
+				renderData.sortedElements[i] = i;
+
+			auto elemComp = [&renderElements](UINT32 aIdx, UINT32 bIdx)
+			{
+				const GUIRenderElementData& a = renderElements[aIdx];
+				const GUIRenderElementData& b = renderElements[bIdx];
+
+				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't 
+				// really matter, but we want the order to be the same every time the elements are grouped
+				return (a.depth > b.depth) || 
+					(a.depth == b.depth && a.element > b.element) || 
+					(a.depth == b.depth && a.element == b.element && a.renderElement > b.renderElement); 
+			};
+
+			std::sort(renderData.sortedElements.begin(), renderData.sortedElements.end(), elemComp);
+			renderData.isSortDirty = false;
+		}
+
+		bs_frame_mark();
+		{
+			// Group the elements in such a way so that we end up with a smallest amount of
+			// meshes, without breaking back to front rendering order
+			FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
+			for (auto& elemIdx : renderData.sortedElements)
+			{
+				const GUIRenderElementData& elem = renderElements[elemIdx];
+				GUIElement* guiElem = elem.element;
+
+				SpriteMaterial* spriteMaterial = nullptr;
+				const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(elem.renderElement, &spriteMaterial);
 
-					for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
+				FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[elem.mergeHash];
+				
+				// Try to find a group this material will fit in:
+				//  - Group that has a depth value same or one below elements depth will always be a match
+				//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
+				//    overlap the current elements bounds.
+				GUIMaterialGroup* foundGroup = nullptr;
+
+				for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
+				{
+					// If we separate meshes by widget, ignore any groups with widget parents other than mine
+					if (mSeparateMeshesByWidget)
 					{
-						// If we separate meshes by widget, ignore any groups with widget parents other than mine
-						if (mSeparateMeshesByWidget)
+						if (groupIter->elements.size() > 0)
 						{
-							if (groupIter->elements.size() > 0)
-							{
-								GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
-								if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
-									continue;
-							}
+							GUIElement* otherElem = renderElements[groupIter->elements[0]].element; // We only need to check the first element
+							if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
+								continue;
 						}
+					}
 
-						GUIMaterialGroup& group = *groupIter;
+					GUIMaterialGroup& group = *groupIter;
 
-						if (group.depth == elemDepth)
-						{
-							foundGroup = &group;
-							break;
-						}
-						else
-						{
-							UINT32 startDepth = elemDepth;
-							UINT32 endDepth = group.depth;
+					if (group.depth == elem.depth)
+					{
+						foundGroup = &group;
+						break;
+					}
+					else
+					{
+						UINT32 startDepth = elem.depth;
+						UINT32 endDepth = group.depth;
 
-							Rect2I potentialGroupBounds = group.bounds;
-							potentialGroupBounds.encapsulate(tfrmedBounds);
+						Rect2I potentialGroupBounds = group.bounds;
+						potentialGroupBounds.encapsulate(elem.bounds);
 
-							bool foundOverlap = false;
-							for (auto& material : materialGroups)
+						bool foundOverlap = false;
+						for (auto& material : materialGroups)
+						{
+							for (auto& matGroup : material.second)
 							{
-								for (auto& matGroup : material.second)
-								{
-									if (&matGroup == &group)
-										continue;
+								if (&matGroup == &group)
+									continue;
 
-									if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
-										|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
+								if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
+									|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
+								{
+									if (matGroup.bounds.overlaps(potentialGroupBounds))
 									{
-										if (matGroup.bounds.overlaps(potentialGroupBounds))
-										{
-											foundOverlap = true;
-											break;
-										}
+										foundOverlap = true;
+										break;
 									}
 								}
 							}
+						}
 
-							if (!foundOverlap)
-							{
-								foundGroup = &group;
-								break;
-							}
+						if (!foundOverlap)
+						{
+							foundGroup = &group;
+							break;
 						}
 					}
+				}
 
-					if (foundGroup == nullptr)
-					{
-						groupsPerMaterial.push_back(GUIMaterialGroup());
-						foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
+				if (foundGroup == nullptr)
+				{
+					groupsPerMaterial.push_back(GUIMaterialGroup());
+					foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
+
+					foundGroup->depth = elem.depth;
+					foundGroup->minDepth = elem.depth;
+					foundGroup->bounds = elem.bounds;
+					foundGroup->elements.push_back(elemIdx);
+					foundGroup->matInfo = matInfo.clone();
+					foundGroup->material = spriteMaterial;
+					foundGroup->meshType = elem.meshType;
+					foundGroup->numVertices = elem.numVertices;
+					foundGroup->numIndices = elem.numIndices;
+				}
+				else
+				{
+					foundGroup->bounds.encapsulate(elem.bounds);
+					foundGroup->elements.push_back(elemIdx);
+					foundGroup->minDepth = std::min(foundGroup->minDepth, elem.depth);
+					
+					assert(elem.meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
 
-						foundGroup->depth = elemDepth;
-						foundGroup->minDepth = elemDepth;
-						foundGroup->bounds = tfrmedBounds;
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->matInfo = matInfo.clone();
-						foundGroup->material = spriteMaterial;
+					foundGroup->numVertices += elem.numVertices;
+					foundGroup->numIndices += elem.numIndices;
 
-						guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
-					}
-					else
-					{
-						foundGroup->bounds.encapsulate(tfrmedBounds);
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
-						
-						UINT32 numVertices;
-						UINT32 numIndices;
-						GUIMeshType meshType;
-						guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
-						assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
-
-						foundGroup->numVertices += numVertices;
-						foundGroup->numIndices += numIndices;
-
-						spriteMaterial->merge(foundGroup->matInfo, matInfo);
-					}
+					spriteMaterial->merge(foundGroup->matInfo, matInfo);
 				}
+			}
+
+			UINT32 numIndices[2] = { 0, 0 };
+			UINT32 numVertices[2] = { 0, 0 };
 
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+			// Sort the groups from farthest to nearest (highest depth to lowest)
+			FrameVector<GUIMaterialGroup*> sortedGroups;
+			for(auto& material : materialGroups)
+			{
+				for(auto& group : material.second)
 				{
-					return (a->depth > b->depth) || (a->depth == b->depth && a > b);
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-				};
+					sortedGroups.push_back(&group);
+
+					UINT32 typeIdx = (UINT32)group.meshType;
+					numIndices[typeIdx] += group.numIndices;
+					numVertices[typeIdx] += group.numVertices;
+				}
+			}
 
-				UINT32 numMeshes = 0;
-				UINT32 numIndices[2] = { 0, 0 };
-				UINT32 numVertices[2] = { 0, 0 };
+			auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+			{
+				return (a->depth > b->depth) || (a->depth == b->depth && a > b);
+			};
 
-				FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
-				for(auto& material : materialGroups)
-				{
-					for(auto& group : material.second)
-					{
-						sortedGroups.insert(&group);
+			std::sort(sortedGroups.begin(), sortedGroups.end(), groupComp);
 
-						UINT32 typeIdx = (UINT32)group.meshType;
-						numIndices[typeIdx] += group.numIndices;
-						numVertices[typeIdx] += group.numVertices;
+			// Reuse the existing mesh data if the size didn't change
+			SPtr<VertexDataDesc> vertexDesc[2] = { mTriangleVertexDesc, mLineVertexDesc };
+			for(UINT32 i = 0; i < 2; i++)
+			{
+				SPtr<MeshData>& meshData = renderData.meshData[i];
 
-						numMeshes++;
+				if(numVertices[i] > 0 && numIndices[i] > 0)
+				{
+					if(meshData == nullptr || meshData->getNumVertices() != numVertices[i] || 
+						meshData->getNumIndices() != numIndices[i])
+					{
+						meshData = MeshData::create(numVertices[i], numIndices[i], vertexDesc[i]);
 					}
 				}
+				else
+					meshData = nullptr;
+			}
 
-				renderData.triangleMesh = nullptr;
-				renderData.lineMesh = nullptr;
+			// Fill buffers for each group, and remember where each element was written
+			renderData.cachedMeshes.resize(sortedGroups.size());
+
+			UINT32 meshIdx = 0;
+			UINT32 vertexOffset[2] = { 0, 0 };
+			UINT32 indexOffset[2] = { 0, 0 };
+
+			for(auto& group : sortedGroups)
+			{
+				GUIWidget* widget;
 
-				renderData.cachedMeshes.resize(numMeshes);
+				if (group->elements.size() == 0)
+					widget = nullptr;
+				else
+					widget = renderElements[group->elements[0]].element->_getParentWidget();
 
-				SPtr<MeshData> meshData[2];
-				SPtr<VertexDataDesc> vertexDesc[2] = { mTriangleVertexDesc, mLineVertexDesc };
+				GUIMeshData& guiMeshData = renderData.cachedMeshes[meshIdx];
+				guiMeshData.matInfo = group->matInfo;
+				guiMeshData.material = group->material;
+				guiMeshData.widget = widget;
+				guiMeshData.bounds = group->bounds;
+				guiMeshData.isLine = group->meshType == GUIMeshType::Line;
 
-				UINT8* vertices[2] = { nullptr, nullptr };
-				UINT32* indices[2] = { nullptr, nullptr };
+				UINT32 typeIdx = (UINT32)group->meshType;
+				guiMeshData.indexOffset = indexOffset[typeIdx];
 
-				for(UINT32 i = 0; i < 2; i++)
+				for(auto& elemIdx : group->elements)
 				{
-					if(numVertices[i] > 0 && numIndices[i] > 0)
-					{
-						meshData[i] = MeshData::create(numVertices[i], numIndices[i], vertexDesc[i]);
+					GUIRenderElementData& elem = renderData.renderElements[elemIdx];
+					elem.vertexOffset = vertexOffset[typeIdx];
+					elem.indexOffset = indexOffset[typeIdx];
+					elem.meshIdx = meshIdx;
 
-						vertices[i] = meshData[i]->getElementData(VES_POSITION);
-						indices[i] = meshData[i]->getIndices32();
-					}
+					fillMeshData(*renderData.meshData[typeIdx], elem.element, elem.renderElement, elem.vertexOffset, 
+						elem.indexOffset, elem.numIndices);
+
+					vertexOffset[typeIdx] += elem.numVertices;
+					indexOffset[typeIdx] += elem.numIndices;
 				}
 
-				// Fill buffers for each group and update their meshes
-				UINT32 meshIdx = 0;
-				UINT32 vertexOffset[2] = { 0, 0 };
-				UINT32 indexOffset[2] = { 0, 0 };
+				guiMeshData.indexCount = indexOffset[typeIdx] - guiMeshData.indexOffset;
 
-				for(auto& group : sortedGroups)
-				{
-					GUIWidget* widget;
+				meshIdx++;
+			}
+		}
+		bs_frame_clear();
+	}
 
-					if (group->elements.size() == 0)
-						widget = nullptr;
-					else
-					{
-						GUIElement* elem = group->elements.begin()->element;
-						widget = elem->_getParentWidget();
-					}
+	void GUIManager::patchRenderElements(GUIRenderData& renderData, const Vector<GUIElement*>& dirtyElements)
+	{
+		for (auto& element : dirtyElements)
+		{
+			auto iterFind = renderData.elementLookup.find(element);
+			if (iterFind == renderData.elementLookup.end())
+				continue;
 
-					GUIMeshData& guiMeshData = renderData.cachedMeshes[meshIdx];
-					guiMeshData.matInfo = group->matInfo;
-					guiMeshData.material = group->material;
-					guiMeshData.widget = widget;
-					guiMeshData.isLine = group->meshType == GUIMeshType::Line;
+			const GUIElementRange& range = iterFind->second;
+			for (UINT32 i = 0; i < range.count; i++)
+			{
+				const GUIRenderElementData& elem = renderData.renderElements[range.start + i];
+				const UINT32 typeIdx = (UINT32)elem.meshType;
 
-					UINT32 typeIdx = (UINT32)group->meshType;
-					guiMeshData.indexOffset = indexOffset[typeIdx];
+				fillMeshData(*renderData.meshData[typeIdx], elem.element, elem.renderElement, elem.vertexOffset, 
+					elem.indexOffset, elem.numIndices);
 
-					UINT32 groupNumIndices = 0;
-					for(auto& matElement : group->elements)
-					{
-						matElement.element->_fillBuffer(
-							vertices[typeIdx], indices[typeIdx], 
-							vertexOffset[typeIdx], indexOffset[typeIdx], 
-							numVertices[typeIdx], numIndices[typeIdx], matElement.renderElement);
+				mPatchedElements.push_back(range.start + i);
+			}
+		}
+	}
+
+	void GUIManager::uploadMeshes(GUIRenderData& renderData, bool regroup)
+	{
+		DrawOperationType drawOps[2] = { DOT_TRIANGLE_LIST, DOT_LINE_LIST };
+
+		// Gather the patched ranges of each mesh
+		SPtr<GUIMeshPatch> patches[2];
+		if(!regroup)
+		{
+			for(auto& elemIdx : mPatchedElements)
+			{
+				const GUIRenderElementData& elem = renderData.renderElements[elemIdx];
+				const UINT32 typeIdx = (UINT32)elem.meshType;
 
-						UINT32 elemNumVertices;
-						UINT32 elemNumIndices;
-						GUIMeshType meshType;
-						matElement.element->_getMeshInfo(matElement.renderElement, elemNumVertices, elemNumIndices, meshType);
+				const SPtr<MeshData>& meshData = renderData.meshData[typeIdx];
+				if(meshData == nullptr || elem.numVertices == 0 || elem.numIndices == 0)
+					continue;
 
-						UINT32 indexStart = indexOffset[typeIdx];
-						UINT32 indexEnd = indexStart + elemNumIndices;
+				SPtr<GUIMeshPatch>& patch = patches[typeIdx];
+				if(patch == nullptr)
+					patch = bs_shared_ptr_new<GUIMeshPatch>();
 
-						for(UINT32 i = indexStart; i < indexEnd; i++)
-							indices[typeIdx][i] += vertexOffset[typeIdx];
+				GUIMeshPatch::Range range;
+				range.vertexOffset = elem.vertexOffset;
+				range.numVertices = elem.numVertices;
+				range.indexOffset = elem.indexOffset;
+				range.numIndices = elem.numIndices;
 
-						indexOffset[typeIdx] += elemNumIndices;
-						vertexOffset[typeIdx] += elemNumVertices;
+				patch->ranges.push_back(range);
 
-						groupNumIndices += elemNumIndices;
-					}
+				// All vertex elements are in a single stream, starting with the position
+				const UINT32 vertexStride = meshData->getVertexDesc()->getVertexStride(0);
+				const UINT8* vertices = meshData->getElementData(VES_POSITION) + range.vertexOffset * vertexStride;
+				patch->vertices.insert(patch->vertices.end(), vertices, vertices + range.numVertices * vertexStride);
 
-					guiMeshData.indexCount = groupNumIndices;
+				const UINT8* indices = (const UINT8*)(meshData->getIndices32() + range.indexOffset);
+				patch->indices.insert(patch->indices.end(), indices, indices + range.numIndices * sizeof(UINT32));
+			}
+		}
 
-					meshIdx++;
-				}
+		for(UINT32 i = 0; i < 2; i++)
+		{
+			SPtr<Mesh>& mesh = renderData.meshes[i];
+
+			const SPtr<MeshData>& meshData = renderData.meshData[i];
+			if(meshData == nullptr)
+			{
+				mesh = nullptr;
+				continue;
+			}
+
+			// Layout didn't change, only write the ranges of the patched elements into the existing mesh
+			if(!regroup && mesh != nullptr)
+			{
+				if(patches[i] != nullptr)
+					gCoreThread().queueCommand(std::bind(&writeMeshPatch, mesh->getCore(), patches[i]));
+
+				continue;
+			}
 
-				if(meshData[0])
-					renderData.triangleMesh = Mesh::_createPtr(meshData[0], MU_STATIC, DOT_TRIANGLE_LIST);
+			// The mesh reads the data on the core thread, while we keep patching our copy, so it gets its own
+			SPtr<MeshData> uploadData = MeshData::create(meshData->getNumVertices(), meshData->getNumIndices(),
+				meshData->getVertexDesc());
+			memcpy(uploadData->getData(), meshData->getData(), meshData->getSize());
 
-				if(meshData[1])
-					renderData.lineMesh = Mesh::_createPtr(meshData[1], MU_STATIC, DOT_LINE_LIST);
+			// Only re-allocate if the regrouped data doesn't fit. The mesh is static, since dynamic buffers can only be
+			// written to in their entirety, while patches need to write to arbitrary ranges of it.
+			bool fits = false;
+			if(mesh != nullptr)
+			{
+				const MeshProperties& props = mesh->getProperties();
+				fits = props.getNumVertices() >= meshData->getNumVertices() && 
+					props.getNumIndices() >= meshData->getNumIndices();
 			}
 
-			bs_frame_clear();			
+			if(fits)
+				mesh->writeData(uploadData, false);
+			else
+				mesh = Mesh::_createPtr(uploadData, MU_STATIC, drawOps[i]);
 		}
 	}
 
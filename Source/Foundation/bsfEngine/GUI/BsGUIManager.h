@@ -12,6 +12,7 @@
 #include "Utility/BsModule.h"
 #include "Image/BsColor.h"
 #include "Math/BsMatrix4.h"
+#include "Math/BsRect2I.h"
 #include "Utility/BsEvent.h"
 #include "Material/BsMaterialParam.h"
 #include "Renderer/BsParamBlocks.h"
@@ -57,27 +58,75 @@ namespace bs
 			SpriteMaterial* material;
 			SpriteMaterialInfo matInfo;
 			GUIWidget* widget;
+			Rect2I bounds;
 			bool isLine;
 		};
 
+		/** 
+		 * Information about a single render element of a GUI element, cached when the element was last written to a GUI
+		 * mesh. Used for determining whether the element can be updated in place.
+		 */
+		struct GUIRenderElementData
+		{
+			GUIElement* element;
+			UINT32 renderElement;
+			UINT32 depth;
+			UINT64 mergeHash;
+			SpriteMaterial* material;
+			GUIMeshType meshType;
+			UINT32 numVertices;
+			UINT32 numIndices;
+			Rect2I bounds;
+
+			UINT32 vertexOffset = 0;
+			UINT32 indexOffset = 0;
+			UINT32 meshIdx = 0;
+		};
+
+		/** Range of entries in GUIRenderData::renderElements belonging to a single GUI element. */
+		struct GUIElementRange
+		{
+			UINT32 start;
+			UINT32 count;
+		};
+
 		/**	GUI render data for a single viewport. */
 		struct GUIRenderData
 		{
 			GUIRenderData()
-				:isDirty(true)
+				:isSortDirty(true), isDirty(true)
 			{ }
 
-			SPtr<Mesh> triangleMesh;
-			SPtr<Mesh> lineMesh;
+			/** 
+			 * Triangle and line meshes the GUI is rendered from, indexed by GUIMeshType. Kept alive between updates so dirty
+			 * elements can be written to them in place, and only re-created if the regrouped data no longer fits.
+			 */
+			SPtr<Mesh> meshes[2];
 			Vector<GUIMeshData> cachedMeshes;
 			Vector<GUIWidget*> widgets;
+
+			/** Render elements of all visible GUI elements, in the order their widgets and elements were visited. */
+			Vector<GUIRenderElementData> renderElements;
+
+			/** Indices into @p renderElements, sorted from farthest to nearest. */
+			Vector<UINT32> sortedElements;
+
+			/** Maps a GUI element to its render elements in @p renderElements. */
+			UnorderedMap<const GUIElement*, GUIElementRange> elementLookup;
+
+			/** 
+			 * Contents of the triangle and line meshes, as last uploaded. Dirty elements are patched in place when their 
+			 * size, material and depth don't change.
+			 */
+			SPtr<MeshData> meshData[2];
+			bool isSortDirty;
 			bool isDirty;
 		};
 
 		/**	Render data for a single GUI group used for notifying the core GUI renderer. */
 		struct GUICoreRenderData
 		{
-			SPtr<ct::Mesh> mesh;
+			SPtr<ct::MeshBase> mesh;
 			SubMesh subMesh;
 			SPtr<ct::Texture> texture;
 			SpriteMaterial* material;
@@ -241,6 +290,49 @@ namespace bs
 		/**	Recreates all dirty GUI meshes and makes them ready for rendering. */
 		void updateMeshes();
 
+		/** Refreshes the cached depth, material, mesh size and bounds of a render element. */
+		static void readRenderElement(GUIRenderElementData& data);
+
+		/** 
+		 * Rebuilds the list of render elements of all visible GUI elements in the provided viewport, and refreshes their 
+		 * cached information.
+		 */
+		void collectRenderElements(GUIRenderData& renderData);
+
+		/**
+		 * Refreshes cached information of the render elements belonging to the provided dirty GUI elements, and checks
+		 * whether their existing place in the GUI meshes can be reused.
+		 *
+		 * @param[in]	renderData		Render data of the viewport the elements belong to.
+		 * @param[in]	dirtyElements	Elements whose contents or meshes changed.
+		 * @param[out]	regroup			Set to true if the elements changed depth, material or size, or moved outside of 
+		 *								the bounds of their mesh, meaning the meshes need to be regrouped.
+		 * @return						False if elements were added or removed, meaning the entire list of render
+		 *								elements needs to be rebuilt.
+		 */
+		bool refreshRenderElements(GUIRenderData& renderData, const Vector<GUIElement*>& dirtyElements, bool& regroup);
+
+		/**
+		 * Sorts the render elements of the provided viewport, groups them into as few meshes as possible without breaking
+		 * the back to front order, and fills the mesh data of all the elements.
+		 */
+		void groupRenderElements(GUIRenderData& renderData);
+
+		/** 
+		 * Rewrites the mesh data of the provided elements, at the same location they were written at previously. Indices
+		 * of the rewritten render elements are appended to @p mPatchedElements.
+		 */
+		void patchRenderElements(GUIRenderData& renderData, const Vector<GUIElement*>& dirtyElements);
+
+		/** 
+		 * Uploads the current mesh data of the provided viewport to the GPU. 
+		 *
+		 * @param[in]	renderData	Render data of the viewport whose meshes to upload.
+		 * @param[in]	regroup		If true the layout of the meshes changed and their entire contents are uploaded. 
+		 *							Otherwise only the ranges of the render elements in @p mPatchedElements are written.
+		 */
+		void uploadMeshes(GUIRenderData& renderData, bool regroup);
+
 		/**	Recreates the input caret texture. */
 		void updateCaretTexture();
 
@@ -361,9 +453,6 @@ namespace bs
 		static const UINT32 DRAG_DISTANCE;
 		static const float TOOLTIP_HOVER_TIME;
 
-		static const UINT32 MESH_HEAP_INITIAL_NUM_VERTS;
-		static const UINT32 MESH_HEAP_INITIAL_NUM_INDICES;
-
 		Vector<WidgetInfo> mWidgets;
 		UnorderedMap<const Viewport*, GUIRenderData> mCachedGUIData;
 
@@ -373,6 +462,9 @@ namespace bs
 		SPtr<VertexDataDesc> mTriangleVertexDesc;
 		SPtr<VertexDataDesc> mLineVertexDesc;
 
+		Vector<GUIElement*> mDirtyElements;
+		Vector<UINT32> mPatchedElements;
+
 		Stack<GUIElement*> mScheduledForDestruction;
 
 		// Element and widget pointer is currently over
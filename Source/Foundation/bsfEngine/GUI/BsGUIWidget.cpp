@@ -83,6 +83,7 @@ namespace bs
 
 		mElements.clear();
 		mDirtyContents.clear();
+		mDirtyMeshes.clear();
 	}
 
 	void GUIWidget::setDepth(UINT8 depth)
@@ -122,7 +123,7 @@ namespace bs
 					mWidgetIsDirty = true;
 				else
 				{
-					if(Math::approxEquals(mScale, scale))
+					if(!Math::approxEquals(mScale, scale))
 						mWidgetIsDirty = true;
 				}
 			}
@@ -275,12 +276,18 @@ namespace bs
 		}
 
 		if (elem->_getType() == GUIElementBase::Type::Element)
+		{
 			mDirtyContents.erase(static_cast<GUIElement*>(elem));
+			mDirtyMeshes.erase(static_cast<GUIElement*>(elem));
+		}
 	}
 
 	void GUIWidget::_markMeshDirty(GUIElementBase* elem)
 	{
-		mWidgetIsDirty = true;
+		if (elem->_getType() == GUIElementBase::Type::Element)
+			mDirtyMeshes.insert(static_cast<GUIElement*>(elem));
+		else
+			mWidgetIsDirty = true;
 	}
 
 	void GUIWidget::_markContentDirty(GUIElementBase* elem)
@@ -342,7 +349,7 @@ namespace bs
 		if (!mIsActive)
 			return false;
 
-		bool dirty = mWidgetIsDirty || mDirtyContents.size() > 0;
+		bool dirty = mWidgetIsDirty || mDirtyContents.size() > 0 || mDirtyMeshes.size() > 0;
 
 		if(cleanIfDirty && dirty)
 		{
@@ -352,12 +359,43 @@ namespace bs
 				dirtyElement->_updateRenderElements();
 
 			mDirtyContents.clear();
+			mDirtyMeshes.clear();
 			updateBounds();
 		}
 		
 		return dirty;
 	}
 
+	bool GUIWidget::_updateDirtyElements(Vector<GUIElement*>& dirtyElements)
+	{
+		if (!mIsActive)
+			return false;
+
+		bool rebuild = mWidgetIsDirty;
+		if(!rebuild && mDirtyContents.empty() && mDirtyMeshes.empty())
+			return false;
+
+		mWidgetIsDirty = false;
+
+		for (auto& dirtyElement : mDirtyContents)
+		{
+			dirtyElement->_updateRenderElements();
+			dirtyElements.push_back(dirtyElement);
+		}
+
+		for (auto& dirtyElement : mDirtyMeshes)
+		{
+			if (mDirtyContents.find(dirtyElement) == mDirtyContents.end())
+				dirtyElements.push_back(dirtyElement);
+		}
+
+		mDirtyContents.clear();
+		mDirtyMeshes.clear();
+		updateBounds();
+
+		return rebuild;
+	}
+
 	bool GUIWidget::inBounds(const Vector2I& position) const
 	{
 		Viewport* target = getTarget();
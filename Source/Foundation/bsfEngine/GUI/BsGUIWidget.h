@@ -124,6 +124,8 @@ namespace bs
 
 		/**
 		 * Marks the widget mesh dirty requiring a mesh rebuild. Provided element is the one that requested the mesh update.
+		 * If the element is a GUIElement only its own part of the mesh is considered dirty, otherwise the entire widget
+		 * mesh is.
 		 */
 		void _markMeshDirty(GUIElementBase* elem);
 
@@ -133,6 +135,17 @@ namespace bs
 		 */
 		void _markContentDirty(GUIElementBase* elem);
 
+		/**
+		 * Updates render elements of all elements with dirty contents and marks the widget as clean. Unlike isDirty() 
+		 * this reports which elements changed, so their part of the widget mesh can be updated without rebuilding the 
+		 * rest.
+		 *
+		 * @param[out]	dirtyElements	Elements whose contents or meshes changed since the last call are appended here.
+		 * @return						True if the entire widget mesh needs to be rebuilt (e.g. elements were added or
+		 *								removed, or the widget moved), false otherwise.
+		 */
+		bool _updateDirtyElements(Vector<GUIElement*>& dirtyElements);
+
 		/**	Updates the layout of all child elements, repositioning and resizing them as needed. */
 		void _updateLayout();
 
@@ -200,6 +213,7 @@ namespace bs
 		HEvent mOwnerTargetResizedConn;
 
 		Set<GUIElement*> mDirtyContents;
+		Set<GUIElement*> mDirtyMeshes;
 
 		mutable UINT64 mCachedRTId;
 		mutable bool mWidgetIsDirty;
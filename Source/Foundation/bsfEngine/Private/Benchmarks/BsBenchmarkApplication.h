@@ -0,0 +1,127 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsApplication.h"
+#include "BsEngineConfig.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "Profiling/BsProfilingManager.h"
+
+namespace bs
+{
+	/**
+	 * Application used by the benchmark executables. Runs a fixed number of frames every time the main loop is ran, using
+	 * the null render API so benchmarks can run without a GPU.
+	 */
+	class BenchmarkApplication : public Application
+	{
+	public:
+		BenchmarkApplication(const START_UP_DESC& desc)
+			:Application(desc)
+		{ }
+
+		/**
+		 * Starts up the benchmark application, with a window of the specified title. Frame rate is not limited, so frames
+		 * run as fast as possible.
+		 */
+		static BenchmarkApplication& startUp(const String& title)
+		{
+			START_UP_DESC desc;
+			desc.renderAPI = "bsfNullRenderAPI";
+			desc.renderer = BS_RENDERER_MODULE;
+			desc.audio = BS_AUDIO_MODULE;
+			desc.physics = BS_PHYSICS_MODULE;
+			desc.scripting = false;
+			desc.importers.push_back("bsfSL");
+			desc.primaryWindowDesc.videoMode = VideoMode(1280, 720);
+			desc.primaryWindowDesc.fullscreen = false;
+			desc.primaryWindowDesc.title = title;
+
+			Application::startUp<BenchmarkApplication>(desc);
+
+			BenchmarkApplication& app = static_cast<BenchmarkApplication&>(gApplication());
+			app.setFPSLimit(1000000);
+
+			return app;
+		}
+
+		/**
+		 * Runs the main loop for the specified number of frames, and waits until the core thread renders them. Provided
+		 * callback is triggered at the start of every frame.
+		 */
+		void runFrames(UINT32 numFrames, const std::function<void()>& onFrame = nullptr)
+		{
+			mFramesLeft = numFrames;
+			mOnFrame = onFrame;
+			runMainLoop();
+
+			mOnFrame = nullptr;
+			gCoreThread().submitAll(true);
+		}
+
+	protected:
+		/** @copydoc Application::preUpdate */
+		void preUpdate() override
+		{
+			Application::preUpdate();
+
+			if(mOnFrame)
+				mOnFrame();
+		}
+
+		/** @copydoc Application::postUpdate */
+		void postUpdate() override
+		{
+			Application::postUpdate();
+
+			if(mFramesLeft > 0)
+				mFramesLeft--;
+
+			if(mFramesLeft == 0)
+				stopMainLoop();
+		}
+
+	private:
+		UINT32 mFramesLeft = 0;
+		std::function<void()> mOnFrame;
+	};
+
+	/** Returns the total time of all samples with the specified name in the hierarchy. */
+	inline double getSampleTime(const CPUProfilerBasicSamplingEntry& entry, const char* name)
+	{
+		double time = 0.0;
+		if(entry.data.name == name)
+			time += entry.data.totalTimeMs;
+
+		for(auto& child : entry.childEntries)
+			time += getSampleTime(child, name);
+
+		return time;
+	}
+
+	/** Adds the time of every sample in the hierarchy to the total for its name. */
+	inline void accumulateSamples(const CPUProfilerBasicSamplingEntry& entry, UnorderedMap<String, double>& totals)
+	{
+		totals[entry.data.name.c_str()] += entry.data.totalTimeMs;
+
+		for(auto& child : entry.childEntries)
+			accumulateSamples(child, totals);
+	}
+
+	/**
+	 * Returns the average time per frame in milliseconds of all samples with the specified name, over the last
+	 * @p numFrames frames reported by the profiler for the specified thread.
+	 */
+	inline double getAverageSampleTime(ProfiledThread thread, const char* name, UINT32 numFrames)
+	{
+		double totalTime = 0.0;
+		for(UINT32 i = 0; i < numFrames; i++)
+		{
+			const ProfilerReport& report = gProfiler().getReport(thread, i);
+			totalTime += getSampleTime(report.cpuReport.getBasicSamplingData(), name);
+		}
+
+		return totalTime / std::max(numFrames, 1U);
+	}
+}
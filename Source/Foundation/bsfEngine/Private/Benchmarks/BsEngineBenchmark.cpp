@@ -0,0 +1,421 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Benchmarks/BsBenchmarkApplication.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationManager.h"
+#include "Animation/BsSkeleton.h"
+#include "Components/BsCAnimation.h"
+#include "Components/BsCCamera.h"
+#include "Components/BsCRenderable.h"
+#include "GUI/BsCGUIWidget.h"
+#include "GUI/BsGUILabel.h"
+#include "GUI/BsGUIPanel.h"
+#include "Localization/BsHString.h"
+#include "Mesh/BsMesh.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+#include "Scene/BsSceneActor.h"
+#include "Scene/BsSceneManager.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsTransformStorage.h"
+#include "Utility/BsTimer.h"
+
+#include <iostream>
+#include <iomanip>
+
+using namespace bs;
+
+namespace
+{
+	/** Number of labels in the benchmark GUI. */
+	constexpr UINT32 NUM_GUI_ELEMENTS = 5000;
+
+	/** Fractions of GUI elements whose contents change every frame. */
+	constexpr float DIRTY_FRACTIONS[] = { 0.0f, 0.001f, 0.01f, 0.1f, 1.0f };
+
+	/** Number of distinct texts the labels cycle through. All of them have the same length. */
+	constexpr UINT32 NUM_TEXTS = 100;
+
+	/** Number of frames ran before measuring, letting the GUI build its initial meshes. */
+	constexpr UINT32 NUM_WARMUP_FRAMES = 10;
+
+	/** Number of frames measured per run. Must not be larger than the number of reports kept by the profiler. */
+	constexpr UINT32 NUM_FRAMES = 100;
+
+	/** Number of scene objects in the transform benchmark hierarchy. */
+	constexpr UINT32 NUM_TRANSFORM_OBJECTS = 100000;
+
+	/** Number of children of each scene object in the transform benchmark hierarchy. */
+	constexpr UINT32 NUM_TRANSFORM_CHILDREN = 8;
+
+	/** Number of frames measured per transform benchmark run. The fastest frame is reported. */
+	constexpr UINT32 NUM_TRANSFORM_FRAMES = 20;
+
+	/** Number of scene actors bound to scene objects in the actor benchmark. */
+	constexpr UINT32 NUM_BOUND_ACTORS = 150000;
+
+	/** Numbers of animated characters in each of the animation benchmark runs. */
+	constexpr UINT32 CHARACTER_COUNTS[] = { 250, 500, 1000, 2000, 4000 };
+
+	/** Number of bones in the skeleton of every animated character. */
+	constexpr UINT32 NUM_CHARACTER_BONES = 32;
+
+	/** 
+	 * Measures GUIManager mesh updates in a HUD-like GUI made out of many labels, while changing the text of a fraction
+	 * of them every frame.
+	 */
+	void runGUIBenchmark(BenchmarkApplication& app)
+	{
+		HSceneObject root = SceneObject::create("GUI");
+
+		HCamera camera = root->addComponent<CCamera>();
+		camera->setMain(true);
+
+		HGUIWidget widget = root->addComponent<CGUIWidget>(camera);
+		GUIPanel* panel = widget->getPanel();
+
+		Vector<HString> texts;
+		for(UINT32 i = 0; i < NUM_TEXTS; i++)
+		{
+			String text = "Item " + toString(i, 2, '0');
+			texts.push_back(HString(text));
+		}
+
+		// Lay the labels out in a grid, so they overlap each other the same way in every run
+		const UINT32 rowLength = (UINT32)std::ceil(std::sqrt((float)NUM_GUI_ELEMENTS));
+
+		Vector<GUILabel*> labels(NUM_GUI_ELEMENTS);
+		for(UINT32 i = 0; i < NUM_GUI_ELEMENTS; i++)
+		{
+			labels[i] = panel->addNewElement<GUILabel>(texts[i % NUM_TEXTS]);
+			labels[i]->setPosition((i % rowLength) * 16, (i / rowLength) * 10);
+			labels[i]->setSize(64, 16);
+		}
+
+		app.runFrames(NUM_WARMUP_FRAMES);
+
+		std::cout << NUM_GUI_ELEMENTS << " GUI labels" << std::endl;
+
+		UINT32 frameIdx = 0;
+		for(auto& dirtyFraction : DIRTY_FRACTIONS)
+		{
+			const UINT32 numDirty = (UINT32)(NUM_GUI_ELEMENTS * dirtyFraction);
+
+			// Change the text of a different set of labels every frame
+			app.runFrames(NUM_FRAMES, [&]()
+			{
+				for(UINT32 i = 0; i < numDirty; i++)
+				{
+					UINT32 labelIdx = (frameIdx * numDirty + i) % NUM_GUI_ELEMENTS;
+					labels[labelIdx]->setContent(GUIContent(texts[(labelIdx + frameIdx + 1) % NUM_TEXTS]));
+				}
+
+				frameIdx++;
+			});
+
+			const double frameTime = getAverageSampleTime(ProfiledThread::Sim, "UpdateMeshes", NUM_FRAMES);
+
+			std::cout << "  " << std::left << std::setw(24) << (toString(dirtyFraction * 100.0f) + "% dirty")
+				<< std::fixed << std::setprecision(3) << frameTime << " ms/frame" << std::endl;
+		}
+
+		root->destroy();
+	}
+
+	/** 
+	 * Returns the fastest time in milliseconds it takes to move every object in a large hierarchy and then retrieve all
+	 * of their world matrices, as the renderer would when syncing them.
+	 */
+	double measureTransformUpdate(bool useStorage)
+	{
+		if(useStorage)
+			TransformStorage::startUp();
+
+		HSceneObject root = SceneObject::create("Transforms");
+
+		Vector<HSceneObject> objects(NUM_TRANSFORM_OBJECTS);
+		for(UINT32 i = 0; i < NUM_TRANSFORM_OBJECTS; i++)
+		{
+			objects[i] = SceneObject::create("Object");
+
+			if(i == 0)
+				objects[i]->setParent(root);
+			else
+				objects[i]->setParent(objects[(i - 1) / NUM_TRANSFORM_CHILDREN]);
+		}
+
+		UINT64 bestTime = std::numeric_limits<UINT64>::max();
+		for(UINT32 i = 0; i < NUM_TRANSFORM_FRAMES; i++)
+		{
+			Timer timer;
+
+			const Radian angle(i * 0.01f);
+			for(UINT32 j = 0; j < NUM_TRANSFORM_OBJECTS; j++)
+			{
+				objects[j]->setPosition(Vector3((float)(j % 16), (float)i, 0.0f));
+				objects[j]->setRotation(Quaternion(Vector3::UNIT_Y, angle));
+			}
+
+			if(useStorage)
+				TransformStorage::instance().update();
+
+			float sum = 0.0f;
+			for(UINT32 j = 0; j < NUM_TRANSFORM_OBJECTS; j++)
+				sum += objects[j]->getWorldMatrix()[0][3];
+
+			bestTime = std::min(bestTime, timer.getMicroseconds());
+
+			// Make sure the reads aren't optimized out
+			if(sum == std::numeric_limits<float>::max())
+				std::cout << sum << std::endl;
+		}
+
+		root->destroy(true);
+
+		if(useStorage)
+			TransformStorage::shutDown();
+
+		return bestTime / 1000.0;
+	}
+
+	/** 
+	 * Compares updating transforms of a large moving hierarchy through scene objects, against updating them in batches
+	 * through the TransformStorage.
+	 */
+	void runTransformBenchmark()
+	{
+		const double inlineTime = measureTransformUpdate(false);
+		const double storageTime = measureTransformUpdate(true);
+
+		std::cout << NUM_TRANSFORM_OBJECTS << " moving scene objects" << std::endl;
+		std::cout << "  " << std::left << std::setw(24) << "Scene objects" << std::fixed << std::setprecision(3)
+			<< inlineTime << " ms/frame" << std::endl;
+		std::cout << "  " << std::left << std::setw(24) << "Transform storage" << std::fixed << std::setprecision(3)
+			<< storageTime << " ms/frame" << std::endl;
+	}
+
+
+	/** 
+	 * Measures the time the scene manager takes to transfer scene object changes to bound scene actors, while moving a 
+	 * fraction of the scene objects every frame.
+	 */
+	void runActorBenchmark()
+	{
+		HSceneObject root = SceneObject::create("Actors");
+
+		Vector<HSceneObject> objects(NUM_BOUND_ACTORS);
+		Vector<SPtr<SceneActor>> actors(NUM_BOUND_ACTORS);
+		for(UINT32 i = 0; i < NUM_BOUND_ACTORS; i++)
+		{
+			objects[i] = SceneObject::create("Actor");
+			objects[i]->setParent(root);
+			objects[i]->setPosition(Vector3((float)(i % 256), 0.0f, (float)(i / 256)));
+
+			actors[i] = bs_shared_ptr_new<SceneActor>();
+			gSceneManager()._bindActor(actors[i], objects[i]);
+		}
+
+		// Transfer the initial state
+		gSceneManager()._updateCoreObjectTransforms();
+
+		std::cout << NUM_BOUND_ACTORS << " bound scene actors" << std::endl;
+
+		UINT32 frameIdx = 0;
+		for(auto& dirtyFraction : DIRTY_FRACTIONS)
+		{
+			const UINT32 numDirty = (UINT32)(NUM_BOUND_ACTORS * dirtyFraction);
+
+			UINT64 totalTime = 0;
+			for(UINT32 i = 0; i < NUM_FRAMES; i++)
+			{
+				// Move a different set of objects every frame
+				for(UINT32 j = 0; j < numDirty; j++)
+				{
+					UINT32 objectIdx = (frameIdx * numDirty + j) % NUM_BOUND_ACTORS;
+					objects[objectIdx]->move(Vector3(0.0f, 0.01f, 0.0f));
+				}
+
+				Timer timer;
+				gSceneManager()._updateCoreObjectTransforms();
+				totalTime += timer.getMicroseconds();
+
+				frameIdx++;
+			}
+
+			std::cout << "  " << std::left << std::setw(24) << (toString(dirtyFraction * 100.0f) + "% dirty")
+				<< std::fixed << std::setprecision(3) << totalTime / 1000.0 / NUM_FRAMES << " ms/frame" << std::endl;
+		}
+
+		for(auto& entry : actors)
+			gSceneManager()._unbindActor(entry);
+
+		root->destroy(true);
+	}
+
+	/** 
+	 * Creates a skinned mesh representing a column of segments, where each segment is fully influenced by one bone of a
+	 * chain of NUM_CHARACTER_BONES bones.
+	 */
+	HMesh createCharacterMesh()
+	{
+		BONE_DESC bones[NUM_CHARACTER_BONES];
+		for(UINT32 i = 0; i < NUM_CHARACTER_BONES; i++)
+		{
+			bones[i].name = "Bone" + toString(i);
+			bones[i].parent = i > 0 ? i - 1 : (UINT32)-1;
+			bones[i].localTfrm = Transform(i > 0 ? Vector3(0.0f, 0.1f, 0.0f) : Vector3::ZERO, Quaternion::IDENTITY,
+				Vector3::ONE);
+			bones[i].invBindPose = Matrix4::translation(Vector3(0.0f, -0.1f * i, 0.0f));
+		}
+
+		SPtr<VertexDataDesc> vertexDesc = VertexDataDesc::create();
+		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+		vertexDesc->addVertElem(VET_FLOAT3, VES_NORMAL);
+		vertexDesc->addVertElem(VET_FLOAT4, VES_TANGENT);
+		vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD);
+		vertexDesc->addVertElem(VET_FLOAT4, VES_BLEND_WEIGHTS);
+		vertexDesc->addVertElem(VET_UBYTE4, VES_BLEND_INDICES);
+
+		// Every segment is a quad
+		const UINT32 numVertices = NUM_CHARACTER_BONES * 4;
+		const UINT32 numIndices = NUM_CHARACTER_BONES * 6;
+
+		Vector<Vector3> positions(numVertices);
+		Vector<Vector3> normals(numVertices, Vector3::UNIT_Z);
+		Vector<Vector4> tangents(numVertices, Vector4(1.0f, 0.0f, 0.0f, 1.0f));
+		Vector<Vector2> uvs(numVertices, Vector2::ZERO);
+		Vector<Vector4> weights(numVertices, Vector4(1.0f, 0.0f, 0.0f, 0.0f));
+		Vector<UINT32> boneIndices(numVertices);
+
+		SPtr<MeshData> meshData = MeshData::create(numVertices, numIndices, vertexDesc);
+		UINT32* indices = meshData->getIndices32();
+
+		for(UINT32 i = 0; i < NUM_CHARACTER_BONES; i++)
+		{
+			const float bottom = 0.1f * i;
+			const float top = bottom + 0.1f;
+
+			positions[i * 4 + 0] = Vector3(-0.1f, bottom, 0.0f);
+			positions[i * 4 + 1] = Vector3(0.1f, bottom, 0.0f);
+			positions[i * 4 + 2] = Vector3(0.1f, top, 0.0f);
+			positions[i * 4 + 3] = Vector3(-0.1f, top, 0.0f);
+
+			for(UINT32 j = 0; j < 4; j++)
+				boneIndices[i * 4 + j] = i;
+
+			const UINT32 indexData[] = { 0, 1, 2, 0, 2, 3 };
+			for(UINT32 j = 0; j < 6; j++)
+				indices[i * 6 + j] = i * 4 + indexData[j];
+		}
+
+		meshData->setVertexData(VES_POSITION, positions.data(), numVertices * sizeof(Vector3));
+		meshData->setVertexData(VES_NORMAL, normals.data(), numVertices * sizeof(Vector3));
+		meshData->setVertexData(VES_TANGENT, tangents.data(), numVertices * sizeof(Vector4));
+		meshData->setVertexData(VES_TEXCOORD, uvs.data(), numVertices * sizeof(Vector2));
+		meshData->setVertexData(VES_BLEND_WEIGHTS, weights.data(), numVertices * sizeof(Vector4));
+		meshData->setVertexData(VES_BLEND_INDICES, boneIndices.data(), numVertices * sizeof(UINT32));
+
+		MESH_DESC desc;
+		desc.numVertices = numVertices;
+		desc.numIndices = numIndices;
+		desc.vertexDesc = vertexDesc;
+		desc.skeleton = Skeleton::create(bones, NUM_CHARACTER_BONES);
+
+		return Mesh::create(meshData, desc);
+	}
+
+	/** Creates an animation clip that sways every bone of the character mesh back and forth. */
+	HAnimationClip createCharacterClip()
+	{
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		for(UINT32 i = 0; i < NUM_CHARACTER_BONES; i++)
+		{
+			const Quaternion left(Vector3::UNIT_Z, Degree(-5.0f));
+			const Quaternion right(Vector3::UNIT_Z, Degree(5.0f));
+
+			Vector<TKeyframe<Quaternion>> keyframes =
+			{
+				{ left, Quaternion::ZERO, Quaternion::ZERO, 0.0f },
+				{ right, Quaternion::ZERO, Quaternion::ZERO, 0.5f },
+				{ left, Quaternion::ZERO, Quaternion::ZERO, 1.0f }
+			};
+
+			curves->addRotationCurve("Bone" + toString(i), TAnimationCurve<Quaternion>(keyframes));
+		}
+
+		return AnimationClip::create(curves);
+	}
+
+	/** 
+	 * Measures the frame time of a scene with an increasing number of skinned characters, each playing an animation.
+	 * Characters are laid out in a grid in front of the camera, so some of them are outside of the frustum and get 
+	 * culled.
+	 */
+	void runAnimationBenchmark(BenchmarkApplication& app)
+	{
+		HMesh mesh = createCharacterMesh();
+		HAnimationClip clip = createCharacterClip();
+
+		// Evaluate animation every frame, rather than at the default 60 times per second
+		gAnimation().setUpdateRate(1000000);
+
+		std::cout << NUM_CHARACTER_BONES << " bone animated characters" << std::endl;
+
+		for(auto& numCharacters : CHARACTER_COUNTS)
+		{
+			HSceneObject root = SceneObject::create("Characters");
+
+			const UINT32 rowLength = (UINT32)std::ceil(std::sqrt((float)numCharacters));
+			for(UINT32 i = 0; i < numCharacters; i++)
+			{
+				HSceneObject so = SceneObject::create("Character");
+				so->setParent(root);
+				so->setPosition(Vector3((i % rowLength) * 1.0f - rowLength * 0.5f, 0.0f, (i / rowLength) * -1.0f));
+
+				HRenderable renderable = so->addComponent<CRenderable>();
+				renderable->setMesh(mesh);
+
+				HAnimation animation = so->addComponent<CAnimation>();
+				animation->play(clip);
+			}
+
+			HSceneObject cameraSO = SceneObject::create("Camera");
+			cameraSO->setParent(root);
+			cameraSO->setPosition(Vector3(0.0f, 10.0f, 10.0f));
+			cameraSO->lookAt(Vector3(0.0f, 0.0f, -20.0f));
+
+			HCamera camera = cameraSO->addComponent<CCamera>();
+			camera->setMain(true);
+
+			app.runFrames(NUM_WARMUP_FRAMES);
+
+			Timer timer;
+			app.runFrames(NUM_FRAMES);
+			const double frameTime = timer.getMicroseconds() / 1000.0 / NUM_FRAMES;
+
+			const double cullTime = getAverageSampleTime(ProfiledThread::Sim, "AnimationCull", NUM_FRAMES);
+			const double waitTime = getAverageSampleTime(ProfiledThread::Sim, "AnimationWait", NUM_FRAMES);
+
+			std::cout << "  " << std::left << std::setw(24) << (toString(numCharacters) + " characters")
+				<< std::fixed << std::setprecision(3) << frameTime << " ms/frame (cull " << cullTime << " ms, wait "
+				<< waitTime << " ms)" << std::endl;
+
+			root->destroy();
+		}
+
+		gAnimation().setUpdateRate(60);
+	}
+}
+
+int main()
+{
+	BenchmarkApplication& app = BenchmarkApplication::startUp("Engine benchmark");
+
+	runGUIBenchmark(app);
+	runTransformBenchmark();
+	runActorBenchmark();
+	runAnimationBenchmark(app);
+
+	Application::shutDown();
+	return 0;
+}
@@ -7,8 +7,6 @@
 #include "Material/BsMaterial.h"
 #include "Renderer/BsRenderableElement.h"
 
-using namespace std::placeholders;
-
 namespace bs { namespace ct
 {
 	RenderQueue::RenderQueue(StateReduction mode)
@@ -17,11 +15,28 @@ namespace bs { namespace ct
 
 	}
 
+	/** 
+	 * Converts a floating point value into an unsigned integer that compares in the same order, and keeps its top 24 
+	 * bits. 
+	 */
+	static UINT64 quantizeDistance(float distance)
+	{
+		// Ensure negative zero doesn't end up sorted before positive zero
+		distance += 0.0f;
+
+		UINT32 bits;
+		memcpy(&bits, &distance, sizeof(bits));
+
+		// Flip all the bits of negative values, and just the sign bit of positive ones
+		bits ^= (bits & 0x80000000) ? 0xFFFFFFFF : 0x80000000;
+		return bits >> 8;
+	}
+
 	void RenderQueue::clear()
 	{
 		mSortableElements.clear();
-		mSortableElementIdx.clear();
 		mElements.clear();
+		mNumPasses = 0;
 
 		mSortedRenderElements.clear();
 	}
@@ -31,6 +46,7 @@ namespace bs { namespace ct
 		SPtr<Material> material = element->material;
 		SPtr<Shader> shader = material->getShader();
 
+		UINT32 elementIdx = (UINT32)mElements.size();
 		mElements.push_back(element);
 		
 		UINT32 queuePriority = shader->getQueuePriority();
@@ -51,69 +67,111 @@ namespace bs { namespace ct
 		}
 
 		UINT32 numPasses = material->getNumPasses();
+		UINT32 numSortablePasses = numPasses;
 		if (!separablePasses)
-			numPasses = std::min(1U, numPasses);
+			numSortablePasses = std::min(1U, numPasses);
 
-		for (UINT32 i = 0; i < numPasses; i++)
+		for (UINT32 i = 0; i < numSortablePasses; i++)
 		{
-			UINT32 idx = (UINT32)mSortableElementIdx.size();
-			mSortableElementIdx.push_back(idx);
-
 			mSortableElements.push_back(SortableElement());
 			SortableElement& sortableElem = mSortableElements.back();
 
-			sortableElem.seqIdx = idx;
+			sortableElem.elementIdx = elementIdx;
 			sortableElem.priority = queuePriority;
 			sortableElem.shaderId = shaderId;
 			sortableElem.passIdx = i;
+			sortableElem.numPasses = separablePasses ? 1 : numPasses;
+			sortableElem.separablePasses = separablePasses;
 			sortableElem.distFromCamera = distFromCamera;
 		}
+
+		mNumPasses += numPasses;
 	}
 
-	void RenderQueue::sort()
+	void RenderQueue::generateSortKeys()
 	{
-		std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)> sortMethod;
+		const UINT32 numElements = (UINT32)mSortableElements.size();
 
-		switch (mStateReductionMode)
+		// Priorities can use the entire 32-bit range, so they are replaced with their rank among the priorities present in
+		// the queue. Queues generally contain only a few distinct priorities, so a linear search is fine.
+		mPriorities.clear();
+		for (UINT32 i = 0; i < numElements; i++)
 		{
-		case StateReduction::None:
-			sortMethod = &elementSorterNoGroup;
-			break;
-		case StateReduction::Material:
-			sortMethod = &elementSorterPreferGroup;
-			break;
-		case StateReduction::Distance:
-			sortMethod = &elementSorterPreferSort;
-			break;
+			const INT32 priority = mSortableElements[i].priority;
+			if (i > 0 && priority == mSortableElements[i - 1].priority)
+				continue;
+
+			if (std::find(mPriorities.begin(), mPriorities.end(), priority) == mPriorities.end())
+				mPriorities.push_back(priority);
 		}
 
-		// Sort only indices since we generate an entirely new data set anyway, it doesn't make sense to move sortable elements
-		std::sort(mSortableElementIdx.begin(), mSortableElementIdx.end(), std::bind(sortMethod, _1, _2, mSortableElements));
+		// Higher priorities are rendered first, and receive a lower rank
+		std::sort(mPriorities.begin(), mPriorities.end(), std::greater<INT32>());
 
-		UINT32 prevShaderId = (UINT32)-1;
-		UINT32 prevPassIdx = (UINT32)-1;
-		RenderableElement* renderElem = nullptr;
-		INT32 currentElementIdx = -1;
-		UINT32 numPassesInCurrentElement = 0;
-		bool separablePasses = true;
-		for (UINT32 i = 0; i < (UINT32)mSortableElementIdx.size(); i++)
+		INT32 lastPriority = 0;
+		UINT64 lastRank = (UINT64)-1;
+		for (UINT32 i = 0; i < numElements; i++)
 		{
-			UINT32 idx = mSortableElementIdx[i];
+			const SortableElement& elem = mSortableElements[i];
 
-			while (numPassesInCurrentElement == 0)
+			if (elem.priority != lastPriority || lastRank == (UINT64)-1)
 			{
-				currentElementIdx++;
-				renderElem = mElements[currentElementIdx];
-				numPassesInCurrentElement = renderElem->material->getNumPasses();
-				separablePasses = renderElem->material->getShader()->getAllowSeparablePasses();
+				auto iterFind = std::lower_bound(mPriorities.begin(), mPriorities.end(), elem.priority, 
+					std::greater<INT32>());
+
+				// Only 8 bits are available for the rank, any further priorities get grouped together
+				lastRank = std::min((UINT64)(iterFind - mPriorities.begin()), (UINT64)0xFF);
+				lastPriority = elem.priority;
 			}
 
-			const SortableElement& elem = mSortableElements[idx];
-			if (separablePasses)
+			const UINT64 distance = quantizeDistance(elem.distFromCamera);
+			const UINT64 shaderId = elem.shaderId & 0xFFFFFF;
+			const UINT64 passIdx = std::min(elem.passIdx, 0xFFU);
+
+			// Bits 56-63 contain the priority rank, followed by a 24-bit distance, a 24-bit shader ID and an 8-bit pass 
+			// index, with the order of the last three determined by the state reduction mode. Elements with equal keys
+			// keep the order they were added in, as the sort is stable.
+			UINT64 key = lastRank << 56;
+			switch (mStateReductionMode)
 			{
-				mSortedRenderElements.push_back(RenderQueueElement());
+			case StateReduction::None:
+				key |= distance << 32;
+				break;
+			case StateReduction::Material:
+				key |= (shaderId << 32) | (passIdx << 24) | distance;
+				break;
+			case StateReduction::Distance:
+				key |= (distance << 32) | (shaderId << 8) | passIdx;
+				break;
+			}
+
+			mSortKeys[i] = key;
+			mSortedIndices[i] = i;
+		}
+	}
+
+	void RenderQueue::sort()
+	{
+		const UINT32 numElements = (UINT32)mSortableElements.size();
+		mSortKeys.resize(numElements);
+		mSortedIndices.resize(numElements);
 
-				RenderQueueElement& sortedElem = mSortedRenderElements.back();
+		generateSortKeys();
+		mRadixSort.sort(mSortKeys.data(), mSortedIndices.data(), numElements);
+
+		mSortedRenderElements.resize(mNumPasses);
+
+		UINT32 prevShaderId = (UINT32)-1;
+		UINT32 prevPassIdx = (UINT32)-1;
+		UINT32 outputIdx = 0;
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			const SortableElement& elem = mSortableElements[mSortedIndices[i]];
+			RenderableElement* renderElem = mElements[elem.elementIdx];
+
+			if (elem.separablePasses)
+			{
+				RenderQueueElement& sortedElem = mSortedRenderElements[outputIdx++];
 				sortedElem.renderElem = renderElem;
 				sortedElem.passIdx = elem.passIdx;
 
@@ -125,16 +183,12 @@ namespace bs { namespace ct
 				}
 				else
 					sortedElem.applyPass = false;
-
-				numPassesInCurrentElement--;
 			}
 			else
 			{
-				for (UINT32 j = 0; j < numPassesInCurrentElement; j++)
+				for (UINT32 j = 0; j < elem.numPasses; j++)
 				{
-					mSortedRenderElements.push_back(RenderQueueElement());
-
-					RenderQueueElement& sortedElem = mSortedRenderElements.back();
+					RenderQueueElement& sortedElem = mSortedRenderElements[outputIdx++];
 					sortedElem.renderElem = renderElem;
 					sortedElem.passIdx = j;
 					sortedElem.applyPass = true;
@@ -142,66 +196,10 @@ namespace bs { namespace ct
 					prevShaderId = elem.shaderId;
 					prevPassIdx = j;
 				}
-
-				numPassesInCurrentElement = 0;
-			}			
+			}
 		}
-	}
 
-	bool RenderQueue::elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
-	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
-	}
-
-	bool RenderQueue::elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
-	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-		
-		UINT8 isHigher = (a.priority > b.priority) << 4 |
-			(a.shaderId < b.shaderId) << 3 |
-			(a.passIdx < b.passIdx) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 4 |
-			(a.shaderId > b.shaderId) << 3 |
-			(a.passIdx > b.passIdx) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
-	}
-
-	bool RenderQueue::elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
-	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 4 | 
-			(a.distFromCamera < b.distFromCamera) << 3 | 
-			(a.shaderId < b.shaderId) << 2 | 
-			(a.passIdx < b.passIdx) << 1 | 
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 4 |
-			(a.distFromCamera > b.distFromCamera) << 3 |
-			(a.shaderId > b.shaderId) << 2 |
-			(a.passIdx > b.passIdx) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
+		assert(outputIdx == mNumPasses);
 	}
 
 	const Vector<RenderQueueElement>& RenderQueue::getSortedElements() const
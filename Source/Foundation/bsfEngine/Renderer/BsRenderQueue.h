@@ -5,6 +5,7 @@
 #include "BsPrerequisites.h"
 #include "Math/BsVector3.h"
 #include "RenderAPI/BsSubMesh.h"
+#include "Utility/BsRadixSort.h"
 
 namespace bs { namespace ct
 {
@@ -38,17 +39,22 @@ namespace bs { namespace ct
 	 * Render objects determines rendering order of objects contained within it. Rendering order is determined by object
 	 * material, and can influence rendering of transparent or opaque objects, or be used to improve performance by grouping
 	 * similar objects together.
+	 *
+	 * Each queued pass is assigned a 64-bit sort key packing its priority, shader, pass and distance from the camera, in
+	 * the order determined by the StateReduction mode. Keys are then radix sorted. All storage is retained between frames.
 	 */
 	class BS_EXPORT RenderQueue
 	{
 		/**	Data used for renderable element sorting. Represents a single pass for a single mesh. */
 		struct SortableElement
 		{
-			UINT32 seqIdx;
+			UINT32 elementIdx;
 			INT32 priority;
 			float distFromCamera;
 			UINT32 shaderId;
 			UINT32 passIdx;
+			UINT32 numPasses;
+			bool separablePasses;
 		};
 
 	public:
@@ -79,21 +85,24 @@ namespace bs { namespace ct
 		void setStateReduction(StateReduction mode) { mStateReductionMode = mode; }
 
 	protected:
-		/**	Callback used for sorting elements with no material grouping. */
-		static bool elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
-
-		/**	Callback used for sorting elements with preferred material grouping. */
-		static bool elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
-
-		/**	Callback used for sorting elements with material grouping after sorting. */
-		static bool elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/** 
+		 * Generates a sort key for every sortable element, according to the current state reduction mode. Elements that
+		 * should be rendered first receive lower keys.
+		 */
+		void generateSortKeys();
 
 		Vector<SortableElement> mSortableElements;
-		Vector<UINT32> mSortableElementIdx;
 		Vector<RenderableElement*> mElements;
+		UINT32 mNumPasses = 0;
 
 		Vector<RenderQueueElement> mSortedRenderElements;
 		StateReduction mStateReductionMode;
+
+		// Transient
+		Vector<UINT64> mSortKeys;
+		Vector<UINT32> mSortedIndices;
+		Vector<INT32> mPriorities;
+		RadixSort mRadixSort;
 	};
 
 	/** @} */
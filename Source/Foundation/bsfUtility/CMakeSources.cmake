@@ -4,6 +4,7 @@ set(BS_UTILITY_INC_THREADING
 	"bsfUtility/Threading/BsSpinLock.h"
 	"bsfUtility/Threading/BsThreadPool.h"
 	"bsfUtility/Threading/BsTaskScheduler.h"
+	"bsfUtility/Threading/BsJobScheduler.h"
 )
 
 set(BS_UTILITY_SRC_THIRDPARTY
@@ -50,6 +51,8 @@ set(BS_UTILITY_SRC_UTILITY
 	"bsfUtility/Utility/BsCompression.cpp"
 	"bsfUtility/Utility/BsTriangulation.cpp"
 	"bsfUtility/Utility/BsUUID.cpp"
+	"bsfUtility/Utility/BsCullingOctree.cpp"
+	"bsfUtility/Utility/BsRadixSort.cpp"
 )
 
 set(BS_UTILITY_INC_DEBUG
@@ -73,6 +76,7 @@ set(BS_UTILITY_SRC_FILESYSTEM
 set(BS_UTILITY_SRC_THREADING
 	"bsfUtility/Threading/BsAsyncOp.cpp"
 	"bsfUtility/Threading/BsTaskScheduler.cpp"
+	"bsfUtility/Threading/BsJobScheduler.cpp"
 	"bsfUtility/Threading/BsThreadPool.cpp"
 )
 
@@ -96,6 +100,8 @@ set(BS_UTILITY_INC_UTILITY
 	"bsfUtility/Utility/BsNonCopyable.h"
 	"bsfUtility/Utility/BsUUID.h"
 	"bsfUtility/Utility/BsOctree.h"
+	"bsfUtility/Utility/BsCullingOctree.h"
+	"bsfUtility/Utility/BsRadixSort.h"
 	"bsfUtility/Utility/BsDataBlob.h"
 )
 
@@ -309,6 +309,19 @@ namespace bs
 		}
 	}
 
+	MappedFileDataStream::~MappedFileDataStream()
+	{
+		close();
+	}
+
+	SPtr<DataStream> MappedFileDataStream::clone(bool copyData) const
+	{
+		if (!copyData)
+			return bs_shared_ptr_new<MemoryDataStream>(mData, mSize, false);
+
+		return bs_shared_ptr_new<MappedFileDataStream>(mPath, mAccessPattern);
+	}
+
 	FileDataStream::FileDataStream(const Path& path, AccessMode accessMode, bool freeOnClose)
 		: DataStream(accessMode), mPath(path), mFreeOnClose(freeOnClose)
 	{
@@ -18,6 +18,14 @@ namespace bs
 		UTF16 = 2
 	};
 
+	/** Describes how the data of a memory mapped file is going to be accessed. Used as a hint for the OS. */
+	enum class FileAccessPattern
+	{
+		Normal, /**< No particular access pattern. */
+		Sequential, /**< Data will be read from start to end. It will be paged in ahead of reads. */
+		Random /**< Data will be accessed in random order. Data around the accessed locations won't be read ahead. */
+	};
+
 	/**
 	 * General purpose class used for encapsulating the reading and writing of data from and to various sources using a 
 	 * common interface.
@@ -50,6 +58,12 @@ namespace bs
 		virtual bool isWriteable() const { return (mAccess & WRITE) != 0; }
 		virtual bool isFile() const = 0;
 
+		/** 
+		 * Returns true if the stream data is a memory mapped file. Memory of such streams stays valid for as long as the
+		 * stream is referenced, and can be referenced directly instead of being copied.
+		 */
+		virtual bool isMapped() const { return false; }
+
 		/** Reads data from the buffer and copies it to the specified value. */
 		template<typename T> DataStream& operator>>(T& val);
 
@@ -229,6 +243,45 @@ namespace bs
 		bool mFreeOnClose;
 	};
 
+	/** 
+	 * Data stream for reading a file mapped into memory. File contents are paged in by the OS as they are accessed instead
+	 * of being read into an intermediate buffer, and the memory returned by getPtr() can be referenced for as long as
+	 * the stream is open. The mapping is private, so any writes to the memory are never propagated to the file.
+	 *
+	 * @note	The file must not be modified or truncated while it is mapped.
+	 */
+	class BS_UTILITY_EXPORT MappedFileDataStream : public MemoryDataStream
+	{
+	public:
+		/**
+		 * Maps a file into memory. If the file cannot be mapped the stream will be empty and isOpen() will return false.
+		 *
+		 * @param[in]	filePath		Path of the file to map.
+		 * @param[in]	accessPattern	Hint about how the file data will be accessed.
+		 */
+		MappedFileDataStream(const Path& filePath, FileAccessPattern accessPattern = FileAccessPattern::Sequential);
+
+		~MappedFileDataStream();
+
+		bool isMapped() const override { return true; }
+
+		/** Returns true if the file was successfully mapped. */
+		bool isOpen() const { return mData != nullptr; }
+
+		/** @copydoc DataStream::clone */
+		SPtr<DataStream> clone(bool copyData = true) const override;
+
+		/** @copydoc DataStream::close */
+		void close() override;
+
+		/** Returns the path of the file mapped by the stream. */
+		const Path& getPath() const { return mPath; }
+
+	protected:
+		Path mPath;
+		FileAccessPattern mAccessPattern;
+	};
+
 	/** Data stream for handling data from standard streams. */
 	class BS_UTILITY_EXPORT FileDataStream : public DataStream
 	{
@@ -4,8 +4,11 @@
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Math/BsVector4.h"
+#include "Math/BsMatrix4.h"
 #include "Math/BsAABox.h"
 #include "Math/BsSphere.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsMath.h"
 
 #define SIMDPP_ARCH_X86_SSE4_1
 
@@ -83,6 +86,149 @@ namespace bs
 			}
 		};
 
+		/**
+		 * Stores a set of axis aligned boxes as separate arrays for each component (structure of arrays). This allows
+		 * many boxes to be tested at once using SIMD instructions. Array sizes are always padded to a multiple of
+		 * BATCH_SIZE.
+		 */
+		struct AABoxSoA
+		{
+			/** Number of boxes processed by a single SIMD operation. */
+			static constexpr UINT32 BATCH_SIZE = 8;
+
+			/** Changes the number of boxes stored in the set. Existing contents are preserved. */
+			void resize(UINT32 count)
+			{
+				const UINT32 paddedCount = ((count + BATCH_SIZE - 1) / BATCH_SIZE) * BATCH_SIZE;
+
+				centerX.resize(paddedCount, 0.0f);
+				centerY.resize(paddedCount, 0.0f);
+				centerZ.resize(paddedCount, 0.0f);
+				extentX.resize(paddedCount, 0.0f);
+				extentY.resize(paddedCount, 0.0f);
+				extentZ.resize(paddedCount, 0.0f);
+
+				numBoxes = count;
+			}
+
+			/** Assigns an axis aligned box to the specified index. */
+			void set(UINT32 idx, const bs::AABox& box)
+			{
+				const Vector3 center = box.getCenter();
+				const Vector3 extents = box.getHalfSize();
+
+				centerX[idx] = center.x;
+				centerY[idx] = center.y;
+				centerZ[idx] = center.z;
+				extentX[idx] = Math::abs(extents.x);
+				extentY[idx] = Math::abs(extents.y);
+				extentZ[idx] = Math::abs(extents.z);
+			}
+
+			/** Assigns bounds of a sphere to the specified index. */
+			void set(UINT32 idx, const Sphere& sphere)
+			{
+				const Vector3& center = sphere.getCenter();
+				const float radius = sphere.getRadius();
+
+				centerX[idx] = center.x;
+				centerY[idx] = center.y;
+				centerZ[idx] = center.z;
+				extentX[idx] = radius;
+				extentY[idx] = radius;
+				extentZ[idx] = radius;
+			}
+
+			/** Returns the number of boxes in the set (not including padding). */
+			UINT32 size() const { return numBoxes; }
+
+			Vector<float> centerX;
+			Vector<float> centerY;
+			Vector<float> centerZ;
+			Vector<float> extentX;
+			Vector<float> extentY;
+			Vector<float> extentZ;
+
+			UINT32 numBoxes = 0;
+		};
+
+		/**
+		 * Tests a range of boxes against the planes of a convex volume, BATCH_SIZE boxes at a time. Matches the behaviour
+		 * of ConvexVolume::intersects(const AABox&).
+		 *
+		 * @param[in]	planes		Planes of the convex volume to test against.
+		 * @param[in]	boxes		Boxes to test.
+		 * @param[in]	start		Index of the first box to test. Must be a multiple of AABoxSoA::BATCH_SIZE.
+		 * @param[in]	count		Number of boxes to test.
+		 * @param[out]	output		Array of @p count entries, starting at @p start. Each entry will be set to 1 if the box
+		 *							intersects the volume, or 0 otherwise.
+		 */
+		inline void intersects(const Vector<Plane>& planes, const AABoxSoA& boxes, UINT32 start, UINT32 count, 
+			UINT8* output)
+		{
+			constexpr UINT32 BATCH_SIZE = AABoxSoA::BATCH_SIZE;
+			assert((start % BATCH_SIZE) == 0);
+
+			const UINT32 end = start + count;
+			for(UINT32 i = start; i < end; i += BATCH_SIZE)
+			{
+				float32x8 centerX = load_u<float32x8>(&boxes.centerX[i]);
+				float32x8 centerY = load_u<float32x8>(&boxes.centerY[i]);
+				float32x8 centerZ = load_u<float32x8>(&boxes.centerZ[i]);
+				float32x8 extentX = load_u<float32x8>(&boxes.extentX[i]);
+				float32x8 extentY = load_u<float32x8>(&boxes.extentY[i]);
+				float32x8 extentZ = load_u<float32x8>(&boxes.extentZ[i]);
+
+				uint32x8 outside = make_zero();
+				for(auto& plane : planes)
+				{
+					float32x8 normalX = splat<float32x8>(plane.normal.x);
+					float32x8 normalY = splat<float32x8>(plane.normal.y);
+					float32x8 normalZ = splat<float32x8>(plane.normal.z);
+
+					float32x8 dist = add(add(mul(centerX, normalX), mul(centerY, normalY)), mul(centerZ, normalZ));
+					dist = sub(dist, splat<float32x8>(plane.d));
+
+					float32x8 radius = mul(extentX, abs(normalX));
+					radius = add(radius, mul(extentY, abs(normalY)));
+					radius = add(radius, mul(extentZ, abs(normalZ)));
+
+					outside = bit_or(outside, bit_cast<uint32x8>(cmp_lt(dist, neg(radius))));
+				}
+
+				SIMDPP_ALIGN(32) UINT32 result[BATCH_SIZE];
+				store(result, outside);
+
+				const UINT32 numInBatch = std::min(BATCH_SIZE, end - i);
+				for(UINT32 j = 0; j < numInBatch; j++)
+					output[i - start + j] = result[j] == 0 ? 1 : 0;
+			}
+		}
+
+		/** 
+		 * Multiplies two 4x4 matrices, one row at a time. Equivalent to Matrix4::operator*, but allows @p output to
+		 * alias either of the inputs.
+		 */
+		inline void multiply(const Matrix4& lhs, const Matrix4& rhs, Matrix4& output)
+		{
+			const float32x4 rhsRow0 = load_u<float32x4>(&rhs[0].x);
+			const float32x4 rhsRow1 = load_u<float32x4>(&rhs[1].x);
+			const float32x4 rhsRow2 = load_u<float32x4>(&rhs[2].x);
+			const float32x4 rhsRow3 = load_u<float32x4>(&rhs[3].x);
+
+			for(UINT32 i = 0; i < 4; i++)
+			{
+				const Vector4& lhsRow = lhs[i];
+
+				float32x4 row = mul(splat<float32x4>(lhsRow.x), rhsRow0);
+				row = add(row, mul(splat<float32x4>(lhsRow.y), rhsRow1));
+				row = add(row, mul(splat<float32x4>(lhsRow.z), rhsRow2));
+				row = add(row, mul(splat<float32x4>(lhsRow.w), rhsRow3));
+
+				store_u(&output[i].x, row);
+			}
+		}
+
 		/** @} */
 	}
 }
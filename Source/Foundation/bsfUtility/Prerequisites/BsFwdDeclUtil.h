@@ -72,6 +72,7 @@ namespace bs
 	class FileSystem;
 	class Timer;
 	class Task;
+	struct Job;
 	class GpuResourceData;
 	class PixelData;
 	class HString;
@@ -0,0 +1,234 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Threading/BsThreadPool.h"
+
+namespace bs
+{
+	/** @addtogroup Threading-Internal
+	 *  @{
+	 */
+
+	class LegacyTaskScheduler;
+
+	/**
+	 * Copy of the Task implementation used before TaskScheduler was moved on top of JobScheduler. Only used as a baseline
+	 * by the benchmarks.
+	 */
+	class LegacyTask
+	{
+		struct PrivatelyConstruct {};
+
+	public:
+		LegacyTask(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker)
+			: mName(name), mTaskWorker(std::move(taskWorker))
+		{ }
+
+		/** @copydoc Task::create */
+		static SPtr<LegacyTask> create(const String& name, std::function<void()> taskWorker)
+		{
+			return bs_shared_ptr_new<LegacyTask>(PrivatelyConstruct(), name, std::move(taskWorker));
+		}
+
+		/** @copydoc Task::isComplete */
+		bool isComplete() const { return mState == 2; }
+
+		/** @copydoc Task::wait */
+		inline void wait();
+
+	private:
+		friend class LegacyTaskScheduler;
+
+		String mName;
+		UINT32 mTaskId = 0;
+		std::function<void()> mTaskWorker;
+		std::atomic<UINT32> mState{0}; /**< 0 - Inactive, 1 - In progress, 2 - Completed */
+
+		LegacyTaskScheduler* mParent = nullptr;
+	};
+
+	/**
+	 * Copy of the TaskScheduler implementation used before it was moved on top of JobScheduler. A dispatcher thread pops
+	 * tasks from a global, mutex protected queue and runs every task on its own ThreadPool thread. Only used as a
+	 * baseline by the benchmarks.
+	 */
+	class LegacyTaskScheduler
+	{
+	public:
+		LegacyTaskScheduler(UINT32 numWorkers)
+			:mTaskQueue(&LegacyTaskScheduler::taskCompare), mMaxActiveTasks(numWorkers)
+		{
+			mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler",
+				std::bind(&LegacyTaskScheduler::runMain, this));
+		}
+
+		~LegacyTaskScheduler()
+		{
+			// Wait until all tasks complete
+			{
+				Lock activeTaskLock(mReadyMutex);
+
+				while (mActiveTasks.size() > 0)
+				{
+					SPtr<LegacyTask> task = mActiveTasks[0];
+					activeTaskLock.unlock();
+
+					task->wait();
+					activeTaskLock.lock();
+				}
+			}
+
+			// Start shutdown of the main queue worker and wait until it exits
+			{
+				Lock lock(mReadyMutex);
+
+				mShutdown = true;
+			}
+
+			mTaskReadyCond.notify_one();
+
+			mTaskSchedulerThread.blockUntilComplete();
+		}
+
+		/** @copydoc TaskScheduler::addTask */
+		void addTask(SPtr<LegacyTask> task)
+		{
+			Lock lock(mReadyMutex);
+
+			task->mParent = this;
+			task->mTaskId = mNextTaskId++;
+			task->mState.store(0);
+
+			mCheckTasks = true;
+			mTaskQueue.insert(std::move(task));
+
+			// Wake main scheduler thread
+			mTaskReadyCond.notify_one();
+		}
+
+		/** @copydoc TaskScheduler::addWorker */
+		void addWorker()
+		{
+			Lock lock(mReadyMutex);
+
+			mMaxActiveTasks++;
+
+			// A spot freed up, queue new tasks on main scheduler thread if they exist
+			mTaskReadyCond.notify_one();
+		}
+
+		/** @copydoc TaskScheduler::removeWorker */
+		void removeWorker()
+		{
+			Lock lock(mReadyMutex);
+
+			if(mMaxActiveTasks > 0)
+				mMaxActiveTasks--;
+		}
+
+	private:
+		friend class LegacyTask;
+
+		/**	Main task scheduler method that dispatches tasks to other threads. */
+		void runMain()
+		{
+			while(true)
+			{
+				Lock lock(mReadyMutex);
+
+				while((!mCheckTasks || (UINT32)mActiveTasks.size() >= mMaxActiveTasks) && !mShutdown)
+					mTaskReadyCond.wait(lock);
+
+				mCheckTasks = false;
+
+				if(mShutdown)
+					break;
+
+				for(auto iter = mTaskQueue.begin(); iter != mTaskQueue.end();)
+				{
+					if ((UINT32)mActiveTasks.size() >= mMaxActiveTasks)
+						break;
+
+					SPtr<LegacyTask> curTask = *iter;
+					iter = mTaskQueue.erase(iter);
+
+					curTask->mState.store(1);
+					mActiveTasks.push_back(curTask);
+
+					ThreadPool::instance().run(curTask->mName, std::bind(&LegacyTaskScheduler::runTask, this, curTask));
+				}
+			}
+		}
+
+		/**	Worker method that runs a single task. */
+		void runTask(SPtr<LegacyTask> task)
+		{
+			task->mTaskWorker();
+
+			{
+				Lock lock(mReadyMutex);
+
+				auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
+				if (findIter != mActiveTasks.end())
+					mActiveTasks.erase(findIter);
+			}
+
+			{
+				Lock lock(mCompleteMutex);
+				task->mState.store(2);
+
+				mTaskCompleteCond.notify_all();
+			}
+
+			// Wake the main scheduler thread in case there are other tasks waiting
+			{
+				Lock lock(mReadyMutex);
+
+				mCheckTasks = true;
+				mTaskReadyCond.notify_one();
+			}
+		}
+
+		/**	Blocks the calling thread until the specified task has completed. */
+		void waitUntilComplete(const LegacyTask* task)
+		{
+			Lock lock(mCompleteMutex);
+
+			while(!task->isComplete())
+			{
+				addWorker();
+				mTaskCompleteCond.wait(lock);
+				removeWorker();
+			}
+		}
+
+		/**	Method used for sorting tasks. */
+		static bool taskCompare(const SPtr<LegacyTask>& lhs, const SPtr<LegacyTask>& rhs)
+		{
+			return lhs->mTaskId < rhs->mTaskId;
+		}
+
+		HThread mTaskSchedulerThread;
+		Set<SPtr<LegacyTask>, std::function<bool(const SPtr<LegacyTask>&, const SPtr<LegacyTask>&)>> mTaskQueue;
+		Vector<SPtr<LegacyTask>> mActiveTasks;
+		UINT32 mMaxActiveTasks = 0;
+		UINT32 mNextTaskId = 0;
+		bool mShutdown = false;
+		bool mCheckTasks = false;
+
+		Mutex mReadyMutex;
+		Mutex mCompleteMutex;
+		Signal mTaskReadyCond;
+		Signal mTaskCompleteCond;
+	};
+
+	void LegacyTask::wait()
+	{
+		if(mParent != nullptr)
+			mParent->waitUntilComplete(this);
+	}
+
+	/** @} */
+}
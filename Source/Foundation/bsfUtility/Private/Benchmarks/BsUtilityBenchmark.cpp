@@ -0,0 +1,656 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Math/BsSIMD.h"
+#include "Math/BsRandom.h"
+#include "Math/BsQuaternion.h"
+#include "Utility/BsTimer.h"
+#include "Utility/BsCullingOctree.h"
+#include "Utility/BsRadixSort.h"
+#include "Utility/BsCompression.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "BsLegacyTaskScheduler.h"
+
+#include <iostream>
+#include <iomanip>
+
+using namespace bs;
+
+namespace
+{
+	/** Amount of busy work performed by a single job, roughly equivalent to a tiny animation or culling job. */
+	constexpr UINT32 WORK_ITERATIONS = 200;
+
+	/** Number of jobs to execute per measurement. */
+	constexpr UINT32 NUM_JOBS = 100000;
+
+	std::atomic<UINT32> gSink{0};
+
+	void doWork(UINT32 seed)
+	{
+		UINT32 value = seed;
+		for(UINT32 i = 0; i < WORK_ITERATIONS; i++)
+			value = value * 1664525 + 1013904223;
+
+		gSink.fetch_add(value & 1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Executes every work item as a separate task through the TaskScheduler implementation used before JobScheduler,
+	 * with a dispatcher thread and a global task queue.
+	 */
+	double runLegacyTasks(UINT32 numWorkers)
+	{
+		LegacyTaskScheduler scheduler(numWorkers);
+
+		Vector<SPtr<LegacyTask>> tasks;
+		tasks.reserve(NUM_JOBS);
+
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_JOBS; i++)
+		{
+			SPtr<LegacyTask> task = LegacyTask::create("Bench", [i]() { doWork(i); });
+			scheduler.addTask(task);
+			tasks.push_back(task);
+		}
+
+		for(auto& task : tasks)
+			task->wait();
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Executes every work item as a separate Task through the TaskScheduler layer on top of JobScheduler. */
+	double runTasks()
+	{
+		Vector<SPtr<Task>> tasks;
+		tasks.reserve(NUM_JOBS);
+
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_JOBS; i++)
+		{
+			SPtr<Task> task = Task::create("Bench", [i]() { doWork(i); });
+			TaskScheduler::instance().addTask(task);
+			tasks.push_back(task);
+		}
+
+		for(auto& task : tasks)
+			task->wait();
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Executes every work item as a separate job, parented to a single root the caller waits on. */
+	double runJobs()
+	{
+		JobScheduler& scheduler = JobScheduler::instance();
+
+		Timer timer;
+		Job* root = scheduler.createJob([](Job*, const void*) { });
+		for(UINT32 i = 0; i < NUM_JOBS; i++)
+			scheduler.run(scheduler.createJobFromCallable([i]() { doWork(i); }, root));
+
+		scheduler.wait(scheduler.run(root));
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Executes the work items using a parallel for, letting workers split and steal ranges. */
+	double runParallelFor()
+	{
+		Timer timer;
+		JobScheduler::instance().parallelForAndWait(NUM_JOBS, 16, [](UINT32 start, UINT32 count)
+		{
+			for(UINT32 i = start; i < start + count; i++)
+				doWork(i);
+		});
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Generates a set of boxes randomly scattered around the origin, roughly half of them in front of the frustum. */
+	Vector<AABox> generateBoxes(UINT32 count)
+	{
+		Random random(count);
+
+		Vector<AABox> boxes(count);
+		for(UINT32 i = 0; i < count; i++)
+		{
+			Vector3 center(random.getSNorm() * 100.0f, random.getSNorm() * 100.0f, random.getSNorm() * 100.0f);
+			Vector3 extents(1.0f, 2.0f, 1.0f);
+
+			boxes[i] = AABox(center - extents, center + extents);
+		}
+
+		return boxes;
+	}
+
+	/** Culls the boxes one by one, using the generic ConvexVolume path. */
+	double runScalarCull(const ConvexVolume& frustum, const Vector<AABox>& boxes, Vector<UINT8>& output)
+	{
+		Timer timer;
+		for(UINT32 i = 0; i < (UINT32)boxes.size(); i++)
+			output[i] = frustum.intersects(boxes[i]) ? 1 : 0;
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Culls the boxes eight at a time, using the SIMD path. Includes the cost of converting the boxes to SoA. */
+	double runSIMDCull(const ConvexVolume& frustum, const Vector<AABox>& boxes, simd::AABoxSoA& soa, 
+		Vector<UINT8>& output)
+	{
+		Timer timer;
+		soa.resize((UINT32)boxes.size());
+		for(UINT32 i = 0; i < (UINT32)boxes.size(); i++)
+			soa.set(i, boxes[i]);
+
+		simd::intersects(frustum.getPlanes(), soa, 0, (UINT32)boxes.size(), output.data());
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Generates bounds of objects spread over a large, mostly flat area, as in an open world scene. */
+	Vector<Bounds> generateSceneBounds(UINT32 count)
+	{
+		Random random(count);
+
+		Vector<Bounds> bounds(count);
+		for(UINT32 i = 0; i < count; i++)
+		{
+			Vector3 center(random.getSNorm() * 4000.0f, random.getSNorm() * 50.0f, random.getSNorm() * 4000.0f);
+			Vector3 extents(0.5f + random.getUNorm() * 4.0f, 0.5f + random.getUNorm() * 4.0f, 
+				0.5f + random.getUNorm() * 4.0f);
+
+			bounds[i] = Bounds(AABox(center - extents, center + extents), Sphere(center, extents.length()));
+		}
+
+		return bounds;
+	}
+
+	/** Culls the bounds one by one, testing the layer, sphere and then the box, as the renderer used to. */
+	double runLinearCull(const ConvexVolume& frustum, const Vector<Bounds>& bounds, const Vector<UINT64>& layers, 
+		Vector<bool>& output)
+	{
+		Timer timer;
+		for(UINT32 i = 0; i < (UINT32)bounds.size(); i++)
+		{
+			if((layers[i] & 1) == 0)
+				continue;
+
+			if(frustum.intersects(bounds[i].getSphere()) && frustum.intersects(bounds[i].getBox()))
+				output[i] = true;
+		}
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Culls the bounds using the culling octree, split over the job scheduler workers. */
+	double runOctreeCull(const ConvexVolume& frustum, const CullingOctree& octree, Vector<bool>& output)
+	{
+		Timer timer;
+		octree.cull(frustum, 1, output);
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Culls the bounds against each of the volumes using a separate pass over the culling octree per volume. */
+	double runSeparateViewCull(const Vector<ConvexVolume>& frustums, const CullingOctree& octree, Vector<bool>& output)
+	{
+		Timer timer;
+		for(auto& frustum : frustums)
+			octree.cull(frustum, 1, output);
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Culls the bounds against all of the volumes using a single pass over the culling octree. */
+	double runSharedViewCull(const Vector<ConvexVolume>& frustums, const CullingOctree& octree,
+		Vector<CullingOctree::VisibleElement>& output)
+	{
+		CullingOctree::CullVolume volumes[CullingOctree::MAX_CULL_VOLUMES];
+		for(UINT32 i = 0; i < (UINT32)frustums.size(); i++)
+			volumes[i] = { &frustums[i], 1 };
+
+		Timer timer;
+		octree.cull(volumes, (UINT32)frustums.size(), output);
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Sort data of a single render queue entry, as kept by the render queue. */
+	struct SortableElement
+	{
+		UINT32 seqIdx;
+		INT32 priority;
+		float distFromCamera;
+		UINT32 shaderId;
+		UINT32 passIdx;
+	};
+
+	/** Generates render queue entries with a few priorities and a few hundred shaders, spread over a large view. */
+	Vector<SortableElement> generateSortableElements(UINT32 count)
+	{
+		Random random(count);
+
+		Vector<SortableElement> elements(count);
+		for(UINT32 i = 0; i < count; i++)
+		{
+			elements[i].seqIdx = i;
+			elements[i].priority = (random.get() % 8) == 0 ? 90000 : 100000;
+			elements[i].distFromCamera = random.getUNorm() * 1000.0f;
+			elements[i].shaderId = random.get() % 300;
+			elements[i].passIdx = 0;
+		}
+
+		return elements;
+	}
+
+	/** Comparator used by the render queue before sort keys, sorting by distance first and material second. */
+	bool elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	{
+		const SortableElement& a = lookup[aIdx];
+		const SortableElement& b = lookup[bIdx];
+
+		UINT8 isHigher = (a.priority > b.priority) << 4 | 
+			(a.distFromCamera < b.distFromCamera) << 3 | 
+			(a.shaderId < b.shaderId) << 2 | 
+			(a.passIdx < b.passIdx) << 1 | 
+			(a.seqIdx < b.seqIdx);
+
+		UINT8 isLower = (a.priority < b.priority) << 4 |
+			(a.distFromCamera > b.distFromCamera) << 3 |
+			(a.shaderId > b.shaderId) << 2 |
+			(a.passIdx > b.passIdx) << 1 |
+			(a.seqIdx > b.seqIdx);
+
+		return isHigher > isLower;
+	}
+
+	/** Sorts element indices using std::sort and a bound comparator, as the render queue used to. */
+	double runComparatorSort(const Vector<SortableElement>& elements, Vector<UINT32>& indices)
+	{
+		using namespace std::placeholders;
+
+		Timer timer;
+		indices.resize(elements.size());
+		for(UINT32 i = 0; i < (UINT32)elements.size(); i++)
+			indices[i] = i;
+
+		std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)> sortMethod = &elementSorterPreferSort;
+		std::sort(indices.begin(), indices.end(), std::bind(sortMethod, _1, _2, elements));
+
+		return (double)timer.getMicroseconds();
+	}
+
+	/** 
+	 * Packs the elements into 64-bit keys in the same layout as the render queue does in its distance mode, and radix 
+	 * sorts them. 
+	 */
+	double runKeySort(const Vector<SortableElement>& elements, RadixSort& sorter, Vector<UINT64>& keys, 
+		Vector<UINT32>& indices)
+	{
+		Timer timer;
+		const UINT32 count = (UINT32)elements.size();
+		keys.resize(count);
+		indices.resize(count);
+
+		for(UINT32 i = 0; i < count; i++)
+		{
+			const SortableElement& elem = elements[i];
+
+			UINT32 distance;
+			memcpy(&distance, &elem.distFromCamera, sizeof(distance));
+			distance ^= (distance & 0x80000000) ? 0xFFFFFFFF : 0x80000000;
+
+			const UINT64 rank = elem.priority == 100000 ? 0 : 1;
+			keys[i] = (rank << 56) | ((UINT64)(distance >> 8) << 32) | ((UINT64)elem.shaderId << 8) | elem.passIdx;
+			indices[i] = i;
+		}
+
+		sorter.sort(keys.data(), indices.data(), count);
+		return (double)timer.getMicroseconds();
+	}
+
+	/** Codec and compression level combination measured by the compression benchmark. */
+	struct CompressionConfig
+	{
+		const char* name;
+		CompressionCodec codec;
+		INT32 level;
+	};
+
+	/** Total time spent compressing and decompressing the corpus, and its total compressed size. */
+	struct CompressionResults
+	{
+		double compressTime = 0.0;
+		double decompressTime = 0.0;
+		UINT64 compressedSize = 0;
+	};
+
+	/**
+	 * Generates data standing in for the asset corpus when none is provided: vertex data with smoothly varying
+	 * attributes, a texture with gradients and noise, and serialized text with repeating field names.
+	 */
+	Vector<Vector<UINT8>> generateCompressionCorpus()
+	{
+		Random random(5);
+		Vector<Vector<UINT8>> corpus;
+
+		const UINT32 numVertices = 256 * 1024;
+		Vector<float> vertices(numVertices * 8);
+		for(UINT32 i = 0; i < numVertices; i++)
+		{
+			float* vertex = &vertices[i * 8];
+			const float angle = i * 0.001f;
+
+			vertex[0] = std::cos(angle) * (i / 1024);
+			vertex[1] = std::sin(angle) * (i / 1024);
+			vertex[2] = (i % 1024) * 0.01f;
+			vertex[3] = std::cos(angle);
+			vertex[4] = std::sin(angle);
+			vertex[5] = 0.0f;
+			vertex[6] = (i % 1024) / 1024.0f;
+			vertex[7] = (i / 1024) / 256.0f;
+		}
+
+		corpus.push_back(Vector<UINT8>((UINT8*)vertices.data(), (UINT8*)(vertices.data() + vertices.size())));
+
+		const UINT32 textureSize = 1024;
+		Vector<UINT8> texture(textureSize * textureSize * 4);
+		for(UINT32 i = 0; i < textureSize * textureSize; i++)
+		{
+			const UINT32 x = i % textureSize;
+			const UINT32 y = i / textureSize;
+
+			texture[i * 4 + 0] = (UINT8)(x / 4);
+			texture[i * 4 + 1] = (UINT8)(y / 4);
+			texture[i * 4 + 2] = (UINT8)((x + y) / 8 + random.get() % 8);
+			texture[i * 4 + 3] = 255;
+		}
+
+		corpus.push_back(std::move(texture));
+
+		String text;
+		while(text.size() < 4 * 1024 * 1024)
+		{
+			text += "{ \"name\": \"Object" + toString(random.get() % 10000) + "\", \"position\": [" +
+				toString(random.getUNorm()) + ", " + toString(random.getUNorm()) + ", 0], \"parent\": " +
+				toString(random.get() % 100) + " }\n";
+		}
+
+		corpus.push_back(Vector<UINT8>(text.begin(), text.end()));
+		return corpus;
+	}
+
+	/** Loads every file in the directory and its child directories. */
+	Vector<Vector<UINT8>> loadCompressionCorpus(const Path& path)
+	{
+		Vector<Vector<UINT8>> corpus;
+		FileSystem::iterate(path, [&corpus](const Path& filePath)
+		{
+			SPtr<DataStream> stream = FileSystem::openFile(filePath);
+			if(stream == nullptr)
+				return true;
+
+			Vector<UINT8> data(stream->size());
+			stream->read(data.data(), data.size());
+
+			corpus.push_back(std::move(data));
+			return true;
+		});
+
+		return corpus;
+	}
+
+	/** Compresses and decompresses every asset in the corpus separately, as the resource system does. */
+	CompressionResults runCompression(const Vector<Vector<UINT8>>& corpus, const CompressionConfig& config)
+	{
+		COMPRESSION_DESC desc;
+		desc.codec = config.codec;
+		desc.level = config.level;
+
+		CompressionResults results;
+		for(auto& asset : corpus)
+		{
+			SPtr<DataStream> input = bs_shared_ptr_new<MemoryDataStream>((void*)asset.data(), asset.size(), false);
+
+			Timer timer;
+			SPtr<DataStream> compressed = Compression::compressBlocks(input, desc);
+			results.compressTime += timer.getMicroseconds();
+
+			timer.reset();
+			SPtr<MemoryDataStream> decompressed = Compression::decompressBlocks(compressed);
+			results.decompressTime += timer.getMicroseconds();
+
+			if(decompressed == nullptr || decompressed->size() != asset.size())
+				std::cout << "Warning: " << config.name << " failed to decompress an asset." << std::endl;
+
+			results.compressedSize += compressed->size();
+		}
+
+		return results;
+	}
+
+	/** Compresses and decompresses every asset in the corpus as a single Snappy stream, as resources used to be. */
+	CompressionResults runStreamCompression(const Vector<Vector<UINT8>>& corpus)
+	{
+		CompressionResults results;
+		for(auto& asset : corpus)
+		{
+			SPtr<DataStream> input = bs_shared_ptr_new<MemoryDataStream>((void*)asset.data(), asset.size(), false);
+
+			Timer timer;
+			SPtr<DataStream> compressed = Compression::compress(input);
+			results.compressTime += timer.getMicroseconds();
+
+			timer.reset();
+			SPtr<MemoryDataStream> decompressed = Compression::decompress(compressed);
+			results.decompressTime += timer.getMicroseconds();
+
+			results.compressedSize += compressed->size();
+		}
+
+		return results;
+	}
+
+	void reportCompression(const char* name, UINT64 corpusSize, const CompressionResults& results)
+	{
+		const double megabytes = corpusSize / (1024.0 * 1024.0);
+
+		std::cout << std::left << std::setw(16) << name << std::fixed << std::setprecision(2) << std::setw(10)
+			<< corpusSize / (double)results.compressedSize << std::setprecision(1)
+			<< std::setw(18) << megabytes / (results.compressTime / 1000000.0)
+			<< megabytes / (results.decompressTime / 1000000.0) << std::endl;
+	}
+
+	void report(const char* name, UINT32 numWorkers, double microseconds)
+	{
+		const double jobsPerSecond = NUM_JOBS / (microseconds / 1000000.0);
+
+		std::cout << std::left << std::setw(16) << name << std::setw(10) << numWorkers
+			<< std::fixed << std::setprecision(0) << jobsPerSecond << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const UINT32 maxWorkers = std::max((UINT32)BS_THREAD_HARDWARE_CONCURRENCY, 1U);
+	ThreadPool::startUp<TThreadPool<>>(maxWorkers, maxWorkers + 16);
+
+	std::cout << std::left << std::setw(16) << "Method" << std::setw(10) << "Workers" << "Jobs/sec" << std::endl;
+	for(UINT32 numWorkers = 1; numWorkers <= maxWorkers; numWorkers++)
+	{
+		// Measured before the job workers start, so the two don't compete for pool threads
+		report("Legacy task", numWorkers, runLegacyTasks(numWorkers));
+
+		JobScheduler::startUp(numWorkers);
+		TaskScheduler::startUp();
+
+		report("Task", numWorkers, runTasks());
+		report("Job", numWorkers, runJobs());
+		report("ParallelFor", numWorkers, runParallelFor());
+
+		TaskScheduler::shutDown();
+		JobScheduler::shutDown();
+	}
+
+	// Culling cost, as performed by the animation system before any evaluation jobs are queued
+	const ConvexVolume frustum(Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.1f, 100.0f));
+
+	std::cout << std::endl << std::left << std::setw(16) << "Bounds" << std::setw(16) << "Scalar (us)" 
+		<< "SIMD (us)" << std::endl;
+	for(UINT32 count = 64; count <= 65536; count *= 4)
+	{
+		Vector<AABox> boxes = generateBoxes(count);
+		Vector<UINT8> output(count);
+		simd::AABoxSoA soa;
+
+		std::cout << std::left << std::setw(16) << count << std::fixed << std::setprecision(1) 
+			<< std::setw(16) << runScalarCull(frustum, boxes, output) 
+			<< runSIMDCull(frustum, boxes, soa, output) << std::endl;
+	}
+
+	// Scene culling, as performed by the renderer for every view
+	const Matrix4 viewProj = Matrix4::projectionPerspective(Degree(90.0f), 16.0f / 9.0f, 0.1f, 1000.0f) *
+		Matrix4::view(Vector3(0.0f, 10.0f, 0.0f), Quaternion::IDENTITY);
+	const ConvexVolume viewFrustum(viewProj);
+
+	JobScheduler::startUp(maxWorkers);
+
+	std::cout << std::endl << std::left << std::setw(16) << "Renderables" << std::setw(16) << "Linear (us)" 
+		<< "Octree (us)" << std::endl;
+	for(UINT32 count = 1000; count <= 256000; count *= 4)
+	{
+		Vector<Bounds> bounds = generateSceneBounds(count);
+		Vector<UINT64> layers(count, 1);
+		Vector<bool> output(count);
+
+		CullingOctree octree;
+		for(UINT32 i = 0; i < count; i++)
+			octree.add(bounds[i], layers[i]);
+
+		double linearTime = std::numeric_limits<double>::max();
+		double octreeTime = std::numeric_limits<double>::max();
+		for(UINT32 i = 0; i < 10; i++)
+		{
+			linearTime = std::min(linearTime, runLinearCull(viewFrustum, bounds, layers, output));
+			octreeTime = std::min(octreeTime, runOctreeCull(viewFrustum, octree, output));
+		}
+
+		std::cout << std::left << std::setw(16) << count << std::fixed << std::setprecision(1) 
+			<< std::setw(16) << linearTime << octreeTime << std::endl;
+	}
+
+	// Culling many views at once, such as shadow cascades and cubemap faces, over a fixed number of renderables
+	{
+		const UINT32 count = 64000;
+
+		Vector<Bounds> bounds = generateSceneBounds(count);
+		Vector<bool> output(count);
+		Vector<CullingOctree::VisibleElement> visibleElements;
+
+		CullingOctree octree;
+		for(UINT32 i = 0; i < count; i++)
+			octree.add(bounds[i], 1);
+
+		std::cout << std::endl << std::left << std::setw(16) << "Views" << std::setw(16) << "Separate (us)" 
+			<< "Shared (us)" << std::endl;
+		for(UINT32 numViews = 1; numViews <= CullingOctree::MAX_CULL_VOLUMES; numViews *= 2)
+		{
+			// Cubemap faces of a few nearby lights, similar to what shadow and reflection probe rendering require
+			Vector<ConvexVolume> frustums;
+			for(UINT32 i = 0; i < numViews; i++)
+			{
+				static const Vector3 FACE_DIRECTIONS[] = { Vector3::UNIT_X, -Vector3::UNIT_X, Vector3::UNIT_Y,
+					-Vector3::UNIT_Y, Vector3::UNIT_Z, -Vector3::UNIT_Z };
+
+				const Vector3 position((i / 6) * 100.0f, 10.0f, 0.0f);
+				const Vector3& direction = FACE_DIRECTIONS[i % 6];
+				const Vector3 up = Math::abs(direction.y) > 0.5f ? Vector3::UNIT_Z : Vector3::UNIT_Y;
+
+				Quaternion rotation(BsIdentity);
+				rotation.lookRotation(direction, up);
+
+				const Matrix4 proj = Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.1f, 500.0f);
+				frustums.push_back(ConvexVolume(proj * Matrix4::view(position, rotation)));
+			}
+
+			double separateTime = std::numeric_limits<double>::max();
+			double sharedTime = std::numeric_limits<double>::max();
+			for(UINT32 i = 0; i < 10; i++)
+			{
+				separateTime = std::min(separateTime, runSeparateViewCull(frustums, octree, output));
+				sharedTime = std::min(sharedTime, runSharedViewCull(frustums, octree, visibleElements));
+			}
+
+			std::cout << std::left << std::setw(16) << numViews << std::fixed << std::setprecision(1) 
+				<< std::setw(16) << separateTime << sharedTime << std::endl;
+		}
+	}
+
+	// Render queue sorting, as performed for every queue of every view
+	std::cout << std::endl << std::left << std::setw(16) << "Queue elements" << std::setw(16) << "std::sort (us)" 
+		<< "Radix (us)" << std::endl;
+	for(UINT32 count = 1000; count <= 256000; count *= 4)
+	{
+		Vector<SortableElement> elements = generateSortableElements(count);
+		Vector<UINT32> indices;
+		Vector<UINT64> keys;
+		RadixSort sorter;
+
+		double keyTime = std::numeric_limits<double>::max();
+		for(UINT32 i = 0; i < 10; i++)
+			keyTime = std::min(keyTime, runKeySort(elements, sorter, keys, indices));
+
+		// The comparator copies the element array whenever it is copied, making it too slow to measure on large queues
+		std::cout << std::left << std::setw(16) << count << std::fixed << std::setprecision(1) << std::setw(16);
+		if(count <= 16000)
+			std::cout << runComparatorSort(elements, indices);
+		else
+			std::cout << "-";
+
+		std::cout << keyTime << std::endl;
+	}
+
+	// Resource compression, over the asset corpus in the directory provided as the first argument, if any
+	{
+		const Vector<Vector<UINT8>> corpus = argc > 1 ? loadCompressionCorpus(Path(argv[1])) :
+			generateCompressionCorpus();
+
+		UINT64 corpusSize = 0;
+		for(auto& asset : corpus)
+			corpusSize += asset.size();
+
+		static const CompressionConfig CONFIGS[] =
+		{
+			{ "Snappy", CompressionCodec::Snappy, 0 },
+			{ "LZ4", CompressionCodec::LZ4, 0 },
+			{ "LZ4 HC 9", CompressionCodec::LZ4, 9 },
+			{ "Zstd 1", CompressionCodec::Zstd, 1 },
+			{ "Zstd 3", CompressionCodec::Zstd, 3 },
+			{ "Zstd 9", CompressionCodec::Zstd, 9 },
+			{ "Zstd 19", CompressionCodec::Zstd, 19 }
+		};
+
+		std::cout << std::endl << corpus.size() << " assets, " << corpusSize / 1024 << " KB" << std::endl;
+		std::cout << std::left << std::setw(16) << "Codec" << std::setw(10) << "Ratio" << std::setw(18)
+			<< "Compress (MB/s)" << "Decompress (MB/s)" << std::endl;
+
+		if(corpusSize > 0)
+		{
+			reportCompression("Snappy stream", corpusSize, runStreamCompression(corpus));
+
+			for(auto& config : CONFIGS)
+			{
+				if(Compression::isSupported(config.codec))
+					reportCompression(config.name, corpusSize, runCompression(corpus, config));
+			}
+		}
+	}
+
+	JobScheduler::shutDown();
+
+	ThreadPool::shutDown();
+	return 0;
+}
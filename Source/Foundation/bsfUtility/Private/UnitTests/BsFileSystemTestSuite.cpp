@@ -5,6 +5,7 @@
 #include "Debug/BsDebug.h"
 #include "Error/BsException.h"
 #include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
 
 #include <algorithm>
 #include <fstream>
@@ -84,6 +85,8 @@ namespace bs
 		BS_ADD_TEST(FileSystemTestSuite::testGetChildren);
 		BS_ADD_TEST(FileSystemTestSuite::testGetLastModifiedTime);
 		BS_ADD_TEST(FileSystemTestSuite::testGetTempDirectoryPath);
+		BS_ADD_TEST(FileSystemTestSuite::testMappedFile);
+		BS_ADD_TEST(FileSystemTestSuite::testMappedFile_empty);
 	}
 
 	void FileSystemTestSuite::testExists_yes_file()
@@ -299,4 +302,42 @@ namespace bs
 		/* No judging. */
 		BS_TEST_ASSERT(!path.toString().empty());
 	}
+
+	void FileSystemTestSuite::testMappedFile()
+	{
+		Path path = mTestDirectory + "mapped-file";
+		createFile(path, "0123456789");
+
+		{
+			MappedFileDataStream stream(path);
+			BS_TEST_ASSERT(stream.isOpen());
+			BS_TEST_ASSERT(stream.size() == 10);
+			BS_TEST_ASSERT(memcmp(stream.getPtr(), "0123456789", 10) == 0);
+
+			char data[4];
+			stream.skip(3);
+			BS_TEST_ASSERT(stream.read(data, sizeof(data)) == sizeof(data));
+			BS_TEST_ASSERT(memcmp(data, "3456", sizeof(data)) == 0);
+
+			// Writes to the mapped memory must not reach the file
+			stream.getPtr()[0] = 'x';
+		}
+
+		BS_TEST_ASSERT(readFile(path) == "0123456789");
+		FileSystem::remove(path);
+	}
+
+	void FileSystemTestSuite::testMappedFile_empty()
+	{
+		Path path = mTestDirectory + "mapped-file-empty";
+		createEmptyFile(path);
+
+		MappedFileDataStream stream(path);
+		BS_TEST_ASSERT(!stream.isOpen());
+		BS_TEST_ASSERT(stream.size() == 0);
+		BS_TEST_ASSERT(stream.eof());
+
+		stream.close();
+		FileSystem::remove(path);
+	}
 }
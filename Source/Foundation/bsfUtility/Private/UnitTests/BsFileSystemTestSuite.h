@@ -35,6 +35,8 @@ namespace bs
 		void testGetChildren();
 		void testGetLastModifiedTime();
 		void testGetTempDirectoryPath();
+		void testMappedFile();
+		void testMappedFile_empty();
 
 		Path mTestDirectory;
 	};
@@ -3,6 +3,9 @@
 #include "Private/UnitTests/BsUtilityTestSuite.h"
 #include "Private/UnitTests/BsFileSystemTestSuite.h"
 #include "Utility/BsOctree.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsRadixSort.h"
+#include "Math/BsRandom.h"
 
 namespace bs
 {
@@ -51,6 +54,8 @@ namespace bs
 	UtilityTestSuite::UtilityTestSuite()
 	{
 		BS_ADD_TEST(UtilityTestSuite::testOctree);
+		BS_ADD_TEST(UtilityTestSuite::testJobScheduler);
+		BS_ADD_TEST(UtilityTestSuite::testRadixSort);
 	}
 
 	void UtilityTestSuite::testOctree()
@@ -143,4 +148,132 @@ namespace bs
 		for(auto& entry : octreeData.elements)
 			octree.removeElement(entry.octreeId);
 	}
+
+	void UtilityTestSuite::testJobScheduler()
+	{
+		ThreadPool::startUp<TThreadPool<>>(4, BS_THREAD_HARDWARE_CONCURRENCY + 16);
+		JobScheduler::startUp();
+		TaskScheduler::startUp();
+
+		JobScheduler& jobScheduler = JobScheduler::instance();
+
+		// Parallel for, ensure every element is visited exactly once
+		constexpr UINT32 NUM_ELEMENTS = 100000;
+		Vector<UINT32> visits(NUM_ELEMENTS, 0);
+
+		jobScheduler.parallelForAndWait(NUM_ELEMENTS, 64, [&visits](UINT32 start, UINT32 count)
+		{
+			for(UINT32 i = start; i < start + count; i++)
+				visits[i]++;
+		});
+
+		bool allVisitedOnce = true;
+		for(auto& entry : visits)
+			allVisitedOnce &= entry == 1;
+
+		BS_TEST_ASSERT(allVisitedOnce);
+
+		// Parent shouldn't complete until all of its children complete
+		std::atomic<UINT32> numExecuted{0};
+		Job* parent = jobScheduler.createJobFromCallable([&numExecuted]() { numExecuted++; });
+		for(UINT32 i = 0; i < 1000; i++)
+		{
+			Job* child = jobScheduler.createJobFromCallable([&numExecuted]() { numExecuted++; }, parent);
+			jobScheduler.run(child);
+		}
+
+		jobScheduler.wait(jobScheduler.run(parent));
+
+		BS_TEST_ASSERT(numExecuted == 1001);
+
+		// Handle to a completed job must stay complete once its slot is re-used by a job that hasn't ran yet
+		JobHandle completed = jobScheduler.run(jobScheduler.createJobFromCallable([]() { }));
+		jobScheduler.wait(completed);
+
+		Job* recycled = nullptr;
+		for(UINT32 i = 0; i < JobQueue::CAPACITY * 2 && !recycled; i++)
+		{
+			Job* job = jobScheduler.createJobFromCallable([]() { });
+			if(job == completed.job)
+				recycled = job;
+			else
+				jobScheduler.wait(jobScheduler.run(job));
+		}
+
+		BS_TEST_ASSERT(recycled != nullptr);
+		BS_TEST_ASSERT(JobScheduler::isComplete(completed));
+
+		if(recycled)
+			jobScheduler.wait(jobScheduler.run(recycled));
+
+		// Tasks must still respect their dependencies when ran on top of the job scheduler
+		std::atomic<UINT32> order{0};
+		UINT32 firstOrder = 0;
+		UINT32 secondOrder = 0;
+
+		SPtr<Task> first = Task::create("First", [&]() { BS_THREAD_SLEEP(5); firstOrder = ++order; });
+		SPtr<Task> second = Task::create("Second", [&]() { secondOrder = ++order; }, TaskPriority::High, first);
+
+		TaskScheduler::instance().addTask(second);
+		TaskScheduler::instance().addTask(first);
+		second->wait();
+
+		BS_TEST_ASSERT(first->isComplete() && second->isComplete());
+		BS_TEST_ASSERT(firstOrder == 1 && secondOrder == 2);
+
+		TaskScheduler::shutDown();
+		JobScheduler::shutDown();
+		ThreadPool::shutDown();
+	}
+
+	void UtilityTestSuite::testRadixSort()
+	{
+		// Keys only differ in some of their digits, ensuring skipped passes are handled, and contain many duplicates to
+		// test stability
+		constexpr UINT32 NUM_ELEMENTS = 100000;
+		Random random(1);
+
+		Vector<std::pair<UINT64, UINT32>> reference(NUM_ELEMENTS);
+		for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			const UINT64 key = ((UINT64)(random.get() & 0xFF) << 56) | ((UINT64)(random.get() & 0x3FF) << 20);
+			reference[i] = std::make_pair(key, i);
+		}
+
+		Vector<UINT64> keys(NUM_ELEMENTS);
+		Vector<UINT32> values(NUM_ELEMENTS);
+
+		auto sortAndCompare = [&reference, &keys, &values](RadixSort& sorter)
+		{
+			for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+			{
+				keys[i] = reference[i].first;
+				values[i] = reference[i].second;
+			}
+
+			sorter.sort(keys.data(), values.data(), NUM_ELEMENTS);
+
+			Vector<std::pair<UINT64, UINT32>> sorted = reference;
+			std::stable_sort(sorted.begin(), sorted.end(), 
+				[](const std::pair<UINT64, UINT32>& a, const std::pair<UINT64, UINT32>& b) { return a.first < b.first; });
+
+			bool matches = true;
+			for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+				matches &= keys[i] == sorted[i].first && values[i] == sorted[i].second;
+
+			return matches;
+		};
+
+		RadixSort sorter;
+		BS_TEST_ASSERT(sortAndCompare(sorter));
+
+		// Same, but sorted in multiple chunks in parallel
+		ThreadPool::startUp<TThreadPool<>>(4, BS_THREAD_HARDWARE_CONCURRENCY + 16);
+		JobScheduler::startUp(4);
+
+		BS_TEST_ASSERT(sortAndCompare(sorter));
+
+		JobScheduler::shutDown();
+		ThreadPool::shutDown();
+	}
 }
@@ -15,5 +15,7 @@ namespace bs
 
 	private:
 		void testOctree();
+		void testJobScheduler();
+		void testRadixSort();
 	};
 }
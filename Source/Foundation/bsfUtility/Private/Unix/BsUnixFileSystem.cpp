@@ -8,6 +8,8 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -150,6 +152,71 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(path, DataStream::AccessMode::WRITE, true);
 	}
 
+	MappedFileDataStream::MappedFileDataStream(const Path& filePath, FileAccessPattern accessPattern)
+		:MemoryDataStream(nullptr, 0, false), mPath(filePath), mAccessPattern(accessPattern)
+	{
+		mAccess = READ;
+
+		String pathString = filePath.toString();
+		int fileDesc = open(pathString.c_str(), O_RDONLY);
+		if (fileDesc == -1)
+		{
+			HANDLE_PATH_ERROR(pathString, errno);
+			return;
+		}
+
+		struct stat st_buf;
+		if (fstat(fileDesc, &st_buf) != 0)
+		{
+			HANDLE_PATH_ERROR(pathString, errno);
+			::close(fileDesc);
+			return;
+		}
+
+		// Empty files cannot be mapped
+		const size_t size = (size_t)st_buf.st_size;
+		if (size > 0)
+		{
+			// Private writable mapping, so users referencing the data can modify it without affecting the file
+			void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDesc, 0);
+			if (data != MAP_FAILED)
+			{
+				switch (accessPattern)
+				{
+				case FileAccessPattern::Sequential:
+					madvise(data, size, MADV_SEQUENTIAL);
+					madvise(data, size, MADV_WILLNEED);
+					break;
+				case FileAccessPattern::Random:
+					madvise(data, size, MADV_RANDOM);
+					break;
+				default:
+					break;
+				}
+
+				mData = mPos = (UINT8*)data;
+				mSize = size;
+				mEnd = mData + mSize;
+			}
+			else
+				HANDLE_PATH_ERROR(pathString, errno);
+		}
+
+		// Mapping remains valid after the descriptor is closed
+		::close(fileDesc);
+	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData != nullptr)
+		{
+			munmap(mData, mSize);
+
+			mData = mPos = mEnd = nullptr;
+			mSize = 0;
+		}
+	}
+
 	UINT64 FileSystem::getFileSize(const Path& path)
 	{
 		struct stat st_buf;
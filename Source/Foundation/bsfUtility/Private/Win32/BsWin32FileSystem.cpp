@@ -293,6 +293,66 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(fullPath, DataStream::AccessMode::WRITE, true);
 	}
 
+	MappedFileDataStream::MappedFileDataStream(const Path& filePath, FileAccessPattern accessPattern)
+		:MemoryDataStream(nullptr, 0, false), mPath(filePath), mAccessPattern(accessPattern)
+	{
+		mAccess = READ;
+
+		DWORD flags = FILE_ATTRIBUTE_NORMAL;
+		if (accessPattern == FileAccessPattern::Sequential)
+			flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+		else if (accessPattern == FileAccessPattern::Random)
+			flags |= FILE_FLAG_RANDOM_ACCESS;
+
+		WString pathWString = UTF8::toWide(filePath.toString());
+		HANDLE file = CreateFileW(pathWString.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, 
+			nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			win32_handleError(GetLastError(), pathWString);
+			return;
+		}
+
+		// Empty files cannot be mapped
+		LARGE_INTEGER fileSize;
+		if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+		{
+			// Copy-on-write mapping, so users referencing the data can modify it without affecting the file
+			HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+			if (mapping != nullptr)
+			{
+				void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+				if (data != nullptr)
+				{
+					mData = mPos = (UINT8*)data;
+					mSize = (size_t)fileSize.QuadPart;
+					mEnd = mData + mSize;
+				}
+				else
+					win32_handleError(GetLastError(), pathWString);
+
+				// View keeps the mapping alive
+				CloseHandle(mapping);
+			}
+			else
+				win32_handleError(GetLastError(), pathWString);
+		}
+
+		CloseHandle(file);
+	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData != nullptr)
+		{
+			UnmapViewOfFile(mData);
+
+			mData = mPos = mEnd = nullptr;
+			mSize = 0;
+		}
+	}
+
 	UINT64 FileSystem::getFileSize(const Path& fullPath)
 	{
 		return win32_getFileSize(UTF8::toWide(fullPath.toString()));
@@ -99,7 +99,7 @@ namespace bs
 		 * @param[in]	copyData	Determines should the data be copied or just referenced. If referenced then the returned
 		 *							serialized object will be invalid as soon as the original data buffer is destroyed.
 		 *							Referencing is faster than copying. If the source data stream is a file stream the data
-		 *							will always be copied.
+		 *							will always be copied. Memory mapped file streams are referenced same as memory streams.
 		 *
 		 * @note
 		 * References to field data will point to the original buffer and will become invalid when it is destroyed.
@@ -0,0 +1,436 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Threading/BsJobScheduler.h"
+#include "Error/BsException.h"
+
+namespace bs
+{
+	/** Number of times a worker will check the queues for new work before going to sleep. */
+	static constexpr UINT32 WORKER_SPIN_COUNT = 64;
+
+	BS_THREADLOCAL JobScheduler::CachedJobPool JobScheduler::sThreadPools[NUM_CACHED_POOLS];
+	BS_THREADLOCAL UINT32 JobScheduler::sNextThreadPoolSlot = 0;
+	BS_THREADLOCAL UINT32 JobScheduler::sWorkerSchedulerId = 0;
+	BS_THREADLOCAL INT32 JobScheduler::sWorkerIdx = -1;
+	std::atomic<UINT32> JobScheduler::sNextSchedulerId{1};
+
+	JobQueue::JobQueue()
+		:mTop(0), mBottom(0)
+	{
+		for(UINT32 i = 0; i < CAPACITY; i++)
+			mJobs[i].store(nullptr, std::memory_order_relaxed);
+	}
+
+	bool JobQueue::push(Job* job)
+	{
+		const INT64 bottom = mBottom.load(std::memory_order_relaxed);
+		const INT64 top = mTop.load(std::memory_order_acquire);
+
+		if((bottom - top) >= (INT64)CAPACITY)
+			return false;
+
+		mJobs[bottom & MASK].store(job, std::memory_order_relaxed);
+		mBottom.store(bottom + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	Job* JobQueue::pop()
+	{
+		const INT64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+		mBottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		INT64 top = mTop.load(std::memory_order_relaxed);
+		if(top > bottom)
+		{
+			// Queue is empty
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Job* job = mJobs[bottom & MASK].load(std::memory_order_relaxed);
+		if(top != bottom)
+			return job;
+
+		// Last job in the queue, race against any stealing threads
+		if(!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			job = nullptr;
+
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+		return job;
+	}
+
+	Job* JobQueue::steal()
+	{
+		INT64 top = mTop.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const INT64 bottom = mBottom.load(std::memory_order_acquire);
+
+		if(top >= bottom)
+			return nullptr;
+
+		Job* job = mJobs[top & MASK].load(std::memory_order_relaxed);
+		if(!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr; // Another thread got it first
+
+		return job;
+	}
+
+	bool JobQueue::isEmpty() const
+	{
+		return mBottom.load(std::memory_order_relaxed) <= mTop.load(std::memory_order_relaxed);
+	}
+
+	JobScheduler::JobScheduler(UINT32 numWorkers)
+		: mNumActiveWorkers(0), mShutdown(false), mSharedQueueSize(0), mNumSleepingWorkers(0), mNumWaiters(0)
+	{
+		mId = sNextSchedulerId.fetch_add(1);
+		mNumWorkers = numWorkers != 0 ? numWorkers : std::max((UINT32)BS_THREAD_HARDWARE_CONCURRENCY, 1U);
+		mNumActiveWorkers = (INT32)mNumWorkers;
+
+		mWorkerQueues = (JobQueue*)bs_alloc_aligned(sizeof(JobQueue) * mNumWorkers, alignof(JobQueue));
+		for(UINT32 i = 0; i < mNumWorkers; i++)
+			new (&mWorkerQueues[i]) JobQueue();
+
+		mWorkerThreads.reserve(mNumWorkers);
+		for(UINT32 i = 0; i < mNumWorkers; i++)
+			mWorkerThreads.push_back(ThreadPool::instance().run("JobWorker", std::bind(&JobScheduler::runWorker, this, i)));
+	}
+
+	JobScheduler::~JobScheduler()
+	{
+		{
+			Lock lock(mSleepMutex);
+			mShutdown = true;
+		}
+
+		mWorkCond.notify_all();
+		mActiveWorkersCond.notify_all();
+
+		for(auto& thread : mWorkerThreads)
+			thread.blockUntilComplete();
+
+		for(UINT32 i = 0; i < mNumWorkers; i++)
+			mWorkerQueues[i].~JobQueue();
+
+		bs_free_aligned(mWorkerQueues);
+
+		for(auto& entry : mThreadPools)
+		{
+			bs_free_aligned(entry.second->jobs);
+			bs_delete(entry.second);
+		}
+	}
+
+	Job* JobScheduler::createJob(JobFunction function, Job* parent)
+	{
+		JobPool& pool = getThreadPool();
+
+		// Find the next job in the ring that isn't in flight. In normal use the very first candidate is free.
+		Job* job = nullptr;
+		while(job == nullptr)
+		{
+			for(UINT32 i = 0; i < JobPool::SIZE; i++)
+			{
+				Job* candidate = &pool.jobs[pool.next++ & (JobPool::SIZE - 1)];
+				if(isComplete(candidate))
+				{
+					job = candidate;
+					break;
+				}
+			}
+
+			// All jobs from this thread are still in flight, help out until some of them complete
+			if(job == nullptr)
+			{
+				Job* queuedJob = findJob(getWorkerIndex());
+				if(queuedJob)
+					execute(queuedJob);
+				else
+					std::this_thread::yield();
+			}
+		}
+
+		// Generation must be visible before the job is marked as unfinished, see isComplete(const JobHandle&)
+		job->function = function;
+		job->parent = parent;
+		job->generation.store(job->generation.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		job->unfinishedJobs.store(1, std::memory_order_release);
+
+		if(parent)
+			parent->unfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+
+		return job;
+	}
+
+	JobHandle JobScheduler::run(Job* job)
+	{
+		JobHandle handle;
+		handle.job = job;
+		handle.generation = job->generation.load(std::memory_order_relaxed);
+
+		const INT32 workerIdx = getWorkerIndex();
+		if(workerIdx >= 0)
+		{
+			// Queue overflowed, the calling worker will have to execute the job itself
+			if(!mWorkerQueues[workerIdx].push(job))
+			{
+				execute(job);
+				return handle;
+			}
+		}
+		else
+		{
+			ScopedSpinLock lock(mSharedQueueLock);
+
+			mSharedQueue.push_back(job);
+			mSharedQueueSize.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		wakeWorker();
+		return handle;
+	}
+
+	void JobScheduler::addWorker()
+	{
+		{
+			Lock lock(mSleepMutex);
+			mNumActiveWorkers.fetch_add(1);
+		}
+
+		mActiveWorkersCond.notify_all();
+	}
+
+	void JobScheduler::removeWorker()
+	{
+		mNumActiveWorkers.fetch_sub(1);
+	}
+
+	void JobScheduler::runWorker(UINT32 index)
+	{
+		// A pool thread only runs a single worker loop at a time, so it can only be a worker of a single scheduler
+		sWorkerIdx = (INT32)index;
+		sWorkerSchedulerId = mId;
+
+		while(true)
+		{
+			if(mShutdown.load(std::memory_order_relaxed))
+				break;
+
+			if((INT32)index >= mNumActiveWorkers.load(std::memory_order_relaxed))
+			{
+				Lock lock(mSleepMutex);
+				while((INT32)index >= mNumActiveWorkers && !mShutdown)
+					mActiveWorkersCond.wait(lock);
+
+				continue;
+			}
+
+			Job* job = findJob((INT32)index);
+			if(job)
+			{
+				execute(job);
+				continue;
+			}
+
+			// Check for a while before going to sleep, as work is often submitted in short bursts
+			bool hasWork = false;
+			for(UINT32 i = 0; i < WORKER_SPIN_COUNT; i++)
+			{
+				std::this_thread::yield();
+
+				if(hasQueuedJobs())
+				{
+					hasWork = true;
+					break;
+				}
+			}
+
+			if(hasWork)
+				continue;
+
+			Lock lock(mSleepMutex);
+			mNumSleepingWorkers.fetch_add(1);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			while(!hasQueuedJobs() && !mShutdown && (INT32)index < mNumActiveWorkers)
+				mWorkCond.wait(lock);
+
+			mNumSleepingWorkers.fetch_sub(1);
+
+			// If we got woken up but are no longer allowed to run, pass the notification on to another worker
+			if((INT32)index >= mNumActiveWorkers && hasQueuedJobs())
+				mWorkCond.notify_one();
+		}
+
+		sWorkerIdx = -1;
+		sWorkerSchedulerId = 0;
+
+		// Pool thread can be re-used after the scheduler is gone, make sure it doesn't keep the cached pool around
+		for(auto& entry : sThreadPools)
+		{
+			if(entry.schedulerId == mId)
+				entry = CachedJobPool();
+		}
+	}
+
+	void JobScheduler::execute(Job* job)
+	{
+		job->function(job, job->data);
+		finish(job);
+	}
+
+	void JobScheduler::finish(Job* job)
+	{
+		// Once the job is complete its slot can be re-used by createJob(), so its contents can't be accessed afterwards
+		Job* parent = job->parent;
+
+		const INT32 unfinishedJobs = job->unfinishedJobs.fetch_sub(1) - 1;
+		if(unfinishedJobs > 0)
+			return;
+
+		if(parent)
+			finish(parent);
+
+		if(mNumWaiters.load() > 0)
+		{
+			Lock lock(mSleepMutex);
+			mCompleteCond.notify_all();
+		}
+	}
+
+	Job* JobScheduler::findJob(INT32 workerIdx)
+	{
+		if(workerIdx >= 0)
+		{
+			Job* job = mWorkerQueues[workerIdx].pop();
+			if(job)
+				return job;
+		}
+
+		if(mSharedQueueSize.load(std::memory_order_relaxed) > 0)
+		{
+			ScopedSpinLock lock(mSharedQueueLock);
+			if(!mSharedQueue.empty())
+			{
+				Job* job = mSharedQueue.front();
+				mSharedQueue.pop_front();
+				mSharedQueueSize.fetch_sub(1, std::memory_order_relaxed);
+
+				return job;
+			}
+		}
+
+		// Try to steal from other workers, starting from the neighbour so not every thread hits the same queue
+		const UINT32 start = workerIdx >= 0 ? (UINT32)workerIdx + 1 : 0;
+		for(UINT32 i = 0; i < mNumWorkers; i++)
+		{
+			const UINT32 victimIdx = (start + i) % mNumWorkers;
+			if((INT32)victimIdx == workerIdx)
+				continue;
+
+			Job* job = mWorkerQueues[victimIdx].steal();
+			if(job)
+				return job;
+		}
+
+		return nullptr;
+	}
+
+	bool JobScheduler::hasQueuedJobs() const
+	{
+		if(mSharedQueueSize.load() > 0)
+			return true;
+
+		for(UINT32 i = 0; i < mNumWorkers; i++)
+		{
+			if(!mWorkerQueues[i].isEmpty())
+				return true;
+		}
+
+		return false;
+	}
+
+	INT32 JobScheduler::getWorkerIndex() const
+	{
+		if(sWorkerSchedulerId != mId)
+			return -1;
+
+		return sWorkerIdx;
+	}
+
+	JobScheduler::JobPool& JobScheduler::getThreadPool()
+	{
+		for(auto& entry : sThreadPools)
+		{
+			if(entry.schedulerId == mId)
+				return *entry.pool;
+		}
+
+		// Not cached, either the first job from this thread or the thread uses more schedulers than can be cached
+		JobPool* pool;
+		{
+			Lock lock(mThreadPoolsMutex);
+
+			JobPool*& threadPool = mThreadPools[BS_THREAD_CURRENT_ID];
+			if(threadPool == nullptr)
+			{
+				threadPool = bs_new<JobPool>();
+				threadPool->jobs = (Job*)bs_alloc_aligned(sizeof(Job) * JobPool::SIZE, alignof(Job));
+
+				for(UINT32 i = 0; i < JobPool::SIZE; i++)
+				{
+					threadPool->jobs[i].unfinishedJobs.store(0, std::memory_order_relaxed);
+					threadPool->jobs[i].generation.store(0, std::memory_order_relaxed);
+				}
+			}
+
+			pool = threadPool;
+		}
+
+		CachedJobPool& entry = sThreadPools[sNextThreadPoolSlot++ % NUM_CACHED_POOLS];
+		entry.schedulerId = mId;
+		entry.pool = pool;
+
+		return *pool;
+	}
+
+	void JobScheduler::wakeWorker()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if(mNumSleepingWorkers.load() > 0)
+		{
+			Lock lock(mSleepMutex);
+			mWorkCond.notify_one();
+		}
+		else if(mNumWaiters.load() > 0)
+		{
+			// No workers to wake, let the waiting threads pick up the work instead
+			Lock lock(mSleepMutex);
+			mCompleteCond.notify_all();
+		}
+	}
+
+	void JobScheduler::parallelForJob(Job* job, const void* data)
+	{
+		ParallelForData range = *(const ParallelForData*)data;
+
+		// Keep splitting off the upper half as a child job (so other workers can steal it) and process the rest locally
+		JobScheduler& scheduler = *range.scheduler;
+		while(range.count > range.granularity)
+		{
+			const UINT32 half = range.count / 2;
+
+			ParallelForData upper = range;
+			upper.start += half;
+			upper.count -= half;
+
+			scheduler.run(scheduler.createJob(&parallelForJob, upper, job));
+			range.count = half;
+		}
+
+		range.invoke(range.functor, range.start, range.count);
+	}
+}
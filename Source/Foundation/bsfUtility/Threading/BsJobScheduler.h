@@ -0,0 +1,376 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Utility/BsModule.h"
+#include "Threading/BsThreadPool.h"
+
+namespace bs
+{
+	/** @addtogroup Threading
+	 *  @{
+	 */
+
+	struct Job;
+
+	/** Signature of the method executed by a job. Receives the job being executed and a pointer to its payload. */
+	typedef void(*JobFunction)(Job* job, const void* data);
+
+	/** Maximum size of the payload (e.g. lambda captures) that can be stored within a Job. */
+	static constexpr UINT32 JOB_PAYLOAD_SIZE = 64 - sizeof(JobFunction) - sizeof(Job*) - sizeof(std::atomic<INT32>) - 
+		sizeof(std::atomic<UINT32>);
+
+	/**
+	 * Smallest unit of work that can be executed by the JobScheduler. Jobs are allocated from a per-thread pool and
+	 * are sized to a single cache line. Jobs can have children, in which case the job is not considered complete
+	 * until all of its children complete.
+	 *
+	 * @note
+	 * Jobs are recycled by the pool so a job pointer is only valid until the job completes. Use the JobHandle returned
+	 * by JobScheduler::run() to refer to the job afterwards.
+	 */
+	struct alignas(64) Job
+	{
+		JobFunction function;
+		Job* parent;
+		std::atomic<INT32> unfinishedJobs;
+		std::atomic<UINT32> generation; /**< Incremented every time the job slot is re-used. */
+		UINT8 data[JOB_PAYLOAD_SIZE];
+	};
+
+	static_assert(sizeof(Job) == 64, "Job must fit within a single cache line.");
+
+	/**
+	 * Reference to a job that stays valid after the job completes. Once the job's slot is re-used by another job the
+	 * generation no longer matches, and the handle reports the job as complete.
+	 */
+	struct JobHandle
+	{
+		Job* job = nullptr;
+		UINT32 generation = 0;
+	};
+
+	/** @} */
+
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Threading-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Fixed size, lock-free, double ended queue of jobs (Chase-Lev). The owning thread pushes and pops jobs from the
+	 * bottom of the queue while any other thread can steal jobs from the top.
+	 */
+	class JobQueue
+	{
+	public:
+		/** Maximum number of jobs that can be in the queue. */
+		static constexpr UINT32 CAPACITY = 4096;
+
+		JobQueue();
+
+		/** Pushes a job on the bottom of the queue. Returns false if the queue is full. Only callable by the owner. */
+		bool push(Job* job);
+
+		/** Pops a job from the bottom of the queue. Returns null if the queue is empty. Only callable by the owner. */
+		Job* pop();
+
+		/** Takes a job from the top of the queue. Returns null if the queue is empty. Callable from any thread. */
+		Job* steal();
+
+		/** Returns true if the queue has no jobs in it. Result is only approximate when called from non-owner threads. */
+		bool isEmpty() const;
+
+	private:
+		static constexpr UINT32 MASK = CAPACITY - 1;
+
+		alignas(64) std::atomic<INT64> mTop;
+		alignas(64) std::atomic<INT64> mBottom;
+		alignas(64) std::atomic<Job*> mJobs[CAPACITY];
+	};
+
+	/** @} */
+	/** @} */
+
+	/** @addtogroup Threading
+	 *  @{
+	 */
+
+	/**
+	 * Job scheduler designed for large amounts (tens of thousands per frame) of very small jobs. Each worker thread owns
+	 * its own queue of jobs, and idle workers steal jobs from the queues of other workers. Jobs are allocated from
+	 * per-thread pools and never touch the heap.
+	 *
+	 * Threads that are not workers of the scheduler (e.g. the main or the core thread) submit their jobs into a shared
+	 * queue from which the workers take them. Any thread waiting on a job will help execute other queued jobs in the
+	 * meantime.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT JobScheduler : public Module<JobScheduler>
+	{
+	public:
+		/**
+		 * Creates the scheduler and starts the worker threads.
+		 *
+		 * @param[in]	numWorkers	Number of worker threads to create. If zero, one worker per logical core is created.
+		 */
+		JobScheduler(UINT32 numWorkers = 0);
+		~JobScheduler();
+
+		/**
+		 * Creates a new job. The job will not execute until run() is called.
+		 *
+		 * @param[in]	function	Method to execute.
+		 * @param[in]	parent		(optional) Parent job, if any. Parent will not complete until all of its children
+		 *							complete. Child must be ran before its parent finishes executing.
+		 */
+		Job* createJob(JobFunction function, Job* parent = nullptr);
+
+		/**
+		 * Creates a new job and copies the provided data into its payload. The data is passed to the job function when
+		 * it executes.
+		 */
+		template<class T>
+		Job* createJob(JobFunction function, const T& data, Job* parent = nullptr)
+		{
+			static_assert(sizeof(T) <= JOB_PAYLOAD_SIZE, "Job data too large.");
+			static_assert(std::is_trivially_copyable<T>::value, "Job data must be trivially copyable.");
+
+			Job* job = createJob(function, parent);
+			memcpy(job->data, &data, sizeof(T));
+
+			return job;
+		}
+
+		/**
+		 * Creates a new job executing the provided callable. The callable is stored within the job itself and its
+		 * captures must fit into JOB_PAYLOAD_SIZE bytes.
+		 */
+		template<class F>
+		Job* createJobFromCallable(F&& callable, Job* parent = nullptr)
+		{
+			using Callable = typename std::decay<F>::type;
+			static_assert(sizeof(Callable) <= JOB_PAYLOAD_SIZE, "Callable captures are too large to store within a job.");
+
+			Job* job = createJob(&invokeCallable<Callable>, parent);
+			new (job->data) Callable(std::forward<F>(callable));
+
+			return job;
+		}
+
+		/** 
+		 * Queues the job for execution. Returns a handle that can be used for waiting on the job. The job pointer itself
+		 * must not be accessed after this call.
+		 */
+		JobHandle run(Job* job);
+
+		/**
+		 * Blocks until the job (and all of its children) complete. While waiting the calling thread will execute other
+		 * queued jobs.
+		 */
+		void wait(const JobHandle& handle)
+		{
+			waitUntil([handle]() { return isComplete(handle); });
+		}
+
+		/**
+		 * Blocks until the provided predicate returns true. While waiting the calling thread will execute other queued
+		 * jobs. The predicate is re-checked whenever a job completes, so it should only depend on state modified by
+		 * jobs of this scheduler.
+		 */
+		template<class Predicate>
+		void waitUntil(Predicate predicate)
+		{
+			const INT32 workerIdx = getWorkerIndex();
+			while(!predicate())
+			{
+				Job* job = findJob(workerIdx);
+				if(job)
+				{
+					execute(job);
+					continue;
+				}
+
+				Lock lock(mSleepMutex);
+				mNumWaiters.fetch_add(1);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				while(!predicate() && !hasQueuedJobs())
+					mCompleteCond.wait(lock);
+
+				mNumWaiters.fetch_sub(1);
+			}
+		}
+
+		/** Returns true if the job and all of its children have finished executing. */
+		static bool isComplete(const JobHandle& handle)
+		{
+			if(isComplete(handle.job))
+				return true;
+
+			// Slot is only re-used once the job completes. createJob() bumps the generation before marking the new
+			// job as unfinished, so the acquire above guarantees the new generation is visible here.
+			return handle.job->generation.load(std::memory_order_relaxed) != handle.generation;
+		}
+
+		/**
+		 * Splits the [0, count) range into chunks of at most @p granularity elements and executes @p func on each chunk
+		 * in parallel. Returns a handle to the root job which completes once all chunks complete. The functor must remain
+		 * valid until the returned job completes.
+		 *
+		 * @param[in]	count		Number of elements to iterate over.
+		 * @param[in]	granularity	Maximum number of elements to process by a single job.
+		 * @param[in]	func		Functor with signature void(UINT32 start, UINT32 count).
+		 * @param[in]	parent		(optional) Parent of the returned job.
+		 */
+		template<class F>
+		JobHandle parallelFor(UINT32 count, UINT32 granularity, const F& func, Job* parent = nullptr)
+		{
+			ParallelForData data;
+			data.scheduler = this;
+			data.functor = &func;
+			data.invoke = &invokeRangeFunctor<F>;
+			data.start = 0;
+			data.count = count;
+			data.granularity = std::max(granularity, 1U);
+
+			return run(createJob(&parallelForJob, data, parent));
+		}
+
+		/** Same as parallelFor(), but blocks until all the elements are processed, helping out in the meantime. */
+		template<class F>
+		void parallelForAndWait(UINT32 count, UINT32 granularity, const F& func)
+		{
+			wait(parallelFor(count, granularity, func));
+		}
+
+		/** Allows one more worker thread to execute jobs, up to the number of created worker threads. */
+		void addWorker();
+
+		/** Prevents one of the worker threads from executing jobs (as soon as its current job is finished). */
+		void removeWorker();
+
+		/** Returns the number of worker threads currently allowed to execute jobs. */
+		UINT32 getNumActiveWorkers() const { return (UINT32)std::max(mNumActiveWorkers.load(), 0); }
+
+		/** Returns the total number of worker threads created by the scheduler. */
+		UINT32 getNumWorkers() const { return mNumWorkers; }
+
+	private:
+		/** Per-thread ring buffer of jobs. */
+		struct JobPool
+		{
+			static constexpr UINT32 SIZE = 4096;
+
+			Job* jobs = nullptr;
+			UINT32 next = 0;
+		};
+
+		/** Job pool used by the calling thread for a specific scheduler. */
+		struct CachedJobPool
+		{
+			UINT32 schedulerId;
+			JobPool* pool;
+		};
+
+		/** Number of schedulers whose job pools each thread keeps a direct reference to. */
+		static constexpr UINT32 NUM_CACHED_POOLS = 4;
+
+		/** Payload used by parallelFor() jobs. */
+		struct ParallelForData
+		{
+			JobScheduler* scheduler;
+			const void* functor;
+			void(*invoke)(const void*, UINT32, UINT32);
+			UINT32 start;
+			UINT32 count;
+			UINT32 granularity;
+		};
+
+		/** Main loop of a worker thread. */
+		void runWorker(UINT32 index);
+
+		/** Executes the job, and marks it as finished. */
+		void execute(Job* job);
+
+		/** Decrements the unfinished counter of the job and notifies the parent if the job is done. */
+		void finish(Job* job);
+
+		/** Attempts to find a job to execute, from own queue first, then the shared queue and finally other workers. */
+		Job* findJob(INT32 workerIdx);
+
+		/** Returns true if the job and all of its children have finished executing. */
+		static bool isComplete(const Job* job)
+		{
+			return job->unfinishedJobs.load(std::memory_order_acquire) <= 0;
+		}
+
+		/** Returns true if there are any jobs queued in any of the queues. */
+		bool hasQueuedJobs() const;
+
+		/** Returns the index of the worker running on the calling thread, or -1 if not called from a worker. */
+		INT32 getWorkerIndex() const;
+
+		/** 
+		 * Returns the job pool for the calling thread, creating it if needed. Each thread has a separate pool for every 
+		 * scheduler it creates jobs on.
+		 */
+		JobPool& getThreadPool();
+
+		/** Wakes a sleeping worker, if any. */
+		void wakeWorker();
+
+		/** Job method used for splitting parallelFor() ranges. */
+		static void parallelForJob(Job* job, const void* data);
+
+		/** Job method used for executing callables stored in the job payload. */
+		template<class Callable>
+		static void invokeCallable(Job* job, const void* data)
+		{
+			Callable* callable = (Callable*)data;
+			(*callable)();
+			callable->~Callable();
+		}
+
+		/** Forwards a range to the parallelFor() functor. */
+		template<class F>
+		static void invokeRangeFunctor(const void* functor, UINT32 start, UINT32 count)
+		{
+			(*(const F*)functor)(start, count);
+		}
+
+		static BS_THREADLOCAL CachedJobPool sThreadPools[NUM_CACHED_POOLS];
+		static BS_THREADLOCAL UINT32 sNextThreadPoolSlot;
+		static BS_THREADLOCAL UINT32 sWorkerSchedulerId;
+		static BS_THREADLOCAL INT32 sWorkerIdx;
+		static std::atomic<UINT32> sNextSchedulerId;
+
+		UINT32 mId = 0;
+		UINT32 mNumWorkers = 0;
+		JobQueue* mWorkerQueues = nullptr;
+		Vector<HThread> mWorkerThreads;
+		std::atomic<INT32> mNumActiveWorkers;
+		std::atomic<bool> mShutdown;
+
+		Deque<Job*> mSharedQueue;
+		std::atomic<UINT32> mSharedQueueSize;
+		SpinLock mSharedQueueLock;
+
+		UnorderedMap<ThreadId, JobPool*> mThreadPools;
+		Mutex mThreadPoolsMutex;
+
+		std::atomic<UINT32> mNumSleepingWorkers;
+		std::atomic<UINT32> mNumWaiters;
+		Mutex mSleepMutex;
+		Signal mWorkCond;
+		Signal mActiveWorkersCond;
+		Signal mCompleteCond;
+	};
+
+	/** @} */
+}
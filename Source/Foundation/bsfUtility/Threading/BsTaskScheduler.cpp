@@ -1,7 +1,6 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Threading/BsTaskScheduler.h"
-#include "Threading/BsThreadPool.h"
 
 namespace bs
 {
@@ -41,144 +40,136 @@ namespace bs
 
 	TaskScheduler::TaskScheduler()
 		:mTaskQueue(&TaskScheduler::taskCompare)
-	{
-		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
-
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
-	}
+	{ }
 
 	TaskScheduler::~TaskScheduler()
 	{
-		// Wait until all tasks complete
-		{
-			Lock activeTaskLock(mReadyMutex);
-
-			while (mActiveTasks.size() > 0)
-			{
-				SPtr<Task> task = mActiveTasks[0];
-				activeTaskLock.unlock();
-
-				task->wait();
-				activeTaskLock.lock();
-			}
-		}
-
-		// Start shutdown of the main queue worker and wait until it exits
+		// Wait until all tasks complete, any tasks that haven't started yet are discarded
 		{
 			Lock lock(mReadyMutex);
-
 			mShutdown = true;
 		}
 
-		mTaskReadyCond.notify_one();
-
-		mTaskSchedulerThread.blockUntilComplete();
+		JobScheduler::instance().waitUntil([this]()
+		{
+			Lock lock(mReadyMutex);
+			return mNumActiveTasks == 0 && mNumQueuedJobs == 0;
+		});
 	}
 
 	void TaskScheduler::addTask(SPtr<Task> task)
 	{
-		Lock lock(mReadyMutex);
+		UINT32 numJobs;
+		{
+			Lock lock(mReadyMutex);
 
-		assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
+			assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
 
-		task->mParent = this;
-		task->mTaskId = mNextTaskId++;
-		task->mState.store(0); // Reset state in case the task is getting re-queued
+			task->mParent = this;
+			task->mTaskId = mNextTaskId++;
+			task->mState.store(0); // Reset state in case the task is getting re-queued
 
-		mCheckTasks = true;
-		mTaskQueue.insert(std::move(task));
+			mTaskQueue.insert(std::move(task));
+			numJobs = reserveJobs();
+		}
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+		queueJobs(numJobs);
 	}
 
 	void TaskScheduler::addWorker()
 	{
-		Lock lock(mReadyMutex);
-
-		mMaxActiveTasks++;
-
-		// A spot freed up, queue new tasks on main scheduler thread if they exist
-		mTaskReadyCond.notify_one();
+		JobScheduler::instance().addWorker();
 	}
 
 	void TaskScheduler::removeWorker()
 	{
-		Lock lock(mReadyMutex);
+		JobScheduler::instance().removeWorker();
+	}
 
-		if(mMaxActiveTasks > 0)
-			mMaxActiveTasks--;
+	UINT32 TaskScheduler::getNumWorkers() const
+	{
+		return JobScheduler::instance().getNumActiveWorkers();
 	}
 
-	void TaskScheduler::runMain()
+	void TaskScheduler::runTaskJob(Job* job, const void* data)
 	{
-		while(true)
+		TaskScheduler* scheduler = *(TaskScheduler* const*)data;
+		scheduler->runNextTask();
+	}
+
+	void TaskScheduler::runNextTask()
+	{
+		SPtr<Task> task;
 		{
 			Lock lock(mReadyMutex);
+			mNumQueuedJobs--;
 
-			while((!mCheckTasks || (UINT32)mActiveTasks.size() >= mMaxActiveTasks) && !mShutdown)
-				mTaskReadyCond.wait(lock);
-
-			mCheckTasks = false;
-
-			if(mShutdown)
-				break;
-
-			for(auto iter = mTaskQueue.begin(); iter != mTaskQueue.end();)
+			if(!mShutdown)
 			{
-				if ((UINT32)mActiveTasks.size() >= mMaxActiveTasks)
-					break;	
-
-				SPtr<Task> curTask = *iter;
-
-				if(curTask->isCanceled())
+				for (auto iter = mTaskQueue.begin(); iter != mTaskQueue.end();)
 				{
-					iter = mTaskQueue.erase(iter);
-					continue;
+					const SPtr<Task>& curTask = *iter;
+
+					if (curTask->isCanceled())
+					{
+						iter = mTaskQueue.erase(iter);
+						continue;
+					}
+
+					if (curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
+					{
+						++iter;
+						continue;
+					}
+
+					task = curTask;
+					mTaskQueue.erase(iter);
+					break;
 				}
+			}
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
-				{
-					++iter;
-					continue;
-				}
-
-				iter = mTaskQueue.erase(iter);
-
-				curTask->mState.store(1);
-				mActiveTasks.push_back(curTask);
+			if(task == nullptr)
+				return;
 
-				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
-			}
+			task->mState.store(1);
+			mNumActiveTasks++;
 		}
-	}
 
-	void TaskScheduler::runTask(SPtr<Task> task)
-	{
 		task->mTaskWorker();
+		task->mState.store(2);
 
+		UINT32 numJobs = 0;
 		{
 			Lock lock(mReadyMutex);
+			mNumActiveTasks--;
 
-			auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
-			if (findIter != mActiveTasks.end())
-				mActiveTasks.erase(findIter);
+			// This task might have been someone's dependency, make sure waiting tasks get picked up
+			if(!mShutdown)
+				numJobs = reserveJobs();
 		}
 
-		{
-			Lock lock(mCompleteMutex);
-			task->mState.store(2);
+		queueJobs(numJobs);
+	}
 
-			mTaskCompleteCond.notify_all();
-		}
+	UINT32 TaskScheduler::reserveJobs()
+	{
+		const UINT32 numTasks = (UINT32)mTaskQueue.size();
+		if(mNumQueuedJobs >= numTasks)
+			return 0;
 
-		// Wake the main scheduler thread in case there are other tasks waiting or this task was someone's dependency
-		{
-			Lock lock(mReadyMutex);
+		const UINT32 numJobs = numTasks - mNumQueuedJobs;
+		mNumQueuedJobs += numJobs;
 
-			mCheckTasks = true;
-			mTaskReadyCond.notify_one();
-		}
+		return numJobs;
+	}
+
+	void TaskScheduler::queueJobs(UINT32 count)
+	{
+		JobScheduler& jobScheduler = JobScheduler::instance();
+
+		TaskScheduler* scheduler = this;
+		for(UINT32 i = 0; i < count; i++)
+			jobScheduler.run(jobScheduler.createJob(&TaskScheduler::runTaskJob, scheduler));
 	}
 
 	void TaskScheduler::waitUntilComplete(const Task* task)
@@ -186,16 +177,7 @@ namespace bs
 		if(task->isCanceled())
 			return;
 
-		{
-			Lock lock(mCompleteMutex);
-
-			while(!task->isComplete())
-			{
-				addWorker();
-				mTaskCompleteCond.wait(lock);
-				removeWorker();
-			}
-		}
+		JobScheduler::instance().waitUntil([task]() { return task->isComplete() || task->isCanceled(); });
 	}
 
 	bool TaskScheduler::taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs)
@@ -4,7 +4,7 @@
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Utility/BsModule.h"
-#include "Threading/BsThreadPool.h"
+#include "Threading/BsJobScheduler.h"
 
 namespace bs
 {
@@ -57,7 +57,7 @@ namespace bs
 		/**
 		 * Blocks the current thread until the task has completed.
 		 *
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @note	While waiting the thread executes other queued jobs, so that the blocking threads core can be utilized.
 		 */
 		void wait();
 
@@ -84,11 +84,11 @@ namespace bs
 	 * @note
 	 * Thread safe.
 	 * @note
-	 * This type of task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks
-	 * in the order of hundreds. Higher number of tasks might require different queuing and locking mechanism, potentially
-	 * at the cost of flexibility.)
+	 * Tasks are executed on the worker threads of the JobScheduler. This scheduler keeps a global queue in order to
+	 * support task priorities and dependencies, and is best used for coarse granularity of tasks (number of tasks in the
+	 * order of hundreds). For large amounts of small tasks use JobScheduler directly.
 	 * @note
-	 * By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
+	 * By default the task scheduler will use as many threads as there are logical CPU cores. You may add or remove
 	 * threads using addWorker()/removeWorker() methods.
 	 */
 	class BS_UTILITY_EXPORT TaskScheduler : public Module<TaskScheduler>
@@ -107,15 +107,24 @@ namespace bs
 		void removeWorker();
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
-		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+		UINT32 getNumWorkers() const;
 	protected:
 		friend class Task;
 
-		/**	Main task scheduler method that dispatches tasks to other threads. */
-		void runMain();
+		/** Job method that executes the highest priority task that is ready to run. */
+		static void runTaskJob(Job* job, const void* data);
 
-		/**	Worker method that runs a single task. */
-		void runTask(SPtr<Task> task);
+		/**	Runs the highest priority task that is ready to run, if any. */
+		void runNextTask();
+
+		/**
+		 * Returns the number of jobs that need to be queued so every queued task has a job that can pick it up, and
+		 * registers them as queued. Caller must hold mReadyMutex.
+		 */
+		UINT32 reserveJobs();
+
+		/** Queues the specified number of jobs executing runNextTask(). Must be called without holding mReadyMutex. */
+		void queueJobs(UINT32 count);
 
 		/**	Blocks the calling thread until the specified task has completed. */
 		void waitUntilComplete(const Task* task);
@@ -123,18 +132,13 @@ namespace bs
 		/**	Method used for sorting tasks. */
 		static bool taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs);
 
-		HThread mTaskSchedulerThread;
 		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
-		Vector<SPtr<Task>> mActiveTasks;
-		UINT32 mMaxActiveTasks = 0;
+		UINT32 mNumQueuedJobs = 0;
+		UINT32 mNumActiveTasks = 0;
 		UINT32 mNextTaskId = 0;
 		bool mShutdown = false;
-		bool mCheckTasks = false;
 
 		Mutex mReadyMutex;
-		Mutex mCompleteMutex;
-		Signal mTaskReadyCond;
-		Signal mTaskCompleteCond;
 	};
 
 	/** @} */
@@ -2,11 +2,30 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Utility/BsCompression.h"
 #include "FileSystem/BsDataStream.h"
+#include "Threading/BsJobScheduler.h"
+#include "Math/BsMath.h"
+#include "Debug/BsDebug.h"
 
 // Third party
 #include "snappy.h"
 #include "snappy-sinksource.h"
-#include "Debug/BsDebug.h"
+
+#ifndef BS_COMPRESSION_LZ4
+#define BS_COMPRESSION_LZ4 0
+#endif
+
+#ifndef BS_COMPRESSION_ZSTD
+#define BS_COMPRESSION_ZSTD 0
+#endif
+
+#if BS_COMPRESSION_LZ4
+#include "lz4.h"
+#include "lz4hc.h"
+#endif
+
+#if BS_COMPRESSION_ZSTD
+#include "zstd.h"
+#endif
 
 namespace bs
 {
@@ -21,6 +40,8 @@ namespace bs
 
 			if (mStream->isFile())
 				mReadBuffer = (char*)bs_alloc(2048);
+			else
+				mBufferOffset = mStream->tell();
 		}
 
 		virtual ~DataStreamSource()
@@ -191,4 +212,432 @@ namespace bs
 
 		return dst.GetOutput();
 	}
+
+	/** Identifies data compressed by Compression::compressBlocks(). */
+	static constexpr UINT32 BLOCK_MAGIC = 0x4B4C4246; // "FBLK"
+
+	/** Version of the block format, increment when the format changes. */
+	static constexpr UINT8 BLOCK_FORMAT_VERSION = 0;
+
+	/** Set on the compressed size of blocks which are stored uncompressed, because compression didn't reduce their size. */
+	static constexpr UINT32 BLOCK_STORED_FLAG = 0x80000000;
+
+	/**
+	 * Header written at the start of data compressed by Compression::compressBlocks(). Followed by a table containing the
+	 * compressed size of each block, and then by the compressed blocks themselves.
+	 */
+	struct CompressedBlocksHeader
+	{
+		UINT32 magic;
+		UINT8 version;
+		UINT8 codec;
+		UINT16 reserved;
+		UINT32 blockSize;
+		UINT32 numBlocks;
+		UINT64 uncompressedSize;
+	};
+
+	static_assert(sizeof(CompressedBlocksHeader) == 24, "Unexpected padding in the compressed block header.");
+
+	/** Returns the maximum size of a single block after compression with the specified codec. */
+	static size_t getMaxCompressedBlockSize(CompressionCodec codec, size_t size)
+	{
+		switch(codec)
+		{
+#if BS_COMPRESSION_LZ4
+		case CompressionCodec::LZ4:
+			return (size_t)LZ4_compressBound((int)size);
+#endif
+#if BS_COMPRESSION_ZSTD
+		case CompressionCodec::Zstd:
+			return ZSTD_compressBound(size);
+#endif
+		default:
+			return snappy::MaxCompressedLength(size);
+		}
+	}
+
+	/**
+	 * Compresses a single block of data. Returns the size of the compressed data, or zero if compression failed. Output
+	 * buffer must have at least getMaxCompressedBlockSize() bytes.
+	 */
+	static size_t compressBlock(CompressionCodec codec, INT32 level, const UINT8* input, size_t inputSize, UINT8* output,
+		size_t outputSize)
+	{
+		switch(codec)
+		{
+#if BS_COMPRESSION_LZ4
+		case CompressionCodec::LZ4:
+		{
+			int compressedSize;
+			if(level > 0)
+			{
+				compressedSize = LZ4_compress_HC((const char*)input, (char*)output, (int)inputSize, (int)outputSize,
+					level);
+			}
+			else
+				compressedSize = LZ4_compress_default((const char*)input, (char*)output, (int)inputSize, (int)outputSize);
+
+			return (size_t)std::max(compressedSize, 0);
+		}
+#endif
+#if BS_COMPRESSION_ZSTD
+		case CompressionCodec::Zstd:
+		{
+			const size_t compressedSize = ZSTD_compress(output, outputSize, input, inputSize, level);
+			if(ZSTD_isError(compressedSize))
+				return 0;
+
+			return compressedSize;
+		}
+#endif
+		default:
+		{
+			size_t compressedSize = 0;
+			snappy::RawCompress((const char*)input, inputSize, (char*)output, &compressedSize);
+
+			return compressedSize;
+		}
+		}
+	}
+
+	/** Decompresses a single block of data. Returns false if the data is corrupt. */
+	static bool decompressBlock(CompressionCodec codec, const UINT8* input, size_t inputSize, UINT8* output,
+		size_t outputSize)
+	{
+		switch(codec)
+		{
+		case CompressionCodec::Snappy:
+		{
+			size_t uncompressedSize = 0;
+			if(!snappy::GetUncompressedLength((const char*)input, inputSize, &uncompressedSize) ||
+				uncompressedSize != outputSize)
+				return false;
+
+			return snappy::RawUncompress((const char*)input, inputSize, (char*)output);
+		}
+#if BS_COMPRESSION_LZ4
+		case CompressionCodec::LZ4:
+		{
+			const int uncompressedSize = LZ4_decompress_safe((const char*)input, (char*)output, (int)inputSize,
+				(int)outputSize);
+
+			return uncompressedSize == (int)outputSize;
+		}
+#endif
+#if BS_COMPRESSION_ZSTD
+		case CompressionCodec::Zstd:
+			return ZSTD_decompress(output, outputSize, input, inputSize) == outputSize;
+#endif
+		default:
+			return false;
+		}
+	}
+
+	/** Calls @p func with the index of each block, in parallel if the JobScheduler is running. */
+	template<class F>
+	static void forEachBlock(UINT32 numBlocks, const F& func)
+	{
+		if(numBlocks < 2 || !JobScheduler::isStarted())
+		{
+			for(UINT32 i = 0; i < numBlocks; i++)
+				func(i);
+
+			return;
+		}
+
+		JobScheduler::instance().parallelForAndWait(numBlocks, 1, [&func](UINT32 start, UINT32 count)
+		{
+			for(UINT32 i = start; i < start + count; i++)
+				func(i);
+		});
+	}
+
+	SPtr<MemoryDataStream> Compression::compressBlocks(const SPtr<DataStream>& input, const COMPRESSION_DESC& desc)
+	{
+		CompressionCodec codec = desc.codec;
+		if(!isSupported(codec))
+		{
+			LOGWRN("Compression codec " + toString((UINT32)codec) + " is not supported in this build. Falling back "
+				"to Snappy.");
+			codec = CompressionCodec::Snappy;
+		}
+
+		const UINT32 blockSize = Math::clamp(desc.blockSize, 1U, BLOCK_STORED_FLAG - 1);
+
+		// Reference memory streams directly, and read everything else in one go
+		const size_t inputSize = input->size() - input->tell();
+
+		const UINT8* inputData;
+		UINT8* inputBuffer = nullptr;
+		if(!input->isFile())
+		{
+			inputData = std::static_pointer_cast<MemoryDataStream>(input)->getCurrentPtr();
+			input->skip(inputSize);
+		}
+		else
+		{
+			inputBuffer = (UINT8*)bs_alloc(inputSize);
+			input->read(inputBuffer, inputSize);
+
+			inputData = inputBuffer;
+		}
+
+		const UINT32 numBlocks = (UINT32)((inputSize + blockSize - 1) / blockSize);
+		const size_t maxCompressedBlockSize = getMaxCompressedBlockSize(codec, blockSize);
+
+		// Every block gets its own range of the scratch buffer, and the blocks are packed together once all are done
+		UINT8* scratch = (UINT8*)bs_alloc(maxCompressedBlockSize * numBlocks);
+		Vector<UINT32> compressedSizes(numBlocks);
+
+		forEachBlock(numBlocks, [&](UINT32 idx)
+		{
+			const size_t blockStart = (size_t)idx * blockSize;
+			const size_t blockLength = std::min((size_t)blockSize, inputSize - blockStart);
+
+			const size_t compressedSize = compressBlock(codec, desc.level, inputData + blockStart, blockLength,
+				scratch + idx * maxCompressedBlockSize, maxCompressedBlockSize);
+
+			// Keep the block uncompressed if compression failed or didn't help
+			if(compressedSize == 0 || compressedSize >= blockLength)
+				compressedSizes[idx] = (UINT32)blockLength | BLOCK_STORED_FLAG;
+			else
+				compressedSizes[idx] = (UINT32)compressedSize;
+		});
+
+		const size_t tableSize = numBlocks * sizeof(UINT32);
+
+		size_t outputSize = sizeof(CompressedBlocksHeader) + tableSize;
+		for(auto& entry : compressedSizes)
+			outputSize += entry & ~BLOCK_STORED_FLAG;
+
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>(outputSize);
+		UINT8* outputData = output->getPtr();
+
+		CompressedBlocksHeader header;
+		header.magic = BLOCK_MAGIC;
+		header.version = BLOCK_FORMAT_VERSION;
+		header.codec = (UINT8)codec;
+		header.reserved = 0;
+		header.blockSize = blockSize;
+		header.numBlocks = numBlocks;
+		header.uncompressedSize = inputSize;
+
+		memcpy(outputData, &header, sizeof(header));
+		outputData += sizeof(header);
+
+		if(numBlocks > 0)
+			memcpy(outputData, compressedSizes.data(), tableSize);
+
+		outputData += tableSize;
+
+		for(UINT32 i = 0; i < numBlocks; i++)
+		{
+			const UINT32 size = compressedSizes[i] & ~BLOCK_STORED_FLAG;
+			if((compressedSizes[i] & BLOCK_STORED_FLAG) != 0)
+				memcpy(outputData, inputData + (size_t)i * blockSize, size);
+			else
+				memcpy(outputData, scratch + i * maxCompressedBlockSize, size);
+
+			outputData += size;
+		}
+
+		bs_free(scratch);
+
+		if(inputBuffer != nullptr)
+			bs_free(inputBuffer);
+
+		return output;
+	}
+
+	SPtr<MemoryDataStream> Compression::decompressBlocks(const SPtr<DataStream>& input)
+	{
+		const size_t start = input->tell();
+
+		CompressedBlockReader reader(input);
+		if(!reader.isValid())
+		{
+			LOGERR("Decompression failed, corrupt data or unsupported codec.");
+			return nullptr;
+		}
+
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>((size_t)reader.getUncompressedSize());
+		if(!reader.readAll(output->getPtr()))
+		{
+			LOGERR("Decompression failed, corrupt data.");
+			return nullptr;
+		}
+
+		input->seek(start + (size_t)reader.getCompressedSize());
+		return output;
+	}
+
+	bool Compression::isSupported(CompressionCodec codec)
+	{
+		switch(codec)
+		{
+		case CompressionCodec::Snappy:
+			return true;
+		case CompressionCodec::LZ4:
+			return BS_COMPRESSION_LZ4 != 0;
+		case CompressionCodec::Zstd:
+			return BS_COMPRESSION_ZSTD != 0;
+		default:
+			return false;
+		}
+	}
+
+	CompressedBlockReader::CompressedBlockReader(const SPtr<DataStream>& stream)
+		: mStream(stream), mStart(stream->tell()), mBlockOffsets(1, 0)
+	{
+		const size_t available = mStream->size() - mStart;
+
+		CompressedBlocksHeader header;
+		if(available < sizeof(header) || mStream->read(&header, sizeof(header)) != sizeof(header))
+			return;
+
+		if(header.magic != BLOCK_MAGIC || header.version != BLOCK_FORMAT_VERSION || header.blockSize == 0)
+			return;
+
+		mCodec = (CompressionCodec)header.codec;
+		if(header.codec > (UINT8)CompressionCodec::Zstd || !Compression::isSupported(mCodec))
+			return;
+
+		const UINT64 expectedNumBlocks = (header.uncompressedSize + header.blockSize - 1) / header.blockSize;
+		if(header.numBlocks != expectedNumBlocks)
+			return;
+
+		const size_t tableSize = header.numBlocks * sizeof(UINT32);
+		if(available < sizeof(header) + tableSize)
+			return;
+
+		Vector<UINT32> compressedSizes(header.numBlocks);
+		if(header.numBlocks > 0 && mStream->read(compressedSizes.data(), tableSize) != tableSize)
+			return;
+
+		mUncompressedSize = header.uncompressedSize;
+		mBlockSize = header.blockSize;
+		mDataOffset = sizeof(header) + tableSize;
+
+		mBlockOffsets.resize(header.numBlocks + 1);
+		mIsBlockStored.resize(header.numBlocks);
+		for(UINT32 i = 0; i < header.numBlocks; i++)
+		{
+			const bool isStored = (compressedSizes[i] & BLOCK_STORED_FLAG) != 0;
+			const UINT32 size = compressedSizes[i] & ~BLOCK_STORED_FLAG;
+
+			// Stored blocks are copied as is, so their size must match the uncompressed size
+			if(isStored && size != getBlockUncompressedSize(i))
+				return;
+
+			mIsBlockStored[i] = isStored;
+			mBlockOffsets[i + 1] = mBlockOffsets[i] + size;
+		}
+
+		if(available < getCompressedSize())
+			return;
+
+		if(!mStream->isFile())
+			mMemory = std::static_pointer_cast<MemoryDataStream>(mStream)->getPtr() + mStart;
+
+		mIsValid = true;
+	}
+
+	UINT32 CompressedBlockReader::getBlockUncompressedSize(UINT32 idx) const
+	{
+		const UINT64 blockStart = (UINT64)idx * mBlockSize;
+		return (UINT32)std::min((UINT64)mBlockSize, mUncompressedSize - blockStart);
+	}
+
+	const UINT8* CompressedBlockReader::getBlockData(UINT32 idx, Vector<UINT8>& buffer) const
+	{
+		const UINT64 offset = mDataOffset + mBlockOffsets[idx];
+		if(mMemory != nullptr)
+			return mMemory + offset;
+
+		const size_t size = (size_t)(mBlockOffsets[idx + 1] - mBlockOffsets[idx]);
+		buffer.resize(size);
+
+		Lock lock(mStreamMutex);
+		mStream->seek(mStart + (size_t)offset);
+		if(mStream->read(buffer.data(), size) != size)
+			return nullptr;
+
+		return buffer.data();
+	}
+
+	bool CompressedBlockReader::readBlock(UINT32 idx, UINT8* output) const
+	{
+		if(!mIsValid || idx >= getNumBlocks())
+			return false;
+
+		Vector<UINT8> buffer;
+		const UINT8* data = getBlockData(idx, buffer);
+		if(data == nullptr)
+			return false;
+
+		const size_t compressedSize = (size_t)(mBlockOffsets[idx + 1] - mBlockOffsets[idx]);
+		const UINT32 uncompressedSize = getBlockUncompressedSize(idx);
+
+		if(mIsBlockStored[idx])
+		{
+			memcpy(output, data, uncompressedSize);
+			return true;
+		}
+
+		return decompressBlock(mCodec, data, compressedSize, output, uncompressedSize);
+	}
+
+	UINT64 CompressedBlockReader::read(UINT64 offset, UINT8* output, UINT64 size) const
+	{
+		if(!mIsValid || offset >= mUncompressedSize)
+			return 0;
+
+		size = std::min(size, mUncompressedSize - offset);
+
+		Vector<UINT8> blockBuffer;
+		UINT64 numRead = 0;
+		while(numRead < size)
+		{
+			const UINT64 position = offset + numRead;
+			const UINT32 idx = (UINT32)(position / mBlockSize);
+			const UINT32 offsetInBlock = (UINT32)(position % mBlockSize);
+			const UINT32 blockSize = getBlockUncompressedSize(idx);
+			const UINT64 numToCopy = std::min((UINT64)(blockSize - offsetInBlock), size - numRead);
+
+			// Whole blocks are decompressed straight into the output, partial ones go through a temporary buffer
+			if(numToCopy == blockSize)
+			{
+				if(!readBlock(idx, output + numRead))
+					break;
+			}
+			else
+			{
+				blockBuffer.resize(blockSize);
+				if(!readBlock(idx, blockBuffer.data()))
+					break;
+
+				memcpy(output + numRead, blockBuffer.data() + offsetInBlock, (size_t)numToCopy);
+			}
+
+			numRead += numToCopy;
+		}
+
+		return numRead;
+	}
+
+	bool CompressedBlockReader::readAll(UINT8* output) const
+	{
+		if(!mIsValid)
+			return false;
+
+		std::atomic<bool> success(true);
+		forEachBlock(getNumBlocks(), [this, output, &success](UINT32 idx)
+		{
+			if(!readBlock(idx, output + (size_t)idx * mBlockSize))
+				success.store(false, std::memory_order_relaxed);
+		});
+
+		return success.load();
+	}
 }
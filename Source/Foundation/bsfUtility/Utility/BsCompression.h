@@ -10,6 +10,36 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Algorithms that can be used for compressing blocks of data. */
+	enum class CompressionCodec : UINT8
+	{
+		/** Very fast compression and decompression, with a moderate compression ratio. Always available. */
+		Snappy,
+		/** Similar ratio to Snappy with faster decompression. Higher levels trade compression speed for ratio. */
+		LZ4,
+		/** Better compression ratio than LZ4 and Snappy, at a lower speed. Higher levels trade compression speed for ratio. */
+		Zstd
+	};
+
+	/** Options that control how Compression::compressBlocks() compresses the data. */
+	struct COMPRESSION_DESC
+	{
+		/** Algorithm to compress the blocks with. Falls back to Snappy if the codec isn't supported by this build. */
+		CompressionCodec codec = CompressionCodec::Snappy;
+
+		/**
+		 * Codec specific compression level. Zero uses the codec default. For LZ4 positive values use the high compression
+		 * mode (in range [1, 12]), while for Zstd the range is [1, 22]. Ignored by Snappy.
+		 */
+		INT32 level = 0;
+
+		/**
+		 * Number of uncompressed bytes in a single block. Blocks are compressed independently which allows them to be
+		 * processed in parallel and decompressed individually, at the cost of slightly worse compression ratio.
+		 */
+		UINT32 blockSize = 256 * 1024;
+	};
+
 	/** Performs generic compression and decompression on raw data. */
 	class BS_UTILITY_EXPORT Compression
 	{
@@ -19,7 +49,117 @@ namespace bs
 
 		/** Decompresses the data from the provided data stream and outputs the new stream with decompressed data. */
 		static SPtr<MemoryDataStream> decompress(SPtr<DataStream>& input);
+
+		/**
+		 * Compresses the data from the current position of the provided stream to its end, and outputs a stream
+		 * containing the compressed blocks. Blocks are compressed in parallel on the JobScheduler, if it is running.
+		 * Use decompressBlocks() or CompressedBlockReader to decompress the data.
+		 *
+		 * @param[in]	input	Stream to read the uncompressed data from.
+		 * @param[in]	desc	Options that control the codec, compression level and size of the blocks.
+		 * @return				Stream containing the compressed data, positioned at its start.
+		 */
+		static SPtr<MemoryDataStream> compressBlocks(const SPtr<DataStream>& input,
+			const COMPRESSION_DESC& desc = COMPRESSION_DESC());
+
+		/**
+		 * Decompresses data compressed with compressBlocks(), starting at the current position of the provided stream.
+		 * Blocks are decompressed in parallel on the JobScheduler, if it is running.
+		 *
+		 * @param[in]	input	Stream to read the compressed data from.
+		 * @return				Stream containing the decompressed data, or null if the data is corrupt or was compressed
+		 *						with a codec unsupported by this build.
+		 */
+		static SPtr<MemoryDataStream> decompressBlocks(const SPtr<DataStream>& input);
+
+		/** Checks if the codec is available in this build. */
+		static bool isSupported(CompressionCodec codec);
+	};
+
+	/**
+	 * Provides access to individual blocks of data compressed by Compression::compressBlocks(). Allows the caller to only
+	 * decompress the ranges of data it needs, without processing the rest of the data.
+	 *
+	 * If the source stream is a memory stream the compressed blocks are read directly from its memory, otherwise they are
+	 * read from the stream on demand. The source stream must not be accessed by anything else while in use by the reader.
+	 * Reading methods can be called from multiple threads at once.
+	 */
+	class BS_UTILITY_EXPORT CompressedBlockReader
+	{
+	public:
+		/** Reads the block information, starting at the current position of the stream. */
+		CompressedBlockReader(const SPtr<DataStream>& stream);
+
+		/** Returns false if the stream doesn't contain valid compressed data, or uses an unsupported codec. */
+		bool isValid() const { return mIsValid; }
+
+		/** Returns the codec the data was compressed with. */
+		CompressionCodec getCodec() const { return mCodec; }
+
+		/** Returns the total size of the decompressed data, in bytes. */
+		UINT64 getUncompressedSize() const { return mUncompressedSize; }
+
+		/** Returns the size of the compressed data, including the block information, in bytes. */
+		UINT64 getCompressedSize() const { return mDataOffset + mBlockOffsets.back(); }
+
+		/** Returns the number of uncompressed bytes in every block, except for the last one which can be smaller. */
+		UINT32 getBlockSize() const { return mBlockSize; }
+
+		/** Returns the number of blocks the data is split in. */
+		UINT32 getNumBlocks() const { return (UINT32)mBlockOffsets.size() - 1; }
+
+		/** Returns the number of uncompressed bytes in the block with the specified index. */
+		UINT32 getBlockUncompressedSize(UINT32 idx) const;
+
+		/**
+		 * Decompresses a single block.
+		 *
+		 * @param[in]	idx		Index of the block to decompress.
+		 * @param[out]	output	Buffer to output the data to. Must be at least getBlockUncompressedSize() bytes.
+		 * @return				True if the block was successfully decompressed.
+		 */
+		bool readBlock(UINT32 idx, UINT8* output) const;
+
+		/**
+		 * Decompresses a range of the uncompressed data. Only the blocks overlapping the range are decompressed.
+		 *
+		 * @param[in]	offset	Offset into the uncompressed data to start reading at, in bytes.
+		 * @param[out]	output	Buffer to output the data to. Must be at least @p size bytes.
+		 * @param[in]	size	Number of bytes to read.
+		 * @return				Number of bytes read. Less than @p size if the range extends past the end of the data,
+		 *						or if a block is corrupt.
+		 */
+		UINT64 read(UINT64 offset, UINT8* output, UINT64 size) const;
+
+		/**
+		 * Decompresses all the blocks, in parallel on the JobScheduler if it is running.
+		 *
+		 * @param[out]	output	Buffer to output the data to. Must be at least getUncompressedSize() bytes.
+		 * @return				True if all the blocks were successfully decompressed.
+		 */
+		bool readAll(UINT8* output) const;
+
+	private:
+		/**
+		 * Returns a pointer to the compressed data of the block. If the data isn't in memory it is read into the provided
+		 * buffer.
+		 */
+		const UINT8* getBlockData(UINT32 idx, Vector<UINT8>& buffer) const;
+
+		SPtr<DataStream> mStream;
+		const UINT8* mMemory = nullptr;
+		size_t mStart = 0;
+		UINT64 mDataOffset = 0;
+
+		CompressionCodec mCodec = CompressionCodec::Snappy;
+		UINT64 mUncompressedSize = 0;
+		UINT32 mBlockSize = 0;
+		Vector<UINT64> mBlockOffsets;
+		Vector<bool> mIsBlockStored;
+		bool mIsValid = false;
+
+		mutable Mutex mStreamMutex;
 	};
 
 	/** @} */
-}
\ No newline at end of file
+}
@@ -0,0 +1,403 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Utility/BsCullingOctree.h"
+#include "Threading/BsJobScheduler.h"
+
+namespace bs
+{
+	/** Number of elements tested by a single SIMD operation. */
+	static constexpr UINT32 CULL_BATCH_SIZE = 8;
+
+	/** Octree depth at which the tree is split into sub-trees culled as separate tasks. */
+	static constexpr UINT32 TASK_SPLIT_DEPTH = 2;
+
+	/** Minimum number of elements required before culling is split over multiple workers. */
+	static constexpr UINT32 MIN_PARALLEL_ELEMENTS = 16384;
+
+	/** Possible results of testing an octree node against a convex volume. */
+	enum class NodeCullResult
+	{
+		Outside,
+		Intersecting,
+		Inside
+	};
+
+	/** Determines if a box is outside, inside or intersecting the volume defined by the provided planes. */
+	static NodeCullResult cullNode(const simd::AABox& box, const Vector<Plane>& planes)
+	{
+		bool inside = true;
+		for(auto& plane : planes)
+		{
+			const float dist = box.center.x * plane.normal.x + box.center.y * plane.normal.y +
+				box.center.z * plane.normal.z - plane.d;
+
+			float radius = box.extents.x * Math::abs(plane.normal.x);
+			radius += box.extents.y * Math::abs(plane.normal.y);
+			radius += box.extents.z * Math::abs(plane.normal.z);
+
+			if(dist < -radius)
+				return NodeCullResult::Outside;
+
+			if(dist < radius)
+				inside = false;
+		}
+
+		return inside ? NodeCullResult::Inside : NodeCullResult::Intersecting;
+	}
+
+	/**
+	 * Tests a box against every volume in the @p active mask that the box's parent isn't already fully inside of. Bits of
+	 * volumes the box is outside of are cleared from @p active, and bits of volumes the box is fully inside of are set in
+	 * @p inside.
+	 */
+	static void cullNode(const simd::AABox& box, const CullingOctree::CullVolume* volumes, UINT32 numVolumes,
+		UINT32& active, UINT32& inside)
+	{
+		for(UINT32 i = 0; i < numVolumes; i++)
+		{
+			const UINT32 bit = 1u << i;
+			if((active & bit) == 0 || (inside & bit) != 0)
+				continue;
+
+			const NodeCullResult result = cullNode(box, volumes[i].volume->getPlanes());
+			if(result == NodeCullResult::Outside)
+				active &= ~bit;
+			else if(result == NodeCullResult::Inside)
+				inside |= bit;
+		}
+	}
+
+	/** Group of elements gathered from octree nodes, in a layout that can be tested using SIMD. */
+	struct CullBatch
+	{
+		/** 
+		 * Adds an element to the batch. Caller must ensure the batch isn't full. @p active and @p inside are the masks of
+		 * the node containing the element, as determined by cullNode().
+		 */
+		void push(UINT32 index, UINT64 layer, const simd::AABox& bounds, UINT32 active, UINT32 inside)
+		{
+			centerX[count] = bounds.center.x;
+			centerY[count] = bounds.center.y;
+			centerZ[count] = bounds.center.z;
+			extentX[count] = bounds.extents.x;
+			extentY[count] = bounds.extents.y;
+			extentZ[count] = bounds.extents.z;
+			layerLow[count] = (UINT32)layer;
+			layerHigh[count] = (UINT32)(layer >> 32);
+			activeMasks[count] = active;
+			insideMasks[count] = inside;
+			indices[count] = index;
+
+			combinedActive |= active;
+			count++;
+		}
+
+		/**
+		 * Tests all elements in the batch against all active volumes and appends the visible ones to the output, then
+		 * clears the batch. Elements are only tested against the volumes their node wasn't culled against, and
+		 * elements known to be inside a volume only have their layers tested.
+		 */
+		void flush(const CullingOctree::CullVolume* volumes, UINT32 numVolumes, 
+			Vector<CullingOctree::VisibleElement>& output)
+		{
+			using namespace simd;
+
+			if(count == 0)
+				return;
+
+			// Unused entries are rejected as they're not active for any volume
+			for(UINT32 i = count; i < CULL_BATCH_SIZE; i++)
+			{
+				activeMasks[i] = 0;
+				insideMasks[i] = 0;
+			}
+
+			const uint32x8 zero = make_zero();
+			const uint32x8 elemLayerLow = load<uint32x8>(layerLow);
+			const uint32x8 elemLayerHigh = load<uint32x8>(layerHigh);
+			const uint32x8 elemActive = load<uint32x8>(activeMasks);
+			const uint32x8 elemInside = load<uint32x8>(insideMasks);
+
+			const float32x8 boxCenterX = load<float32x8>(centerX);
+			const float32x8 boxCenterY = load<float32x8>(centerY);
+			const float32x8 boxCenterZ = load<float32x8>(centerZ);
+			const float32x8 boxExtentX = load<float32x8>(extentX);
+			const float32x8 boxExtentY = load<float32x8>(extentY);
+			const float32x8 boxExtentZ = load<float32x8>(extentZ);
+
+			// One bit per volume, for each element
+			uint32x8 visible = zero;
+			for(UINT32 i = 0; i < numVolumes; i++)
+			{
+				const UINT32 bit = 1u << i;
+				if((combinedActive & bit) == 0)
+					continue;
+
+				const UINT64 layers = volumes[i].layers;
+				const uint32x8 volumeBit = splat<uint32x8>(bit);
+
+				uint32x8 layerMask = bit_and(elemLayerLow, splat<uint32x8>((UINT32)layers));
+				layerMask = bit_or(layerMask, bit_and(elemLayerHigh, splat<uint32x8>((UINT32)(layers >> 32))));
+
+				uint32x8 culled = bit_cast<uint32x8>(cmp_eq(layerMask, zero));
+				culled = bit_or(culled, bit_cast<uint32x8>(cmp_eq(bit_and(elemActive, volumeBit), zero)));
+
+				// Bounds only need to be tested if some elements aren't already known to be inside the volume
+				const uint32x8 outsideNode = bit_cast<uint32x8>(cmp_eq(bit_and(elemInside, volumeBit), zero));
+				if(test_bits_any(bit_andnot(outsideNode, culled)))
+				{
+					uint32x8 culledBounds = zero;
+					for(auto& plane : volumes[i].volume->getPlanes())
+					{
+						const float32x8 normalX = splat<float32x8>(plane.normal.x);
+						const float32x8 normalY = splat<float32x8>(plane.normal.y);
+						const float32x8 normalZ = splat<float32x8>(plane.normal.z);
+
+						float32x8 dist = add(add(mul(boxCenterX, normalX), mul(boxCenterY, normalY)), 
+							mul(boxCenterZ, normalZ));
+						dist = sub(dist, splat<float32x8>(plane.d));
+
+						float32x8 radius = mul(boxExtentX, abs(normalX));
+						radius = add(radius, mul(boxExtentY, abs(normalY)));
+						radius = add(radius, mul(boxExtentZ, abs(normalZ)));
+
+						culledBounds = bit_or(culledBounds, bit_cast<uint32x8>(cmp_lt(dist, neg(radius))));
+					}
+
+					culled = bit_or(culled, bit_and(culledBounds, outsideNode));
+				}
+
+				visible = bit_or(visible, bit_andnot(volumeBit, culled));
+			}
+
+			SIMDPP_ALIGN(32) UINT32 result[CULL_BATCH_SIZE];
+			store(result, visible);
+
+			for(UINT32 i = 0; i < count; i++)
+			{
+				if(result[i] != 0)
+					output.push_back({ indices[i], result[i] });
+			}
+
+			count = 0;
+			combinedActive = 0;
+		}
+
+		SIMDPP_ALIGN(32) float centerX[CULL_BATCH_SIZE] = { };
+		SIMDPP_ALIGN(32) float centerY[CULL_BATCH_SIZE] = { };
+		SIMDPP_ALIGN(32) float centerZ[CULL_BATCH_SIZE] = { };
+		SIMDPP_ALIGN(32) float extentX[CULL_BATCH_SIZE] = { };
+		SIMDPP_ALIGN(32) float extentY[CULL_BATCH_SIZE] = { };
+		SIMDPP_ALIGN(32) float extentZ[CULL_BATCH_SIZE] = { };
+		SIMDPP_ALIGN(32) UINT32 layerLow[CULL_BATCH_SIZE] = { };
+		SIMDPP_ALIGN(32) UINT32 layerHigh[CULL_BATCH_SIZE] = { };
+		SIMDPP_ALIGN(32) UINT32 activeMasks[CULL_BATCH_SIZE] = { };
+		SIMDPP_ALIGN(32) UINT32 insideMasks[CULL_BATCH_SIZE] = { };
+		UINT32 indices[CULL_BATCH_SIZE];
+		UINT32 count = 0;
+		UINT32 combinedActive = 0;
+	};
+
+	simd::AABox CullingOctree::OctreeOptions::getBounds(const Element& elem, void* context)
+	{
+		CullingOctree* octree = (CullingOctree*)context;
+		return simd::AABox(octree->mBounds[elem.index]);
+	}
+
+	void CullingOctree::OctreeOptions::setElementId(const Element& elem, const OctreeElementId& id, void* context)
+	{
+		CullingOctree* octree = (CullingOctree*)context;
+		octree->mOctreeIds[elem.index] = id;
+	}
+
+	CullingOctree::CullingOctree(const Vector3& center, float extent)
+		:mOctree(center, extent, this)
+	{ }
+
+	void CullingOctree::add(const Bounds& bounds, UINT64 layer)
+	{
+		const UINT32 idx = (UINT32)mBounds.size();
+
+		mBounds.push_back(bounds.getBox());
+		mLayers.push_back(layer);
+		mOctreeIds.push_back(OctreeElementId());
+
+		mOctree.addElement({ idx, layer });
+	}
+
+	void CullingOctree::update(UINT32 idx, const Bounds& bounds, UINT64 layer)
+	{
+		mOctree.removeElement(mOctreeIds[idx]);
+
+		mBounds[idx] = bounds.getBox();
+		mLayers[idx] = layer;
+
+		mOctree.addElement({ idx, layer });
+	}
+
+	void CullingOctree::remove(UINT32 idx)
+	{
+		const UINT32 lastIdx = (UINT32)mBounds.size() - 1;
+
+		mOctree.removeElement(mOctreeIds[idx]);
+		if(idx != lastIdx)
+		{
+			// Re-insert the last element under its new index
+			mOctree.removeElement(mOctreeIds[lastIdx]);
+
+			mBounds[idx] = mBounds[lastIdx];
+			mLayers[idx] = mLayers[lastIdx];
+
+			mOctree.addElement({ idx, mLayers[idx] });
+		}
+
+		mBounds.erase(mBounds.end() - 1);
+		mLayers.erase(mLayers.end() - 1);
+		mOctreeIds.erase(mOctreeIds.end() - 1);
+	}
+
+	void CullingOctree::cull(const ConvexVolume& volume, UINT64 layers, Vector<bool>& visibility) const
+	{
+		const CullVolume cullVolume = { &volume, layers };
+		cull(&cullVolume, 1, mVisibleElements);
+
+		for(auto& entry : mVisibleElements)
+			visibility[entry.index] = true;
+	}
+
+	void CullingOctree::cull(const CullVolume* volumes, UINT32 numVolumes, Vector<VisibleElement>& output) const
+	{
+		assert(numVolumes <= MAX_CULL_VOLUMES);
+
+		output.clear();
+		if(numVolumes == 0)
+			return;
+
+		const UINT32 allVolumes = numVolumes == 32 ? 0xFFFFFFFF : (1u << numVolumes) - 1;
+
+		// Cull the top levels of the tree, and split the rest of it into sub-trees that can be culled independently
+		mTasks.clear();
+
+		ElementOctree::NodeIterator nodeIter(mOctree);
+		nodeIter.moveNext();
+
+		const ElementOctree::HNode& root = nodeIter.getCurrent();
+
+		// Elements that don't fit within the root bounds are stored in the root, so it can never be skipped
+		mTasks.push_back({ root.getNode(), root.getBounds(), allVolumes, 0, false });
+
+		addCullTasks(root.getNode(), root.getBounds(), volumes, numVolumes, allVolumes, 0, 1);
+
+		const UINT32 numTasks = (UINT32)mTasks.size();
+		if(mTaskOutputs.size() < numTasks)
+			mTaskOutputs.resize(numTasks);
+
+		for(UINT32 i = 0; i < numTasks; i++)
+			mTaskOutputs[i].clear();
+
+		const bool parallel = size() >= MIN_PARALLEL_ELEMENTS && JobScheduler::isStarted() &&
+			JobScheduler::instance().getNumActiveWorkers() > 1;
+
+		if(parallel)
+		{
+			JobScheduler::instance().parallelForAndWait(numTasks, 1, 
+				[this, volumes, numVolumes](UINT32 start, UINT32 count)
+			{
+				for(UINT32 i = start; i < start + count; i++)
+					cullTask(mTasks[i], volumes, numVolumes, mTaskOutputs[i]);
+			});
+		}
+		else
+		{
+			for(UINT32 i = 0; i < numTasks; i++)
+				cullTask(mTasks[i], volumes, numVolumes, mTaskOutputs[i]);
+		}
+
+		for(UINT32 i = 0; i < numTasks; i++)
+			output.insert(output.end(), mTaskOutputs[i].begin(), mTaskOutputs[i].end());
+	}
+
+	void CullingOctree::addCullTasks(const ElementOctree::Node* node, const ElementOctree::NodeBounds& bounds,
+		const CullVolume* volumes, UINT32 numVolumes, UINT32 active, UINT32 inside, UINT32 depth) const
+	{
+		for(UINT32 i = 0; i < 8; i++)
+		{
+			if(!node->hasChild(i))
+				continue;
+
+			const ElementOctree::Node* child = node->getChild(i);
+			const ElementOctree::NodeBounds childBounds = bounds.getChild(i);
+
+			UINT32 childActive = active;
+			UINT32 childInside = inside;
+			cullNode(childBounds.getBounds(), volumes, numVolumes, childActive, childInside);
+
+			if(childActive == 0)
+				continue;
+
+			if(childInside == childActive || depth == TASK_SPLIT_DEPTH)
+			{
+				mTasks.push_back({ child, childBounds, childActive, childInside, true });
+				continue;
+			}
+
+			mTasks.push_back({ child, childBounds, childActive, childInside, false });
+			addCullTasks(child, childBounds, volumes, numVolumes, childActive, childInside, depth + 1);
+		}
+	}
+
+	void CullingOctree::cullTask(const CullTask& task, const CullVolume* volumes, UINT32 numVolumes,
+		Vector<VisibleElement>& output) const
+	{
+		struct StackEntry
+		{
+			const ElementOctree::Node* node;
+			ElementOctree::NodeBounds bounds;
+			UINT32 active;
+			UINT32 inside;
+		};
+
+		StackEntry stack[OctreeOptions::MaxDepth * 8];
+		UINT32 stackSize = 0;
+
+		stack[stackSize++] = { task.node, task.bounds, task.active, task.inside };
+
+		CullBatch batch;
+		while(stackSize > 0)
+		{
+			const StackEntry entry = stack[--stackSize];
+
+			ElementOctree::ElementIterator elemIter(entry.node);
+			while(elemIter.moveNext())
+			{
+				const Element& elem = elemIter.getCurrentElem();
+				batch.push(elem.index, elem.layer, elemIter.getCurrentBounds(), entry.active, entry.inside);
+
+				if(batch.count == CULL_BATCH_SIZE)
+					batch.flush(volumes, numVolumes, output);
+			}
+
+			if(!task.recurse)
+				break;
+
+			for(UINT32 i = 0; i < 8; i++)
+			{
+				if(!entry.node->hasChild(i))
+					continue;
+
+				const ElementOctree::NodeBounds childBounds = entry.bounds.getChild(i);
+
+				UINT32 active = entry.active;
+				UINT32 inside = entry.inside;
+				cullNode(childBounds.getBounds(), volumes, numVolumes, active, inside);
+
+				if(active == 0)
+					continue;
+
+				stack[stackSize++] = { entry.node->getChild(i), childBounds, active, inside };
+			}
+		}
+
+		batch.flush(volumes, numVolumes, output);
+	}
+}
@@ -0,0 +1,151 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Utility/BsOctree.h"
+#include "Math/BsBounds.h"
+#include "Math/BsConvexVolume.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Container for a set of object bounds and their layer masks, optimized for culling them against a convex volume
+	 * (e.g. a camera frustum).
+	 *
+	 * Bounds are stored in an octree. Nodes fully outside the volume are skipped along with their entire sub-tree, and
+	 * nodes fully inside the volume have their elements accepted without testing the bounds. Elements of the remaining
+	 * nodes are tested eight at a time using SIMD. Layer masks are tested the same way. Separate sub-trees are culled in
+	 * parallel on the JobScheduler, if it is running.
+	 *
+	 * Multiple volumes can be culled in a single pass over the tree (e.g. all views of a frame, or all faces of a shadow
+	 * cubemap), in which case each element is tested against all of the volumes at once and the result is reported as a
+	 * bitmask with one bit per volume.
+	 *
+	 * Elements are referenced using sequential indices, same as they would be in a plain array. Removing an element
+	 * moves the last element into its place.
+	 */
+	class BS_UTILITY_EXPORT CullingOctree
+	{
+		/** Contents of a single octree element. */
+		struct Element
+		{
+			UINT32 index;
+			UINT64 layer;
+		};
+
+		/** Options controlling the octree, as required by Octree. */
+		struct OctreeOptions
+		{
+			enum { LoosePadding = 16 };
+			enum { MinElementsPerNode = 8 };
+			enum { MaxElementsPerNode = 32 };
+			enum { MaxDepth = 12 };
+
+			static simd::AABox getBounds(const Element& elem, void* context);
+			static void setElementId(const Element& elem, const OctreeElementId& id, void* context);
+		};
+
+		typedef Octree<Element, OctreeOptions> ElementOctree;
+	public:
+		/** Maximum number of volumes that can be culled in a single pass. */
+		static constexpr UINT32 MAX_CULL_VOLUMES = 32;
+
+		/** Volume to cull the elements against, along with the layers visible from it. */
+		struct CullVolume
+		{
+			const ConvexVolume* volume;
+			UINT64 layers;
+		};
+
+		/** Element visible from at least one of the volumes of a cull pass. */
+		struct VisibleElement
+		{
+			UINT32 index; /**< Index of the element. */
+			UINT32 mask; /**< Bit for each volume, in the order they were provided, set if the element is visible from it. */
+		};
+
+		/**
+		 * Constructs an empty culling octree.
+		 *
+		 * @param[in]	center	Center of the area the elements are expected to be placed in.
+		 * @param[in]	extent	Extent (half-size) of the area the elements are expected to be placed in. Elements outside
+		 *						of the area are supported, but will always be tested individually.
+		 */
+		CullingOctree(const Vector3& center = Vector3::ZERO, float extent = 16384.0f);
+
+		/** Adds a new element with the specified bounds and layer mask. Its index will be equal to size() - 1. */
+		void add(const Bounds& bounds, UINT64 layer);
+
+		/** Updates the bounds and the layer mask of an existing element. */
+		void update(UINT32 idx, const Bounds& bounds, UINT64 layer);
+
+		/** Removes the element at the specified index. The last element is moved into its place. */
+		void remove(UINT32 idx);
+
+		/** Returns the number of elements in the container. */
+		UINT32 size() const { return (UINT32)mBounds.size(); }
+
+		/**
+		 * Determines which elements intersect the provided volume, and have at least one layer bit in common with the
+		 * provided layer mask.
+		 *
+		 * @param[in]	volume		Volume to cull the elements against.
+		 * @param[in]	layers		Layer mask to test the element layer masks against.
+		 * @param[out]	visibility	Set to true for every visible element. Entries for elements that are not visible
+		 *							are left unchanged. Must be at least size() entries in length.
+		 *
+		 * @note	Not thread safe. Only one cull operation may be in progress at once.
+		 */
+		void cull(const ConvexVolume& volume, UINT64 layers, Vector<bool>& visibility) const;
+
+		/**
+		 * Culls the elements against multiple volumes in a single pass.
+		 *
+		 * @param[in]	volumes		Volumes to cull the elements against.
+		 * @param[in]	numVolumes	Number of entries in the @p volumes array. Must not be larger than MAX_CULL_VOLUMES.
+		 * @param[out]	output		Cleared and then populated with all elements visible from at least one of the volumes,
+		 *							in no particular order. Each element is reported at most once.
+		 *
+		 * @note	Not thread safe. Only one cull operation may be in progress at once.
+		 */
+		void cull(const CullVolume* volumes, UINT32 numVolumes, Vector<VisibleElement>& output) const;
+
+	private:
+		/** Sub-tree of the octree that is culled as a single unit of work. */
+		struct CullTask
+		{
+			const ElementOctree::Node* node;
+			ElementOctree::NodeBounds bounds;
+			UINT32 active; /**< Bit for each volume the node is not fully outside of. */
+			UINT32 inside; /**< Bit for each volume the node is known to be fully inside of. */
+			bool recurse; /**< If false only the node's own elements are culled, and not the elements of its children. */
+		};
+
+		/**
+		 * Culls the children of the provided node, and adds a cull task for each child that isn't fully outside of all
+		 * the volumes. Recurses into intersecting children until the task split depth is reached.
+		 */
+		void addCullTasks(const ElementOctree::Node* node, const ElementOctree::NodeBounds& bounds,
+			const CullVolume* volumes, UINT32 numVolumes, UINT32 active, UINT32 inside, UINT32 depth) const;
+
+		/** Performs culling of the provided sub-tree. Visible elements are appended to @p output. */
+		void cullTask(const CullTask& task, const CullVolume* volumes, UINT32 numVolumes,
+			Vector<VisibleElement>& output) const;
+
+		ElementOctree mOctree;
+		Vector<AABox> mBounds;
+		Vector<UINT64> mLayers;
+		Vector<OctreeElementId> mOctreeIds;
+
+		mutable Vector<CullTask> mTasks;
+		mutable Vector<Vector<VisibleElement>> mTaskOutputs;
+		mutable Vector<VisibleElement> mVisibleElements;
+	};
+
+	/** @} */
+}
@@ -65,11 +65,12 @@ namespace bs
 		template<class ...Args>
 		static void startUp(Args &&...args)
 		{
-			if (isStartedUp())
+			if (isStarted())
 				BS_EXCEPT(InternalErrorException, "Trying to start an already started module.");
 
 			_instance() = bs_new<T>(std::forward<Args>(args)...);
 			isStartedUp() = true;
+			isDestroyed() = false;
 
 			((Module*)_instance())->onStartUp();
 		}
@@ -83,11 +84,12 @@ namespace bs
 		{
 			static_assert(std::is_base_of<T, SubType>::value, "Provided type is not derived from type the Module is initialized with.");
 
-			if (isStartedUp())
+			if (isStarted())
 				BS_EXCEPT(InternalErrorException, "Trying to start an already started module.");
 
 			_instance() = bs_new<SubType>(std::forward<Args>(args)...);
 			isStartedUp() = true;
+			isDestroyed() = false;
 
 			((Module*)_instance())->onStartUp();
 		}
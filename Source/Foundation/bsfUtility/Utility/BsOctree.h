@@ -244,13 +244,9 @@ namespace bs
 				auto nodeCenter = simd::load<simd::float32x4>(&mBounds.center);
 				auto childOffset = simd::load_splat<simd::float32x4>(&mChildOffset);
 
-				auto negativeCenter = simd::sub(nodeCenter, childOffset);
-				auto negativeDiff = simd::sub(queryCenter, negativeCenter);
-
-				auto positiveCenter = simd::add(nodeCenter, childOffset);
-				auto positiveDiff = simd::sub(positiveCenter, queryCenter);
-
-				auto diff = simd::min(negativeDiff, positiveDiff);
+				// Distance from the center of the child on the same side of the node as the query center
+				simd::float32x4 nodeDiff = simd::abs(simd::sub(queryCenter, nodeCenter));
+				simd::float32x4 diff = simd::abs(simd::sub(nodeDiff, childOffset));
 
 				auto queryExtents = simd::load<simd::float32x4>(&bounds.extents);
 				auto childExtent = simd::load_splat<simd::float32x4>(&mChildExtent);
@@ -604,11 +600,11 @@ namespace bs
 
 			if(nodeToCollapse)
 			{
-				// Add all the child node elements to the current node
+				// Add all the child node elements to the node being collapsed
 				bs_frame_mark();
 				{
 					FrameStack<Node*> todo;
-					todo.push(node);
+					todo.push(nodeToCollapse);
 
 					while(!todo.empty())
 					{
@@ -623,7 +619,7 @@ namespace bs
 
 								ElementIterator elemIter(childNode);
 								while(elemIter.moveNext())
-									pushElement(node, elemIter.getCurrentElem(), elemIter.getCurrentBounds());
+									pushElement(nodeToCollapse, elemIter.getCurrentElem(), elemIter.getCurrentBounds());
 
 								todo.push(childNode);
 							}
@@ -632,17 +628,17 @@ namespace bs
 				}
 				bs_frame_clear();
 				
-				node->mIsLeaf = true;
+				nodeToCollapse->mIsLeaf = true;
 
 				// Recursively delete all child nodes
 				for (UINT32 i = 0; i < 8; i++)
 				{
-					if(node->mChildren[i])
+					if(nodeToCollapse->mChildren[i])
 					{
-						destroyNode(node->mChildren[i]);
+						destroyNode(nodeToCollapse->mChildren[i]);
 
-						mNodeAlloc.destruct(node->mChildren[i]);
-						node->mChildren[i] = nullptr;
+						mNodeAlloc.destruct(nodeToCollapse->mChildren[i]);
+						nodeToCollapse->mChildren[i] = nullptr;
 					}
 				}
 			}
@@ -758,7 +754,7 @@ namespace bs
 
 			ElementGroup* elemGroup;
 			ElementBoundGroup* boundGroup;
-			elementIdx = node->mapToGroup(elementIdx, &elemGroup, &boundGroup);
+			UINT32 groupElementIdx = node->mapToGroup(elementIdx, &elemGroup, &boundGroup);
 
 			ElementGroup* lastElemGroup;
 			ElementBoundGroup* lastBoundGroup;
@@ -766,10 +762,11 @@ namespace bs
 
 			if(elements.count > 1)
 			{
-				std::swap(elemGroup->v[elementIdx], lastElemGroup->v[lastElementIdx]);
-				std::swap(boundGroup->v[elementIdx], lastBoundGroup->v[lastElementIdx]);
+				std::swap(elemGroup->v[groupElementIdx], lastElemGroup->v[lastElementIdx]);
+				std::swap(boundGroup->v[groupElementIdx], lastBoundGroup->v[lastElementIdx]);
 
-				Options::setElementId(elemGroup->v[elementIdx], OctreeElementId(node, elementIdx), mContext);
+				// Element ID uses the index within the node, not within the group
+				Options::setElementId(elemGroup->v[groupElementIdx], OctreeElementId(node, elementIdx), mContext);
 			}
 
 			if(lastElementIdx == 0) // Last element in that group, remove it completely
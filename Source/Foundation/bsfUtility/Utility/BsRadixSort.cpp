@@ -0,0 +1,151 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Utility/BsRadixSort.h"
+#include "Threading/BsJobScheduler.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/** Number of key bits processed by a single sort pass. */
+	static constexpr UINT32 RADIX_BITS = 8;
+
+	/** Number of distinct values of a single digit. */
+	static constexpr UINT32 RADIX_SIZE = 1 << RADIX_BITS;
+
+	/** Number of passes required to sort a 64-bit key. */
+	static constexpr UINT32 NUM_PASSES = 64 / RADIX_BITS;
+
+	/** Minimum number of elements processed by a single job when sorting in parallel. */
+	static constexpr UINT32 MIN_ELEMENTS_PER_CHUNK = 16384;
+
+	/** Returns the digit of the key that is sorted by the specified pass. */
+	static UINT32 getDigit(UINT64 key, UINT32 pass)
+	{
+		return (UINT32)(key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1);
+	}
+
+	/** Calls @p func with the index of each chunk, in parallel if there is more than one chunk. */
+	template<class F>
+	static void forEachChunk(UINT32 numChunks, const F& func)
+	{
+		if(numChunks == 1)
+		{
+			func(0);
+			return;
+		}
+
+		JobScheduler::instance().parallelForAndWait(numChunks, 1, [&func](UINT32 start, UINT32 count)
+		{
+			for(UINT32 i = start; i < start + count; i++)
+				func(i);
+		});
+	}
+
+	void RadixSort::sort(UINT64* keys, UINT32* values, UINT32 count)
+	{
+		if(count < 2)
+			return;
+
+		if(mTempKeys.size() < count)
+		{
+			mTempKeys.resize(count);
+			mTempValues.resize(count);
+		}
+
+		UINT32 numChunks = 1;
+		if(JobScheduler::isStarted())
+		{
+			const UINT32 maxChunks = JobScheduler::instance().getNumActiveWorkers() + 1;
+			numChunks = Math::clamp(count / MIN_ELEMENTS_PER_CHUNK, 1U, maxChunks);
+		}
+
+		const UINT32 chunkSize = Math::divideAndRoundUp(count, numChunks);
+		numChunks = Math::divideAndRoundUp(count, chunkSize);
+
+		// Histograms of every digit, for every chunk. These are only valid for the initial order of the elements, which is
+		// enough to find which passes can be skipped, and to perform the first pass (or all of them with a single chunk).
+		mHistograms.assign(numChunks * NUM_PASSES * RADIX_SIZE, 0);
+		mOffsets.resize(numChunks * RADIX_SIZE);
+
+		forEachChunk(numChunks, [this, keys, count, chunkSize](UINT32 chunk)
+		{
+			UINT32* histograms = &mHistograms[chunk * NUM_PASSES * RADIX_SIZE];
+
+			const UINT32 end = std::min((chunk + 1) * chunkSize, count);
+			for(UINT32 i = chunk * chunkSize; i < end; i++)
+			{
+				for(UINT32 pass = 0; pass < NUM_PASSES; pass++)
+					histograms[pass * RADIX_SIZE + getDigit(keys[i], pass)]++;
+			}
+		});
+
+		UINT64* srcKeys = keys;
+		UINT32* srcValues = values;
+		UINT64* dstKeys = mTempKeys.data();
+		UINT32* dstValues = mTempValues.data();
+
+		bool histogramsValid = true;
+		for(UINT32 pass = 0; pass < NUM_PASSES; pass++)
+		{
+			// If all keys share the same digit the pass wouldn't change the order
+			const UINT32 firstDigit = getDigit(keys[0], pass);
+
+			UINT32 numWithFirstDigit = 0;
+			for(UINT32 chunk = 0; chunk < numChunks; chunk++)
+				numWithFirstDigit += mHistograms[(chunk * NUM_PASSES + pass) * RADIX_SIZE + firstDigit];
+
+			if(numWithFirstDigit == count)
+				continue;
+
+			if(!histogramsValid)
+			{
+				forEachChunk(numChunks, [this, srcKeys, count, chunkSize, pass](UINT32 chunk)
+				{
+					UINT32* histogram = &mHistograms[(chunk * NUM_PASSES + pass) * RADIX_SIZE];
+					memset(histogram, 0, RADIX_SIZE * sizeof(UINT32));
+
+					const UINT32 end = std::min((chunk + 1) * chunkSize, count);
+					for(UINT32 i = chunk * chunkSize; i < end; i++)
+						histogram[getDigit(srcKeys[i], pass)]++;
+				});
+			}
+
+			// Elements of earlier chunks are placed before elements of later chunks with the same digit, keeping the sort
+			// stable
+			UINT32 offset = 0;
+			for(UINT32 digit = 0; digit < RADIX_SIZE; digit++)
+			{
+				for(UINT32 chunk = 0; chunk < numChunks; chunk++)
+				{
+					mOffsets[chunk * RADIX_SIZE + digit] = offset;
+					offset += mHistograms[(chunk * NUM_PASSES + pass) * RADIX_SIZE + digit];
+				}
+			}
+
+			forEachChunk(numChunks, [=](UINT32 chunk)
+			{
+				UINT32* offsets = &mOffsets[chunk * RADIX_SIZE];
+
+				const UINT32 end = std::min((chunk + 1) * chunkSize, count);
+				for(UINT32 i = chunk * chunkSize; i < end; i++)
+				{
+					const UINT32 dstIdx = offsets[getDigit(srcKeys[i], pass)]++;
+					dstKeys[dstIdx] = srcKeys[i];
+					dstValues[dstIdx] = srcValues[i];
+				}
+			});
+
+			std::swap(srcKeys, dstKeys);
+			std::swap(srcValues, dstValues);
+
+			// With a single chunk the histograms cover all the elements and don't depend on their order
+			histogramsValid = numChunks == 1;
+		}
+
+		if(srcKeys != keys)
+		{
+			memcpy(keys, srcKeys, count * sizeof(UINT64));
+			memcpy(values, srcValues, count * sizeof(UINT32));
+		}
+	}
+}
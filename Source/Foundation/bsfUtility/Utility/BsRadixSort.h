@@ -0,0 +1,43 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Sorts 64-bit keys along with a 32-bit value per key, using a least significant digit radix sort. The sort is stable,
+	 * meaning elements with equal keys keep their relative order.
+	 *
+	 * Keys are processed eight bits at a time. Digits that are equal for all keys are skipped, so keys that only use part
+	 * of the 64-bit range are cheaper to sort. Large arrays are split into chunks that are histogrammed and scattered in
+	 * parallel on the JobScheduler, if it is running.
+	 *
+	 * Temporary storage is kept between calls, so the same instance should be re-used for sorts performed every frame.
+	 */
+	class BS_UTILITY_EXPORT RadixSort
+	{
+	public:
+		/**
+		 * Sorts the keys in ascending order, and reorders the values so they stay paired with their keys.
+		 *
+		 * @param[in, out]	keys	Keys to sort.
+		 * @param[in, out]	values	Values to reorder along with the keys. Must have the same number of entries as @p keys.
+		 * @param[in]		count	Number of entries in the @p keys and @p values arrays.
+		 */
+		void sort(UINT64* keys, UINT32* values, UINT32 count);
+
+	private:
+		Vector<UINT64> mTempKeys;
+		Vector<UINT32> mTempValues;
+		Vector<UINT32> mHistograms;
+		Vector<UINT32> mOffsets;
+	};
+
+	/** @} */
+}
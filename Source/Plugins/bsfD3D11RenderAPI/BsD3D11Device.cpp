@@ -1,20 +1,24 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsD3D11Device.h"
+#include "BsD3D11ParamBlockRing.h"
 #include "Error/BsException.h"
 
 namespace bs { namespace ct
 {
 	D3D11Device::D3D11Device() 
-		:mD3D11Device(nullptr), mImmediateContext(nullptr), mClassLinkage(nullptr)
+		:mD3D11Device(nullptr), mImmediateContext(nullptr), mImmediateContext1(nullptr), mClassLinkage(nullptr)
+		, mParamBlockRing(nullptr)
 	{
 	}
 
 	D3D11Device::D3D11Device(ID3D11Device* device)
 		: mD3D11Device(device)
 		, mImmediateContext(nullptr)
+		, mImmediateContext1(nullptr)
 		, mInfoQueue(nullptr)
 		, mClassLinkage(nullptr)
+		, mParamBlockRing(nullptr)
 	{
 		assert(device != nullptr);
 
@@ -41,6 +45,16 @@ namespace bs { namespace ct
 				if (FAILED(hr))
 					BS_EXCEPT(RenderingAPIException, "Unable to create class linkage.");
 			}
+
+			// Sub-allocating parameter blocks from a ring buffer requires constant buffer offsetting from DX11.1
+			if (SUCCEEDED(mImmediateContext->QueryInterface(__uuidof(ID3D11DeviceContext1), (LPVOID*)&mImmediateContext1)))
+			{
+				D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+				HRESULT hr = mD3D11Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+
+				if (SUCCEEDED(hr) && options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer)
+					mParamBlockRing = bs_new<D3D11ParamBlockRing>(*this);
+			}
 		}	
 	}
 
@@ -57,8 +71,15 @@ namespace bs { namespace ct
 			mImmediateContext->ClearState();
 		}
 
+		if (mParamBlockRing != nullptr)
+		{
+			bs_delete(mParamBlockRing);
+			mParamBlockRing = nullptr;
+		}
+
 		SAFE_RELEASE(mInfoQueue);
 		SAFE_RELEASE(mD3D11Device);
+		SAFE_RELEASE(mImmediateContext1);
 		SAFE_RELEASE(mImmediateContext);
 		SAFE_RELEASE(mClassLinkage);
 	}
@@ -34,6 +34,15 @@ namespace bs { namespace ct
 		/**	Returns DX11 immediate context object. */
 		ID3D11DeviceContext* getImmediateContext() const { return mImmediateContext; }
 
+		/** Returns DX11.1 interface of the immediate context object, or null if the runtime doesn't support DX11.1. */
+		ID3D11DeviceContext1* getImmediateContext1() const { return mImmediateContext1; }
+
+		/** 
+		 * Returns a ring buffer that GPBU_STREAM parameter blocks are sub-allocated from. Null if the device doesn't
+		 * support constant buffer offsetting.
+		 */
+		D3D11ParamBlockRing* getParamBlockRing() const { return mParamBlockRing; }
+
 		/**	Returns DX11 class linkage object. */
 		ID3D11ClassLinkage* getClassLinkage() const { return mClassLinkage; }
 
@@ -63,8 +72,10 @@ namespace bs { namespace ct
 
 		ID3D11Device* mD3D11Device;
 		ID3D11DeviceContext* mImmediateContext;
+		ID3D11DeviceContext1* mImmediateContext1;
 		ID3D11InfoQueue* mInfoQueue; 
 		ID3D11ClassLinkage* mClassLinkage;
+		D3D11ParamBlockRing* mParamBlockRing;
 	};
 
 	/** @} */
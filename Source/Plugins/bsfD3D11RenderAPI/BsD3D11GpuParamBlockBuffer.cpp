@@ -4,13 +4,14 @@
 #include "BsD3D11HardwareBuffer.h"
 #include "BsD3D11RenderAPI.h"
 #include "BsD3D11Device.h"
+#include "BsD3D11ParamBlockRing.h"
 #include "Profiling/BsRenderStats.h"
 
 namespace bs { namespace ct
 {
 	D3D11GpuParamBlockBuffer::D3D11GpuParamBlockBuffer(UINT32 size, GpuParamBlockUsage usage, 
 		GpuDeviceFlags deviceMask)
-		:GpuParamBlockBuffer(size, usage, deviceMask), mBuffer(nullptr)
+		:GpuParamBlockBuffer(size, usage, deviceMask), mBuffer(nullptr), mRing(nullptr), mRingOffset(0), mRingGeneration(0)
 	{
 		assert((deviceMask == GDF_DEFAULT || deviceMask == GDF_PRIMARY) && "Multiple GPUs not supported natively on DirectX 11.");
 	}
@@ -28,9 +29,15 @@ namespace bs { namespace ct
 		D3D11RenderAPI* d3d11rs = static_cast<D3D11RenderAPI*>(RenderAPI::instancePtr());
 		D3D11Device& device = d3d11rs->getPrimaryDevice();
 
-		if(mUsage == GPBU_STATIC)
+		// Streamed buffers are written to the ring buffer if the device supports it, and act as dynamic buffers otherwise
+		if(mUsage == GPBU_STREAM)
+			mRing = device.getParamBlockRing();
+
+		if(mRing != nullptr)
+			mBuffer = nullptr;
+		else if(mUsage == GPBU_STATIC)
 			mBuffer = bs_new<D3D11HardwareBuffer>(D3D11HardwareBuffer::BT_CONSTANT, GBU_STATIC, 1, mSize, std::ref(device));
-		else if(mUsage == GPBU_DYNAMIC)
+		else if(mUsage == GPBU_DYNAMIC || mUsage == GPBU_STREAM)
 			mBuffer = bs_new<D3D11HardwareBuffer>(D3D11HardwareBuffer::BT_CONSTANT, GBU_DYNAMIC, 1, mSize, std::ref(device));
 		else
 			BS_EXCEPT(InternalErrorException, "Invalid gpu param block usage.");
@@ -43,13 +50,41 @@ namespace bs { namespace ct
 
 	ID3D11Buffer* D3D11GpuParamBlockBuffer::getD3D11Buffer() const
 	{
+		if (mRing != nullptr)
+			return mRing->getD3D11Buffer();
+
 		return mBuffer->getD3DBuffer();
 	}
 
+	void D3D11GpuParamBlockBuffer::getConstantRange(UINT32& firstConstant, UINT32& numConstants) const
+	{
+		if (mRing != nullptr)
+		{
+			const UINT32 alignment = D3D11ParamBlockRing::OFFSET_ALIGNMENT;
+
+			firstConstant = mRingOffset / 16;
+			numConstants = Math::divideAndRoundUp(mSize, alignment) * (alignment / 16);
+		}
+		else
+		{
+			// Reads past the end of the buffer return zero, so the maximum range covers the entire buffer
+			firstConstant = 0;
+			numConstants = D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT;
+		}
+	}
+
 	void D3D11GpuParamBlockBuffer::writeToGPU(const UINT8* data, UINT32 queueIdx)
 	{
-		mBuffer->writeData(0, mSize, data, BWT_DISCARD);
+		if (mRing != nullptr)
+			mRing->write(data, mSize, mRingOffset, mRingGeneration);
+		else
+			mBuffer->writeData(0, mSize, data, BWT_DISCARD);
 
 		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
 	}
+
+	bool D3D11GpuParamBlockBuffer::isGPUDataLost() const
+	{
+		return mRing != nullptr && !mRing->isValid(mRingGeneration);
+	}
 }}
\ No newline at end of file
@@ -23,12 +23,24 @@ namespace bs { namespace ct
 
 		/**	Returns internal DX11 buffer object. */
 		ID3D11Buffer* getD3D11Buffer() const;
+
+		/** 
+		 * Returns the range of the buffer returned by getD3D11Buffer() containing the parameter block data, in number of 
+		 * 16-byte constants. Meant to be used with the *SetConstantBuffers1 family of methods.
+		 */
+		void getConstantRange(UINT32& firstConstant, UINT32& numConstants) const;
 	protected:
 		/** @copydoc GpuParamBlockBuffer::initialize */
 		void initialize() override;
 
+		/** @copydoc GpuParamBlockBuffer::isGPUDataLost */
+		bool isGPUDataLost() const override;
+
 	private:
 		D3D11HardwareBuffer* mBuffer;
+		D3D11ParamBlockRing* mRing;
+		UINT32 mRingOffset;
+		UINT64 mRingGeneration;
 	};
 
 	/** @} */
@@ -0,0 +1,67 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsD3D11ParamBlockRing.h"
+#include "BsD3D11Device.h"
+#include "Error/BsException.h"
+
+namespace bs { namespace ct
+{
+	D3D11ParamBlockRing::D3D11ParamBlockRing(D3D11Device& device)
+		:mDevice(device), mBuffer(nullptr), mOffset(0), mGeneration(1), mDiscard(true)
+	{
+		D3D11_BUFFER_DESC desc;
+		desc.ByteWidth = SIZE;
+		desc.Usage = D3D11_USAGE_DYNAMIC;
+		desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		desc.MiscFlags = 0;
+		desc.StructureByteStride = 0;
+
+		HRESULT hr = device.getD3D11Device()->CreateBuffer(&desc, nullptr, &mBuffer);
+		if (FAILED(hr) || device.hasError())
+		{
+			String msg = device.getErrorDescription();
+			BS_EXCEPT(RenderingAPIException, "Cannot create D3D11 parameter block ring buffer: " + msg);
+		}
+	}
+
+	D3D11ParamBlockRing::~D3D11ParamBlockRing()
+	{
+		SAFE_RELEASE(mBuffer);
+	}
+
+	void D3D11ParamBlockRing::write(const UINT8* data, UINT32 size, UINT32& offset, UINT64& generation)
+	{
+		UINT32 alignedSize = Math::divideAndRoundUp(size, OFFSET_ALIGNMENT) * OFFSET_ALIGNMENT;
+		assert(alignedSize <= SIZE);
+
+		// Start over in a fresh buffer. The driver keeps the old contents around for any commands still using them.
+		if ((mOffset + alignedSize) > SIZE)
+		{
+			mOffset = 0;
+			mGeneration++;
+			mDiscard = true;
+		}
+
+		D3D11_MAP mapType = mDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+		mDiscard = false;
+
+		ID3D11DeviceContext* context = mDevice.getImmediateContext();
+
+		D3D11_MAPPED_SUBRESOURCE mappedData;
+		HRESULT hr = context->Map(mBuffer, 0, mapType, 0, &mappedData);
+		if (FAILED(hr) || mDevice.hasError())
+		{
+			String msg = mDevice.getErrorDescription();
+			BS_EXCEPT(RenderingAPIException, "Cannot map D3D11 parameter block ring buffer: " + msg);
+		}
+
+		memcpy((UINT8*)mappedData.pData + mOffset, data, size);
+		context->Unmap(mBuffer, 0);
+
+		offset = mOffset;
+		generation = mGeneration;
+
+		mOffset += alignedSize;
+	}
+}}
@@ -0,0 +1,59 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsD3D11Prerequisites.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup D3D11
+	 *  @{
+	 */
+
+	/**
+	 * Dynamic constant buffer that parameter blocks are sub-allocated from. Each write is appended after the previous one
+	 * using D3D11_MAP_WRITE_NO_OVERWRITE, and the parameter block is bound by its offset within the buffer using the
+	 * D3D11.1 constant buffer offsetting. Once the buffer is full it is discarded and writing starts from the beginning,
+	 * at which point all previously written data is considered lost.
+	 *
+	 * Requires ID3D11DeviceContext1 and a device that supports constant buffer offsetting and no-overwrite maps of
+	 * dynamic constant buffers.
+	 */
+	class D3D11ParamBlockRing
+	{
+	public:
+		D3D11ParamBlockRing(D3D11Device& device);
+		~D3D11ParamBlockRing();
+
+		/**
+		 * Copies the provided data into the ring.
+		 *
+		 * @param[in]	data		Data to copy.
+		 * @param[in]	size		Size of the data, in bytes.
+		 * @param[out]	offset		Offset of the data from the start of the buffer, in bytes. Always a multiple of
+		 *							OFFSET_ALIGNMENT.
+		 * @param[out]	generation	Identifier that can be passed to isValid() to check if the data is still available.
+		 */
+		void write(const UINT8* data, UINT32 size, UINT32& offset, UINT64& generation);
+
+		/** Checks if the data written with the provided generation is still available in the buffer. */
+		bool isValid(UINT64 generation) const { return generation == mGeneration; }
+
+		/** Returns the internal DX11 buffer object. */
+		ID3D11Buffer* getD3D11Buffer() const { return mBuffer; }
+
+		/** Alignment of the written data, in bytes. Offsets must be a multiple of 16 constants, each 16 bytes in size. */
+		static const UINT32 OFFSET_ALIGNMENT = 256;
+
+	private:
+		static const UINT32 SIZE = 4 * 1024 * 1024;
+
+		D3D11Device& mDevice;
+		ID3D11Buffer* mBuffer;
+		UINT32 mOffset;
+		UINT64 mGeneration;
+		bool mDiscard;
+	};
+
+	/** @} */
+}}
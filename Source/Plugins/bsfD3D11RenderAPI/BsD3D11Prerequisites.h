@@ -15,7 +15,7 @@
 #	define NOMINMAX // Required to stop windows.h messing up std::min
 #endif
 
-#include <d3d11.h>
+#include <d3d11_1.h>
 #include <d3d11shader.h>
 #include <D3Dcompiler.h>
 
@@ -46,6 +46,7 @@ namespace bs { namespace ct
 	class D3D11GpuProgram;
 	class D3D11TextureView;
 	class D3D11RenderWindow;
+	class D3D11ParamBlockRing;
 	class GpuBufferView;
 
 	/**	DirectX 11 specific types to track resource statistics for. */
@@ -341,6 +341,11 @@ namespace bs { namespace ct
 
 			ID3D11DeviceContext* context = mDevice->getImmediateContext();
 
+			// Param blocks sub-allocated from the ring buffer must be bound with an offset, which requires D3D11.1
+			ID3D11DeviceContext1* context1 = nullptr;
+			if (mDevice->getParamBlockRing() != nullptr)
+				context1 = mDevice->getImmediateContext1();
+
 			// Clear any previously bound UAVs (otherwise shaders attempting to read resources viewed by those views will
 			// be unable to)
 			if (mPSUAVsBound || mCSUAVsBound)
@@ -370,6 +375,8 @@ namespace bs { namespace ct
 				FrameVector<ID3D11ShaderResourceView*> srvs(8);
 				FrameVector<ID3D11UnorderedAccessView*> uavs(8);
 				FrameVector<ID3D11Buffer*> constBuffers(8);
+				FrameVector<UINT> firstConstants(8);
+				FrameVector<UINT> numConstants(8);
 				FrameVector<ID3D11SamplerState*> samplers(8);
 
 				auto populateViews = [&](GpuProgramType type)
@@ -377,6 +384,8 @@ namespace bs { namespace ct
 					srvs.clear();
 					uavs.clear();
 					constBuffers.clear();
+					firstConstants.clear();
+					numConstants.clear();
 					samplers.clear();
 
 					SPtr<GpuParamDesc> paramDesc = gpuParams->getParamDesc(type);
@@ -481,7 +490,11 @@ namespace bs { namespace ct
 						SPtr<GpuParamBlockBuffer> buffer = gpuParams->getParamBlockBuffer(iter->second.set, slot);
 
 						while (slot >= (UINT32)constBuffers.size())
+						{
 							constBuffers.push_back(nullptr);
+							firstConstants.push_back(0);
+							numConstants.push_back(D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT);
+						}
 
 						if (buffer != nullptr)
 						{
@@ -490,6 +503,7 @@ namespace bs { namespace ct
 							const D3D11GpuParamBlockBuffer* d3d11paramBlockBuffer =
 								static_cast<const D3D11GpuParamBlockBuffer*>(buffer.get());
 							constBuffers[slot] = d3d11paramBlockBuffer->getD3D11Buffer();
+							d3d11paramBlockBuffer->getConstantRange(firstConstants[slot], numConstants[slot]);
 						}
 					}
 				};
@@ -508,7 +522,15 @@ namespace bs { namespace ct
 					context->VSSetShaderResources(0, numSRVs, srvs.data());
 
 				if (numConstBuffers > 0)
-					context->VSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				{
+					if (context1 != nullptr)
+					{
+						context1->VSSetConstantBuffers1(0, numConstBuffers, constBuffers.data(), firstConstants.data(),
+							numConstants.data());
+					}
+					else
+						context->VSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				}
 
 				if (numSamplers > 0)
 					context->VSSetSamplers(0, numSamplers, samplers.data());
@@ -530,7 +552,15 @@ namespace bs { namespace ct
 				}
 
 				if (numConstBuffers > 0)
-					context->PSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				{
+					if (context1 != nullptr)
+					{
+						context1->PSSetConstantBuffers1(0, numConstBuffers, constBuffers.data(), firstConstants.data(),
+							numConstants.data());
+					}
+					else
+						context->PSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				}
 
 				if (numSamplers > 0)
 					context->PSSetSamplers(0, numSamplers, samplers.data());
@@ -544,7 +574,15 @@ namespace bs { namespace ct
 					context->GSSetShaderResources(0, numSRVs, srvs.data());
 
 				if (numConstBuffers > 0)
-					context->GSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				{
+					if (context1 != nullptr)
+					{
+						context1->GSSetConstantBuffers1(0, numConstBuffers, constBuffers.data(), firstConstants.data(),
+							numConstants.data());
+					}
+					else
+						context->GSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				}
 
 				if (numSamplers > 0)
 					context->GSSetSamplers(0, numSamplers, samplers.data());
@@ -558,7 +596,15 @@ namespace bs { namespace ct
 					context->HSSetShaderResources(0, numSRVs, srvs.data());
 
 				if (numConstBuffers > 0)
-					context->HSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				{
+					if (context1 != nullptr)
+					{
+						context1->HSSetConstantBuffers1(0, numConstBuffers, constBuffers.data(), firstConstants.data(),
+							numConstants.data());
+					}
+					else
+						context->HSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				}
 
 				if (numSamplers > 0)
 					context->HSSetSamplers(0, numSamplers, samplers.data());
@@ -572,7 +618,15 @@ namespace bs { namespace ct
 					context->DSSetShaderResources(0, numSRVs, srvs.data());
 
 				if (numConstBuffers > 0)
-					context->DSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				{
+					if (context1 != nullptr)
+					{
+						context1->DSSetConstantBuffers1(0, numConstBuffers, constBuffers.data(), firstConstants.data(),
+							numConstants.data());
+					}
+					else
+						context->DSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				}
 
 				if (numSamplers > 0)
 					context->DSSetSamplers(0, numSamplers, samplers.data());
@@ -593,7 +647,15 @@ namespace bs { namespace ct
 				}
 
 				if (numConstBuffers > 0)
-					context->CSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				{
+					if (context1 != nullptr)
+					{
+						context1->CSSetConstantBuffers1(0, numConstBuffers, constBuffers.data(), firstConstants.data(),
+							numConstants.data());
+					}
+					else
+						context->CSSetConstantBuffers(0, numConstBuffers, constBuffers.data());
+				}
 
 				if (numSamplers > 0)
 					context->CSSetSamplers(0, numSamplers, samplers.data());
@@ -1164,6 +1226,9 @@ namespace bs { namespace ct
 		caps.setCapability(RSC_TEXTURE_COMPRESSION_BC);
 		caps.addShaderProfile("hlsl");
 
+		if(mDevice->getParamBlockRing() != nullptr)
+			caps.setCapability(RSC_PARAM_BLOCK_RING_BUFFER);
+
 		if(mFeatureLevel >= D3D_FEATURE_LEVEL_10_1)
 			caps.setMaxBoundVertexBuffers(32);
 		else
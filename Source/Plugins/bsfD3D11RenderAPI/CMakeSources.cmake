@@ -36,6 +36,7 @@ set(BS_D3D11RENDERAPI_INC_NOFILTER
 	"BsD3D11RenderAPIFactory.h"
 	"BsD3D11CommandBuffer.h"
 	"BsD3D11CommandBufferManager.h"
+	"BsD3D11ParamBlockRing.h"
 )
 
 set(BS_D3D11RENDERAPI_SRC_NOFILTER
@@ -76,6 +77,7 @@ set(BS_D3D11RENDERAPI_SRC_NOFILTER
 	"BsD3D11RenderAPIFactory.cpp"
 	"BsD3D11CommandBuffer.cpp"
 	"BsD3D11CommandBufferManager.cpp"
+	"BsD3D11ParamBlockRing.cpp"
 )
 
 source_group("" FILES ${BS_D3D11RENDERAPI_SRC_NOFILTER} ${BS_D3D11RENDERAPI_INC_NOFILTER})
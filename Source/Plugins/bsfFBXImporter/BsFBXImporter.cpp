@@ -18,6 +18,7 @@
 #include "Physics/BsPhysicsMesh.h"
 #include "Animation/BsAnimationCurve.h"
 #include "Animation/BsAnimationClip.h"
+#include "Animation/BsCompressedAnimationCurves.h"
 #include "Animation/BsAnimationUtility.h"
 #include "Animation/BsSkeleton.h"
 #include "Animation/BsMorphShapes.h"
@@ -181,6 +182,9 @@ namespace bs
 			{
 				SPtr<AnimationClip> clip = AnimationClip::_createPtr(entry.curves, entry.isAdditive, entry.sampleRate, 
 					entry.rootMotion);
+
+				if(meshImportOptions->getAnimationCompression())
+					clip->compress(ANIMATION_COMPRESSION_DESC());
 				
 				for(auto& eventsEntry : events)
 				{
@@ -33,7 +33,7 @@ namespace bs { namespace ct
 			glBufferData(GL_UNIFORM_BUFFER, mSize, nullptr, GL_STATIC_DRAW);
 			BS_CHECK_GL_ERROR();
 		}
-		else if (mUsage == GPBU_DYNAMIC)
+		else if (mUsage == GPBU_DYNAMIC || mUsage == GPBU_STREAM)
 		{
 			glBufferData(GL_UNIFORM_BUFFER, mSize, nullptr, GL_DYNAMIC_DRAW);
 			BS_CHECK_GL_ERROR();
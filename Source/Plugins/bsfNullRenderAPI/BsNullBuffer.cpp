@@ -0,0 +1,63 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullBuffer.h"
+#include "BsNullRenderAPI.h"
+#include "Debug/BsDebug.h"
+
+namespace bs { namespace ct
+{
+	NullBuffer::~NullBuffer()
+	{
+		if (mData != nullptr)
+			bs_free(mData);
+	}
+
+	void NullBuffer::initialize(UINT32 size)
+	{
+		assert(mData == nullptr);
+
+		mSize = size;
+		mData = (UINT8*)bs_alloc(size);
+	}
+
+	void* NullBuffer::lock(UINT32 offset, UINT32 length, GpuLockOptions options)
+	{
+		assert(offset + length <= mSize);
+
+		mLockSize = length;
+		mIsWriteLocked = options != GBL_READ_ONLY;
+
+		return mData + offset;
+	}
+
+	void NullBuffer::unlock()
+	{
+		if (mIsWriteLocked)
+			gNullRenderAPI()._notifyBytesUploaded(mLockSize);
+
+		mLockSize = 0;
+		mIsWriteLocked = false;
+	}
+
+	void NullBuffer::readData(UINT32 offset, UINT32 length, void* dest)
+	{
+		assert(offset + length <= mSize);
+
+		memcpy(dest, mData + offset, length);
+	}
+
+	void NullBuffer::writeData(UINT32 offset, UINT32 length, const void* source)
+	{
+		assert(offset + length <= mSize);
+
+		memcpy(mData + offset, source, length);
+		gNullRenderAPI()._notifyBytesUploaded(length);
+	}
+
+	void NullBuffer::copyData(NullBuffer& dstBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length)
+	{
+		assert(srcOffset + length <= mSize && dstOffset + length <= dstBuffer.mSize);
+
+		memmove(dstBuffer.mData + dstOffset, mData + srcOffset, length);
+	}
+}}
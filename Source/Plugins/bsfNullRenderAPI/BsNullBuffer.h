@@ -0,0 +1,76 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/** 
+	 * Buffer stored in CPU memory, used as storage by all null render API buffer types. Reports all writes to the
+	 * render API as uploaded bytes.
+	 */
+	class NullBuffer
+	{
+	public:
+		NullBuffer() = default;
+		~NullBuffer();
+
+		/** Allocates the internal storage. Must be called before using the buffer. */
+		void initialize(UINT32 size);
+
+		/**
+		 * Locks a portion of the buffer and returns pointer to the locked area. You must call unlock() when done.
+		 *
+		 * @param[in]	offset	Offset in bytes from which to lock the buffer.
+		 * @param[in]	length	Length of the area you want to lock, in bytes.
+		 * @param[in]	options	Signifies what you want to do with the returned pointer.
+		 */
+		void* lock(UINT32 offset, UINT32 length, GpuLockOptions options);
+
+		/**	Releases the lock on this buffer. */
+		void unlock();
+
+		/**
+		 * Reads data from a portion of the buffer and copies it to the destination buffer. Caller must ensure destination 
+		 * buffer is large enough.
+		 *
+		 * @param[in]	offset	Offset in bytes from which to copy the data.
+		 * @param[in]	length	Length of the area you want to copy, in bytes.
+		 * @param[in]	dest	Destination buffer large enough to store the read data.
+		 */
+		void readData(UINT32 offset, UINT32 length, void* dest);
+
+		/**
+		 * Writes data into a portion of the buffer from the source memory. 
+		 *
+		 * @param[in]	offset		Offset in bytes from which to copy the data.
+		 * @param[in]	length		Length of the area you want to copy, in bytes.
+		 * @param[in]	source		Source buffer containing the data to write.
+		 */
+		void writeData(UINT32 offset, UINT32 length, const void* source);
+
+		/**
+		 * Copies data from a specific portion of this buffer into a specific portion of the provided buffer.
+		 *
+		 * @param[in]	dstBuffer			Buffer to copy to.
+		 * @param[in]	srcOffset			Offset into this buffer to start copying from, in bytes.
+		 * @param[in]	dstOffset			Offset into the destination buffer to start copying to, in bytes.
+		 * @param[in]	length				Size of the data to copy, in bytes.
+		 */
+		void copyData(NullBuffer& dstBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length);
+
+	private:
+		UINT8* mData = nullptr;
+		UINT32 mSize = 0;
+
+		UINT32 mLockSize = 0;
+		bool mIsWriteLocked = false;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,41 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsCommandBuffer.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**
+	 * Command buffer implementation for the null render API. Commands are not stored, instead only their counts are
+	 * recorded. Counts are added to the render API totals when the buffer is submitted.
+	 */
+	class NullCommandBuffer : public CommandBuffer
+	{
+	public:
+		/** Adds the counts of the secondary buffer to this command buffer. */
+		void appendSecondary(const SPtr<NullCommandBuffer>& secondaryBuffer);
+
+		/** Returns counts of commands recorded since the buffer was last submitted. */
+		const NullRenderStats& getStats() const { return mStats; }
+
+		/** Resets the counts of recorded commands. */
+		void clear();
+
+	private:
+		friend class NullCommandBufferManager;
+		friend class NullRenderAPI;
+
+		NullCommandBuffer(GpuQueueType type, UINT32 deviceIdx, UINT32 queueIdx, bool secondary);
+
+		NullRenderStats mStats;
+		DrawOperationType mCurrentDrawOperation = DOT_TRIANGLE_LIST;
+	};
+
+	/** @} */
+}}
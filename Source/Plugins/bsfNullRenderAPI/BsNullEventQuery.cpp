@@ -0,0 +1,30 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullEventQuery.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullEventQuery::NullEventQuery(UINT32 deviceIdx)
+	{
+		assert(deviceIdx == 0 && "Multiple GPUs not supported by the null render API.");
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Query);
+	}
+
+	NullEventQuery::~NullEventQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Query);
+	}
+
+	void NullEventQuery::begin(const SPtr<CommandBuffer>& cb)
+	{
+		setActive(true);
+	}
+
+	bool NullEventQuery::isReady() const
+	{
+		// No GPU work is ever queued, so the event is reached as soon as it is issued
+		return true;
+	}
+}}
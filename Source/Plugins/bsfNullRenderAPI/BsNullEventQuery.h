@@ -0,0 +1,29 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsEventQuery.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/** @copydoc EventQuery */
+	class NullEventQuery : public EventQuery
+	{
+	public:
+		NullEventQuery(UINT32 deviceIdx);
+		~NullEventQuery();
+
+		/** @copydoc EventQuery::begin */
+		void begin(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc EventQuery::isReady */
+		bool isReady() const override;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,32 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullGpuParamBlockBuffer.h"
+#include "BsNullRenderAPI.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullGpuParamBlockBuffer::NullGpuParamBlockBuffer(UINT32 size, GpuParamBlockUsage usage, GpuDeviceFlags deviceMask)
+		:GpuParamBlockBuffer(size, usage, deviceMask)
+	{
+		assert((deviceMask == GDF_DEFAULT || deviceMask == GDF_PRIMARY) && "Multiple GPUs not supported by the null render API.");
+	}
+
+	NullGpuParamBlockBuffer::~NullGpuParamBlockBuffer()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuParamBuffer);
+	}
+
+	void NullGpuParamBlockBuffer::initialize()
+	{
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuParamBuffer);
+		GpuParamBlockBuffer::initialize();
+	}
+
+	void NullGpuParamBlockBuffer::writeToGPU(const UINT8* data, UINT32 queueIdx)
+	{
+		gNullRenderAPI()._notifyBytesUploaded(mSize);
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
+	}
+}}
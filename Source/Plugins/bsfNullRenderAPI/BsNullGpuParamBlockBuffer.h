@@ -0,0 +1,33 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**	
+	 * Null render API implementation of a GPU parameter buffer. Parameter data is only kept in the CPU side cache of the
+	 * buffer, and writes to the GPU are only counted.
+	 */
+	class NullGpuParamBlockBuffer : public GpuParamBlockBuffer
+	{
+	public:
+		NullGpuParamBlockBuffer(UINT32 size, GpuParamBlockUsage usage, GpuDeviceFlags deviceMask);
+		~NullGpuParamBlockBuffer();
+
+		/** @copydoc GpuParamBlockBuffer::writeToGPU */
+		void writeToGPU(const UINT8* data, UINT32 queueIdx = 0) override;
+
+	protected:
+		/** @copydoc GpuParamBlockBuffer::initialize */
+		void initialize() override;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,181 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullGpuProgram.h"
+#include "RenderAPI/BsGpuParamDesc.h"
+#include "RenderAPI/BsGpuParams.h"
+#include "Managers/BsHardwareBufferManager.h"
+#include "Profiling/BsRenderStats.h"
+#include "Math/BsMath.h"
+
+#if BS_NULL_GLSLANG
+#define AMD_EXTENSIONS
+#define NV_EXTENSIONS
+#include "glslang/Public/ShaderLang.h"
+#include "glslang/Include/Types.h"
+#include "BsGLSLangReflection.h"
+#endif
+
+namespace bs { namespace ct
+{
+#if BS_NULL_GLSLANG
+	const String NullGpuProgramFactory::LANGUAGE = "vksl";
+#else
+	const String NullGpuProgramFactory::LANGUAGE = "hlsl";
+#endif
+
+	NullGpuProgram::NullGpuProgram(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask)
+		: GpuProgram(desc, deviceMask)
+	{
+		assert((deviceMask == GDF_DEFAULT || deviceMask == GDF_PRIMARY) && "Multiple GPUs not supported by the null render API.");
+	}
+
+	NullGpuProgram::~NullGpuProgram()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuProgram);
+	}
+
+	void NullGpuProgram::initialize()
+	{
+		// Prefer reflection cached along with the bytecode, otherwise reflect the source
+		if(!mBytecode || !mBytecode->paramDesc)
+		{
+			GPU_PROGRAM_DESC desc;
+			desc.type = mType;
+			desc.entryPoint = mEntryPoint;
+			desc.language = NullGpuProgramFactory::LANGUAGE;
+			desc.source = mSource;
+
+			mBytecode = compileBytecode(desc);
+		}
+
+		mCompileMessages = mBytecode->messages;
+
+		// Without glslang the program is accepted without reflection, and the render API warns about it on start-up
+		mIsCompiled = mBytecode->paramDesc != nullptr || !BS_NULL_GLSLANG;
+
+		if(mIsCompiled)
+		{
+			Vector<VertexElement> vertexInput;
+			if(mBytecode->paramDesc)
+			{
+				mParametersDesc = mBytecode->paramDesc;
+				vertexInput = mBytecode->vertexInput;
+			}
+
+			if(mType == GPT_VERTEX_PROGRAM)
+				mInputDeclaration = HardwareBufferManager::instance().createVertexDeclaration(vertexInput);
+		}
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuProgram);
+		GpuProgram::initialize();
+	}
+
+	NullGpuProgramFactory::NullGpuProgramFactory()
+	{
+#if BS_NULL_GLSLANG
+		glslang::InitializeProcess();
+#endif
+	}
+
+	NullGpuProgramFactory::~NullGpuProgramFactory()
+	{
+#if BS_NULL_GLSLANG
+		glslang::FinalizeProcess();
+#endif
+	}
+
+	SPtr<GpuProgram> NullGpuProgramFactory::create(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask)
+	{
+		SPtr<GpuProgram> gpuProg = bs_shared_ptr<NullGpuProgram>(new (bs_alloc<NullGpuProgram>())
+			NullGpuProgram(desc, deviceMask));
+		gpuProg->_setThisPtr(gpuProg);
+
+		return gpuProg;
+	}
+
+	SPtr<GpuProgram> NullGpuProgramFactory::create(GpuProgramType type, GpuDeviceFlags deviceMask)
+	{
+		GPU_PROGRAM_DESC desc;
+		desc.type = type;
+
+		SPtr<GpuProgram> gpuProg = bs_shared_ptr<NullGpuProgram>(new (bs_alloc<NullGpuProgram>())
+			NullGpuProgram(desc, deviceMask));
+		gpuProg->_setThisPtr(gpuProg);
+
+		return gpuProg;
+	}
+
+	SPtr<GpuProgramBytecode> NullGpuProgramFactory::compileBytecode(const GPU_PROGRAM_DESC& desc)
+	{
+		SPtr<GpuProgramBytecode> bytecode = bs_shared_ptr_new<GpuProgramBytecode>();
+		bytecode->compilerId = "Null";
+
+#if BS_NULL_GLSLANG
+		EShLanguage glslType;
+		switch(desc.type)
+		{
+		case GPT_FRAGMENT_PROGRAM:
+			glslType = EShLangFragment;
+			break;
+		case GPT_HULL_PROGRAM:
+			glslType = EShLangTessControl;
+			break;
+		case GPT_DOMAIN_PROGRAM:
+			glslType = EShLangTessEvaluation;
+			break;
+		case GPT_GEOMETRY_PROGRAM:
+			glslType = EShLangGeometry;
+			break;
+		case GPT_COMPUTE_PROGRAM:
+			glslType = EShLangCompute;
+			break;
+		case GPT_VERTEX_PROGRAM:
+		default:
+			glslType = EShLangVertex;
+			break;
+		}
+
+		const char* sourceBytes = desc.source.c_str();
+
+		glslang::TShader shader(glslType);
+		shader.setStrings(&sourceBytes, 1);
+		shader.setEntryPoint("main");
+
+		glslang::TProgram program;
+
+		EShMessages messages = (EShMessages)((int)EShMsgSpvRules | (int)EShMsgVulkanRules);
+		if (!shader.parse(&GLSLangReflection::DEFAULT_RESOURCES, 450, false, messages))
+		{
+			bytecode->messages = "Compile error: " + String(shader.getInfoLog());
+			return bytecode;
+		}
+
+		program.addShader(&shader);
+
+		if (!program.link(messages))
+		{
+			bytecode->messages = "Link error: " + String(program.getInfoLog());
+			return bytecode;
+		}
+
+		program.mapIO();
+		program.buildReflection();
+
+		SPtr<GpuParamDesc> paramDesc = bs_shared_ptr_new<GpuParamDesc>();
+		if(!GLSLangReflection::parseUniforms(&program, *paramDesc, bytecode->messages))
+			return bytecode;
+
+		if (desc.type == GPT_VERTEX_PROGRAM)
+		{
+			if (!GLSLangReflection::parseVertexAttributes(&program, bytecode->vertexInput, bytecode->messages))
+				return bytecode;
+		}
+
+		bytecode->paramDesc = paramDesc;
+#else
+		bytecode->messages = "The null render API was built without glslang, GPU program parameters cannot be reflected.";
+#endif
+
+		return bytecode;
+	}
+}}
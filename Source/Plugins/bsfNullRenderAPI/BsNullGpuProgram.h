@@ -0,0 +1,65 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsGpuProgram.h"
+#include "Managers/BsGpuProgramManager.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/** 
+	 * Null render API implementation of a GPU program. Programs are never compiled to executable code, but their
+	 * parameters and vertex inputs are reflected so the renderer binds and updates them as it would on a real GPU. If the
+	 * program was created with bytecode that contains reflection information, it is taken from the bytecode. Otherwise
+	 * the source is reflected using glslang. If the plugin was built without glslang, such programs report no parameters
+	 * and no vertex inputs.
+	 */
+	class NullGpuProgram : public GpuProgram
+	{
+	public:
+		~NullGpuProgram();
+
+	protected:
+		friend class NullGpuProgramFactory;
+
+		NullGpuProgram(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask);
+
+		/** @copydoc GpuProgram::initialize */
+		void initialize() override;
+	};
+
+	/**	Handles creation of null render API GPU programs. */
+	class NullGpuProgramFactory : public GpuProgramFactory
+	{
+	public:
+		NullGpuProgramFactory();
+		~NullGpuProgramFactory();
+
+		/** 
+		 * Language of the programs accepted by the factory. Vulkan GLSL if the programs can be reflected using glslang,
+		 * HLSL otherwise.
+		 */
+		static const String LANGUAGE;
+
+		/** @copydoc GpuProgramFactory::create(const GPU_PROGRAM_DESC&, GpuDeviceFlags) */
+		SPtr<GpuProgram> create(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
+		/** @copydoc GpuProgramFactory::create(GpuProgramType, GpuDeviceFlags) */
+		SPtr<GpuProgram> create(GpuProgramType type, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
+		/** 
+		 * @copydoc GpuProgramFactory::compileBytecode(const GPU_PROGRAM_DESC&)
+		 *
+		 * @note	Returned bytecode contains no instructions, only the reflected parameters and vertex inputs. If the
+		 *			plugin was built without glslang the reflection information will be missing.
+		 */
+		SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc) override;
+	};
+
+	/** @} */
+}}
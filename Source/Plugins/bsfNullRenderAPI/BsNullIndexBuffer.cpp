@@ -0,0 +1,55 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullIndexBuffer.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullIndexBuffer::NullIndexBuffer(const INDEX_BUFFER_DESC& desc, GpuDeviceFlags deviceMask)
+		:IndexBuffer(desc, deviceMask)
+	{
+		assert((deviceMask == GDF_DEFAULT || deviceMask == GDF_PRIMARY) && "Multiple GPUs not supported by the null render API.");
+	}
+
+	NullIndexBuffer::~NullIndexBuffer()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_IndexBuffer);
+	}
+
+	void NullIndexBuffer::initialize()
+	{
+		mBuffer.initialize(mSize);
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_IndexBuffer);
+		IndexBuffer::initialize();
+	}
+
+	void* NullIndexBuffer::map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		return mBuffer.lock(offset, length, options);
+	}
+
+	void NullIndexBuffer::unmap()
+	{
+		mBuffer.unlock();
+	}
+
+	void NullIndexBuffer::readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		mBuffer.readData(offset, length, dest);
+	}
+
+	void NullIndexBuffer::writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags,
+		UINT32 queueIdx)
+	{
+		mBuffer.writeData(offset, length, source);
+	}
+
+	void NullIndexBuffer::copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length,
+		bool discardWholeBuffer, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Commands are never deferred, so the copy is performed immediately even if a command buffer is provided
+		NullIndexBuffer& nullSrcBuffer = static_cast<NullIndexBuffer&>(srcBuffer);
+		nullSrcBuffer.mBuffer.copyData(mBuffer, srcOffset, dstOffset, length);
+	}
+}}
@@ -0,0 +1,42 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullOcclusionQuery.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullOcclusionQuery::NullOcclusionQuery(bool binary, UINT32 deviceIdx)
+		:OcclusionQuery(binary)
+	{
+		assert(deviceIdx == 0 && "Multiple GPUs not supported by the null render API.");
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Query);
+	}
+
+	NullOcclusionQuery::~NullOcclusionQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Query);
+	}
+
+	void NullOcclusionQuery::begin(const SPtr<CommandBuffer>& cb)
+	{
+		mEndIssued = false;
+
+		setActive(true);
+	}
+
+	void NullOcclusionQuery::end(const SPtr<CommandBuffer>& cb)
+	{
+		mEndIssued = true;
+	}
+
+	bool NullOcclusionQuery::isReady() const
+	{
+		return mEndIssued;
+	}
+
+	UINT32 NullOcclusionQuery::getNumSamples()
+	{
+		return 0;
+	}
+}}
@@ -0,0 +1,118 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+/** Set to 1 when the plugin is built with glslang, which is used for reflecting GPU program parameters. */
+#ifndef BS_NULL_GLSLANG
+#define BS_NULL_GLSLANG 0
+#endif
+
+/** @addtogroup Plugins
+ *  @{
+ */
+
+/** @defgroup NullRenderAPI bsfNullRenderAPI
+ *	Render API that executes no GPU work. Resources are kept in CPU memory and commands are only counted. Used for
+ *	running the renderer on systems without a GPU, and for measuring its CPU side.
+ */
+
+/** @} */
+
+namespace bs
+{
+	class NullRenderWindow;
+	class NullRenderTexture;
+
+	namespace ct
+	{
+	class NullRenderAPI;
+	class NullCommandBuffer;
+	class NullTexture;
+	class NullRenderWindow;
+	class NullRenderTexture;
+	class NullGpuProgram;
+	class NullGpuProgramFactory;
+	class NullHardwareBuffer;
+
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/** Counts of the work submitted to the null render API. */
+	struct NullRenderStats
+	{
+		UINT64 numDrawCalls = 0; /**< Number of draw calls, both indexed and non-indexed. */
+		UINT64 numComputeCalls = 0; /**< Number of compute shader dispatches. */
+		UINT64 numInstances = 0; /**< Number of instances drawn by all draw calls. */
+		UINT64 numVertices = 0; /**< Number of vertices drawn, across all instances. */
+		UINT64 numPrimitives = 0; /**< Number of primitives drawn, across all instances. */
+
+		UINT64 numPipelineStateChanges = 0; /**< Number of graphics or compute pipeline binds. */
+		UINT64 numGpuParamBinds = 0; /**< Number of GPU parameter set binds. */
+		UINT64 numVertexBufferBinds = 0; /**< Number of vertex buffer binds. */
+		UINT64 numIndexBufferBinds = 0; /**< Number of index buffer binds. */
+		UINT64 numRenderTargetChanges = 0; /**< Number of render target binds. */
+
+		UINT64 numClears = 0; /**< Number of render target or viewport clears. */
+		UINT64 numPresents = 0; /**< Number of render targets presented (swapped). */
+
+		/** Number of bytes written from the CPU to buffers (including parameter blocks) and textures. */
+		UINT64 numBytesUploaded = 0;
+
+		/** Number of separate writes from the CPU to buffers (including parameter blocks) and textures. */
+		UINT64 numUploads = 0;
+
+		/** Returns the total number of state changes (pipeline, parameter, vertex/index buffer and render target binds). */
+		UINT64 getNumStateChanges() const
+		{
+			return numPipelineStateChanges + numGpuParamBinds + numVertexBufferBinds + numIndexBufferBinds +
+				numRenderTargetChanges;
+		}
+
+		NullRenderStats& operator+=(const NullRenderStats& rhs)
+		{
+			numDrawCalls += rhs.numDrawCalls;
+			numComputeCalls += rhs.numComputeCalls;
+			numInstances += rhs.numInstances;
+			numVertices += rhs.numVertices;
+			numPrimitives += rhs.numPrimitives;
+			numPipelineStateChanges += rhs.numPipelineStateChanges;
+			numGpuParamBinds += rhs.numGpuParamBinds;
+			numVertexBufferBinds += rhs.numVertexBufferBinds;
+			numIndexBufferBinds += rhs.numIndexBufferBinds;
+			numRenderTargetChanges += rhs.numRenderTargetChanges;
+			numClears += rhs.numClears;
+			numPresents += rhs.numPresents;
+			numBytesUploaded += rhs.numBytesUploaded;
+			numUploads += rhs.numUploads;
+
+			return *this;
+		}
+
+		NullRenderStats operator-(const NullRenderStats& rhs) const
+		{
+			NullRenderStats output;
+			output.numDrawCalls = numDrawCalls - rhs.numDrawCalls;
+			output.numComputeCalls = numComputeCalls - rhs.numComputeCalls;
+			output.numInstances = numInstances - rhs.numInstances;
+			output.numVertices = numVertices - rhs.numVertices;
+			output.numPrimitives = numPrimitives - rhs.numPrimitives;
+			output.numPipelineStateChanges = numPipelineStateChanges - rhs.numPipelineStateChanges;
+			output.numGpuParamBinds = numGpuParamBinds - rhs.numGpuParamBinds;
+			output.numVertexBufferBinds = numVertexBufferBinds - rhs.numVertexBufferBinds;
+			output.numIndexBufferBinds = numIndexBufferBinds - rhs.numIndexBufferBinds;
+			output.numRenderTargetChanges = numRenderTargetChanges - rhs.numRenderTargetChanges;
+			output.numClears = numClears - rhs.numClears;
+			output.numPresents = numPresents - rhs.numPresents;
+			output.numBytesUploaded = numBytesUploaded - rhs.numBytesUploaded;
+			output.numUploads = numUploads - rhs.numUploads;
+
+			return output;
+		}
+	};
+
+	/** @} */
+	}
+}
@@ -0,0 +1,472 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullRenderAPI.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Profiling/BsRenderStats.h"
+#include "RenderAPI/BsGpuParamDesc.h"
+#include "RenderAPI/BsGpuParams.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "RenderAPI/BsRenderTarget.h"
+#include "Managers/BsRenderStateManager.h"
+#include "Managers/BsGpuProgramManager.h"
+#include "Managers/BsRenderWindowManager.h"
+#include "Math/BsMath.h"
+#include "BsNullCommandBuffer.h"
+#include "BsNullCommandBufferManager.h"
+#include "BsNullTextureManager.h"
+#include "BsNullHardwareBufferManager.h"
+#include "BsNullRenderWindowManager.h"
+#include "BsNullQueryManager.h"
+#include "BsNullGpuProgram.h"
+#include "BsNullVideoModeInfo.h"
+
+namespace bs { namespace ct
+{
+	NullRenderAPI::NullRenderAPI()
+	{ }
+
+	NullRenderAPI::~NullRenderAPI()
+	{ }
+
+	const StringID& NullRenderAPI::getName() const
+	{
+		static StringID strName("NullRenderAPI");
+		return strName;
+	}
+
+	void NullRenderAPI::initialize()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mVideoModeInfo = bs_shared_ptr_new<NullVideoModeInfo>();
+
+		// Create command buffer manager
+		CommandBufferManager::startUp<NullCommandBufferManager>();
+
+		// Create main command buffer
+		mMainCommandBuffer = std::static_pointer_cast<NullCommandBuffer>(CommandBuffer::create(GQT_GRAPHICS));
+
+		// Create the texture manager for use by others		
+		bs::TextureManager::startUp<bs::NullTextureManager>();
+		TextureManager::startUp<NullTextureManager>();
+
+		// Create hardware buffer manager		
+		bs::HardwareBufferManager::startUp();
+		HardwareBufferManager::startUp<NullHardwareBufferManager>();
+
+		// Create render window manager
+		bs::RenderWindowManager::startUp<bs::NullRenderWindowManager>();
+		RenderWindowManager::startUp();
+
+		// Create query manager 
+		QueryManager::startUp<NullQueryManager>();
+
+		// Create render state manager
+		RenderStateManager::startUp();
+
+		// Create & register the program factory
+		mProgramFactory = bs_new<NullGpuProgramFactory>();
+		GpuProgramManager::instance().addFactory(NullGpuProgramFactory::LANGUAGE, mProgramFactory);
+
+#if !BS_NULL_GLSLANG
+		LOGWRN("Null render API was built without glslang. GPU programs without reflection information cached in their "
+			"bytecode will report no parameters, and no parameters will be bound or updated.");
+#endif
+
+		initCapabilites();
+		
+		RenderAPI::initialize();
+	}
+
+	void NullRenderAPI::destroyCore()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mProgramFactory != nullptr)
+		{
+			GpuProgramManager::instance().removeFactory(NullGpuProgramFactory::LANGUAGE);
+
+			bs_delete(mProgramFactory);
+			mProgramFactory = nullptr;
+		}
+
+		QueryManager::shutDown();
+		RenderStateManager::shutDown();
+		RenderWindowManager::shutDown();
+		bs::RenderWindowManager::shutDown();
+		HardwareBufferManager::shutDown();
+		bs::HardwareBufferManager::shutDown();
+		TextureManager::shutDown();
+		bs::TextureManager::shutDown();
+
+		mMainCommandBuffer = nullptr;
+		CommandBufferManager::shutDown();
+
+		RenderAPI::destroyCore();
+	}
+
+	void NullRenderAPI::setGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numPipelineStateChanges++;
+
+		BS_INC_RENDER_STAT(NumPipelineStateChanges);
+	}
+
+	void NullRenderAPI::setComputePipeline(const SPtr<ComputePipelineState>& pipelineState,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numPipelineStateChanges++;
+
+		BS_INC_RENDER_STAT(NumPipelineStateChanges);
+	}
+
+	void NullRenderAPI::setGpuParams(const SPtr<GpuParams>& gpuParams, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+
+		for (UINT32 i = 0; i < GPT_COUNT; i++)
+		{
+			SPtr<GpuParamDesc> paramDesc = gpuParams->getParamDesc((GpuProgramType)i);
+			if (paramDesc == nullptr)
+				continue;
+
+			// Flush all param block buffers, same as a real render API would
+			for (auto iter = paramDesc->paramBlocks.begin(); iter != paramDesc->paramBlocks.end(); ++iter)
+			{
+				SPtr<GpuParamBlockBuffer> buffer = gpuParams->getParamBlockBuffer(iter->second.set, iter->second.slot);
+
+				if (buffer != nullptr)
+					buffer->flushToGPU();
+			}
+		}
+
+		cb->mStats.numGpuParamBinds++;
+
+		BS_INC_RENDER_STAT(NumGpuParamBinds);
+	}
+
+	void NullRenderAPI::setViewport(const Rect2& vp, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Do nothing
+	}
+
+	void NullRenderAPI::setVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numVertexBufferBinds++;
+
+		BS_INC_RENDER_STAT(NumVertexBufferBinds);
+	}
+
+	void NullRenderAPI::setIndexBuffer(const SPtr<IndexBuffer>& buffer, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numIndexBufferBinds++;
+
+		BS_INC_RENDER_STAT(NumIndexBufferBinds);
+	}
+
+	void NullRenderAPI::setVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Do nothing
+	}
+
+	void NullRenderAPI::setDrawOperation(DrawOperationType op, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mCurrentDrawOperation = op;
+	}
+
+	void NullRenderAPI::draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+
+		UINT32 primCount = vertexCountToPrimCount(cb->mCurrentDrawOperation, vertexCount);
+		UINT32 numInstances = std::max(instanceCount, 1U);
+
+		cb->mStats.numDrawCalls++;
+		cb->mStats.numInstances += numInstances;
+		cb->mStats.numVertices += vertexCount * (UINT64)numInstances;
+		cb->mStats.numPrimitives += primCount * (UINT64)numInstances;
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+		BS_ADD_RENDER_STAT(NumVertices, vertexCount);
+		BS_ADD_RENDER_STAT(NumPrimitives, primCount);
+	}
+
+	void NullRenderAPI::drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
+		UINT32 instanceCount, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+
+		UINT32 primCount = vertexCountToPrimCount(cb->mCurrentDrawOperation, indexCount);
+		UINT32 numInstances = std::max(instanceCount, 1U);
+
+		cb->mStats.numDrawCalls++;
+		cb->mStats.numInstances += numInstances;
+		cb->mStats.numVertices += vertexCount * (UINT64)numInstances;
+		cb->mStats.numPrimitives += primCount * (UINT64)numInstances;
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+		BS_ADD_RENDER_STAT(NumVertices, vertexCount);
+		BS_ADD_RENDER_STAT(NumPrimitives, primCount);
+	}
+
+	void NullRenderAPI::dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numComputeCalls++;
+
+		BS_INC_RENDER_STAT(NumComputeCalls);
+	}
+
+	void NullRenderAPI::setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Do nothing
+	}
+
+	void NullRenderAPI::setStencilRef(UINT32 value, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Do nothing
+	}
+
+	void NullRenderAPI::clearViewport(UINT32 buffers, const Color& color, float depth, UINT16 stencil, UINT8 targetMask,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numClears++;
+
+		BS_INC_RENDER_STAT(NumClears);
+	}
+
+	void NullRenderAPI::clearRenderTarget(UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+		UINT8 targetMask, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numClears++;
+
+		BS_INC_RENDER_STAT(NumClears);
+	}
+
+	void NullRenderAPI::setRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags,
+		RenderSurfaceMask loadMask, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numRenderTargetChanges++;
+
+		mActiveRenderTarget = target;
+
+		BS_INC_RENDER_STAT(NumRenderTargetChanges);
+	}
+
+	void NullRenderAPI::swapBuffers(const SPtr<RenderTarget>& target, UINT32 syncMask)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		submitCommandBuffer(mMainCommandBuffer, syncMask);
+		target->swapBuffers(syncMask);
+
+		mStats.numPresents++;
+
+		{
+			Lock lock(mStatsMutex);
+			mPresentedStats = mStats;
+		}
+
+		BS_INC_RENDER_STAT(NumPresents);
+	}
+
+	void NullRenderAPI::addCommands(const SPtr<CommandBuffer>& commandBuffer, const SPtr<CommandBuffer>& secondary)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->appendSecondary(std::static_pointer_cast<NullCommandBuffer>(secondary));
+	}
+
+	void NullRenderAPI::submitCommandBuffer(const SPtr<CommandBuffer>& commandBuffer, UINT32 syncMask)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		NullCommandBuffer* cb = getCB(commandBuffer);
+
+		mStats += cb->getStats();
+		cb->clear();
+	}
+
+	void NullRenderAPI::convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest)
+	{
+		dest = matrix;
+
+		// Convert depth range from [-1,+1] to [0,1]
+		dest[2][0] = (dest[2][0] + dest[3][0]) / 2;
+		dest[2][1] = (dest[2][1] + dest[3][1]) / 2;
+		dest[2][2] = (dest[2][2] + dest[3][2]) / 2;
+		dest[2][3] = (dest[2][3] + dest[3][3]) / 2;
+	}
+
+	const RenderAPIInfo& NullRenderAPI::getAPIInfo() const
+	{
+		RenderAPIFeatures featureFlags =
+			RenderAPIFeatureFlag::TextureViews |
+			RenderAPIFeatureFlag::Compute | 
+			RenderAPIFeatureFlag::LoadStore |
+			RenderAPIFeatureFlag::RenderTargetLayers;
+
+		static RenderAPIInfo info(0.0f, 0.0f, 0.0f, 1.0f, VET_COLOR_ABGR, featureFlags);
+
+		return info;
+	}
+
+	GpuParamBlockDesc NullRenderAPI::generateParamBlockDesc(const String& name, Vector<GpuParamDataDesc>& params)
+	{
+		// Uses the same layout as DirectX, as programs are created from HLSL techniques
+		GpuParamBlockDesc block;
+		block.blockSize = 0;
+		block.isShareable = true;
+		block.name = name;
+		block.slot = 0;
+		block.set = 0;
+
+		for (auto& param : params)
+		{
+			const GpuParamDataTypeInfo& typeInfo = bs::GpuParams::PARAM_SIZES.lookup[param.type];
+
+			if (param.arraySize > 1)
+			{
+				// Arrays perform no packing and their elements are always padded and aligned to four component vectors
+				UINT32 size;
+				if(param.type == GPDT_STRUCT)
+					size = Math::divideAndRoundUp(param.elementSize, 16U) * 4;
+				else
+					size = Math::divideAndRoundUp(typeInfo.size, 16U) * 4;
+
+				block.blockSize = Math::divideAndRoundUp(block.blockSize, 4U) * 4;
+
+				param.elementSize = size;
+				param.arrayElementStride = size;
+				param.cpuMemOffset = block.blockSize;
+				param.gpuMemOffset = 0;
+
+				// Last array element isn't rounded up to four component vectors unless it's a struct
+				if(param.type != GPDT_STRUCT)
+				{
+					block.blockSize += size * (param.arraySize - 1);
+					block.blockSize += typeInfo.size / 4;
+				}
+				else
+					block.blockSize += param.arraySize * size;
+			}
+			else
+			{
+				UINT32 size;
+				if(param.type == GPDT_STRUCT)
+				{
+					// Structs are always aligned and arounded up to 4 component vectors
+					size = Math::divideAndRoundUp(param.elementSize, 16U) * 4;
+					block.blockSize = Math::divideAndRoundUp(block.blockSize, 4U) * 4;
+				}
+				else
+				{
+					size = typeInfo.baseTypeSize * (typeInfo.numRows * typeInfo.numColumns) / 4;
+
+					// Pack everything as tightly as possible as long as the data doesn't cross 16 byte boundary
+					UINT32 alignOffset = block.blockSize % 4;
+					if (alignOffset != 0 && size > (4 - alignOffset))
+					{
+						UINT32 padding = (4 - alignOffset);
+						block.blockSize += padding;
+					}
+				}
+
+				param.elementSize = size;
+				param.arrayElementStride = size;
+				param.cpuMemOffset = block.blockSize;
+				param.gpuMemOffset = 0;
+
+				block.blockSize += size;
+			}
+
+			param.paramBlockSlot = 0;
+			param.paramBlockSet = 0;
+		}
+
+		// Constant buffer size must always be a multiple of 16
+		if (block.blockSize % 4 != 0)
+			block.blockSize += (4 - (block.blockSize % 4));
+
+		return block;
+	}
+
+	void NullRenderAPI::initCapabilites()
+	{
+		mNumDevices = 1;
+		mCurrentCapabilities = bs_newN<RenderAPICapabilities>(mNumDevices);
+
+		RenderAPICapabilities& caps = mCurrentCapabilities[0];
+
+		DriverVersion driverVersion;
+		driverVersion.major = 1;
+		caps.setDriverVersion(driverVersion);
+
+		caps.setDeviceName("Null");
+		caps.setVendor(GPU_UNKNOWN);
+		caps.setRenderAPIName(getName());
+
+		// Everything is supported, since nothing is executed
+		caps.setCapability(RSC_TEXTURE_COMPRESSION_BC);
+		caps.setCapability(RSC_COMPUTE_PROGRAM);
+		caps.setCapability(RSC_GEOMETRY_PROGRAM);
+		caps.setCapability(RSC_TESSELLATION_PROGRAM);
+
+		caps.setMaxBoundVertexBuffers(16);
+		caps.setNumMultiRenderTargets(8);
+
+		for (UINT32 i = 0; i < GPT_COUNT; i++)
+		{
+			GpuProgramType type = (GpuProgramType)i;
+
+			caps.setNumTextureUnits(type, 128);
+			caps.setNumGpuParamBlockBuffers(type, 14);
+		}
+
+		caps.setNumLoadStoreTextureUnits(GPT_FRAGMENT_PROGRAM, 8);
+		caps.setNumLoadStoreTextureUnits(GPT_COMPUTE_PROGRAM, 8);
+
+		caps.setNumCombinedTextureUnits(caps.getNumTextureUnits(GPT_FRAGMENT_PROGRAM)
+			+ caps.getNumTextureUnits(GPT_VERTEX_PROGRAM) + caps.getNumTextureUnits(GPT_GEOMETRY_PROGRAM)
+			+ caps.getNumTextureUnits(GPT_HULL_PROGRAM) + caps.getNumTextureUnits(GPT_DOMAIN_PROGRAM)
+			+ caps.getNumTextureUnits(GPT_COMPUTE_PROGRAM));
+
+		caps.setNumCombinedGpuParamBlockBuffers(caps.getNumGpuParamBlockBuffers(GPT_FRAGMENT_PROGRAM)
+			+ caps.getNumGpuParamBlockBuffers(GPT_VERTEX_PROGRAM) + caps.getNumGpuParamBlockBuffers(GPT_GEOMETRY_PROGRAM)
+			+ caps.getNumGpuParamBlockBuffers(GPT_HULL_PROGRAM) + caps.getNumGpuParamBlockBuffers(GPT_DOMAIN_PROGRAM)
+			+ caps.getNumGpuParamBlockBuffers(GPT_COMPUTE_PROGRAM));
+
+		caps.setNumCombinedLoadStoreTextureUnits(caps.getNumLoadStoreTextureUnits(GPT_FRAGMENT_PROGRAM)
+			+ caps.getNumLoadStoreTextureUnits(GPT_COMPUTE_PROGRAM));
+
+		caps.setGeometryProgramNumOutputVertices(1024);
+
+		caps.addShaderProfile(NullGpuProgramFactory::LANGUAGE);
+	}
+
+	NullCommandBuffer* NullRenderAPI::getCB(const SPtr<CommandBuffer>& buffer)
+	{
+		if (buffer != nullptr)
+			return static_cast<NullCommandBuffer*>(buffer.get());
+
+		return mMainCommandBuffer.get();
+	}
+
+	NullRenderAPI& gNullRenderAPI()
+	{
+		return static_cast<NullRenderAPI&>(RenderAPI::instance());
+	}
+}}
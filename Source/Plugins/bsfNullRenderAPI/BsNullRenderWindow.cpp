@@ -0,0 +1,181 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullRenderWindow.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Managers/BsRenderWindowManager.h"
+
+namespace bs
+{
+	NullRenderWindow::NullRenderWindow(const RENDER_WINDOW_DESC& desc, UINT32 windowId)
+		:RenderWindow(desc, windowId), mProperties(desc)
+	{ }
+
+	void NullRenderWindow::getCustomAttribute(const String& name, void* data) const
+	{
+		if (name == "WINDOW")
+		{
+			blockUntilCoreInitialized();
+			getCore()->getCustomAttribute(name, data);
+			return;
+		}
+	}
+
+	Vector2I NullRenderWindow::screenToWindowPos(const Vector2I& screenPos) const
+	{
+		return Vector2I(screenPos.x - mProperties.left, screenPos.y - mProperties.top);
+	}
+
+	Vector2I NullRenderWindow::windowToScreenPos(const Vector2I& windowPos) const
+	{
+		return Vector2I(windowPos.x + mProperties.left, windowPos.y + mProperties.top);
+	}
+
+	SPtr<ct::NullRenderWindow> NullRenderWindow::getCore() const
+	{
+		return std::static_pointer_cast<ct::NullRenderWindow>(mCoreSpecific);
+	}
+
+	SPtr<ct::CoreObject> NullRenderWindow::createCore() const
+	{
+		RENDER_WINDOW_DESC desc = mDesc;
+		SPtr<ct::CoreObject> coreObj = bs_shared_ptr_new<ct::NullRenderWindow>(desc, mWindowId);
+		coreObj->_setThisPtr(coreObj);
+
+		return coreObj;
+	}
+
+	void NullRenderWindow::syncProperties()
+	{
+		ScopedSpinLock lock(getCore()->_getPropertiesLock());
+		mProperties = getCore()->mSyncedProperties;
+	}
+
+	namespace ct
+	{
+	NullRenderWindow::NullRenderWindow(const RENDER_WINDOW_DESC& desc, UINT32 windowId)
+		: RenderWindow(desc, windowId), mProperties(desc), mSyncedProperties(desc)
+	{ }
+
+	void NullRenderWindow::initialize()
+	{
+		RenderWindowProperties& props = mProperties;
+
+		// There is no desktop to center on, so centered windows are placed at the origin instead
+		props.left = std::max(mDesc.left, 0);
+		props.top = std::max(mDesc.top, 0);
+		props.width = mDesc.videoMode.getWidth();
+		props.height = mDesc.videoMode.getHeight();
+		props.isFullScreen = mDesc.fullscreen;
+		props.isHidden = mDesc.hideUntilSwap || mDesc.hidden;
+		props.hwGamma = mDesc.gamma;
+		props.multisampleCount = mDesc.multisampleCount;
+		props.vsync = mDesc.vsync;
+		props.vsyncInterval = mDesc.vsyncInterval;
+
+		{
+			ScopedSpinLock lock(mLock);
+			mSyncedProperties = props;
+		}
+
+		bs::RenderWindowManager::instance().notifySyncDataDirty(this);
+		RenderWindow::initialize();
+	}
+
+	void NullRenderWindow::setFullscreen(UINT32 width, UINT32 height, float refreshRate, UINT32 monitorIdx)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		setArea(0, 0, width, height, true);
+	}
+
+	void NullRenderWindow::setFullscreen(const VideoMode& videoMode)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		setArea(0, 0, videoMode.getWidth(), videoMode.getHeight(), true);
+	}
+
+	void NullRenderWindow::setWindowed(UINT32 width, UINT32 height)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		setArea(mProperties.left, mProperties.top, width, height, false);
+	}
+
+	void NullRenderWindow::move(INT32 left, INT32 top)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (!mProperties.isFullScreen)
+			setArea(left, top, mProperties.width, mProperties.height, false);
+	}
+
+	void NullRenderWindow::resize(UINT32 width, UINT32 height)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (!mProperties.isFullScreen)
+			setArea(mProperties.left, mProperties.top, width, height, false);
+	}
+
+	void NullRenderWindow::setArea(INT32 left, INT32 top, UINT32 width, UINT32 height, bool fullscreen)
+	{
+		RenderWindowProperties& props = mProperties;
+		props.left = left;
+		props.top = top;
+		props.width = width;
+		props.height = height;
+		props.isFullScreen = fullscreen;
+
+		{
+			ScopedSpinLock lock(mLock);
+			mSyncedProperties.left = props.left;
+			mSyncedProperties.top = props.top;
+			mSyncedProperties.width = props.width;
+			mSyncedProperties.height = props.height;
+			mSyncedProperties.isFullScreen = props.isFullScreen;
+		}
+
+		bs::RenderWindowManager::instance().notifySyncDataDirty(this);
+		bs::RenderWindowManager::instance().notifyMovedOrResized(this);
+	}
+
+	void NullRenderWindow::setVSync(bool enabled, UINT32 interval)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if(!enabled)
+			interval = 0;
+
+		mProperties.vsync = enabled;
+		mProperties.vsyncInterval = interval;
+
+		{
+			ScopedSpinLock lock(mLock);
+			mSyncedProperties.vsync = enabled;
+			mSyncedProperties.vsyncInterval = interval;
+		}
+
+		bs::RenderWindowManager::instance().notifySyncDataDirty(this);
+	}
+
+	void NullRenderWindow::getCustomAttribute(const String& name, void* pData) const
+	{
+		// No native window exists, so a null handle is reported
+		if (name == "WINDOW")
+		{
+			UINT64* handle = (UINT64*)pData;
+			*handle = 0;
+			return;
+		}
+
+		RenderWindow::getCustomAttribute(name, pData);
+	}
+
+	void NullRenderWindow::syncProperties()
+	{
+		ScopedSpinLock lock(mLock);
+		mProperties = mSyncedProperties;
+	}
+	}
+}
@@ -0,0 +1,110 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullTexture.h"
+#include "BsNullRenderAPI.h"
+#include "Image/BsPixelUtil.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullTexture::NullTexture(const TEXTURE_DESC& desc, const SPtr<PixelData>& initialData, GpuDeviceFlags deviceMask)
+		: Texture(desc, initialData, deviceMask)
+	{
+		assert((deviceMask == GDF_DEFAULT || deviceMask == GDF_PRIMARY) && "Multiple GPUs not supported by the null render API.");
+	}
+
+	NullTexture::~NullTexture()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Texture);
+	}
+
+	void NullTexture::initialize()
+	{
+		mSurfaces.resize(mProperties.getNumFaces() * (mProperties.getNumMipmaps() + 1));
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Texture);
+		Texture::initialize();
+	}
+
+	PixelData& NullTexture::getSurface(UINT32 face, UINT32 mipLevel)
+	{
+		SPtr<PixelData>& surface = mSurfaces[face * (mProperties.getNumMipmaps() + 1) + mipLevel];
+		if (surface == nullptr)
+			surface = mProperties.allocBuffer(face, mipLevel);
+
+		return *surface;
+	}
+
+	PixelData NullTexture::lockImpl(GpuLockOptions options, UINT32 mipLevel, UINT32 face, UINT32 deviceIdx,
+		UINT32 queueIdx)
+	{
+		if (mProperties.getNumSamples() > 1)
+			BS_EXCEPT(InvalidStateException, "Multisampled textures cannot be accessed from the CPU directly.");
+
+		PixelData& surface = getSurface(face, mipLevel);
+		mLockedSize = surface.getSize();
+		mIsWriteLocked = options != GBL_READ_ONLY;
+
+		return surface;
+	}
+
+	void NullTexture::unlockImpl()
+	{
+		if (mIsWriteLocked)
+			gNullRenderAPI()._notifyBytesUploaded(mLockedSize);
+
+		mLockedSize = 0;
+		mIsWriteLocked = false;
+	}
+
+	void NullTexture::copyImpl(const SPtr<Texture>& target, const TEXTURE_COPY_DESC& desc, 
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullTexture* destTex = static_cast<NullTexture*>(target.get());
+
+		PixelData& srcSurface = getSurface(desc.srcFace, desc.srcMip);
+		PixelData& dstSurface = destTex->getSurface(desc.dstFace, desc.dstMip);
+
+		PixelVolume srcVolume = desc.srcVolume;
+		if (srcVolume.getWidth() == 0 || srcVolume.getHeight() == 0 || srcVolume.getDepth() == 0)
+			srcVolume = srcSurface.getExtents();
+
+		PixelVolume dstVolume(
+			desc.dstPosition.x, desc.dstPosition.y, desc.dstPosition.z,
+			desc.dstPosition.x + srcVolume.getWidth(), 
+			desc.dstPosition.y + srcVolume.getHeight(), 
+			desc.dstPosition.z + srcVolume.getDepth());
+
+		PixelData dst = dstSurface.getSubVolume(dstVolume);
+		PixelUtil::bulkPixelConversion(srcSurface.getSubVolume(srcVolume), dst);
+	}
+
+	void NullTexture::readDataImpl(PixelData& dest, UINT32 mipLevel, UINT32 face, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		if (mProperties.getNumSamples() > 1)
+		{
+			LOGERR("Multisampled textures cannot be accessed from the CPU directly.");
+			return;
+		}
+
+		PixelUtil::bulkPixelConversion(getSurface(face, mipLevel), dest);
+
+		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_Texture);
+	}
+
+	void NullTexture::writeDataImpl(const PixelData& src, UINT32 mipLevel, UINT32 face, bool discardWholeBuffer,
+		UINT32 queueIdx)
+	{
+		if (mProperties.getNumSamples() > 1)
+		{
+			LOGERR("Multisampled textures cannot be accessed from the CPU directly.");
+			return;
+		}
+
+		PixelData& surface = getSurface(face, mipLevel);
+		PixelUtil::bulkPixelConversion(src, surface);
+		gNullRenderAPI()._notifyBytesUploaded(src.getSize());
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_Texture);
+	}
+}}
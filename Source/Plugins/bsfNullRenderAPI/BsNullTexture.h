@@ -0,0 +1,61 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "Image/BsTexture.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**	
+	 * Null render API implementation of a texture. Each face and mip level is stored in CPU memory, allocated the first
+	 * time the surface is accessed.
+	 */
+	class NullTexture : public Texture
+	{
+	public:
+		~NullTexture();
+
+	protected:
+		friend class NullTextureManager;
+
+		NullTexture(const TEXTURE_DESC& desc, const SPtr<PixelData>& initialData, GpuDeviceFlags deviceMask);
+
+		/** @copydoc Texture::initialize */
+		void initialize() override;
+
+		/** @copydoc Texture::lock */
+		PixelData lockImpl(GpuLockOptions options, UINT32 mipLevel = 0, UINT32 face = 0, UINT32 deviceIdx = 0,
+						   UINT32 queueIdx = 0) override;
+
+		/** @copydoc Texture::unlock */
+		void unlockImpl() override;
+
+		/** @copydoc Texture::copyImpl */
+		void copyImpl(const SPtr<Texture>& target, const TEXTURE_COPY_DESC& desc, 
+			const SPtr<CommandBuffer>& commandBuffer) override;
+
+		/** @copydoc Texture::readData */
+		void readDataImpl(PixelData& dest, UINT32 mipLevel = 0, UINT32 face = 0, UINT32 deviceIdx = 0,
+					  UINT32 queueIdx = 0) override;
+
+		/** @copydoc Texture::writeData */
+		void writeDataImpl(const PixelData& src, UINT32 mipLevel = 0, UINT32 face = 0, bool discardWholeBuffer = false,
+					   UINT32 queueIdx = 0) override;
+
+		/** Returns the data of the specified face and mip level, allocating it if this is the first access. */
+		PixelData& getSurface(UINT32 face, UINT32 mipLevel);
+
+	private:
+		Vector<SPtr<PixelData>> mSurfaces;
+
+		UINT32 mLockedSize = 0;
+		bool mIsWriteLocked = false;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,41 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullTimerQuery.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullTimerQuery::NullTimerQuery(UINT32 deviceIdx)
+	{
+		assert(deviceIdx == 0 && "Multiple GPUs not supported by the null render API.");
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Query);
+	}
+
+	NullTimerQuery::~NullTimerQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Query);
+	}
+
+	void NullTimerQuery::begin(const SPtr<CommandBuffer>& cb)
+	{
+		mEndIssued = false;
+
+		setActive(true);
+	}
+
+	void NullTimerQuery::end(const SPtr<CommandBuffer>& cb)
+	{
+		mEndIssued = true;
+	}
+
+	bool NullTimerQuery::isReady() const
+	{
+		return mEndIssued;
+	}
+
+	float NullTimerQuery::getTimeMs()
+	{
+		return 0.0f;
+	}
+}}
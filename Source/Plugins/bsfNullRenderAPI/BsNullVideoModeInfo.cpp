@@ -0,0 +1,21 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullVideoModeInfo.h"
+
+namespace bs { namespace ct
+{
+	NullVideoModeInfo::NullVideoModeInfo()
+	{
+		// Report a single virtual output, as there are no physical outputs to enumerate
+		mOutputs.push_back(bs_new<NullVideoOutputInfo>());
+	}
+
+	NullVideoOutputInfo::NullVideoOutputInfo()
+	{
+		mName = "Null";
+
+		VideoMode* videoMode = bs_new<VideoMode>(1920, 1080, 60.0f, 0);
+		mVideoModes.push_back(videoMode);
+		mDesktopVideoMode = bs_new<VideoMode>(*videoMode);
+	}
+}}
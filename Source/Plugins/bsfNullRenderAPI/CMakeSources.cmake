@@ -0,0 +1,65 @@
+set(BS_NULLRENDERAPI_INC_NOFILTER
+	"BsNullVideoModeInfo.h"
+	"BsNullVertexBuffer.h"
+	"BsNullTimerQuery.h"
+	"BsNullTextureManager.h"
+	"BsNullTexture.h"
+	"BsNullRenderWindowManager.h"
+	"BsNullRenderWindow.h"
+	"BsNullRenderTexture.h"
+	"BsNullRenderAPIFactory.h"
+	"BsNullRenderAPI.h"
+	"BsNullQueryManager.h"
+	"BsNullPrerequisites.h"
+	"BsNullOcclusionQuery.h"
+	"BsNullIndexBuffer.h"
+	"BsNullHardwareBufferManager.h"
+	"BsNullGpuProgram.h"
+	"BsNullGpuParamBlockBuffer.h"
+	"BsNullGpuBuffer.h"
+	"BsNullEventQuery.h"
+	"BsNullCommandBufferManager.h"
+	"BsNullCommandBuffer.h"
+	"BsNullBuffer.h"
+)
+
+set(BS_NULLRENDERAPI_SRC_NOFILTER
+	"BsNullVideoModeInfo.cpp"
+	"BsNullVertexBuffer.cpp"
+	"BsNullTimerQuery.cpp"
+	"BsNullTextureManager.cpp"
+	"BsNullTexture.cpp"
+	"BsNullRenderWindowManager.cpp"
+	"BsNullRenderWindow.cpp"
+	"BsNullRenderTexture.cpp"
+	"BsNullRenderAPIFactory.cpp"
+	"BsNullRenderAPI.cpp"
+	"BsNullQueryManager.cpp"
+	"BsNullPlugin.cpp"
+	"BsNullOcclusionQuery.cpp"
+	"BsNullIndexBuffer.cpp"
+	"BsNullHardwareBufferManager.cpp"
+	"BsNullGpuProgram.cpp"
+	"BsNullGpuParamBlockBuffer.cpp"
+	"BsNullGpuBuffer.cpp"
+	"BsNullEventQuery.cpp"
+	"BsNullCommandBufferManager.cpp"
+	"BsNullCommandBuffer.cpp"
+	"BsNullBuffer.cpp"
+)
+
+set(BS_NULLRENDERAPI_INC_GLSLANG
+	"../bsfVulkanRenderAPI/BsGLSLangReflection.h"
+)
+
+set(BS_NULLRENDERAPI_SRC_GLSLANG
+	"../bsfVulkanRenderAPI/BsGLSLangReflection.cpp"
+)
+
+source_group("" FILES ${BS_NULLRENDERAPI_SRC_NOFILTER} ${BS_NULLRENDERAPI_INC_NOFILTER})
+source_group("GLSLang" FILES ${BS_NULLRENDERAPI_INC_GLSLANG} ${BS_NULLRENDERAPI_SRC_GLSLANG})
+
+set(BS_NULLRENDERAPI_SRC
+	${BS_NULLRENDERAPI_INC_NOFILTER}
+	${BS_NULLRENDERAPI_SRC_NOFILTER}
+)
\ No newline at end of file
@@ -18,12 +18,15 @@
 #include "BsPhysXD6Joint.h"
 #include "BsPhysXCharacterController.h"
 #include "Threading/BsTaskScheduler.h"
+#include "Threading/BsJobScheduler.h"
+#include "Profiling/BsProfilerCPU.h"
 #include "Components/BsCCollider.h"
 #include "BsFPhysXCollider.h"
 #include "Utility/BsTime.h"
 #include "Math/BsVector3.h"
 #include "Math/BsAABox.h"
 #include "Math/BsCapsule.h"
+#include "Math/BsRay.h"
 #include "foundation/PxTransform.h"
 
 using namespace physx;
@@ -284,28 +287,74 @@ namespace bs
 		}
 	};
 
+	/**
+	 * Dispatches PhysX tasks to the engine's job scheduler. Jobs are allocated from preallocated per-thread pools and
+	 * submitted through lock-free queues, and are executed by the same worker threads as the rest of the engine. Keeps
+	 * track of the latency between a task being submitted and it starting execution.
+	 */
 	class PhysXCPUDispatcher : public PxCpuDispatcher
 	{
+		/** Data stored within the job payload for a single PhysX task. */
+		struct TaskData
+		{
+			PxBaseTask* task;
+			UINT64 submitTime;
+		};
+
 	public:
 		void submitTask(PxBaseTask& physxTask) override
 		{
-			// Note: Banshee's task scheduler is pretty low granularity. Consider a better task manager in case PhysX ends
-			// up submitting many tasks.
-			// - PhysX's task manager doesn't seem much lighter either. But perhaps I can at least create a task pool to 
-			//   avoid allocating them constantly.
+			if(!JobScheduler::isStarted())
+			{
+				auto runTask = [&]() { physxTask.run(); physxTask.release(); };
+				TaskScheduler::instance().addTask(Task::create("PhysX", runTask));
 
-			auto runTask = [&]() { physxTask.run(); physxTask.release(); };
-			SPtr<Task> task = Task::create("PhysX", runTask);
+				return;
+			}
+
+			TaskData data;
+			data.task = &physxTask;
+			data.submitTime = gTime().getTimePrecise();
 
-			TaskScheduler::instance().addTask(task);
+			JobScheduler& scheduler = JobScheduler::instance();
+			scheduler.run(scheduler.createJob(&runTask, data));
 		}
 
 		PxU32 getWorkerCount() const override
 		{
-			return (PxU32)TaskScheduler::instance().getNumWorkers();
+			if(!JobScheduler::isStarted())
+				return (PxU32)TaskScheduler::instance().getNumWorkers();
+
+			return (PxU32)JobScheduler::instance().getNumActiveWorkers();
 		}
+
+		/**
+		 * Reports the dispatch latency of the tasks executed since the last call to the CPU profiler, and resets the
+		 * measurements. Should be called once per simulation step.
+		 */
+		void reportLatency()
+		{
+			const UINT64 numTasks = mNumTasks.exchange(0, std::memory_order_relaxed);
+			const UINT64 totalLatency = mTotalLatency.exchange(0, std::memory_order_relaxed);
+			const UINT64 maxLatency = mMaxLatency.exchange(0, std::memory_order_relaxed);
+
+			if(numTasks == 0 || !ProfilerCPU::isStarted())
+				return;
+
+			gProfilerCPU().addSample("PhysX dispatch latency (avg)", totalLatency / (double)numTasks * 1e-3);
+			gProfilerCPU().addSample("PhysX dispatch latency (max)", maxLatency * 1e-3);
+		}
+
+	private:
+		/** Job function executing a single PhysX task. */
+		static void runTask(Job* job, const void* data);
+
+		std::atomic<UINT64> mNumTasks{0};
+		std::atomic<UINT64> mTotalLatency{0}; // In microseconds
+		std::atomic<UINT64> mMaxLatency{0}; // In microseconds
 	};
 
+
 	class PhysXBroadPhaseCallback : public PxBroadPhaseCallback
 	{
 		void onObjectOutOfBounds(PxShape& shape, PxActor& actor) override
@@ -352,6 +401,40 @@ namespace bs
 		return PxFilterFlags();
 	}
 
+	/** Maximum number of queries processed by a single job when executing a batch of scene queries. */
+	static constexpr UINT32 BATCH_QUERY_GRANULARITY = 256;
+
+	/**
+	 * Executes a batch of @p count scene queries, splitting it into chunks executed in parallel on the job scheduler
+	 * workers if the batch is large enough. @p query is called with the index of each query, and should return true if
+	 * the query hit something. Returns the number of queries that hit something.
+	 */
+	template<class F>
+	UINT32 executeBatch(UINT32 count, const F& query)
+	{
+		if(count <= BATCH_QUERY_GRANULARITY || !JobScheduler::isStarted())
+		{
+			UINT32 numHits = 0;
+			for(UINT32 i = 0; i < count; i++)
+				numHits += query(i) ? 1 : 0;
+
+			return numHits;
+		}
+
+		std::atomic<UINT32> numHits{0};
+		auto executeChunk = [&query, &numHits](UINT32 start, UINT32 chunkCount)
+		{
+			UINT32 chunkHits = 0;
+			for(UINT32 i = start; i < start + chunkCount; i++)
+				chunkHits += query(i) ? 1 : 0;
+
+			numHits.fetch_add(chunkHits, std::memory_order_relaxed);
+		};
+
+		JobScheduler::instance().parallelForAndWait(count, BATCH_QUERY_GRANULARITY, executeChunk);
+		return numHits.load(std::memory_order_relaxed);
+	}
+
 	void parseHit(const PxRaycastHit& input, PhysicsQueryHit& output)
 	{
 		output.point = fromPxVector(input.position);
@@ -458,6 +541,23 @@ namespace bs
 	static PhysXEventCallback gPhysXEventCallback;
 	static PhysXBroadPhaseCallback gPhysXBroadphaseCallback;
 
+	void PhysXCPUDispatcher::runTask(Job* job, const void* data)
+	{
+		const TaskData& taskData = *(const TaskData*)data;
+
+		const UINT64 latency = gTime().getTimePrecise() - taskData.submitTime;
+		gPhysXCPUDispatcher.mNumTasks.fetch_add(1, std::memory_order_relaxed);
+		gPhysXCPUDispatcher.mTotalLatency.fetch_add(latency, std::memory_order_relaxed);
+
+		UINT64 maxLatency = gPhysXCPUDispatcher.mMaxLatency.load(std::memory_order_relaxed);
+		while(latency > maxLatency &&
+			!gPhysXCPUDispatcher.mMaxLatency.compare_exchange_weak(maxLatency, latency, std::memory_order_relaxed))
+		{ }
+
+		taskData.task->run();
+		taskData.task->release();
+	}
+
 	static const UINT32 SIZE_16K = 1 << 14;
 	const UINT32 PhysX::SCRATCH_BUFFER_SIZE = SIZE_16K * 64; // 1MB by default
 
@@ -503,10 +603,17 @@ namespace bs
 		mCharManager = PxCreateControllerManager(*mScene);
 
 		mDefaultMaterial = mPhysics->createMaterial(1.0f, 1.0f, 0.5f);
+
+		// Note: Allocated persistently, rather than from the frame allocator, as a pipelined simulation step outlives
+		//       the frame it was started in
+		mScratchBuffer = (UINT8*)bs_alloc_aligned16(SCRATCH_BUFFER_SIZE);
 	}
 
 	PhysX::~PhysX()
 	{
+		if (mSimulationInProgress)
+			mScene->fetchResults(true);
+
 		mCharManager->release();
 		mScene->release();
 
@@ -515,28 +622,75 @@ namespace bs
 
 		mPhysics->release();
 		mFoundation->release();
+
+		bs_free_aligned16(mScratchBuffer);
 	}
 
 	void PhysX::fixedUpdate(float step)
 	{
+		// Retrieve the results of the step started during the previous fixed update, if simulation is pipelined
+		if (mSimulationInProgress)
+			fetchResults();
+
 		if (mPaused)
 			return;
 
-		mUpdateInProgress = true;
+		mScene->simulate(step, nullptr, mScratchBuffer, SCRATCH_BUFFER_SIZE);
+		mSimulationInProgress = true;
+
+		if (mFlags.isSet(PhysicsFlag::Pipelined))
+		{
+			// The next fetch happens one step from now, which is the period the transforms are interpolated over
+			mInterpolationStep = step;
+			return;
+		}
 
-		// Note: Consider delaying fetchResults one frame. This could improve performance because Physics update would be
-		//       able to run parallel to the simulation thread, but at a cost to input latency.
-		bs_frame_mark();
-		UINT8* scratchBuffer = bs_frame_alloc_aligned(SCRATCH_BUFFER_SIZE, 16);
+		fetchResults();
+	}
 
-		mScene->simulate(step, nullptr, scratchBuffer, SCRATCH_BUFFER_SIZE);
+	void PhysX::fetchResults()
+	{
+		mUpdateInProgress = true;
 
 		UINT32 errorState;
 		if (!mScene->fetchResults(true, &errorState))
 			LOGWRN("Physics simulation failed. Error code: " + toString(errorState));
 
-		bs_frame_free_aligned(scratchBuffer);
-		bs_frame_clear();
+		mSimulationInProgress = false;
+		gPhysXCPUDispatcher.reportLatency();
+
+		const bool interpolate = mFlags.isSet(PhysicsFlag::Pipelined);
+		if (interpolate)
+		{
+			// Rigidbodies that weren't moved by the step before this one have already reached their final transform
+			for (UINT32 i = 0; i < (UINT32)mInterpolatedPoses.size();)
+			{
+				InterpolatedPose& pose = mInterpolatedPoses[i];
+				if (!pose.active)
+				{
+					pose.rigidbody->_setTransform(pose.position, pose.rotation);
+
+					mInterpolatedPoseLookup.erase(pose.rigidbody);
+					if (i != (UINT32)mInterpolatedPoses.size() - 1)
+					{
+						pose = mInterpolatedPoses.back();
+						mInterpolatedPoseLookup[pose.rigidbody] = i;
+					}
+
+					mInterpolatedPoses.pop_back();
+					continue;
+				}
+
+				pose.prevPosition = pose.position;
+				pose.prevRotation = pose.rotation;
+				pose.active = false;
+				i++;
+			}
+
+			mLastFetchTime = gTime().getTimePrecise();
+		}
+		else
+			clearInterpolation();
 
 		// Update rigidbodies with new transforms
 		PxU32 numActiveTransforms;
@@ -556,7 +710,10 @@ namespace bs
 
 			// Note: Make this faster, avoid dereferencing Rigidbody and attempt to access pos/rot destination directly,
 			//       use non-temporal writes
-			rigidbody->_setTransform(fromPxVector(transform.p), fromPxQuaternion(transform.q));
+			if (interpolate)
+				setInterpolationTarget(rigidbody, fromPxVector(transform.p), fromPxQuaternion(transform.q));
+			else
+				rigidbody->_setTransform(fromPxVector(transform.p), fromPxQuaternion(transform.q));
 		}
 
 		// Note: Consider extrapolating for the remaining "simulationAmount" value
@@ -567,7 +724,72 @@ namespace bs
 
 	void PhysX::update()
 	{
-		// Note: Potentially interpolate (would mean a one frame delay needs to be introduced)
+		if (mInterpolatedPoses.empty())
+			return;
+
+		float t = 1.0f;
+		if (mInterpolationStep > 0.0f)
+		{
+			const float elapsed = (gTime().getTimePrecise() - mLastFetchTime) / 1000000.0f;
+			t = Math::clamp01(elapsed / mInterpolationStep);
+		}
+
+		mUpdateInProgress = true;
+
+		for (auto& pose : mInterpolatedPoses)
+		{
+			const Vector3 position = Math::lerp(t, pose.prevPosition, pose.position);
+			const Quaternion rotation = Quaternion::slerp(t, pose.prevRotation, pose.rotation);
+
+			pose.rigidbody->_setTransform(position, rotation);
+		}
+
+		mUpdateInProgress = false;
+	}
+
+	void PhysX::setInterpolationTarget(Rigidbody* rigidbody, const Vector3& position, const Quaternion& rotation)
+	{
+		const auto iterFind = mInterpolatedPoseLookup.find(rigidbody);
+		if (iterFind != mInterpolatedPoseLookup.end())
+		{
+			InterpolatedPose& pose = mInterpolatedPoses[iterFind->second];
+			pose.position = position;
+			pose.rotation = rotation;
+			pose.active = true;
+		}
+		else
+		{
+			// No previous transform is known, so the rigidbody starts interpolating from the new one
+			mInterpolatedPoseLookup[rigidbody] = (UINT32)mInterpolatedPoses.size();
+			mInterpolatedPoses.push_back({ rigidbody, position, rotation, position, rotation, true });
+		}
+	}
+
+	void PhysX::clearInterpolation()
+	{
+		for (auto& pose : mInterpolatedPoses)
+			pose.rigidbody->_setTransform(pose.position, pose.rotation);
+
+		mInterpolatedPoses.clear();
+		mInterpolatedPoseLookup.clear();
+	}
+
+	void PhysX::_clearInterpolation(Rigidbody* rigidbody)
+	{
+		const auto iterFind = mInterpolatedPoseLookup.find(rigidbody);
+		if (iterFind == mInterpolatedPoseLookup.end())
+			return;
+
+		const UINT32 idx = iterFind->second;
+		mInterpolatedPoseLookup.erase(iterFind);
+
+		if (idx != (UINT32)mInterpolatedPoses.size() - 1)
+		{
+			mInterpolatedPoses[idx] = mInterpolatedPoses.back();
+			mInterpolatedPoseLookup[mInterpolatedPoses[idx].rigidbody] = idx;
+		}
+
+		mInterpolatedPoses.pop_back();
 	}
 
 	void PhysX::_reportContactEvent(const ContactEvent& event)
@@ -1046,6 +1268,49 @@ namespace bs
 		return overlapAny(geometry, transform, layer);
 	}
 
+	UINT32 PhysX::rayCastBatch(const Ray* rays, UINT32 count, PhysicsQueryHit* hits, UINT64 layer, float max) const
+	{
+		return executeBatch(count, [&](UINT32 i)
+		{
+			if(rayCast(rays[i].getOrigin(), rays[i].getDirection(), hits[i], layer, max))
+				return true;
+
+			hits[i] = PhysicsQueryHit();
+			return false;
+		});
+	}
+
+	UINT32 PhysX::rayCastAnyBatch(const Ray* rays, UINT32 count, bool* results, UINT64 layer, float max) const
+	{
+		return executeBatch(count, [&](UINT32 i)
+		{
+			results[i] = rayCastAny(rays[i].getOrigin(), rays[i].getDirection(), layer, max);
+			return results[i];
+		});
+	}
+
+	UINT32 PhysX::sphereCastBatch(const Sphere* spheres, const Vector3* unitDirs, UINT32 count, PhysicsQueryHit* hits,
+		UINT64 layer, float max) const
+	{
+		return executeBatch(count, [&](UINT32 i)
+		{
+			if(sphereCast(spheres[i], unitDirs[i], hits[i], layer, max))
+				return true;
+
+			hits[i] = PhysicsQueryHit();
+			return false;
+		});
+	}
+
+	UINT32 PhysX::sphereOverlapAnyBatch(const Sphere* spheres, UINT32 count, bool* results, UINT64 layer) const
+	{
+		return executeBatch(count, [&](UINT32 i)
+		{
+			results[i] = sphereOverlapAny(spheres[i], layer);
+			return results[i];
+		});
+	}
+
 	bool PhysX::_rayCast(const Vector3& origin, const Vector3& unitDir, const Collider& collider, PhysicsQueryHit& hit,
 		float maxDist) const
 	{
@@ -51,6 +51,17 @@ namespace bs
 			Joint* joint; /** Broken joint. */
 		};
 
+		/** Transforms of a rigidbody after the two most recent simulation steps, used for pipelined simulation. */
+		struct InterpolatedPose
+		{
+			Rigidbody* rigidbody;
+			Vector3 prevPosition;
+			Quaternion prevRotation;
+			Vector3 position;
+			Quaternion rotation;
+			bool active; /** True if the rigidbody moved during the most recent simulation step. */
+		};
+
 	public:
 		PhysX(const PHYSICS_INIT_DESC& input);
 		~PhysX();
@@ -183,6 +194,22 @@ namespace bs
 		bool convexOverlapAny(const HPhysicsMesh& mesh, const Vector3& position, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const override;
 
+		/** @copydoc Physics::rayCastBatch */
+		UINT32 rayCastBatch(const Ray* rays, UINT32 count, PhysicsQueryHit* hits, UINT64 layer = BS_ALL_LAYERS,
+			float max = FLT_MAX) const override;
+
+		/** @copydoc Physics::rayCastAnyBatch */
+		UINT32 rayCastAnyBatch(const Ray* rays, UINT32 count, bool* results, UINT64 layer = BS_ALL_LAYERS,
+			float max = FLT_MAX) const override;
+
+		/** @copydoc Physics::sphereCastBatch */
+		UINT32 sphereCastBatch(const Sphere* spheres, const Vector3* unitDirs, UINT32 count, PhysicsQueryHit* hits,
+			UINT64 layer = BS_ALL_LAYERS, float max = FLT_MAX) const override;
+
+		/** @copydoc Physics::sphereOverlapAnyBatch */
+		UINT32 sphereOverlapAnyBatch(const Sphere* spheres, UINT32 count, bool* results,
+			UINT64 layer = BS_ALL_LAYERS) const override;
+
 		/** @copydoc Physics::setFlag */
 		void setFlag(PhysicsFlags flags, bool enabled) override;
 
@@ -238,6 +265,12 @@ namespace bs
 		/** Triggered by the PhysX simulation when a joint breaks. */
 		void _reportJointBreakEvent(const JointBreakEvent& event);
 
+		/** 
+		 * Stops interpolating the transform of the provided rigidbody. Must be called when the rigidbody is destroyed or
+		 * its transform is set externally.
+		 */
+		void _clearInterpolation(Rigidbody* rigidbody);
+
 		/** Returns the default PhysX material. */
 		physx::PxMaterial* getDefaultMaterial() const { return mDefaultMaterial; }
 
@@ -259,6 +292,21 @@ namespace bs
 		/** Sends out all events recorded during simulation to the necessary physics objects. */
 		void triggerEvents();
 
+		/** 
+		 * Blocks until the simulation step in progress completes, then updates the rigidbodies with the new transforms
+		 * and sends out the recorded events.
+		 */
+		void fetchResults();
+
+		/** 
+		 * Records the transform of a rigidbody after the simulation step that just completed, to be interpolated towards
+		 * by update().
+		 */
+		void setInterpolationTarget(Rigidbody* rigidbody, const Vector3& position, const Quaternion& rotation);
+
+		/** Applies the final transforms to all interpolated rigidbodies, and stops interpolating them. */
+		void clearInterpolation();
+
 		/**
 		 * Helper method that performs a sweep query by checking if the provided geometry hits any physics objects
 		 * when moved along the specified direction. Returns information about the first hit.
@@ -291,6 +339,13 @@ namespace bs
 		float mTesselationLength = 3.0f;
 		UINT32 mNextRegionIdx = 1;
 		bool mPaused = false;
+		bool mSimulationInProgress = false;
+
+		UINT8* mScratchBuffer = nullptr;
+		float mInterpolationStep = 0.0f;
+		UINT64 mLastFetchTime = 0;
+		Vector<InterpolatedPose> mInterpolatedPoses;
+		UnorderedMap<Rigidbody*, UINT32> mInterpolatedPoseLookup;
 
 		Vector<TriggerEvent> mTriggerEvents;
 		Vector<ContactEvent> mContactEvents;
@@ -59,6 +59,8 @@ namespace bs
 
 	PhysXRigidbody::~PhysXRigidbody()
 	{
+		gPhysX()._clearInterpolation(this);
+
 		mInternal->userData = nullptr;
 		mInternal->release();
 	}
@@ -111,6 +113,7 @@ namespace bs
 
 	void PhysXRigidbody::setTransform(const Vector3& pos, const Quaternion& rot)
 	{
+		gPhysX()._clearInterpolation(this);
 		mInternal->setGlobalPose(toPxTransform(pos, rot));
 	}
 
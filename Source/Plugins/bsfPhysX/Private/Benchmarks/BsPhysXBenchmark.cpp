@@ -0,0 +1,259 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsPhysX.h"
+#include "PxPhysicsAPI.h"
+#include "Physics/BsBoxCollider.h"
+#include "Physics/BsRigidbody.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Scene/BsSceneManager.h"
+#include "Scene/BsSceneObject.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Threading/BsJobScheduler.h"
+#include "Threading/BsThreadPool.h"
+#include "Utility/BsTime.h"
+#include "Math/BsRay.h"
+#include "Math/BsRandom.h"
+
+#include <iostream>
+#include <iomanip>
+
+using namespace bs;
+using namespace physx;
+
+namespace
+{
+	/** Number of dynamic rigidbodies in the benchmark scene. */
+	constexpr UINT32 NUM_BODIES = 5000;
+
+	/** Number of boxes stacked on top of each other in a single column. */
+	constexpr UINT32 COLUMN_HEIGHT = 10;
+
+	/** Number of frames simulated per measurement. */
+	constexpr UINT32 NUM_FRAMES = 300;
+
+	/** Length of a single simulation step (and a single frame), in seconds. */
+	constexpr float FIXED_STEP = 1.0f / 60.0f;
+
+	/** Time spent on gameplay logic every frame, in microseconds. A pipelined simulation step runs during this time. */
+	constexpr UINT64 GAMEPLAY_TIME = 4000;
+
+	/** Number of raycasts performed per frame by the query benchmark. */
+	constexpr UINT32 NUM_RAYS = 20000;
+
+	/** Number of times the query benchmark casts all the rays. */
+	constexpr UINT32 NUM_QUERY_ITERATIONS = 20;
+
+	/** Objects making up the benchmark scene. */
+	struct BenchmarkScene
+	{
+		PxRigidStatic* ground = nullptr;
+		Vector<HSceneObject> objects;
+		Vector<SPtr<Rigidbody>> bodies;
+		Vector<SPtr<BoxCollider>> colliders;
+	};
+
+	/** 
+	 * Creates a ground plane with columns of boxes stacked on top of it. Boxes are rigidbodies linked to scene objects,
+	 * same as the ones created by the rigidbody component, so the physics system updates their scene object transforms.
+	 */
+	BenchmarkScene createScene()
+	{
+		PxPhysics& physics = *gPhysX().getPhysX();
+		PxScene& scene = *gPhysX().getScene();
+		PxMaterial& material = *gPhysX().getDefaultMaterial();
+
+		BenchmarkScene output;
+
+		output.ground = PxCreatePlane(physics, PxPlane(0.0f, 1.0f, 0.0f, 0.0f), material);
+		scene.addActor(*output.ground);
+
+		const UINT32 numColumns = NUM_BODIES / COLUMN_HEIGHT;
+		const UINT32 rowLength = (UINT32)std::ceil(std::sqrt((float)numColumns));
+		for(UINT32 i = 0; i < NUM_BODIES; i++)
+		{
+			const UINT32 column = i / COLUMN_HEIGHT;
+			const UINT32 level = i % COLUMN_HEIGHT;
+
+			// Small offsets between the levels make the stacks topple over, keeping the bodies awake
+			const Vector3 position(
+				(column % rowLength) * 1.5f + level * 0.05f,
+				0.5f + level * 1.05f,
+				(column / rowLength) * 1.5f);
+
+			HSceneObject so = SceneObject::create("Box");
+			so->setWorldPosition(position);
+
+			SPtr<Rigidbody> body = Rigidbody::create(so);
+			SPtr<BoxCollider> collider = BoxCollider::create(Vector3(0.5f, 0.5f, 0.5f));
+
+			collider->setRigidbody(body.get());
+			body->addCollider(collider->_getInternal());
+
+			body->setMass(1.0f);
+			body->setFlags(RigidbodyFlag::AutoTensors);
+			body->updateMassDistribution();
+
+			output.objects.push_back(so);
+			output.bodies.push_back(body);
+			output.colliders.push_back(collider);
+		}
+
+		return output;
+	}
+
+	/** Keeps the calling thread busy for the specified number of microseconds, standing in for gameplay logic. */
+	void busyWait(UINT64 duration)
+	{
+		const UINT64 start = gTime().getTimePrecise();
+		while(gTime().getTimePrecise() - start < duration)
+		{ }
+	}
+
+	/** Releases all objects created by createScene(). */
+	void destroyScene(BenchmarkScene& scene)
+	{
+		// Releasing the bodies detaches the collider shapes, so they need to go first
+		scene.bodies.clear();
+		scene.colliders.clear();
+
+		for(auto& so : scene.objects)
+			so->destroy(true);
+
+		scene.objects.clear();
+
+		scene.ground->release();
+		scene.ground = nullptr;
+	}
+
+	/**
+	 * Simulates the benchmark scene for a number of frames. Returns the average time the main thread spends in the
+	 * physics updates per frame, in microseconds.
+	 */
+	double runFrames(bool pipelined)
+	{
+		gPhysics().setFlag(PhysicsFlag::Pipelined, pipelined);
+		BenchmarkScene scene = createScene();
+
+		UINT64 physicsTime = 0;
+		for(UINT32 i = 0; i < NUM_FRAMES; i++)
+		{
+			UINT64 start = gTime().getTimePrecise();
+			gPhysics().fixedUpdate(FIXED_STEP);
+			physicsTime += gTime().getTimePrecise() - start;
+
+			busyWait(GAMEPLAY_TIME);
+
+			start = gTime().getTimePrecise();
+			gPhysics().update();
+			physicsTime += gTime().getTimePrecise() - start;
+		}
+
+		// Retrieve the results of the step in progress, if any, before releasing the actors
+		gPhysics().setPaused(true);
+		gPhysics().fixedUpdate(FIXED_STEP);
+		gPhysics().setPaused(false);
+
+		destroyScene(scene);
+		return physicsTime / (double)NUM_FRAMES;
+	}
+
+	/** Throughput of the query benchmark for both query paths, in rays per millisecond. */
+	struct QueryResults
+	{
+		double perCall;
+		double batched;
+	};
+
+	/** Casts random rays into a settled benchmark scene, one at a time and in batches, and measures throughput. */
+	QueryResults runQueries()
+	{
+		BenchmarkScene scene = createScene();
+
+		// Let the stacks settle so the queries are performed against a typical scene
+		for(UINT32 i = 0; i < 60; i++)
+			gPhysics().fixedUpdate(FIXED_STEP);
+
+		gPhysics().setPaused(true);
+		gPhysics().fixedUpdate(FIXED_STEP);
+		gPhysics().setPaused(false);
+
+		Random random(1);
+		Vector<Ray> rays(NUM_RAYS);
+		for(auto& ray : rays)
+		{
+			const Vector3 origin(-10.0f + random.getUNorm() * 50.0f, 0.5f + random.getUNorm() * 10.0f,
+				-10.0f + random.getUNorm() * 50.0f);
+
+			ray = Ray(origin, random.getUnitVector());
+		}
+
+		Vector<PhysicsQueryHit> hits(NUM_RAYS);
+
+		UINT32 perCallHits = 0;
+		UINT64 start = gTime().getTimePrecise();
+		for(UINT32 i = 0; i < NUM_QUERY_ITERATIONS; i++)
+		{
+			for(UINT32 j = 0; j < NUM_RAYS; j++)
+				perCallHits += gPhysics().rayCast(rays[j], hits[j], BS_ALL_LAYERS, 100.0f) ? 1 : 0;
+		}
+		const UINT64 perCallTime = gTime().getTimePrecise() - start;
+
+		UINT32 batchedHits = 0;
+		start = gTime().getTimePrecise();
+		for(UINT32 i = 0; i < NUM_QUERY_ITERATIONS; i++)
+			batchedHits += gPhysics().rayCastBatch(rays.data(), NUM_RAYS, hits.data(), BS_ALL_LAYERS, 100.0f);
+		const UINT64 batchedTime = gTime().getTimePrecise() - start;
+
+		if(perCallHits != batchedHits)
+			std::cout << "Warning: per-call and batched queries reported a different number of hits." << std::endl;
+
+		destroyScene(scene);
+
+		const double numRays = (double)NUM_RAYS * NUM_QUERY_ITERATIONS;
+		return { numRays / (perCallTime / 1000.0), numRays / (batchedTime / 1000.0) };
+	}
+}
+
+int main()
+{
+	const UINT32 numWorkers = std::max((UINT32)BS_THREAD_HARDWARE_CONCURRENCY, 1U);
+	ThreadPool::startUp<TThreadPool<>>(numWorkers, numWorkers + 16);
+	TaskScheduler::startUp();
+	JobScheduler::startUp();
+	Time::startUp();
+	GameObjectManager::startUp();
+	SceneManager::startUp();
+
+	PHYSICS_INIT_DESC desc;
+	desc.initCooking = false;
+	Physics::startUp<PhysX>(desc);
+
+	const double blockingTime = runFrames(false);
+	const double pipelinedTime = runFrames(true);
+
+	std::cout << NUM_BODIES << " rigidbodies, " << GAMEPLAY_TIME << "us of gameplay per frame" << std::endl;
+	std::cout << std::left << std::setw(16) << "Mode" << "Main thread (us/frame)" << std::endl;
+	std::cout << std::left << std::setw(16) << "Blocking" << std::fixed << std::setprecision(1) << blockingTime
+		<< std::endl;
+	std::cout << std::left << std::setw(16) << "Pipelined" << std::fixed << std::setprecision(1) << pipelinedTime
+		<< std::endl;
+
+	const QueryResults queryResults = runQueries();
+
+	std::cout << std::endl << NUM_RAYS << " raycasts per iteration" << std::endl;
+	std::cout << std::left << std::setw(16) << "Mode" << "Rays/ms" << std::endl;
+	std::cout << std::left << std::setw(16) << "Per-call" << std::fixed << std::setprecision(1)
+		<< queryResults.perCall << std::endl;
+	std::cout << std::left << std::setw(16) << "Batched" << std::fixed << std::setprecision(1)
+		<< queryResults.batched << std::endl;
+
+	Physics::shutDown();
+	SceneManager::shutDown();
+	GameObjectManager::shutDown();
+	Time::shutDown();
+	JobScheduler::shutDown();
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+
+	return 0;
+}
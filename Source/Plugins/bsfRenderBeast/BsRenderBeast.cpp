@@ -233,10 +233,15 @@ namespace bs { namespace ct
 		if (filteringChanged)
 			mScene->refreshSamplerOverrides(true);
 
+		bool instancingChanged = mCoreOptions->instancing != options.instancing;
+
 		*mCoreOptions = options;
 
 		mScene->setOptions(mCoreOptions);
 
+		if (instancingChanged)
+			mScene->refreshInstancing();
+
 		ShadowRendering& shadowRenderer = mMainViewGroup->getShadowRenderer();
 		shadowRenderer.setShadowMapSize(mCoreOptions->shadowMapSize);
 	}
@@ -377,6 +382,8 @@ namespace bs { namespace ct
 		shadowRenderer.renderShadowMaps(*mScene, viewGroup, frameInfo);
 
 		// Update various buffers required by each renderable
+		gProfilerCPU().beginSample("PrepareRenderables");
+
 		UINT32 numRenderables = (UINT32)sceneInfo.renderables.size();
 		for (UINT32 i = 0; i < numRenderables; i++)
 		{
@@ -386,6 +393,8 @@ namespace bs { namespace ct
 			mScene->prepareRenderable(i, frameInfo);
 		}
 
+		gProfilerCPU().endSample("PrepareRenderables");
+
 		UINT32 numViews = viewGroup.getNumViews();
 		for (UINT32 i = 0; i < numViews; i++)
 		{
@@ -444,9 +453,13 @@ namespace bs { namespace ct
 			}
 		}
 
+		gProfilerCPU().beginSample("Compositor");
+
 		const RenderCompositor& compositor = view.getCompositor();
 		compositor.execute(inputs);
 
+		gProfilerCPU().endSample("Compositor");
+
 		view.endFrame();
 
 		gProfilerCPU().endSample("Render");
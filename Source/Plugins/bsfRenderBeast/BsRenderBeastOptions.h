@@ -43,6 +43,15 @@ namespace bs { namespace ct
 		 * shadows far away, but will never increase the resolution past the provided value.
 		 */
 		UINT32 shadowMapSize = 2048;
+
+		/**
+		 * When enabled, opaque elements rendered using the deferred pipeline that share the same mesh, material and pass
+		 * are merged into a single instanced draw call. Only elements in the same run of sorted render queue entries using
+		 * the same shader pass are merged. Each merged batch is rendered at the position of its first element, trading
+		 * some of the distance ordering for a lower number of draw calls. Only applies to elements without animation, using
+		 * materials whose shaders support the INSTANCED variation.
+		 */
+		bool instancing = false;
 	};
 
 	/** @} */
@@ -21,9 +21,14 @@
 #include "BsRenderBeastOptions.h"
 #include "BsRendererScene.h"
 #include "BsRenderBeast.h"
+#include "Threading/BsJobScheduler.h"
+#include "Profiling/BsProfilerCPU.h"
 
 namespace bs { namespace ct
 {
+	/** Minimum number of renderables to update per job, when updating per-call buffers in parallel. */
+	static constexpr UINT32 MIN_RENDERABLES_PER_JOB = 1024;
+
 	UnorderedMap<StringID, RenderCompositor::NodeType*> RenderCompositor::mNodeTypes;
 
 	RenderCompositor::~RenderCompositor()
@@ -260,17 +265,59 @@ namespace bs { namespace ct
 		}
 
 		// Prepare all visible objects. Note that this also prepares non-opaque objects.
+		gProfilerCPU().beginSample("UpdatePerCallBuffers");
+
 		const VisibilityInfo& visibility = inputs.view.getVisibilityMasks();
 		UINT32 numRenderables = (UINT32)inputs.scene.renderables.size();
+
+		mVisibleRenderables.clear();
 		for (UINT32 i = 0; i < numRenderables; i++)
 		{
-			if (!visibility.renderables[i])
-				continue;
+			if (visibility.renderables[i])
+				mVisibleRenderables.push_back(i);
+		}
 
-			RendererObject* rendererObject = inputs.scene.renderables[i];
-			rendererObject->updatePerCallBuffer(viewProps.viewProjTransform);
+		// Only updates the CPU copy of the per-call buffers, which every object has its own of, so the objects can be
+		// processed in parallel
+		const UINT32 numVisible = (UINT32)mVisibleRenderables.size();
+		const auto updatePerCallBuffers = [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				RendererObject* rendererObject = inputs.scene.renderables[mVisibleRenderables[i]];
+				rendererObject->updatePerCallBuffer(viewProps.viewProjTransform, false);
+			}
+		};
 
-			for (auto& element : inputs.scene.renderables[i]->elements)
+		UINT32 maxChunks = 1;
+		if (JobScheduler::isStarted())
+			maxChunks = JobScheduler::instance().getNumActiveWorkers() + 1;
+
+		UINT32 numChunks = Math::clamp(numVisible / MIN_RENDERABLES_PER_JOB, 1U, maxChunks);
+		if (numChunks == 1)
+			updatePerCallBuffers(0, numVisible);
+		else
+		{
+			const UINT32 chunkSize = Math::divideAndRoundUp(numVisible, numChunks);
+			numChunks = Math::divideAndRoundUp(numVisible, chunkSize);
+
+			JobScheduler::instance().parallelForAndWait(numChunks, 1, [&](UINT32 start, UINT32 numToProcess)
+			{
+				for (UINT32 chunk = start; chunk < start + numToProcess; chunk++)
+				{
+					const UINT32 chunkStart = chunk * chunkSize;
+					updatePerCallBuffers(chunkStart, std::min(chunkStart + chunkSize, numVisible));
+				}
+			});
+		}
+
+		// GPU writes must be issued from the core thread. Objects whose buffers didn't change aren't written to.
+		for (auto& idx : mVisibleRenderables)
+		{
+			RendererObject* rendererObject = inputs.scene.renderables[idx];
+			rendererObject->perCallParamBuffer->flushToGPU();
+
+			for (auto& element : rendererObject->elements)
 			{
 				SPtr<GpuParams> gpuParams = element.params->getGpuParams();
 				for(UINT32 j = 0; j < GPT_COUNT; j++)
@@ -282,6 +329,8 @@ namespace bs { namespace ct
 			}
 		}
 
+		gProfilerCPU().endSample("UpdatePerCallBuffers");
+
 		Camera* sceneCamera = inputs.view.getSceneCamera();
 
 		// Trigger prepare callbacks
@@ -316,22 +365,32 @@ namespace bs { namespace ct
 
 		// Render all visible opaque elements that use the deferred pipeline
 		const Vector<RenderQueueElement>& opaqueElements = inputs.view.getOpaqueQueue(false)->getSortedElements();
-		for (auto iter = opaqueElements.begin(); iter != opaqueElements.end(); ++iter)
+		if (inputs.options.instancing)
 		{
-			BeastRenderableElement* renderElem = static_cast<BeastRenderableElement*>(iter->renderElem);
+			mInstanceBatcher.build(opaqueElements, inputs.scene.renderables, inputs.view.getPerViewBuffer());
+
+			for (auto& batch : mInstanceBatcher.getBatches())
+				InstanceBatcher::draw(batch);
+		}
+		else
+		{
+			for (auto iter = opaqueElements.begin(); iter != opaqueElements.end(); ++iter)
+			{
+				BeastRenderableElement* renderElem = static_cast<BeastRenderableElement*>(iter->renderElem);
 
-			SPtr<Material> material = renderElem->material;
+				SPtr<Material> material = renderElem->material;
 
-			if (iter->applyPass)
-				gRendererUtility().setPass(material, iter->passIdx, renderElem->techniqueIdx);
+				if (iter->applyPass)
+					gRendererUtility().setPass(material, iter->passIdx, renderElem->techniqueIdx);
 
-			gRendererUtility().setPassParams(renderElem->params, iter->passIdx);
+				gRendererUtility().setPassParams(renderElem->params, iter->passIdx);
 
-			if(renderElem->morphVertexDeclaration == nullptr)
-				gRendererUtility().draw(renderElem->mesh, renderElem->subMesh);
-			else
-				gRendererUtility().drawMorph(renderElem->mesh, renderElem->subMesh, renderElem->morphShapeBuffer, 
-					renderElem->morphVertexDeclaration);
+				if(renderElem->morphVertexDeclaration == nullptr)
+					gRendererUtility().draw(renderElem->mesh, renderElem->subMesh);
+				else
+					gRendererUtility().drawMorph(renderElem->mesh, renderElem->subMesh, renderElem->morphShapeBuffer, 
+						renderElem->morphVertexDeclaration);
+			}
 		}
 
 		// Make sure that any compute shaders are able to read g-buffer by unbinding it
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "BsRenderBeastPrerequisites.h"
+#include "Shading/BsInstancedRendering.h"
 
 namespace bs 
 { 
@@ -210,6 +211,9 @@ namespace ct
 
 		/** @copydoc RenderCompositorNode::clear */
 		void clear() override;
+
+		InstanceBatcher mInstanceBatcher;
+		Vector<UINT32> mVisibleRenderables;
 	};
 
 	/** Initializes the scene color texture and/or buffer. Does not perform any rendering. */
@@ -9,8 +9,9 @@ namespace bs { namespace ct
 
 	RendererObject::RendererObject()
 	{
-		perObjectParamBuffer = gPerObjectParamDef.createBuffer();
-		perCallParamBuffer = gPerCallParamDef.createBuffer();
+		// Re-written every time the object moves or the view changes, so sub-allocate from the per-frame ring buffer
+		perObjectParamBuffer = gPerObjectParamDef.createBuffer(GPBU_STREAM);
+		perCallParamBuffer = gPerCallParamDef.createBuffer(GPBU_STREAM);
 	}
 
 	void RendererObject::updatePerObjectBuffer()
@@ -23,14 +24,22 @@ namespace bs { namespace ct
 		gPerObjectParamDef.gMatWorldNoScale.set(perObjectParamBuffer, worldNoScaleTransform);
 		gPerObjectParamDef.gMatInvWorldNoScale.set(perObjectParamBuffer, worldNoScaleTransform.inverseAffine());
 		gPerObjectParamDef.gWorldDeterminantSign.set(perObjectParamBuffer, worldTransform.determinant3x3() >= 0.0f ? 1.0f : -1.0f);
+
+		mPerCallDirty = true;
 	}
 
 	void RendererObject::updatePerCallBuffer(const Matrix4& viewProj, bool flush)
 	{
+		if(!mPerCallDirty && mPerCallViewProj == viewProj)
+			return;
+
 		Matrix4 worldViewProjMatrix = viewProj * renderable->getMatrix();
 
 		gPerCallParamDef.gMatWorldViewProj.set(perCallParamBuffer, worldViewProjMatrix);
 
+		mPerCallViewProj = viewProj;
+		mPerCallDirty = false;
+
 		if(flush)
 			perCallParamBuffer->flushToGPU();
 	}
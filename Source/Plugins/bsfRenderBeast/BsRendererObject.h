@@ -63,6 +63,18 @@ namespace bs { namespace ct
 		/** Index of the technique in the material to render the element with. */
 		UINT32 techniqueIdx;
 
+		/**
+		 * GPU parameters used when rendering the element as the first element of an instanced batch. Null if the element
+		 * cannot be rendered using instancing.
+		 */
+		SPtr<GpuParamsSet> instancedParams;
+
+		/** Index of the technique used for rendering the element using instancing. Only valid if #instancedParams is set. */
+		UINT32 instancedTechniqueIdx = (UINT32)-1;
+
+		/** Sampler state overrides for #instancedParams. */
+		MaterialSamplerOverrides* instancedSamplerOverrides = nullptr;
+
 		/** Binding indices representing where should the per-camera param block buffer be bound to. */
 		GpuParamBinding perCameraBindings[GPT_COUNT];
 
@@ -124,7 +136,8 @@ namespace bs { namespace ct
 		void updatePerObjectBuffer();
 
 		/** 
-		 * Updates the per-call GPU buffer according to the provided parameters. 
+		 * Updates the per-call GPU buffer according to the provided parameters. Does nothing if neither the object's
+		 * transform nor the view-projection matrix changed since the last update.
 		 * 
 		 * @param[in]	viewProj	Combined view-projection matrix of the current camera.
 		 * @param[in]	flush		True if the buffer contents should be immediately flushed to the GPU.
@@ -136,6 +149,10 @@ namespace bs { namespace ct
 
 		SPtr<GpuParamBlockBuffer> perObjectParamBuffer;
 		SPtr<GpuParamBlockBuffer> perCallParamBuffer;
+
+	private:
+		Matrix4 mPerCallViewProj = Matrix4::ZERO;
+		bool mPerCallDirty = true;
 	};
 
 	/** @} */
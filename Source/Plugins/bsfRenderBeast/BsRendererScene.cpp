@@ -10,6 +10,7 @@
 #include "Material/BsPass.h"
 #include "Material/BsGpuParamsSet.h"
 #include "Utility/BsSamplerOverrides.h"
+#include "Shading/BsInstancedRendering.h"
 #include "BsRenderBeastOptions.h"
 #include "BsRenderBeast.h"
 
@@ -225,6 +226,7 @@ namespace bs {	namespace ct
 
 		mInfo.renderables.push_back(bs_new<RendererObject>());
 		mInfo.renderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer()));
+		mInfo.renderableCulling.add(renderable->getBounds(), renderable->getLayer());
 
 		RendererObject* rendererObject = mInfo.renderables.back();
 		rendererObject->renderable = renderable;
@@ -357,24 +359,9 @@ namespace bs {	namespace ct
 				renElement.material->updateParamsSet(renElement.params, true);
 
 				// Generate or assign sampler state overrides
-				SamplerOverrideKey samplerKey(renElement.material, techniqueIdx);
-				auto iterFind = mSamplerOverrides.find(samplerKey);
-				if (iterFind != mSamplerOverrides.end())
-				{
-					renElement.samplerOverrides = iterFind->second;
-					iterFind->second->refCount++;
-				}
-				else
-				{
-					SPtr<Shader> shader = renElement.material->getShader();
-					MaterialSamplerOverrides* samplerOverrides = SamplerOverrideUtility::generateSamplerOverrides(shader,
-						renElement.material->_getInternalParams(), renElement.params, mOptions);
-
-					mSamplerOverrides[samplerKey] = samplerOverrides;
+				renElement.samplerOverrides = acquireSamplerOverrides(renElement.material, techniqueIdx, renElement.params);
 
-					renElement.samplerOverrides = samplerOverrides;
-					samplerOverrides->refCount++;
-				}
+				updateInstancedParams(renElement);
 			}
 		}
 
@@ -462,6 +449,8 @@ namespace bs {	namespace ct
 
 		mInfo.renderables[renderableId]->updatePerObjectBuffer();
 		mInfo.renderableCullInfos[renderableId].bounds = renderable->getBounds();
+		mInfo.renderableCullInfos[renderableId].layer = renderable->getLayer();
+		mInfo.renderableCulling.update(renderableId, renderable->getBounds(), renderable->getLayer());
 	}
 
 	void RendererScene::unregisterRenderable(Renderable* renderable)
@@ -474,20 +463,14 @@ namespace bs {	namespace ct
 		Vector<BeastRenderableElement>& elements = rendererObject->elements;
 		for (auto& element : elements)
 		{
-			SamplerOverrideKey samplerKey(element.material, element.techniqueIdx);
-
-			auto iterFind = mSamplerOverrides.find(samplerKey);
-			assert(iterFind != mSamplerOverrides.end());
+			releaseSamplerOverrides(element.material, element.techniqueIdx);
+			element.samplerOverrides = nullptr;
 
-			MaterialSamplerOverrides* samplerOverrides = iterFind->second;
-			samplerOverrides->refCount--;
-			if (samplerOverrides->refCount == 0)
+			if (element.instancedParams != nullptr)
 			{
-				SamplerOverrideUtility::destroySamplerOverrides(samplerOverrides);
-				mSamplerOverrides.erase(iterFind);
+				releaseSamplerOverrides(element.material, element.instancedTechniqueIdx);
+				element.instancedSamplerOverrides = nullptr;
 			}
-
-			element.samplerOverrides = nullptr;
 		}
 
 		if (renderableId != lastRenderableId)
@@ -505,6 +488,7 @@ namespace bs {	namespace ct
 		// Last element is the one we want to erase
 		mInfo.renderables.erase(mInfo.renderables.end() - 1);
 		mInfo.renderableCullInfos.erase(mInfo.renderableCullInfos.end() - 1);
+		mInfo.renderableCulling.remove(renderableId);
 
 		bs_delete(rendererObject);
 	}
@@ -767,6 +751,41 @@ namespace bs {	namespace ct
 		}
 	}
 
+	/** Assigns the sampler states from the provided overrides to all passes of the parameter set, if they changed. */
+	static void applySamplerOverrides(MaterialSamplerOverrides* overrides, const SPtr<GpuParamsSet>& paramsSet)
+	{
+		if(overrides == nullptr || !overrides->isDirty)
+			return;
+
+		UINT32 numPasses = paramsSet->getNumPasses();
+		for(UINT32 i = 0; i < numPasses; i++)
+		{
+			SPtr<GpuParams> params = paramsSet->getGpuParams(i);
+
+			const UINT32 numStages = 6;
+			for (UINT32 j = 0; j < numStages; j++)
+			{
+				GpuProgramType type = (GpuProgramType)j;
+
+				SPtr<GpuParamDesc> paramDesc = params->getParamDesc(type);
+				if (paramDesc == nullptr)
+					continue;
+
+				for (auto& samplerDesc : paramDesc->samplers)
+				{
+					UINT32 set = samplerDesc.second.set;
+					UINT32 slot = samplerDesc.second.slot;
+
+					UINT32 overrideIndex = overrides->passes[i].stateOverrides[set][slot];
+					if (overrideIndex == (UINT32)-1)
+						continue;
+
+					params->setSamplerState(set, slot, overrides->overrides[overrideIndex].state);
+				}
+			}
+		}
+	}
+
 	void RendererScene::refreshSamplerOverrides(bool force)
 	{
 		bool anyDirty = false;
@@ -813,42 +832,99 @@ namespace bs {	namespace ct
 		{
 			for(auto& element : mInfo.renderables[i]->elements)
 			{
-				MaterialSamplerOverrides* overrides = element.samplerOverrides;
-				if(overrides != nullptr && overrides->isDirty)
-				{
-					UINT32 numPasses = element.material->getNumPasses();
-					for(UINT32 j = 0; j < numPasses; j++)
-					{
-						SPtr<GpuParams> params = element.params->getGpuParams(j);
+				applySamplerOverrides(element.samplerOverrides, element.params);
 
-						const UINT32 numStages = 6;
-						for (UINT32 k = 0; k < numStages; k++)
-						{
-							GpuProgramType type = (GpuProgramType)k;
+				if(element.instancedParams != nullptr)
+					applySamplerOverrides(element.instancedSamplerOverrides, element.instancedParams);
+			}
+		}
 
-							SPtr<GpuParamDesc> paramDesc = params->getParamDesc(type);
-							if (paramDesc == nullptr)
-								continue;
+		for (auto& entry : mSamplerOverrides)
+			entry.second->isDirty = false;
+	}
 
-							for (auto& samplerDesc : paramDesc->samplers)
-							{
-								UINT32 set = samplerDesc.second.set;
-								UINT32 slot = samplerDesc.second.slot;
+	void RendererScene::refreshInstancing()
+	{
+		for (auto& renderable : mInfo.renderables)
+		{
+			for (auto& element : renderable->elements)
+				updateInstancedParams(element);
+		}
+	}
 
-								UINT32 overrideIndex = overrides->passes[j].stateOverrides[set][slot];
-								if (overrideIndex == (UINT32)-1)
-									continue;
+	MaterialSamplerOverrides* RendererScene::acquireSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx,
+		const SPtr<GpuParamsSet>& params)
+	{
+		SamplerOverrideKey samplerKey(material, techniqueIdx);
+		auto iterFind = mSamplerOverrides.find(samplerKey);
+		if (iterFind != mSamplerOverrides.end())
+		{
+			iterFind->second->refCount++;
+			return iterFind->second;
+		}
 
-								params->setSamplerState(set, slot, overrides->overrides[overrideIndex].state);
-							}
-						}
-					}
-				}
-			}
+		MaterialSamplerOverrides* samplerOverrides = SamplerOverrideUtility::generateSamplerOverrides(
+			material->getShader(), material->_getInternalParams(), params, mOptions);
+
+		mSamplerOverrides[samplerKey] = samplerOverrides;
+		samplerOverrides->refCount++;
+
+		return samplerOverrides;
+	}
+
+	void RendererScene::releaseSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx)
+	{
+		SamplerOverrideKey samplerKey(material, techniqueIdx);
+
+		auto iterFind = mSamplerOverrides.find(samplerKey);
+		assert(iterFind != mSamplerOverrides.end());
+
+		MaterialSamplerOverrides* samplerOverrides = iterFind->second;
+		samplerOverrides->refCount--;
+		if (samplerOverrides->refCount == 0)
+		{
+			SamplerOverrideUtility::destroySamplerOverrides(samplerOverrides);
+			mSamplerOverrides.erase(iterFind);
 		}
+	}
 
-		for (auto& entry : mSamplerOverrides)
-			entry.second->isDirty = false;
+	void RendererScene::updateInstancedParams(BeastRenderableElement& element)
+	{
+		if (element.instancedParams != nullptr)
+		{
+			releaseSamplerOverrides(element.material, element.instancedTechniqueIdx);
+
+			element.instancedParams = nullptr;
+			element.instancedSamplerOverrides = nullptr;
+			element.instancedTechniqueIdx = (UINT32)-1;
+		}
+
+		if (!mOptions->instancing)
+			return;
+
+		// Only non-animated elements rendered through the deferred pipeline are instanced
+		ShaderFlags shaderFlags = element.material->getShader()->getFlags();
+		if (shaderFlags.isSet(ShaderFlag::Forward) || shaderFlags.isSet(ShaderFlag::Transparent))
+			return;
+
+		if (element.animType != RenderableAnimType::None)
+			return;
+
+		FIND_TECHNIQUE_DESC findDesc;
+		findDesc.variation = &getInstancedVariation();
+
+		UINT32 techniqueIdx = element.material->findTechnique(findDesc);
+		if (techniqueIdx == (UINT32)-1)
+			return;
+
+		element.instancedTechniqueIdx = techniqueIdx;
+		element.instancedParams = element.material->createParamsSet(techniqueIdx);
+		element.material->updateParamsSet(element.instancedParams, true);
+		element.instancedSamplerOverrides = acquireSamplerOverrides(element.material, techniqueIdx,
+			element.instancedParams);
+
+		// Per-camera and per-batch buffers are assigned when the batch is built, as they depend on the view
+		element.instancedParams->getGpuParams()->setParamBlockBuffer("PerFrame", mPerFrameParamBuffer);
 	}
 
 	void RendererScene::setParamFrameParams(float time)
@@ -861,7 +937,7 @@ namespace bs {	namespace ct
 		if (mInfo.renderableReady[idx])
 			return;
 		
-		// Note: Before uploading bone matrices perhaps check if they has actually been changed since last frame
+		// Bone matrices are only uploaded if the animation was re-evaluated since the last upload
 		if(frameInfo.animData != nullptr)
 			mInfo.renderables[idx]->renderable->updateAnimationBuffers(*frameInfo.animData);
 		
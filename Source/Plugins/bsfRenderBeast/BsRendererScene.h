@@ -7,6 +7,7 @@
 #include "BsRendererView.h"
 #include "Shading/BsLightProbes.h"
 #include "Utility/BsSamplerOverrides.h"
+#include "Utility/BsCullingOctree.h"
 
 namespace bs 
 { 
@@ -34,6 +35,7 @@ namespace bs
 		// Renderables
 		Vector<RendererObject*> renderables;
 		Vector<CullInfo> renderableCullInfos;
+		CullingOctree renderableCulling; // Same bounds as renderableCullInfos, spatially partitioned for culling
 
 		// Lights
 		Vector<RendererLight> directionalLights;
@@ -140,6 +142,12 @@ namespace bs
 		 */
 		void refreshSamplerOverrides(bool force = false);
 
+		/**
+		 * Creates or destroys the parameters used for instanced rendering of all renderable elements, depending on whether
+		 * instancing is enabled in the renderer options. To be called whenever the option changes.
+		 */
+		void refreshInstancing();
+
 		/** Updates global per frame parameter buffers with new values. To be called at the start of every frame. */
 		void setParamFrameParams(float time);
 
@@ -165,6 +173,25 @@ namespace bs
 		 */
 		void updateCameraRenderTargets(Camera* camera, bool remove = false);
 
+		/**
+		 * Finds sampler overrides for the specified material technique, or generates new ones if none exist, and
+		 * increments their reference count.
+		 */
+		MaterialSamplerOverrides* acquireSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx,
+			const SPtr<GpuParamsSet>& params);
+
+		/**
+		 * Decrements the reference count of sampler overrides previously retrieved with acquireSamplerOverrides(), and
+		 * destroys them if no longer referenced.
+		 */
+		void releaseSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx);
+
+		/**
+		 * Creates the parameters used for rendering the element as a part of an instanced batch, if instancing is enabled
+		 * and supported by the element. Releases any previously created instancing parameters.
+		 */
+		void updateInstancedParams(BeastRenderableElement& element);
+
 		SceneInfo mInfo;
 		SPtr<GpuParamBlockBuffer> mPerFrameParamBuffer;
 		UnorderedMap<SamplerOverrideKey, MaterialSamplerOverrides*> mSamplerOverrides;
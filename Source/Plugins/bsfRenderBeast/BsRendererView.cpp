@@ -7,6 +7,7 @@
 #include "Material/BsMaterial.h"
 #include "Material/BsShader.h"
 #include "Material/BsGpuParamsSet.h"
+#include "Profiling/BsProfilerCPU.h"
 #include "BsRendererLight.h"
 #include "BsRendererScene.h"
 #include "BsRenderBeast.h"
@@ -158,7 +159,7 @@ namespace bs { namespace ct
 	}
 
 	void RendererView::determineVisible(const Vector<RendererObject*>& renderables, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+		const Vector<UINT32>& visibleRenderables, Vector<bool>* visibility)
 	{
 		mVisibility.renderables.clear();
 		mVisibility.renderables.resize(renderables.size(), false);
@@ -166,13 +167,10 @@ namespace bs { namespace ct
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.renderables);
-
 		// Update per-object param buffers and queue render elements
-		for(UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+		for(auto& i : visibleRenderables)
 		{
-			if (!mVisibility.renderables[i])
-				continue;
+			mVisibility.renderables[i] = true;
 
 			const AABox& boundingBox = cullInfos[i].bounds.getBox();
 			float distanceToCamera = (mProperties.viewOrigin - boundingBox.getCenter()).length();
@@ -201,9 +199,13 @@ namespace bs { namespace ct
 			}
 		}
 
+		gProfilerCPU().beginSample("SortRenderQueues");
+
 		mForwardOpaqueQueue->sort();
 		mDeferredOpaqueQueue->sort();
 		mTransparentQueue->sort();
+
+		gProfilerCPU().endSample("SortRenderQueues");
 	}
 
 	void RendererView::determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, 
@@ -250,31 +252,6 @@ namespace bs { namespace ct
 		}
 	}
 
-	void RendererView::calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const
-	{
-		UINT64 cameraLayers = mProperties.visibleLayers;
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
-
-		for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
-		{
-			if ((cullInfos[i].layer & cameraLayers) == 0)
-				continue;
-
-			// Do frustum culling
-			// Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-			// operations, as it is trivial to update them. Also consider spatial partitioning.
-			const Sphere& boundingSphere = cullInfos[i].bounds.getSphere();
-			if (worldFrustum.intersects(boundingSphere))
-			{
-				// More precise with the box
-				const AABox& boundingBox = cullInfos[i].bounds.getBox();
-
-				if (worldFrustum.intersects(boundingBox))
-					visibility[i] = true;
-			}
-		}
-	}
-
 	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
 	{
 		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
@@ -551,8 +528,15 @@ namespace bs { namespace ct
 		mVisibility.renderables.resize(sceneInfo.renderables.size(), false);
 		mVisibility.renderables.assign(sceneInfo.renderables.size(), false);
 
+		gProfilerCPU().beginSample("CullRenderables");
+		cullRenderables(sceneInfo);
+		gProfilerCPU().endSample("CullRenderables");
+
 		for(UINT32 i = 0; i < numViews; i++)
-			mViews[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos, &mVisibility.renderables);
+		{
+			mViews[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos, mVisibleRenderables[i],
+				&mVisibility.renderables);
+		}
 
 		// Calculate light visibility for all views
 		UINT32 numRadialLights = (UINT32)sceneInfo.radialLights.size();
@@ -612,4 +596,45 @@ namespace bs { namespace ct
 			}
 		}
 	}
+
+	void RendererViewGroup::cullRenderables(const SceneInfo& sceneInfo)
+	{
+		UINT32 numViews = (UINT32)mViews.size();
+
+		mVisibleRenderables.resize(numViews);
+		for (auto& entry : mVisibleRenderables)
+			entry.clear();
+
+		// Cull against as many views as possible at once, so objects are visited once instead of once per view
+		CullingOctree::CullVolume volumes[CullingOctree::MAX_CULL_VOLUMES];
+		UINT32 viewIndices[CullingOctree::MAX_CULL_VOLUMES];
+
+		UINT32 viewIdx = 0;
+		while (viewIdx < numViews)
+		{
+			UINT32 numVolumes = 0;
+			for (; viewIdx < numViews && numVolumes < CullingOctree::MAX_CULL_VOLUMES; viewIdx++)
+			{
+				if (mViews[viewIdx]->getRenderSettings().overlayOnly)
+					continue;
+
+				const RendererViewProperties& viewProps = mViews[viewIdx]->getProperties();
+
+				volumes[numVolumes] = { &viewProps.cullFrustum, viewProps.visibleLayers };
+				viewIndices[numVolumes] = viewIdx;
+				numVolumes++;
+			}
+
+			sceneInfo.renderableCulling.cull(volumes, numVolumes, mVisibleElements);
+
+			for (auto& entry : mVisibleElements)
+			{
+				for (UINT32 i = 0; i < numVolumes; i++)
+				{
+					if (entry.mask & (1 << i))
+						mVisibleRenderables[viewIndices[i]].push_back(entry.index);
+				}
+			}
+		}
+	}
 }}
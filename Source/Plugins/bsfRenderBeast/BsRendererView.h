@@ -8,6 +8,7 @@
 #include "Renderer/BsRenderSettings.h"
 #include "Math/BsBounds.h"
 #include "Math/BsConvexVolume.h"
+#include "Utility/BsCullingOctree.h"
 #include "Shading/BsLightGrid.h"
 #include "Shading/BsShadowRendering.h"
 #include "BsRendererView.h"
@@ -263,11 +264,13 @@ namespace bs { namespace ct
 		const RenderCompositor& getCompositor() const { return mCompositor; }
 
 		/**
-		 * Populates view render queues by determining visible renderable objects. 
+		 * Populates view render queues from a list of visible renderable objects. 
 		 *
-		 * @param[in]	renderables			A set of renderable objects to iterate over and determine visibility for.
+		 * @param[in]	renderables			A set of renderable objects to determine visibility for.
 		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
 		 *									renderable objects. Must be the same size as the @p renderables array.
+		 * @param[in]	visibleRenderables	Indices of renderable objects visible from this view, as determined by
+		 *									RendererViewGroup::determineVisibility().
 		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible renderable
 		 *									object. If the bit for an object is already set to true, the method will never
 		 *									change it to false which allows the same bitfield to be provided to multiple
@@ -277,7 +280,7 @@ namespace bs { namespace ct
 		 *									retrieved by calling getVisibilityMask().
 		 */
 		void determineVisible(const Vector<RendererObject*>& renderables, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+			const Vector<UINT32>& visibleRenderables, Vector<bool>* visibility = nullptr);
 
 		/**
 		 * Calculates the visibility masks for all the lights of the provided type.
@@ -297,12 +300,6 @@ namespace bs { namespace ct
 		void determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, LightType type, 
 			Vector<bool>* visibility = nullptr);
 
-		/**
-		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
-		 */
-		void calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const;
-
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
 		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
@@ -452,9 +449,18 @@ namespace bs { namespace ct
 		void determineVisibility(const SceneInfo& sceneInfo);
 
 	private:
+		/** 
+		 * Culls renderables against all views in the group using a single pass over the scene, and outputs the visible 
+		 * renderables of each view into mVisibleRenderables.
+		 */
+		void cullRenderables(const SceneInfo& sceneInfo);
+
 		Vector<RendererView*> mViews;
 		VisibilityInfo mVisibility;
 
+		Vector<Vector<UINT32>> mVisibleRenderables; // Transient
+		Vector<CullingOctree::VisibleElement> mVisibleElements; // Transient
+
 		VisibleLightData mVisibleLightData;
 		VisibleReflProbeData mVisibleReflProbeData;
 
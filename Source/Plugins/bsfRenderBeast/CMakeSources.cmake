@@ -32,6 +32,7 @@ set(BS_RENDERBEAST_INC_SHADING
 	"Shading/BsLightProbes.h"
 	"Shading/BsShadowRendering.h"
 	"Shading/BsPostProcessing.h"
+	"Shading/BsInstancedRendering.h"
 )
 
 set(BS_RENDERBEAST_SRC_SHADING
@@ -41,6 +42,7 @@ set(BS_RENDERBEAST_SRC_SHADING
 	"Shading/BsLightProbes.cpp"
 	"Shading/BsShadowRendering.cpp"
 	"Shading/BsPostProcessing.cpp"
+	"Shading/BsInstancedRendering.cpp"
 )
 
 set(BS_RENDERBEAST_INC_UTILITY
@@ -0,0 +1,200 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Benchmarks/BsBenchmarkApplication.h"
+#include "BsNullRenderAPI.h"
+#include "BsRenderBeastOptions.h"
+#include "Components/BsCCamera.h"
+#include "Components/BsCLight.h"
+#include "Components/BsCRenderable.h"
+#include "Material/BsMaterial.h"
+#include "Material/BsPass.h"
+#include "RenderAPI/BsGpuPipelineState.h"
+#include "RenderAPI/BsGpuParamDesc.h"
+#include "Resources/BsBuiltinResources.h"
+#include "Scene/BsSceneObject.h"
+
+#include <iostream>
+#include <iomanip>
+
+using namespace bs;
+
+namespace
+{
+	/** Number of renderables in each of the benchmark scenes. */
+	constexpr UINT32 SCENE_SIZES[] = { 1000, 4000, 16000, 50000 };
+
+	/** Number of distinct materials the renderables are spread over. */
+	constexpr UINT32 NUM_MATERIALS = 16;
+
+	/** Number of radial lights in the benchmark scenes. */
+	constexpr UINT32 NUM_LIGHTS = 32;
+
+	/** Number of frames rendered before measuring, letting the renderer create its per-object data. */
+	constexpr UINT32 NUM_WARMUP_FRAMES = 10;
+
+	/** Number of frames measured per scene. Must not be larger than the number of reports kept by the profiler. */
+	constexpr UINT32 NUM_FRAMES = 100;
+
+	/** Names of the core thread profiler samples reported by the benchmark, and the labels they're reported under. */
+	const std::pair<const char*, const char*> REPORTED_SAMPLES[] =
+	{
+		{ "renderAllCore", "Frame" },
+		{ "CullRenderables", "Culling" },
+		{ "SortRenderQueues", "Sorting" },
+		{ "PrepareRenderables", "Param updates" },
+		{ "UpdatePerCallBuffers", "Per-call updates" },
+		{ "Compositor", "Compositor" }
+	};
+
+	/** Returns the statistics of all the commands executed by the null render API so far. */
+	ct::NullRenderStats getRenderStats()
+	{
+		return static_cast<ct::NullRenderAPI&>(ct::RenderAPI::instance()).getStats();
+	}
+
+	/** 
+	 * Checks if the null render API reflected the parameters of the programs used by the benchmark. Without reflection
+	 * the renderer has no parameters to update or upload, and the reported numbers would be meaningless.
+	 */
+	bool hasParameterReflection()
+	{
+		HShader shader = BuiltinResources::instance().getBuiltinShader(BuiltinShader::Standard);
+		HMaterial material = Material::create(shader);
+		gCoreThread().submitAll(true);
+
+		SPtr<Pass> pass = material->getPass();
+		if(pass == nullptr || pass->getGraphicsPipelineState() == nullptr)
+			return false;
+
+		const SPtr<GpuProgram>& program = pass->getGraphicsPipelineState()->getVertexProgram();
+		if(program == nullptr || !program->isCompiled())
+			return false;
+
+		return !program->getParamDesc()->paramBlocks.empty();
+	}
+
+	/** Enables or disables automatic instancing in the renderer. Takes effect on the next rendered frame. */
+	void setInstancing(bool enabled)
+	{
+		SPtr<ct::RenderBeastOptions> options = std::static_pointer_cast<ct::RenderBeastOptions>(
+			ct::gRenderer()->getOptions());
+
+		options->instancing = enabled;
+		ct::gRenderer()->setOptions(options);
+	}
+
+	/** Creates a grid of boxes with materials spread evenly between them, lit by a set of radial lights. */
+	HSceneObject createScene(UINT32 numRenderables)
+	{
+		HSceneObject root = SceneObject::create("Scene");
+
+		HShader shader = BuiltinResources::instance().getBuiltinShader(BuiltinShader::Standard);
+		HMesh mesh = BuiltinResources::instance().getMesh(BuiltinMesh::Box);
+
+		Vector<HMaterial> materials(NUM_MATERIALS);
+		for(UINT32 i = 0; i < NUM_MATERIALS; i++)
+		{
+			materials[i] = Material::create(shader);
+			materials[i]->setVec2("gUVOffset", Vector2(i / (float)NUM_MATERIALS, 0.0f));
+		}
+
+		// Spread the boxes in front of the camera, so some are outside of the frustum and get culled
+		const UINT32 rowLength = (UINT32)std::ceil(std::sqrt((float)numRenderables));
+		for(UINT32 i = 0; i < numRenderables; i++)
+		{
+			HSceneObject so = SceneObject::create("Box");
+			so->setParent(root);
+			so->setPosition(Vector3((i % rowLength) * 2.0f - rowLength, 0.0f, (i / rowLength) * -2.0f));
+
+			HRenderable renderable = so->addComponent<CRenderable>();
+			renderable->setMesh(mesh);
+			renderable->setMaterial(materials[i % NUM_MATERIALS]);
+		}
+
+		for(UINT32 i = 0; i < NUM_LIGHTS; i++)
+		{
+			HSceneObject so = SceneObject::create("Light");
+			so->setParent(root);
+			so->setPosition(Vector3((i % 8) * 8.0f - 32.0f, 3.0f, (i / 8) * -8.0f));
+
+			HLight light = so->addComponent<CLight>();
+			light->setType(LightType::Radial);
+			light->setAttenuationRadius(10.0f);
+		}
+
+		HSceneObject cameraSO = SceneObject::create("Camera");
+		cameraSO->setParent(root);
+		cameraSO->setPosition(Vector3(0.0f, 10.0f, 10.0f));
+		cameraSO->lookAt(Vector3(0.0f, 0.0f, -20.0f));
+
+		HCamera camera = cameraSO->addComponent<CCamera>();
+		camera->setMain(true);
+
+		return root;
+	}
+
+	/**
+	 * Renders the scene of the specified size and prints the average per-frame CPU time and render API statistics. 
+	 * Automatic instancing is enabled or disabled according to @p instancing.
+	 */
+	void runScene(BenchmarkApplication& app, UINT32 numRenderables, bool instancing)
+	{
+		setInstancing(instancing);
+
+		HSceneObject scene = createScene(numRenderables);
+		app.runFrames(NUM_WARMUP_FRAMES);
+
+		const ct::NullRenderStats startStats = getRenderStats();
+		app.runFrames(NUM_FRAMES);
+		const ct::NullRenderStats stats = getRenderStats() - startStats;
+
+		UnorderedMap<String, double> sampleTotals;
+		for(UINT32 i = 0; i < NUM_FRAMES; i++)
+			accumulateSamples(gProfiler().getReport(ProfiledThread::Core, i).cpuReport.getBasicSamplingData(), sampleTotals);
+
+		const double numFrames = (double)std::max(stats.numPresents, (UINT64)1);
+
+		std::cout << numRenderables << " renderables, " << NUM_MATERIALS << " materials, " << NUM_LIGHTS << " lights, "
+			<< "instancing " << (instancing ? "on" : "off") << std::endl;
+
+		for(auto& sample : REPORTED_SAMPLES)
+		{
+			std::cout << "  " << std::left << std::setw(24) << sample.second << std::fixed << std::setprecision(3)
+				<< sampleTotals[sample.first] / NUM_FRAMES << " ms/frame" << std::endl;
+		}
+
+		std::cout << "  " << std::left << std::setw(24) << "Draw calls" << std::fixed << std::setprecision(1)
+			<< stats.numDrawCalls / numFrames << std::endl;
+		std::cout << "  " << std::left << std::setw(24) << "State changes" << std::fixed << std::setprecision(1)
+			<< stats.getNumStateChanges() / numFrames << std::endl;
+		std::cout << "  " << std::left << std::setw(24) << "Bytes uploaded" << std::fixed << std::setprecision(1)
+			<< stats.numBytesUploaded / numFrames << std::endl;
+		std::cout << "  " << std::left << std::setw(24) << "Buffer uploads" << std::fixed << std::setprecision(1)
+			<< stats.numUploads / numFrames << std::endl;
+
+		scene->destroy();
+	}
+}
+
+int main()
+{
+	BenchmarkApplication& app = BenchmarkApplication::startUp("RenderBeast benchmark");
+
+	if(!hasParameterReflection())
+	{
+		std::cerr << "GPU program parameters could not be reflected by the null render API. Make sure it is built with "
+			"glslang." << std::endl;
+
+		Application::shutDown();
+		return 1;
+	}
+
+	for(auto& numRenderables : SCENE_SIZES)
+	{
+		runScene(app, numRenderables, false);
+		runScene(app, numRenderables, true);
+	}
+
+	Application::shutDown();
+	return 0;
+}
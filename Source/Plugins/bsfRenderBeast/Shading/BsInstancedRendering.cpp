@@ -0,0 +1,208 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsInstancedRendering.h"
+#include "RenderAPI/BsGpuBuffer.h"
+#include "Material/BsGpuParamsSet.h"
+#include "Material/BsMaterial.h"
+#include "Mesh/BsMesh.h"
+#include "Renderer/BsRendererUtility.h"
+#include "BsRendererObject.h"
+
+namespace bs { namespace ct
+{
+	/** Number of instances the size of the instance data buffer is rounded up to, to avoid frequent re-allocations. */
+	static const UINT32 INSTANCE_BUFFER_INCREMENT = 256;
+
+	PerInstanceBatchParamDef gPerInstanceBatchParamDef;
+
+	InstanceBatcher::BatchKey::BatchKey(const BeastRenderableElement& element, UINT32 passIdx)
+		: material(element.material.get()), mesh(element.mesh.get()), indexOffset(element.subMesh.indexOffset)
+		, passIdx(passIdx)
+	{ }
+
+	size_t InstanceBatcher::BatchKey::HashFunction::operator()(const BatchKey& key) const
+	{
+		size_t hash = 0;
+		bs::hash_combine(hash, key.material);
+		bs::hash_combine(hash, key.mesh);
+		bs::hash_combine(hash, key.indexOffset);
+		bs::hash_combine(hash, key.passIdx);
+
+		return hash;
+	}
+
+	bool InstanceBatcher::BatchKey::EqualFunction::operator()(const BatchKey& lhs, const BatchKey& rhs) const
+	{
+		return lhs.material == rhs.material && lhs.mesh == rhs.mesh && lhs.indexOffset == rhs.indexOffset &&
+			lhs.passIdx == rhs.passIdx;
+	}
+
+	void InstanceBatcher::build(const Vector<RenderQueueElement>& elements, const Vector<RendererObject*>& renderables,
+		const SPtr<GpuParamBlockBuffer>& perCamera)
+	{
+		mBatches.clear();
+		mBatchedElements.clear();
+		mBatchedElementBatches.clear();
+
+		// Elements that don't need their pass applied use the same pipeline state as the element before them
+		const UINT32 numElements = (UINT32)elements.size();
+		UINT32 runStart = 0;
+		for (UINT32 i = 1; i <= numElements; i++)
+		{
+			if (i == numElements || elements[i].applyPass)
+			{
+				buildRun(elements, runStart, i);
+				runStart = i;
+			}
+		}
+
+		// Assign a range of the instance buffer to every instanced batch
+		const UINT32 numBatches = (UINT32)mBatches.size();
+		mInstanceOffsets.resize(numBatches);
+
+		UINT32 numInstances = 0;
+		for (UINT32 i = 0; i < numBatches; i++)
+		{
+			mInstanceOffsets[i] = numInstances;
+
+			if (mBatches[i].numInstances > 1)
+				numInstances += mBatches[i].numInstances;
+		}
+
+		if (numInstances == 0)
+			return;
+
+		// Write the instance data. Offsets are advanced as the data is written, so they end up pointing past the end of
+		// their batch.
+		mInstanceData.resize(numInstances * INSTANCE_DATA_STRIDE);
+		for (UINT32 i = 0; i < (UINT32)mBatchedElements.size(); i++)
+		{
+			const UINT32 batchIdx = mBatchedElementBatches[i];
+			if (mBatches[batchIdx].numInstances <= 1)
+				continue;
+
+			const Renderable* renderable = renderables[mBatchedElements[i]->renderableId]->renderable;
+			const Matrix4 worldTfrm = renderable->getMatrix();
+			const Matrix4 worldNoScaleTfrm = renderable->getMatrixNoScale();
+
+			Vector4* dest = &mInstanceData[mInstanceOffsets[batchIdx]++ * INSTANCE_DATA_STRIDE];
+			memcpy(&dest[0], &worldTfrm, 12 * sizeof(float)); // Assuming row-major format
+			memcpy(&dest[3], &worldNoScaleTfrm, 12 * sizeof(float));
+			dest[6] = Vector4(worldTfrm.determinant3x3() >= 0.0f ? 1.0f : -1.0f, 0.0f, 0.0f, 0.0f);
+		}
+
+		const UINT32 numEntries = numInstances * INSTANCE_DATA_STRIDE;
+		if (mInstanceBuffer == nullptr || mInstanceBuffer->getProperties().getElementCount() < numEntries)
+		{
+			GPU_BUFFER_DESC desc;
+			desc.elementCount = Math::divideAndRoundUp(numInstances, INSTANCE_BUFFER_INCREMENT) *
+				INSTANCE_BUFFER_INCREMENT * INSTANCE_DATA_STRIDE;
+			desc.elementSize = 0;
+			desc.type = GBT_STANDARD;
+			desc.format = BF_32X4F;
+			desc.usage = GBU_DYNAMIC;
+
+			mInstanceBuffer = GpuBuffer::create(desc);
+		}
+
+		mInstanceBuffer->writeData(0, numEntries * sizeof(Vector4), mInstanceData.data(), BWT_DISCARD);
+
+		// Bind the instance data to the first element of every batch, which is the one used for rendering the batch
+		UINT32 numInstancedBatches = 0;
+		for (UINT32 i = 0; i < numBatches; i++)
+		{
+			const RenderBatch& batch = mBatches[i];
+			if (batch.numInstances <= 1)
+				continue;
+
+			if (numInstancedBatches >= (UINT32)mBatchParamBuffers.size())
+				mBatchParamBuffers.push_back(gPerInstanceBatchParamDef.createBuffer());
+
+			const SPtr<GpuParamBlockBuffer>& batchParamBuffer = mBatchParamBuffers[numInstancedBatches++];
+			gPerInstanceBatchParamDef.gInstanceOffset.set(batchParamBuffer,
+				(INT32)(mInstanceOffsets[i] - batch.numInstances));
+			batchParamBuffer->flushToGPU();
+
+			BeastRenderableElement* element = batch.element;
+			element->material->updateParamsSet(element->instancedParams);
+
+			SPtr<GpuParams> gpuParams = element->instancedParams->getGpuParams(batch.passIdx);
+			gpuParams->setParamBlockBuffer("PerCamera", perCamera);
+			gpuParams->setParamBlockBuffer("PerInstanceBatch", batchParamBuffer);
+
+			if (gpuParams->hasBuffer(GPT_VERTEX_PROGRAM, "gInstanceData"))
+				gpuParams->setBuffer(GPT_VERTEX_PROGRAM, "gInstanceData", mInstanceBuffer);
+		}
+	}
+
+	void InstanceBatcher::buildRun(const Vector<RenderQueueElement>& elements, UINT32 start, UINT32 end)
+	{
+		const UINT32 firstBatch = (UINT32)mBatches.size();
+		const bool canBatch = (end - start) > 1;
+
+		mBatchLookup.clear();
+		for (UINT32 i = start; i < end; i++)
+		{
+			const RenderQueueElement& queueElem = elements[i];
+			BeastRenderableElement* element = static_cast<BeastRenderableElement*>(queueElem.renderElem);
+
+			UINT32 batchIdx = (UINT32)-1;
+			if (canBatch && element->instancedParams != nullptr)
+			{
+				BatchKey key(*element, queueElem.passIdx);
+
+				auto iterFind = mBatchLookup.find(key);
+				if (iterFind != mBatchLookup.end())
+				{
+					batchIdx = iterFind->second;
+					mBatches[batchIdx].numInstances++;
+				}
+				else
+					mBatchLookup[key] = (UINT32)mBatches.size();
+
+				mBatchedElements.push_back(element);
+				mBatchedElementBatches.push_back(batchIdx != (UINT32)-1 ? batchIdx : (UINT32)mBatches.size());
+			}
+
+			if (batchIdx == (UINT32)-1)
+				mBatches.push_back({ element, queueElem.passIdx, false, 1 });
+		}
+
+		// Instanced batches use a different technique than the regular elements, so the pass needs to be re-applied when
+		// switching between them
+		for (UINT32 i = firstBatch; i < (UINT32)mBatches.size(); i++)
+		{
+			const bool instanced = mBatches[i].numInstances > 1;
+			const bool prevInstanced = i > firstBatch && mBatches[i - 1].numInstances > 1;
+
+			mBatches[i].applyPass = i == firstBatch || instanced || prevInstanced;
+		}
+	}
+
+	void InstanceBatcher::draw(const RenderBatch& batch)
+	{
+		BeastRenderableElement* element = batch.element;
+
+		if (batch.numInstances > 1)
+		{
+			if (batch.applyPass)
+				gRendererUtility().setPass(element->material, batch.passIdx, element->instancedTechniqueIdx);
+
+			gRendererUtility().setPassParams(element->instancedParams, batch.passIdx);
+			gRendererUtility().draw(element->mesh, element->subMesh, batch.numInstances);
+		}
+		else
+		{
+			if (batch.applyPass)
+				gRendererUtility().setPass(element->material, batch.passIdx, element->techniqueIdx);
+
+			gRendererUtility().setPassParams(element->params, batch.passIdx);
+
+			if (element->morphVertexDeclaration == nullptr)
+				gRendererUtility().draw(element->mesh, element->subMesh);
+			else
+				gRendererUtility().drawMorph(element->mesh, element->subMesh, element->morphShapeBuffer,
+					element->morphVertexDeclaration);
+		}
+	}
+}}
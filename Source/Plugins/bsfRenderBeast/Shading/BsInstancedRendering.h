@@ -0,0 +1,127 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Renderer/BsRenderQueue.h"
+#include "Renderer/BsParamBlocks.h"
+#include "Material/BsShaderVariation.h"
+
+namespace bs { namespace ct
+{
+	class BeastRenderableElement;
+	struct RendererObject;
+
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	BS_PARAM_BLOCK_BEGIN(PerInstanceBatchParamDef)
+		BS_PARAM_BLOCK_ENTRY(INT32, gInstanceOffset)
+	BS_PARAM_BLOCK_END
+
+	extern PerInstanceBatchParamDef gPerInstanceBatchParamDef;
+
+	/**
+	 * Number of Vector4 entries in the instance data buffer used per instance. Contains the 3x4 world matrix, the 3x4 world
+	 * matrix without scale, and the sign of the world matrix determinant, in that order. Must match the layout expected by
+	 * PerObjectData.bslinc.
+	 */
+	static constexpr UINT32 INSTANCE_DATA_STRIDE = 7;
+
+	/** Returns the shader variation used for rendering elements as a part of an instanced batch. */
+	static const ShaderVariation& getInstancedVariation()
+	{
+		static ShaderVariation variation = ShaderVariation(
+		Vector<ShaderVariation::Param>{
+			ShaderVariation::Param("SKINNED", false),
+			ShaderVariation::Param("MORPH", false),
+			ShaderVariation::Param("INSTANCED", true),
+		});
+
+		return variation;
+	}
+
+	/** A single draw operation produced by InstanceBatcher. */
+	struct RenderBatch
+	{
+		/** Element to render. For instanced batches this is the first element of the batch. */
+		BeastRenderableElement* element;
+
+		/** Index of the pass to render the element(s) with. */
+		UINT32 passIdx;
+
+		/** True if the pass (and its pipeline state) needs to be bound before rendering the batch. */
+		bool applyPass;
+
+		/** Number of elements rendered by the batch. Batches with a single element are rendered without instancing. */
+		UINT32 numInstances;
+	};
+
+	/**
+	 * Merges elements of a sorted render queue that share the same mesh, material and pass into instanced batches.
+	 * Only elements that have their instanced parameters prepared by RendererScene are batched, and only with other
+	 * elements in the same run of queue entries rendered using the same pipeline state. Each batch is placed at the
+	 * position of its first element. World transforms of all batched elements are stored in a single GPU buffer.
+	 */
+	class InstanceBatcher
+	{
+	public:
+		/**
+		 * Groups the provided queue elements into batches, uploads the per-instance data and binds it to the instanced
+		 * parameters of every batch.
+		 *
+		 * @param[in]	elements		Sorted elements of the render queue.
+		 * @param[in]	renderables		Renderable objects the elements belong to.
+		 * @param[in]	perCamera		Buffer containing per-camera parameters, to bind to instanced parameters.
+		 */
+		void build(const Vector<RenderQueueElement>& elements, const Vector<RendererObject*>& renderables,
+			const SPtr<GpuParamBlockBuffer>& perCamera);
+
+		/** Returns the batches generated by the last call to build(). */
+		const Vector<RenderBatch>& getBatches() const { return mBatches; }
+
+		/** Renders a batch, binding its pass and parameters if required. */
+		static void draw(const RenderBatch& batch);
+
+	private:
+		/** Key used for grouping elements that can be rendered with a single draw call. */
+		struct BatchKey
+		{
+			BatchKey(const BeastRenderableElement& element, UINT32 passIdx);
+
+			class HashFunction
+			{
+			public:
+				size_t operator()(const BatchKey& key) const;
+			};
+
+			class EqualFunction
+			{
+			public:
+				bool operator()(const BatchKey& lhs, const BatchKey& rhs) const;
+			};
+
+			const Material* material;
+			const Mesh* mesh;
+			UINT32 indexOffset;
+			UINT32 passIdx;
+		};
+
+		/** Groups the queue elements in range [@p start, @p end), all rendered using the same pipeline state. */
+		void buildRun(const Vector<RenderQueueElement>& elements, UINT32 start, UINT32 end);
+
+		Vector<RenderBatch> mBatches;
+		SPtr<GpuBuffer> mInstanceBuffer;
+		Vector<SPtr<GpuParamBlockBuffer>> mBatchParamBuffers;
+
+		// Transient
+		UnorderedMap<BatchKey, UINT32, BatchKey::HashFunction, BatchKey::EqualFunction> mBatchLookup;
+		Vector<BeastRenderableElement*> mBatchedElements;
+		Vector<UINT32> mBatchedElementBatches;
+		Vector<UINT32> mInstanceOffsets;
+		Vector<Vector4> mInstanceData;
+	};
+
+	/** @} */
+}}
@@ -436,8 +436,8 @@ namespace bs { namespace ct
 
 	/** 
 	 * Provides a common way for all types of shadow depth rendering to render the relevant objects into the depth map. 
-	 * Iterates over all relevant objects in the scene, binds the relevant materials and renders the objects into the depth
-	 * map.
+	 * Iterates over all shadow casters of the shadow map, binds the relevant materials and renders the objects into the
+	 * depth map.
 	 */
 	class ShadowRenderQueue
 	{
@@ -463,7 +463,8 @@ namespace bs { namespace ct
 		};
 
 		template<class Options>
-		static void execute(RendererScene& scene, const FrameInfo& frameInfo, const Options& opt)
+		static void execute(RendererScene& scene, const FrameInfo& frameInfo, const Vector<ShadowCaster>& casters,
+			const Options& opt)
 		{
 			static_assert((UINT32)RenderableAnimType::Count == 4, "RenderableAnimType is expected to have four sequential entries.");
 
@@ -474,12 +475,12 @@ namespace bs { namespace ct
 				FrameVector<Command> commands[4];
 
 				// Make a list of relevant renderables and prepare them for rendering
-				for (UINT32 i = 0; i < sceneInfo.renderables.size(); i++)
+				for (auto& caster : casters)
 				{
-					const Sphere& bounds = sceneInfo.renderableCullInfos[i].bounds.getSphere();
-					if (!opt.intersects(bounds))
+					if (!opt.intersects(caster.mask))
 						continue;
 
+					const UINT32 i = caster.renderableIdx;
 					scene.prepareRenderable(i, frameInfo);
 
 					Command renderableCommand;
@@ -489,7 +490,7 @@ namespace bs { namespace ct
 					renderableCommand.isElement = false;
 					renderableCommand.renderable = renderable;
 
-					opt.prepare(renderableCommand, bounds);
+					opt.prepare(renderableCommand, caster.mask);
 
 					bool renderableBound[4];
 					bs_zero_out(renderableBound);
@@ -543,24 +544,21 @@ namespace bs { namespace ct
 	struct ShadowRenderQueueCubeOptions
 	{
 		ShadowRenderQueueCubeOptions(
-			const ConvexVolume (&frustums)[6], 
-			const ConvexVolume& boundingVolume, 
 			const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer, 
 			const SPtr<GpuParamBlockBuffer>& shadowCubeMatricesBuffer,
 			const SPtr<GpuParamBlockBuffer>& shadowCubeMasksBuffer)
-			: frustums(frustums), boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
-			, shadowCubeMatricesBuffer(shadowCubeMatricesBuffer), shadowCubeMasksBuffer(shadowCubeMasksBuffer)
+			: shadowParamsBuffer(shadowParamsBuffer), shadowCubeMatricesBuffer(shadowCubeMatricesBuffer)
+			, shadowCubeMasksBuffer(shadowCubeMasksBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
+		bool intersects(UINT32 faceMask) const
 		{
-			return boundingVolume.intersects(bounds);
+			return true;
 		}
 
-		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
+		void prepare(ShadowRenderQueue::Command& command, UINT32 faceMask) const
 		{
-			for (UINT32 j = 0; j < 6; j++)
-				command.mask |= (frustums[j].intersects(bounds) ? 1 : 0) << j;
+			command.mask = faceMask;
 		}
 
 		void bindMaterial(const ShaderVariation& variation) const
@@ -579,8 +577,6 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer, shadowCubeMasksBuffer);
 		}
 		
-		const ConvexVolume (&frustums)[6];
-		const ConvexVolume& boundingVolume;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 		const SPtr<GpuParamBlockBuffer>& shadowCubeMatricesBuffer;
 		const SPtr<GpuParamBlockBuffer>& shadowCubeMasksBuffer;
@@ -592,17 +588,17 @@ namespace bs { namespace ct
 	struct ShadowRenderQueueCubeSingleOptions
 	{
 		ShadowRenderQueueCubeSingleOptions(
-				const ConvexVolume& boundingVolume,
+				UINT32 face,
 				const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
-				: boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
+				: face(face), shadowParamsBuffer(shadowParamsBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
+		bool intersects(UINT32 faceMask) const
 		{
-			return boundingVolume.intersects(bounds);
+			return (faceMask & (1 << face)) != 0;
 		}
 
-		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
+		void prepare(ShadowRenderQueue::Command& command, UINT32 faceMask) const
 		{
 		}
 
@@ -619,7 +615,7 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer);
 		}
 
-		const ConvexVolume& boundingVolume;
+		UINT32 face;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 
 		mutable ShadowDepthNormalNoPSMat* material = nullptr;
@@ -629,17 +625,16 @@ namespace bs { namespace ct
 	struct ShadowRenderQueueSpotOptions
 	{
 		ShadowRenderQueueSpotOptions(
-			const ConvexVolume& boundingVolume, 
 			const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
-			: boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
+			: shadowParamsBuffer(shadowParamsBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
+		bool intersects(UINT32 mask) const
 		{
-			return boundingVolume.intersects(bounds);
+			return true;
 		}
 
-		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
+		void prepare(ShadowRenderQueue::Command& command, UINT32 mask) const
 		{
 		}
 
@@ -656,7 +651,6 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer);
 		}
 		
-		const ConvexVolume& boundingVolume;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 
 		mutable ShadowDepthNormalMat* material = nullptr;
@@ -666,17 +660,17 @@ namespace bs { namespace ct
 	struct ShadowRenderQueueDirOptions
 	{
 		ShadowRenderQueueDirOptions(
-			const ConvexVolume& boundingVolume, 
+			UINT32 cascadeIdx, 
 			const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
-			: boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
+			: cascadeIdx(cascadeIdx), shadowParamsBuffer(shadowParamsBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
+		bool intersects(UINT32 cascadeMask) const
 		{
-			return boundingVolume.intersects(bounds);
+			return (cascadeMask & (1 << cascadeIdx)) != 0;
 		}
 
-		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
+		void prepare(ShadowRenderQueue::Command& command, UINT32 cascadeMask) const
 		{
 		}
 
@@ -693,7 +687,7 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer);
 		}
 		
-		const ConvexVolume& boundingVolume;
+		UINT32 cascadeIdx;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 
 		mutable ShadowDepthDirectionalMat* material = nullptr;
@@ -797,6 +791,9 @@ namespace bs { namespace ct
 		mSpotLightShadowOptions.clear();
 		mRadialLightShadowOptions.clear();
 
+		mShadowCullVolumes.clear();
+		mNumShadowCasterLists = 0;
+
 		// Clear all dynamic light atlases
 		for (auto& entry : mCascadedShadowMaps)
 			entry.clear();
@@ -830,6 +827,9 @@ namespace bs { namespace ct
 			if (maxFadePercent < 0.005f)
 				continue;
 
+			mShadowCullVolumes.push_back(getSpotShadowFrustum(light));
+			options.casterListIdx = addShadowCasterList(1);
+
 			mSpotLightShadowOptions.push_back(options);
 			shadowInfoCount++; // For now, always a single fully dynamic shadow for a single light, but that may change
 		}
@@ -855,11 +855,48 @@ namespace bs { namespace ct
 			if (maxFadePercent < 0.005f)
 				continue;
 
+			ConvexVolume frustums[6];
+			getRadialShadowFrustums(*light.internal, frustums);
+
+			mShadowCullVolumes.insert(mShadowCullVolumes.end(), std::begin(frustums), std::end(frustums));
+			options.casterListIdx = addShadowCasterList(6);
+
 			mRadialLightShadowOptions.push_back(options);
 
 			shadowInfoCount++; // For now, always a single fully dynamic shadow for a single light, but that may change
 		}
 
+		for (UINT32 i = 0; i < (UINT32)sceneInfo.directionalLights.size(); ++i)
+		{
+			const RendererLight& light = sceneInfo.directionalLights[i];
+
+			if (!light.internal->getCastsShadow())
+				continue;
+
+			UINT32 numViews = viewGroup.getNumViews();
+			mDirectionalLightShadows[i].viewCasterLists.resize(numViews);
+
+			Vector3 lightDir = -light.internal->getTransform().getRotation().zAxis();
+			for (UINT32 j = 0; j < numViews; ++j)
+			{
+				const RendererView& view = *viewGroup.getView(j);
+				if (!view.getRenderSettings().enableShadows)
+					continue;
+
+				UINT32 numCascades = view.getRenderSettings().shadowSettings.numCascades;
+				for (UINT32 k = 0; k < numCascades; ++k)
+				{
+					Sphere frustumBounds;
+					mShadowCullVolumes.push_back(getCSMSplitFrustum(view, lightDir, k, numCascades, frustumBounds));
+				}
+
+				mDirectionalLightShadows[i].viewCasterLists[j] = addShadowCasterList(numCascades);
+			}
+		}
+
+		// Find shadow casters for all shadow maps at once
+		cullShadowCasters(sceneInfo);
+
 		// Sort spot lights by size so they fit neatly in the texture atlas
 		std::sort(mSpotLightShadowOptions.begin(), mSpotLightShadowOptions.end(),
 			[](const ShadowMapOptions& a, const ShadowMapOptions& b) { return a.mapSize > b.mapSize; } );
@@ -900,7 +937,7 @@ namespace bs { namespace ct
 			const RendererLight& light = sceneInfo.directionalLights[i];
 
 			if (!light.internal->getCastsShadow())
-				return;
+				continue;
 
 			UINT32 numViews = viewGroup.getNumViews();
 			mDirectionalLightShadows[i].viewShadows.resize(numViews);
@@ -1266,6 +1303,7 @@ namespace bs { namespace ct
 		}
 
 		ShadowCascadedMap& shadowMap = mCascadedShadowMaps[shadowInfo.textureIdx];
+		const ShadowCasterList& casterList = mShadowCasterLists[mDirectionalLightShadows[lightIdx].viewCasterLists[viewIdx]];
 
 		Quaternion lightRotation(BsIdentity);
 		lightRotation.lookRotation(lightDir, Vector3::UNIT_Y);
@@ -1273,7 +1311,7 @@ namespace bs { namespace ct
 		for (UINT32 i = 0; i < numCascades; ++i)
 		{
 			Sphere frustumBounds;
-			ConvexVolume cascadeCullVolume = getCSMSplitFrustum(view, lightDir, i, numCascades, frustumBounds);
+			getCSMSplitFrustum(view, lightDir, i, numCascades, frustumBounds);
 
 			// Make sure the size of the projected area is in multiples of shadow map pixel size (for stability)
 			float worldUnitsPerTexel = frustumBounds.getRadius() * 2.0f / shadowMap.getSize();
@@ -1334,12 +1372,12 @@ namespace bs { namespace ct
 			ShadowDepthDirectionalMat* depthDirMat = ShadowDepthDirectionalMat::get();
 			depthDirMat->bind(shadowParamsBuffer);
 
-			// Render all renderables into the shadow map
+			// Render all shadow casters into the shadow map
 			ShadowRenderQueueDirOptions dirOptions(
-				cascadeCullVolume,
+				i,
 				shadowParamsBuffer);
 			
-			ShadowRenderQueue::execute(scene, frameInfo, dirOptions);
+			ShadowRenderQueue::execute(scene, frameInfo, casterList.casters, dirOptions);
 
 			shadowMap.setShadowInfo(i, shadowInfo);
 		}
@@ -1405,7 +1443,6 @@ namespace bs { namespace ct
 		Matrix4 view = Matrix4::view(rendererLight.getShiftedLightPosition(), lightRotation);
 		Matrix4 proj = Matrix4::projectionPerspective(light->getSpotAngle(), 1.0f, 0.05f, light->getAttenuationRadius());
 
-		ConvexVolume localFrustum = ConvexVolume(proj);
 		RenderAPI::instance().convertProjectionMatrix(proj, proj);
 
 		mapInfo.shadowVPTransform = proj * view;
@@ -1415,25 +1452,12 @@ namespace bs { namespace ct
 		gShadowParamsDef.gMatViewProj.set(shadowParamsBuffer, mapInfo.shadowVPTransform);
 		gShadowParamsDef.gNDCZToDeviceZ.set(shadowParamsBuffer, RendererView::getNDCZToDeviceZ());
 
-		const Vector<Plane>& frustumPlanes = localFrustum.getPlanes();
-		Matrix4 worldMatrix = view.transpose();
-
-		Vector<Plane> worldPlanes(frustumPlanes.size());
-		UINT32 j = 0;
-		for (auto& plane : frustumPlanes)
-		{
-			worldPlanes[j] = worldMatrix.multiplyAffine(plane);
-			j++;
-		}
-
-		ConvexVolume worldFrustum(worldPlanes);
-
-		// Render all renderables into the shadow map
+		// Render all shadow casters into the shadow map
 		ShadowRenderQueueSpotOptions spotOptions(
-			worldFrustum,
 			shadowParamsBuffer);
 
-		ShadowRenderQueue::execute(scene, frameInfo, spotOptions);
+		const ShadowCasterList& casterList = mShadowCasterLists[options.casterListIdx];
+		ShadowRenderQueue::execute(scene, frameInfo, casterList.casters, spotOptions);
 
 		// Restore viewport
 		rapi.setViewport(Rect2(0.0f, 0.0f, 1.0f, 1.0f));
@@ -1493,7 +1517,6 @@ namespace bs { namespace ct
 
 		// Note: Projecting on positive Z axis, because cubemaps use a left-handed coordinate system
 		Matrix4 proj = Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.05f, light->getAttenuationRadius(), true);
-		ConvexVolume localFrustum(proj);
 
 		RenderAPI& rapi = RenderAPI::instance();
 		const RenderAPIInfo& rapiInfo = rapi.getAPIInfo();
@@ -1528,40 +1551,11 @@ namespace bs { namespace ct
 		gShadowParamsDef.gMatViewProj.set(shadowParamsBuffer, Matrix4::IDENTITY);
 		gShadowParamsDef.gNDCZToDeviceZ.set(shadowParamsBuffer, RendererView::getNDCZToDeviceZ());
 
-		ConvexVolume frustums[6];
-		Vector<Plane> boundingPlanes;
+		const ShadowCasterList& casterList = mShadowCasterLists[options.casterListIdx];
 		for (UINT32 i = 0; i < 6; i++)
 		{
 			// Calculate view matrix
-			Vector3 forward;
-			Vector3 up = Vector3::UNIT_Y;
-
-			switch (i)
-			{
-			case CF_PositiveX:
-				forward = Vector3::UNIT_X;
-				break;
-			case CF_NegativeX:
-				forward = -Vector3::UNIT_X;
-				break;
-			case CF_PositiveY:
-				forward = Vector3::UNIT_Y;
-				up = -Vector3::UNIT_Z;
-				break;
-			case CF_NegativeY:
-				forward = -Vector3::UNIT_Y;
-				up = Vector3::UNIT_Z;
-				break;
-			case CF_PositiveZ:
-				forward = Vector3::UNIT_Z;
-				break;
-			case CF_NegativeZ:
-				forward = -Vector3::UNIT_Z;
-				break;
-			}
-
-			Vector3 right = Vector3::cross(up, forward);
-			Matrix3 viewRotationMat = Matrix3(right, up, forward);
+			Matrix3 viewRotationMat = getCubeFaceRotation(i);
 
 			Vector3 lightPos = light->getTransform().getPosition();
 			Matrix4 viewOffsetMat = Matrix4::translation(-lightPos);
@@ -1571,29 +1565,8 @@ namespace bs { namespace ct
 
 			Matrix4 shadowViewProj = adjustedProj * view;
 
-			// Calculate world frustum for culling
-			const Vector<Plane>& frustumPlanes = localFrustum.getPlanes();
-
-			Matrix4 worldMatrix = Matrix4::translation(lightPos) * Matrix4(viewRotationMat);
-
-			Vector<Plane> worldPlanes(frustumPlanes.size());
-			UINT32 j = 0;
-			for (auto& plane : frustumPlanes)
-			{
-				worldPlanes[j] = worldMatrix.multiplyAffine(plane);
-				j++;
-			}
-
-			ConvexVolume frustum(worldPlanes);
-
 			if(renderAllFacesAtOnce)
-			{
-				frustums[i] = frustum;
-
-				// Register far plane of all frustums
-				boundingPlanes.push_back(worldPlanes.back());
 				gShadowCubeMatricesDef.gFaceVPMatrices.set(shadowCubeMatricesBuffer, shadowViewProj, i);
-			}
 			else
 			{
 				gShadowParamsDef.gMatViewProj.set(shadowParamsBuffer, shadowViewProj);
@@ -1608,14 +1581,13 @@ namespace bs { namespace ct
 				rapi.setRenderTarget(faceRt);
 				rapi.clearRenderTarget(FBT_DEPTH);
 
-				// Render all renderables into the shadow map
-				ConvexVolume boundingVolume(boundingPlanes);
+				// Render all shadow casters visible from this face into the shadow map
 				ShadowRenderQueueCubeSingleOptions cubeOptions(
-						frustum,
+						i,
 						shadowParamsBuffer
 				);
 
-				ShadowRenderQueue::execute(scene, frameInfo, cubeOptions);
+				ShadowRenderQueue::execute(scene, frameInfo, casterList.casters, cubeOptions);
 			}
 		}
 
@@ -1624,17 +1596,14 @@ namespace bs { namespace ct
 			rapi.setRenderTarget(cubemap.getTarget());
 			rapi.clearRenderTarget(FBT_DEPTH);
 
-			// Render all renderables into the shadow map
-			ConvexVolume boundingVolume(boundingPlanes);
+			// Render all shadow casters into the shadow map
 			ShadowRenderQueueCubeOptions cubeOptions(
-					frustums,
-					boundingVolume,
 					shadowParamsBuffer,
 					shadowCubeMatricesBuffer,
 					shadowCubeMasksBuffer
 			);
 
-			ShadowRenderQueue::execute(scene, frameInfo, cubeOptions);
+			ShadowRenderQueue::execute(scene, frameInfo, casterList.casters, cubeOptions);
 		}
 
 		LightShadows& lightShadows = mRadialLightShadows[options.lightIdx];
@@ -1643,6 +1612,62 @@ namespace bs { namespace ct
 		lightShadows.numShadows++;
 	}
 
+	UINT32 ShadowRendering::addShadowCasterList(UINT32 numVolumes)
+	{
+		if (mNumShadowCasterLists == (UINT32)mShadowCasterLists.size())
+			mShadowCasterLists.push_back(ShadowCasterList());
+
+		ShadowCasterList& casterList = mShadowCasterLists[mNumShadowCasterLists];
+		casterList.firstVolume = (UINT32)mShadowCullVolumes.size() - numVolumes;
+		casterList.numVolumes = numVolumes;
+		casterList.casters.clear();
+
+		return mNumShadowCasterLists++;
+	}
+
+	void ShadowRendering::cullShadowCasters(const SceneInfo& sceneInfo)
+	{
+		// Shadows are cast regardless of layers
+		static constexpr UINT64 ALL_LAYERS = (UINT64)-1;
+
+		CullingOctree::CullVolume volumes[CullingOctree::MAX_CULL_VOLUMES];
+
+		// Cull against volumes of as many shadow maps as possible at once. Volumes of a single shadow map are always
+		// culled together, so every caster is reported once per shadow map.
+		UINT32 listIdx = 0;
+		while (listIdx < mNumShadowCasterLists)
+		{
+			UINT32 firstListIdx = listIdx;
+			UINT32 numVolumes = 0;
+			for (; listIdx < mNumShadowCasterLists; listIdx++)
+			{
+				const ShadowCasterList& casterList = mShadowCasterLists[listIdx];
+				if ((numVolumes + casterList.numVolumes) > CullingOctree::MAX_CULL_VOLUMES)
+					break;
+
+				for (UINT32 i = 0; i < casterList.numVolumes; i++)
+					volumes[numVolumes++] = { &mShadowCullVolumes[casterList.firstVolume + i], ALL_LAYERS };
+			}
+
+			sceneInfo.renderableCulling.cull(volumes, numVolumes, mVisibleElements);
+
+			for (auto& entry : mVisibleElements)
+			{
+				UINT32 mask = entry.mask;
+				for (UINT32 i = firstListIdx; i < listIdx && mask != 0; i++)
+				{
+					ShadowCasterList& casterList = mShadowCasterLists[i];
+
+					UINT32 listMask = mask & ((1 << casterList.numVolumes) - 1);
+					if (listMask != 0)
+						casterList.casters.push_back({ entry.index, listMask });
+
+					mask >>= casterList.numVolumes;
+				}
+			}
+		}
+	}
+
 	void ShadowRendering::calcShadowMapProperties(const RendererLight& light, const RendererViewGroup& viewGroup, 
 		UINT32 border, UINT32& size, SmallVector<float, 6>& fadePercents, float& maxFadePercent) const
 	{
@@ -1909,6 +1934,90 @@ namespace bs { namespace ct
 		return ConvexVolume(lightVolume);
 	}
 
+	ConvexVolume ShadowRendering::getSpotShadowFrustum(const RendererLight& rendererLight)
+	{
+		Light* light = rendererLight.internal;
+
+		Quaternion lightRotation(BsIdentity);
+		lightRotation.lookRotation(-light->getTransform().getRotation().zAxis());
+
+		Matrix4 view = Matrix4::view(rendererLight.getShiftedLightPosition(), lightRotation);
+		Matrix4 proj = Matrix4::projectionPerspective(light->getSpotAngle(), 1.0f, 0.05f, light->getAttenuationRadius());
+
+		ConvexVolume localFrustum = ConvexVolume(proj);
+
+		const Vector<Plane>& frustumPlanes = localFrustum.getPlanes();
+		Matrix4 worldMatrix = view.transpose();
+
+		Vector<Plane> worldPlanes(frustumPlanes.size());
+		UINT32 j = 0;
+		for (auto& plane : frustumPlanes)
+		{
+			worldPlanes[j] = worldMatrix.multiplyAffine(plane);
+			j++;
+		}
+
+		return ConvexVolume(worldPlanes);
+	}
+
+	void ShadowRendering::getRadialShadowFrustums(const Light& light, ConvexVolume (&frustums)[6])
+	{
+		// Note: Projecting on positive Z axis, because cubemaps use a left-handed coordinate system
+		Matrix4 proj = Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.05f, light.getAttenuationRadius(), true);
+		ConvexVolume localFrustum(proj);
+
+		const Vector<Plane>& frustumPlanes = localFrustum.getPlanes();
+		Vector3 lightPos = light.getTransform().getPosition();
+
+		for (UINT32 i = 0; i < 6; i++)
+		{
+			Matrix4 worldMatrix = Matrix4::translation(lightPos) * Matrix4(getCubeFaceRotation(i));
+
+			Vector<Plane> worldPlanes(frustumPlanes.size());
+			UINT32 j = 0;
+			for (auto& plane : frustumPlanes)
+			{
+				worldPlanes[j] = worldMatrix.multiplyAffine(plane);
+				j++;
+			}
+
+			frustums[i] = ConvexVolume(worldPlanes);
+		}
+	}
+
+	Matrix3 ShadowRendering::getCubeFaceRotation(UINT32 face)
+	{
+		Vector3 forward;
+		Vector3 up = Vector3::UNIT_Y;
+
+		switch (face)
+		{
+		case CF_PositiveX:
+			forward = Vector3::UNIT_X;
+			break;
+		case CF_NegativeX:
+			forward = -Vector3::UNIT_X;
+			break;
+		case CF_PositiveY:
+			forward = Vector3::UNIT_Y;
+			up = -Vector3::UNIT_Z;
+			break;
+		case CF_NegativeY:
+			forward = -Vector3::UNIT_Y;
+			up = Vector3::UNIT_Z;
+			break;
+		case CF_PositiveZ:
+			forward = Vector3::UNIT_Z;
+			break;
+		case CF_NegativeZ:
+			forward = -Vector3::UNIT_Z;
+			break;
+		}
+
+		Vector3 right = Vector3::cross(up, forward);
+		return Matrix3(right, up, forward);
+	}
+
 	float ShadowRendering::getCSMSplitDistance(const RendererView& view, UINT32 index, UINT32 numCascades)
 	{
 		auto& shadowSettings = view.getRenderSettings().shadowSettings;
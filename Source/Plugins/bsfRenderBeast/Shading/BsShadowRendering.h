@@ -6,6 +6,7 @@
 #include "Utility/BsModule.h"
 #include "Math/BsMatrix4.h"
 #include "Math/BsConvexVolume.h"
+#include "Utility/BsCullingOctree.h"
 #include "Renderer/BsParamBlocks.h"
 #include "Renderer/BsRendererMaterial.h"
 #include "Renderer/BsLight.h"
@@ -509,6 +510,13 @@ namespace bs { namespace ct
 		Vector<ShadowInfo> mShadowInfos;
 	};
 
+	/** Renderable that casts a shadow into a particular shadow map. */
+	struct ShadowCaster
+	{
+		UINT32 renderableIdx;
+		UINT32 mask; /**< Bit for each volume (cascade or cubemap face) of the shadow map the renderable is visible from. */
+	};
+
 	/** Provides functionality for rendering shadow maps. */
 	class ShadowRendering
 	{
@@ -517,6 +525,7 @@ namespace bs { namespace ct
 		{
 			UINT32 lightIdx;
 			UINT32 mapSize;
+			UINT32 casterListIdx;
 			SmallVector<float, 6> fadePercents;
 		};
 
@@ -531,6 +540,15 @@ namespace bs { namespace ct
 		struct PerViewLightShadows
 		{
 			SmallVector<LightShadows, 6> viewShadows;
+			SmallVector<UINT32, 6> viewCasterLists;
+		};
+
+		/** Contains all renderables casting a shadow into a particular shadow map. */
+		struct ShadowCasterList
+		{
+			UINT32 firstVolume = 0; /**< Index of the first culling volume of the shadow map, in mShadowCullVolumes. */
+			UINT32 numVolumes = 0;
+			Vector<ShadowCaster> casters;
 		};
 	public:
 		ShadowRendering(UINT32 shadowMapSize);
@@ -547,6 +565,19 @@ namespace bs { namespace ct
 		/** Changes the default shadow map size. Will cause all shadow maps to be rebuilt. */
 		void setShadowMapSize(UINT32 size);
 	private:
+		/** 
+		 * Registers a new shadow map whose casters will be determined by the next call to cullShadowCasters(), and returns
+		 * the index of its caster list. Volumes of the shadow map are expected to be appended to mShadowCullVolumes
+		 * right before calling this method.
+		 */
+		UINT32 addShadowCasterList(UINT32 numVolumes);
+
+		/** 
+		 * Determines shadow casters for all shadow maps registered through addShadowCasterList(), by culling the scene
+		 * against volumes of all the shadow maps at once.
+		 */
+		void cullShadowCasters(const SceneInfo& sceneInfo);
+
 		/** Renders cascaded shadow maps for the provided directional light viewed from the provided view. */
 		void renderCascadedShadowMaps(const RendererView& view, UINT32 lightIdx, RendererScene& scene, 
 			const FrameInfo& frameInfo);
@@ -610,6 +641,18 @@ namespace bs { namespace ct
 		static ConvexVolume getCSMSplitFrustum(const RendererView& view, const Vector3& lightDir, UINT32 cascade, 
 			UINT32 numCascades, Sphere& outBounds);
 
+		/** Generates a world space frustum covering the area rendered into the shadow map of the provided spot light. */
+		static ConvexVolume getSpotShadowFrustum(const RendererLight& light);
+
+		/** 
+		 * Generates world space frustums covering the area rendered into each face of the shadow cubemap of the provided
+		 * radial light. 
+		 */
+		static void getRadialShadowFrustums(const Light& light, ConvexVolume (&frustums)[6]);
+
+		/** Returns the rotation of the camera used for rendering the specified face of a shadow cubemap. */
+		static Matrix3 getCubeFaceRotation(UINT32 face);
+
 		/**
 		 * Finds the distance (along the view direction) of the frustum split for the specified index. Used for cascaded
 		 * shadow maps.
@@ -688,6 +731,10 @@ namespace bs { namespace ct
 		Vector<bool> mRenderableVisibility; // Transient
 		Vector<ShadowMapOptions> mSpotLightShadowOptions; // Transient
 		Vector<ShadowMapOptions> mRadialLightShadowOptions; // Transient
+		Vector<ConvexVolume> mShadowCullVolumes; // Transient
+		Vector<ShadowCasterList> mShadowCasterLists; // Transient
+		UINT32 mNumShadowCasterLists = 0; // Transient
+		Vector<CullingOctree::VisibleElement> mVisibleElements; // Transient
 	};
 
 	/* @} */
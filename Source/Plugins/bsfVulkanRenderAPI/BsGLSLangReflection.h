@@ -0,0 +1,67 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "RenderAPI/BsVertexDeclaration.h"
+
+struct TBuiltInResource;
+
+namespace glslang
+{
+	class TProgram;
+}
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Vulkan
+	 *  @{
+	 */
+
+	/**
+	 * Extracts GPU program parameters and vertex inputs from GLSL programs linked by glslang. Doesn't depend on Vulkan
+	 * itself, and is also compiled into the null render API so it reports the same parameters as the Vulkan backend.
+	 */
+	class GLSLangReflection
+	{
+	public:
+		/** Resource limits to use when parsing shaders with glslang. */
+		static const TBuiltInResource DEFAULT_RESOURCES;
+
+		/**
+		 * Populates the provided list with vertex input attributes of a linked program.
+		 *
+		 * @param[in]	program		Linked glslang program containing a vertex stage.
+		 * @param[out]	elementList	List to append the vertex elements to.
+		 * @param[out]	log			Error messages, if any.
+		 * @return					False if the attributes couldn't be parsed.
+		 */
+		static bool parseVertexAttributes(const glslang::TProgram* program, Vector<VertexElement>& elementList,
+			String& log);
+
+		/**
+		 * Populates the provided parameter description with uniforms, uniform blocks, buffers and samplers of a linked
+		 * program.
+		 *
+		 * @param[in]	program		Linked glslang program.
+		 * @param[out]	desc		Description to populate.
+		 * @param[out]	log			Error messages, if any.
+		 * @return					False if the uniforms couldn't be parsed.
+		 */
+		static bool parseUniforms(const glslang::TProgram* program, GpuParamDesc& desc, String& log);
+
+		/**
+		 * Calculates the size and alignment of a single element within a shader interface block using the std140 layout.
+		 *
+		 * @param[in]		type		Type of the element. Structs are not supported.
+		 * @param[in]		arraySize	Number of array elements of the element (1 if it's not an array).
+		 * @param[in, out]	offset		Current location in some parent buffer at which the element should be placed at. If the
+		 *								location doesn't match the element's alignment, the value will be modified to a valid
+		 *								alignment. In multiples of 4 bytes.
+		 * @return						Size of the element, in multiples of 4 bytes.
+		 */
+		static UINT32 calcInterfaceBlockElementSizeAndOffset(GpuParamDataType type, UINT32 arraySize, UINT32& offset);
+	};
+
+	/** @} */
+}}
@@ -192,7 +192,8 @@ namespace bs { namespace ct
 		, mFramebuffer(nullptr), mRenderTargetWidth(0)
 		, mRenderTargetHeight(0), mRenderTargetReadOnlyFlags(0), mRenderTargetLoadMask(RT_NONE), mGlobalQueueIdx(-1)
 		, mViewport(0.0f, 0.0f, 1.0f, 1.0f), mScissor(0, 0, 0, 0), mStencilRef(0), mDrawOp(DOT_TRIANGLE_LIST)
-		, mNumBoundDescriptorSets(0), mGfxPipelineRequiresBind(true), mCmpPipelineRequiresBind(true)
+		, mNumBoundDescriptorSets(0), mNumBoundDynamicOffsets(0), mGfxPipelineRequiresBind(true)
+		, mCmpPipelineRequiresBind(true)
 		, mViewportRequiresBind(true), mStencilRefRequiresBind(true), mScissorRequiresBind(true), mBoundParamsDirty(false)
 		, mClearValues(), mClearMask(), mSemaphoresTemp(BS_MAX_UNIQUE_QUEUES), mVertexBuffersTemp()
 		, mVertexBufferOffsetsTemp()
@@ -200,6 +201,9 @@ namespace bs { namespace ct
 		UINT32 maxBoundDescriptorSets = device.getDeviceProperties().limits.maxBoundDescriptorSets;
 		mDescriptorSetsTemp = (VkDescriptorSet*)bs_alloc(sizeof(VkDescriptorSet) * maxBoundDescriptorSets);
 
+		UINT32 maxDynamicOffsets = device.getDeviceProperties().limits.maxDescriptorSetUniformBuffersDynamic;
+		mDynamicOffsetsTemp = (UINT32*)bs_alloc(sizeof(UINT32) * maxDynamicOffsets);
+
 		VkCommandBufferAllocateInfo cmdBufferAllocInfo;
 		cmdBufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 		cmdBufferAllocInfo.pNext = nullptr;
@@ -280,6 +284,7 @@ namespace bs { namespace ct
 		vkFreeCommandBuffers(device, mPool, 1, &mCmdBuffer);
 
 		bs_free(mDescriptorSetsTemp);
+		bs_free(mDynamicOffsetsTemp);
 	}
 
 	UINT32 VulkanCmdBuffer::getDeviceIdx() const
@@ -1138,6 +1143,7 @@ namespace bs { namespace ct
 		else
 		{
 			mNumBoundDescriptorSets = 0;
+			mNumBoundDynamicOffsets = 0;
 			mBoundParamsDirty = false;
 		}
 
@@ -1352,16 +1358,21 @@ namespace bs { namespace ct
 			if (mBoundParams != nullptr)
 			{
 				mNumBoundDescriptorSets = mBoundParams->getNumSets();
-				mBoundParams->prepareForBind(*this, mDescriptorSetsTemp);
+				mNumBoundDynamicOffsets = mBoundParams->getNumDynamicOffsets();
+				mBoundParams->prepareForBind(*this, mDescriptorSetsTemp, mDynamicOffsetsTemp);
 			}
 			else
+			{
 				mNumBoundDescriptorSets = 0;
+				mNumBoundDynamicOffsets = 0;
+			}
 
 			mBoundParamsDirty = false;
 		}
 		else
 		{
 			mNumBoundDescriptorSets = 0;
+			mNumBoundDynamicOffsets = 0;
 		}
 	}
 
@@ -1503,7 +1514,8 @@ namespace bs { namespace ct
 				VkPipelineLayout pipelineLayout = mGraphicsPipeline->getPipelineLayout(deviceIdx);
 
 				vkCmdBindDescriptorSets(mCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
-										mNumBoundDescriptorSets, mDescriptorSetsTemp, 0, nullptr);
+										mNumBoundDescriptorSets, mDescriptorSetsTemp, mNumBoundDynamicOffsets,
+										mDynamicOffsetsTemp);
 			}
 
 			mDescriptorSetsBindState.unset(DescriptorSetBindFlag::Graphics);
@@ -1542,7 +1554,8 @@ namespace bs { namespace ct
 				VkPipelineLayout pipelineLayout = mGraphicsPipeline->getPipelineLayout(deviceIdx);
 
 				vkCmdBindDescriptorSets(mCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
-										mNumBoundDescriptorSets, mDescriptorSetsTemp, 0, nullptr);
+										mNumBoundDescriptorSets, mDescriptorSetsTemp, mNumBoundDynamicOffsets,
+										mDynamicOffsetsTemp);
 			}
 
 			mDescriptorSetsBindState.unset(DescriptorSetBindFlag::Graphics);
@@ -1590,7 +1603,8 @@ namespace bs { namespace ct
 			{
 				VkPipelineLayout pipelineLayout = mComputePipeline->getPipelineLayout(deviceIdx);
 				vkCmdBindDescriptorSets(mCmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0,
-										mNumBoundDescriptorSets, mDescriptorSetsTemp, 0, nullptr);
+										mNumBoundDescriptorSets, mDescriptorSetsTemp, mNumBoundDynamicOffsets,
+										mDynamicOffsetsTemp);
 			}
 
 			mDescriptorSetsBindState.unset(DescriptorSetBindFlag::Compute);
@@ -503,6 +503,7 @@ namespace bs { namespace ct
 		UINT32 mStencilRef;
 		DrawOperationType mDrawOp;
 		UINT32 mNumBoundDescriptorSets;
+		UINT32 mNumBoundDynamicOffsets;
 		bool mGfxPipelineRequiresBind : 1;
 		bool mCmpPipelineRequiresBind : 1;
 		bool mViewportRequiresBind : 1;
@@ -520,6 +521,7 @@ namespace bs { namespace ct
 		VkBuffer mVertexBuffersTemp[BS_MAX_BOUND_VERTEX_BUFFERS];
 		VkDeviceSize mVertexBufferOffsetsTemp[BS_MAX_BOUND_VERTEX_BUFFERS];
 		VkDescriptorSet* mDescriptorSetsTemp;
+		UINT32* mDynamicOffsetsTemp;
 		UnorderedMap<UINT32, TransitionInfo> mTransitionInfoTemp;
 		Vector<VkImageMemoryBarrier> mLayoutTransitionBarriersTemp;
 		UnorderedMap<VulkanImage*, UINT32> mQueuedLayoutTransitions;
@@ -8,7 +8,7 @@ namespace bs { namespace ct
 	VulkanDescriptorPool::VulkanDescriptorPool(VulkanDevice& device)
 		:mDevice(device)
 	{
-		VkDescriptorPoolSize poolSizes[6];
+		VkDescriptorPoolSize poolSizes[7];
 		poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 		poolSizes[0].descriptorCount = sMaxSampledImages;
 
@@ -27,6 +27,9 @@ namespace bs { namespace ct
 		poolSizes[5].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 		poolSizes[5].descriptorCount = sMaxBuffers;
 
+		poolSizes[6].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		poolSizes[6].descriptorCount = sMaxUniformBuffers;
+
 		VkDescriptorPoolCreateInfo poolCI;
 		poolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 		poolCI.pNext = nullptr;
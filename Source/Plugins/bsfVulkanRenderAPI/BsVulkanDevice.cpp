@@ -5,6 +5,7 @@
 #include "BsVulkanCommandBuffer.h"
 #include "Managers/BsVulkanDescriptorManager.h"
 #include "Managers/BsVulkanQueryManager.h"
+#include "BsVulkanParamBlockRing.h"
 
 #define VMA_IMPLEMENTATION
 #include "ThirdParty/vk_mem_alloc.h"
@@ -159,6 +160,7 @@ namespace bs { namespace ct
 		mQueryPool = bs_new<VulkanQueryPool>(*this);
 		mDescriptorManager = bs_new<VulkanDescriptorManager>(*this);
 		mResourceManager = bs_new<VulkanResourceManager>(*this);
+		mParamBlockRing = bs_new<VulkanParamBlockRing>(*this);
 	}
 
 	VulkanDevice::~VulkanDevice()
@@ -175,6 +177,7 @@ namespace bs { namespace ct
 			}
 		}
 
+		bs_delete(mParamBlockRing);
 		bs_delete(mDescriptorManager);
 		bs_delete(mQueryPool);
 		bs_delete(mCommandBufferPool);
@@ -337,6 +340,27 @@ namespace bs { namespace ct
 		return memory;
 	}
 
+	VmaAllocation VulkanDevice::allocateMappedMemory(VkBuffer buffer, VkMemoryPropertyFlags flags, UINT8*& mappedData)
+	{
+		assert((flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0);
+
+		// Dedicated memory so mapping it doesn't conflict with vkMapMemory() calls on other allocations in the same block
+		VmaAllocationCreateInfo allocCI = {};
+		allocCI.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		allocCI.requiredFlags = flags;
+
+		VmaAllocationInfo allocInfo;
+		VmaAllocation memory;
+		VkResult result = vmaAllocateMemoryForBuffer(mAllocator, buffer, &allocCI, &memory, &allocInfo);
+		assert(result == VK_SUCCESS);
+
+		result = vkBindBufferMemory(mLogicalDevice, buffer, allocInfo.deviceMemory, allocInfo.offset);
+		assert(result == VK_SUCCESS);
+
+		mappedData = (UINT8*)allocInfo.pMappedData;
+		return memory;
+	}
+
 	void VulkanDevice::freeMemory(VmaAllocation allocation)
 	{
 		vmaFreeMemory(mAllocator, allocation);
@@ -84,6 +84,9 @@ namespace bs { namespace ct
 		/** Returns a manager that can be used for allocating Vulkan objects wrapped as managed resources. */
 		VulkanResourceManager& getResourceManager() const { return *mResourceManager; }
 
+		/** Returns a ring buffer that GPBU_STREAM parameter blocks are sub-allocated from. */
+		VulkanParamBlockRing& getParamBlockRing() const { return *mParamBlockRing; }
+
 		/** 
 		 * Allocates memory for the provided image, and binds it to the image. Returns null if it cannot find memory
 		 * with the specified flags.
@@ -96,6 +99,17 @@ namespace bs { namespace ct
 		 */
 		VmaAllocation allocateMemory(VkBuffer buffer, VkMemoryPropertyFlags flags);
 
+		/** 
+		 * Allocates a dedicated block of memory for the provided buffer, binds it to the buffer and keeps it mapped until
+		 * the memory is freed. Memory flags must include VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT.
+		 *
+		 * @param[in]	buffer		Buffer to allocate and bind the memory for.
+		 * @param[in]	flags		Required memory properties.
+		 * @param[out]	mappedData	Pointer to the start of the mapped memory.
+		 * @return					Memory allocation that should be released with freeMemory().
+		 */
+		VmaAllocation allocateMappedMemory(VkBuffer buffer, VkMemoryPropertyFlags flags, UINT8*& mappedData);
+
 		/** Frees a previously allocated block of memory. */
 		void freeMemory(VmaAllocation allocation);
 
@@ -120,6 +134,7 @@ namespace bs { namespace ct
 		VulkanQueryPool* mQueryPool;
 		VulkanDescriptorManager* mDescriptorManager;
 		VulkanResourceManager* mResourceManager;
+		VulkanParamBlockRing* mParamBlockRing;
 		VmaAllocator mAllocator;
 
 		VkPhysicalDeviceProperties mDeviceProperties;
@@ -2,13 +2,16 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsVulkanGpuParamBlockBuffer.h"
 #include "BsVulkanHardwareBuffer.h"
+#include "BsVulkanRenderAPI.h"
+#include "BsVulkanDevice.h"
+#include "BsVulkanUtility.h"
 #include "Profiling/BsRenderStats.h"
 
 namespace bs { namespace ct
 {
 	VulkanGpuParamBlockBuffer::VulkanGpuParamBlockBuffer(UINT32 size, GpuParamBlockUsage usage,
 		GpuDeviceFlags deviceMask)
-		:GpuParamBlockBuffer(size, usage, deviceMask), mBuffer(nullptr), mDeviceMask(deviceMask)
+		:GpuParamBlockBuffer(size, usage, deviceMask), mBuffer(nullptr), mDevices(), mRingSlices(), mDeviceMask(deviceMask)
 	{ }
 
 	VulkanGpuParamBlockBuffer::~VulkanGpuParamBlockBuffer()
@@ -23,22 +26,63 @@ namespace bs { namespace ct
 	{
 		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuParamBuffer);
 
-		GpuBufferUsage usage = mUsage == GPBU_STATIC ? GBU_STATIC : GBU_DYNAMIC;
+		// Streamed buffers have no storage of their own, data is written to the per-device ring buffer instead
+		if (mUsage == GPBU_STREAM)
+		{
+			VulkanRenderAPI& rapi = static_cast<VulkanRenderAPI&>(RenderAPI::instance());
+			VulkanUtility::getDevices(rapi, mDeviceMask, mDevices);
+		}
+		else
+		{
+			GpuBufferUsage usage = mUsage == GPBU_STATIC ? GBU_STATIC : GBU_DYNAMIC;
 
-		mBuffer = bs_new<VulkanHardwareBuffer>(VulkanHardwareBuffer::BT_UNIFORM, BF_UNKNOWN, usage, mSize, mDeviceMask);
+			mBuffer = bs_new<VulkanHardwareBuffer>(VulkanHardwareBuffer::BT_UNIFORM, BF_UNKNOWN, usage, mSize,
+				mDeviceMask);
+		}
 
 		GpuParamBlockBuffer::initialize();
 	}
 
 	void VulkanGpuParamBlockBuffer::writeToGPU(const UINT8* data, UINT32 queueIdx)
 	{
-		mBuffer->writeData(0, mSize, data, BWT_DISCARD, queueIdx);
+		if (mBuffer != nullptr)
+			mBuffer->writeData(0, mSize, data, BWT_DISCARD, queueIdx);
+		else
+		{
+			for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
+			{
+				if (mDevices[i] != nullptr)
+					mDevices[i]->getParamBlockRing().write(data, mSize, mRingSlices[i]);
+			}
+		}
 
 		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
 	}
 
+	bool VulkanGpuParamBlockBuffer::isGPUDataLost() const
+	{
+		if (mBuffer != nullptr)
+			return false;
+
+		for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
+		{
+			if (mDevices[i] != nullptr && !mDevices[i]->getParamBlockRing().isValid(mRingSlices[i]))
+				return true;
+		}
+
+		return false;
+	}
+
 	VulkanBuffer* VulkanGpuParamBlockBuffer::getResource(UINT32 deviceIdx) const
 	{
-		return mBuffer->getResource(deviceIdx);
+		if (mBuffer != nullptr)
+			return mBuffer->getResource(deviceIdx);
+
+		// Ring buffer could have been re-allocated since the last write, in which case the old one might not exist anymore
+		const VulkanParamBlockRingSlice& slice = mRingSlices[deviceIdx];
+		if (mDevices[deviceIdx] == nullptr || !mDevices[deviceIdx]->getParamBlockRing().isValid(slice))
+			return nullptr;
+
+		return slice.buffer;
 	}
 }}
\ No newline at end of file
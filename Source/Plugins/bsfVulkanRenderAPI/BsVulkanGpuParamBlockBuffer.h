@@ -4,6 +4,7 @@
 
 #include "BsVulkanPrerequisites.h"
 #include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "BsVulkanParamBlockRing.h"
 
 namespace bs { namespace ct
 {
@@ -23,15 +24,34 @@ namespace bs { namespace ct
 
 		/** 
 		 * Gets the resource wrapping the buffer object, on the specified device. If GPU param block buffer's device mask
-		 * doesn't include the provided device, null is returned. 
+		 * doesn't include the provided device, null is returned. For GPBU_STREAM buffers this is the ring buffer the data
+		 * was last written to, or null if no data was written yet or it is no longer available.
 		 */
 		VulkanBuffer* getResource(UINT32 deviceIdx) const;
+
+		/** 
+		 * Returns the offset of the parameter block data from the start of the buffer returned by getResource(), in
+		 * bytes. Always zero unless the buffer was created with GPBU_STREAM usage.
+		 */
+		UINT32 getOffset(UINT32 deviceIdx) const { return mRingSlices[deviceIdx].offset; }
+
+		/** 
+		 * Returns the resource tracking the use of the ring buffer segment the data was last written to, on the specified
+		 * device. Must be registered with any command buffer the data is bound to. Null unless the buffer was created
+		 * with GPBU_STREAM usage.
+		 */
+		VulkanResource* getRingSegment(UINT32 deviceIdx) const { return mRingSlices[deviceIdx].segment; }
 	protected:
 		/** @copydoc GpuParamBlockBuffer::initialize */
 		void initialize() override;
 
+		/** @copydoc GpuParamBlockBuffer::isGPUDataLost */
+		bool isGPUDataLost() const override;
+
 	private:
 		VulkanHardwareBuffer* mBuffer;
+		VulkanDevice* mDevices[BS_MAX_DEVICES];
+		VulkanParamBlockRingSlice mRingSlices[BS_MAX_DEVICES];
 		GpuDeviceFlags mDeviceMask;
 	};
 
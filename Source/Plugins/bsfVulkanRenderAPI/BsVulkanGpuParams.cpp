@@ -178,8 +178,10 @@ namespace bs { namespace ct
 					}
 					else
 					{
-						bool useView = writeSetInfo.descriptorType != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER && 
-							writeSetInfo.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+						bool isUniform = writeSetInfo.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
+							writeSetInfo.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+
+						bool useView = !isUniform && writeSetInfo.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 
 						if (!useView)
 						{
@@ -187,7 +189,7 @@ namespace bs { namespace ct
 							bufferInfo.offset = 0;
 							bufferInfo.range = VK_WHOLE_SIZE;
 
-							if(writeSetInfo.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+							if(isUniform)
 								bufferInfo.buffer = vkBufManager.getDummyUniformBuffer(i);
 							else
 								bufferInfo.buffer = vkBufManager.getDummyStructuredBuffer(i);
@@ -251,11 +253,17 @@ namespace bs { namespace ct
 				bufferRes = nullptr;
 
 			PerSetData& perSetData = mPerDeviceData[i].perSetData[set];
+			VkDescriptorBufferInfo& bufferInfo = perSetData.writeInfos[bindingIdx].buffer;
 			if (bufferRes != nullptr)
 			{
 				VkBuffer buffer = bufferRes->getHandle();
 
-				perSetData.writeInfos[bindingIdx].buffer.buffer = buffer;
+				// Offset is provided when binding if the descriptor is dynamic
+				bool isDynamic = vkParamInfo.getDynamicOffsetIdx(sequentialIdx) != (UINT32)-1;
+
+				bufferInfo.buffer = buffer;
+				bufferInfo.offset = isDynamic ? 0 : vulkanParamBlockBuffer->getOffset(i);
+				bufferInfo.range = vulkanParamBlockBuffer->getSize();
 				mPerDeviceData[i].uniformBuffers[sequentialIdx] = buffer;
 			}
 			else
@@ -263,7 +271,9 @@ namespace bs { namespace ct
 				VulkanHardwareBufferManager& vkBufManager = static_cast<VulkanHardwareBufferManager&>(
 					HardwareBufferManager::instance());
 
-				perSetData.writeInfos[bindingIdx].buffer.buffer = vkBufManager.getDummyUniformBuffer(i);
+				bufferInfo.buffer = vkBufManager.getDummyUniformBuffer(i);
+				bufferInfo.offset = 0;
+				bufferInfo.range = VK_WHOLE_SIZE;
 				mPerDeviceData[i].uniformBuffers[sequentialIdx] = VK_NULL_HANDLE;
 			}
 		}
@@ -525,7 +535,13 @@ namespace bs { namespace ct
 		return mParamInfo->getNumSets();
 	}
 
-	void VulkanGpuParams::prepareForBind(VulkanCmdBuffer& buffer, VkDescriptorSet* sets)
+	UINT32 VulkanGpuParams::getNumDynamicOffsets() const
+	{
+		VulkanGpuPipelineParamInfo& vkParamInfo = static_cast<VulkanGpuPipelineParamInfo&>(*mParamInfo);
+		return vkParamInfo.getNumDynamicOffsets();
+	}
+
+	void VulkanGpuParams::prepareForBind(VulkanCmdBuffer& buffer, VkDescriptorSet* sets, UINT32* dynamicOffsets)
 	{
 		UINT32 deviceIdx = buffer.getDeviceIdx();
 
@@ -541,9 +557,13 @@ namespace bs { namespace ct
 		UINT32 numBuffers = vkParamInfo.getNumElements(GpuPipelineParamInfo::ParamType::Buffer);
 		UINT32 numSamplers = vkParamInfo.getNumElements(GpuPipelineParamInfo::ParamType::SamplerState);
 		UINT32 numSets = vkParamInfo.getNumSets();
+		UINT32 numDynamicOffsets = vkParamInfo.getNumDynamicOffsets();
 
 		Lock lock(mMutex);
 
+		// Dynamic offsets must be provided for all dynamic descriptors, including those with no param block bound
+		bs_zero_out(dynamicOffsets, numDynamicOffsets);
+
 		// Registers resources with the command buffer, and check if internal resource handled changed (in which case set
 		// needs updating - this can happen due to resource writes, as internally system might find it more performant
 		// to discard used resources and create new ones).
@@ -562,19 +582,35 @@ namespace bs { namespace ct
 			// Register with command buffer
 			buffer.registerResource(resource, VK_ACCESS_UNIFORM_READ_BIT, VulkanUseFlag::Read);
 
-			// Check if internal resource changed from what was previously bound in the descriptor set
-			assert(perDeviceData.uniformBuffers[i] != VK_NULL_HANDLE);
+			// Streamed param blocks also need to keep their ring buffer segment from being reused
+			VulkanResource* ringSegment = element->getRingSegment(deviceIdx);
+			if (ringSegment != nullptr)
+				buffer.registerResource(ringSegment, VulkanUseFlag::Read);
 
+			// Offsets of dynamic descriptors are provided at bind time, others need to be written to the descriptor set
+			UINT32 offset = element->getOffset(deviceIdx);
+			UINT32 dynamicOffsetIdx = vkParamInfo.getDynamicOffsetIdx(i);
+			if (dynamicOffsetIdx != (UINT32)-1)
+			{
+				dynamicOffsets[dynamicOffsetIdx] = offset;
+				offset = 0;
+			}
+
+			UINT32 set, slot;
+			mParamInfo->getBinding(GpuPipelineParamInfo::ParamType::ParamBlock, i, set, slot);
+
+			UINT32 bindingIdx = vkParamInfo.getBindingIdx(set, slot);
+			VkDescriptorBufferInfo& bufferInfo = perDeviceData.perSetData[set].writeInfos[bindingIdx].buffer;
+
+			// Check if internal resource changed from what was previously bound in the descriptor set
 			VkBuffer vkBuffer = resource->getHandle();
-			if(perDeviceData.uniformBuffers[i] != vkBuffer)
+			if(perDeviceData.uniformBuffers[i] != vkBuffer || bufferInfo.offset != offset)
 			{
 				perDeviceData.uniformBuffers[i] = vkBuffer;
-			
-				UINT32 set, slot;
-				mParamInfo->getBinding(GpuPipelineParamInfo::ParamType::ParamBlock, i, set, slot);
 
-				UINT32 bindingIdx = vkParamInfo.getBindingIdx(set, slot);
-				perDeviceData.perSetData[set].writeInfos[bindingIdx].buffer.buffer = vkBuffer;
+				bufferInfo.buffer = vkBuffer;
+				bufferInfo.offset = offset;
+				bufferInfo.range = element->getSize();
 
 				mSetsDirty[set] = true;
 			}
@@ -38,6 +38,9 @@ namespace bs { namespace ct
 		/** Returns the total number of descriptor sets used by this object. */
 		UINT32 getNumSets() const;
 
+		/** Returns the number of dynamic offsets that need to be provided when binding the descriptor sets. */
+		UINT32 getNumDynamicOffsets() const;
+
 		/** 
 		 * Prepares the internal descriptor sets for a bind operation on the provided command buffer. It generates and/or
 		 * updates and descriptor sets, and registers the relevant resources with the command buffer.
@@ -45,13 +48,15 @@ namespace bs { namespace ct
 		 * Caller must perform external locking if some other thread could write to this object while it is being bound. 
 		 * The same applies to any resources held by this object.
 		 * 
-		 * @param[in]	buffer	Buffer on which the parameters will be bound to.
-		 * @param[out]	sets	Pre-allocated buffer in which the descriptor set handled will be written. Must be of
-		 *						getNumSets() size.
+		 * @param[in]	buffer			Buffer on which the parameters will be bound to.
+		 * @param[out]	sets			Pre-allocated buffer in which the descriptor set handled will be written. Must be
+		 *								of getNumSets() size.
+		 * @param[out]	dynamicOffsets	Pre-allocated buffer in which the dynamic offsets of the uniform buffers will be
+		 *								written. Must be of getNumDynamicOffsets() size.
 		 * 
 		 * @note	Thread safe.
 		 */
-		void prepareForBind(VulkanCmdBuffer& buffer, VkDescriptorSet* sets);
+		void prepareForBind(VulkanCmdBuffer& buffer, VkDescriptorSet* sets, UINT32* dynamicOffsets);
 
 	protected:
 		/** Contains data about writing to either buffer or a texture descriptor. */
@@ -10,7 +10,7 @@ namespace bs { namespace ct
 {
 	VulkanGpuPipelineParamInfo::VulkanGpuPipelineParamInfo(const GPU_PIPELINE_PARAMS_DESC& desc, GpuDeviceFlags deviceMask)
 		: GpuPipelineParamInfo(desc, deviceMask), mDeviceMask(deviceMask), mSetExtraInfos(nullptr), mLayouts()
-		, mLayoutInfos()
+		, mLayoutInfos(), mDynamicOffsetIndices(nullptr), mNumDynamicOffsets(0)
 	{ }
 
 	VulkanGpuPipelineParamInfo::~VulkanGpuPipelineParamInfo()
@@ -26,12 +26,19 @@ namespace bs { namespace ct
 		VulkanUtility::getDevices(rapi, mDeviceMask, devices);
 
 		UINT32 numDevices = 0;
+		UINT32 maxDynamicOffsets = std::numeric_limits<UINT32>::max();
 		for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
 		{
 			if (devices[i] != nullptr)
+			{
+				const VkPhysicalDeviceLimits& limits = devices[i]->getDeviceProperties().limits;
+				maxDynamicOffsets = std::min(maxDynamicOffsets, limits.maxDescriptorSetUniformBuffersDynamic);
+
 				numDevices++;
+			}
 		}
 
+		UINT32 numParamBlocks = getNumElements(ParamType::ParamBlock);
 		UINT32 totalNumSlots = 0;
 		for (UINT32 i = 0; i < mNumSets; i++)
 			totalNumSlots += mSetInfos[i].numSlots;
@@ -42,6 +49,7 @@ namespace bs { namespace ct
 			.reserve<VulkanDescriptorLayout*>(mNumSets * numDevices)
 			.reserve<SetExtraInfo>(mNumSets)
 			.reserve<UINT32>(totalNumSlots)
+			.reserve<UINT32>(numParamBlocks)
 			.init();
 
 		mLayoutInfos = mAlloc.alloc<LayoutInfo>(mNumSets);
@@ -184,6 +192,31 @@ namespace bs { namespace ct
 			}
 		}
 
+		// Bind as many uniform buffers as the device allows using dynamic offsets. This way param blocks sub-allocated
+		// from the ring buffer can be re-bound by only changing the offset, without needing to update the descriptor set.
+		// Dynamic offsets are provided in set order, then binding order within the set.
+		mDynamicOffsetIndices = mAlloc.alloc<UINT32>(numParamBlocks);
+		for (UINT32 i = 0; i < numParamBlocks; i++)
+			mDynamicOffsetIndices[i] = (UINT32)-1;
+
+		for (UINT32 i = 0; i < mNumSets; i++)
+		{
+			for (UINT32 j = 0; j < mLayoutInfos[i].numBindings; j++)
+			{
+				if (mNumDynamicOffsets >= maxDynamicOffsets)
+					break;
+
+				VkDescriptorSetLayoutBinding& binding = mLayoutInfos[i].bindings[j];
+				if (binding.descriptorType != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+					continue;
+
+				binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+
+				UINT32 paramBlockIdx = getSequentialSlot(ParamType::ParamBlock, i, binding.binding);
+				mDynamicOffsetIndices[paramBlockIdx] = mNumDynamicOffsets++;
+			}
+		}
+
 		// Allocate layouts per-device
 		for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
 		{
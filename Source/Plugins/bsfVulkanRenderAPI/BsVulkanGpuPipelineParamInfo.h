@@ -31,6 +31,15 @@ namespace bs { namespace ct
 		/** Returns the sequential index of the binding at the specificn set/slot. Returns -1 if slot is not used. */
 		UINT32 getBindingIdx(UINT32 set, UINT32 slot) const { return mSetExtraInfos[set].slotIndices[slot]; }
 
+		/** Returns the number of dynamic offsets that must be provided when binding all of the descriptor sets. */
+		UINT32 getNumDynamicOffsets() const { return mNumDynamicOffsets; }
+
+		/** 
+		 * Returns the index into the dynamic offset array for the param block with the provided sequential index. Returns
+		 * -1 if the param block is bound using a regular uniform buffer descriptor with no dynamic offset.
+		 */
+		UINT32 getDynamicOffsetIdx(UINT32 paramBlockIdx) const { return mDynamicOffsetIndices[paramBlockIdx]; }
+
 		/** 
 		 * Returns a layout for the specified device, at the specified index. Returns null if no layout for the specified 
 		 * device index. 
@@ -60,6 +69,8 @@ namespace bs { namespace ct
 		SetExtraInfo* mSetExtraInfos;
 		VulkanDescriptorLayout** mLayouts[BS_MAX_DEVICES];
 		LayoutInfo* mLayoutInfos;
+		UINT32* mDynamicOffsetIndices;
+		UINT32 mNumDynamicOffsets;
 
 		GroupAlloc mAlloc;
 	};
@@ -0,0 +1,127 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsVulkanParamBlockRing.h"
+#include "BsVulkanDevice.h"
+#include "BsVulkanHardwareBuffer.h"
+#include "Managers/BsVulkanCommandBufferManager.h"
+
+namespace bs { namespace ct
+{
+	VulkanParamBlockRing::VulkanParamBlockRing(VulkanDevice& device)
+		: mDevice(device), mBuffer(nullptr), mMappedData(nullptr), mSegments(), mSegmentSize(0), mAlignment(1)
+		, mCurrentSegment(0), mSegmentOffset(0), mNextGeneration(1)
+	{
+		const VkPhysicalDeviceLimits& limits = device.getDeviceProperties().limits;
+		mAlignment = std::max(1U, (UINT32)limits.minUniformBufferOffsetAlignment);
+
+		allocate(INITIAL_SEGMENT_SIZE);
+	}
+
+	VulkanParamBlockRing::~VulkanParamBlockRing()
+	{
+		for (UINT32 i = 0; i < NUM_SEGMENTS; i++)
+			mSegments[i].tracker->destroy();
+
+		mBuffer->destroy();
+	}
+
+	void VulkanParamBlockRing::write(const UINT8* data, UINT32 size, VulkanParamBlockRingSlice& slice)
+	{
+		UINT32 alignedSize = Math::divideAndRoundUp(size, mAlignment) * mAlignment;
+
+		Lock lock(mMutex);
+
+		while (alignedSize > mSegmentSize)
+			allocate(mSegmentSize * 2);
+
+		if ((mSegmentOffset + alignedSize) > mSegmentSize)
+			advance();
+
+		UINT32 offset = mCurrentSegment * mSegmentSize + mSegmentOffset;
+		memcpy(mMappedData + offset, data, size);
+
+		const Segment& segment = mSegments[mCurrentSegment];
+		slice.buffer = mBuffer;
+		slice.segment = segment.tracker;
+		slice.offset = offset;
+		slice.segmentIdx = mCurrentSegment;
+		slice.generation = segment.generation;
+
+		mSegmentOffset += alignedSize;
+	}
+
+	bool VulkanParamBlockRing::isValid(const VulkanParamBlockRingSlice& slice) const
+	{
+		Lock lock(mMutex);
+
+		if (slice.buffer != mBuffer || slice.segmentIdx >= NUM_SEGMENTS)
+			return false;
+
+		return mSegments[slice.segmentIdx].generation == slice.generation;
+	}
+
+	void VulkanParamBlockRing::advance()
+	{
+		UINT32 nextSegment = (mCurrentSegment + 1) % NUM_SEGMENTS;
+
+		// Segment is reused only once the GPU is done with all command buffers it is bound to
+		VulkanResource* tracker = mSegments[nextSegment].tracker;
+		if (tracker->isBound())
+		{
+			gVulkanCBManager().refreshStates(mDevice.getIndex());
+
+			if (tracker->isBound())
+			{
+				allocate(mSegmentSize * 2);
+				return;
+			}
+		}
+
+		mCurrentSegment = nextSegment;
+		mSegmentOffset = 0;
+		mSegments[nextSegment].generation = mNextGeneration++;
+	}
+
+	void VulkanParamBlockRing::allocate(UINT32 segmentSize)
+	{
+		// Destruction is delayed until the GPU is done with the old buffer, any data in it is considered lost
+		if (mBuffer != nullptr)
+		{
+			for (UINT32 i = 0; i < NUM_SEGMENTS; i++)
+				mSegments[i].tracker->destroy();
+
+			mBuffer->destroy();
+		}
+
+		mSegmentSize = Math::divideAndRoundUp(segmentSize, mAlignment) * mAlignment;
+
+		VkBufferCreateInfo bufferCI;
+		bufferCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferCI.pNext = nullptr;
+		bufferCI.flags = 0;
+		bufferCI.size = mSegmentSize * NUM_SEGMENTS;
+		bufferCI.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+		bufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bufferCI.queueFamilyIndexCount = 0;
+		bufferCI.pQueueFamilyIndices = nullptr;
+
+		VkBuffer buffer;
+		VkResult result = vkCreateBuffer(mDevice.getLogical(), &bufferCI, gVulkanAllocator, &buffer);
+		assert(result == VK_SUCCESS);
+
+		VkMemoryPropertyFlags flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		VmaAllocation allocation = mDevice.allocateMappedMemory(buffer, flags, mMappedData);
+
+		VulkanResourceManager& resManager = mDevice.getResourceManager();
+		mBuffer = resManager.create<VulkanBuffer>(buffer, VK_NULL_HANDLE, allocation);
+
+		for (UINT32 i = 0; i < NUM_SEGMENTS; i++)
+		{
+			mSegments[i].tracker = resManager.create<VulkanResource>(false);
+			mSegments[i].generation = mNextGeneration++;
+		}
+
+		mCurrentSegment = 0;
+		mSegmentOffset = 0;
+	}
+}}
@@ -0,0 +1,99 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsVulkanPrerequisites.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Vulkan
+	 *  @{
+	 */
+
+	/** Location of a single parameter block written to a VulkanParamBlockRing. */
+	struct VulkanParamBlockRingSlice
+	{
+		/** Buffer the data was written to. */
+		VulkanBuffer* buffer = nullptr;
+
+		/**
+		 * Resource tracking the GPU use of the ring segment the data was written to. Must be registered with any command
+		 * buffer that reads the data, so the segment isn't reused before the GPU is done with it.
+		 */
+		VulkanResource* segment = nullptr;
+
+		/** Offset of the data from the start of the buffer, in bytes. */
+		UINT32 offset = 0;
+
+		/** Index of the segment the data was written to. */
+		UINT32 segmentIdx = 0;
+
+		/** Generation of the segment at the time the data was written, used for determining if the data was lost. */
+		UINT64 generation = 0;
+	};
+
+	/**
+	 * Persistently mapped uniform buffer that parameter blocks are sub-allocated from. Each write is placed after the
+	 * previous one, and the parameter block is bound by its offset within the buffer. This avoids allocating a new
+	 * buffer and re-writing the descriptor set whenever a frequently updated parameter block changes.
+	 *
+	 * The buffer is split into a fixed number of segments. A segment is only reused once the GPU is done with all the
+	 * command buffers it was bound to. If that isn't the case the ring is re-created at twice the size, so it grows to
+	 * match the amount of data written between GPU syncs.
+	 *
+	 * @note	Thread safe.
+	 */
+	class VulkanParamBlockRing
+	{
+	public:
+		VulkanParamBlockRing(VulkanDevice& device);
+		~VulkanParamBlockRing();
+
+		/**
+		 * Copies the provided data into the ring.
+		 *
+		 * @param[in]	data	Data to copy.
+		 * @param[in]	size	Size of the data, in bytes. Must not be larger than the maximum uniform buffer range.
+		 * @param[out]	slice	Location the data was written to.
+		 */
+		void write(const UINT8* data, UINT32 size, VulkanParamBlockRingSlice& slice);
+
+		/**
+		 * Checks if the data at the provided location is still available, or if its segment has since been reused or
+		 * the ring has been re-allocated.
+		 */
+		bool isValid(const VulkanParamBlockRingSlice& slice) const;
+
+	private:
+		/** Information about a single segment of the ring buffer. */
+		struct Segment
+		{
+			VulkanResource* tracker;
+			UINT64 generation;
+		};
+
+		/** Moves the write position to the start of the next segment, growing the ring if that segment is in use. */
+		void advance();
+
+		/** Releases the current buffer (if any) and allocates a new one with the provided segment size. */
+		void allocate(UINT32 segmentSize);
+
+		static const UINT32 NUM_SEGMENTS = 4;
+		static const UINT32 INITIAL_SEGMENT_SIZE = 256 * 1024;
+
+		VulkanDevice& mDevice;
+		VulkanBuffer* mBuffer;
+		UINT8* mMappedData;
+		Segment mSegments[NUM_SEGMENTS];
+
+		UINT32 mSegmentSize;
+		UINT32 mAlignment;
+		UINT32 mCurrentSegment;
+		UINT32 mSegmentOffset;
+		UINT64 mNextGeneration;
+
+		mutable Mutex mMutex;
+	};
+
+	/** @} */
+}}
@@ -66,6 +66,7 @@ namespace bs { namespace ct
 	class VulkanQueryPool;
 	class VulkanVertexInput;
 	class VulkanSemaphore;
+	class VulkanParamBlockRing;
 
 	extern VkAllocationCallbacks* gVulkanAllocator;
 
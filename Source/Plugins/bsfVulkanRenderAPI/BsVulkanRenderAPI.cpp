@@ -20,6 +20,7 @@
 
 #include <vulkan/vulkan.h>
 #include "BsVulkanUtility.h"
+#include "BsGLSLangReflection.h"
 
 #if BS_PLATFORM == BS_PLATFORM_WIN32
 	#include "Win32/BsWin32VideoModeInfo.h"
@@ -595,7 +596,8 @@ namespace bs { namespace ct
 				block.blockSize = Math::divideAndRoundUp(block.blockSize, 4U) * 4;
 			}
 			else
-				size = VulkanUtility::calcInterfaceBlockElementSizeAndOffset(param.type, param.arraySize, block.blockSize);
+				size = GLSLangReflection::calcInterfaceBlockElementSizeAndOffset(param.type, param.arraySize,
+					block.blockSize);
 
 			if (param.arraySize > 1)
 			{
@@ -683,6 +685,7 @@ namespace bs { namespace ct
 			caps.setNumMultiRenderTargets(deviceLimits.maxColorAttachments);
 
 			caps.setCapability(RSC_COMPUTE_PROGRAM);
+			caps.setCapability(RSC_PARAM_BLOCK_RING_BUFFER);
 
 			caps.setNumTextureUnits(GPT_FRAGMENT_PROGRAM, deviceLimits.maxPerStageDescriptorSampledImages);
 			caps.setNumTextureUnits(GPT_VERTEX_PROGRAM, deviceLimits.maxPerStageDescriptorSampledImages);